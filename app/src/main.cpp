@@ -13,6 +13,7 @@
 #include "nuri/resources/gpu/model.h"
 #include "nuri/resources/gpu/resource_manager.h"
 #include "nuri/resources/gpu/texture.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
 #include "nuri/scene/camera_system.h"
 #include "nuri/scene/render_scene.h"
 #include "nuri/text/text_layer_2d.h"
@@ -46,11 +47,9 @@ std::filesystem::path pickDefaultNfontPath(const nuri::RuntimeConfig &config) {
   for (std::string_view name : preferred) {
     const std::filesystem::path candidate =
         (fontsRoot / std::string(name)).lexically_normal();
-    if (std::filesystem::exists(candidate, ec) &&
-        std::filesystem::is_regular_file(candidate, ec)) {
+    if (nuri::assetFileExists(candidate)) {
       return candidate;
     }
-    ec.clear();
   }
 
   std::filesystem::path newest;
@@ -90,6 +89,19 @@ std::filesystem::path pickDefaultNfontPath(const nuri::RuntimeConfig &config) {
   return (fontsRoot / "default_ui.nfont").lexically_normal();
 }
 
+// Files missing from the archive keep loading from the loose asset tree.
+void mountConfiguredAssetArchive(const nuri::RuntimeConfig &config) {
+  if (config.roots.archive.empty()) {
+    return;
+  }
+  auto mountResult =
+      nuri::mountAssetArchive(config.roots.archive, config.roots.assets);
+  if (mountResult.hasError()) {
+    NURI_LOG_WARNING("mountConfiguredAssetArchive: %s",
+                     mountResult.error().c_str());
+  }
+}
+
 } // namespace
 
 class NuriApplication : public nuri::Application {
@@ -200,7 +212,7 @@ private:
   void initializeTextSystem() {
     const std::filesystem::path defaultFontPath = pickDefaultNfontPath(config_);
     const bool requireDefaultFont =
-        std::filesystem::is_regular_file(defaultFontPath);
+        nuri::assetFileExists(defaultFontPath);
     NURI_LOG_INFO("NuriApplication::initializeTextSystem: default font '%s'",
                   defaultFontPath.string().c_str());
 
@@ -586,6 +598,7 @@ private:
   void buildFrameContext(const nuri::Camera &camera, double timeSeconds) {
     frameContext_.scene = &scene_;
     frameContext_.resources = &getRenderer().resources();
+    frameContext_.pipelines = &getRenderer().pipelines();
     frameContext_.camera.view = camera.viewMatrix();
     frameContext_.camera.proj = camera.projectionMatrix(getAspectRatio());
     frameContext_.camera.cameraPos = glm::vec4(camera.position(), 1.0f);
@@ -635,6 +648,7 @@ int main() {
   auto configResult = nuri::loadRuntimeConfigFromEnvOrDefault();
   NURI_ASSERT(!configResult.hasError(), "Failed to load app config: %s",
               configResult.error().c_str());
+  mountConfiguredAssetArchive(configResult.value());
 
   NuriApplication app{std::move(configResult.value())};
   app.run();
@@ -12,6 +12,30 @@ vec2 selectUv(vec2 uv0, vec2 uv1, uint uvSet) {
   return (uvSet == 1u) ? uv1 : uv0;
 }
 
+// Baked irradiance volume atlas: z slices side by side along x and one band of
+// rows per L1 SH coefficient (l0, l1x, l1y, l1z). rgb holds irradiance / pi,
+// a holds sky visibility.
+vec4 sampleIrradianceVolumeSlice(uint texId, uvec3 counts, vec2 probe,
+                                 float slice, uint coefficient) {
+  vec2 atlasSize = vec2(float(counts.x * counts.z), float(counts.y * 4u));
+  vec2 texel = vec2(slice * float(counts.x) + probe.x,
+                    float(coefficient * counts.y) + probe.y) +
+               vec2(0.5);
+  return textureBindless2D(texId, 0, texel / atlasSize);
+}
+
+vec4 sampleIrradianceVolume(vec3 probe, uint coefficient) {
+  uint texId = pc.frameData.irradianceVolumeInfo.x;
+  uvec3 counts = pc.frameData.irradianceVolumeInfo.yzw;
+  float slice0 = floor(probe.z);
+  float slice1 = min(slice0 + 1.0, float(counts.z - 1u));
+  vec4 a = sampleIrradianceVolumeSlice(texId, counts, probe.xy, slice0,
+                                       coefficient);
+  vec4 b = sampleIrradianceVolumeSlice(texId, counts, probe.xy, slice1,
+                                       coefficient);
+  return mix(a, b, probe.z - slice0);
+}
+
 void main() {
   const MaterialGpuData material = pc.materialBuffer.materials[pc.materialIndex];
 
@@ -429,6 +453,29 @@ void main() {
     hasIndirectLighting = true;
   }
 
+  if ((pc.frameData.flags & kFrameDataFlagHasIrradianceVolume) != 0u) {
+    vec3 counts = vec3(pc.frameData.irradianceVolumeInfo.yzw);
+    vec3 probe = (vtx.worldPos - pc.frameData.irradianceVolumeMin.xyz) *
+                     pc.frameData.irradianceVolumeInvExtent.xyz * counts -
+                 vec3(0.5);
+    probe = clamp(probe, vec3(0.0), counts - vec3(1.0));
+    vec4 c0 = sampleIrradianceVolume(probe, 0u);
+    vec4 c1 = sampleIrradianceVolume(probe, 1u);
+    vec4 c2 = sampleIrradianceVolume(probe, 2u);
+    vec4 c3 = sampleIrradianceVolume(probe, 3u);
+    // Baked against a unit white sky, so the volume acts as a transfer term
+    // on top of the environment lighting.
+    vec3 diffuseTransfer =
+        c0.rgb + c1.rgb * nBase.x + c2.rgb * nBase.y + c3.rgb * nBase.z;
+    iblDiffuse *= max(diffuseTransfer, vec3(0.0));
+    vec3 r = reflect(-v, nBase);
+    float specularOcclusion =
+        clamp(c0.a + dot(vec3(c1.a, c2.a, c3.a), r), 0.0, 1.0);
+    iblSpecular *= specularOcclusion;
+    iblSheen *= specularOcclusion;
+    clearcoatIblSpecular *= specularOcclusion;
+  }
+
   vec3 indirectLighting =
       clearcoatAttenuation *
           (iblSheen + indirectScale * (iblDiffuse + iblSpecular)) +
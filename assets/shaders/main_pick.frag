@@ -0,0 +1,15 @@
+// Opaque shading plus the 1-based object ID on color attachment 1, so pick
+// requests reuse the main geometry pass instead of redrawing the scene.
+#define main shadeOpaqueSurface
+#include "main.frag"
+#undef main
+
+layout(location = 10) flat in uint inInstanceId;
+
+layout(location = 1) out uint outObjectId;
+
+// 0 is reserved as sentinel. Saturate to avoid wrap when inInstanceId == UINT_MAX.
+void main() {
+  shadeOpaqueSurface();
+  outObjectId = (inInstanceId >= 0xFFFFFFFFu) ? 0xFFFFFFFFu : (inInstanceId + 1u);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <filesystem>
 #include <string>
@@ -7,7 +8,11 @@
 
 namespace nuri::bakery {
 
-enum class BakeJobKind : uint8_t { BrdfLut, EnvmapPrefilter };
+enum class BakeJobKind : uint8_t {
+  BrdfLut,
+  EnvmapPrefilter,
+  IrradianceVolume
+};
 
 enum class BakeJobState : uint8_t {
   Queued,
@@ -37,8 +42,19 @@ struct EnvmapPrefilterBakeRequest {
   bool forceRebuild = false;
 };
 
+// Probes span the mesh bounds in mesh space; the runtime places the volume
+// with the same transform as the mesh.
+struct IrradianceVolumeBakeRequest {
+  std::filesystem::path meshPath;
+  std::array<uint32_t, 3> probeCounts{16u, 8u, 16u};
+  uint32_t samplesPerProbe = 256u;
+  uint32_t bounceCount = 2u;
+  bool forceRebuild = false;
+};
+
 using BakeRequest =
-    std::variant<BrdfLutBakeRequest, EnvmapPrefilterBakeRequest>;
+    std::variant<BrdfLutBakeRequest, EnvmapPrefilterBakeRequest,
+                 IrradianceVolumeBakeRequest>;
 
 struct BakeJobSnapshot {
   BakeJobId id{};
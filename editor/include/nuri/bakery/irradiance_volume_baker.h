@@ -0,0 +1,113 @@
+#pragma once
+
+#include "nuri/bakery/bakery_types.h"
+#include "nuri/core/result.h"
+#include "nuri/core/runtime_config.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace nuri::bakery::detail {
+
+// Probe grid stored alongside the texels as KTX2 metadata. Bounds are in mesh
+// space, probes sit at the centers of the grid cells.
+struct IrradianceVolumeInfo {
+  glm::vec3 boundsMin{0.0f};
+  glm::vec3 boundsMax{0.0f};
+  glm::uvec3 probeCounts{0u};
+};
+
+struct IrradianceBakePlan {
+  bool shouldBake = false;
+  std::filesystem::path meshPath;
+  std::filesystem::path outputPath;
+  glm::uvec3 probeCounts{0u};
+  uint32_t samplesPerProbe = 0;
+  uint32_t bounceCount = 0;
+};
+
+enum class IrradianceSetupPhase : uint8_t {
+  StartSceneLoad,
+  WaitSceneLoad,
+  Done,
+};
+
+struct IrradianceSetupProgress {
+  bool ready = false;
+  std::string summary;
+};
+
+// Triangle BVH, probe results and the tracing threads. Defined in the baker.
+struct IrradianceBakeRuntime;
+using IrradianceSceneLoadResult =
+    Result<std::shared_ptr<IrradianceBakeRuntime>, std::string>;
+
+struct IrradianceBakeState {
+  IrradianceSetupPhase setupPhase = IrradianceSetupPhase::StartSceneLoad;
+  std::shared_future<IrradianceSceneLoadResult> sceneLoadFuture{};
+  bool sceneLoadInFlight = false;
+  std::shared_ptr<IrradianceBakeRuntime> runtime{};
+  uint32_t completedSteps = 0;
+  uint32_t totalSteps = 0;
+};
+
+struct IrradianceStepProgress {
+  uint32_t completedSteps = 0;
+  uint32_t totalSteps = 0;
+  bool finished = false;
+};
+
+struct IrradianceProbe {
+  // Irradiance / pi as L1 SH, so an unoccluded probe under a unit sky reads
+  // 1 in every direction: E(n) / pi = l0 + dot(l1, n) per channel.
+  glm::vec3 l0{0.0f};
+  glm::vec3 l1x{0.0f};
+  glm::vec3 l1y{0.0f};
+  glm::vec3 l1z{0.0f};
+  // Same projection for the fraction of rays that escape to the sky.
+  glm::vec4 skyVisibility{0.0f};
+  bool valid = false;
+};
+
+struct IrradianceWritePayload {
+  std::filesystem::path outputPath;
+  IrradianceVolumeInfo info{};
+  uint32_t samplesPerProbe = 0;
+  uint32_t bounceCount = 0;
+  std::vector<IrradianceProbe> probes;
+};
+
+[[nodiscard]] Result<IrradianceBakePlan, std::string>
+planIrradianceVolumeBake(const RuntimeConfig &config,
+                         const IrradianceVolumeBakeRequest &request);
+
+[[nodiscard]] Result<IrradianceSetupProgress, std::string>
+advanceIrradianceVolumeSetup(const IrradianceBakePlan &plan,
+                             IrradianceBakeState &state);
+
+[[nodiscard]] Result<IrradianceStepProgress, std::string>
+pollIrradianceVolumeBake(IrradianceBakeState &state);
+
+[[nodiscard]] IrradianceWritePayload
+collectIrradianceWritePayload(const IrradianceBakePlan &plan,
+                              IrradianceBakeState &state);
+
+void cleanupIrradianceVolumeBake(IrradianceBakeState &state);
+
+[[nodiscard]] Result<bool, std::string>
+writeIrradianceVolumeKtx2(IrradianceWritePayload &payload);
+
+[[nodiscard]] Result<IrradianceVolumeInfo, std::string>
+readIrradianceVolumeInfo(const std::filesystem::path &path);
+
+[[nodiscard]] std::filesystem::path
+irradianceVolumeOutputPath(const RuntimeConfig &config,
+                           const std::filesystem::path &meshPath);
+
+} // namespace nuri::bakery::detail
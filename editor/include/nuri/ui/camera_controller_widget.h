@@ -30,4 +30,8 @@ bool drawScenePresetWidget(std::span<const char *const> presetNames,
                            int &selectedIndex,
                            std::string_view hotkeyHint = "Hotkey: F6");
 
+// Returns true when a new calibration run is requested.
+bool drawRenderQualityWidget(std::string_view status, bool calibrating,
+                             std::string_view hotkeyHint = "Hotkey: F7");
+
 } // namespace nuri
@@ -4,6 +4,7 @@
 
 #include "nuri/bakery/brdf_lut_baker.h"
 #include "nuri/bakery/envmap_prefilter_baker.h"
+#include "nuri/bakery/irradiance_volume_baker.h"
 #include "nuri/core/log.h"
 #include "nuri/core/profiling.h"
 #include "nuri/gfx/gpu_device.h"
@@ -47,10 +48,22 @@ maxWriteCompletionsPerTick(BakeryExecutionProfile profile) {
     return "BRDF LUT";
   case BakeJobKind::EnvmapPrefilter:
     return "Envmap Prefilter";
+  case BakeJobKind::IrradianceVolume:
+    return "Irradiance Volume";
   }
   return "Unknown";
 }
 
+[[nodiscard]] BakeJobKind jobKindFor(const BakeRequest &request) {
+  if (std::holds_alternative<BrdfLutBakeRequest>(request)) {
+    return BakeJobKind::BrdfLut;
+  }
+  if (std::holds_alternative<IrradianceVolumeBakeRequest>(request)) {
+    return BakeJobKind::IrradianceVolume;
+  }
+  return BakeJobKind::EnvmapPrefilter;
+}
+
 [[nodiscard]] uint32_t bakeTileSizeForProfile(BakeryExecutionProfile profile) {
   switch (profile) {
   case BakeryExecutionProfile::Interactive:
@@ -82,6 +95,12 @@ struct BakerySystem::Impl {
     std::optional<detail::EnvWritePayload> payload{};
   };
 
+  struct IrradianceJobData {
+    detail::IrradianceBakePlan plan{};
+    detail::IrradianceBakeState bake{};
+    std::optional<detail::IrradianceWritePayload> payload{};
+  };
+
   struct JobRecord {
     BakeJobId id{};
     BakeRequest request{};
@@ -92,7 +111,8 @@ struct BakerySystem::Impl {
     uint32_t totalSteps = 0;
     std::string summary{};
     std::string error{};
-    std::variant<std::monostate, BrdfJobData, EnvJobData> data{};
+    std::variant<std::monostate, BrdfJobData, EnvJobData, IrradianceJobData>
+        data{};
   };
 
   struct BrdfWriteTask {
@@ -104,9 +124,13 @@ struct BakerySystem::Impl {
     detail::EnvWritePayload payload{};
   };
 
+  struct IrradianceWriteTask {
+    detail::IrradianceWritePayload payload{};
+  };
+
   struct WriteTask {
     BakeJobId jobId{};
-    std::variant<BrdfWriteTask, EnvWriteTask> payload{};
+    std::variant<BrdfWriteTask, EnvWriteTask, IrradianceWriteTask> payload{};
   };
 
   struct WriteCompletion {
@@ -154,9 +178,7 @@ struct BakerySystem::Impl {
     const BakeJobId id{.value = nextJobId++};
     JobRecord job{};
     job.id = id;
-    job.kind = std::holds_alternative<BrdfLutBakeRequest>(request)
-                   ? BakeJobKind::BrdfLut
-                   : BakeJobKind::EnvmapPrefilter;
+    job.kind = jobKindFor(request);
     job.request = std::move(request);
     job.state = BakeJobState::Queued;
     job.summary = "Queued";
@@ -319,6 +341,8 @@ struct BakerySystem::Impl {
                     std::span<const std::byte>(payload.bytes.data(),
                                                payload.bytes.size()),
                     payload.outputPath);
+              } else if constexpr (std::is_same_v<T, IrradianceWriteTask>) {
+                return detail::writeIrradianceVolumeKtx2(payload.payload);
               } else {
                 return detail::writeEnvmapPrefilterOutputs(payload.payload);
               }
@@ -422,6 +446,39 @@ struct BakerySystem::Impl {
         return;
       }
 
+      if (job.kind == BakeJobKind::IrradianceVolume) {
+        const auto *request =
+            std::get_if<IrradianceVolumeBakeRequest>(&job.request);
+        if (request == nullptr) {
+          setFailed(job,
+                    "BakerySystem: irradiance volume request payload mismatch");
+          return;
+        }
+
+        auto planResult = detail::planIrradianceVolumeBake(config, *request);
+        if (planResult.hasError()) {
+          setFailed(job, planResult.error());
+          return;
+        }
+
+        detail::IrradianceBakePlan plan = std::move(planResult.value());
+        if (!plan.shouldBake) {
+          job.state = BakeJobState::Skipped;
+          job.summary = "Up-to-date";
+          job.error.clear();
+          return;
+        }
+
+        IrradianceJobData data{};
+        data.plan = std::move(plan);
+        job.data = std::move(data);
+        job.totalSteps = 0u;
+        job.completedSteps = 0u;
+        job.summary = "Cache check complete";
+        job.state = BakeJobState::GpuSetup;
+        return;
+      }
+
       const auto *request =
           std::get_if<EnvmapPrefilterBakeRequest>(&job.request);
       if (request == nullptr) {
@@ -476,6 +533,28 @@ struct BakerySystem::Impl {
         return;
       }
 
+      if (job.kind == BakeJobKind::IrradianceVolume) {
+        auto *data = std::get_if<IrradianceJobData>(&job.data);
+        if (data == nullptr) {
+          setFailed(job, "BakerySystem: missing irradiance volume job data");
+          return;
+        }
+        auto setupResult =
+            detail::advanceIrradianceVolumeSetup(data->plan, data->bake);
+        if (setupResult.hasError()) {
+          setFailed(job, setupResult.error());
+          return;
+        }
+        job.summary = setupResult.value().summary;
+        if (!setupResult.value().ready) {
+          return;
+        }
+        job.totalSteps = data->bake.totalSteps;
+        job.completedSteps = 0u;
+        job.state = BakeJobState::GpuStep;
+        return;
+      }
+
       auto *data = std::get_if<EnvJobData>(&job.data);
       if (data == nullptr) {
         setFailed(job, "BakerySystem: missing envmap job data");
@@ -533,6 +612,32 @@ struct BakerySystem::Impl {
         return;
       }
 
+      if (job.kind == BakeJobKind::IrradianceVolume) {
+        auto *data = std::get_if<IrradianceJobData>(&job.data);
+        if (data == nullptr) {
+          setFailed(job, "BakerySystem: missing irradiance volume job data");
+          return;
+        }
+        // Probes are traced on the baker's own threads; a step only polls.
+        auto pollResult = detail::pollIrradianceVolumeBake(data->bake);
+        if (pollResult.hasError()) {
+          setFailed(job, pollResult.error());
+          return;
+        }
+        job.completedSteps = pollResult.value().completedSteps;
+        job.totalSteps = pollResult.value().totalSteps;
+        if (!pollResult.value().finished) {
+          job.summary = "CPU bake in progress";
+          return;
+        }
+        data->payload =
+            detail::collectIrradianceWritePayload(data->plan, data->bake);
+        detail::cleanupIrradianceVolumeBake(data->bake);
+        job.state = BakeJobState::WriteQueued;
+        job.summary = "CPU bake complete";
+        return;
+      }
+
       auto *data = std::get_if<EnvJobData>(&job.data);
       if (data == nullptr) {
         setFailed(job, "BakerySystem: missing envmap job data");
@@ -586,6 +691,16 @@ struct BakerySystem::Impl {
           .outputPath = data->plan.outputPath,
           .bytes = std::move(data->outputBytes),
       };
+    } else if (job.kind == BakeJobKind::IrradianceVolume) {
+      auto *data = std::get_if<IrradianceJobData>(&job.data);
+      if (data == nullptr || !data->payload.has_value()) {
+        setFailed(job, "BakerySystem: missing irradiance volume write payload");
+        return;
+      }
+      task.payload = IrradianceWriteTask{
+          .payload = std::move(*data->payload),
+      };
+      data->payload.reset();
     } else {
       auto *data = std::get_if<EnvJobData>(&job.data);
       if (data == nullptr || !data->payload.has_value()) {
@@ -627,6 +742,14 @@ struct BakerySystem::Impl {
       return;
     }
 
+    if (job.kind == BakeJobKind::IrradianceVolume) {
+      if (auto *data = std::get_if<IrradianceJobData>(&job.data);
+          data != nullptr) {
+        detail::cleanupIrradianceVolumeBake(data->bake);
+      }
+      return;
+    }
+
     if (auto *data = std::get_if<EnvJobData>(&job.data); data != nullptr) {
       detail::cleanupEnvmapPrefilterBake(*gpu, data->gpu);
     }
@@ -0,0 +1,1061 @@
+#include "nuri/editor_pch.h"
+
+#include "nuri/bakery/irradiance_volume_baker.h"
+
+#include "nuri/core/log.h"
+#include "nuri/core/profiling.h"
+#include "nuri/resources/mesh_importer.h"
+#include "nuri/resources/storage/mesh/mesh_binary_serializer.h"
+#include "nuri/resources/storage/mesh/mesh_cache_utils.h"
+
+#include <ktx.h>
+#include <vulkan/vulkan_core.h>
+
+namespace nuri::bakery::detail {
+namespace {
+
+constexpr const char *kVolumeMetadataKey = "nuriIrradianceVolume";
+constexpr std::string_view kOutputSuffix = "_irradiance_volume.ktx2";
+constexpr std::string_view kCachedMeshExtension = ".nmesh";
+constexpr uint32_t kMaxProbesPerAxis = 64u;
+constexpr uint32_t kMinSamplesPerProbe = 16u;
+constexpr uint32_t kMaxSamplesPerProbe = 16384u;
+constexpr uint32_t kMaxBounceCount = 8u;
+constexpr uint32_t kMaxWorkerThreads = 16u;
+constexpr uint32_t kBvhLeafTriangles = 4u;
+constexpr uint32_t kBvhStackSize = 64u;
+// One texel row band per SH coefficient: l0, l1x, l1y, l1z.
+constexpr uint32_t kCoefficientCount = 4u;
+// Probes that see mostly back faces sit inside geometry.
+constexpr float kMaxBackfaceRatio = 0.25f;
+constexpr float kRayOffsetScale = 1.0e-4f;
+constexpr glm::vec3 kDefaultAlbedo{0.5f};
+constexpr std::array<std::array<int, 3>, 6> kFaceNeighbourOffsets = {{
+    {-1, 0, 0},
+    {1, 0, 0},
+    {0, -1, 0},
+    {0, 1, 0},
+    {0, 0, -1},
+    {0, 0, 1},
+}};
+
+struct BvhNode {
+  glm::vec3 boundsMin{0.0f};
+  // Interior nodes keep their two children at leftOrFirst and leftOrFirst + 1,
+  // leaves the first of triangleCount triangles.
+  uint32_t leftOrFirst = 0;
+  glm::vec3 boundsMax{0.0f};
+  uint32_t triangleCount = 0;
+};
+
+struct Triangle {
+  glm::vec3 v0{0.0f};
+  glm::vec3 edge1{0.0f};
+  glm::vec3 edge2{0.0f};
+  glm::vec3 albedo{kDefaultAlbedo};
+};
+
+struct RayHit {
+  float t = 0.0f;
+  uint32_t triangle = 0;
+};
+
+// PCG32, seeded per probe so results do not depend on the thread count.
+struct Rng {
+  uint64_t state = 0;
+  uint64_t increment = 0;
+
+  Rng(uint64_t seed, uint64_t sequence)
+      : increment((sequence << 1u) | 1u) {
+    nextU32();
+    state += seed;
+    nextU32();
+  }
+
+  uint32_t nextU32() {
+    const uint64_t oldState = state;
+    state = oldState * 6364136223846793005ull + increment;
+    const auto xorShifted =
+        static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+    const auto rotation = static_cast<uint32_t>(oldState >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((~rotation + 1u) & 31u));
+  }
+
+  float nextFloat() {
+    return static_cast<float>(nextU32() >> 8u) * (1.0f / 16777216.0f);
+  }
+};
+
+glm::vec3 sampleUniformSphere(Rng &rng) {
+  const float z = 1.0f - 2.0f * rng.nextFloat();
+  const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+  const float phi = glm::two_pi<float>() * rng.nextFloat();
+  return glm::vec3(r * std::cos(phi), r * std::sin(phi), z);
+}
+
+glm::vec3 sampleCosineHemisphere(const glm::vec3 &normal, Rng &rng) {
+  const float r = std::sqrt(rng.nextFloat());
+  const float phi = glm::two_pi<float>() * rng.nextFloat();
+  const float x = r * std::cos(phi);
+  const float y = r * std::sin(phi);
+  const float z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+
+  const float sign = std::copysign(1.0f, normal.z);
+  const float a = -1.0f / (sign + normal.z);
+  const float b = normal.x * normal.y * a;
+  const glm::vec3 tangent(1.0f + sign * normal.x * normal.x * a, sign * b,
+                          -sign * normal.x);
+  const glm::vec3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+  return tangent * x + bitangent * y + normal * z;
+}
+
+glm::vec3 triangleCentroid(const Triangle &triangle) {
+  return triangle.v0 + (triangle.edge1 + triangle.edge2) * (1.0f / 3.0f);
+}
+
+void growBounds(const Triangle &triangle, glm::vec3 &boundsMin,
+                glm::vec3 &boundsMax) {
+  const std::array<glm::vec3, 3> vertices = {
+      triangle.v0, triangle.v0 + triangle.edge1, triangle.v0 + triangle.edge2};
+  for (const glm::vec3 &vertex : vertices) {
+    boundsMin = glm::min(boundsMin, vertex);
+    boundsMax = glm::max(boundsMax, vertex);
+  }
+}
+
+// Median split on the longest centroid axis. Cheaper to build than SAH and
+// good enough for a bake that traces a few million rays.
+std::vector<BvhNode> buildBvh(std::vector<Triangle> &triangles) {
+  struct BuildTask {
+    uint32_t node = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+  };
+
+  std::vector<BvhNode> nodes;
+  nodes.reserve(triangles.size() / 2u + 1u);
+  nodes.push_back(BvhNode{});
+  std::vector<BuildTask> tasks;
+  tasks.push_back(BuildTask{
+      .node = 0u, .count = static_cast<uint32_t>(triangles.size())});
+
+  while (!tasks.empty()) {
+    const BuildTask task = tasks.back();
+    tasks.pop_back();
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    glm::vec3 centroidMin(std::numeric_limits<float>::max());
+    glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+    for (uint32_t i = task.first; i < task.first + task.count; ++i) {
+      growBounds(triangles[i], boundsMin, boundsMax);
+      const glm::vec3 centroid = triangleCentroid(triangles[i]);
+      centroidMin = glm::min(centroidMin, centroid);
+      centroidMax = glm::max(centroidMax, centroid);
+    }
+    nodes[task.node].boundsMin = boundsMin;
+    nodes[task.node].boundsMax = boundsMax;
+
+    const glm::vec3 centroidExtent = centroidMax - centroidMin;
+    int axis = 0;
+    if (centroidExtent.y > centroidExtent.x) {
+      axis = 1;
+    }
+    if (centroidExtent.z > centroidExtent[axis]) {
+      axis = 2;
+    }
+    if (task.count <= kBvhLeafTriangles || centroidExtent[axis] <= 0.0f) {
+      nodes[task.node].leftOrFirst = task.first;
+      nodes[task.node].triangleCount = task.count;
+      continue;
+    }
+
+    const uint32_t leftCount = task.count / 2u;
+    const auto first = triangles.begin() + task.first;
+    std::nth_element(first, first + leftCount, first + task.count,
+                     [axis](const Triangle &lhs, const Triangle &rhs) {
+                       return triangleCentroid(lhs)[axis] <
+                              triangleCentroid(rhs)[axis];
+                     });
+
+    const auto leftChild = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(BvhNode{});
+    nodes.push_back(BvhNode{});
+    nodes[task.node].leftOrFirst = leftChild;
+    nodes[task.node].triangleCount = 0u;
+    tasks.push_back(BuildTask{
+        .node = leftChild, .first = task.first, .count = leftCount});
+    tasks.push_back(BuildTask{.node = leftChild + 1u,
+                              .first = task.first + leftCount,
+                              .count = task.count - leftCount});
+  }
+  return nodes;
+}
+
+bool intersectBounds(const BvhNode &node, const glm::vec3 &origin,
+                     const glm::vec3 &invDirection, float tMax,
+                     float &outTNear) {
+  const glm::vec3 t0 = (node.boundsMin - origin) * invDirection;
+  const glm::vec3 t1 = (node.boundsMax - origin) * invDirection;
+  const glm::vec3 tSmall = glm::min(t0, t1);
+  const glm::vec3 tLarge = glm::max(t0, t1);
+  const float tNear = std::max(std::max(tSmall.x, tSmall.y), tSmall.z);
+  const float tFar = std::min(std::min(tLarge.x, tLarge.y), tLarge.z);
+  outTNear = tNear;
+  return tNear <= tFar && tFar >= 0.0f && tNear < tMax;
+}
+
+bool intersectTriangle(const Triangle &triangle, const glm::vec3 &origin,
+                       const glm::vec3 &direction, float &inOutT) {
+  const glm::vec3 pvec = glm::cross(direction, triangle.edge2);
+  const float det = glm::dot(triangle.edge1, pvec);
+  if (std::abs(det) < 1.0e-12f) {
+    return false;
+  }
+  const float invDet = 1.0f / det;
+  const glm::vec3 tvec = origin - triangle.v0;
+  const float u = glm::dot(tvec, pvec) * invDet;
+  if (u < 0.0f || u > 1.0f) {
+    return false;
+  }
+  const glm::vec3 qvec = glm::cross(tvec, triangle.edge1);
+  const float v = glm::dot(direction, qvec) * invDet;
+  if (v < 0.0f || u + v > 1.0f) {
+    return false;
+  }
+  const float t = glm::dot(triangle.edge2, qvec) * invDet;
+  if (t <= 0.0f || t >= inOutT) {
+    return false;
+  }
+  inOutT = t;
+  return true;
+}
+
+} // namespace
+
+struct IrradianceBakeRuntime {
+  std::vector<Triangle> triangles;
+  std::vector<BvhNode> nodes;
+  IrradianceVolumeInfo info{};
+  uint32_t samplesPerProbe = 0;
+  uint32_t bounceCount = 0;
+  float rayOffset = 0.0f;
+  std::vector<IrradianceProbe> probes;
+  std::atomic<uint32_t> nextProbe{0};
+  std::atomic<uint32_t> completedProbes{0};
+  std::vector<std::jthread> workers;
+
+  ~IrradianceBakeRuntime() { stop(); }
+
+  void stop() {
+    for (std::jthread &worker : workers) {
+      worker.request_stop();
+    }
+    workers.clear();
+  }
+
+  [[nodiscard]] bool intersect(const glm::vec3 &origin,
+                               const glm::vec3 &direction,
+                               RayHit &outHit) const {
+    if (nodes.empty()) {
+      return false;
+    }
+    const glm::vec3 invDirection(1.0f / direction.x, 1.0f / direction.y,
+                                 1.0f / direction.z);
+    float closestT = std::numeric_limits<float>::max();
+    bool hit = false;
+    std::array<uint32_t, kBvhStackSize> stack{};
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0u;
+    while (stackSize > 0u) {
+      const BvhNode &node = nodes[stack[--stackSize]];
+      float tNear = 0.0f;
+      if (!intersectBounds(node, origin, invDirection, closestT, tNear)) {
+        continue;
+      }
+      if (node.triangleCount > 0u) {
+        for (uint32_t i = 0; i < node.triangleCount; ++i) {
+          const uint32_t triangleIndex = node.leftOrFirst + i;
+          if (intersectTriangle(triangles[triangleIndex], origin, direction,
+                                closestT)) {
+            outHit.triangle = triangleIndex;
+            hit = true;
+          }
+        }
+        continue;
+      }
+      if (stackSize + 2u > kBvhStackSize) {
+        continue;
+      }
+      // Visit the nearer child first so closestT shrinks early.
+      uint32_t nearChild = node.leftOrFirst;
+      uint32_t farChild = node.leftOrFirst + 1u;
+      float nearT = 0.0f;
+      float farT = 0.0f;
+      const bool nearHit = intersectBounds(nodes[nearChild], origin,
+                                           invDirection, closestT, nearT);
+      const bool farHit = intersectBounds(nodes[farChild], origin,
+                                          invDirection, closestT, farT);
+      if (nearHit && farHit && farT < nearT) {
+        std::swap(nearChild, farChild);
+      }
+      if (farHit || nearHit) {
+        if (nearHit && farHit) {
+          stack[stackSize++] = farChild;
+          stack[stackSize++] = nearChild;
+        } else {
+          stack[stackSize++] = nearHit ? nearChild : farChild;
+        }
+      }
+    }
+    outHit.t = closestT;
+    return hit;
+  }
+
+  [[nodiscard]] glm::vec3 probePosition(uint32_t probeIndex) const {
+    const glm::uvec3 counts = info.probeCounts;
+    const glm::uvec3 cell(probeIndex % counts.x,
+                          (probeIndex / counts.x) % counts.y,
+                          probeIndex / (counts.x * counts.y));
+    const glm::vec3 t = (glm::vec3(cell) + glm::vec3(0.5f)) / glm::vec3(counts);
+    return info.boundsMin + (info.boundsMax - info.boundsMin) * t;
+  }
+
+  // Radiance arriving along -direction with a unit white sky and diffuse
+  // bounces off the scene albedo.
+  [[nodiscard]] glm::vec3 traceRadiance(glm::vec3 origin, glm::vec3 direction,
+                                        Rng &rng, bool &outEscaped,
+                                        bool &outBackface) const {
+    glm::vec3 throughput(1.0f);
+    outEscaped = false;
+    outBackface = false;
+    for (uint32_t bounce = 0; bounce <= bounceCount; ++bounce) {
+      RayHit hit{};
+      if (!intersect(origin, direction, hit)) {
+        outEscaped = bounce == 0u;
+        return throughput;
+      }
+      const Triangle &triangle = triangles[hit.triangle];
+      glm::vec3 normal =
+          glm::normalize(glm::cross(triangle.edge1, triangle.edge2));
+      if (glm::dot(normal, direction) > 0.0f) {
+        outBackface = outBackface || bounce == 0u;
+        normal = -normal;
+      }
+      if (bounce == bounceCount) {
+        break;
+      }
+      throughput *= triangle.albedo;
+      origin = origin + direction * hit.t + normal * rayOffset;
+      direction = sampleCosineHemisphere(normal, rng);
+    }
+    return glm::vec3(0.0f);
+  }
+
+  void bakeProbe(uint32_t probeIndex) {
+    Rng rng(0x853c49e6748fea9bull ^ probeIndex, probeIndex);
+    const glm::vec3 origin = probePosition(probeIndex);
+    glm::vec3 sum0(0.0f);
+    glm::vec3 sumX(0.0f);
+    glm::vec3 sumY(0.0f);
+    glm::vec3 sumZ(0.0f);
+    glm::vec4 skySum(0.0f);
+    uint32_t backfaceCount = 0;
+    for (uint32_t sample = 0; sample < samplesPerProbe; ++sample) {
+      const glm::vec3 direction = sampleUniformSphere(rng);
+      bool escaped = false;
+      bool backface = false;
+      const glm::vec3 radiance =
+          traceRadiance(origin, direction, rng, escaped, backface);
+      sum0 += radiance;
+      sumX += radiance * direction.x;
+      sumY += radiance * direction.y;
+      sumZ += radiance * direction.z;
+      if (escaped) {
+        skySum += glm::vec4(1.0f, direction);
+      }
+      if (backface) {
+        ++backfaceCount;
+      }
+    }
+
+    // Monte Carlo L1 projection folded with the cosine lobe:
+    // E(n) / pi = mean(L) + dot(2 * mean(L * w), n).
+    const float invSamples = 1.0f / static_cast<float>(samplesPerProbe);
+    IrradianceProbe &probe = probes[probeIndex];
+    probe.l0 = sum0 * invSamples;
+    probe.l1x = sumX * (2.0f * invSamples);
+    probe.l1y = sumY * (2.0f * invSamples);
+    probe.l1z = sumZ * (2.0f * invSamples);
+    probe.skyVisibility = glm::vec4(skySum.x * invSamples,
+                                    skySum.y * (2.0f * invSamples),
+                                    skySum.z * (2.0f * invSamples),
+                                    skySum.w * (2.0f * invSamples));
+    probe.valid = static_cast<float>(backfaceCount) * invSamples <=
+                  kMaxBackfaceRatio;
+  }
+
+  void workerLoop(std::stop_token stopToken) {
+    NURI_PROFILER_THREAD("IrradianceBakeWorker");
+    const auto probeCount = static_cast<uint32_t>(probes.size());
+    while (!stopToken.stop_requested()) {
+      const uint32_t probeIndex =
+          nextProbe.fetch_add(1u, std::memory_order_relaxed);
+      if (probeIndex >= probeCount) {
+        return;
+      }
+      bakeProbe(probeIndex);
+      completedProbes.fetch_add(1u, std::memory_order_release);
+    }
+  }
+
+  void start() {
+    const uint32_t hardwareThreads =
+        std::max(1u, std::thread::hardware_concurrency());
+    // Leave a core for the editor's main thread.
+    const uint32_t workerCount =
+        std::clamp(hardwareThreads - 1u, 1u, kMaxWorkerThreads);
+    workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+      workers.emplace_back(
+          [this](std::stop_token stopToken) { workerLoop(stopToken); });
+    }
+  }
+};
+
+namespace {
+
+Result<bool, std::string> appendMeshTriangles(
+    std::span<const glm::vec3> positions, std::span<const uint32_t> indices,
+    std::span<const Submesh> submeshes, std::span<const glm::vec3> albedos,
+    std::span<const uint8_t> skipMaterial, std::vector<Triangle> &out) {
+  for (const Submesh &submesh : submeshes) {
+    const uint32_t materialIndex = submesh.materialIndex;
+    if (materialIndex < skipMaterial.size() &&
+        skipMaterial[materialIndex] != 0u) {
+      continue;
+    }
+    const glm::vec3 albedo = materialIndex < albedos.size()
+                                 ? albedos[materialIndex]
+                                 : kDefaultAlbedo;
+    const uint64_t end = static_cast<uint64_t>(submesh.indexOffset) +
+                         static_cast<uint64_t>(submesh.indexCount);
+    if (end > indices.size()) {
+      return Result<bool, std::string>::makeError(
+          "Irradiance volume baker: submesh index range is out of bounds");
+    }
+    for (uint32_t i = submesh.indexOffset; i + 2u < end; i += 3u) {
+      const uint32_t i0 = indices[i];
+      const uint32_t i1 = indices[i + 1u];
+      const uint32_t i2 = indices[i + 2u];
+      if (i0 >= positions.size() || i1 >= positions.size() ||
+          i2 >= positions.size()) {
+        return Result<bool, std::string>::makeError(
+            "Irradiance volume baker: vertex index is out of bounds");
+      }
+      Triangle triangle{};
+      triangle.v0 = positions[i0];
+      triangle.edge1 = positions[i1] - positions[i0];
+      triangle.edge2 = positions[i2] - positions[i0];
+      triangle.albedo = albedo;
+      const glm::vec3 areaVector =
+          glm::cross(triangle.edge1, triangle.edge2);
+      if (glm::dot(areaVector, areaVector) <= 0.0f) {
+        continue;
+      }
+      out.push_back(triangle);
+    }
+  }
+  return Result<bool, std::string>::makeResult(true);
+}
+
+// NURIMESH caches carry positions in the first three words of every packed
+// vertex but no materials, so cached meshes bake with the default albedo.
+Result<std::vector<Triangle>, std::string>
+loadCachedMeshTriangles(const std::filesystem::path &path) {
+  auto bytesResult = readBinaryFile(path);
+  if (bytesResult.hasError()) {
+    return Result<std::vector<Triangle>, std::string>::makeError(
+        "Irradiance volume baker: " + bytesResult.error());
+  }
+  auto decodedResult = meshBinaryDeserialize(bytesResult.value(),
+                                             MeshBinaryDeserializeContext{});
+  if (decodedResult.hasError()) {
+    return Result<std::vector<Triangle>, std::string>::makeError(
+        "Irradiance volume baker: failed to decode '" + path.string() +
+        "': " + decodedResult.error().message);
+  }
+  const MeshBinaryDecodedMesh &mesh = decodedResult.value();
+  if (mesh.vertexStrideBytes < sizeof(glm::vec3) ||
+      mesh.packedVertexBytes.size() <
+          static_cast<size_t>(mesh.vertexCount) * mesh.vertexStrideBytes) {
+    return Result<std::vector<Triangle>, std::string>::makeError(
+        "Irradiance volume baker: invalid vertex data in '" + path.string() +
+        "'");
+  }
+
+  std::vector<glm::vec3> positions(mesh.vertexCount);
+  for (uint32_t i = 0; i < mesh.vertexCount; ++i) {
+    std::memcpy(&positions[i],
+                mesh.packedVertexBytes.data() +
+                    static_cast<size_t>(i) * mesh.vertexStrideBytes,
+                sizeof(glm::vec3));
+  }
+
+  std::vector<Triangle> triangles;
+  triangles.reserve(mesh.indices.size() / 3u);
+  auto appendResult = appendMeshTriangles(positions, mesh.indices,
+                                          mesh.submeshes, {}, {}, triangles);
+  if (appendResult.hasError()) {
+    return Result<std::vector<Triangle>, std::string>::makeError(
+        appendResult.error());
+  }
+  return Result<std::vector<Triangle>, std::string>::makeResult(
+      std::move(triangles));
+}
+
+Result<std::vector<Triangle>, std::string>
+loadSourceMeshTriangles(const std::filesystem::path &path) {
+  MeshImportOptions options{};
+  options.genTangents = false;
+  options.genUVCoords = false;
+  options.generateLods = false;
+  options.lodCount = 1u;
+  const std::string pathString = path.string();
+  auto meshResult = MeshImporter::loadFromFile(pathString, options);
+  if (meshResult.hasError()) {
+    return Result<std::vector<Triangle>, std::string>::makeError(
+        "Irradiance volume baker: failed to import '" + pathString +
+        "': " + meshResult.error());
+  }
+  const MeshData &mesh = meshResult.value();
+
+  // Base color factors stand in for albedo; textures are not sampled.
+  // Blended materials let light through and are left out.
+  std::vector<glm::vec3> albedos;
+  std::vector<uint8_t> skipMaterial;
+  auto materialsResult = MeshImporter::loadMaterialInfoFromFile(pathString);
+  if (materialsResult.hasError()) {
+    NURI_LOG_WARNING("Irradiance volume baker: no materials for '%s', using "
+                     "default albedo: %s",
+                     pathString.c_str(), materialsResult.error().c_str());
+  } else {
+    for (const MaterialData &material : materialsResult.value().materials) {
+      albedos.push_back(glm::clamp(glm::vec3(material.baseColorFactor),
+                                   glm::vec3(0.0f), glm::vec3(0.95f)));
+      skipMaterial.push_back(
+          material.alphaMode == MaterialAlphaMode::Blend ? 1u : 0u);
+    }
+  }
+
+  std::vector<glm::vec3> positions;
+  positions.reserve(mesh.vertices.size());
+  for (const Vertex &vertex : mesh.vertices) {
+    positions.push_back(vertex.position);
+  }
+
+  std::vector<Triangle> triangles;
+  triangles.reserve(mesh.indices.size() / 3u);
+  auto appendResult =
+      appendMeshTriangles(positions, mesh.indices, mesh.submeshes, albedos,
+                          skipMaterial, triangles);
+  if (appendResult.hasError()) {
+    return Result<std::vector<Triangle>, std::string>::makeError(
+        appendResult.error());
+  }
+  return Result<std::vector<Triangle>, std::string>::makeResult(
+      std::move(triangles));
+}
+
+IrradianceSceneLoadResult loadBakeScene(const IrradianceBakePlan &plan) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  const bool isCachedMesh = plan.meshPath.extension() == kCachedMeshExtension;
+  auto trianglesResult = isCachedMesh
+                             ? loadCachedMeshTriangles(plan.meshPath)
+                             : loadSourceMeshTriangles(plan.meshPath);
+  if (trianglesResult.hasError()) {
+    return IrradianceSceneLoadResult::makeError(trianglesResult.error());
+  }
+  if (trianglesResult.value().empty()) {
+    return IrradianceSceneLoadResult::makeError(
+        "Irradiance volume baker: mesh '" + plan.meshPath.string() +
+        "' has no triangles");
+  }
+
+  auto runtime = std::make_shared<IrradianceBakeRuntime>();
+  runtime->triangles = std::move(trianglesResult.value());
+  runtime->nodes = buildBvh(runtime->triangles);
+  runtime->info.boundsMin = runtime->nodes.front().boundsMin;
+  runtime->info.boundsMax = runtime->nodes.front().boundsMax;
+  runtime->info.probeCounts = plan.probeCounts;
+  runtime->samplesPerProbe = plan.samplesPerProbe;
+  runtime->bounceCount = plan.bounceCount;
+  runtime->rayOffset =
+      kRayOffsetScale *
+      std::max(glm::length(runtime->info.boundsMax - runtime->info.boundsMin),
+               1.0f);
+  runtime->probes.resize(static_cast<size_t>(plan.probeCounts.x) *
+                         plan.probeCounts.y * plan.probeCounts.z);
+  return IrradianceSceneLoadResult::makeResult(std::move(runtime));
+}
+
+struct VolumeMetadata {
+  IrradianceVolumeInfo info{};
+  uint32_t samplesPerProbe = 0;
+  uint32_t bounceCount = 0;
+};
+
+Result<VolumeMetadata, std::string>
+readVolumeMetadata(const std::filesystem::path &path) {
+  ktxTexture2 *texture = nullptr;
+  const std::string pathString = path.string();
+  const auto createError = ktxTexture2_CreateFromNamedFile(
+      pathString.c_str(), KTX_TEXTURE_CREATE_NO_FLAGS, &texture);
+  if (createError != KTX_SUCCESS || texture == nullptr) {
+    return Result<VolumeMetadata, std::string>::makeError(
+        "Irradiance volume: failed to open '" + pathString + "'");
+  }
+
+  unsigned int valueLength = 0;
+  void *value = nullptr;
+  const auto findError = ktxHashList_FindValue(
+      &texture->kvDataHead, kVolumeMetadataKey, &valueLength, &value);
+  std::string text;
+  if (findError == KTX_SUCCESS && value != nullptr) {
+    text.assign(static_cast<const char *>(value),
+                strnlen(static_cast<const char *>(value), valueLength));
+  }
+  const uint32_t width = texture->baseWidth;
+  const uint32_t height = texture->baseHeight;
+  ktxTexture_Destroy(ktxTexture(texture));
+
+  VolumeMetadata metadata{};
+  IrradianceVolumeInfo &info = metadata.info;
+  const int parsed = std::sscanf(
+      text.c_str(), "%f %f %f %f %f %f %u %u %u %u %u", &info.boundsMin.x,
+      &info.boundsMin.y, &info.boundsMin.z, &info.boundsMax.x,
+      &info.boundsMax.y, &info.boundsMax.z, &info.probeCounts.x,
+      &info.probeCounts.y, &info.probeCounts.z, &metadata.samplesPerProbe,
+      &metadata.bounceCount);
+  if (parsed != 11 || info.probeCounts.x == 0u || info.probeCounts.y == 0u ||
+      info.probeCounts.z == 0u ||
+      width != info.probeCounts.x * info.probeCounts.z ||
+      height != info.probeCounts.y * kCoefficientCount) {
+    return Result<VolumeMetadata, std::string>::makeError(
+        "Irradiance volume: '" + pathString + "' has no valid volume metadata");
+  }
+  return Result<VolumeMetadata, std::string>::makeResult(metadata);
+}
+
+// Invalid probes take the average of their valid face neighbours, growing
+// outwards from the valid ones. Whatever stays unreachable reads as open sky.
+void fillInvalidProbes(const glm::uvec3 &counts,
+                       std::vector<IrradianceProbe> &probes) {
+  const auto indexOf = [&counts](uint32_t x, uint32_t y, uint32_t z) {
+    return static_cast<size_t>(x) +
+           static_cast<size_t>(counts.x) *
+               (static_cast<size_t>(y) + static_cast<size_t>(counts.y) * z);
+  };
+  const uint32_t maxPasses = counts.x + counts.y + counts.z;
+  for (uint32_t pass = 0; pass < maxPasses; ++pass) {
+    std::vector<IrradianceProbe> next = probes;
+    bool changed = false;
+    bool anyInvalid = false;
+    for (uint32_t z = 0; z < counts.z; ++z) {
+      for (uint32_t y = 0; y < counts.y; ++y) {
+        for (uint32_t x = 0; x < counts.x; ++x) {
+          IrradianceProbe &target = next[indexOf(x, y, z)];
+          if (target.valid) {
+            continue;
+          }
+          anyInvalid = true;
+          IrradianceProbe sum{};
+          uint32_t validCount = 0;
+          for (const auto &offset : kFaceNeighbourOffsets) {
+            const int nx = static_cast<int>(x) + offset[0];
+            const int ny = static_cast<int>(y) + offset[1];
+            const int nz = static_cast<int>(z) + offset[2];
+            if (nx < 0 || ny < 0 || nz < 0 ||
+                nx >= static_cast<int>(counts.x) ||
+                ny >= static_cast<int>(counts.y) ||
+                nz >= static_cast<int>(counts.z)) {
+              continue;
+            }
+            const IrradianceProbe &neighbour =
+                probes[indexOf(static_cast<uint32_t>(nx),
+                               static_cast<uint32_t>(ny),
+                               static_cast<uint32_t>(nz))];
+            if (!neighbour.valid) {
+              continue;
+            }
+            sum.l0 += neighbour.l0;
+            sum.l1x += neighbour.l1x;
+            sum.l1y += neighbour.l1y;
+            sum.l1z += neighbour.l1z;
+            sum.skyVisibility += neighbour.skyVisibility;
+            ++validCount;
+          }
+          if (validCount == 0u) {
+            continue;
+          }
+          const float invCount = 1.0f / static_cast<float>(validCount);
+          target.l0 = sum.l0 * invCount;
+          target.l1x = sum.l1x * invCount;
+          target.l1y = sum.l1y * invCount;
+          target.l1z = sum.l1z * invCount;
+          target.skyVisibility = sum.skyVisibility * invCount;
+          target.valid = true;
+          changed = true;
+        }
+      }
+    }
+    probes = std::move(next);
+    if (!anyInvalid || !changed) {
+      break;
+    }
+  }
+
+  for (IrradianceProbe &probe : probes) {
+    if (!probe.valid) {
+      probe = IrradianceProbe{.l0 = glm::vec3(1.0f),
+                              .skyVisibility = glm::vec4(1.0f, 0.0f, 0.0f,
+                                                         0.0f),
+                              .valid = true};
+    }
+  }
+}
+
+} // namespace
+
+Result<IrradianceBakePlan, std::string>
+planIrradianceVolumeBake(const RuntimeConfig &config,
+                         const IrradianceVolumeBakeRequest &request) {
+  IrradianceBakePlan plan{};
+  if (request.meshPath.empty()) {
+    return Result<IrradianceBakePlan, std::string>::makeError(
+        "Irradiance volume baker: mesh path is empty");
+  }
+  plan.meshPath = request.meshPath;
+  std::error_code ec;
+  if (plan.meshPath.is_relative() &&
+      !std::filesystem::exists(plan.meshPath, ec)) {
+    plan.meshPath = config.roots.models / request.meshPath;
+  }
+  ec.clear();
+  if (!std::filesystem::is_regular_file(plan.meshPath, ec)) {
+    return Result<IrradianceBakePlan, std::string>::makeError(
+        "Irradiance volume baker: mesh does not exist: '" +
+        request.meshPath.string() + "'");
+  }
+
+  for (const uint32_t count : request.probeCounts) {
+    if (count == 0u || count > kMaxProbesPerAxis) {
+      return Result<IrradianceBakePlan, std::string>::makeError(
+          "Irradiance volume baker: probe counts must be in [1, " +
+          std::to_string(kMaxProbesPerAxis) + "]");
+    }
+  }
+  if (request.samplesPerProbe < kMinSamplesPerProbe ||
+      request.samplesPerProbe > kMaxSamplesPerProbe) {
+    return Result<IrradianceBakePlan, std::string>::makeError(
+        "Irradiance volume baker: samples per probe must be in [" +
+        std::to_string(kMinSamplesPerProbe) + ", " +
+        std::to_string(kMaxSamplesPerProbe) + "]");
+  }
+  if (request.bounceCount > kMaxBounceCount) {
+    return Result<IrradianceBakePlan, std::string>::makeError(
+        "Irradiance volume baker: bounce count must be at most " +
+        std::to_string(kMaxBounceCount));
+  }
+
+  plan.outputPath = irradianceVolumeOutputPath(config, plan.meshPath);
+  plan.probeCounts = glm::uvec3(request.probeCounts[0], request.probeCounts[1],
+                                request.probeCounts[2]);
+  plan.samplesPerProbe = request.samplesPerProbe;
+  plan.bounceCount = request.bounceCount;
+
+  if (request.forceRebuild) {
+    plan.shouldBake = true;
+    return Result<IrradianceBakePlan, std::string>::makeResult(std::move(plan));
+  }
+
+  ec.clear();
+  if (std::filesystem::exists(plan.outputPath, ec)) {
+    std::error_code ecMesh;
+    const auto meshWriteTime =
+        std::filesystem::last_write_time(plan.meshPath, ecMesh);
+    std::error_code ecKtx2;
+    const auto ktx2WriteTime =
+        std::filesystem::last_write_time(plan.outputPath, ecKtx2);
+    auto metadataResult = readVolumeMetadata(plan.outputPath);
+    if (!ecMesh && !ecKtx2 && meshWriteTime <= ktx2WriteTime &&
+        !metadataResult.hasError() &&
+        metadataResult.value().info.probeCounts == plan.probeCounts &&
+        metadataResult.value().samplesPerProbe == plan.samplesPerProbe &&
+        metadataResult.value().bounceCount == plan.bounceCount) {
+      plan.shouldBake = false;
+      return Result<IrradianceBakePlan, std::string>::makeResult(
+          std::move(plan));
+    }
+  }
+
+  plan.shouldBake = true;
+  return Result<IrradianceBakePlan, std::string>::makeResult(std::move(plan));
+}
+
+Result<IrradianceSetupProgress, std::string>
+advanceIrradianceVolumeSetup(const IrradianceBakePlan &plan,
+                             IrradianceBakeState &state) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  switch (state.setupPhase) {
+  case IrradianceSetupPhase::StartSceneLoad: {
+    cleanupIrradianceVolumeBake(state);
+    try {
+      state.sceneLoadFuture =
+          std::async(std::launch::async,
+                     [plan]() { return loadBakeScene(plan); })
+              .share();
+    } catch (const std::exception &e) {
+      return Result<IrradianceSetupProgress, std::string>::makeError(
+          std::string("Irradiance volume baker: failed to launch scene "
+                      "load: ") +
+          e.what());
+    } catch (...) {
+      return Result<IrradianceSetupProgress, std::string>::makeError(
+          "Irradiance volume baker: failed to launch scene load");
+    }
+    state.sceneLoadInFlight = true;
+    state.setupPhase = IrradianceSetupPhase::WaitSceneLoad;
+    return Result<IrradianceSetupProgress, std::string>::makeResult(
+        IrradianceSetupProgress{.summary = "Building BVH (CPU)"});
+  }
+
+  case IrradianceSetupPhase::WaitSceneLoad: {
+    if (!state.sceneLoadInFlight || !state.sceneLoadFuture.valid()) {
+      return Result<IrradianceSetupProgress, std::string>::makeError(
+          "Irradiance volume baker: scene load future is invalid");
+    }
+    if (state.sceneLoadFuture.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return Result<IrradianceSetupProgress, std::string>::makeResult(
+          IrradianceSetupProgress{.summary = "Building BVH (CPU)"});
+    }
+
+    IrradianceSceneLoadResult loadResult = state.sceneLoadFuture.get();
+    state.sceneLoadInFlight = false;
+    state.sceneLoadFuture = {};
+    if (loadResult.hasError()) {
+      return Result<IrradianceSetupProgress, std::string>::makeError(
+          loadResult.error());
+    }
+    state.runtime = std::move(loadResult.value());
+    state.totalSteps = static_cast<uint32_t>(state.runtime->probes.size());
+    state.completedSteps = 0u;
+    NURI_LOG_INFO("Irradiance volume baker: %zu triangles, %zu BVH nodes, "
+                  "%u probes x %u samples",
+                  state.runtime->triangles.size(), state.runtime->nodes.size(),
+                  state.totalSteps, plan.samplesPerProbe);
+    state.runtime->start();
+    state.setupPhase = IrradianceSetupPhase::Done;
+    return Result<IrradianceSetupProgress, std::string>::makeResult(
+        IrradianceSetupProgress{.ready = true, .summary = "Tracing probes"});
+  }
+
+  case IrradianceSetupPhase::Done:
+    return Result<IrradianceSetupProgress, std::string>::makeResult(
+        IrradianceSetupProgress{.ready = true, .summary = "Tracing probes"});
+  }
+
+  return Result<IrradianceSetupProgress, std::string>::makeError(
+      "Irradiance volume baker: unknown setup phase");
+}
+
+Result<IrradianceStepProgress, std::string>
+pollIrradianceVolumeBake(IrradianceBakeState &state) {
+  if (!state.runtime) {
+    return Result<IrradianceStepProgress, std::string>::makeError(
+        "Irradiance volume baker: bake is not running");
+  }
+  state.completedSteps = std::min(
+      state.runtime->completedProbes.load(std::memory_order_acquire),
+      state.totalSteps);
+  return Result<IrradianceStepProgress, std::string>::makeResult(
+      IrradianceStepProgress{
+          .completedSteps = state.completedSteps,
+          .totalSteps = state.totalSteps,
+          .finished = state.completedSteps >= state.totalSteps,
+      });
+}
+
+IrradianceWritePayload
+collectIrradianceWritePayload(const IrradianceBakePlan &plan,
+                              IrradianceBakeState &state) {
+  IrradianceWritePayload payload{};
+  payload.outputPath = plan.outputPath;
+  payload.samplesPerProbe = plan.samplesPerProbe;
+  payload.bounceCount = plan.bounceCount;
+  if (state.runtime) {
+    state.runtime->stop();
+    payload.info = state.runtime->info;
+    payload.probes = std::move(state.runtime->probes);
+  }
+  return payload;
+}
+
+void cleanupIrradianceVolumeBake(IrradianceBakeState &state) {
+  if (state.runtime) {
+    state.runtime->stop();
+  }
+  if (state.sceneLoadInFlight && state.sceneLoadFuture.valid()) {
+    state.sceneLoadFuture.wait();
+  }
+  state.runtime.reset();
+  state.sceneLoadFuture = {};
+  state.sceneLoadInFlight = false;
+  state.setupPhase = IrradianceSetupPhase::StartSceneLoad;
+  state.completedSteps = 0u;
+  state.totalSteps = 0u;
+}
+
+Result<bool, std::string>
+writeIrradianceVolumeKtx2(IrradianceWritePayload &payload) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  const glm::uvec3 counts = payload.info.probeCounts;
+  const size_t probeCount =
+      static_cast<size_t>(counts.x) * counts.y * counts.z;
+  if (probeCount == 0u || payload.probes.size() != probeCount) {
+    return Result<bool, std::string>::makeError(
+        "Irradiance volume write: invalid probe data");
+  }
+  fillInvalidProbes(counts, payload.probes);
+
+  const std::filesystem::path parent = payload.outputPath.parent_path();
+  if (!parent.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(parent, ec);
+    if (ec) {
+      return Result<bool, std::string>::makeError(
+          "Irradiance volume write: failed to create output directory '" +
+          parent.string() + "': " + ec.message());
+    }
+  }
+
+  // 2D atlas: z slices side by side along x, one band of y rows per SH
+  // coefficient. Runtime filtering stays inside a slice, so the shader only
+  // blends two slices by hand.
+  const uint32_t width = counts.x * counts.z;
+  const uint32_t height = counts.y * kCoefficientCount;
+  std::vector<uint16_t> texels(static_cast<size_t>(width) * height * 4u);
+  for (uint32_t z = 0; z < counts.z; ++z) {
+    for (uint32_t y = 0; y < counts.y; ++y) {
+      for (uint32_t x = 0; x < counts.x; ++x) {
+        const IrradianceProbe &probe =
+            payload.probes[x + counts.x * (y + counts.y * z)];
+        const std::array<glm::vec4, kCoefficientCount> coefficients = {
+            glm::vec4(probe.l0, probe.skyVisibility.x),
+            glm::vec4(probe.l1x, probe.skyVisibility.y),
+            glm::vec4(probe.l1y, probe.skyVisibility.z),
+            glm::vec4(probe.l1z, probe.skyVisibility.w),
+        };
+        for (uint32_t c = 0; c < kCoefficientCount; ++c) {
+          const size_t texel =
+              (static_cast<size_t>(c * counts.y + y) * width + z * counts.x +
+               x) *
+              4u;
+          for (uint32_t channel = 0; channel < 4u; ++channel) {
+            texels[texel + channel] = static_cast<uint16_t>(
+                glm::packHalf1x16(coefficients[c][channel]));
+          }
+        }
+      }
+    }
+  }
+
+  const ktxTextureCreateInfo createInfo{
+      .glInternalformat = 0u,
+      .vkFormat = VK_FORMAT_R16G16B16A16_SFLOAT,
+      .baseWidth = width,
+      .baseHeight = height,
+      .baseDepth = 1u,
+      .numDimensions = 2u,
+      .numLevels = 1u,
+      .numLayers = 1u,
+      .numFaces = 1u,
+      .isArray = KTX_FALSE,
+      .generateMipmaps = KTX_FALSE,
+  };
+
+  ktxTexture2 *textureKtx2 = nullptr;
+  const auto createError = ktxTexture2_Create(
+      &createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &textureKtx2);
+  if (createError != KTX_SUCCESS || textureKtx2 == nullptr) {
+    if (textureKtx2 != nullptr) {
+      ktxTexture_Destroy(ktxTexture(textureKtx2));
+      textureKtx2 = nullptr;
+    }
+    return Result<bool, std::string>::makeError(
+        "Irradiance volume write: ktxTexture2_Create failed with code " +
+        std::to_string(static_cast<int>(createError)));
+  }
+
+  ktxTexture *texture = ktxTexture(textureKtx2);
+  std::memcpy(ktxTexture_GetData(texture), texels.data(),
+              texels.size() * sizeof(uint16_t));
+
+  const IrradianceVolumeInfo &info = payload.info;
+  std::array<char, 256> metadata{};
+  const int metadataLength = std::snprintf(
+      metadata.data(), metadata.size(),
+      "%.9g %.9g %.9g %.9g %.9g %.9g %u %u %u %u %u", info.boundsMin.x,
+      info.boundsMin.y, info.boundsMin.z, info.boundsMax.x, info.boundsMax.y,
+      info.boundsMax.z, counts.x, counts.y, counts.z, payload.samplesPerProbe,
+      payload.bounceCount);
+  if (metadataLength <= 0 ||
+      static_cast<size_t>(metadataLength) >= metadata.size()) {
+    ktxTexture_Destroy(texture);
+    return Result<bool, std::string>::makeError(
+        "Irradiance volume write: failed to format volume metadata");
+  }
+  const auto metadataError = ktxHashList_AddKVPair(
+      &textureKtx2->kvDataHead, kVolumeMetadataKey,
+      static_cast<unsigned int>(metadataLength + 1), metadata.data());
+  if (metadataError != KTX_SUCCESS) {
+    ktxTexture_Destroy(texture);
+    return Result<bool, std::string>::makeError(
+        "Irradiance volume write: ktxHashList_AddKVPair failed with code " +
+        std::to_string(static_cast<int>(metadataError)));
+  }
+
+  const std::string outputPathStr = payload.outputPath.string();
+  const auto writeError =
+      ktxTexture_WriteToNamedFile(texture, outputPathStr.c_str());
+  ktxTexture_Destroy(texture);
+  if (writeError != KTX_SUCCESS) {
+    return Result<bool, std::string>::makeError(
+        "Irradiance volume write: ktxTexture_WriteToNamedFile failed with "
+        "code " +
+        std::to_string(static_cast<int>(writeError)));
+  }
+
+  return Result<bool, std::string>::makeResult(true);
+}
+
+Result<IrradianceVolumeInfo, std::string>
+readIrradianceVolumeInfo(const std::filesystem::path &path) {
+  auto metadataResult = readVolumeMetadata(path);
+  if (metadataResult.hasError()) {
+    return Result<IrradianceVolumeInfo, std::string>::makeError(
+        metadataResult.error());
+  }
+  return Result<IrradianceVolumeInfo, std::string>::makeResult(
+      metadataResult.value().info);
+}
+
+std::filesystem::path
+irradianceVolumeOutputPath(const RuntimeConfig &config,
+                           const std::filesystem::path &meshPath) {
+  return config.roots.textures /
+         (meshPath.stem().string() + std::string(kOutputSuffix));
+}
+
+} // namespace nuri::bakery::detail
@@ -1,20 +1,25 @@
 #include "nuri/editor_pch.h"
 
 #include "nuri/bakery/bakery_system.h"
+#include "nuri/bakery/irradiance_volume_baker.h"
 #include "nuri/core/application.h"
 #include "nuri/core/log.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/pmr_scratch.h"
 #include "nuri/core/profiling.h"
 #include "nuri/core/runtime_config.h"
+#include "nuri/core/startup_task_graph.h"
 #include "nuri/gfx/layers/debug_layer.h"
 #include "nuri/gfx/layers/opaque_layer.h"
 #include "nuri/gfx/layers/render_frame_context.h"
 #include "nuri/gfx/layers/skybox_layer.h"
 #include "nuri/gfx/layers/transparent_layer.h"
+#include "nuri/gfx/render_calibration.h"
 #include "nuri/resources/gpu/material.h"
 #include "nuri/resources/gpu/model.h"
 #include "nuri/resources/gpu/resource_manager.h"
 #include "nuri/resources/gpu/texture.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
 #include "nuri/scene/camera_system.h"
 #include "nuri/scene/render_scene.h"
 #include "nuri/text/text_layer_2d.h"
@@ -63,6 +68,8 @@ constexpr std::string_view kSheenChairModelRelativePath =
 constexpr float kBistroTargetRadius = 120.0f;
 constexpr float kBistroMinScale = 0.0005f;
 constexpr float kBistroMaxScale = 2.0f;
+// Calibration renders the animated 32K duck grid as its synthetic workload.
+constexpr ScenePreset kCalibrationScenePreset = ScenePreset::InstancedDuck32K;
 constexpr const char *kScenePresetNames[] = {
     "Single Duck",    "Instanced Duck 32K", "Bistro Exterior",
     "Damaged Helmet", "Clearcoat Wicker",   "Sheen Chair",
@@ -153,6 +160,7 @@ nuri::ApplicationConfig toApplicationConfig(const nuri::RuntimeConfig &config) {
       .width = config.window.width,
       .height = config.window.height,
       .windowMode = config.window.mode,
+      .renderOnDemand = true,
   };
 }
 
@@ -165,11 +173,9 @@ std::filesystem::path pickDefaultNfontPath(const nuri::RuntimeConfig &config) {
   for (std::string_view name : preferred) {
     const std::filesystem::path candidate =
         (fontsRoot / std::string(name)).lexically_normal();
-    if (std::filesystem::exists(candidate, ec) &&
-        std::filesystem::is_regular_file(candidate, ec)) {
+    if (nuri::assetFileExists(candidate)) {
       return candidate;
     }
-    ec.clear();
   }
 
   std::filesystem::path newest;
@@ -240,6 +246,23 @@ std::filesystem::path pickDefaultNfontPath(const nuri::RuntimeConfig &config) {
   return std::string(buffer.data());
 }
 
+const nuri::PerfCounterId kFrameCpuMicrosCounter =
+    nuri::PerfCounters::registerCounter("frame.cpu_us",
+                                        nuri::PerfCounterKind::Gauge);
+
+// Files missing from the archive keep loading from the loose asset tree.
+void mountConfiguredAssetArchive(const nuri::RuntimeConfig &config) {
+  if (config.roots.archive.empty()) {
+    return;
+  }
+  auto mountResult =
+      nuri::mountAssetArchive(config.roots.archive, config.roots.assets);
+  if (mountResult.hasError()) {
+    NURI_LOG_WARNING("mountConfiguredAssetArchive: %s",
+                     mountResult.error().c_str());
+  }
+}
+
 } // namespace
 
 class NuriApplication : public nuri::Application {
@@ -264,13 +287,9 @@ public:
     } else {
       bakerySystem_ = std::move(bakeryResult.value());
     }
+    loadQualityProfile();
     initializeCamera();
-    initializeTextSystem();
-    loadSceneResources();
-    initializeRenderLayers();
-    initializeEditorLayer();
-
-    NURI_LOG_INFO("Application was initialized");
+    queueStartupTasks();
   }
 
   void onDraw() override {
@@ -302,6 +321,7 @@ public:
       fpsAccumulatorSeconds_ = 0.0;
       fpsFrameCount_ = 0;
     }
+    updateRenderCalibration(deltaTime);
     cameraSystem_.update(deltaTime, getInput());
     if (bakerySystem_) {
       bakerySystem_->tick();
@@ -310,6 +330,17 @@ public:
 
   void onResize(std::int32_t, std::int32_t) override {}
 
+  [[nodiscard]] bool isAnimating() const override {
+    const nuri::CameraController *controller =
+        cameraSystem_.activeController();
+    return renderSettings_.opaque.enableInstanceAnimation ||
+           pendingScenePreset_.has_value() || calibration_.isRunning() ||
+           (controller != nullptr && controller->isMoving()) ||
+           (bistroAsyncLoad_ && bistroAsyncLoad_->valid() &&
+            !bistroAsyncLoad_->isFinalized()) ||
+           (bakerySystem_ && bakerySystem_->hasActiveJobs());
+  }
+
   bool onInput(const nuri::InputEvent &event) override {
     if (event.type == nuri::InputEventType::Key &&
         event.payload.key.action == nuri::KeyAction::Press &&
@@ -317,6 +348,12 @@ public:
       toggleEditorLayer();
       return true;
     }
+    if (event.type == nuri::InputEventType::Key &&
+        event.payload.key.action == nuri::KeyAction::Press &&
+        event.payload.key.key == nuri::Key::F7) {
+      startRenderCalibration();
+      return true;
+    }
 
     if (cameraSystem_.onInput(event, getWindow())) {
       return true;
@@ -335,6 +372,159 @@ public:
   }
 
 private:
+  struct PreparedTexture {
+    nuri::TextureRequest request{};
+    std::optional<nuri::TexturePayload> payload{};
+  };
+
+  [[nodiscard]] nuri::TextureRequest makeDuckAlbedoRequest() const {
+    return nuri::TextureRequest{
+        .path =
+            (config_.roots.models / kSampleDuckAlbedoRelativePath).string(),
+        .loadOptions =
+            nuri::TextureLoadOptions{.srgb = true, .generateMipmaps = true},
+        .kind = nuri::TextureRequestKind::Texture2D,
+        .debugName = "duck_albedo",
+    };
+  }
+
+  [[nodiscard]] nuri::TextureRequest makeEnvironmentCubemapRequest() const {
+    return nuri::TextureRequest{
+        .path = (config_.roots.textures / kSampleEnvironmentHdrRelativePath)
+                    .string(),
+        .loadOptions = nuri::TextureLoadOptions{},
+        .kind = nuri::TextureRequestKind::EquirectHdrCubemap,
+        .debugName = "cubemap",
+    };
+  }
+
+  // File reads, mesh cache builds and texture decodes run on startup workers
+  // while the main thread creates the text system; GPU uploads follow once
+  // their inputs are ready.
+  void queueStartupTasks() {
+    nuri::StartupTaskGraph &tasks = startupTasks();
+    const auto addTask =
+        [&tasks](std::string_view name, nuri::StartupTaskAffinity affinity,
+                 std::span<const nuri::StartupTaskId> dependencies,
+                 std::function<nuri::Result<bool, std::string>()> run) {
+          auto result = tasks.addTask(nuri::StartupTaskDesc{
+              .name = name,
+              .affinity = affinity,
+              .dependencies = dependencies,
+              .run = std::move(run),
+          });
+          NURI_ASSERT(!result.hasError(), "Failed to queue startup task: %s",
+                      result.error().c_str());
+          return result.value();
+        };
+
+    nuri::MeshImportOptions flippedUvOptions{};
+    flippedUvOptions.flipUVs = true;
+    const std::array<std::pair<std::filesystem::path, nuri::MeshImportOptions>,
+                     4>
+        sceneModels = {{
+            {kSampleDuckModelRelativePath, nuri::MeshImportOptions{}},
+            {kDamagedHelmetModelRelativePath, flippedUvOptions},
+            {kClearcoatWickerModelRelativePath, flippedUvOptions},
+            {kSheenChairModelRelativePath, flippedUvOptions},
+        }};
+
+    std::vector<nuri::StartupTaskId> assetTasks;
+    for (const auto &sceneModel : sceneModels) {
+      const std::string path =
+          (config_.roots.models / sceneModel.first).string();
+      const nuri::MeshImportOptions importOptions = sceneModel.second;
+      const std::string taskName =
+          "warm_mesh_cache:" + sceneModel.first.stem().string();
+      assetTasks.push_back(addTask(
+          taskName, nuri::StartupTaskAffinity::Worker, {},
+          [path, importOptions]() -> nuri::Result<bool, std::string> {
+            // Non-fatal: acquireModel() imports directly on a cold cache.
+            auto warmResult = nuri::Model::warmFileCache(path, importOptions);
+            if (warmResult.hasError()) {
+              NURI_LOG_WARNING("NuriApplication::queueStartupTasks: failed to "
+                               "warm mesh cache for '%s': %s",
+                               path.c_str(), warmResult.error().c_str());
+            }
+            return nuri::Result<bool, std::string>::makeResult(true);
+          }));
+    }
+
+    preparedTextures_.clear();
+    preparedTextures_.resize(2);
+    preparedTextures_[0].request = makeDuckAlbedoRequest();
+    preparedTextures_[1].request = makeEnvironmentCubemapRequest();
+    // Decodes read through the asset file system, which is safe to call
+    // from startup workers.
+    for (PreparedTexture &prepared : preparedTextures_) {
+      const std::string taskName =
+          "decode_texture:" + prepared.request.debugName;
+      assetTasks.push_back(addTask(
+          taskName, nuri::StartupTaskAffinity::Worker, {},
+          [&prepared]() -> nuri::Result<bool, std::string> {
+            auto decodeResult =
+                nuri::ResourceManager::decodeTexture(prepared.request);
+            if (decodeResult.hasError()) {
+              // Leave the payload empty; loadSceneResources() retries
+              // synchronously and reports the error there.
+              return nuri::Result<bool, std::string>::makeResult(true);
+            }
+            prepared.payload = std::move(decodeResult.value());
+            return nuri::Result<bool, std::string>::makeResult(true);
+          }));
+    }
+
+    const nuri::StartupTaskId textTask =
+        addTask("text_system", nuri::StartupTaskAffinity::MainThread, {},
+                [this]() -> nuri::Result<bool, std::string> {
+                  initializeTextSystem();
+                  return nuri::Result<bool, std::string>::makeResult(true);
+                });
+    const nuri::StartupTaskId sceneTask =
+        addTask("scene_resources", nuri::StartupTaskAffinity::MainThread,
+                assetTasks, [this]() -> nuri::Result<bool, std::string> {
+                  loadSceneResources();
+                  preparedTextures_.clear();
+                  return nuri::Result<bool, std::string>::makeResult(true);
+                });
+    const std::array<nuri::StartupTaskId, 2> layerDependencies = {textTask,
+                                                                  sceneTask};
+    const nuri::StartupTaskId layersTask =
+        addTask("render_layers", nuri::StartupTaskAffinity::MainThread,
+                layerDependencies, [this]() -> nuri::Result<bool, std::string> {
+                  initializeRenderLayers();
+                  if (!qualityTier_.has_value()) {
+                    startRenderCalibration();
+                  }
+                  return nuri::Result<bool, std::string>::makeResult(true);
+                });
+    const std::array<nuri::StartupTaskId, 1> editorDependencies = {layersTask};
+    (void)addTask("editor_layer", nuri::StartupTaskAffinity::MainThread,
+                  editorDependencies,
+                  [this]() -> nuri::Result<bool, std::string> {
+                    initializeEditorLayer();
+                    NURI_LOG_INFO("Application was initialized");
+                    return nuri::Result<bool, std::string>::makeResult(true);
+                  });
+  }
+
+  // Uses the payload decoded by a startup worker when there is one.
+  [[nodiscard]] nuri::Result<nuri::TextureRef, std::string>
+  acquireSceneTexture(const nuri::TextureRequest &request) {
+    nuri::ResourceManager &resources = getRenderer().resources();
+    for (PreparedTexture &prepared : preparedTextures_) {
+      if (!prepared.payload.has_value() ||
+          prepared.request.path != request.path ||
+          prepared.request.kind != request.kind) {
+        continue;
+      }
+      nuri::TexturePayload payload = std::move(*prepared.payload);
+      prepared.payload.reset();
+      return resources.acquireTexture(request, std::move(payload));
+    }
+    return resources.acquireTexture(request);
+  }
+
   void initializeCamera() {
     nuri::Camera camera{};
     camera.setLookAt(glm::vec3(0.0f, 1.0f, -1.5f), glm::vec3(0.0f, 0.5f, 0.0f),
@@ -397,7 +587,7 @@ private:
   void initializeTextSystem() {
     const std::filesystem::path defaultFontPath = pickDefaultNfontPath(config_);
     const bool requireDefaultFont =
-        std::filesystem::is_regular_file(defaultFontPath);
+        nuri::assetFileExists(defaultFontPath);
     NURI_LOG_INFO("NuriApplication::initializeTextSystem: default font '%s'",
                   defaultFontPath.string().c_str());
 
@@ -761,6 +951,7 @@ private:
         nuri::EditorLayer::UiCallback([this]() {
           nuri::drawCameraControllerWidget(cameraSystem_, cameraWidgetState_);
           drawScenePresetPanel();
+          drawRenderQualityPanel();
         }),
         editorServices);
     NURI_ASSERT(editorLayer != nullptr, "Failed to create editor layer");
@@ -796,16 +987,15 @@ private:
 
     const std::string duckModelPath =
         (config_.roots.models / kSampleDuckModelRelativePath).string();
-    const std::string duckAlbedoPath =
-        (config_.roots.models / kSampleDuckAlbedoRelativePath).string();
     const std::string helmetModelPath =
         (config_.roots.models / kDamagedHelmetModelRelativePath).string();
     const std::string clearcoatModelPath =
         (config_.roots.models / kClearcoatWickerModelRelativePath).string();
     const std::string sheenChairModelPath =
         (config_.roots.models / kSheenChairModelRelativePath).string();
-    const std::string environmentHdrPath =
-        (config_.roots.textures / kSampleEnvironmentHdrRelativePath).string();
+    const nuri::TextureRequest environmentRequest =
+        makeEnvironmentCubemapRequest();
+    const std::string &environmentHdrPath = environmentRequest.path;
 
     auto duckModelResult = resources.acquireModel(
         nuri::ModelRequest{.path = duckModelPath, .debugName = "rubber_duck"});
@@ -813,13 +1003,7 @@ private:
                 duckModelResult.error().c_str());
     duckModel_ = duckModelResult.value();
 
-    auto duckAlbedoRefResult = resources.acquireTexture(nuri::TextureRequest{
-        .path = duckAlbedoPath,
-        .loadOptions =
-            nuri::TextureLoadOptions{.srgb = true, .generateMipmaps = true},
-        .kind = nuri::TextureRequestKind::Texture2D,
-        .debugName = "duck_albedo",
-    });
+    auto duckAlbedoRefResult = acquireSceneTexture(makeDuckAlbedoRequest());
     NURI_ASSERT(!duckAlbedoRefResult.hasError(),
                 "Failed to load albedo texture: %s",
                 duckAlbedoRefResult.error().c_str());
@@ -875,12 +1059,7 @@ private:
                 "Failed to create SheenChair model: %s",
                 sheenChairModelResult.error().c_str());
 
-    auto cubemapResult = resources.acquireTexture(nuri::TextureRequest{
-        .path = environmentHdrPath,
-        .loadOptions = nuri::TextureLoadOptions{},
-        .kind = nuri::TextureRequestKind::EquirectHdrCubemap,
-        .debugName = "cubemap",
-    });
+    auto cubemapResult = acquireSceneTexture(environmentRequest);
     NURI_ASSERT(!cubemapResult.hasError(),
                 "Failed to create cubemap texture: %s",
                 cubemapResult.error().c_str());
@@ -1378,6 +1557,62 @@ private:
     }
   }
 
+  void loadBistroIrradianceVolume(float bistroScale) {
+    const std::filesystem::path volumePath =
+        nuri::bakery::detail::irradianceVolumeOutputPath(
+            config_, resolveBistroExteriorPath());
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(volumePath, ec)) {
+      return;
+    }
+    auto infoResult =
+        nuri::bakery::detail::readIrradianceVolumeInfo(volumePath);
+    if (infoResult.hasError()) {
+      NURI_LOG_WARNING("NuriApplication::loadBistroIrradianceVolume: %s",
+                       infoResult.error().c_str());
+      return;
+    }
+    nuri::ResourceManager &resources = getRenderer().resources();
+    auto textureResult = resources.acquireTexture(nuri::TextureRequest{
+        .path = volumePath.string(),
+        .kind = nuri::TextureRequestKind::Ktx2Texture2D,
+        .debugName = "bistro_irradiance_volume",
+    });
+    if (textureResult.hasError()) {
+      NURI_LOG_WARNING("NuriApplication::loadBistroIrradianceVolume: failed "
+                       "to load '%s': %s",
+                       volumePath.string().c_str(),
+                       textureResult.error().c_str());
+      return;
+    }
+
+    // The bake is in mesh space; the Bistro transform is a uniform scale.
+    const nuri::bakery::detail::IrradianceVolumeInfo &info =
+        infoResult.value();
+    nuri::EnvironmentHandles environment = scene_.environment();
+    environment.irradianceVolume = nuri::IrradianceVolumeDesc{
+        .texture = textureResult.value(),
+        .boundsMin = info.boundsMin * bistroScale,
+        .boundsMax = info.boundsMax * bistroScale,
+        .probeCounts = info.probeCounts,
+    };
+    scene_.setEnvironment(environment);
+    resources.release(textureResult.value());
+    NURI_LOG_INFO("NuriApplication::loadBistroIrradianceVolume: loaded '%s' "
+                  "(%ux%ux%u probes)",
+                  volumePath.string().c_str(), info.probeCounts.x,
+                  info.probeCounts.y, info.probeCounts.z);
+  }
+
+  void clearIrradianceVolume() {
+    nuri::EnvironmentHandles environment = scene_.environment();
+    if (!nuri::isValid(environment.irradianceVolume.texture)) {
+      return;
+    }
+    environment.irradianceVolume = nuri::IrradianceVolumeDesc{};
+    scene_.setEnvironment(environment);
+  }
+
   void setupBistroExteriorScene() {
     nuri::ResourceManager &resources = getRenderer().resources();
     if (!nuri::isValid(bistroModel_)) {
@@ -1405,6 +1640,7 @@ private:
     renderSettings_.opaque.meshLodDistanceThresholds =
         glm::vec3(8.0f, 24.0f, 48.0f);
     renderSettings_.opaque.enableInstanceAnimation = false;
+    captureSceneRenderSettings();
     const nuri::BoundingBox &bounds = bistroModel.bounds();
     const float bistroScale = computeBistroScale(bounds);
     const glm::mat4 bistroModelMatrix =
@@ -1415,6 +1651,7 @@ private:
     NURI_ASSERT(!addResult.hasError(), "Failed to add Bistro renderable: %s",
                 addResult.error().c_str());
     bistroRenderableIndex_ = addResult.value();
+    loadBistroIrradianceVolume(bistroScale);
 
     const float rawRadius =
         std::max(0.5f * glm::length(bounds.getSize()), 1.0f);
@@ -1671,6 +1908,7 @@ private:
                 "Duck material is not loaded");
 
     scene_.clearOpaqueRenderables();
+    clearIrradianceVolume();
     if (editorLayer_ != nullptr) {
       editorLayer_->resetControllers();
     }
@@ -1698,12 +1936,146 @@ private:
     } else {
       loadSingleDuckSceneResources();
     }
+    captureSceneRenderSettings();
+  }
+
+  // Presets write their own baseline; the quality tier scales it.
+  void captureSceneRenderSettings() {
+    sceneRenderSettings_ = renderSettings_;
+    applyRenderQuality();
+  }
+
+  void applyRenderQuality() {
+    const std::optional<nuri::RenderQualityTier> tier =
+        calibration_.isRunning()
+            ? std::optional<nuri::RenderQualityTier>(
+                  calibration_.currentTier())
+            : qualityTier_;
+    renderSettings_ = sceneRenderSettings_;
+    if (tier.has_value()) {
+      nuri::applyRenderQualityTier(*tier, renderSettings_);
+    }
+  }
+
+  void loadQualityProfile() {
+    const std::filesystem::path profilePath =
+        nuri::renderCalibrationProfilePath(config_.sourcePath);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(profilePath, ec)) {
+      return;
+    }
+    auto profileResult = nuri::loadRenderCalibrationProfile(profilePath);
+    if (profileResult.hasError()) {
+      NURI_LOG_WARNING("NuriApplication::loadQualityProfile: %s; "
+                       "recalibrating",
+                       profileResult.error().c_str());
+      return;
+    }
+    calibrationProfile_ = profileResult.value();
+    qualityTier_ = calibrationProfile_->tier;
+    NURI_LOG_INFO("NuriApplication::loadQualityProfile: using "
+                  "'%s' quality from '%s'",
+                  nuri::renderQualityTierName(*qualityTier_).data(),
+                  profilePath.string().c_str());
+  }
+
+  void startRenderCalibration() {
+    if (calibration_.isRunning() || !nuri::isValid(duckModel_)) {
+      return;
+    }
+    calibrationReturnPreset_ = pendingScenePreset_.value_or(scenePreset_);
+    pendingScenePreset_.reset();
+    calibration_.begin(nuri::RenderCalibrationConfig{});
+    if (scenePreset_ != kCalibrationScenePreset) {
+      applyScenePreset(kCalibrationScenePreset);
+    } else {
+      applyRenderQuality();
+    }
+    NURI_LOG_INFO("NuriApplication::startRenderCalibration: calibrating "
+                  "render quality");
+  }
+
+  // Frame timings lag one frame: deltaTime and the frame.cpu_us gauge both
+  // describe the frame that was just presented.
+  void updateRenderCalibration(double deltaTime) {
+    if (!calibration_.isRunning()) {
+      return;
+    }
+    const double cpuSeconds =
+        static_cast<double>(
+            nuri::PerfCounters::value(kFrameCpuMicrosCounter)) *
+        1.0e-6;
+    if (!calibration_.recordFrame(cpuSeconds, deltaTime)) {
+      return;
+    }
+    if (calibration_.isRunning()) {
+      applyRenderQuality();
+      return;
+    }
+
+    calibrationProfile_ = *calibration_.result();
+    qualityTier_ = calibrationProfile_->tier;
+    NURI_LOG_INFO("NuriApplication::updateRenderCalibration: selected '%s' "
+                  "quality (frame %.2f ms, cpu %.2f ms, target %.2f ms)",
+                  nuri::renderQualityTierName(*qualityTier_).data(),
+                  calibrationProfile_->frameIntervalMs,
+                  calibrationProfile_->cpuFrameMs,
+                  calibrationProfile_->targetFrameMs);
+    const std::filesystem::path profilePath =
+        nuri::renderCalibrationProfilePath(config_.sourcePath);
+    auto saveResult =
+        nuri::saveRenderCalibrationProfile(profilePath, *calibrationProfile_);
+    if (saveResult.hasError()) {
+      NURI_LOG_WARNING("NuriApplication::updateRenderCalibration: %s",
+                       saveResult.error().c_str());
+    }
+
+    const ScenePreset returnPreset =
+        calibrationReturnPreset_.value_or(scenePreset_);
+    calibrationReturnPreset_.reset();
+    if (returnPreset != scenePreset_) {
+      requestScenePreset(returnPreset);
+    } else {
+      applyRenderQuality();
+    }
+  }
+
+  void drawRenderQualityPanel() {
+    std::string status;
+    if (calibration_.isRunning()) {
+      status = std::string("Calibrating ") +
+               std::string(nuri::renderQualityTierName(
+                   calibration_.currentTier())) +
+               " (" + std::to_string(calibration_.framesRemainingInTier()) +
+               " frames left)";
+    } else if (calibrationProfile_.has_value()) {
+      char buffer[128]{};
+      std::snprintf(buffer, sizeof(buffer),
+                    "%s: %.2f ms frame, %.2f ms cpu (target %.2f ms)",
+                    nuri::renderQualityTierName(calibrationProfile_->tier)
+                        .data(),
+                    calibrationProfile_->frameIntervalMs,
+                    calibrationProfile_->cpuFrameMs,
+                    calibrationProfile_->targetFrameMs);
+      status = buffer;
+    } else {
+      status = "Not calibrated";
+    }
+    if (nuri::drawRenderQualityWidget(status, calibration_.isRunning())) {
+      startRenderCalibration();
+    }
   }
 
   void requestScenePreset(ScenePreset preset) {
     if (preset == scenePreset_) {
       return;
     }
+    if (calibration_.isRunning()) {
+      calibration_.cancel();
+      calibrationReturnPreset_.reset();
+      NURI_LOG_INFO("NuriApplication::requestScenePreset: render calibration "
+                    "cancelled");
+    }
     pendingScenePreset_ = preset;
   }
 
@@ -1736,6 +2108,7 @@ private:
   void buildFrameContext(const nuri::Camera &camera, double timeSeconds) {
     frameContext_.scene = &scene_;
     frameContext_.resources = &getRenderer().resources();
+    frameContext_.pipelines = &getRenderer().pipelines();
     frameContext_.camera.view = camera.viewMatrix();
     frameContext_.camera.proj = camera.projectionMatrix(getAspectRatio());
     frameContext_.camera.cameraPos = glm::vec4(camera.position(), 1.0f);
@@ -1772,6 +2145,7 @@ private:
   nuri::MaterialRef clearcoatMaterial_ = nuri::kInvalidMaterialRef;
   nuri::MaterialRef sheenChairMaterial_ = nuri::kInvalidMaterialRef;
   nuri::MaterialRef bistroMaterialIndex_ = nuri::kInvalidMaterialRef;
+  std::vector<PreparedTexture> preparedTextures_{};
   std::optional<nuri::ModelAsyncLoad> bistroAsyncLoad_{};
   bool bistroLoadFailed_ = false;
   std::string bistroLoadError_{};
@@ -1790,6 +2164,11 @@ private:
   glm::mat4 clearcoatBaseModel_ = glm::mat4(1.0f);
 
   nuri::RenderSettings renderSettings_{};
+  nuri::RenderSettings sceneRenderSettings_{};
+  nuri::RenderCalibration calibration_{};
+  std::optional<nuri::RenderCalibrationProfile> calibrationProfile_{};
+  std::optional<nuri::RenderQualityTier> qualityTier_{};
+  std::optional<ScenePreset> calibrationReturnPreset_{};
   nuri::RenderFrameContext frameContext_{};
   uint64_t frameIndex_ = 0;
   double frameDeltaSeconds_ = 0.0;
@@ -1810,6 +2189,7 @@ int main() {
   auto configResult = nuri::loadRuntimeConfigFromEnvOrDefault();
   NURI_ASSERT(!configResult.hasError(), "Failed to load app config: %s",
               configResult.error().c_str());
+  mountConfiguredAssetArchive(configResult.value());
 
   NuriApplication app{std::move(configResult.value())};
   app.run();
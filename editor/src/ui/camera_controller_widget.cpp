@@ -134,4 +134,22 @@ bool drawScenePresetWidget(std::span<const char *const> presetNames,
   return changed;
 }
 
+bool drawRenderQualityWidget(std::string_view status, bool calibrating,
+                             std::string_view hotkeyHint) {
+  if (!ImGui::Begin("Render Quality")) {
+    ImGui::End();
+    return false;
+  }
+
+  ImGui::TextUnformatted(status.data(), status.data() + status.size());
+  ImGui::BeginDisabled(calibrating);
+  const bool requested = ImGui::Button("Calibrate");
+  ImGui::EndDisabled();
+  ImGui::SameLine();
+  ImGui::TextUnformatted(hotkeyHint.data(),
+                         hotkeyHint.data() + hotkeyHint.size());
+  ImGui::End();
+  return requested;
+}
+
 } // namespace nuri
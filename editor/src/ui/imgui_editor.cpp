@@ -3,6 +3,7 @@
 #include "nuri/ui/imgui_editor.h"
 
 #include "nuri/bakery/bakery_system.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/pmr_scratch.h"
 #include "nuri/core/profiling.h"
 #include "nuri/core/runtime_config.h"
@@ -11,6 +12,7 @@
 #include "nuri/gfx/imgui_gpu_renderer.h"
 #include "nuri/gfx/render_graph/render_graph_telemetry.h"
 #include "nuri/platform/imgui_glfw_platform.h"
+#include "nuri/resources/storage/archive/asset_archive.h"
 #include "nuri/resources/storage/font/nfont_compiler.h"
 #include "nuri/text/text_system.h"
 #include "nuri/ui/file_dialog_widget.h"
@@ -32,15 +34,19 @@ constexpr float kMetricGraphWindowHeight = 280.0f;
 constexpr double kMetricSampleMinDeltaSeconds = 1.0e-6;
 constexpr std::size_t kMetricGraphSampleCount = 240;
 constexpr uint32_t kUiMaxTessInstances = 65536u;
+constexpr uint32_t kUiMaxAnimationUpdatePeriod = 32u;
+constexpr uint32_t kUiMaxTelemetrySampleInterval = 240u;
 constexpr const char *kDockspaceWindowName = "NuriDockspace";
 constexpr const char *kDockspaceRootId = "NuriDockspace##Root";
 constexpr const char *kLogWindowName = "Log";
 constexpr const char *kRenderGraphTelemetryWindowName =
     "Render Graph Telemetry";
+constexpr const char *kPerfCountersWindowName = "Counters";
 constexpr const char *kFontCompilerWindowName = "Font Compiler";
 constexpr const char *kBakeryWindowName = "Bakery";
 constexpr const char *kCameraControllerWindowName = "Camera Controller";
 constexpr const char *kScenePresetWindowName = "Scene Preset";
+constexpr const char *kRenderQualityWindowName = "Render Quality";
 constexpr const char *kSelectionWindowName = "Selection";
 
 enum class LayerSelection : uint8_t {
@@ -77,6 +83,8 @@ const char *bakeJobKindName(bakery::BakeJobKind kind) {
     return "BRDF LUT";
   case bakery::BakeJobKind::EnvmapPrefilter:
     return "Envmap Prefilter";
+  case bakery::BakeJobKind::IrradianceVolume:
+    return "Irradiance Volume";
   }
   return "Unknown";
 }
@@ -203,19 +211,47 @@ struct FontCompilerUiState {
 
 struct BakeryUiState {
   std::array<char, 512> envHdrPath = {};
+  std::array<char, 512> volumeMeshPath = {};
+  int volumeProbeCounts[3] = {16, 8, 16};
+  int volumeSamplesPerProbe = 256;
+  int volumeBounceCount = 2;
   bool forceRebuild = false;
+  std::array<char, 512> archiveSourcePath = {};
+  std::array<char, 512> archiveOutputPath = {};
+  bool archiveCompress = true;
+  std::shared_future<Result<AssetArchiveBuildStats, std::string>>
+      archiveFuture;
+  bool archiveInFlight = false;
   std::string status{};
   std::string error{};
   FileDialogWidget fileDialog{};
 
   BakeryUiState() {
-    constexpr std::string_view kDefaultEnvHdr = "piazza_bologni_1k.hdr";
-    const size_t copyCount =
-        std::min(envHdrPath.size() - 1u, kDefaultEnvHdr.size());
-    if (copyCount > 0) {
-      std::memcpy(envHdrPath.data(), kDefaultEnvHdr.data(), copyCount);
+    const auto copyDefault = [](std::array<char, 512> &buffer,
+                                std::string_view value) {
+      const size_t copyCount = std::min(buffer.size() - 1u, value.size());
+      if (copyCount > 0) {
+        std::memcpy(buffer.data(), value.data(), copyCount);
+      }
+      buffer[copyCount] = '\0';
+    };
+    copyDefault(envHdrPath, "piazza_bologni_1k.hdr");
+    copyDefault(volumeMeshPath, "bistro/exterior/exterior.obj");
+
+    std::filesystem::path archiveSource("assets");
+    std::filesystem::path archiveOutput("assets.npak");
+    auto runtimeConfigResult = loadRuntimeConfigFromEnvOrDefault();
+    if (!runtimeConfigResult.hasError()) {
+      const RuntimeRootsConfig &roots = runtimeConfigResult.value().roots;
+      archiveSource = roots.assets;
+      archiveOutput = roots.archive.empty()
+                          ? roots.assets.parent_path() / "assets.npak"
+                          : roots.archive;
     }
-    envHdrPath[copyCount] = '\0';
+    copyDefault(archiveSourcePath,
+                archiveSource.lexically_normal().generic_string());
+    copyDefault(archiveOutputPath,
+                archiveOutput.lexically_normal().generic_string());
   }
 };
 
@@ -564,6 +600,36 @@ void drawOpaqueSettings(RenderSettings::OpaqueSettings &opaque) {
     opaque.meshLodDistanceThresholds =
         glm::vec3(lodThresholds[0], lodThresholds[1], lodThresholds[2]);
   }
+  ImGui::Checkbox("Cluster LOD##OpaqueLayer", &opaque.enableClusterLod);
+  ImGui::SliderFloat("Cluster Error (px)##OpaqueLayer",
+                     &opaque.clusterLodErrorPixels, 0.25f, 8.0f, "%.2f");
+
+  ImGui::Separator();
+  ImGui::TextUnformatted("Culling");
+  ImGui::Checkbox("Occlusion Culling##OpaqueLayer",
+                  &opaque.enableOcclusionCulling);
+  if (opaque.enableOcclusionCulling && opaque.enableInstanceAnimation) {
+    ImGui::TextUnformatted("Inactive while instance animation is enabled.");
+  }
+
+  ImGui::Separator();
+  ImGui::TextUnformatted("Instance Animation");
+  ImGui::SliderFloat("Full Rate Distance##OpaqueLayer",
+                     &opaque.instanceAnimationFullRateDistance, 0.0f, 256.0f,
+                     "%.1f");
+  int maxUpdatePeriod =
+      static_cast<int>(std::clamp(opaque.instanceAnimationMaxUpdatePeriod, 1u,
+                                  kUiMaxAnimationUpdatePeriod));
+  if (ImGui::SliderInt("Max Update Period##OpaqueLayer", &maxUpdatePeriod, 1,
+                       static_cast<int>(kUiMaxAnimationUpdatePeriod))) {
+    opaque.instanceAnimationMaxUpdatePeriod =
+        std::bit_floor(static_cast<uint32_t>(std::max(maxUpdatePeriod, 1)));
+  }
+
+  ImGui::Separator();
+  ImGui::TextUnformatted("Baked Lighting");
+  ImGui::Checkbox("Irradiance Volume##OpaqueLayer",
+                  &opaque.enableBakedIrradiance);
 
   ImGui::Separator();
   ImGui::TextUnformatted("Tessellation");
@@ -931,6 +997,23 @@ void drawFontCompilerWindow(FontCompilerUiState &state, TextSystem *textSystem,
 void drawBakeryWindow(BakeryUiState &state, bakery::BakerySystem *bakery,
                       std::pmr::memory_resource *scratchResource,
                       void *ownerWindowHandle) {
+  if (state.archiveInFlight && state.archiveFuture.valid() &&
+      state.archiveFuture.wait_for(std::chrono::seconds(0)) ==
+          std::future_status::ready) {
+    auto archiveResult = state.archiveFuture.get();
+    state.archiveInFlight = false;
+    if (archiveResult.hasError()) {
+      state.error = archiveResult.error();
+    } else {
+      const AssetArchiveBuildStats &stats = archiveResult.value();
+      std::ostringstream oss;
+      oss << "Packed " << stats.entryCount << " files ("
+          << stats.compressedEntryCount << " compressed) "
+          << stats.sourceBytes << " -> " << stats.archiveBytes << " bytes";
+      state.status = oss.str();
+    }
+  }
+
   if (!ImGui::Begin(kBakeryWindowName)) {
     ImGui::End();
     return;
@@ -997,6 +1080,86 @@ void drawBakeryWindow(BakeryUiState &state, bakery::BakerySystem *bakery,
     }
   }
 
+  ImGui::Separator();
+  ImGui::InputText("Volume Mesh Path", state.volumeMeshPath.data(),
+                   state.volumeMeshPath.size());
+  ImGui::SameLine();
+  if (ImGui::Button("Browse...##VolumeMesh")) {
+    static constexpr std::array<FileDialogFilter, 3> kMeshFilters = {
+        FileDialogFilter{"Meshes (*.gltf;*.glb;*.obj;*.nmesh)",
+                         "*.gltf;*.glb;*.obj;*.nmesh"},
+        FileDialogFilter{"Nuri Mesh Cache (*.nmesh)", "*.nmesh"},
+        FileDialogFilter{"All Files (*.*)", "*.*"},
+    };
+    OpenFileRequest request{};
+    request.title = "Select Irradiance Volume Mesh";
+    request.filters = kMeshFilters;
+    request.defaultExtension = "obj";
+    request.ownerWindowHandle = ownerWindowHandle;
+    if (const auto selectedPath = state.fileDialog.openFile(request)) {
+      setPathText(state.volumeMeshPath, selectedPath->generic_string());
+    }
+  }
+  ImGui::SliderInt3("Probe Counts", state.volumeProbeCounts, 1, 64);
+  ImGui::SliderInt("Samples Per Probe", &state.volumeSamplesPerProbe, 16,
+                   4096);
+  ImGui::SliderInt("Bounces", &state.volumeBounceCount, 0, 8);
+  if (ImGui::Button("Queue Irradiance Volume")) {
+    state.status.clear();
+    state.error.clear();
+    auto enqueueResult =
+        bakery->enqueue(bakery::BakeRequest{bakery::IrradianceVolumeBakeRequest{
+            .meshPath =
+                std::filesystem::path(std::string(state.volumeMeshPath.data())),
+            .probeCounts = {static_cast<uint32_t>(state.volumeProbeCounts[0]),
+                            static_cast<uint32_t>(state.volumeProbeCounts[1]),
+                            static_cast<uint32_t>(state.volumeProbeCounts[2])},
+            .samplesPerProbe =
+                static_cast<uint32_t>(state.volumeSamplesPerProbe),
+            .bounceCount = static_cast<uint32_t>(state.volumeBounceCount),
+            .forceRebuild = state.forceRebuild,
+        }});
+    if (enqueueResult.hasError()) {
+      state.error = enqueueResult.error();
+    } else {
+      std::ostringstream oss;
+      oss << "Queued Irradiance Volume job #" << enqueueResult.value().value;
+      state.status = oss.str();
+    }
+  }
+
+  ImGui::Separator();
+  ImGui::InputText("Archive Source", state.archiveSourcePath.data(),
+                   state.archiveSourcePath.size());
+  ImGui::InputText("Archive Output", state.archiveOutputPath.data(),
+                   state.archiveOutputPath.size());
+  ImGui::Checkbox("Compress Entries", &state.archiveCompress);
+  const bool wasArchiveInFlight = state.archiveInFlight;
+  if (wasArchiveInFlight) {
+    ImGui::BeginDisabled();
+  }
+  if (ImGui::Button("Pack Assets")) {
+    state.status.clear();
+    state.error.clear();
+    const std::filesystem::path sourcePath(
+        std::string(state.archiveSourcePath.data()));
+    const std::filesystem::path outputPath(
+        std::string(state.archiveOutputPath.data()));
+    const AssetArchiveBuildOptions options{
+        .compress = state.archiveCompress,
+    };
+    state.archiveFuture =
+        std::async(std::launch::async, [sourcePath, outputPath, options]() {
+          return buildAssetArchive(sourcePath, outputPath, options);
+        }).share();
+    state.archiveInFlight = true;
+  }
+  if (wasArchiveInFlight) {
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::TextUnformatted("Packing...");
+  }
+
   if (!state.status.empty()) {
     ImGui::Spacing();
     ImGui::TextUnformatted(state.status.c_str());
@@ -1223,6 +1386,29 @@ void drawRenderGraphTelemetryWindow(RenderGraphTelemetryUiState &state,
     ImGui::EndDisabled();
   }
 
+  if (telemetry != nullptr) {
+    int sampleInterval = static_cast<int>(
+        std::min(telemetry->sampleInterval(), kUiMaxTelemetrySampleInterval));
+    if (ImGui::SliderInt("Sample Interval##RenderGraphTelemetry",
+                         &sampleInterval, 0,
+                         static_cast<int>(kUiMaxTelemetrySampleInterval))) {
+      telemetry->setSampleInterval(
+          static_cast<uint32_t>(std::max(sampleInterval, 0)));
+    }
+    if (ImGui::IsItemHovered()) {
+      ImGui::SetTooltip("Frames between captures; 0 captures on request only.");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Capture Next Frame##RenderGraphTelemetry")) {
+      telemetry->requestCapture();
+    }
+    const RenderGraphTelemetryCaptureStats &stats = telemetry->captureStats();
+    ImGui::Text("Captured: %llu  Unchanged: %llu  Sampled Out: %llu",
+                static_cast<unsigned long long>(stats.capturedSnapshots),
+                static_cast<unsigned long long>(stats.unchangedFrames),
+                static_cast<unsigned long long>(stats.sampledOutFrames));
+  }
+
   if (!state.status.empty()) {
     ImGui::Spacing();
     ImGui::TextUnformatted(state.status.c_str());
@@ -1643,6 +1829,39 @@ void drawRenderGraphTelemetryWindow(RenderGraphTelemetryUiState &state,
       });
 }
 
+void drawPerfCountersWindow() {
+  if (!ImGui::Begin(kPerfCountersWindowName)) {
+    ImGui::End();
+    return;
+  }
+  ImGui::Text("Sampled frames: %u", PerfCounters::historySize());
+  if (ImGui::BeginTable("PerfCounters", 3,
+                        ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg |
+                            ImGuiTableFlags_Resizable |
+                            ImGuiTableFlags_ScrollY)) {
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Counter", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Last", ImGuiTableColumnFlags_WidthFixed, 110.0f);
+    ImGui::TableSetupColumn("Average", ImGuiTableColumnFlags_WidthFixed,
+                            110.0f);
+    ImGui::TableHeadersRow();
+    const uint32_t counterCount = PerfCounters::counterCount();
+    for (uint32_t i = 0; i < counterCount; ++i) {
+      const PerfCounterId id = PerfCounters::counterAt(i);
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      drawTextView(PerfCounters::name(id));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu",
+                  static_cast<unsigned long long>(PerfCounters::value(id)));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.1f", PerfCounters::average(id));
+    }
+    ImGui::EndTable();
+  }
+  ImGui::End();
+}
+
 void setDockspaceWindowPlacement(const ImGuiViewport *viewport) {
   if (!viewport) {
     return;
@@ -1688,6 +1907,9 @@ void drawFpsOverlay(const FPSCounter &fpsCounter, LinearGraph &fpsGraph,
     ImGui::Text("Ms  : %.1f", milliseconds);
     ImGui::Text("Inst: %u / %u", frameMetrics.opaque.visibleInstances,
                 frameMetrics.opaque.totalInstances);
+    ImGui::Text("Occluded: %u (Occluders: %u)",
+                frameMetrics.opaque.occludedInstances,
+                frameMetrics.opaque.occluders);
     ImGui::Text("Draw: %u (Tess: %u)  Tess Inst: %u",
                 frameMetrics.opaque.instancedDraws,
                 frameMetrics.opaque.tessellatedDraws,
@@ -1759,9 +1981,11 @@ struct DockLayoutState {
     logDockId = dockBottom;
     ImGui::DockBuilderDockWindow(kCameraControllerWindowName, dockBottomLeft);
     ImGui::DockBuilderDockWindow(kScenePresetWindowName, dockBottomLeft);
+    ImGui::DockBuilderDockWindow(kRenderQualityWindowName, dockBottomLeft);
     ImGui::DockBuilderDockWindow(kSelectionWindowName, dockBottomLeft);
     ImGui::DockBuilderDockWindow(kLogWindowName, logDockId);
     ImGui::DockBuilderDockWindow(kRenderGraphTelemetryWindowName, logDockId);
+    ImGui::DockBuilderDockWindow(kPerfCountersWindowName, logDockId);
     ImGui::DockBuilderDockWindow(kFontCompilerWindowName, logDockId);
     ImGui::DockBuilderDockWindow(kBakeryWindowName, logDockId);
     ImGui::DockBuilderFinish(dockspaceId);
@@ -1860,6 +2084,7 @@ struct ImGuiEditor::Impl {
                                      window.nativeHandle());
     }
     ImGui::End();
+    drawPerfCountersWindow();
     drawFontCompilerWindow(fontCompilerState, textSystem,
                            window.nativeHandle());
     drawBakeryWindow(bakeryState, bakery, scopedScratch.resource(),
@@ -143,7 +143,13 @@ struct ImGuizmoController::Impl {
         glm::value_ptr(view), glm::value_ptr(proj), gizmoOperation, gizmoMode,
         glm::value_ptr(modelMatrix), nullptr, snap);
     gizmoHoverOrUsing = ImGuizmo::IsOver() || ImGuizmo::IsUsing();
-    if (manipulated &&
+    if (!manipulated) {
+      return;
+    }
+    // Dragged objects move the dynamic slots only instead of repacking the
+    // whole static instance set every frame.
+    if (!scene.setRenderableMobility(*selectedOpaqueIndex,
+                                     RenderableMobility::Dynamic) ||
         !scene.setRenderableTransform(*selectedOpaqueIndex, modelMatrix)) {
       clearSelectionState();
     }
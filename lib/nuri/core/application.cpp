@@ -1,11 +1,32 @@
 #include "nuri/core/application.h"
 #include "nuri/core/log.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/profiling.h"
 #include "nuri/core/window.h"
 #include "nuri/gfx/gpu_device.h"
 #include "nuri/gfx/renderer.h"
 
+#include <algorithm>
+
 namespace nuri {
+namespace {
+
+// Frames rendered after a change so UI hover state and every in-flight
+// swapchain image catch up.
+constexpr std::uint32_t kRedrawFrameCount = 3;
+// Minimized windows have nothing to present; wake rarely to re-check.
+constexpr double kMinimizedWaitSeconds = 0.5;
+
+const PerfCounterId kFrameCpuMicrosCounter = PerfCounters::registerCounter(
+    "frame.cpu_us", PerfCounterKind::Gauge);
+const PerfCounterId kFrameIntervalMicrosCounter =
+    PerfCounters::registerCounter("frame.interval_us", PerfCounterKind::Gauge);
+
+[[nodiscard]] uint64_t toMicros(double seconds) noexcept {
+  return static_cast<uint64_t>(std::max(seconds, 0.0) * 1.0e6);
+}
+
+} // namespace
 
 Application::LogLifetimeGuard::LogLifetimeGuard(const LogConfig &config) {
   Log::initialize(config);
@@ -33,10 +54,12 @@ Application::Application(const ApplicationConfig &config)
       width_(appConfig_.width), height_(appConfig_.height),
       windowMode_(appConfig_.windowMode),
       layerStack_(&layerMemory_),
-      eventManager_(eventMemory_), input_(eventManager_) {
+      eventManager_(eventMemory_), input_(eventManager_),
+      startupTasks_(&layerMemory_) {
   inputDispatchSubscription_ = eventManager_.subscribe<InputEvent>(
       EventChannel::Input, &Application::dispatchInputEvent, this);
 
+  double phaseBegin = secondsSinceStartup();
   window_ = Window::create(appConfig_.title, width_, height_, windowMode_);
   NURI_ASSERT(window_ != nullptr, "Failed to create window");
   window_->bindEventManager(&eventManager_);
@@ -52,10 +75,17 @@ Application::Application(const ApplicationConfig &config)
     height_ = fbh;
   }
 
-  gpu_ = GPUDevice::create(*window_);
+  startupTelemetry_.windowSeconds = secondsSinceStartup() - phaseBegin;
+
+  phaseBegin = secondsSinceStartup();
+  gpu_ = GPUDevice::create(*window_, appConfig_.gpuDevice);
   NURI_ASSERT(gpu_ != nullptr, "Failed to create GPU device");
+  startupTelemetry_.gpuDeviceSeconds = secondsSinceStartup() - phaseBegin;
+
+  phaseBegin = secondsSinceStartup();
   renderer_ = Renderer::create(*gpu_, rendererMemory_);
   NURI_ASSERT(renderer_ != nullptr, "Failed to create renderer");
+  startupTelemetry_.rendererSeconds = secondsSinceStartup() - phaseBegin;
 }
 
 Application::Application(const std::string &title, std::int32_t width,
@@ -79,14 +109,28 @@ void Application::run() {
   NURI_LOG_DEBUG("Application::run: Application started");
   NURI_PROFILER_THREAD("Main");
 
+  const double initBegin = secondsSinceStartup();
   onInit();
+  startupTelemetry_.initSeconds = secondsSinceStartup() - initBegin;
+  if (!runStartupTasks()) {
+    window_->requestClose();
+  }
+  const double firstFrameBegin = secondsSinceStartup();
   double lastTime = getTime();
+  uint64_t frameIndex = 0;
+  requestRedraw();
 
   while (!window_->shouldClose()) {
-    NURI_PROFILER_FRAME("Frame");
-
-    input_.beginFrame();
-    {
+    const bool minimized = !width_ || !height_;
+    if (minimized || isIdle()) {
+      NURI_PROFILER_ZONE("Window::waitEvents", NURI_PROFILER_COLOR_WAIT);
+      input_.beginFrame();
+      window_->waitEvents(minimized ? kMinimizedWaitSeconds
+                                    : appConfig_.idleWaitSeconds);
+      NURI_PROFILER_ZONE_END();
+    } else {
+      NURI_PROFILER_FRAME("Frame");
+      input_.beginFrame();
       NURI_PROFILER_ZONE("Window::pollEvents", NURI_PROFILER_COLOR_WAIT);
       window_->pollEvents();
       NURI_PROFILER_ZONE_END();
@@ -103,6 +147,9 @@ void Application::run() {
       eventManager_.dispatch(EventChannel::Input);
       NURI_PROFILER_ZONE_END();
     }
+    if (input_.isActive()) {
+      requestRedraw();
+    }
 
     std::int32_t newWidth = 0;
     std::int32_t newHeight = 0;
@@ -121,6 +168,7 @@ void Application::run() {
 
     if (newWidth != width_ || newHeight != height_) {
       NURI_PROFILER_ZONE("Resize", NURI_PROFILER_COLOR_CREATE);
+      requestRedraw();
       width_ = newWidth;
       height_ = newHeight;
       onResize(width_, height_);
@@ -130,6 +178,12 @@ void Application::run() {
     }
 
     double currentTime = getTime();
+    if (isIdle()) {
+      // Restart the delta so the next frame does not span the idle period.
+      lastTime = currentTime;
+      input_.endFrame();
+      continue;
+    }
     double deltaTime = currentTime - lastTime;
     lastTime = currentTime;
     {
@@ -149,7 +203,20 @@ void Application::run() {
       NURI_PROFILER_ZONE_END();
     }
 
+    PerfCounters::set(kFrameCpuMicrosCounter,
+                      toMicros(getTime() - currentTime));
+    PerfCounters::set(kFrameIntervalMicrosCounter, toMicros(deltaTime));
+    PerfCounters::endFrame(frameIndex++);
+
     input_.endFrame();
+    if (pendingRedrawFrames_ > 0) {
+      --pendingRedrawFrames_;
+    }
+    if (!startupTelemetry_.firstFrameRecorded) {
+      startupTelemetry_.firstFrameSeconds =
+          secondsSinceStartup() - firstFrameBegin;
+      recordFirstFrame();
+    }
   }
 
   NURI_LOG_DEBUG("Application::run: Application shutdown");
@@ -186,6 +253,76 @@ const InputSystem &Application::getInput() const { return input_; }
 
 const ApplicationConfig &Application::config() const { return appConfig_; }
 
+const StartupTelemetry &Application::startupTelemetry() const {
+  return startupTelemetry_;
+}
+
+double Application::secondsSinceStartup() const {
+  return std::chrono::duration<double>(StartupClock::now() - startupBegin_)
+      .count();
+}
+
+bool Application::runStartupTasks() {
+  if (startupTasks_.empty()) {
+    return true;
+  }
+
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  const uint32_t workerCount = appConfig_.startupWorkerCount != 0u
+                                   ? appConfig_.startupWorkerCount
+                                   : StartupTaskGraph::defaultWorkerCount();
+  startupTelemetry_.tasks = startupTasks_.run(workerCount);
+  const StartupReport &report = startupTelemetry_.tasks;
+  startupTelemetry_.taskGraphSeconds = report.wallSeconds;
+
+  for (const StartupTaskTiming &task : report.tasks) {
+    const char *thread =
+        task.affinity == StartupTaskAffinity::MainThread ? "main" : "worker";
+    switch (task.status) {
+    case StartupTaskStatus::Succeeded:
+      NURI_LOG_DEBUG("Application::runStartupTasks: '%s' (%s) started at "
+                     "%.2f ms, took %.2f ms",
+                     task.name.c_str(), thread, task.startSeconds * 1000.0,
+                     task.durationSeconds * 1000.0);
+      break;
+    case StartupTaskStatus::Failed:
+      NURI_LOG_WARNING("Application::runStartupTasks: '%s' failed: %s",
+                       task.name.c_str(), task.error.c_str());
+      break;
+    case StartupTaskStatus::Skipped:
+      NURI_LOG_WARNING("Application::runStartupTasks: '%s' skipped after a "
+                       "failed dependency",
+                       task.name.c_str());
+      break;
+    case StartupTaskStatus::Pending:
+      break;
+    }
+  }
+  NURI_LOG_INFO("Application::runStartupTasks: %zu tasks on %u workers in "
+                "%.2f ms (main busy %.2f ms, workers busy %.2f ms)",
+                report.tasks.size(), report.workerCount,
+                report.wallSeconds * 1000.0,
+                report.mainThreadBusySeconds * 1000.0,
+                report.workerBusySeconds * 1000.0);
+  return report.succeeded();
+}
+
+void Application::recordFirstFrame() {
+  StartupTelemetry &telemetry = startupTelemetry_;
+  telemetry.firstFrameRecorded = true;
+  telemetry.timeToFirstFrameSeconds = secondsSinceStartup();
+  NURI_LOG_INFO("Application::run: time to first frame %.2f ms (window %.2f, "
+                "device %.2f, renderer %.2f, init %.2f, tasks %.2f, first "
+                "frame %.2f)",
+                telemetry.timeToFirstFrameSeconds * 1000.0,
+                telemetry.windowSeconds * 1000.0,
+                telemetry.gpuDeviceSeconds * 1000.0,
+                telemetry.rendererSeconds * 1000.0,
+                telemetry.initSeconds * 1000.0,
+                telemetry.taskGraphSeconds * 1000.0,
+                telemetry.firstFrameSeconds * 1000.0);
+}
+
 bool Application::dispatchInputEvent(const InputEvent &event, void *user) {
   if (!user) {
     return false;
@@ -193,6 +330,15 @@ bool Application::dispatchInputEvent(const InputEvent &event, void *user) {
   return static_cast<Application *>(user)->handleInputEvent(event);
 }
 
+void Application::requestRedraw() {
+  pendingRedrawFrames_ = std::max(pendingRedrawFrames_, kRedrawFrameCount);
+}
+
+bool Application::isIdle() const {
+  return appConfig_.renderOnDemand && pendingRedrawFrames_ == 0 &&
+         !isAnimating();
+}
+
 bool Application::handleInputEvent(const InputEvent &event) {
   if (layerStack_.onInput(event)) {
     return true;
@@ -5,11 +5,14 @@
 #include "nuri/core/input_system.h"
 #include "nuri/core/layer_stack.h"
 #include "nuri/core/log.h"
+#include "nuri/core/startup_task_graph.h"
 #include "nuri/core/window.h"
 #include "nuri/defines.h"
 #include "nuri/gfx/gpu_device.h"
 #include "nuri/gfx/renderer.h"
 
+#include <chrono>
+
 namespace nuri {
 struct NURI_API ApplicationConfig {
   std::string title = "Nuri";
@@ -19,6 +22,29 @@ struct NURI_API ApplicationConfig {
   // Window mode (mutually exclusive).
   // Windowed with width=0 and height=0 uses max screen size coverage.
   WindowMode windowMode = WindowMode::Windowed;
+
+  // Threads for startup tasks queued during onInit(); 0 picks a default.
+  std::uint32_t startupWorkerCount = 0;
+
+  // Render only after input, resizes, requestRedraw() or while isAnimating();
+  // otherwise block on window events, waking up every idleWaitSeconds.
+  bool renderOnDemand = false;
+  double idleWaitSeconds = 0.1;
+
+  GPUDeviceCreateDesc gpuDevice{};
+};
+
+// Wall-clock breakdown of startup, measured from the start of construction.
+struct NURI_API StartupTelemetry {
+  double windowSeconds = 0.0;
+  double gpuDeviceSeconds = 0.0;
+  double rendererSeconds = 0.0;
+  double initSeconds = 0.0;
+  double taskGraphSeconds = 0.0;
+  double firstFrameSeconds = 0.0;
+  double timeToFirstFrameSeconds = 0.0;
+  bool firstFrameRecorded = false;
+  StartupReport tasks{};
 };
 
 class NURI_API Application {
@@ -42,6 +68,11 @@ public:
   virtual void onResize(std::int32_t width, std::int32_t height) = 0;
   virtual bool onInput(const InputEvent &event);
   virtual void onShutdown() = 0;
+  // Keeps frames coming in on-demand mode while something changes over time.
+  [[nodiscard]] virtual bool isAnimating() const { return false; }
+
+  // Marks the next frames dirty so on-demand mode renders them.
+  void requestRedraw();
 
   GPUDevice &getGPU();
   const GPUDevice &getGPU() const;
@@ -63,11 +94,17 @@ public:
   const EventManager &getEventManager() const;
   InputSystem &getInput();
   const InputSystem &getInput() const;
+  const StartupTelemetry &startupTelemetry() const;
 
 protected:
   [[nodiscard]] std::pmr::memory_resource *layerMemoryResource() noexcept {
     return &layerMemory_;
   }
+  // Tasks added during onInit() run right after it returns, before the first
+  // frame.
+  [[nodiscard]] StartupTaskGraph &startupTasks() noexcept {
+    return startupTasks_;
+  }
 
 private:
   struct LogLifetimeGuard {
@@ -79,9 +116,16 @@ private:
 
   static LogConfig makeDefaultLogConfig();
 
+  using StartupClock = std::chrono::steady_clock;
+
   static bool dispatchInputEvent(const InputEvent &event, void *user);
   bool handleInputEvent(const InputEvent &event);
+  [[nodiscard]] double secondsSinceStartup() const;
+  bool runStartupTasks();
+  void recordFirstFrame();
+  [[nodiscard]] bool isIdle() const;
 
+  StartupClock::time_point startupBegin_ = StartupClock::now();
   LogLifetimeGuard logLifetimeGuard_;
   ApplicationConfig appConfig_{};
   std::int32_t width_;
@@ -97,6 +141,9 @@ private:
   EventManager eventManager_;
   InputSystem input_;
   SubscriptionToken inputDispatchSubscription_{};
+  StartupTaskGraph startupTasks_;
+  StartupTelemetry startupTelemetry_{};
+  std::uint32_t pendingRedrawFrames_ = 0;
 };
 
 } // namespace nuri
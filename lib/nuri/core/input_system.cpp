@@ -54,10 +54,15 @@ void InputSystem::beginFrame() {
   mouseReleased_.reset();
   mouseDelta_ = glm::dvec2(0.0, 0.0);
   scrollDelta_ = glm::dvec2(0.0, 0.0);
+  receivedInput_ = false;
 }
 
 void InputSystem::endFrame() {}
 
+bool InputSystem::isActive() const {
+  return receivedInput_ || keyDown_.any() || mouseDown_.any();
+}
+
 bool InputSystem::isKeyDown(Key key) const {
   const size_t idx = keyIndex(key);
   return idx < keyDown_.size() ? keyDown_.test(idx) : false;
@@ -95,6 +100,7 @@ glm::dvec2 InputSystem::mouseDelta() const { return mouseDelta_; }
 glm::dvec2 InputSystem::scrollDelta() const { return scrollDelta_; }
 
 bool InputSystem::handleRawKey(const RawKeyEvent &event) {
+  receivedInput_ = true;
   const size_t idx = keyIndex(event.key);
   if (idx < keyDown_.size()) {
     switch (event.action) {
@@ -130,6 +136,7 @@ bool InputSystem::handleRawKey(const RawKeyEvent &event) {
 }
 
 bool InputSystem::handleRawChar(const RawCharEvent &event) {
+  receivedInput_ = true;
   InputEvent out{};
   out.type = InputEventType::Character;
   out.deviceId = event.deviceId;
@@ -139,6 +146,7 @@ bool InputSystem::handleRawChar(const RawCharEvent &event) {
 }
 
 bool InputSystem::handleRawMouseButton(const RawMouseButtonEvent &event) {
+  receivedInput_ = true;
   const size_t idx = mouseIndex(event.button);
   if (idx < mouseDown_.size()) {
     switch (event.action) {
@@ -170,6 +178,7 @@ bool InputSystem::handleRawMouseButton(const RawMouseButtonEvent &event) {
 }
 
 bool InputSystem::handleRawMouseMove(const RawMouseMoveEvent &event) {
+  receivedInput_ = true;
   double dx = 0.0;
   double dy = 0.0;
   if (hasMousePosition_) {
@@ -194,6 +203,7 @@ bool InputSystem::handleRawMouseMove(const RawMouseMoveEvent &event) {
 }
 
 bool InputSystem::handleRawMouseScroll(const RawMouseScrollEvent &event) {
+  receivedInput_ = true;
   scrollDelta_ += glm::dvec2(event.xOffset, event.yOffset);
 
   InputEvent out{};
@@ -206,6 +216,7 @@ bool InputSystem::handleRawMouseScroll(const RawMouseScrollEvent &event) {
 }
 
 bool InputSystem::handleRawFocus(const RawFocusEvent &event) {
+  receivedInput_ = true;
   if (!event.focused) {
     keyDown_.reset();
     mouseDown_.reset();
@@ -223,6 +234,7 @@ bool InputSystem::handleRawFocus(const RawFocusEvent &event) {
 }
 
 bool InputSystem::handleRawCursorEnter(const RawCursorEnterEvent &event) {
+  receivedInput_ = true;
   if (!event.entered) {
     hasMousePosition_ = false;
     mousePosition_ = glm::dvec2(0.0, 0.0);
@@ -23,6 +23,9 @@ public:
   void beginFrame();
   void endFrame();
 
+  // True when raw input arrived since beginFrame() or a key or button is held.
+  bool isActive() const;
+
   bool isKeyDown(Key key) const;
   bool wasKeyPressed(Key key) const;
   bool wasKeyReleased(Key key) const;
@@ -75,6 +78,7 @@ private:
   glm::dvec2 mouseDelta_{0.0, 0.0};
   glm::dvec2 scrollDelta_{0.0, 0.0};
   bool hasMousePosition_ = false;
+  bool receivedInput_ = false;
 };
 
 } // namespace nuri
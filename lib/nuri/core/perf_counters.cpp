@@ -0,0 +1,166 @@
+#include "nuri/pch.h"
+
+#include "nuri/core/perf_counters.h"
+#include "nuri/core/log.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace nuri {
+namespace {
+
+constexpr uint32_t kMaxCounters = PerfCounters::kMaxCounters;
+constexpr uint32_t kHistoryFrames = PerfCounters::kHistoryFrames;
+
+// One cache line per counter so publishers on different threads never share.
+struct alignas(64) LiveCounter {
+  std::atomic<uint64_t> value{0u};
+};
+
+struct PerfCounterRegistry {
+  std::mutex registerMutex;
+  std::array<std::string_view, kMaxCounters> names{};
+  std::array<PerfCounterKind, kMaxCounters> kinds{};
+  // Published with release after names/kinds, so readers can skip the mutex.
+  std::atomic<uint32_t> count{0u};
+  std::array<LiveCounter, kMaxCounters> live{};
+
+  std::array<std::array<uint64_t, kMaxCounters>, kHistoryFrames> history{};
+  std::array<uint64_t, kHistoryFrames> frameIndices{};
+  uint32_t head = 0u;
+  uint32_t size = 0u;
+};
+
+// Function-local so counters registered from other static initializers
+// always find the registry constructed.
+[[nodiscard]] PerfCounterRegistry &registry() noexcept {
+  static PerfCounterRegistry instance;
+  return instance;
+}
+
+[[nodiscard]] bool isRegistered(const PerfCounterRegistry &r,
+                                PerfCounterId id) noexcept {
+  return id.isValid() && id.index < r.count.load(std::memory_order_acquire);
+}
+
+[[nodiscard]] uint32_t historySlot(const PerfCounterRegistry &r,
+                                   uint32_t framesAgo) noexcept {
+  return (r.head + kHistoryFrames - 1u - framesAgo) % kHistoryFrames;
+}
+
+} // namespace
+
+PerfCounterId PerfCounters::registerCounter(std::string_view name,
+                                            PerfCounterKind kind) {
+  PerfCounterRegistry &r = registry();
+  std::scoped_lock lock(r.registerMutex);
+  const uint32_t count = r.count.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < count; ++i) {
+    if (r.names[i] == name) {
+      return PerfCounterId{i};
+    }
+  }
+  if (count >= kMaxCounters) {
+    NURI_LOG_WARNING("PerfCounters::registerCounter: registry full, '%.*s' "
+                     "is not tracked",
+                     static_cast<int>(name.size()), name.data());
+    return PerfCounterId{};
+  }
+  r.names[count] = name;
+  r.kinds[count] = kind;
+  r.count.store(count + 1u, std::memory_order_release);
+  return PerfCounterId{count};
+}
+
+void PerfCounters::add(PerfCounterId id, uint64_t value) noexcept {
+  if (!id.isValid() || id.index >= kMaxCounters) {
+    return;
+  }
+  registry().live[id.index].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+void PerfCounters::set(PerfCounterId id, uint64_t value) noexcept {
+  if (!id.isValid() || id.index >= kMaxCounters) {
+    return;
+  }
+  registry().live[id.index].value.store(value, std::memory_order_relaxed);
+}
+
+void PerfCounters::endFrame(uint64_t frameIndex) noexcept {
+  PerfCounterRegistry &r = registry();
+  const uint32_t count = r.count.load(std::memory_order_acquire);
+  std::array<uint64_t, kMaxCounters> &row = r.history[r.head];
+  for (uint32_t i = 0; i < count; ++i) {
+    std::atomic<uint64_t> &live = r.live[i].value;
+    row[i] = r.kinds[i] == PerfCounterKind::Counter
+                 ? live.exchange(0u, std::memory_order_relaxed)
+                 : live.load(std::memory_order_relaxed);
+  }
+  r.frameIndices[r.head] = frameIndex;
+  r.head = (r.head + 1u) % kHistoryFrames;
+  r.size = std::min(r.size + 1u, kHistoryFrames);
+}
+
+uint32_t PerfCounters::counterCount() noexcept {
+  return registry().count.load(std::memory_order_acquire);
+}
+
+PerfCounterId PerfCounters::counterAt(uint32_t index) noexcept {
+  return index < counterCount() ? PerfCounterId{index} : PerfCounterId{};
+}
+
+std::string_view PerfCounters::name(PerfCounterId id) noexcept {
+  const PerfCounterRegistry &r = registry();
+  return isRegistered(r, id) ? r.names[id.index] : std::string_view{};
+}
+
+PerfCounterKind PerfCounters::kind(PerfCounterId id) noexcept {
+  const PerfCounterRegistry &r = registry();
+  return isRegistered(r, id) ? r.kinds[id.index] : PerfCounterKind::Counter;
+}
+
+uint32_t PerfCounters::historySize() noexcept { return registry().size; }
+
+uint64_t PerfCounters::frameIndex(uint32_t framesAgo) noexcept {
+  const PerfCounterRegistry &r = registry();
+  if (framesAgo >= r.size) {
+    return 0u;
+  }
+  return r.frameIndices[historySlot(r, framesAgo)];
+}
+
+uint64_t PerfCounters::value(PerfCounterId id, uint32_t framesAgo) noexcept {
+  const PerfCounterRegistry &r = registry();
+  if (!isRegistered(r, id) || framesAgo >= r.size) {
+    return 0u;
+  }
+  return r.history[historySlot(r, framesAgo)][id.index];
+}
+
+double PerfCounters::average(PerfCounterId id) noexcept {
+  const PerfCounterRegistry &r = registry();
+  if (!isRegistered(r, id) || r.size == 0u) {
+    return 0.0;
+  }
+  uint64_t sum = 0u;
+  for (uint32_t framesAgo = 0; framesAgo < r.size; ++framesAgo) {
+    sum += r.history[historySlot(r, framesAgo)][id.index];
+  }
+  return static_cast<double>(sum) / static_cast<double>(r.size);
+}
+
+void PerfCounters::resetHistory() noexcept {
+  PerfCounterRegistry &r = registry();
+  for (LiveCounter &live : r.live) {
+    live.value.store(0u, std::memory_order_relaxed);
+  }
+  for (std::array<uint64_t, kMaxCounters> &row : r.history) {
+    row.fill(0u);
+  }
+  r.frameIndices.fill(0u);
+  r.head = 0u;
+  r.size = 0u;
+}
+
+} // namespace nuri
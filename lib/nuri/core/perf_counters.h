@@ -0,0 +1,66 @@
+#pragma once
+
+#include "nuri/defines.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace nuri {
+
+enum class PerfCounterKind : uint8_t {
+  // Summed over a frame and cleared when the frame is sampled.
+  Counter,
+  // Keeps the last value set until it is overwritten.
+  Gauge,
+};
+
+struct PerfCounterId {
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+  uint32_t index = kInvalidIndex;
+
+  [[nodiscard]] bool isValid() const noexcept { return index != kInvalidIndex; }
+};
+
+// Process-wide named counters. Register once at namespace scope, e.g.
+//   const PerfCounterId kUploadBytes =
+//       PerfCounters::registerCounter("gpu.upload_bytes");
+// then publish with add()/set() from any thread; both are a relaxed atomic on
+// a cache line of their own. endFrame() samples every counter into a ring
+// that tools read back by frame age.
+class NURI_API PerfCounters {
+public:
+  static constexpr uint32_t kMaxCounters = 256;
+  static constexpr uint32_t kHistoryFrames = 120;
+
+  PerfCounters() = delete;
+
+  // Names must have static storage duration. Registering an existing name
+  // returns its id; a full registry returns an invalid id, which add() and
+  // set() ignore.
+  static PerfCounterId registerCounter(
+      std::string_view name, PerfCounterKind kind = PerfCounterKind::Counter);
+
+  static void add(PerfCounterId id, uint64_t value = 1u) noexcept;
+  static void set(PerfCounterId id, uint64_t value) noexcept;
+
+  // Call once per frame from the thread that owns the frame loop.
+  static void endFrame(uint64_t frameIndex) noexcept;
+
+  [[nodiscard]] static uint32_t counterCount() noexcept;
+  [[nodiscard]] static PerfCounterId counterAt(uint32_t index) noexcept;
+  [[nodiscard]] static std::string_view name(PerfCounterId id) noexcept;
+  [[nodiscard]] static PerfCounterKind kind(PerfCounterId id) noexcept;
+
+  // Number of sampled frames available, at most kHistoryFrames.
+  [[nodiscard]] static uint32_t historySize() noexcept;
+  // framesAgo 0 is the most recently sampled frame.
+  [[nodiscard]] static uint64_t frameIndex(uint32_t framesAgo = 0u) noexcept;
+  [[nodiscard]] static uint64_t value(PerfCounterId id,
+                                      uint32_t framesAgo = 0u) noexcept;
+  [[nodiscard]] static double average(PerfCounterId id) noexcept;
+
+  // Clears live values and history; registrations are kept.
+  static void resetHistory() noexcept;
+};
+
+} // namespace nuri
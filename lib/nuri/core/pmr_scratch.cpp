@@ -0,0 +1,44 @@
+#include "nuri/pch.h"
+
+#include "nuri/core/pmr_scratch.h"
+
+#include "nuri/core/perf_counters.h"
+
+namespace nuri {
+namespace {
+
+const PerfCounterId kScratchSpillBytesCounter =
+    PerfCounters::registerCounter("memory.scratch_spill_bytes");
+
+struct ThreadScratchStack {
+  std::array<ScratchArena, ScopedThreadScratch::kMaxDepth> arenas;
+  uint32_t depth = 0u;
+};
+
+[[nodiscard]] ThreadScratchStack &threadScratchStack() noexcept {
+  thread_local ThreadScratchStack stack;
+  return stack;
+}
+
+[[nodiscard]] ScratchArena &pushThreadScratch() noexcept {
+  ThreadScratchStack &stack = threadScratchStack();
+  NURI_ASSERT(stack.depth < ScopedThreadScratch::kMaxDepth,
+              "ScopedThreadScratch nesting exceeds %u levels",
+              ScopedThreadScratch::kMaxDepth);
+  return stack.arenas[stack.depth++];
+}
+
+} // namespace
+
+void recordScratchSpill(size_t bytes) noexcept {
+  PerfCounters::add(kScratchSpillBytesCounter, bytes);
+}
+
+ScopedThreadScratch::ScopedThreadScratch() noexcept
+    : scope_(pushThreadScratch()) {}
+
+ScopedThreadScratch::~ScopedThreadScratch() noexcept {
+  --threadScratchStack().depth;
+}
+
+} // namespace nuri
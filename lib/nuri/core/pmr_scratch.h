@@ -1,17 +1,45 @@
 #pragma once
 
 #include "nuri/core/log.h"
+#include "nuri/defines.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory_resource>
+#include <new>
+#include <optional>
+#include <utility>
 
 namespace nuri {
 
+// Publishes bytes that spilled past an arena's retained block.
+NURI_API void recordScratchSpill(size_t bytes) noexcept;
+
+// Monotonic arena that keeps its first block across resets. When a scope
+// spills past that block, the next reset grows it to the observed high-water
+// mark so the steady state never touches the upstream resource.
 class ScratchArena final {
 public:
+  static constexpr size_t kBlockGranularity = 4u * 1024u;
+  static constexpr size_t kMaxRetainedCapacity = 64u * 1024u * 1024u;
+
   explicit ScratchArena(
-      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
-      : pool_(upstream ? upstream : std::pmr::get_default_resource()),
-        arena_(&pool_) {}
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource(),
+      size_t initialCapacity = 0u)
+      : upstream_(upstream ? upstream : std::pmr::get_default_resource()),
+        pool_(upstream_), overflow_(&pool_) {
+    if (initialCapacity > 0u) {
+      retainBlock(roundUpCapacity(initialCapacity));
+    }
+    rebuildArena();
+  }
+
+  ~ScratchArena() {
+    arena_.reset();
+    releaseBlock();
+  }
 
   ScratchArena(const ScratchArena &) = delete;
   ScratchArena &operator=(const ScratchArena &) = delete;
@@ -19,15 +47,103 @@ public:
   ScratchArena &operator=(ScratchArena &&) = delete;
 
   [[nodiscard]] std::pmr::memory_resource *resource() noexcept {
-    return &arena_;
+    return &*arena_;
   }
 
-  void reset() noexcept { arena_.release(); }
+  void reset() noexcept {
+    arena_->release();
+    const size_t spilledBytes = overflow_.takeAllocatedBytes();
+    if (spilledBytes == 0u) {
+      return;
+    }
+    recordScratchSpill(spilledBytes);
+    const size_t usedBytes = capacity_ + spilledBytes;
+    highWaterMark_ = std::max(highWaterMark_, usedBytes);
+    if (capacity_ >= kMaxRetainedCapacity) {
+      return;
+    }
+    arena_.reset();
+    releaseBlock();
+    try {
+      retainBlock(roundUpCapacity(usedBytes));
+    } catch (const std::bad_alloc &) {
+      // Keep running unbuffered; the next spill retries the growth.
+    }
+    rebuildArena();
+  }
+
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+  [[nodiscard]] size_t highWaterMark() const noexcept {
+    return highWaterMark_;
+  }
 
 private:
   friend class ScopedScratch;
+
+  class OverflowResource final : public std::pmr::memory_resource {
+  public:
+    explicit OverflowResource(std::pmr::memory_resource *upstream) noexcept
+        : upstream_(upstream) {}
+
+    [[nodiscard]] size_t takeAllocatedBytes() noexcept {
+      const size_t bytes = allocatedBytes_;
+      allocatedBytes_ = 0u;
+      return bytes;
+    }
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+      void *ptr = upstream_->allocate(bytes, alignment);
+      allocatedBytes_ += bytes;
+      return ptr;
+    }
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+      upstream_->deallocate(ptr, bytes, alignment);
+    }
+    [[nodiscard]] bool do_is_equal(
+        const std::pmr::memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream_ = nullptr;
+    size_t allocatedBytes_ = 0u;
+  };
+
+  [[nodiscard]] static size_t roundUpCapacity(size_t bytes) noexcept {
+    const size_t clamped = bytes < kMaxRetainedCapacity ? bytes
+                                                        : kMaxRetainedCapacity;
+    return (clamped + kBlockGranularity - 1u) / kBlockGranularity *
+           kBlockGranularity;
+  }
+
+  void retainBlock(size_t bytes) {
+    block_ = upstream_->allocate(bytes, alignof(std::max_align_t));
+    capacity_ = bytes;
+  }
+
+  void releaseBlock() noexcept {
+    if (block_ != nullptr) {
+      upstream_->deallocate(block_, capacity_, alignof(std::max_align_t));
+    }
+    block_ = nullptr;
+    capacity_ = 0u;
+  }
+
+  void rebuildArena() noexcept {
+    if (block_ != nullptr) {
+      arena_.emplace(block_, capacity_, &overflow_);
+    } else {
+      arena_.emplace(&overflow_);
+    }
+  }
+
+  std::pmr::memory_resource *upstream_ = nullptr;
   std::pmr::unsynchronized_pool_resource pool_;
-  std::pmr::monotonic_buffer_resource arena_;
+  OverflowResource overflow_;
+  std::optional<std::pmr::monotonic_buffer_resource> arena_;
+  void *block_ = nullptr;
+  size_t capacity_ = 0u;
+  size_t highWaterMark_ = 0u;
   bool scopeActive_ = false;
 };
 
@@ -57,4 +173,67 @@ private:
   ScratchArena &arena_;
 };
 
+// Scope over the calling thread's persistent scratch stack. Nested guards on
+// the same thread take the next arena, up to kMaxDepth levels.
+class NURI_API ScopedThreadScratch final {
+public:
+  static constexpr uint32_t kMaxDepth = 4u;
+
+  ScopedThreadScratch() noexcept;
+  ~ScopedThreadScratch() noexcept;
+
+  ScopedThreadScratch(const ScopedThreadScratch &) = delete;
+  ScopedThreadScratch &operator=(const ScopedThreadScratch &) = delete;
+  ScopedThreadScratch(ScopedThreadScratch &&) = delete;
+  ScopedThreadScratch &operator=(ScopedThreadScratch &&) = delete;
+
+  [[nodiscard]] std::pmr::memory_resource *resource() noexcept {
+    return scope_.resource();
+  }
+
+private:
+  ScopedScratch scope_;
+};
+
+// One arena per frame in flight. beginFrame() recycles the slot last used
+// FrameCount frames ago, so its data may be referenced until that frame's
+// recording and submission have completed.
+template <uint32_t FrameCount> class FrameArenaRing final {
+public:
+  static_assert(FrameCount > 0u);
+
+  explicit FrameArenaRing(
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : arenas_{makeArenas(
+            upstream, std::make_integer_sequence<uint32_t, FrameCount>{})} {}
+
+  FrameArenaRing(const FrameArenaRing &) = delete;
+  FrameArenaRing &operator=(const FrameArenaRing &) = delete;
+  FrameArenaRing(FrameArenaRing &&) = delete;
+  FrameArenaRing &operator=(FrameArenaRing &&) = delete;
+
+  void beginFrame(uint64_t frameIndex) noexcept {
+    current_ = static_cast<uint32_t>(frameIndex % FrameCount);
+    arenas_[current_].reset();
+  }
+
+  [[nodiscard]] std::pmr::memory_resource *resource() noexcept {
+    return arenas_[current_].resource();
+  }
+  [[nodiscard]] const ScratchArena &arena(uint32_t slot) const noexcept {
+    return arenas_[slot];
+  }
+
+private:
+  template <uint32_t... Slots>
+  static std::array<ScratchArena, FrameCount>
+  makeArenas(std::pmr::memory_resource *upstream,
+             std::integer_sequence<uint32_t, Slots...>) {
+    return {{(static_cast<void>(Slots), ScratchArena(upstream))...}};
+  }
+
+  std::array<ScratchArena, FrameCount> arenas_;
+  uint32_t current_ = 0u;
+};
+
 } // namespace nuri
@@ -37,8 +37,8 @@ constexpr std::array<std::string_view, 3> kRootObjectKeys = {"window", "roots",
                                                              "shaders"};
 constexpr std::array<std::string_view, 4> kWindowKeys = {"title", "width",
                                                          "height", "mode"};
-constexpr std::array<std::string_view, 5> kRootsKeys = {
-    "assets", "shaders", "models", "textures", "fonts"};
+constexpr std::array<std::string_view, 6> kRootsKeys = {
+    "assets", "shaders", "models", "textures", "fonts", "archive"};
 constexpr std::array<std::string_view, 4> kShadersKeys = {
     "debug_grid", "skybox", "opaque", "text_mtsdf"};
 constexpr std::array<std::string_view, 2> kDebugGridShaderKeys = {"vertex",
@@ -277,9 +277,9 @@ resolvePath(std::string_view rawPath, const std::filesystem::path &baseDir,
 
 [[nodiscard]] Result<std::filesystem::path, std::string>
 resolveDirectory(std::string_view rawPath, const std::filesystem::path &baseDir,
-                 std::string_view fieldName) {
+                 std::string_view fieldName, bool requireExisting) {
   auto resolvedResult = resolvePath(rawPath, baseDir, fieldName);
-  if (resolvedResult.hasError()) {
+  if (resolvedResult.hasError() || !requireExisting) {
     return resolvedResult;
   }
   const std::filesystem::path &resolved = resolvedResult.value();
@@ -301,9 +301,9 @@ resolveDirectory(std::string_view rawPath, const std::filesystem::path &baseDir,
 
 [[nodiscard]] Result<std::filesystem::path, std::string>
 resolveFile(std::string_view rawPath, const std::filesystem::path &baseDir,
-            std::string_view fieldName) {
+            std::string_view fieldName, bool requireExisting) {
   auto resolvedResult = resolvePath(rawPath, baseDir, fieldName);
-  if (resolvedResult.hasError()) {
+  if (resolvedResult.hasError() || !requireExisting) {
     return resolvedResult;
   }
   const std::filesystem::path &resolved = resolvedResult.value();
@@ -327,7 +327,8 @@ resolveFile(std::string_view rawPath, const std::filesystem::path &baseDir,
 resolveShaderFileWithDefault(yyjson_val *sectionObj, const char *key,
                              std::string_view sectionFieldName,
                              std::string_view defaultRelativePath,
-                             const std::filesystem::path &shadersRoot) {
+                             const std::filesystem::path &shadersRoot,
+                             bool requireExisting) {
   auto shaderPathText = stringFieldOrDefault(sectionObj, key, sectionFieldName,
                                              defaultRelativePath);
   if (shaderPathText.hasError()) {
@@ -335,7 +336,8 @@ resolveShaderFileWithDefault(yyjson_val *sectionObj, const char *key,
   }
 
   const std::string resolvedFieldName = fieldPath(sectionFieldName, key);
-  return resolveFile(shaderPathText.value(), shadersRoot, resolvedFieldName);
+  return resolveFile(shaderPathText.value(), shadersRoot, resolvedFieldName,
+                     requireExisting);
 }
 
 } // namespace
@@ -516,132 +518,158 @@ loadRuntimeConfig(const std::filesystem::path &configPath) {
   }
 
   const std::filesystem::path configDir = normalizedConfigPath.parent_path();
+  auto archiveText = stringFieldOrDefault(rootsObj, "archive", "roots", "");
+  if (archiveText.hasError()) {
+    return makeError<RuntimeConfig>(archiveText.error());
+  }
+  std::filesystem::path archivePath;
+  bool requireExisting = true;
+  if (!archiveText.value().empty()) {
+    auto archiveResult =
+        resolvePath(archiveText.value(), configDir, "roots.archive");
+    if (archiveResult.hasError()) {
+      return makeError<RuntimeConfig>(archiveResult.error());
+    }
+    archivePath = archiveResult.value();
+    // A packed build may ship without the loose asset tree; its files are
+    // then served from the archive once it is mounted.
+    std::error_code ec;
+    requireExisting = !std::filesystem::is_regular_file(archivePath, ec) || ec;
+  }
   auto assetsRoot =
-      resolveDirectory(assetsRootText.value(), configDir, "roots.assets");
+      resolveDirectory(assetsRootText.value(), configDir, "roots.assets",
+                       requireExisting);
   if (assetsRoot.hasError()) {
     return makeError<RuntimeConfig>(assetsRoot.error());
   }
   auto shadersRoot =
-      resolveDirectory(shadersRootText.value(), configDir, "roots.shaders");
+      resolveDirectory(shadersRootText.value(), configDir, "roots.shaders",
+                       requireExisting);
   if (shadersRoot.hasError()) {
     return makeError<RuntimeConfig>(shadersRoot.error());
   }
   auto modelsRoot =
-      resolveDirectory(modelsRootText.value(), configDir, "roots.models");
+      resolveDirectory(modelsRootText.value(), configDir, "roots.models",
+                       requireExisting);
   if (modelsRoot.hasError()) {
     return makeError<RuntimeConfig>(modelsRoot.error());
   }
   auto texturesRoot =
-      resolveDirectory(texturesRootText.value(), configDir, "roots.textures");
+      resolveDirectory(texturesRootText.value(), configDir, "roots.textures",
+                       requireExisting);
   if (texturesRoot.hasError()) {
     return makeError<RuntimeConfig>(texturesRoot.error());
   }
   auto fontsRoot =
-      resolveDirectory(fontsRootText.value(), configDir, "roots.fonts");
+      resolveDirectory(fontsRootText.value(), configDir, "roots.fonts",
+                       requireExisting);
   if (fontsRoot.hasError()) {
     return makeError<RuntimeConfig>(fontsRoot.error());
   }
 
   auto debugGridVertexPath = resolveShaderFileWithDefault(
       debugGridObj, "vertex", "shaders.debug_grid",
-      kDefaultDebugGridVertexShader, shadersRoot.value());
+      kDefaultDebugGridVertexShader, shadersRoot.value(), requireExisting);
   if (debugGridVertexPath.hasError()) {
     return makeError<RuntimeConfig>(debugGridVertexPath.error());
   }
   auto debugGridFragmentPath = resolveShaderFileWithDefault(
       debugGridObj, "fragment", "shaders.debug_grid",
-      kDefaultDebugGridFragmentShader, shadersRoot.value());
+      kDefaultDebugGridFragmentShader, shadersRoot.value(), requireExisting);
   if (debugGridFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(debugGridFragmentPath.error());
   }
   auto skyboxVertexPath = resolveShaderFileWithDefault(
       skyboxObj, "vertex", "shaders.skybox", kDefaultSkyboxVertexShader,
-      shadersRoot.value());
+      shadersRoot.value(), requireExisting);
   if (skyboxVertexPath.hasError()) {
     return makeError<RuntimeConfig>(skyboxVertexPath.error());
   }
   auto skyboxFragmentPath = resolveShaderFileWithDefault(
       skyboxObj, "fragment", "shaders.skybox", kDefaultSkyboxFragmentShader,
-      shadersRoot.value());
+      shadersRoot.value(), requireExisting);
   if (skyboxFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(skyboxFragmentPath.error());
   }
 
   auto meshVertexPath = resolveShaderFileWithDefault(
       opaqueObj, "mesh_vertex", "shaders.opaque",
-      kDefaultOpaqueMeshVertexShader, shadersRoot.value());
+      kDefaultOpaqueMeshVertexShader, shadersRoot.value(), requireExisting);
   if (meshVertexPath.hasError()) {
     return makeError<RuntimeConfig>(meshVertexPath.error());
   }
   auto meshFragmentPath = resolveShaderFileWithDefault(
       opaqueObj, "mesh_fragment", "shaders.opaque",
-      kDefaultOpaqueMeshFragmentShader, shadersRoot.value());
+      kDefaultOpaqueMeshFragmentShader, shadersRoot.value(), requireExisting);
   if (meshFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(meshFragmentPath.error());
   }
   auto pickFragmentPath = resolveShaderFileWithDefault(
       opaqueObj, "pick_fragment", "shaders.opaque",
-      kDefaultOpaquePickFragmentShader, shadersRoot.value());
+      kDefaultOpaquePickFragmentShader, shadersRoot.value(), requireExisting);
   if (pickFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(pickFragmentPath.error());
   }
   auto computeInstancesPath = resolveShaderFileWithDefault(
       opaqueObj, "compute_instances", "shaders.opaque",
-      kDefaultOpaqueComputeShader, shadersRoot.value());
+      kDefaultOpaqueComputeShader, shadersRoot.value(), requireExisting);
   if (computeInstancesPath.hasError()) {
     return makeError<RuntimeConfig>(computeInstancesPath.error());
   }
   auto tessVertexPath = resolveShaderFileWithDefault(
       opaqueObj, "tess_vertex", "shaders.opaque",
-      kDefaultOpaqueTessVertexShader, shadersRoot.value());
+      kDefaultOpaqueTessVertexShader, shadersRoot.value(), requireExisting);
   if (tessVertexPath.hasError()) {
     return makeError<RuntimeConfig>(tessVertexPath.error());
   }
   auto tessControlPath = resolveShaderFileWithDefault(
       opaqueObj, "tess_control", "shaders.opaque",
-      kDefaultOpaqueTessControlShader, shadersRoot.value());
+      kDefaultOpaqueTessControlShader, shadersRoot.value(), requireExisting);
   if (tessControlPath.hasError()) {
     return makeError<RuntimeConfig>(tessControlPath.error());
   }
   auto tessEvalPath = resolveShaderFileWithDefault(
       opaqueObj, "tess_eval", "shaders.opaque", kDefaultOpaqueTessEvalShader,
-      shadersRoot.value());
+      shadersRoot.value(), requireExisting);
   if (tessEvalPath.hasError()) {
     return makeError<RuntimeConfig>(tessEvalPath.error());
   }
   auto overlayGeometryPath = resolveShaderFileWithDefault(
       opaqueObj, "overlay_geometry", "shaders.opaque",
-      kDefaultOpaqueOverlayGeometryShader, shadersRoot.value());
+      kDefaultOpaqueOverlayGeometryShader, shadersRoot.value(),
+      requireExisting);
   if (overlayGeometryPath.hasError()) {
     return makeError<RuntimeConfig>(overlayGeometryPath.error());
   }
   auto overlayFragmentPath = resolveShaderFileWithDefault(
       opaqueObj, "overlay_fragment", "shaders.opaque",
-      kDefaultOpaqueOverlayFragmentShader, shadersRoot.value());
+      kDefaultOpaqueOverlayFragmentShader, shadersRoot.value(),
+      requireExisting);
   if (overlayFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(overlayFragmentPath.error());
   }
   auto textMtsdfUiVertexPath = resolveShaderFileWithDefault(
       textMtsdfObj, "ui_vertex", "shaders.text_mtsdf",
-      kDefaultTextMtsdfUiVertexShader, shadersRoot.value());
+      kDefaultTextMtsdfUiVertexShader, shadersRoot.value(), requireExisting);
   if (textMtsdfUiVertexPath.hasError()) {
     return makeError<RuntimeConfig>(textMtsdfUiVertexPath.error());
   }
   auto textMtsdfUiFragmentPath = resolveShaderFileWithDefault(
       textMtsdfObj, "ui_fragment", "shaders.text_mtsdf",
-      kDefaultTextMtsdfUiFragmentShader, shadersRoot.value());
+      kDefaultTextMtsdfUiFragmentShader, shadersRoot.value(), requireExisting);
   if (textMtsdfUiFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(textMtsdfUiFragmentPath.error());
   }
   auto textMtsdfWorldVertexPath = resolveShaderFileWithDefault(
       textMtsdfObj, "world_vertex", "shaders.text_mtsdf",
-      kDefaultTextMtsdfWorldVertexShader, shadersRoot.value());
+      kDefaultTextMtsdfWorldVertexShader, shadersRoot.value(), requireExisting);
   if (textMtsdfWorldVertexPath.hasError()) {
     return makeError<RuntimeConfig>(textMtsdfWorldVertexPath.error());
   }
   auto textMtsdfWorldFragmentPath = resolveShaderFileWithDefault(
       textMtsdfObj, "world_fragment", "shaders.text_mtsdf",
-      kDefaultTextMtsdfWorldFragmentShader, shadersRoot.value());
+      kDefaultTextMtsdfWorldFragmentShader, shadersRoot.value(),
+      requireExisting);
   if (textMtsdfWorldFragmentPath.hasError()) {
     return makeError<RuntimeConfig>(textMtsdfWorldFragmentPath.error());
   }
@@ -660,6 +688,7 @@ loadRuntimeConfig(const std::filesystem::path &configPath) {
       .models = modelsRoot.value(),
       .textures = texturesRoot.value(),
       .fonts = fontsRoot.value(),
+      .archive = std::move(archivePath),
   };
   config.shaders = RuntimeShaderConfig{
       .debugGrid =
@@ -23,6 +23,9 @@ struct NURI_API RuntimeRootsConfig {
   std::filesystem::path models;
   std::filesystem::path textures;
   std::filesystem::path fonts;
+  // Optional packed asset archive; empty when the config has no
+  // roots.archive entry.
+  std::filesystem::path archive;
 };
 
 struct NURI_API RuntimeDebugShaderConfig {
@@ -0,0 +1,234 @@
+#include "nuri/pch.h"
+
+#include "nuri/core/startup_task_graph.h"
+
+#include "nuri/core/profiling.h"
+
+namespace nuri {
+
+namespace {
+
+using StartupClock = std::chrono::steady_clock;
+
+[[nodiscard]] double secondsBetween(StartupClock::time_point begin,
+                                    StartupClock::time_point end) {
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+} // namespace
+
+StartupTaskGraph::StartupTaskGraph(std::pmr::memory_resource *memory)
+    : memory_(memory != nullptr ? memory : std::pmr::get_default_resource()),
+      tasks_(memory_) {}
+
+uint32_t StartupTaskGraph::defaultWorkerCount() noexcept {
+  const uint32_t hardwareCount =
+      static_cast<uint32_t>(std::thread::hardware_concurrency());
+  return std::clamp(hardwareCount > 1u ? hardwareCount - 1u : 1u, 1u, 8u);
+}
+
+Result<StartupTaskId, std::string>
+StartupTaskGraph::addTask(const StartupTaskDesc &desc) {
+  if (!desc.run) {
+    return Result<StartupTaskId, std::string>::makeError(
+        "StartupTaskGraph::addTask: task '" + std::string(desc.name) +
+        "' has no callback");
+  }
+  const uint32_t index = static_cast<uint32_t>(tasks_.size());
+  for (const StartupTaskId dependency : desc.dependencies) {
+    if (!isValid(dependency) || dependency.value >= index) {
+      return Result<StartupTaskId, std::string>::makeError(
+          "StartupTaskGraph::addTask: task '" + std::string(desc.name) +
+          "' depends on an unknown task");
+    }
+  }
+
+  Task task(memory_);
+  task.name.assign(desc.name.data(), desc.name.size());
+  task.affinity = desc.affinity;
+  task.run = desc.run;
+  for (const StartupTaskId dependency : desc.dependencies) {
+    std::pmr::vector<uint32_t> &dependents =
+        tasks_[dependency.value].dependents;
+    // Duplicate edges would be counted twice but only released once.
+    if (std::find(dependents.begin(), dependents.end(), index) !=
+        dependents.end()) {
+      continue;
+    }
+    dependents.push_back(index);
+    ++task.dependencyCount;
+  }
+  tasks_.push_back(std::move(task));
+  return Result<StartupTaskId, std::string>::makeResult(
+      StartupTaskId{.value = index});
+}
+
+StartupReport StartupTaskGraph::run(uint32_t workerCount) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  const StartupClock::time_point runBegin = StartupClock::now();
+  const uint32_t taskCount = static_cast<uint32_t>(tasks_.size());
+
+  StartupReport report{};
+  report.tasks.resize(taskCount);
+  uint32_t workerTaskCount = 0u;
+  for (uint32_t i = 0u; i < taskCount; ++i) {
+    report.tasks[i].name.assign(tasks_[i].name.data(), tasks_[i].name.size());
+    report.tasks[i].affinity = tasks_[i].affinity;
+    if (tasks_[i].affinity == StartupTaskAffinity::Worker) {
+      ++workerTaskCount;
+    }
+  }
+  report.workerCount = std::min(workerCount, workerTaskCount);
+
+  std::mutex mutex;
+  std::condition_variable cvReady;
+  std::pmr::vector<uint32_t> pendingDependencies(memory_);
+  std::pmr::vector<uint8_t> dependencyFailed(memory_);
+  std::pmr::deque<uint32_t> workerQueue(memory_);
+  std::pmr::deque<uint32_t> mainQueue(memory_);
+  std::pmr::vector<uint32_t> releaseStack(memory_);
+  pendingDependencies.reserve(taskCount);
+  dependencyFailed.assign(taskCount, 0u);
+  uint32_t remaining = taskCount;
+
+  const auto enqueue = [&](uint32_t index) {
+    if (tasks_[index].affinity == StartupTaskAffinity::MainThread) {
+      mainQueue.push_back(index);
+    } else {
+      workerQueue.push_back(index);
+    }
+  };
+  for (uint32_t i = 0u; i < taskCount; ++i) {
+    pendingDependencies.push_back(tasks_[i].dependencyCount);
+    if (tasks_[i].dependencyCount == 0u) {
+      enqueue(i);
+    }
+  }
+
+  // Called with the mutex held. Skipped dependents are retired here so the
+  // failure propagates without ever being scheduled.
+  const auto finish = [&](uint32_t index, bool succeeded) {
+    releaseStack.clear();
+    releaseStack.push_back(index);
+    dependencyFailed[index] = succeeded ? 0u : 1u;
+    while (!releaseStack.empty()) {
+      const uint32_t finished = releaseStack.back();
+      releaseStack.pop_back();
+      --remaining;
+      const bool failed = dependencyFailed[finished] != 0u;
+      for (const uint32_t dependent : tasks_[finished].dependents) {
+        if (failed) {
+          dependencyFailed[dependent] = 1u;
+        }
+        if (--pendingDependencies[dependent] != 0u) {
+          continue;
+        }
+        if (dependencyFailed[dependent] != 0u) {
+          report.tasks[dependent].status = StartupTaskStatus::Skipped;
+          releaseStack.push_back(dependent);
+        } else {
+          enqueue(dependent);
+        }
+      }
+    }
+    cvReady.notify_all();
+  };
+
+  const auto execute = [&](uint32_t index, uint32_t workerIndex) {
+    StartupTaskTiming &timing = report.tasks[index];
+    const StartupClock::time_point taskBegin = StartupClock::now();
+    bool succeeded = false;
+    {
+      NURI_PROFILER_ZONE("StartupTaskGraph.task", NURI_PROFILER_COLOR_CREATE);
+      try {
+        auto result = tasks_[index].run();
+        succeeded = !result.hasError();
+        if (!succeeded) {
+          timing.error = result.error();
+        }
+      } catch (const std::exception &e) {
+        timing.error = std::string("unhandled exception: ") + e.what();
+      } catch (...) {
+        timing.error = "unhandled exception";
+      }
+      NURI_PROFILER_ZONE_END();
+    }
+    const StartupClock::time_point taskEnd = StartupClock::now();
+    timing.startSeconds = secondsBetween(runBegin, taskBegin);
+    timing.durationSeconds = secondsBetween(taskBegin, taskEnd);
+    timing.workerIndex = workerIndex;
+    timing.status =
+        succeeded ? StartupTaskStatus::Succeeded : StartupTaskStatus::Failed;
+
+    std::scoped_lock lock(mutex);
+    finish(index, succeeded);
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(report.workerCount);
+    for (uint32_t workerIndex = 0u; workerIndex < report.workerCount;
+         ++workerIndex) {
+      workers.emplace_back([&, workerIndex] {
+        NURI_PROFILER_THREAD("StartupWorker");
+        while (true) {
+          uint32_t index = 0u;
+          {
+            std::unique_lock lock(mutex);
+            cvReady.wait(lock, [&] {
+              return remaining == 0u || !workerQueue.empty();
+            });
+            if (workerQueue.empty()) {
+              return;
+            }
+            index = workerQueue.front();
+            workerQueue.pop_front();
+          }
+          execute(index, workerIndex);
+        }
+      });
+    }
+
+    // The calling thread owns MainThread tasks; without workers it also
+    // drains the worker queue.
+    const bool mainRunsWorkerTasks = report.workerCount == 0u;
+    while (true) {
+      uint32_t index = 0u;
+      {
+        std::unique_lock lock(mutex);
+        cvReady.wait(lock, [&] {
+          return remaining == 0u || !mainQueue.empty() ||
+                 (mainRunsWorkerTasks && !workerQueue.empty());
+        });
+        if (!mainQueue.empty()) {
+          index = mainQueue.front();
+          mainQueue.pop_front();
+        } else if (mainRunsWorkerTasks && !workerQueue.empty()) {
+          index = workerQueue.front();
+          workerQueue.pop_front();
+        } else {
+          break;
+        }
+      }
+      execute(index, UINT32_MAX);
+    }
+  }
+
+  for (const StartupTaskTiming &timing : report.tasks) {
+    if (timing.status == StartupTaskStatus::Failed) {
+      ++report.failedTaskCount;
+    } else if (timing.status == StartupTaskStatus::Skipped) {
+      ++report.skippedTaskCount;
+    }
+    if (timing.workerIndex == UINT32_MAX) {
+      report.mainThreadBusySeconds += timing.durationSeconds;
+    } else {
+      report.workerBusySeconds += timing.durationSeconds;
+    }
+  }
+  report.wallSeconds = secondsBetween(runBegin, StartupClock::now());
+  tasks_.clear();
+  return report;
+}
+
+} // namespace nuri
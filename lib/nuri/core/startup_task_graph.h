@@ -0,0 +1,116 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nuri {
+
+enum class StartupTaskAffinity : uint8_t {
+  Worker,
+  // GPU object creation and anything else bound to the window/device thread.
+  MainThread,
+};
+
+enum class StartupTaskStatus : uint8_t {
+  Pending,
+  Succeeded,
+  Failed,
+  // Not run because a dependency failed or was skipped.
+  Skipped,
+};
+
+struct NURI_API StartupTaskId {
+  uint32_t value = UINT32_MAX;
+};
+
+[[nodiscard]] inline bool isValid(StartupTaskId id) noexcept {
+  return id.value != UINT32_MAX;
+}
+
+struct NURI_API StartupTaskDesc {
+  std::string_view name{};
+  StartupTaskAffinity affinity = StartupTaskAffinity::Worker;
+  // Must refer to tasks added earlier, which keeps the graph acyclic.
+  std::span<const StartupTaskId> dependencies{};
+  std::function<Result<bool, std::string>()> run{};
+};
+
+struct NURI_API StartupTaskTiming {
+  std::string name{};
+  StartupTaskAffinity affinity = StartupTaskAffinity::Worker;
+  StartupTaskStatus status = StartupTaskStatus::Pending;
+  // Relative to the start of StartupTaskGraph::run().
+  double startSeconds = 0.0;
+  double durationSeconds = 0.0;
+  // UINT32_MAX when the task ran on the calling (main) thread.
+  uint32_t workerIndex = UINT32_MAX;
+  std::string error{};
+};
+
+struct NURI_API StartupReport {
+  std::vector<StartupTaskTiming> tasks{};
+  double wallSeconds = 0.0;
+  double mainThreadBusySeconds = 0.0;
+  double workerBusySeconds = 0.0;
+  uint32_t workerCount = 0u;
+  uint32_t failedTaskCount = 0u;
+  uint32_t skippedTaskCount = 0u;
+
+  [[nodiscard]] bool succeeded() const noexcept {
+    return failedTaskCount == 0u && skippedTaskCount == 0u;
+  }
+};
+
+// One-shot dependency graph for application startup. Worker tasks (file I/O,
+// decoding, cache warmup) run on a transient thread pool while the calling
+// thread executes MainThread tasks as soon as their inputs are ready, so GPU
+// uploads overlap with the remaining CPU work.
+class NURI_API StartupTaskGraph {
+public:
+  explicit StartupTaskGraph(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+  ~StartupTaskGraph() = default;
+
+  StartupTaskGraph(const StartupTaskGraph &) = delete;
+  StartupTaskGraph &operator=(const StartupTaskGraph &) = delete;
+  StartupTaskGraph(StartupTaskGraph &&) = delete;
+  StartupTaskGraph &operator=(StartupTaskGraph &&) = delete;
+
+  [[nodiscard]] Result<StartupTaskId, std::string>
+  addTask(const StartupTaskDesc &desc);
+
+  // Blocks until every task finished or was skipped, then clears the graph.
+  // With workerCount == 0 all tasks run on the calling thread.
+  [[nodiscard]] StartupReport run(uint32_t workerCount);
+
+  [[nodiscard]] size_t taskCount() const noexcept { return tasks_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return tasks_.empty(); }
+
+  // Default worker count: hardware threads minus the main thread, at most 8.
+  [[nodiscard]] static uint32_t defaultWorkerCount() noexcept;
+
+private:
+  struct Task {
+    std::pmr::string name;
+    StartupTaskAffinity affinity = StartupTaskAffinity::Worker;
+    std::pmr::vector<uint32_t> dependents;
+    uint32_t dependencyCount = 0u;
+    std::function<Result<bool, std::string>()> run{};
+
+    explicit Task(std::pmr::memory_resource *memory)
+        : name(memory), dependents(memory) {}
+  };
+
+  std::pmr::memory_resource *memory_ = nullptr;
+  std::pmr::vector<Task> tasks_;
+};
+
+} // namespace nuri
@@ -31,6 +31,8 @@ public:
   Window &operator=(Window &&) = delete;
 
   virtual void pollEvents() = 0;
+  // Blocks until an event arrives or the timeout elapses, then processes it.
+  virtual void waitEvents(double timeoutSeconds) = 0;
   virtual bool shouldClose() const = 0;
   virtual void getWindowSize(int32_t &outWidth, int32_t &outHeight) const = 0;
   virtual void getFramebufferSize(int32_t &outWidth,
@@ -3,9 +3,15 @@
 #include "nuri/core/profiling.h"
 #include "nuri/gfx/gpu_descriptors.h"
 
+#include <numbers>
+
 namespace nuri {
 namespace {
 
+constexpr uint32_t kSphereSegments = 32;
+constexpr int kFrustumGridLines = 100;
+constexpr float kFrustumGridTint = 0.7f;
+
 constexpr std::string_view kDebugDraw3DVS = R"(
 #version 460
 #extension GL_EXT_buffer_reference : require
@@ -32,6 +38,47 @@ void main() {
 }
 )";
 
+// Expands one unit-shape vertex per primitive instance; firstVertex selects the
+// shape and firstInstance the primitive type's slice of the instance buffer.
+constexpr std::string_view kDebugDraw3DPrimitiveVS = R"(
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+layout(location = 0) out vec4 outColor;
+
+struct Vertex {
+  vec4 pos;
+  vec4 rgba;
+};
+
+struct Primitive {
+  mat4 transform;
+  vec4 color;
+};
+
+layout(std430, buffer_reference) readonly buffer VertexBuffer {
+  Vertex vertices[];
+};
+
+layout(std430, buffer_reference) readonly buffer PrimitiveBuffer {
+  Primitive primitives[];
+};
+
+layout(push_constant) uniform PushConstants {
+  mat4 mvp;
+  VertexBuffer vb;
+  PrimitiveBuffer pb;
+} pc;
+
+void main() {
+  const Vertex v = pc.vb.vertices[gl_VertexIndex];
+  const Primitive p = pc.pb.primitives[gl_InstanceIndex];
+  const vec4 world = p.transform * vec4(v.pos.xyz, 1.0);
+  outColor = v.rgba * p.color;
+  gl_Position = pc.mvp * vec4(world.xyz / world.w, 1.0);
+}
+)";
+
 constexpr std::string_view kDebugDraw3DFS = R"(
 #version 460
 
@@ -54,32 +101,71 @@ resolveMemoryResource(std::pmr::memory_resource *memoryResource) {
 DebugDraw3D::DebugDraw3D(GPUDevice &gpu,
                          std::pmr::memory_resource *memoryResource)
     : gpu_(gpu), lines_(resolveMemoryResource(memoryResource)),
+      primitives_{
+          std::pmr::vector<PrimitiveData>(
+              resolveMemoryResource(memoryResource)),
+          std::pmr::vector<PrimitiveData>(
+              resolveMemoryResource(memoryResource)),
+          std::pmr::vector<PrimitiveData>(
+              resolveMemoryResource(memoryResource)),
+          std::pmr::vector<PrimitiveData>(
+              resolveMemoryResource(memoryResource)),
+      },
       frameBuffers_(resolveMemoryResource(memoryResource)) {}
 
 DebugDraw3D::~DebugDraw3D() {
   for (const FrameBufferState &frame : frameBuffers_) {
-    if (nuri::isValid(frame.buffer)) {
-      gpu_.destroyBuffer(frame.buffer);
+    if (nuri::isValid(frame.lines.buffer)) {
+      gpu_.destroyBuffer(frame.lines.buffer);
+    }
+    if (nuri::isValid(frame.primitives.buffer)) {
+      gpu_.destroyBuffer(frame.primitives.buffer);
     }
   }
+  if (nuri::isValid(unitMeshBuffer_)) {
+    gpu_.destroyBuffer(unitMeshBuffer_);
+  }
 
   if (nuri::isValid(pipeline_)) {
     gpu_.destroyRenderPipeline(pipeline_);
   }
+  if (nuri::isValid(primitivePipeline_)) {
+    gpu_.destroyRenderPipeline(primitivePipeline_);
+  }
   if (nuri::isValid(vert_)) {
     gpu_.destroyShaderModule(vert_);
   }
+  if (nuri::isValid(primitiveVert_)) {
+    gpu_.destroyShaderModule(primitiveVert_);
+  }
   if (nuri::isValid(frag_)) {
     gpu_.destroyShaderModule(frag_);
   }
 }
 
+void DebugDraw3D::clear() {
+  lines_.clear();
+  for (std::pmr::vector<PrimitiveData> &primitives : primitives_) {
+    primitives.clear();
+  }
+}
+
 void DebugDraw3D::line(const glm::vec3 &p1, const glm::vec3 &p2,
                        const glm::vec4 &c) {
   lines_.push_back({.pos = glm::vec4(p1, 1.0f), .color = c});
   lines_.push_back({.pos = glm::vec4(p2, 1.0f), .color = c});
 }
 
+void DebugDraw3D::primitive(DebugPrimitive type, const glm::mat4 &transform,
+                            const glm::vec4 &color) {
+  const size_t typeIndex = static_cast<size_t>(type);
+  if (typeIndex >= kPrimitiveTypeCount) {
+    return;
+  }
+  primitives_[typeIndex].push_back(
+      PrimitiveData{.transform = transform, .color = color});
+}
+
 void DebugDraw3D::plane(const glm::vec3 &o, const glm::vec3 &v1,
                         const glm::vec3 &v2, int n1, int n2, float s1, float s2,
                         const glm::vec4 &color, const glm::vec4 &outlineColor) {
@@ -108,34 +194,7 @@ void DebugDraw3D::plane(const glm::vec3 &o, const glm::vec3 &v1,
 
 void DebugDraw3D::box(const glm::mat4 &m, const glm::vec3 &size,
                       const glm::vec4 &c) {
-  glm::vec3 pts[8] = {
-      glm::vec3(+size.x, +size.y, +size.z),
-      glm::vec3(+size.x, +size.y, -size.z),
-      glm::vec3(+size.x, -size.y, +size.z),
-      glm::vec3(+size.x, -size.y, -size.z),
-      glm::vec3(-size.x, +size.y, +size.z),
-      glm::vec3(-size.x, +size.y, -size.z),
-      glm::vec3(-size.x, -size.y, +size.z),
-      glm::vec3(-size.x, -size.y, -size.z),
-  };
-
-  for (auto &p : pts)
-    p = glm::vec3(m * glm::vec4(p, 1.f));
-
-  line(pts[0], pts[1], c);
-  line(pts[2], pts[3], c);
-  line(pts[4], pts[5], c);
-  line(pts[6], pts[7], c);
-
-  line(pts[0], pts[2], c);
-  line(pts[1], pts[3], c);
-  line(pts[4], pts[6], c);
-  line(pts[5], pts[7], c);
-
-  line(pts[0], pts[4], c);
-  line(pts[1], pts[5], c);
-  line(pts[2], pts[6], c);
-  line(pts[3], pts[7], c);
+  primitive(DebugPrimitive::Box, m * glm::scale(glm::mat4(1.0f), size), c);
 }
 
 void DebugDraw3D::box(const glm::mat4 &m, const BoundingBox &box,
@@ -144,94 +203,156 @@ void DebugDraw3D::box(const glm::mat4 &m, const BoundingBox &box,
             0.5f * glm::vec3(box.max_ - box.min_), color);
 }
 
+void DebugDraw3D::sphere(const glm::vec3 &center, float radius,
+                         const glm::vec4 &color) {
+  primitive(DebugPrimitive::Sphere,
+            glm::scale(glm::translate(glm::mat4(1.0f), center),
+                       glm::vec3(radius)),
+            color);
+}
+
+void DebugDraw3D::axes(const glm::mat4 &m, float length) {
+  primitive(DebugPrimitive::Axis, m * glm::scale(glm::mat4(1.0f),
+                                                 glm::vec3(length)),
+            glm::vec4(1.0f));
+}
+
 void DebugDraw3D::frustum(const glm::mat4 &camView, const glm::mat4 &camProj,
                           const glm::vec4 &color) {
+  const glm::mat4 invViewProj = glm::inverse(camProj * camView);
+  primitive(DebugPrimitive::Frustum, invViewProj, color);
+
+  // The side grids are spaced evenly in world space, which a projective
+  // transform of a fixed NDC shape cannot express, so they stay on the line
+  // path.
   const glm::vec3 corners[] = {glm::vec3(-1, -1, -1), glm::vec3(+1, -1, -1),
                                glm::vec3(+1, +1, -1), glm::vec3(-1, +1, -1),
                                glm::vec3(-1, -1, +1), glm::vec3(+1, -1, +1),
                                glm::vec3(+1, +1, +1), glm::vec3(-1, +1, +1)};
-
   glm::vec3 pp[8];
-
-  for (int i = 0; i < 8; i++) {
-    glm::vec4 q = glm::inverse(camView) * glm::inverse(camProj) *
-                  glm::vec4(corners[i], 1.0f);
-    pp[i] = glm::vec3(q.x / q.w, q.y / q.w, q.z / q.w);
-  }
-  line(pp[0], pp[4], color);
-  line(pp[1], pp[5], color);
-  line(pp[2], pp[6], color);
-  line(pp[3], pp[7], color);
-  // near
-  line(pp[0], pp[1], color);
-  line(pp[1], pp[2], color);
-  line(pp[2], pp[3], color);
-  line(pp[3], pp[0], color);
-  // x
-  line(pp[0], pp[2], color);
-  line(pp[1], pp[3], color);
-  // far
-  line(pp[4], pp[5], color);
-  line(pp[5], pp[6], color);
-  line(pp[6], pp[7], color);
-  line(pp[7], pp[4], color);
-  // x
-  line(pp[4], pp[6], color);
-  line(pp[5], pp[7], color);
-
-  const glm::vec4 gridColor = color * 0.7f;
-  const int gridLines = 100;
-
-  // bottom
-  {
-    glm::vec3 p1 = pp[0];
-    glm::vec3 p2 = pp[1];
-    const glm::vec3 s1 = (pp[4] - pp[0]) / float(gridLines);
-    const glm::vec3 s2 = (pp[5] - pp[1]) / float(gridLines);
-    for (int i = 0; i != gridLines; i++, p1 += s1, p2 += s2)
+  for (int i = 0; i < 8; ++i) {
+    const glm::vec4 q = invViewProj * glm::vec4(corners[i], 1.0f);
+    pp[i] = glm::vec3(q) / q.w;
+  }
+
+  // bottom, top, left and right grids
+  const glm::vec4 gridColor = color * kFrustumGridTint;
+  const std::pair<int, int> gridEdges[] = {{0, 1}, {2, 3}, {0, 3}, {1, 2}};
+  for (const auto &[a, b] : gridEdges) {
+    glm::vec3 p1 = pp[a];
+    glm::vec3 p2 = pp[b];
+    const glm::vec3 s1 = (pp[a + 4] - pp[a]) / float(kFrustumGridLines);
+    const glm::vec3 s2 = (pp[b + 4] - pp[b]) / float(kFrustumGridLines);
+    for (int i = 0; i != kFrustumGridLines; ++i, p1 += s1, p2 += s2) {
       line(p1, p2, gridColor);
+    }
   }
-  // top
-  {
-    glm::vec3 p1 = pp[2];
-    glm::vec3 p2 = pp[3];
-    const glm::vec3 s1 = (pp[6] - pp[2]) / float(gridLines);
-    const glm::vec3 s2 = (pp[7] - pp[3]) / float(gridLines);
-    for (int i = 0; i != gridLines; i++, p1 += s1, p2 += s2)
-      line(p1, p2, gridColor);
+}
+
+Result<bool, std::string> DebugDraw3D::ensureUnitMeshBuffer() {
+  if (nuri::isValid(unitMeshBuffer_)) {
+    return Result<bool, std::string>::makeResult(true);
   }
-  // left
-  {
-    glm::vec3 p1 = pp[0];
-    glm::vec3 p2 = pp[3];
-    const glm::vec3 s1 = (pp[4] - pp[0]) / float(gridLines);
-    const glm::vec3 s2 = (pp[7] - pp[3]) / float(gridLines);
-    for (int i = 0; i != gridLines; i++, p1 += s1, p2 += s2)
-      line(p1, p2, gridColor);
+
+  std::pmr::vector<LineData> vertices(lines_.get_allocator().resource());
+  const auto addLine = [&vertices](const glm::vec3 &p1, const glm::vec3 &p2,
+                                   const glm::vec4 &c) {
+    vertices.push_back({.pos = glm::vec4(p1, 1.0f), .color = c});
+    vertices.push_back({.pos = glm::vec4(p2, 1.0f), .color = c});
+  };
+  const auto beginShape = [this, &vertices](DebugPrimitive type) {
+    unitMeshFirstVertex_[static_cast<size_t>(type)] =
+        static_cast<uint32_t>(vertices.size());
+  };
+  const auto endShape = [this, &vertices](DebugPrimitive type) {
+    const size_t typeIndex = static_cast<size_t>(type);
+    unitMeshVertexCount_[typeIndex] = static_cast<uint32_t>(vertices.size()) -
+                                      unitMeshFirstVertex_[typeIndex];
+  };
+  const glm::vec4 white(1.0f);
+
+  // Box and frustum share the cube corners; the frustum's are NDC.
+  const glm::vec3 corners[] = {glm::vec3(-1, -1, -1), glm::vec3(+1, -1, -1),
+                               glm::vec3(+1, +1, -1), glm::vec3(-1, +1, -1),
+                               glm::vec3(-1, -1, +1), glm::vec3(+1, -1, +1),
+                               glm::vec3(+1, +1, +1), glm::vec3(-1, +1, +1)};
+  const auto addCubeEdges = [&addLine, &corners](const glm::vec4 &c) {
+    for (int i = 0; i < 4; ++i) {
+      addLine(corners[i], corners[(i + 1) % 4], c);
+      addLine(corners[i + 4], corners[(i + 1) % 4 + 4], c);
+      addLine(corners[i], corners[i + 4], c);
+    }
+  };
+
+  beginShape(DebugPrimitive::Box);
+  addCubeEdges(white);
+  endShape(DebugPrimitive::Box);
+
+  beginShape(DebugPrimitive::Sphere);
+  for (int axis = 0; axis < 3; ++axis) {
+    const auto circlePoint = [axis](uint32_t segment) {
+      const float angle = 2.0f * std::numbers::pi_v<float> *
+                          static_cast<float>(segment) /
+                          static_cast<float>(kSphereSegments);
+      glm::vec3 p(0.0f);
+      p[(axis + 1) % 3] = std::cos(angle);
+      p[(axis + 2) % 3] = std::sin(angle);
+      return p;
+    };
+    for (uint32_t segment = 0; segment < kSphereSegments; ++segment) {
+      addLine(circlePoint(segment), circlePoint(segment + 1u), white);
+    }
   }
-  // right
-  {
-    glm::vec3 p1 = pp[1];
-    glm::vec3 p2 = pp[2];
-    const glm::vec3 s1 = (pp[5] - pp[1]) / float(gridLines);
-    const glm::vec3 s2 = (pp[6] - pp[2]) / float(gridLines);
-    for (int i = 0; i != gridLines; i++, p1 += s1, p2 += s2)
-      line(p1, p2, gridColor);
+  endShape(DebugPrimitive::Sphere);
+
+  beginShape(DebugPrimitive::Frustum);
+  addCubeEdges(white);
+  // x
+  addLine(corners[0], corners[2], white);
+  addLine(corners[1], corners[3], white);
+  addLine(corners[4], corners[6], white);
+  addLine(corners[5], corners[7], white);
+  endShape(DebugPrimitive::Frustum);
+
+  beginShape(DebugPrimitive::Axis);
+  addLine(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f),
+          glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+  addLine(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+          glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+  addLine(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f),
+          glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+  endShape(DebugPrimitive::Axis);
+
+  const std::span<const std::byte> bytes{
+      reinterpret_cast<const std::byte *>(vertices.data()),
+      vertices.size() * sizeof(LineData)};
+  auto bufferResult = gpu_.createBuffer(
+      BufferDesc{
+          .usage = BufferUsage::Storage,
+          .storage = Storage::Device,
+          .size = bytes.size(),
+          .data = bytes,
+      },
+      "DebugDraw3D Unit Mesh Buffer");
+  if (bufferResult.hasError()) {
+    return Result<bool, std::string>::makeError(bufferResult.error());
   }
+
+  unitMeshBuffer_ = bufferResult.value();
+  return Result<bool, std::string>::makeResult(true);
 }
 
 Result<bool, std::string> DebugDraw3D::ensureShaderModules() {
-  if (nuri::isValid(vert_) && nuri::isValid(frag_)) {
+  if (nuri::isValid(vert_) && nuri::isValid(primitiveVert_) &&
+      nuri::isValid(frag_)) {
     return Result<bool, std::string>::makeResult(true);
   }
 
-  if (nuri::isValid(vert_)) {
-    gpu_.destroyShaderModule(vert_);
-    vert_ = ShaderHandle{};
-  }
-  if (nuri::isValid(frag_)) {
-    gpu_.destroyShaderModule(frag_);
-    frag_ = ShaderHandle{};
+  for (ShaderHandle *shader : {&vert_, &primitiveVert_, &frag_}) {
+    if (nuri::isValid(*shader)) {
+      gpu_.destroyShaderModule(*shader);
+      *shader = ShaderHandle{};
+    }
   }
 
   auto vertResult = gpu_.createShaderModule(ShaderDesc{
@@ -243,6 +364,16 @@ Result<bool, std::string> DebugDraw3D::ensureShaderModules() {
     return Result<bool, std::string>::makeError(vertResult.error());
   }
 
+  auto primitiveVertResult = gpu_.createShaderModule(ShaderDesc{
+      .moduleName = "debug_draw_3d_primitive_vs",
+      .source = kDebugDraw3DPrimitiveVS,
+      .stage = ShaderStage::Vertex,
+  });
+  if (primitiveVertResult.hasError()) {
+    gpu_.destroyShaderModule(vertResult.value());
+    return Result<bool, std::string>::makeError(primitiveVertResult.error());
+  }
+
   auto fragResult = gpu_.createShaderModule(ShaderDesc{
       .moduleName = "debug_draw_3d_fs",
       .source = kDebugDraw3DFS,
@@ -250,17 +381,20 @@ Result<bool, std::string> DebugDraw3D::ensureShaderModules() {
   });
   if (fragResult.hasError()) {
     gpu_.destroyShaderModule(vertResult.value());
+    gpu_.destroyShaderModule(primitiveVertResult.value());
     return Result<bool, std::string>::makeError(fragResult.error());
   }
 
   vert_ = vertResult.value();
+  primitiveVert_ = primitiveVertResult.value();
   frag_ = fragResult.value();
   return Result<bool, std::string>::makeResult(true);
 }
 
 Result<bool, std::string> DebugDraw3D::ensurePipeline(Format colorFormat,
                                                       Format depthFormat) {
-  if (nuri::isValid(pipeline_) && pipelineColorFormat_ == colorFormat &&
+  if (nuri::isValid(pipeline_) && nuri::isValid(primitivePipeline_) &&
+      pipelineColorFormat_ == colorFormat &&
       pipelineDepthFormat_ == depthFormat) {
     return Result<bool, std::string>::makeResult(true);
   }
@@ -270,9 +404,11 @@ Result<bool, std::string> DebugDraw3D::ensurePipeline(Format colorFormat,
     return shaderResult;
   }
 
-  if (nuri::isValid(pipeline_)) {
-    gpu_.destroyRenderPipeline(pipeline_);
-    pipeline_ = RenderPipelineHandle{};
+  for (RenderPipelineHandle *pipeline : {&pipeline_, &primitivePipeline_}) {
+    if (nuri::isValid(*pipeline)) {
+      gpu_.destroyRenderPipeline(*pipeline);
+      *pipeline = RenderPipelineHandle{};
+    }
   }
 
   RenderPipelineDesc pipelineDesc{
@@ -293,7 +429,17 @@ Result<bool, std::string> DebugDraw3D::ensurePipeline(Format colorFormat,
     return Result<bool, std::string>::makeError(pipelineResult.error());
   }
 
+  pipelineDesc.vertexShader = primitiveVert_;
+  auto primitivePipelineResult = gpu_.createRenderPipeline(
+      pipelineDesc, "DebugDraw3D Primitive Pipeline");
+  if (primitivePipelineResult.hasError()) {
+    gpu_.destroyRenderPipeline(pipelineResult.value());
+    return Result<bool, std::string>::makeError(
+        primitivePipelineResult.error());
+  }
+
   pipeline_ = pipelineResult.value();
+  primitivePipeline_ = primitivePipelineResult.value();
   pipelineColorFormat_ = colorFormat;
   pipelineDepthFormat_ = depthFormat;
   return Result<bool, std::string>::makeResult(true);
@@ -306,8 +452,11 @@ void DebugDraw3D::syncFrameBufferCount(uint32_t swapchainImageCount) {
   }
 
   for (const FrameBufferState &frame : frameBuffers_) {
-    if (nuri::isValid(frame.buffer)) {
-      gpu_.destroyBuffer(frame.buffer);
+    if (nuri::isValid(frame.lines.buffer)) {
+      gpu_.destroyBuffer(frame.lines.buffer);
+    }
+    if (nuri::isValid(frame.primitives.buffer)) {
+      gpu_.destroyBuffer(frame.primitives.buffer);
     }
   }
 
@@ -315,25 +464,18 @@ void DebugDraw3D::syncFrameBufferCount(uint32_t swapchainImageCount) {
 }
 
 Result<bool, std::string>
-DebugDraw3D::ensureLineBufferCapacity(uint64_t frameIndex,
-                                      size_t requiredSize) {
-  if (frameIndex >= frameBuffers_.size()) {
-    return Result<bool, std::string>::makeError(
-        "DebugDraw3D: frame index out of range");
-  }
-
-  FrameBufferState &frame = frameBuffers_[static_cast<size_t>(frameIndex)];
-  if (nuri::isValid(frame.buffer) && frame.capacityBytes >= requiredSize) {
+DebugDraw3D::ensureBufferCapacity(GpuBufferState &state, size_t requiredSize) {
+  if (nuri::isValid(state.buffer) && state.capacityBytes >= requiredSize) {
     return Result<bool, std::string>::makeResult(true);
   }
 
-  if (nuri::isValid(frame.buffer)) {
-    gpu_.destroyBuffer(frame.buffer);
-    frame.buffer = BufferHandle{};
+  if (nuri::isValid(state.buffer)) {
+    gpu_.destroyBuffer(state.buffer);
+    state.buffer = BufferHandle{};
   }
 
   const size_t newSize =
-      std::max({requiredSize, frame.capacityBytes * 2, size_t{1}});
+      std::max({requiredSize, state.capacityBytes * 2, size_t{1}});
   auto bufferResult = gpu_.createBuffer(
       BufferDesc{
           .usage = BufferUsage::Storage,
@@ -345,8 +487,33 @@ DebugDraw3D::ensureLineBufferCapacity(uint64_t frameIndex,
     return Result<bool, std::string>::makeError(bufferResult.error());
   }
 
-  frame.buffer = bufferResult.value();
-  frame.capacityBytes = newSize;
+  state.buffer = bufferResult.value();
+  state.capacityBytes = newSize;
+  return Result<bool, std::string>::makeResult(true);
+}
+
+Result<bool, std::string>
+DebugDraw3D::uploadPrimitives(GpuBufferState &state, size_t primitiveCount) {
+  auto capacityResult =
+      ensureBufferCapacity(state, primitiveCount * sizeof(PrimitiveData));
+  if (capacityResult.hasError()) {
+    return capacityResult;
+  }
+
+  size_t offsetBytes = 0;
+  for (const std::pmr::vector<PrimitiveData> &primitives : primitives_) {
+    if (primitives.empty()) {
+      continue;
+    }
+    const std::span<const std::byte> bytes{
+        reinterpret_cast<const std::byte *>(primitives.data()),
+        primitives.size() * sizeof(PrimitiveData)};
+    auto updateResult = gpu_.updateBuffer(state.buffer, bytes, offsetBytes);
+    if (updateResult.hasError()) {
+      return Result<bool, std::string>::makeError(updateResult.error());
+    }
+    offsetBytes += bytes.size();
+  }
   return Result<bool, std::string>::makeResult(true);
 }
 
@@ -369,12 +536,18 @@ DebugDraw3D::buildGraphPass(uint64_t frameIndexValue,
     pass.desc.depth.clearStencil = 0;
   }
 
-  if (lines_.empty()) {
+  size_t primitiveCount = 0;
+  for (const std::pmr::vector<PrimitiveData> &primitives : primitives_) {
+    primitiveCount += primitives.size();
+  }
+
+  if (lines_.empty() && primitiveCount == 0) {
     pass.desc.draws = {};
     return Result<PreparedGraphPass, std::string>::makeResult(pass);
   }
 
-  if (lines_.size() > std::numeric_limits<uint32_t>::max()) {
+  if (lines_.size() > std::numeric_limits<uint32_t>::max() ||
+      primitiveCount > std::numeric_limits<uint32_t>::max()) {
     return Result<PreparedGraphPass, std::string>::makeError(
         "DebugDraw3D: vertex count exceeds uint32_t range");
   }
@@ -384,23 +557,37 @@ DebugDraw3D::buildGraphPass(uint64_t frameIndexValue,
   const uint64_t imageCount = static_cast<uint64_t>(frameBuffers_.size());
   // Use the renderer's logical frame index here as well to avoid forcing a
   // swapchain acquire while only preparing upload buffers.
-  const uint64_t frameIndex = frameIndexValue % imageCount;
-  const size_t frameSlot = static_cast<size_t>(frameIndex);
-  const size_t requiredBytes = lines_.size() * sizeof(LineData);
+  const size_t frameSlot = static_cast<size_t>(frameIndexValue % imageCount);
+  FrameBufferState &frame = frameBuffers_[frameSlot];
+
+  if (!lines_.empty()) {
+    const size_t requiredBytes = lines_.size() * sizeof(LineData);
+    auto lineBufferResult = ensureBufferCapacity(frame.lines, requiredBytes);
+    if (lineBufferResult.hasError()) {
+      return Result<PreparedGraphPass, std::string>::makeError(
+          lineBufferResult.error());
+    }
 
-  auto lineBufferResult = ensureLineBufferCapacity(frameIndex, requiredBytes);
-  if (lineBufferResult.hasError()) {
-    return Result<PreparedGraphPass, std::string>::makeError(
-        lineBufferResult.error());
+    const std::span<const std::byte> lineBytes{
+        reinterpret_cast<const std::byte *>(lines_.data()), requiredBytes};
+    auto updateResult = gpu_.updateBuffer(frame.lines.buffer, lineBytes, 0);
+    if (updateResult.hasError()) {
+      return Result<PreparedGraphPass, std::string>::makeError(
+          updateResult.error());
+    }
   }
 
-  const std::span<const std::byte> lineBytes{
-      reinterpret_cast<const std::byte *>(lines_.data()), requiredBytes};
-  auto updateResult =
-      gpu_.updateBuffer(frameBuffers_[frameSlot].buffer, lineBytes, 0);
-  if (updateResult.hasError()) {
-    return Result<PreparedGraphPass, std::string>::makeError(
-        updateResult.error());
+  if (primitiveCount > 0) {
+    auto unitMeshResult = ensureUnitMeshBuffer();
+    if (unitMeshResult.hasError()) {
+      return Result<PreparedGraphPass, std::string>::makeError(
+          unitMeshResult.error());
+    }
+    auto uploadResult = uploadPrimitives(frame.primitives, primitiveCount);
+    if (uploadResult.hasError()) {
+      return Result<PreparedGraphPass, std::string>::makeError(
+          uploadResult.error());
+    }
   }
 
   const Format depthFormat = nuri::isValid(depthTexture)
@@ -412,37 +599,79 @@ DebugDraw3D::buildGraphPass(uint64_t frameIndexValue,
         pipelineResult.error());
   }
 
-  const uint64_t address =
-      gpu_.getBufferDeviceAddress(frameBuffers_[frameSlot].buffer);
-  if (address == 0) {
-    return Result<PreparedGraphPass, std::string>::makeError(
-        "DebugDraw3D: invalid line buffer GPU address");
-  }
-
-  pushConstants_.mvp = mvp_;
-  pushConstants_.vertexBufferAddress = address;
-
-  drawItem_ = DrawItem{};
-  drawItem_.pipeline = pipeline_;
-  drawItem_.vertexCount = static_cast<uint32_t>(lines_.size());
-  drawItem_.instanceCount = 1;
-  drawItem_.pushConstants = std::span<const std::byte>(
-      reinterpret_cast<const std::byte *>(&pushConstants_),
-      sizeof(pushConstants_));
-  drawItem_.debugLabel = "DebugDraw3D Draw";
-  drawItem_.debugColor = 0xffffcc00u;
-  dependencyBuffer_ = frameBuffers_[frameSlot].buffer;
+  DrawItem baseDraw{};
+  baseDraw.debugColor = 0xffffcc00u;
   if (nuri::isValid(depthTexture)) {
-    drawItem_.useDepthState = true;
-    drawItem_.depthState = {
+    baseDraw.useDepthState = true;
+    baseDraw.depthState = {
         .compareOp = CompareOp::LessEqual,
         .isDepthWriteEnabled = false,
     };
   }
 
-  pass.desc.draws = std::span<const DrawItem>(&drawItem_, 1u);
+  size_t drawCount = 0;
+  size_t dependencyCount = 0;
+  if (!lines_.empty()) {
+    const uint64_t address = gpu_.getBufferDeviceAddress(frame.lines.buffer);
+    if (address == 0) {
+      return Result<PreparedGraphPass, std::string>::makeError(
+          "DebugDraw3D: invalid line buffer GPU address");
+    }
+    linePushConstants_.mvp = mvp_;
+    linePushConstants_.vertexBufferAddress = address;
+
+    DrawItem &draw = drawItems_[drawCount++];
+    draw = baseDraw;
+    draw.pipeline = pipeline_;
+    draw.vertexCount = static_cast<uint32_t>(lines_.size());
+    draw.instanceCount = 1;
+    draw.pushConstants = std::span<const std::byte>(
+        reinterpret_cast<const std::byte *>(&linePushConstants_),
+        sizeof(linePushConstants_));
+    draw.debugLabel = "DebugDraw3D Draw";
+    dependencyBuffers_[dependencyCount++] = frame.lines.buffer;
+  }
+
+  if (primitiveCount > 0) {
+    const uint64_t unitMeshAddress =
+        gpu_.getBufferDeviceAddress(unitMeshBuffer_);
+    const uint64_t primitiveAddress =
+        gpu_.getBufferDeviceAddress(frame.primitives.buffer);
+    if (unitMeshAddress == 0 || primitiveAddress == 0) {
+      return Result<PreparedGraphPass, std::string>::makeError(
+          "DebugDraw3D: invalid primitive buffer GPU address");
+    }
+    primitivePushConstants_.mvp = mvp_;
+    primitivePushConstants_.vertexBufferAddress = unitMeshAddress;
+    primitivePushConstants_.primitiveBufferAddress = primitiveAddress;
+
+    // Types are packed back to back, so each slice starts at firstInstance.
+    uint32_t firstInstance = 0;
+    for (size_t type = 0; type < kPrimitiveTypeCount; ++type) {
+      const uint32_t count = static_cast<uint32_t>(primitives_[type].size());
+      if (count == 0) {
+        continue;
+      }
+      DrawItem &draw = drawItems_[drawCount++];
+      draw = baseDraw;
+      draw.pipeline = primitivePipeline_;
+      draw.vertexCount = unitMeshVertexCount_[type];
+      draw.firstVertex = unitMeshFirstVertex_[type];
+      draw.instanceCount = count;
+      draw.firstInstance = firstInstance;
+      draw.pushConstants = std::span<const std::byte>(
+          reinterpret_cast<const std::byte *>(&primitivePushConstants_),
+          sizeof(primitivePushConstants_));
+      draw.debugLabel = "DebugDraw3D Primitive Draw";
+      firstInstance += count;
+    }
+    dependencyBuffers_[dependencyCount++] = unitMeshBuffer_;
+    dependencyBuffers_[dependencyCount++] = frame.primitives.buffer;
+  }
+
+  pass.desc.draws = std::span<const DrawItem>(drawItems_.data(), drawCount);
   pass.desc.dependencyBuffers =
-      std::span<const BufferHandle>(&dependencyBuffer_, 1u);
+      std::span<const BufferHandle>(dependencyBuffers_.data(), dependencyCount);
   return Result<PreparedGraphPass, std::string>::makeResult(pass);
 }
 
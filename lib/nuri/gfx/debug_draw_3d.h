@@ -10,12 +10,18 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
 #include <cstdint>
 #include <memory_resource>
 #include <string>
 
 namespace nuri {
 
+// Unit shapes expanded in the vertex shader: Box spans [-1, 1]^3, Sphere is
+// three unit great circles, Frustum is the NDC cube outline (its transform is
+// the inverse view-projection) and Axis is three unit lines tinted X/Y/Z.
+enum class DebugPrimitive : uint8_t { Box, Sphere, Frustum, Axis, Count };
+
 class NURI_API DebugDraw3D {
 public:
   explicit DebugDraw3D(GPUDevice &gpu,
@@ -34,13 +40,17 @@ public:
   DebugDraw3D(DebugDraw3D &&) = delete;
   DebugDraw3D &operator=(DebugDraw3D &&) = delete;
 
-  void clear() { lines_.clear(); }
+  void clear();
   void line(const glm::vec3 &p1, const glm::vec3 &p2, const glm::vec4 &c);
+  void primitive(DebugPrimitive type, const glm::mat4 &transform,
+                 const glm::vec4 &color);
   void plane(const glm::vec3 &orig, const glm::vec3 &v1, const glm::vec3 &v2,
              int n1, int n2, float s1, float s2, const glm::vec4 &color,
              const glm::vec4 &outlineColor);
   void box(const glm::mat4 &m, const BoundingBox &box, const glm::vec4 &color);
   void box(const glm::mat4 &m, const glm::vec3 &size, const glm::vec4 &color);
+  void sphere(const glm::vec3 &center, float radius, const glm::vec4 &color);
+  void axes(const glm::mat4 &m, float length);
   void frustum(const glm::mat4 &camView, const glm::mat4 &camProj,
                const glm::vec4 &color);
 
@@ -54,36 +64,63 @@ private:
     glm::vec4 color;
   };
 
-  struct FrameBufferState {
+  struct PrimitiveData {
+    glm::mat4 transform{1.0f};
+    glm::vec4 color{1.0f};
+  };
+
+  struct GpuBufferState {
     BufferHandle buffer{};
     size_t capacityBytes = 0;
   };
 
+  struct FrameBufferState {
+    GpuBufferState lines{};
+    GpuBufferState primitives{};
+  };
+
   struct PushConstants {
     glm::mat4 mvp{1.0f};
     uint64_t vertexBufferAddress = 0;
+    uint64_t primitiveBufferAddress = 0;
   };
 
+  static constexpr size_t kPrimitiveTypeCount =
+      static_cast<size_t>(DebugPrimitive::Count);
+  static constexpr size_t kMaxDraws = kPrimitiveTypeCount + 1u;
+
   [[nodiscard]] Result<bool, std::string> ensureShaderModules();
   [[nodiscard]] Result<bool, std::string> ensurePipeline(Format colorFormat,
                                                          Format depthFormat);
+  [[nodiscard]] Result<bool, std::string> ensureUnitMeshBuffer();
   void syncFrameBufferCount(uint32_t swapchainImageCount);
   [[nodiscard]] Result<bool, std::string>
-  ensureLineBufferCapacity(uint64_t frameIndex, size_t requiredSize);
+  ensureBufferCapacity(GpuBufferState &state, size_t requiredSize);
+  [[nodiscard]] Result<bool, std::string>
+  uploadPrimitives(GpuBufferState &state, size_t primitiveCount);
 
   GPUDevice &gpu_;
   glm::mat4 mvp_ = glm::mat4(1.0f);
   std::pmr::vector<LineData> lines_;
+  // One list per primitive type so each type is a single instanced draw.
+  std::array<std::pmr::vector<PrimitiveData>, kPrimitiveTypeCount>
+      primitives_;
   std::pmr::vector<FrameBufferState> frameBuffers_;
+  BufferHandle unitMeshBuffer_{};
+  std::array<uint32_t, kPrimitiveTypeCount> unitMeshFirstVertex_{};
+  std::array<uint32_t, kPrimitiveTypeCount> unitMeshVertexCount_{};
   ShaderHandle vert_{};
+  ShaderHandle primitiveVert_{};
   ShaderHandle frag_{};
   RenderPipelineHandle pipeline_{};
+  RenderPipelineHandle primitivePipeline_{};
   Format pipelineColorFormat_ = Format::Count;
   Format pipelineDepthFormat_ = Format::Count;
 
-  PushConstants pushConstants_{};
-  DrawItem drawItem_{};
-  BufferHandle dependencyBuffer_{};
+  PushConstants linePushConstants_{};
+  PushConstants primitivePushConstants_{};
+  std::array<DrawItem, kMaxDraws> drawItems_{};
+  std::array<BufferHandle, 3> dependencyBuffers_{};
 };
 
 } // namespace nuri
@@ -0,0 +1,380 @@
+#include "nuri/pch.h"
+
+#include "nuri/gfx/draw_stream.h"
+
+#include "nuri/core/log.h"
+
+namespace nuri {
+namespace {
+
+constexpr uint32_t kDrawStreamOpMask = 0xffu;
+constexpr uint32_t kDrawStreamPayloadShift = 16u;
+
+[[nodiscard]] constexpr size_t alignRecordSize(size_t size) {
+  return (size + (kDrawStreamRecordAlignment - 1u)) &
+         ~(kDrawStreamRecordAlignment - 1u);
+}
+
+[[nodiscard]] constexpr size_t expectedPayloadSize(DrawStreamOp op) {
+  switch (op) {
+  case DrawStreamOp::BindPipeline:
+    return sizeof(RenderPipelineHandle);
+  case DrawStreamOp::BindVertexBuffer:
+    return sizeof(DrawStreamBindVertexBuffer);
+  case DrawStreamOp::BindIndexBuffer:
+    return sizeof(DrawStreamBindIndexBuffer);
+  case DrawStreamOp::SetDepthState:
+    return sizeof(DepthState);
+  case DrawStreamOp::SetDepthBias:
+    return sizeof(DrawStreamSetDepthBias);
+  case DrawStreamOp::SetScissor:
+    return sizeof(DrawStreamSetScissor);
+  case DrawStreamOp::Draw:
+    return sizeof(DrawStreamDraw);
+  case DrawStreamOp::DrawIndexed:
+    return sizeof(DrawStreamDrawIndexed);
+  case DrawStreamOp::DrawIndexedIndirect:
+    return sizeof(DrawStreamDrawIndexedIndirect);
+  case DrawStreamOp::DrawIndexedIndirectCount:
+    return sizeof(DrawStreamDrawIndexedIndirectCount);
+  case DrawStreamOp::PushConstants:
+  case DrawStreamOp::Count:
+  default:
+    return 0u;
+  }
+}
+
+[[nodiscard]] bool sameHandle(RenderPipelineHandle lhs,
+                              RenderPipelineHandle rhs) {
+  return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+[[nodiscard]] bool sameHandle(BufferHandle lhs, BufferHandle rhs) {
+  return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+} // namespace
+
+DrawStreamWriter::DrawStreamWriter(std::pmr::memory_resource *memory)
+    : bytes_(memory), lastPushConstants_(memory) {}
+
+void DrawStreamWriter::reset() {
+  bytes_.clear();
+  lastPushConstants_.clear();
+  drawCount_ = 0;
+  hasPipeline_ = false;
+  hasVertexBuffer_ = false;
+  hasIndexBuffer_ = false;
+  hasDepthState_ = false;
+  hasDepthBias_ = false;
+  hasScissor_ = false;
+  hasPushConstants_ = false;
+}
+
+size_t DrawStreamWriter::emit(DrawStreamOp op, const void *payload,
+                              size_t payloadSize) {
+  NURI_ASSERT(payloadSize <= kMaxDrawStreamPayloadSize,
+              "DrawStreamWriter::emit: payload exceeds record limit");
+  const uint32_t header =
+      static_cast<uint32_t>(op) |
+      (static_cast<uint32_t>(payloadSize) << kDrawStreamPayloadShift);
+  const size_t recordOffset = bytes_.size();
+  bytes_.resize(recordOffset +
+                alignRecordSize(kDrawStreamHeaderSize + payloadSize));
+  std::memcpy(bytes_.data() + recordOffset, &header, sizeof(header));
+  if (payloadSize > 0u) {
+    std::memcpy(bytes_.data() + recordOffset + kDrawStreamHeaderSize, payload,
+                payloadSize);
+  }
+  return recordOffset + kDrawStreamHeaderSize;
+}
+
+void DrawStreamWriter::bindPipeline(RenderPipelineHandle pipeline) {
+  if (hasPipeline_ && sameHandle(pipeline_, pipeline)) {
+    return;
+  }
+  hasPipeline_ = true;
+  pipeline_ = pipeline;
+  emit(DrawStreamOp::BindPipeline, pipeline);
+}
+
+void DrawStreamWriter::bindVertexBuffer(BufferHandle buffer, uint64_t offset) {
+  if (hasVertexBuffer_ && sameHandle(vertexBuffer_.buffer, buffer) &&
+      vertexBuffer_.offset == offset) {
+    return;
+  }
+  hasVertexBuffer_ = true;
+  vertexBuffer_ = {.buffer = buffer, .offset = offset};
+  emit(DrawStreamOp::BindVertexBuffer, vertexBuffer_);
+}
+
+void DrawStreamWriter::bindIndexBuffer(BufferHandle buffer, uint64_t offset,
+                                       IndexFormat format) {
+  if (hasIndexBuffer_ && sameHandle(indexBuffer_.buffer, buffer) &&
+      indexBuffer_.offset == offset && indexBuffer_.format == format) {
+    return;
+  }
+  hasIndexBuffer_ = true;
+  indexBuffer_ = {.buffer = buffer, .offset = offset, .format = format};
+  emit(DrawStreamOp::BindIndexBuffer, indexBuffer_);
+}
+
+void DrawStreamWriter::setDepthState(const DepthState &state) {
+  if (hasDepthState_ && depthState_.compareOp == state.compareOp &&
+      depthState_.isDepthWriteEnabled == state.isDepthWriteEnabled) {
+    return;
+  }
+  hasDepthState_ = true;
+  depthState_ = state;
+  emit(DrawStreamOp::SetDepthState, depthState_);
+}
+
+void DrawStreamWriter::setDepthBias(bool enable, float constant, float slope,
+                                    float clamp) {
+  DrawStreamSetDepthBias bias{};
+  bias.enable = enable ? 1u : 0u;
+  if (enable) {
+    bias.constant = constant;
+    bias.slope = slope;
+    bias.clamp = clamp;
+  }
+  if (hasDepthBias_ && depthBias_.enable == bias.enable &&
+      depthBias_.constant == bias.constant && depthBias_.slope == bias.slope &&
+      depthBias_.clamp == bias.clamp) {
+    return;
+  }
+  hasDepthBias_ = true;
+  depthBias_ = bias;
+  emit(DrawStreamOp::SetDepthBias, depthBias_);
+}
+
+void DrawStreamWriter::setScissor(bool enable, const RectU32 &rect) {
+  DrawStreamSetScissor scissor{};
+  scissor.enable = enable ? 1u : 0u;
+  if (enable) {
+    scissor.rect = rect;
+  }
+  if (hasScissor_ && scissor_.enable == scissor.enable &&
+      scissor_.rect.x == scissor.rect.x && scissor_.rect.y == scissor.rect.y &&
+      scissor_.rect.width == scissor.rect.width &&
+      scissor_.rect.height == scissor.rect.height) {
+    return;
+  }
+  hasScissor_ = true;
+  scissor_ = scissor;
+  emit(DrawStreamOp::SetScissor, scissor_);
+}
+
+void DrawStreamWriter::pushConstants(std::span<const std::byte> data) {
+  if (data.empty()) {
+    return;
+  }
+  if (hasPushConstants_ && lastPushConstants_.size() == data.size() &&
+      std::memcmp(lastPushConstants_.data(), data.data(), data.size()) == 0) {
+    return;
+  }
+  hasPushConstants_ = true;
+  lastPushConstants_.assign(data.begin(), data.end());
+  emit(DrawStreamOp::PushConstants, data.data(), data.size());
+}
+
+void DrawStreamWriter::draw(const DrawStreamDraw &draw) {
+  emit(DrawStreamOp::Draw, draw);
+  ++drawCount_;
+}
+
+void DrawStreamWriter::drawIndexed(const DrawStreamDrawIndexed &draw) {
+  emit(DrawStreamOp::DrawIndexed, draw);
+  ++drawCount_;
+}
+
+void DrawStreamWriter::drawIndexedIndirect(
+    const DrawStreamDrawIndexedIndirect &draw) {
+  emit(DrawStreamOp::DrawIndexedIndirect, draw);
+  ++drawCount_;
+}
+
+void DrawStreamWriter::drawIndexedIndirectCount(
+    const DrawStreamDrawIndexedIndirectCount &draw) {
+  emit(DrawStreamOp::DrawIndexedIndirectCount, draw);
+  ++drawCount_;
+}
+
+void DrawStreamWriter::appendDrawItem(const DrawItem &item) {
+  (void)appendDrawItemInternal(item, false);
+}
+
+DrawStreamPatchOffsets
+DrawStreamWriter::appendPatchableDrawItem(const DrawItem &item) {
+  return appendDrawItemInternal(item, true);
+}
+
+void DrawStreamWriter::patch(size_t offset, std::span<const std::byte> data) {
+  NURI_ASSERT(offset <= bytes_.size() && data.size() <= bytes_.size() - offset,
+              "DrawStreamWriter::patch: range exceeds stream");
+  if (!data.empty()) {
+    std::memcpy(bytes_.data() + offset, data.data(), data.size());
+  }
+}
+
+DrawStreamPatchOffsets
+DrawStreamWriter::appendDrawItemInternal(const DrawItem &item,
+                                         bool patchable) {
+  DrawStreamPatchOffsets offsets{};
+  bindPipeline(item.pipeline);
+  if (nuri::isValid(item.vertexBuffer)) {
+    bindVertexBuffer(item.vertexBuffer, item.vertexBufferOffset);
+  }
+  const bool requiresIndexBuffer = item.command != DrawCommandType::Direct ||
+                                   item.indexCount > 0u;
+  if (requiresIndexBuffer) {
+    bindIndexBuffer(item.indexBuffer, item.indexBufferOffset,
+                    item.indexFormat);
+  }
+  if (item.useDepthState) {
+    setDepthState(item.depthState);
+  }
+  setDepthBias(item.depthBiasEnable, item.depthBiasConstant,
+               item.depthBiasSlope, item.depthBiasClamp);
+  setScissor(item.useScissor, item.scissor);
+  if (patchable && !item.pushConstants.empty()) {
+    hasPushConstants_ = true;
+    lastPushConstants_.assign(item.pushConstants.begin(),
+                              item.pushConstants.end());
+    offsets.pushConstants =
+        emit(DrawStreamOp::PushConstants, item.pushConstants.data(),
+             item.pushConstants.size());
+  } else {
+    pushConstants(item.pushConstants);
+  }
+
+  // Draw records are never elided, so the next record is the draw itself.
+  offsets.draw = bytes_.size() + kDrawStreamHeaderSize;
+  switch (item.command) {
+  case DrawCommandType::IndexedIndirect:
+    drawIndexedIndirect({.buffer = item.indirectBuffer,
+                         .offset = item.indirectBufferOffset,
+                         .drawCount = item.indirectDrawCount,
+                         .stride = item.indirectStride});
+    return offsets;
+  case DrawCommandType::IndexedIndirectCount:
+    drawIndexedIndirectCount({.buffer = item.indirectBuffer,
+                              .offset = item.indirectBufferOffset,
+                              .countBuffer = item.indirectCountBuffer,
+                              .countOffset = item.indirectCountBufferOffset,
+                              .maxDrawCount = item.indirectDrawCount,
+                              .stride = item.indirectStride});
+    return offsets;
+  case DrawCommandType::Direct:
+  default:
+    break;
+  }
+
+  if (item.indexCount > 0u) {
+    drawIndexed({.indexCount = item.indexCount,
+                 .instanceCount = item.instanceCount,
+                 .firstIndex = item.firstIndex,
+                 .vertexOffset = item.vertexOffset,
+                 .firstInstance = item.firstInstance});
+  } else {
+    draw({.vertexCount = item.vertexCount,
+          .instanceCount = item.instanceCount,
+          .firstVertex = item.firstVertex,
+          .firstInstance = item.firstInstance});
+  }
+  return offsets;
+}
+
+Result<bool, std::string> DrawStreamReader::next(DrawStreamCommand &out) {
+  if (cursor_ == bytes_.size()) {
+    return Result<bool, std::string>::makeResult(false);
+  }
+  if (bytes_.size() - cursor_ < kDrawStreamHeaderSize) {
+    return Result<bool, std::string>::makeError(
+        "DrawStreamReader::next: truncated record header");
+  }
+
+  uint32_t header = 0;
+  std::memcpy(&header, bytes_.data() + cursor_, sizeof(header));
+  const uint32_t opValue = header & kDrawStreamOpMask;
+  const size_t payloadSize = header >> kDrawStreamPayloadShift;
+  if (opValue >= static_cast<uint32_t>(DrawStreamOp::Count)) {
+    return Result<bool, std::string>::makeError(
+        "DrawStreamReader::next: unknown record op");
+  }
+  const DrawStreamOp op = static_cast<DrawStreamOp>(opValue);
+  if (op == DrawStreamOp::PushConstants) {
+    if (payloadSize == 0u) {
+      return Result<bool, std::string>::makeError(
+          "DrawStreamReader::next: push-constant record is empty");
+    }
+  } else if (payloadSize != expectedPayloadSize(op)) {
+    return Result<bool, std::string>::makeError(
+        "DrawStreamReader::next: record payload size does not match op");
+  }
+
+  const size_t recordSize =
+      alignRecordSize(kDrawStreamHeaderSize + payloadSize);
+  if (bytes_.size() - cursor_ < recordSize) {
+    return Result<bool, std::string>::makeError(
+        "DrawStreamReader::next: truncated record payload");
+  }
+
+  out.op = op;
+  out.payload = bytes_.subspan(cursor_ + kDrawStreamHeaderSize, payloadSize);
+  cursor_ += recordSize;
+
+  if (op == DrawStreamOp::BindIndexBuffer &&
+      out.as<DrawStreamBindIndexBuffer>().format >= IndexFormat::Count) {
+    return Result<bool, std::string>::makeError(
+        "DrawStreamReader::next: index format is invalid");
+  }
+  if (op == DrawStreamOp::SetDepthState &&
+      out.as<DepthState>().compareOp >= CompareOp::Count) {
+    return Result<bool, std::string>::makeError(
+        "DrawStreamReader::next: depth compare op is invalid");
+  }
+  return Result<bool, std::string>::makeResult(true);
+}
+
+Result<uint32_t, std::string>
+validateDrawStream(std::span<const std::byte> bytes) {
+  DrawStreamReader reader(bytes);
+  DrawStreamCommand command{};
+  uint32_t drawCount = 0;
+  bool pipelineBound = false;
+  bool indexBufferBound = false;
+  while (true) {
+    auto nextResult = reader.next(command);
+    if (nextResult.hasError()) {
+      return Result<uint32_t, std::string>::makeError(nextResult.error());
+    }
+    if (!nextResult.value()) {
+      break;
+    }
+    if (command.op == DrawStreamOp::BindPipeline) {
+      pipelineBound = true;
+    } else if (command.op == DrawStreamOp::BindIndexBuffer) {
+      indexBufferBound = true;
+    }
+    if (isDrawStreamDrawOp(command.op)) {
+      if (!pipelineBound) {
+        return Result<uint32_t, std::string>::makeError(
+            "validateDrawStream: draw record precedes any BindPipeline");
+      }
+      if (command.op != DrawStreamOp::Draw && !indexBufferBound) {
+        return Result<uint32_t, std::string>::makeError(
+            "validateDrawStream: indexed draw record precedes any "
+            "BindIndexBuffer");
+      }
+      if (drawCount == UINT32_MAX) {
+        return Result<uint32_t, std::string>::makeError(
+            "validateDrawStream: draw count exceeds uint32_t");
+      }
+      ++drawCount;
+    }
+  }
+  return Result<uint32_t, std::string>::makeResult(drawCount);
+}
+
+} // namespace nuri
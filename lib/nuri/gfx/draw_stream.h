@@ -0,0 +1,214 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/gfx/gpu_render_types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nuri {
+
+// Packed draw encoding: state records are only emitted when the bound state
+// changes, so a run of draws sharing a pipeline and geometry costs one small
+// draw record each instead of a full DrawItem.
+enum class DrawStreamOp : uint8_t {
+  BindPipeline,
+  BindVertexBuffer,
+  BindIndexBuffer,
+  SetDepthState,
+  SetDepthBias,
+  SetScissor,
+  PushConstants,
+  Draw,
+  DrawIndexed,
+  DrawIndexedIndirect,
+  DrawIndexedIndirectCount,
+  Count
+};
+
+// Every record starts with a 4-byte header (op in the low byte, payload size
+// in the high 16 bits) and is padded to 4 bytes.
+constexpr size_t kDrawStreamRecordAlignment = 4;
+constexpr size_t kDrawStreamHeaderSize = sizeof(uint32_t);
+constexpr size_t kMaxDrawStreamPayloadSize = UINT16_MAX;
+
+struct DrawStreamBindVertexBuffer {
+  BufferHandle buffer{};
+  uint64_t offset = 0;
+};
+
+struct DrawStreamBindIndexBuffer {
+  BufferHandle buffer{};
+  uint64_t offset = 0;
+  IndexFormat format = IndexFormat::U32;
+  std::array<uint8_t, 7> reserved{};
+};
+static_assert(sizeof(DrawStreamBindIndexBuffer) == 24);
+
+struct DrawStreamSetDepthBias {
+  uint32_t enable = 0;
+  float constant = 0.0f;
+  float slope = 0.0f;
+  float clamp = 0.0f;
+};
+
+// enable == 0 restores the pass viewport scissor.
+struct DrawStreamSetScissor {
+  uint32_t enable = 0;
+  RectU32 rect{};
+};
+
+struct DrawStreamDraw {
+  uint32_t vertexCount = 0;
+  uint32_t instanceCount = 1;
+  uint32_t firstVertex = 0;
+  uint32_t firstInstance = 0;
+};
+
+struct DrawStreamDrawIndexed {
+  uint32_t indexCount = 0;
+  uint32_t instanceCount = 1;
+  uint32_t firstIndex = 0;
+  int32_t vertexOffset = 0;
+  uint32_t firstInstance = 0;
+};
+
+struct DrawStreamDrawIndexedIndirect {
+  BufferHandle buffer{};
+  uint64_t offset = 0;
+  uint32_t drawCount = 0;
+  uint32_t stride = 0;
+};
+
+struct DrawStreamDrawIndexedIndirectCount {
+  BufferHandle buffer{};
+  uint64_t offset = 0;
+  BufferHandle countBuffer{};
+  uint64_t countOffset = 0;
+  uint32_t maxDrawCount = 0;
+  uint32_t stride = 0;
+};
+
+// Payload offsets into DrawStreamWriter::bytes() for records a cached stream
+// rewrites in place.
+struct DrawStreamPatchOffsets {
+  static constexpr size_t kNone = SIZE_MAX;
+  size_t pushConstants = kNone;
+  size_t draw = kNone;
+};
+
+struct DrawStreamCommand {
+  DrawStreamOp op = DrawStreamOp::Count;
+  std::span<const std::byte> payload{};
+
+  template <typename T> [[nodiscard]] T as() const noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    std::memcpy(&value, payload.data(),
+                payload.size() < sizeof(T) ? payload.size() : sizeof(T));
+    return value;
+  }
+};
+
+class NURI_API DrawStreamWriter {
+public:
+  explicit DrawStreamWriter(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+  void reset();
+
+  void bindPipeline(RenderPipelineHandle pipeline);
+  void bindVertexBuffer(BufferHandle buffer, uint64_t offset);
+  void bindIndexBuffer(BufferHandle buffer, uint64_t offset,
+                       IndexFormat format);
+  void setDepthState(const DepthState &state);
+  void setDepthBias(bool enable, float constant, float slope, float clamp);
+  void setScissor(bool enable, const RectU32 &rect = {});
+  void pushConstants(std::span<const std::byte> data);
+
+  void draw(const DrawStreamDraw &draw);
+  void drawIndexed(const DrawStreamDrawIndexed &draw);
+  void drawIndexedIndirect(const DrawStreamDrawIndexedIndirect &draw);
+  void
+  drawIndexedIndirectCount(const DrawStreamDrawIndexedIndirectCount &draw);
+
+  // Translates a legacy DrawItem into the state deltas it implies. Debug
+  // labels are not carried by the stream.
+  void appendDrawItem(const DrawItem &item);
+  // Same as appendDrawItem, but the push-constant record is always written so
+  // its bytes can be refreshed later with `patch`.
+  DrawStreamPatchOffsets appendPatchableDrawItem(const DrawItem &item);
+  // Overwrites payload bytes of an already written record. The delta state
+  // used to elide records is not updated, so only patch finished streams.
+  void patch(size_t offset, std::span<const std::byte> data);
+
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {bytes_.data(), bytes_.size()};
+  }
+  [[nodiscard]] uint32_t drawCount() const noexcept { return drawCount_; }
+  [[nodiscard]] bool empty() const noexcept { return bytes_.empty(); }
+
+private:
+  // Returns the offset of the record payload in bytes_.
+  size_t emit(DrawStreamOp op, const void *payload, size_t payloadSize);
+  template <typename T> size_t emit(DrawStreamOp op, const T &payload) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return emit(op, &payload, sizeof(T));
+  }
+  DrawStreamPatchOffsets appendDrawItemInternal(const DrawItem &item,
+                                                bool patchable);
+
+  std::pmr::vector<std::byte> bytes_;
+  std::pmr::vector<std::byte> lastPushConstants_;
+  uint32_t drawCount_ = 0;
+
+  bool hasPipeline_ = false;
+  RenderPipelineHandle pipeline_{};
+  bool hasVertexBuffer_ = false;
+  DrawStreamBindVertexBuffer vertexBuffer_{};
+  bool hasIndexBuffer_ = false;
+  DrawStreamBindIndexBuffer indexBuffer_{};
+  bool hasDepthState_ = false;
+  DepthState depthState_{};
+  bool hasDepthBias_ = false;
+  DrawStreamSetDepthBias depthBias_{};
+  bool hasScissor_ = false;
+  DrawStreamSetScissor scissor_{};
+  bool hasPushConstants_ = false;
+};
+
+// Sequential decoder. `next` yields false once the stream is exhausted and
+// reports malformed records as errors.
+class NURI_API DrawStreamReader {
+public:
+  explicit DrawStreamReader(std::span<const std::byte> bytes) noexcept
+      : bytes_(bytes) {}
+
+  [[nodiscard]] Result<bool, std::string> next(DrawStreamCommand &out);
+
+private:
+  std::span<const std::byte> bytes_;
+  size_t cursor_ = 0;
+};
+
+// Walks the whole stream once; returns the number of draw records. A stream
+// must be self-contained: every draw follows a BindPipeline, and indexed and
+// indirect draws also follow a BindIndexBuffer.
+[[nodiscard]] NURI_API Result<uint32_t, std::string>
+validateDrawStream(std::span<const std::byte> bytes);
+
+[[nodiscard]] constexpr bool isDrawStreamDrawOp(DrawStreamOp op) {
+  return op == DrawStreamOp::Draw || op == DrawStreamOp::DrawIndexed ||
+         op == DrawStreamOp::DrawIndexedIndirect ||
+         op == DrawStreamOp::DrawIndexedIndirectCount;
+}
+
+} // namespace nuri
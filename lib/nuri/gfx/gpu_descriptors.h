@@ -39,6 +39,9 @@ struct RenderPipelineDesc {
   ShaderHandle geometryShader{};
   ShaderHandle fragmentShader{};
   std::array<Format, 1> colorFormats{Format::RGBA8_UNORM};
+  // Formats for color attachments 1..N; Format::Count marks an unused slot.
+  std::array<Format, kMaxAdditionalColorAttachments> additionalColorFormats{
+      Format::Count, Format::Count, Format::Count};
   Format depthFormat = Format::Count;
   CullMode cullMode = CullMode::Back;
   PolygonMode polygonMode = PolygonMode::Fill;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <string_view>
 
@@ -22,6 +23,15 @@ struct TextureReadbackRegion {
   uint32_t layer = 0;
 };
 
+// Driver pipeline build that owns everything it reads, so compile() may run
+// on any thread. Jobs are created, finished and destroyed on the device
+// thread.
+class NURI_API PipelineCompileJob {
+public:
+  virtual ~PipelineCompileJob() = default;
+  [[nodiscard]] virtual Result<bool, std::string> compile() = 0;
+};
+
 class NURI_API GPUDevice {
 public:
   static std::unique_ptr<GPUDevice>
@@ -62,6 +72,22 @@ public:
   createComputePipeline(const ComputePipelineDesc &desc,
                         std::string_view debugName = {}) = 0;
 
+  // Background compiles are split so that only PipelineCompileJob::compile()
+  // leaves the device thread: prepare snapshots the pipeline into a job, and
+  // finish publishes its result so the first bind does not compile.
+  virtual bool supportsBackgroundPipelineCompilation() const { return false; }
+  virtual Result<std::unique_ptr<PipelineCompileJob>, std::string>
+  prepareRenderPipelineCompile(RenderPipelineHandle pipeline) {
+    (void)pipeline;
+    return Result<std::unique_ptr<PipelineCompileJob>, std::string>::makeError(
+        "GPUDevice::prepareRenderPipelineCompile: not supported");
+  }
+  virtual Result<bool, std::string>
+  finishRenderPipelineCompile(PipelineCompileJob &job) {
+    (void)job;
+    return Result<bool, std::string>::makeResult(true);
+  }
+
   virtual void destroyRenderPipeline(RenderPipelineHandle pipeline) = 0;
   virtual void destroyComputePipeline(ComputePipelineHandle pipeline) = 0;
   virtual void destroyBuffer(BufferHandle buffer) = 0;
@@ -118,6 +144,21 @@ public:
   allocateGeometry(std::span<const std::byte> vertexBytes, uint32_t vertexCount,
                    std::span<const std::byte> indexBytes, uint32_t indexCount,
                    std::string_view debugName = {}) = 0;
+  // When supported, allocateEncodedGeometry decodes the vertex stream on the
+  // GPU so only the compressed bytes cross the bus.
+  virtual bool supportsEncodedGeometry() const { return false; }
+  virtual Result<GeometryAllocationHandle, std::string>
+  allocateEncodedGeometry(const EncodedVertexStream &vertices,
+                          std::span<const std::byte> indexBytes,
+                          uint32_t indexCount,
+                          std::string_view debugName = {}) {
+    (void)vertices;
+    (void)indexBytes;
+    (void)indexCount;
+    (void)debugName;
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "GPUDevice::allocateEncodedGeometry: not supported");
+  }
   virtual void releaseGeometry(GeometryAllocationHandle h) = 0;
   virtual Result<bool, std::string>
   copyBufferRegions(std::span<const BufferCopyRegion> regions) = 0;
@@ -2,6 +2,7 @@
 
 #include "nuri/gfx/gpu_types.h"
 
+#include <array>
 #include <cstddef>
 #include <span>
 #include <string_view>
@@ -99,6 +100,39 @@ hasGraphicsBarrierAccessFlag(GraphicsBarrierAccessMode mode,
   return (static_cast<uint8_t>(mode) & static_cast<uint8_t>(flag)) != 0u;
 }
 
+// Pipeline stages a resource is used in on one side of a barrier. An empty
+// mask lets the backend fall back to conservative stages for the state.
+enum class GraphicsBarrierStage : uint16_t {
+  None = 0,
+  DrawIndirect = 1u << 0u,
+  IndexInput = 1u << 1u,
+  VertexInput = 1u << 2u,
+  VertexShader = 1u << 3u,
+  FragmentShader = 1u << 4u,
+  ComputeShader = 1u << 5u,
+  Transfer = 1u << 6u,
+  ColorAttachment = 1u << 7u,
+  DepthAttachment = 1u << 8u,
+};
+
+[[nodiscard]] constexpr GraphicsBarrierStage
+operator|(GraphicsBarrierStage lhs, GraphicsBarrierStage rhs) {
+  return static_cast<GraphicsBarrierStage>(static_cast<uint16_t>(lhs) |
+                                           static_cast<uint16_t>(rhs));
+}
+
+constexpr GraphicsBarrierStage &operator|=(GraphicsBarrierStage &lhs,
+                                           GraphicsBarrierStage rhs) {
+  lhs = lhs | rhs;
+  return lhs;
+}
+
+[[nodiscard]] constexpr bool
+hasGraphicsBarrierStageFlag(GraphicsBarrierStage stages,
+                            GraphicsBarrierStage flag) {
+  return (static_cast<uint16_t>(stages) & static_cast<uint16_t>(flag)) != 0u;
+}
+
 enum class GraphicsBarrierState : uint8_t {
   Unknown = 0,
   Read = 1,
@@ -122,6 +156,8 @@ struct GraphicsBarrierRecord {
   GraphicsBarrierAccessMode afterAccess = GraphicsBarrierAccessMode::None;
   GraphicsBarrierState beforeState = GraphicsBarrierState::Unknown;
   GraphicsBarrierState afterState = GraphicsBarrierState::Unknown;
+  GraphicsBarrierStage beforeStages = GraphicsBarrierStage::None;
+  GraphicsBarrierStage afterStages = GraphicsBarrierStage::None;
 
   [[nodiscard]] static constexpr GraphicsBarrierRecord ForTexture(
       TextureHandle textureHandle,
@@ -159,6 +195,15 @@ struct GraphicsBarrierRecord {
     return record;
   }
 
+  [[nodiscard]] constexpr GraphicsBarrierRecord
+  withStages(GraphicsBarrierStage before,
+             GraphicsBarrierStage after) const noexcept {
+    GraphicsBarrierRecord record = *this;
+    record.beforeStages = before;
+    record.afterStages = after;
+    return record;
+  }
+
   constexpr void setTextureHandle(TextureHandle textureHandle) noexcept {
     resourceKind = GraphicsBarrierResourceKind::Texture;
     resource.texture = textureHandle;
@@ -197,6 +242,10 @@ struct DrawItem {
   uint64_t indexBufferOffset = 0;
   BufferHandle indirectBuffer{};
   uint64_t indirectBufferOffset = 0;
+  // IndexedIndirectCount reads its draw count here on the GPU; a zero count
+  // skips the draw without a CPU round trip. Passes themselves are never
+  // predicated. Devices without draw-indirect-count issue all
+  // `indirectDrawCount` commands, so skipped commands need zero instances.
   BufferHandle indirectCountBuffer{};
   uint64_t indirectCountBufferOffset = 0;
   uint32_t indirectDrawCount = 0;
@@ -222,9 +271,19 @@ struct DrawItem {
   uint32_t debugColor = 0xffffffffu;
 };
 
+// Graphics passes open a dynamic-rendering scope; compute passes only record
+// `preDispatches` and transfer passes only record `copies`.
+enum class RenderPassKind : uint8_t { Graphics, Compute, Transfer };
+
 struct RenderPass {
+  RenderPassKind kind = RenderPassKind::Graphics;
   AttachmentColor color;
   TextureHandle colorTexture{};
+  std::array<AttachmentColor, kMaxAdditionalColorAttachments>
+      additionalColors{};
+  std::array<TextureHandle, kMaxAdditionalColorAttachments>
+      additionalColorTextures{};
+  uint32_t additionalColorCount = 0;
   AttachmentDepth depth;
   TextureHandle depthTexture{};
   bool useViewport = false;
@@ -232,6 +291,9 @@ struct RenderPass {
   std::span<const ComputeDispatchItem> preDispatches{};
   std::span<const BufferHandle> dependencyBuffers{};
   std::span<const DrawItem> draws{};
+  // Packed state-delta draws (see draw_stream.h), recorded after `draws`.
+  std::span<const std::byte> drawStream{};
+  std::span<const BufferCopyRegion> copies{};
   std::string_view debugLabel{};
   uint32_t debugColor = 0xffffffffu;
 };
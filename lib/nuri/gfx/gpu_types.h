@@ -75,6 +75,10 @@ static_assert(std::is_trivially_destructible_v<RecordedCommandBufferHandle>);
 static_assert(std::is_trivially_destructible_v<SubmissionHandle>);
 static_assert(std::is_trivially_destructible_v<GeometryAllocationHandle>);
 
+// Attachment 0 is the primary color target; the rest are extra MRT outputs.
+constexpr size_t kMaxColorAttachments = 4;
+constexpr size_t kMaxAdditionalColorAttachments = kMaxColorAttachments - 1;
+
 // GPU enums (LVK-free)
 enum class Format : uint8_t {
   R32_UINT,
@@ -258,6 +262,25 @@ struct GeometryPoolConfig {
   uint64_t compactionIntervalFrames = 300;
   float compactionFragmentationThreshold = 0.3f;
   bool enableCompaction = true;
+  // Allocations with identical vertex and index bytes share one reference
+  // counted entry instead of being uploaded again. A full key match is
+  // confirmed against a readback of the resident bytes before sharing.
+  bool enableContentDeduplication = true;
+  // Opt-in: cached meshes upload their compressed vertex stream and are
+  // decoded by a compute pass straight into the pool.
+  bool enableGpuVertexDecode = false;
+};
+
+// A meshopt v0 vertex stream together with the block layout produced by
+// meshBinaryPlanVertexDecode.
+struct EncodedVertexStream {
+  std::span<const std::byte> encodedBytes{};
+  std::span<const uint32_t> channelOffsets{};
+  uint32_t vertexCount = 0;
+  uint32_t vertexStrideBytes = 0;
+  uint32_t blockVertexCount = 0;
+  uint32_t blockCount = 0;
+  uint32_t tailOffset = 0;
 };
 
 struct GPUDeviceCreateDesc {
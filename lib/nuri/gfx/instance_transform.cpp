@@ -0,0 +1,187 @@
+#include "nuri/pch.h"
+
+#include "nuri/gfx/instance_transform.h"
+
+#include "nuri/core/log.h"
+
+namespace nuri {
+namespace {
+
+constexpr float kMinAxisScale = 1.0e-8f;
+constexpr float kProjectiveEpsilon = 1.0e-6f;
+// Cosine between normalized basis vectors above which a transform is treated
+// as sheared; roughly 0.06 degrees away from orthogonal.
+constexpr float kShearEpsilon = 1.0e-3f;
+
+uint16_t packSnorm16(float value) {
+  const float clamped = std::clamp(value, -1.0f, 1.0f);
+  const int32_t quantized =
+      static_cast<int32_t>(std::round(clamped * 32767.0f));
+  const int32_t clampedQuantized = std::clamp(quantized, -32767, 32767);
+  return static_cast<uint16_t>(static_cast<int16_t>(clampedQuantized));
+}
+
+uint32_t packSnorm2x16(float x, float y) {
+  return static_cast<uint32_t>(packSnorm16(x)) |
+         (static_cast<uint32_t>(packSnorm16(y)) << 16u);
+}
+
+glm::vec2 unpackSnorm2x16(uint32_t packed) {
+  const auto x = static_cast<int16_t>(packed & 0xffffu);
+  const auto y = static_cast<int16_t>(packed >> 16u);
+  return glm::clamp(glm::vec2(static_cast<float>(x), static_cast<float>(y)) /
+                        32767.0f,
+                    glm::vec2(-1.0f), glm::vec2(1.0f));
+}
+
+bool isAffine(const glm::mat4 &transform) {
+  return std::abs(transform[0][3]) <= kProjectiveEpsilon &&
+         std::abs(transform[1][3]) <= kProjectiveEpsilon &&
+         std::abs(transform[2][3]) <= kProjectiveEpsilon &&
+         std::abs(transform[3][3] - 1.0f) <= kProjectiveEpsilon;
+}
+
+bool isOrthogonal(const glm::mat3 &basis) {
+  return std::abs(glm::dot(basis[0], basis[1])) <= kShearEpsilon &&
+         std::abs(glm::dot(basis[0], basis[2])) <= kShearEpsilon &&
+         std::abs(glm::dot(basis[1], basis[2])) <= kShearEpsilon;
+}
+
+// Splits the linear part into unit basis vectors and column scales. The
+// basis is only a rotation when isOrthogonal() holds.
+bool splitBasisAndScale(const glm::mat4 &transform, glm::mat3 &basis,
+                        glm::vec3 &scale) {
+  for (int axis = 0; axis < 3; ++axis) {
+    const glm::vec3 column = glm::vec3(transform[axis]);
+    scale[axis] = glm::length(column);
+    if (!(scale[axis] > kMinAxisScale)) {
+      return false;
+    }
+    basis[axis] = column / scale[axis];
+  }
+  if (glm::determinant(basis) < 0.0f) {
+    scale.x = -scale.x;
+    basis[0] = -basis[0];
+  }
+  return true;
+}
+
+PackedInstanceTrs packTrs(const glm::vec3 &translation, const glm::vec3 &scale,
+                          const glm::mat3 &rotation) {
+  glm::quat q = glm::normalize(glm::quat_cast(rotation));
+  if (q.w < 0.0f) {
+    q = -q;
+  }
+  return PackedInstanceTrs{
+      .translation = translation,
+      .scale = scale,
+      .rotationXY = packSnorm2x16(q.x, q.y),
+      .rotationZW = packSnorm2x16(q.z, q.w),
+  };
+}
+
+PackedInstanceTrs packTrsDroppingShear(const glm::mat4 &transform) {
+  const glm::vec3 translation = glm::vec3(transform[3]);
+  glm::mat3 basis(1.0f);
+  glm::vec3 scale(1.0f);
+  if (!splitBasisAndScale(transform, basis, scale)) {
+    return PackedInstanceTrs{.translation = translation,
+                             .scale = glm::vec3(0.0f),
+                             .rotationXY = 0u,
+                             .rotationZW = packSnorm2x16(0.0f, 1.0f)};
+  }
+  // Gram-Schmidt keeps the x axis exact and the handedness fixed above.
+  glm::mat3 rotation;
+  rotation[0] = basis[0];
+  rotation[1] =
+      glm::normalize(basis[1] - glm::dot(basis[1], basis[0]) * basis[0]);
+  rotation[2] = glm::cross(rotation[0], rotation[1]);
+  return packTrs(translation, scale, rotation);
+}
+
+} // namespace
+
+PackedInstanceAffine packInstanceAffine(const glm::mat4 &transform) {
+  const glm::mat4 rows = glm::transpose(transform);
+  return PackedInstanceAffine{.rows = {rows[0], rows[1], rows[2]}};
+}
+
+std::optional<PackedInstanceTrs> packInstanceTrs(const glm::mat4 &transform) {
+  if (!isAffine(transform)) {
+    return std::nullopt;
+  }
+  glm::mat3 basis(1.0f);
+  glm::vec3 scale(1.0f);
+  if (!splitBasisAndScale(transform, basis, scale) || !isOrthogonal(basis)) {
+    return std::nullopt;
+  }
+  return packTrs(glm::vec3(transform[3]), scale, basis);
+}
+
+glm::mat4 unpackInstanceTrs(const PackedInstanceTrs &packed) {
+  const glm::vec2 xy = unpackSnorm2x16(packed.rotationXY);
+  const glm::vec2 zw = unpackSnorm2x16(packed.rotationZW);
+  const glm::quat q = glm::normalize(glm::quat(zw.y, xy.x, xy.y, zw.x));
+  const glm::mat3 rotation = glm::mat3_cast(q);
+  glm::mat4 transform(1.0f);
+  transform[0] = glm::vec4(rotation[0] * packed.scale.x, 0.0f);
+  transform[1] = glm::vec4(rotation[1] * packed.scale.y, 0.0f);
+  transform[2] = glm::vec4(rotation[2] * packed.scale.z, 0.0f);
+  transform[3] = glm::vec4(packed.translation, 1.0f);
+  return transform;
+}
+
+InstanceTransformEncoding
+selectInstanceTransformEncoding(std::span<const glm::mat4> transforms) {
+  for (const glm::mat4 &transform : transforms) {
+    if (!packInstanceTrs(transform).has_value()) {
+      return InstanceTransformEncoding::Affine3x4;
+    }
+  }
+  return InstanceTransformEncoding::CompactTrs;
+}
+
+void packInstanceTransforms(std::span<const glm::mat4> transforms,
+                            InstanceTransformEncoding encoding,
+                            std::span<std::byte> out) {
+  NURI_ASSERT(out.size() >=
+                  transforms.size() * instanceTransformStride(encoding),
+              "packInstanceTransforms: output span too small");
+  std::byte *cursor = out.data();
+  for (const glm::mat4 &transform : transforms) {
+    if (encoding == InstanceTransformEncoding::CompactTrs) {
+      const std::optional<PackedInstanceTrs> exact = packInstanceTrs(transform);
+      const PackedInstanceTrs packed =
+          exact.has_value() ? *exact : packTrsDroppingShear(transform);
+      std::memcpy(cursor, &packed, sizeof(packed));
+      cursor += sizeof(packed);
+    } else {
+      const PackedInstanceAffine packed = packInstanceAffine(transform);
+      std::memcpy(cursor, &packed, sizeof(packed));
+      cursor += sizeof(packed);
+    }
+  }
+}
+
+void setPackedInstanceTranslation(std::span<std::byte> packed,
+                                  InstanceTransformEncoding encoding,
+                                  size_t index, const glm::vec3 &translation) {
+  const size_t offset = index * instanceTransformStride(encoding);
+  NURI_ASSERT(offset + instanceTransformStride(encoding) <= packed.size(),
+              "setPackedInstanceTranslation: index out of range");
+  if (encoding == InstanceTransformEncoding::CompactTrs) {
+    std::memcpy(packed.data() + offset +
+                    offsetof(PackedInstanceTrs, translation),
+                &translation, sizeof(translation));
+    return;
+  }
+  // Translation is the w component of each affine row.
+  for (size_t row = 0; row < 3; ++row) {
+    std::memcpy(packed.data() + offset + row * sizeof(glm::vec4) +
+                    3u * sizeof(float),
+                &translation[static_cast<glm::length_t>(row)],
+                sizeof(float));
+  }
+}
+
+} // namespace nuri
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "nuri/defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <glm/glm.hpp>
+
+namespace nuri {
+
+// GPU layouts for per-instance model transforms. Values match the
+// kInstanceTransform* constants in common.sp.
+enum class InstanceTransformEncoding : uint32_t {
+  // Top three rows of the model matrix; handles any affine transform.
+  Affine3x4 = 0,
+  // Translation, per-axis scale and a snorm16 quaternion. Transforms with
+  // shear cannot be represented.
+  CompactTrs = 1,
+};
+
+struct PackedInstanceAffine {
+  glm::vec4 rows[3]{};
+};
+static_assert(sizeof(PackedInstanceAffine) == 48);
+
+struct PackedInstanceTrs {
+  glm::vec3 translation{0.0f};
+  glm::vec3 scale{1.0f};
+  // Quaternion (x, y, z, w) as snorm16 pairs.
+  uint32_t rotationXY = 0;
+  uint32_t rotationZW = 0;
+};
+static_assert(sizeof(PackedInstanceTrs) == 32);
+
+[[nodiscard]] constexpr size_t
+instanceTransformStride(InstanceTransformEncoding encoding) noexcept {
+  return encoding == InstanceTransformEncoding::CompactTrs
+             ? sizeof(PackedInstanceTrs)
+             : sizeof(PackedInstanceAffine);
+}
+
+[[nodiscard]] NURI_API PackedInstanceAffine
+packInstanceAffine(const glm::mat4 &transform);
+
+// Returns nullopt for projective, degenerate or sheared transforms.
+// Reflections are folded into a negative x scale.
+[[nodiscard]] NURI_API std::optional<PackedInstanceTrs>
+packInstanceTrs(const glm::mat4 &transform);
+
+[[nodiscard]] NURI_API glm::mat4
+unpackInstanceTrs(const PackedInstanceTrs &packed);
+
+// Picks the smallest encoding that represents every transform.
+[[nodiscard]] NURI_API InstanceTransformEncoding
+selectInstanceTransformEncoding(std::span<const glm::mat4> transforms);
+
+// Writes transforms.size() * instanceTransformStride(encoding) bytes. With
+// CompactTrs, transforms that fail to decompose keep their translation and
+// column scales but lose their shear.
+NURI_API void packInstanceTransforms(std::span<const glm::mat4> transforms,
+                                     InstanceTransformEncoding encoding,
+                                     std::span<std::byte> out);
+
+// Overwrites the translation of entry `index` in a packed transform array.
+NURI_API void setPackedInstanceTranslation(std::span<std::byte> packed,
+                                           InstanceTransformEncoding encoding,
+                                           size_t index,
+                                           const glm::vec3 &translation);
+
+} // namespace nuri
@@ -4,6 +4,7 @@
 #include "nuri/gfx/debug_draw_3d.h"
 #include "nuri/gfx/gpu_device.h"
 #include "nuri/gfx/pipeline.h"
+#include "nuri/gfx/pipeline_manager.h"
 #include "nuri/gfx/shader.h"
 #include "nuri/resources/gpu/resource_manager.h"
 #include "nuri/scene/render_scene.h"
@@ -65,50 +66,39 @@ Result<bool, std::string> DebugLayer::createGridShaders() {
   }
 
   const std::string vertexShaderPath = config_.vertex.string();
-  auto vertexResult =
-      gridShader_->compileFromFile(vertexShaderPath, ShaderStage::Vertex);
-  if (vertexResult.hasError()) {
-    gridVertexShader_ = {};
-    gridFragmentShader_ = {};
-    gridShader_.reset();
-    return Result<bool, std::string>::makeError(vertexResult.error());
-  }
   const std::string fragmentShaderPath = config_.fragment.string();
-  auto fragmentResult =
-      gridShader_->compileFromFile(fragmentShaderPath, ShaderStage::Fragment);
-  if (fragmentResult.hasError()) {
+  const std::array<ShaderFile, 2> files = {
+      ShaderFile{vertexShaderPath, ShaderStage::Vertex},
+      ShaderFile{fragmentShaderPath, ShaderStage::Fragment},
+  };
+  auto compiled = gridShader_->compileFromFiles(files);
+  if (compiled.hasError()) {
     gridVertexShader_ = {};
     gridFragmentShader_ = {};
     gridShader_.reset();
-    return Result<bool, std::string>::makeError(fragmentResult.error());
+    return Result<bool, std::string>::makeError(compiled.error());
   }
 
-  gridVertexShader_ = vertexResult.value();
-  gridFragmentShader_ = fragmentResult.value();
+  gridVertexShader_ = compiled.value()[0];
+  gridFragmentShader_ = compiled.value()[1];
   return Result<bool, std::string>::makeResult(true);
 }
 
-Result<bool, std::string> DebugLayer::ensureGridPipeline(Format colorFormat,
-                                                         Format depthFormat) {
+Result<bool, std::string>
+DebugLayer::ensureGridPipeline(PipelineManager *pipelines, Format colorFormat,
+                               Format depthFormat) {
   auto shaderResult = ensureGridInitialized();
   if (shaderResult.hasError()) {
     return shaderResult;
   }
 
-  if (nuri::isValid(gridPipelineHandle_) &&
-      gridPipelineColorFormat_ == colorFormat &&
-      gridPipelineDepthFormat_ == depthFormat) {
+  const bool formatsMatch = gridPipelineColorFormat_ == colorFormat &&
+                            gridPipelineDepthFormat_ == depthFormat;
+  if (formatsMatch && nuri::isValid(gridPipelineHandle_)) {
     return Result<bool, std::string>::makeResult(true);
   }
-
-  gridPipeline_.reset();
-  gridPipelineHandle_ = {};
-
-  gridPipeline_ = Pipeline::create(gpu_);
-  if (!gridPipeline_) {
-    return Result<bool, std::string>::makeError(
-        "DebugLayer::ensureGridPipeline: failed to create grid pipeline "
-        "wrapper");
+  if (!formatsMatch) {
+    releaseGridPipeline();
   }
 
   const RenderPipelineDesc desc{
@@ -123,6 +113,36 @@ Result<bool, std::string> DebugLayer::ensureGridPipeline(Format colorFormat,
       .blendEnabled = true,
   };
 
+  if (pipelines != nullptr) {
+    // Toggling the grid or changing formats must not stall the frame, so
+    // the grid is simply left out until its pipeline has compiled.
+    const uint64_t variant = (static_cast<uint64_t>(colorFormat) << 32u) |
+                             static_cast<uint64_t>(depthFormat);
+    const uint64_t key =
+        PipelineManager::makeKey(this, kGridPipelineName, variant);
+    auto lookupResult = pipelines->acquire(
+        key, PipelineRequest{.desc = desc,
+                             .debugName = kGridPipelineName,
+                             .policy = PipelineFallbackPolicy::Skip});
+    if (lookupResult.hasError()) {
+      return Result<bool, std::string>::makeError(lookupResult.error());
+    }
+    gridPipelineManager_ = pipelines;
+    gridPipelineKey_ = key;
+    gridPipelineHandle_ = lookupResult.value().handle;
+    gridPipelineColorFormat_ = colorFormat;
+    gridPipelineDepthFormat_ = depthFormat;
+    return Result<bool, std::string>::makeResult(
+        nuri::isValid(gridPipelineHandle_));
+  }
+
+  gridPipeline_ = Pipeline::create(gpu_);
+  if (!gridPipeline_) {
+    return Result<bool, std::string>::makeError(
+        "DebugLayer::ensureGridPipeline: failed to create grid pipeline "
+        "wrapper");
+  }
+
   auto pipelineResult =
       gridPipeline_->createRenderPipeline(desc, kGridPipelineName);
   if (pipelineResult.hasError()) {
@@ -135,6 +155,16 @@ Result<bool, std::string> DebugLayer::ensureGridPipeline(Format colorFormat,
   return Result<bool, std::string>::makeResult(true);
 }
 
+void DebugLayer::releaseGridPipeline() {
+  gridPipeline_.reset();
+  if (gridPipelineManager_ != nullptr) {
+    gridPipelineManager_->release(gridPipelineKey_);
+  }
+  gridPipelineManager_ = nullptr;
+  gridPipelineKey_ = 0;
+  gridPipelineHandle_ = {};
+}
+
 Result<bool, std::string>
 DebugLayer::prepareGridDraw(const RenderFrameContext &frame,
                             TextureHandle depthTexture) {
@@ -142,10 +172,14 @@ DebugLayer::prepareGridDraw(const RenderFrameContext &frame,
   const Format depthFormat =
       hasDepth ? gpu_.getTextureFormat(depthTexture) : Format::Count;
   auto pipelineResult =
-      ensureGridPipeline(gpu_.getSwapchainFormat(), depthFormat);
+      ensureGridPipeline(frame.pipelines, gpu_.getSwapchainFormat(),
+                         depthFormat);
   if (pipelineResult.hasError()) {
     return Result<bool, std::string>::makeError(pipelineResult.error());
   }
+  if (!pipelineResult.value()) {
+    return Result<bool, std::string>::makeResult(false);
+  }
 
   gridPushConstants_ = GridPushConstants{
       .mvp = frame.camera.proj * frame.camera.view,
@@ -172,12 +206,11 @@ DebugLayer::prepareGridDraw(const RenderFrameContext &frame,
 }
 
 void DebugLayer::resetGridState() {
-  gridPipeline_.reset();
+  releaseGridPipeline();
   gridShader_.reset();
 
   gridVertexShader_ = {};
   gridFragmentShader_ = {};
-  gridPipelineHandle_ = {};
   gridPipelineColorFormat_ = Format::Count;
   gridPipelineDepthFormat_ = Format::Count;
 
@@ -275,14 +308,18 @@ DebugLayer::buildRenderGraph(RenderFrameContext &frame,
     sceneDepthGraphTexture = *publishedSceneDepth;
   }
 
+  bool gridReady = false;
   if (frame.settings->debug.grid) {
-    const bool hasPriorColorPass = graph.passCount() > 0;
-    const bool hasDepth = nuri::isValid(sceneDepthTexture);
     auto gridResult = prepareGridDraw(frame, sceneDepthTexture);
     if (gridResult.hasError()) {
       return gridResult;
     }
+    gridReady = gridResult.value();
+  }
 
+  if (gridReady) {
+    const bool hasPriorColorPass = graph.passCount() > 0;
+    const bool hasDepth = nuri::isValid(sceneDepthTexture);
     RenderGraphTextureId depthTextureId{};
     if (hasDepth) {
       if (nuri::isValid(sceneDepthGraphTexture)) {
@@ -396,7 +433,9 @@ Result<bool, std::string> DebugLayer::buildTransparentStageContribution(
     if (gridResult.hasError()) {
       return gridResult;
     }
-    transparentFixedDraws_.push_back(gridDrawItem_);
+    if (gridResult.value()) {
+      transparentFixedDraws_.push_back(gridDrawItem_);
+    }
   }
 
   out.sortableDraws = std::span<const TransparentStageSortableDraw>(
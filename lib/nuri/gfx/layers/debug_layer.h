@@ -17,6 +17,7 @@ using DebugLayerConfig = RuntimeDebugShaderConfig;
 class DebugDraw3D;
 class GPUDevice;
 class Pipeline;
+class PipelineManager;
 class Shader;
 
 class NURI_API DebugLayer final : public Layer {
@@ -54,8 +55,11 @@ private:
 
   [[nodiscard]] Result<bool, std::string> ensureGridInitialized();
   [[nodiscard]] Result<bool, std::string> createGridShaders();
+  // Returns false while the pipeline is still compiling in `pipelines`.
   [[nodiscard]] Result<bool, std::string>
-  ensureGridPipeline(Format colorFormat, Format depthFormat);
+  ensureGridPipeline(PipelineManager *pipelines, Format colorFormat,
+                     Format depthFormat);
+  void releaseGridPipeline();
   [[nodiscard]] Result<bool, std::string>
   prepareGridDraw(const RenderFrameContext &frame, TextureHandle depthTexture);
   [[nodiscard]] Result<bool, std::string>
@@ -75,6 +79,8 @@ private:
   ShaderHandle gridVertexShader_{};
   ShaderHandle gridFragmentShader_{};
   RenderPipelineHandle gridPipelineHandle_{};
+  PipelineManager *gridPipelineManager_ = nullptr;
+  uint64_t gridPipelineKey_ = 0;
 
   Format gridPipelineColorFormat_ = Format::Count;
   Format gridPipelineDepthFormat_ = Format::Count;
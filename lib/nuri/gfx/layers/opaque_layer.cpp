@@ -5,8 +5,11 @@
 #include "nuri/core/containers/hash_map.h"
 #include "nuri/core/containers/hash_set.h"
 #include "nuri/core/log.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/pmr_scratch.h"
 #include "nuri/core/profiling.h"
+#include "nuri/gfx/pipeline_manager.h"
+#include "nuri/resources/mesh_cluster_hierarchy.h"
 #include "nuri/resources/gpu/resource_manager.h"
 #include "nuri/scene/render_scene.h"
 
@@ -17,8 +20,13 @@ constexpr float kAutoLodCameraReuseEpsilon = 2.5e-2f;
 constexpr float kAutoLodThresholdReuseEpsilon = 1.0e-4f;
 constexpr size_t kAutoLodTemporalReuseMinInstances = 4096u;
 constexpr uint64_t kAutoLodTemporalReuseFrameInterval = 2ull;
+// Occluders are models whose bounding radius covers at least 1/20th of their
+// distance to the camera, nearest first.
+constexpr float kOccluderMaxNormalizedDistanceSq = 400.0f;
+constexpr size_t kMaxOccludersPerFrame = 256u;
 constexpr float kBoundsRadiusHalf = 0.5f;
 constexpr size_t kMaxBatchReserve = 128;
+constexpr float kMinClusterLodErrorPixels = 1e-3f;
 constexpr float kClearDepthOne = 1.0f;
 constexpr float kClearColorWhite = 1.0f;
 constexpr uint32_t kOpaquePassDebugColor = 0xff0000ff;
@@ -32,6 +40,15 @@ constexpr size_t kMaxDrawItemsForIndirectPath = 8192u;
 constexpr uint32_t kUnlimitedTessInstanceCap = 0u;
 constexpr float kOverlayDepthBiasConstant = -1.0f;
 constexpr float kOverlayDepthBiasSlope = -1.0f;
+constexpr std::string_view kWireframePipelineName = "opaque_mesh_wireframe";
+constexpr std::string_view kTessWireframePipelineName =
+    "opaque_mesh_tess_wireframe";
+constexpr std::string_view kGsOverlayPipelineName = "opaque_mesh_overlay_gs";
+constexpr std::string_view kGsTessOverlayPipelineName =
+    "opaque_mesh_tess_overlay_gs";
+constexpr std::array<std::string_view, 4> kOverlayPipelineNames = {
+    kWireframePipelineName, kTessWireframePipelineName,
+    kGsOverlayPipelineName, kGsTessOverlayPipelineName};
 constexpr uint32_t kAutoLodCacheInvalidationSeed = 1664525u;
 constexpr uint32_t kAutoLodCacheInvalidationMagic = 1013904223u;
 // Phase hash: normalize 24-bit hash to [0, 1] then scale to [0, 2*pi]
@@ -42,9 +59,21 @@ constexpr uint32_t kPhaseHashShift1 = 16u;
 constexpr uint32_t kPhaseHashShift2 = 13u;
 constexpr uint64_t kFnvOffsetBasis64 = 14695981039346656037ull;
 constexpr uint64_t kFnvPrime64 = 1099511628211ull;
+
+const PerfCounterId kVisibleInstancesCounter = PerfCounters::registerCounter(
+    "opaque.visible_instances", PerfCounterKind::Gauge);
+const PerfCounterId kOccludedInstancesCounter = PerfCounters::registerCounter(
+    "opaque.occluded_instances", PerfCounterKind::Gauge);
+const PerfCounterId kInstancedDrawsCounter = PerfCounters::registerCounter(
+    "opaque.instanced_draws", PerfCounterKind::Gauge);
+const PerfCounterId kIndirectCommandsCounter = PerfCounters::registerCounter(
+    "opaque.indirect_commands", PerfCounterKind::Gauge);
 constexpr uint64_t kInvalidDrawSignature = std::numeric_limits<uint64_t>::max();
 constexpr std::string_view kOpaquePickPassLabel = "Opaque Pick Pass";
+constexpr std::string_view kOpaquePickHistoryKey = "opaque_pick_id";
 constexpr std::string_view kOpaqueMainPassLabel = "Opaque Pass";
+constexpr std::string_view kOpaqueOverlayPassLabel = "Opaque Overlay Pass";
+constexpr std::string_view kOpaquePickFragmentShaderFile = "main_pick.frag";
 
 uint64_t hashCombine64(uint64_t hash, uint64_t value) {
   hash ^= value;
@@ -91,6 +120,13 @@ meshPipelineDesc(Format swapchainFormat, Format depthFormat,
   };
 }
 
+// Pick pipelines shade like the main pipelines and also emit the object ID to
+// color attachment 1.
+RenderPipelineDesc withPickIdAttachment(RenderPipelineDesc desc) {
+  desc.additionalColorFormats[0] = Format::R32_UINT;
+  return desc;
+}
+
 bool isSamePipelineHandle(RenderPipelineHandle lhs, RenderPipelineHandle rhs) {
   return lhs.index == rhs.index && lhs.generation == rhs.generation;
 }
@@ -293,15 +329,21 @@ OpaqueLayer::OpaqueLayer(GPUDevice &gpu, OpaqueLayerConfig config,
       indirectCommandRing_(resolveMemoryResource(memory)),
       singleInstanceBatchCaches_(resolveMemoryResource(memory)),
       renderableTemplates_(resolveMemoryResource(memory)),
+      dynamicInstanceIndices_(resolveMemoryResource(memory)),
       meshDrawTemplates_(resolveMemoryResource(memory)),
       indirectSourceDrawIndices_(resolveMemoryResource(memory)),
       indirectUploadSignatures_(resolveMemoryResource(memory)),
       remapUploadSignatures_(resolveMemoryResource(memory)),
       templateBatchIndices_(resolveMemoryResource(memory)),
+      clusterBatchRefs_(resolveMemoryResource(memory)),
       batchWriteOffsets_(resolveMemoryResource(memory)),
       instanceCentersPhase_(resolveMemoryResource(memory)),
       instanceBaseMatrices_(resolveMemoryResource(memory)),
+      instanceBaseTransformsPacked_(resolveMemoryResource(memory)),
       instanceLodCentersInvRadiusSq_(resolveMemoryResource(memory)),
+      instanceWorldBounds_(resolveMemoryResource(memory)),
+      instanceOccluded_(resolveMemoryResource(memory)),
+      occluderCandidates_(resolveMemoryResource(memory)),
       materialGpuDataCache_(resolveMemoryResource(memory)),
       materialTextureAccessHandles_(resolveMemoryResource(memory)),
       instanceAutoLodLevels_(resolveMemoryResource(memory)),
@@ -311,6 +353,8 @@ OpaqueLayer::OpaqueLayer(GPUDevice &gpu, OpaqueLayerConfig config,
       drawPushConstants_(resolveMemoryResource(memory)),
       drawItems_(resolveMemoryResource(memory)),
       indirectDrawItems_(resolveMemoryResource(memory)),
+      indirectDrawStream_(resolveMemoryResource(memory)),
+      indirectStreamPatches_(resolveMemoryResource(memory)),
       indirectCommandUploadBytes_(resolveMemoryResource(memory)),
       overlayDrawItems_(resolveMemoryResource(memory)),
       pickDrawItems_(resolveMemoryResource(memory)),
@@ -342,7 +386,6 @@ void OpaqueLayer::resetPickState() {
 void OpaqueLayer::onDetach() {
   destroyBuffers();
   destroyDepthTexture();
-  destroyPickTexture();
   resetOverlayPipelineState();
   destroyMeshPipelineState();
   meshPipeline_.reset();
@@ -351,6 +394,7 @@ void OpaqueLayer::onDetach() {
   meshTessShader_.reset();
   meshDebugOverlayShader_.reset();
   meshPickShader_.reset();
+  meshIdShader_.reset();
   computeShader_.reset();
   meshVertexShader_ = {};
   meshTessVertexShader_ = {};
@@ -360,14 +404,22 @@ void OpaqueLayer::onDetach() {
   meshDebugOverlayGeometryShader_ = {};
   meshDebugOverlayFragmentShader_ = {};
   meshPickFragmentShader_ = {};
+  meshIdFragmentShader_ = {};
   computeShaderHandle_ = {};
   computePipelineHandle_ = {};
   tessellationUnsupported_ = false;
   renderableTemplates_.clear();
+  dynamicInstanceIndices_.clear();
   meshDrawTemplates_.clear();
   templateBatchIndices_.clear();
+  clusterBatchRefs_.clear();
   batchWriteOffsets_.clear();
   instanceLodCentersInvRadiusSq_.clear();
+  instanceWorldBounds_.clear();
+  instanceOccluded_.clear();
+  occluderCandidates_.clear();
+  occlusionCuller_.reset();
+  occludedInstanceCount_ = 0;
   materialGpuDataCache_.clear();
   materialTextureAccessHandles_.clear();
   instanceAutoLodLevels_.clear();
@@ -378,6 +430,8 @@ void OpaqueLayer::onDetach() {
   drawItems_.clear();
   indirectUploadSignatures_.clear();
   indirectDrawItems_.clear();
+  indirectDrawStream_.reset();
+  indirectStreamPatches_.clear();
   indirectCommandUploadBytes_.clear();
   overlayDrawItems_.clear();
   passDrawItems_.clear();
@@ -387,12 +441,16 @@ void OpaqueLayer::onDetach() {
   pickDrawItems_.clear();
   cachedScene_ = nullptr;
   cachedTopologyVersion_ = std::numeric_limits<uint64_t>::max();
-  cachedTransformVersion_ = std::numeric_limits<uint64_t>::max();
+  cachedStaticTransformVersion_ = std::numeric_limits<uint64_t>::max();
+  cachedDynamicTransformVersion_ = std::numeric_limits<uint64_t>::max();
   cachedMaterialVersion_ = std::numeric_limits<uint64_t>::max();
   cachedGeometryMutationVersion_ = std::numeric_limits<uint64_t>::max();
   instanceStaticBuffersDirty_ = true;
+  instanceDynamicBuffersDirty_ = false;
   uniformSingleSubmeshPath_ = false;
+  hasClusterLodTemplates_ = false;
   invalidateAutoLodCache();
+  invalidateAnimationHistory();
   invalidateSingleInstanceBatchCache();
   invalidateIndirectPackCache();
   cachedRemapSignature_ = kInvalidDrawSignature;
@@ -403,7 +461,6 @@ void OpaqueLayer::onDetach() {
 
 void OpaqueLayer::onResize(int32_t, int32_t) {
   destroyDepthTexture();
-  destroyPickTexture();
   resetPickState();
 }
 
@@ -444,43 +501,6 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       return depthResult;
     }
   }
-  if (!nuri::isValid(pickIdTexture_)) {
-    auto pickTextureResult = recreatePickTexture();
-    if (pickTextureResult.hasError()) {
-      return pickTextureResult;
-    }
-  }
-  if (inFlightPickReadback_.has_value() &&
-      frame.frameIndex > inFlightPickReadback_->submissionFrame) {
-    NURI_PROFILER_ZONE("OpaqueLayer.pick_readback",
-                       NURI_PROFILER_COLOR_CMD_COPY);
-    std::array<std::byte, sizeof(uint32_t)> pickBytes{};
-    const TextureReadbackRegion readbackRegion{
-        .x = inFlightPickReadback_->request.x,
-        .y = inFlightPickReadback_->request.y,
-        .width = 1,
-        .height = 1,
-        .mipLevel = 0,
-        .layer = 0,
-    };
-    auto readResult =
-        gpu_.readTexture(pickIdTexture_, readbackRegion, pickBytes);
-    if (readResult.hasError()) {
-      NURI_LOG_WARNING(
-          "OpaqueLayer::buildOpaquePasses: pick readback failed: %s",
-          readResult.error().c_str());
-    } else {
-      uint32_t encodedId = 0;
-      std::memcpy(&encodedId, pickBytes.data(), sizeof(encodedId));
-      OpaquePickResult result{};
-      result.requestId = inFlightPickReadback_->request.requestId;
-      result.hit = encodedId > 0;
-      result.renderableIndex = result.hit ? (encodedId - 1u) : 0u;
-      frame.opaquePickResult = result;
-    }
-    inFlightPickReadback_.reset();
-    NURI_PROFILER_ZONE_END();
-  }
   const bool topologyDirty =
       cachedScene_ != frame.scene ||
       cachedTopologyVersion_ != frame.scene->topologyVersion();
@@ -499,10 +519,15 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       cachedGeometryMutationVersion_ = geometryMutationVersion;
     }
   }
-  const bool transformDirty =
+  // Static moves repack every instance; dynamic-only moves refresh just the
+  // dynamic slots. Batches and indirect packs do not depend on transforms
+  // and survive both.
+  const bool staticTransformDirty =
       topologyDirty ||
-      cachedTransformVersion_ != frame.scene->transformVersion();
-  if (topologyDirty || transformDirty) {
+      cachedStaticTransformVersion_ != frame.scene->staticTransformVersion();
+  const bool dynamicTransformDirty =
+      cachedDynamicTransformVersion_ != frame.scene->dynamicTransformVersion();
+  if (staticTransformDirty || dynamicTransformDirty) {
     invalidateAutoLodCache();
   }
 
@@ -516,48 +541,27 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
   const uint32_t frameSlot =
       static_cast<uint32_t>(frame.frameIndex % swapchainImageCount);
 
-  if (topologyDirty || transformDirty) {
-    instanceCentersPhase_.clear();
-    instanceBaseMatrices_.clear();
-    instanceLodCentersInvRadiusSq_.clear();
-    instanceCentersPhase_.reserve(instanceCount);
-    instanceBaseMatrices_.reserve(instanceCount);
-    instanceLodCentersInvRadiusSq_.reserve(instanceCount);
-
-    const bool animateInstances = settings.opaque.enableInstanceAnimation;
-    for (size_t i = 0; i < instanceCount; ++i) {
-      const RenderableTemplate &templ = renderableTemplates_[i];
-      const Renderable *renderable = templ.renderable;
-      const Model *model = templ.model;
-      if (!renderable || !model) {
-        return Result<bool, std::string>::makeError(
-            "OpaqueLayer::buildOpaquePasses: invalid opaque renderable");
-      }
-
-      const glm::vec3 center = glm::vec3(renderable->modelMatrix[3]);
-      instanceCentersPhase_.push_back(
-          glm::vec4(center, animateInstances
-                                ? deterministicPhase(static_cast<uint32_t>(i))
-                                : 0.0f));
-      glm::mat4 baseMatrix = renderable->modelMatrix;
-      baseMatrix[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-      instanceBaseMatrices_.push_back(baseMatrix);
-
-      const BoundingBox &bounds = model->bounds();
-      const glm::vec3 localCenter = bounds.getCenter();
-      const float localRadius =
-          kBoundsRadiusHalf * glm::length(bounds.getSize());
-      const glm::vec3 worldCenter =
-          glm::vec3(renderable->modelMatrix * glm::vec4(localCenter, 1.0f));
-      const float worldRadius = std::max(
-          localRadius * maxAxisScale(renderable->modelMatrix), kMinLodRadius);
-      const float invRadiusSq = 1.0f / (worldRadius * worldRadius);
-      instanceLodCentersInvRadiusSq_.push_back(
-          glm::vec4(worldCenter, invRadiusSq));
-    }
-
-    cachedTransformVersion_ = frame.scene->transformVersion();
-    instanceStaticBuffersDirty_ = true;
+  const bool animateInstances = settings.opaque.enableInstanceAnimation;
+  if (!staticTransformDirty && dynamicTransformDirty &&
+      refreshDynamicInstanceTransforms(animateInstances)) {
+    cachedDynamicTransformVersion_ = frame.scene->dynamicTransformVersion();
+    invalidateAnimationHistory();
+  } else if (staticTransformDirty || dynamicTransformDirty) {
+    auto transformResult = rebuildInstanceTransforms(animateInstances);
+    if (transformResult.hasError()) {
+      return transformResult;
+    }
+    cachedStaticTransformVersion_ = frame.scene->staticTransformVersion();
+    cachedDynamicTransformVersion_ = frame.scene->dynamicTransformVersion();
+    invalidateAnimationHistory();
+  }
+
+  updateOcclusionVisibility(frame, settings);
+  // Occluded instances only drop out of the general batch path, and its remap
+  // must not be mistaken for the auto-LOD fast path's afterwards.
+  const bool occlusionActive = occludedInstanceCount_ > 0;
+  if (occlusionActive) {
+    invalidateAutoLodCache();
   }
 
   uint32_t cubemapTexId = kInvalidTextureBindlessIndex;
@@ -618,6 +622,26 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
     frameFlags |= FrameDataFlags::OutputLinearToSrgb;
   }
 
+  glm::vec4 irradianceVolumeMin{0.0f};
+  glm::vec4 irradianceVolumeInvExtent{0.0f};
+  glm::uvec4 irradianceVolumeInfo{kInvalidTextureBindlessIndex, 0u, 0u, 0u};
+  const IrradianceVolumeDesc &volume = environment.irradianceVolume;
+  const glm::vec3 volumeExtent = volume.boundsMax - volume.boundsMin;
+  if (const TextureRecord *volumeTexture =
+          frame.resources->tryGet(volume.texture);
+      settings.opaque.enableBakedIrradiance && volumeTexture != nullptr &&
+      nuri::isValid(volumeTexture->texture) && volume.probeCounts.x > 0u &&
+      volume.probeCounts.y > 0u && volume.probeCounts.z > 0u &&
+      volumeExtent.x > 0.0f && volumeExtent.y > 0.0f &&
+      volumeExtent.z > 0.0f) {
+    irradianceVolumeMin = glm::vec4(volume.boundsMin, 0.0f);
+    irradianceVolumeInvExtent = glm::vec4(1.0f / volumeExtent, 0.0f);
+    irradianceVolumeInfo =
+        glm::uvec4(volumeTexture->bindlessIndex, volume.probeCounts.x,
+                   volume.probeCounts.y, volume.probeCounts.z);
+    frameFlags |= FrameDataFlags::HasIrradianceVolume;
+  }
+
   frameData_ = FrameData{
       .view = frame.camera.view,
       .proj = frame.camera.proj,
@@ -630,6 +654,9 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       .brdfLutTexId = brdfLutTexId,
       .flags = frameFlags,
       .cubemapSamplerId = cubemapSamplerId,
+      .irradianceVolumeMin = irradianceVolumeMin,
+      .irradianceVolumeInvExtent = irradianceVolumeInvExtent,
+      .irradianceVolumeInfo = irradianceVolumeInfo,
   };
 
   auto frameDataResult = ensureFrameDataBufferCapacity(sizeof(FrameData));
@@ -641,13 +668,15 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
   if (centersResult.hasError()) {
     return centersResult;
   }
+  const size_t transformStride =
+      instanceTransformStride(instanceTransformEncoding_);
   auto baseMatricesResult = ensureInstanceBaseMatricesBufferCapacity(
-      std::max(instanceCount * sizeof(glm::mat4), sizeof(glm::mat4)));
+      std::max(instanceCount * transformStride, transformStride));
   if (baseMatricesResult.hasError()) {
     return baseMatricesResult;
   }
   auto matricesResult = ensureInstanceMatricesRingCapacity(
-      std::max(instanceCount * sizeof(glm::mat4), sizeof(glm::mat4)));
+      std::max(instanceCount * transformStride, transformStride));
   if (matricesResult.hasError()) {
     return matricesResult;
   }
@@ -687,10 +716,10 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         return updateResult;
       }
     }
-    if (!instanceBaseMatrices_.empty()) {
+    if (!instanceBaseTransformsPacked_.empty()) {
       const std::span<const std::byte> baseMatricesBytes{
-          reinterpret_cast<const std::byte *>(instanceBaseMatrices_.data()),
-          instanceBaseMatrices_.size() * sizeof(glm::mat4)};
+          instanceBaseTransformsPacked_.data(),
+          instanceBaseTransformsPacked_.size()};
       auto updateResult = gpu_.updateBuffer(
           instanceBaseMatricesBuffer_->handle(), baseMatricesBytes, 0);
       if (updateResult.hasError()) {
@@ -698,6 +727,12 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       }
     }
     instanceStaticBuffersDirty_ = false;
+    instanceDynamicBuffersDirty_ = false;
+  } else if (instanceDynamicBuffersDirty_) {
+    auto uploadResult = uploadDynamicInstanceTransforms();
+    if (uploadResult.hasError()) {
+      return uploadResult;
+    }
   }
 
   if (materialDirty || materialGpuDataCache_.empty()) {
@@ -756,6 +791,8 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
   const bool overlayRequested = wireOverlayRequested || patchHeatmapRequested;
   const uint32_t debugVisualizationMode =
       static_cast<uint32_t>(debugVisualization);
+  const uint32_t instanceTransformEncoding =
+      static_cast<uint32_t>(instanceTransformEncoding_);
   DrawItem baseDraw = baseMeshFillDraw_;
   const float tessNearDistance =
       std::max(0.0f, settings.opaque.tessNearDistance);
@@ -784,8 +821,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
   };
   constexpr uint32_t kInvalidBatchIndex = std::numeric_limits<uint32_t>::max();
 
-  ScratchArena batchScratchArena;
-  ScopedScratch batchScratch(batchScratchArena);
+  ScopedThreadScratch batchScratch;
   std::pmr::vector<BatchEntry> batches(batchScratch.resource());
   const size_t batchReserve =
       std::min<size_t>(meshDrawTemplates_.size(), kMaxBatchReserve);
@@ -822,9 +858,14 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
   const glm::vec3 cameraPosition = glm::vec3(frame.camera.cameraPos);
   const bool useAutoLod =
       settings.opaque.enableMeshLod && settings.opaque.forcedMeshLod < 0;
+  // Cluster selection varies per instance, so it always takes the general
+  // batch path.
+  const bool useClusterLod = useAutoLod && settings.opaque.enableClusterLod &&
+                             hasClusterLodTemplates_;
   const bool canUseUniformAutoLodFastPath =
       uniformSingleSubmeshPath_ && !meshDrawTemplates_.empty() && useAutoLod &&
-      instanceCount == meshDrawTemplates_.size();
+      instanceCount == meshDrawTemplates_.size() && !occlusionActive &&
+      !useClusterLod;
   const uint32_t forcedLod =
       settings.opaque.forcedMeshLod < 0
           ? 0u
@@ -1198,7 +1239,8 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
 
   const bool isSingleRenderableInstance = instanceCount == 1;
   if (!usedUniformFastPath && isSingleRenderableInstance &&
-      !meshDrawTemplates_.empty() && !uniformSingleSubmeshPath_) {
+      !meshDrawTemplates_.empty() && !uniformSingleSubmeshPath_ &&
+      !occlusionActive && !useClusterLod) {
     NURI_PROFILER_ZONE("OpaqueLayer.batch_build_single_instance_cache",
                        NURI_PROFILER_COLOR_CMD_DRAW);
 
@@ -1231,7 +1273,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
 
   if (!usedUniformFastPath && uniformSingleSubmeshPath_ &&
       !tessellationRequested && !meshDrawTemplates_.empty() && !useAutoLod &&
-      instanceCount == meshDrawTemplates_.size()) {
+      instanceCount == meshDrawTemplates_.size() && !occlusionActive) {
     NURI_PROFILER_ZONE("OpaqueLayer.batch_build_fast",
                        NURI_PROFILER_COLOR_CMD_DRAW);
     MeshDrawTemplate &templateEntry = meshDrawTemplates_.front();
@@ -1257,12 +1299,57 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
     NURI_PROFILER_ZONE_END();
   }
 
+  clusterBatchRefs_.clear();
   if (!usedUniformFastPath) {
     PmrHashMap<BatchKey, size_t, BatchKeyHash> batchLookup(
         batchScratch.resource());
     batchLookup.reserve(batchReserve);
     templateBatchIndices_.clear();
     templateBatchIndices_.resize(meshDrawTemplates_.size(), kInvalidBatchIndex);
+    const auto findOrAddBatch = [&batches, &batchLookup, &baseDraw](
+                                    const MeshDrawTemplate &templateEntry,
+                                    RenderPipelineHandle pipeline,
+                                    const SubmeshLod &range) -> size_t {
+      const BatchKey key{
+          .pipeline = pipeline,
+          .indexBuffer = templateEntry.indexBuffer,
+          .indexBufferOffset = templateEntry.indexBufferOffset,
+          .indexCount = range.indexCount,
+          .firstIndex = range.indexOffset,
+          .vertexBufferAddress = templateEntry.vertexBufferAddress,
+          .materialIndex = templateEntry.materialIndex,
+      };
+      auto it = batchLookup.find(key);
+      if (it == batchLookup.end()) {
+        BatchEntry entry{};
+        entry.draw = baseDraw;
+        entry.draw.pipeline = pipeline;
+        entry.draw.indexBuffer = templateEntry.indexBuffer;
+        entry.draw.indexBufferOffset = templateEntry.indexBufferOffset;
+        entry.draw.indexCount = range.indexCount;
+        entry.draw.firstIndex = range.indexOffset;
+        entry.draw.vertexOffset = 0;
+        entry.vertexBufferAddress = templateEntry.vertexBufferAddress;
+        entry.materialIndex = templateEntry.materialIndex;
+        batches.push_back(std::move(entry));
+        auto [insertedIt, _] = batchLookup.emplace(key, batches.size() - 1);
+        it = insertedIt;
+      }
+      return it->second;
+    };
+    // Projected error is error * scale / distance in pixels.
+    float clusterErrorScale = 0.0f;
+    if (useClusterLod) {
+      int32_t framebufferWidth = 0;
+      int32_t framebufferHeight = 0;
+      gpu_.getFramebufferSize(framebufferWidth, framebufferHeight);
+      clusterErrorScale =
+          std::abs(frame.camera.proj[1][1]) * 0.5f *
+          static_cast<float>(std::max(framebufferHeight, 1)) /
+          std::max(settings.opaque.clusterLodErrorPixels,
+                   kMinClusterLodErrorPixels);
+    }
+    std::pmr::vector<SubmeshLod> clusterRanges(batchScratch.resource());
     NURI_PROFILER_ZONE("OpaqueLayer.batch_build", NURI_PROFILER_COLOR_CMD_DRAW);
     for (size_t templateIndex = 0; templateIndex < meshDrawTemplates_.size();
          ++templateIndex) {
@@ -1271,6 +1358,30 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         return Result<bool, std::string>::makeError(
             "OpaqueLayer::buildOpaquePasses: invalid mesh template");
       }
+      if (occlusionActive &&
+          instanceOccluded_[templateEntry.instanceIndex] != 0u) {
+        continue;
+      }
+
+      if (useClusterLod && !templateEntry.clusters.empty()) {
+        clusterRanges.clear();
+        selectMeshClusters(templateEntry.clusters,
+                           templateEntry.renderable->modelMatrix,
+                           cameraPosition, clusterErrorScale, clusterRanges);
+        const RenderPipelineHandle pipeline =
+            selectMeshPipeline(templateEntry.doubleSided, false);
+        for (const SubmeshLod &range : clusterRanges) {
+          const size_t batchIndex =
+              findOrAddBatch(templateEntry, pipeline, range);
+          ++batches[batchIndex].instanceCount;
+          ++remapCount;
+          clusterBatchRefs_.push_back(ClusterBatchRef{
+              .batchIndex = static_cast<uint32_t>(batchIndex),
+              .instanceIndex = templateEntry.instanceIndex,
+          });
+        }
+        continue;
+      }
 
       uint32_t requestedLod = 0;
       if (!settings.opaque.enableMeshLod) {
@@ -1309,37 +1420,10 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         }
       }
 
-      const BatchKey key{
-          .pipeline = selectedPipeline,
-          .indexBuffer = templateEntry.indexBuffer,
-          .indexBufferOffset = templateEntry.indexBufferOffset,
-          .indexCount = lodRange.indexCount,
-          .firstIndex = lodRange.indexOffset,
-          .vertexBufferAddress = templateEntry.vertexBufferAddress,
-          .materialIndex = templateEntry.materialIndex,
-      };
-
-      auto it = batchLookup.find(key);
-      if (it == batchLookup.end()) {
-        BatchEntry entry{};
-        entry.draw = baseDraw;
-        entry.draw.pipeline = selectedPipeline;
-        entry.draw.indexBuffer = templateEntry.indexBuffer;
-        entry.draw.indexBufferOffset = templateEntry.indexBufferOffset;
-        entry.draw.indexCount = lodRange.indexCount;
-        entry.draw.firstIndex = lodRange.indexOffset;
-        entry.draw.vertexOffset = 0;
-        entry.vertexBufferAddress = templateEntry.vertexBufferAddress;
-        entry.materialIndex = templateEntry.materialIndex;
-        batches.push_back(std::move(entry));
-        const size_t insertedIndex = batches.size() - 1;
-        auto [insertedIt, _] = batchLookup.emplace(key, insertedIndex);
-        it = insertedIt;
-      }
-
-      const uint32_t batchIndex = static_cast<uint32_t>(it->second);
-      templateBatchIndices_[templateIndex] = batchIndex;
-      ++batches[it->second].instanceCount;
+      const size_t batchIndex =
+          findOrAddBatch(templateEntry, selectedPipeline, lodRange);
+      templateBatchIndices_[templateIndex] = static_cast<uint32_t>(batchIndex);
+      ++batches[batchIndex].instanceCount;
       ++remapCount;
     }
     NURI_PROFILER_ZONE_END();
@@ -1477,6 +1561,12 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         remapSignature =
             hashCombine64(remapSignature, static_cast<uint64_t>(instanceId));
       }
+      for (const ClusterBatchRef &ref : clusterBatchRefs_) {
+        const size_t writeOffset = batchWriteOffsets_[ref.batchIndex]++;
+        instanceRemap_[writeOffset] = ref.instanceIndex;
+        remapSignature = hashCombine64(
+            remapSignature, static_cast<uint64_t>(ref.instanceIndex));
+      }
     }
     if (shouldBuildRemap) {
       cachedRemapSignature_ = remapSignature;
@@ -1515,6 +1605,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         constants.tessMinFactor = tessMinFactor;
         constants.tessMaxFactor = tessMaxFactor;
         constants.debugVisualizationMode = debugVisualizationMode;
+        constants.instanceTransformEncoding = instanceTransformEncoding;
 
         DrawItem &draw = drawItems_[batchIndex];
         draw = batch.draw;
@@ -1575,6 +1666,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         constants.tessMinFactor = tessMinFactor;
         constants.tessMaxFactor = tessMaxFactor;
         constants.debugVisualizationMode = debugVisualizationMode;
+        constants.instanceTransformEncoding = instanceTransformEncoding;
 
         DrawItem &draw = drawItems_[batchIndex];
         draw = batch.draw;
@@ -1752,9 +1844,28 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
   } else {
     invalidateIndirectPackCache();
     indirectDrawItems_.clear();
+    indirectDrawStream_.reset();
+    indirectStreamPatches_.clear();
     indirectCommandUploadBytes_.clear();
   }
 
+  // Far instances may skip this frame only if the previous frame's slot
+  // holds a complete set of transforms for the current instance data.
+  const bool useComputePass = settings.opaque.enableInstanceCompute;
+  const uint32_t animationMaxUpdatePeriod = std::bit_floor(std::max(
+      settings.opaque.instanceAnimationMaxUpdatePeriod, 1u));
+  const bool throttleAnimation =
+      useComputePass && settings.opaque.enableInstanceAnimation &&
+      animationMaxUpdatePeriod > 1u &&
+      animationHistoryFrameIndex_ + 1u == frame.frameIndex &&
+      animationHistoryFrameSlot_ != frameSlot &&
+      animationHistoryFrameSlot_ < instanceMatricesRing_.size();
+  uint64_t previousInstanceMatricesAddress = 0;
+  if (throttleAnimation) {
+    previousInstanceMatricesAddress = gpu_.getBufferDeviceAddress(
+        instanceMatricesRing_[animationHistoryFrameSlot_].buffer->handle());
+  }
+
   computePushConstants_ = PushConstants{
       .frameDataAddress = frameDataAddress,
       .vertexBufferAddress = 0,
@@ -1773,26 +1884,31 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       .tessMinFactor = tessMinFactor,
       .tessMaxFactor = tessMaxFactor,
       .debugVisualizationMode = debugVisualizationMode,
+      .instanceTransformEncoding = instanceTransformEncoding,
+      .animationFrameIndex = static_cast<uint32_t>(frame.frameIndex),
+      .previousInstanceMatricesAddress = previousInstanceMatricesAddress,
+      .animationFullRateDistance =
+          std::max(settings.opaque.instanceAnimationFullRateDistance, 0.0f),
+      .animationMaxUpdatePeriod =
+          previousInstanceMatricesAddress != 0 ? animationMaxUpdatePeriod : 1u,
   };
-
-  const bool useComputePass = settings.opaque.enableInstanceCompute;
   if (!useComputePass && instanceCount > 0) {
     NURI_PROFILER_ZONE("OpaqueLayer.instance_matrices_cpu",
                        NURI_PROFILER_COLOR_CMD_COPY);
-    ScratchArena scratch;
-    ScopedScratch scopedScratch(scratch);
-    std::pmr::vector<glm::mat4> instanceMatrices(scopedScratch.resource());
-    instanceMatrices.resize(instanceCount);
-
+    ScopedThreadScratch scopedScratch;
+    // Base transforms have no translation, so placing each instance only
+    // patches the packed translation in place of a matrix multiply.
+    std::pmr::vector<std::byte> instanceTransforms(
+        instanceBaseTransformsPacked_.begin(),
+        instanceBaseTransformsPacked_.end(), scopedScratch.resource());
     for (size_t i = 0; i < instanceCount; ++i) {
-      const glm::vec3 center = glm::vec3(instanceCentersPhase_[i]);
-      const glm::mat4 translation = glm::translate(glm::mat4(1.0f), center);
-      instanceMatrices[i] = translation * instanceBaseMatrices_[i];
+      setPackedInstanceTranslation(instanceTransforms,
+                                   instanceTransformEncoding_, i,
+                                   glm::vec3(instanceCentersPhase_[i]));
     }
 
-    const std::span<const std::byte> matricesBytes{
-        reinterpret_cast<const std::byte *>(instanceMatrices.data()),
-        instanceMatrices.size() * sizeof(glm::mat4)};
+    const std::span<const std::byte> matricesBytes{instanceTransforms.data(),
+                                                   instanceTransforms.size()};
     auto updateResult = gpu_.updateBuffer(
         instanceMatricesRing_[frameSlot].buffer->handle(), matricesBytes, 0);
     if (updateResult.hasError()) {
@@ -1876,6 +1992,16 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
             return depResult;
           }
         }
+        if (previousInstanceMatricesAddress != 0) {
+          auto depResult = appendUniqueDependency(
+              dispatchDependencyBuffers_,
+              instanceMatricesRing_[animationHistoryFrameSlot_]
+                  .buffer->handle(),
+              "OpaqueLayer::buildOpaquePasses(dispatch)");
+          if (depResult.hasError()) {
+            return depResult;
+          }
+        }
         auto dispatchDepResult = appendUniqueDependency(
             dispatchDependencyBuffers_,
             instanceMatricesRing_[frameSlot].buffer->handle(),
@@ -1901,8 +2027,13 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         dispatch.debugLabel = "Opaque Instance Compute";
         dispatch.debugColor = kComputeDispatchColor;
         preDispatches_.push_back(dispatch);
+        animationHistoryFrameIndex_ = frame.frameIndex;
+        animationHistoryFrameSlot_ = frameSlot;
       }
     }
+    if (preDispatches_.empty()) {
+      invalidateAnimationHistory();
+    }
     NURI_PROFILER_ZONE_END();
   }
 
@@ -1934,7 +2065,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
     bool lineOverlayAvailable = false;
     bool lineTessOverlayAvailable = false;
 
-    auto lineResult = ensureWireframePipeline();
+    auto lineResult = ensureWireframePipeline(frame.pipelines);
     if (lineResult.hasError()) {
       if (!loggedWireframeFallbackUnsupported_) {
         loggedWireframeFallbackUnsupported_ = true;
@@ -1946,7 +2077,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       lineOverlayAvailable = lineResult.value();
     }
 
-    auto lineTessResult = ensureTessWireframePipeline();
+    auto lineTessResult = ensureTessWireframePipeline(frame.pipelines);
     if (lineTessResult.hasError()) {
       if (!loggedTessWireframeFallbackUnsupported_) {
         loggedTessWireframeFallbackUnsupported_ = true;
@@ -2002,7 +2133,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       bool lineOverlayAvailable = false;
       bool lineTessOverlayAvailable = false;
 
-      auto gsOverlayResult = ensureGsOverlayPipeline();
+      auto gsOverlayResult = ensureGsOverlayPipeline(frame.pipelines);
       if (gsOverlayResult.hasError()) {
         if (!loggedGsOverlayUnsupported_) {
           loggedGsOverlayUnsupported_ = true;
@@ -2014,7 +2145,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         gsOverlayAvailable = gsOverlayResult.value();
       }
 
-      auto gsTessOverlayResult = ensureGsTessOverlayPipeline();
+      auto gsTessOverlayResult = ensureGsTessOverlayPipeline(frame.pipelines);
       if (gsTessOverlayResult.hasError()) {
         if (!loggedGsTessOverlayUnsupported_) {
           loggedGsTessOverlayUnsupported_ = true;
@@ -2027,7 +2158,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       }
 
       if (!gsOverlayAvailable) {
-        auto lineResult = ensureWireframePipeline();
+        auto lineResult = ensureWireframePipeline(frame.pipelines);
         if (lineResult.hasError()) {
           if (!loggedWireframeFallbackUnsupported_) {
             loggedWireframeFallbackUnsupported_ = true;
@@ -2040,7 +2171,7 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
         }
       }
       if (!gsTessOverlayAvailable) {
-        auto lineTessResult = ensureTessWireframePipeline();
+        auto lineTessResult = ensureTessWireframePipeline(frame.pipelines);
         if (lineTessResult.hasError()) {
           if (!loggedTessWireframeFallbackUnsupported_) {
             loggedTessWireframeFallbackUnsupported_ = true;
@@ -2124,6 +2255,12 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
 
   frame.metrics.opaque.totalInstances = saturateToU32(instanceCount);
   frame.metrics.opaque.visibleInstances = saturateToU32(remapCount);
+  frame.metrics.opaque.occludedInstances =
+      saturateToU32(occludedInstanceCount_);
+  frame.metrics.opaque.occluders =
+      occlusionCuller_ != nullptr && !instanceOccluded_.empty()
+          ? occlusionCuller_->stats().occluders
+          : 0u;
   frame.metrics.opaque.instancedDraws = saturateToU32(drawItems_.size());
   frame.metrics.opaque.indirectDrawCalls =
       saturateToU32(indirectDrawItems_.size());
@@ -2138,6 +2275,10 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
       saturateToU32(debugPatchHeatmapDraws);
   frame.metrics.opaque.computeDispatches = saturateToU32(preDispatches_.size());
   frame.metrics.opaque.computeDispatchX = computeDispatchX;
+  PerfCounters::set(kVisibleInstancesCounter, remapCount);
+  PerfCounters::set(kOccludedInstancesCounter, occludedInstanceCount_);
+  PerfCounters::set(kInstancedDrawsCounter, drawItems_.size());
+  PerfCounters::set(kIndirectCommandsCounter, indirectCommandCount);
 
   ++statsLogFrameCounter_;
   const bool shouldLogStats = (statsLogFrameCounter_ & 511ull) == 0ull;
@@ -2155,20 +2296,33 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
     //                debugOverlayDraws, debugOverlayFallbackDraws);
   }
 
-  bool pickPassSubmitted = false;
-  if (pendingPickRequest_.has_value() && nuri::isValid(pickIdTexture_) &&
-      nuri::isValid(meshPickPipelineHandle_)) {
+  // Pick requests ride along the main pass as a second color attachment.
+  // Wireframe-only frames draw line pipelines that cannot carry the ID
+  // output, so they keep a dedicated ID prepass that writes only the R32_UINT
+  // pick target.
+  const bool wireframeOnlyPass =
+      wireframeOnlyRequested && !overlayDrawItems_.empty();
+  bool pickPrepassSubmitted = false;
+  bool mainPassWritesPickId = false;
+  std::span<const DrawItem> mainPassDrawItems = finalPassDrawItems;
+  std::span<const DrawItem> overlayPassDrawItems{};
+  if (pendingPickRequest_.has_value() &&
+      nuri::isValid(wireframeOnlyPass ? meshIdPipelineHandle_
+                                      : meshPickPipelineHandle_)) {
     NURI_PROFILER_ZONE("OpaqueLayer.pick_pass", NURI_PROFILER_COLOR_CMD_DRAW);
     pickDrawItems_.clear();
     pickDrawItems_.reserve(baseDrawItems.size());
 
     for (const DrawItem &baseItem : baseDrawItems) {
       DrawItem pickItem = baseItem;
-      pickItem.pipeline = selectPickPipeline(baseItem.pipeline);
+      pickItem.pipeline =
+          selectPickPipeline(baseItem.pipeline, wireframeOnlyPass);
       pickItem.debugLabel = "OpaqueMeshPick";
       pickItem.debugColor = kOpaquePassDebugColor;
       pickDrawItems_.push_back(pickItem);
     }
+    const std::span<const DrawItem> pickDraws(pickDrawItems_.data(),
+                                              pickDrawItems_.size());
 
     int32_t framebufferWidth = 0;
     int32_t framebufferHeight = 0;
@@ -2180,34 +2334,40 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
     pendingPickRequest_->x = std::min(pendingPickRequest_->x, safeWidth - 1u);
     pendingPickRequest_->y = std::min(pendingPickRequest_->y, safeHeight - 1u);
 
-    PreparedGraphPass pickPass{};
-    pickPass.desc.color = {.loadOp = LoadOp::Clear,
-                           .storeOp = StoreOp::Store,
-                           .clearColor = {0.0f, 0.0f, 0.0f, 0.0f}};
-    pickPass.colorTextureHandle = pickIdTexture_;
-    pickPass.desc.depth = {.loadOp = LoadOp::Clear,
-                           .storeOp = StoreOp::Store,
-                           .clearDepth = kClearDepthOne,
-                           .clearStencil = 0};
-    pickPass.depthTextureHandle = depthTexture_;
-    pickPass.desc.preDispatches = std::span<const ComputeDispatchItem>(
-        preDispatches_.data(), preDispatches_.size());
-    pickPass.desc.dependencyBuffers = std::span<const BufferHandle>(
-        passDependencyBuffers_.data(), passDependencyBuffers_.size());
-    pickPass.desc.draws =
-        std::span<const DrawItem>(pickDrawItems_.data(), pickDrawItems_.size());
-    pickPass.desc.debugLabel = kOpaquePickPassLabel;
-    pickPass.desc.debugColor = kOpaquePassDebugColor;
-    pickPass.hasDraws = !pickDrawItems_.empty();
-    pickPass.hasPreDispatch = !preDispatches_.empty();
-    pickPass.hasIndirectDraws = false;
-    pickPass.isPickPass = true;
-    out.push_back(pickPass);
+    if (wireframeOnlyPass) {
+      PreparedGraphPass pickPass{};
+      pickPass.desc.color = {.loadOp = LoadOp::Clear,
+                             .storeOp = StoreOp::Store,
+                             .clearColor = {0.0f, 0.0f, 0.0f, 0.0f}};
+      pickPass.writesPickId = true;
+      pickPass.desc.depth = {.loadOp = LoadOp::Clear,
+                             .storeOp = StoreOp::Store,
+                             .clearDepth = kClearDepthOne,
+                             .clearStencil = 0};
+      pickPass.depthTextureHandle = depthTexture_;
+      pickPass.desc.preDispatches = std::span<const ComputeDispatchItem>(
+          preDispatches_.data(), preDispatches_.size());
+      pickPass.desc.dependencyBuffers = std::span<const BufferHandle>(
+          passDependencyBuffers_.data(), passDependencyBuffers_.size());
+      pickPass.desc.draws = pickDraws;
+      pickPass.desc.debugLabel = kOpaquePickPassLabel;
+      pickPass.desc.debugColor = kOpaquePassDebugColor;
+      pickPass.hasDraws = !pickDraws.empty();
+      pickPass.hasPreDispatch = !preDispatches_.empty();
+      pickPass.hasIndirectDraws = hasIndirectBaseDraws;
+      pickPass.isPickPass = true;
+      out.push_back(pickPass);
+      pickPrepassSubmitted = true;
+    } else {
+      mainPassWritesPickId = true;
+      mainPassDrawItems = pickDraws;
+      overlayPassDrawItems = std::span<const DrawItem>(
+          overlayDrawItems_.data(), overlayDrawItems_.size());
+    }
 
     inFlightPickReadback_ = InFlightPickReadback{
         .request = *pendingPickRequest_, .submissionFrame = frame.frameIndex};
     pendingPickRequest_.reset();
-    pickPassSubmitted = true;
     NURI_PROFILER_ZONE_END();
   }
 
@@ -2222,24 +2382,59 @@ OpaqueLayer::buildOpaquePasses(RenderFrameContext &frame,
                      .clearDepth = kClearDepthOne,
                      .clearStencil = 0};
   pass.depthTextureHandle = depthTexture_;
-  if (!pickPassSubmitted) {
+  pass.writesPickId = mainPassWritesPickId;
+  if (!pickPrepassSubmitted) {
     pass.desc.preDispatches = std::span<const ComputeDispatchItem>(
         preDispatches_.data(), preDispatches_.size());
   }
   pass.desc.dependencyBuffers = std::span<const BufferHandle>(
       passDependencyBuffers_.data(), passDependencyBuffers_.size());
-  pass.desc.draws = finalPassDrawItems;
+  // The indirect pack keeps its stream across frames and patches it in
+  // place, so the graph clones one byte buffer for it. Other draw lists are
+  // built as DrawItems and go through unchanged; re-encoding them every frame
+  // would only add a conversion pass.
+  const bool usesIndirectStream =
+      mainPassDrawItems.data() == indirectDrawItems_.data() &&
+      mainPassDrawItems.size() == indirectDrawItems_.size() &&
+      indirectDrawStream_.drawCount() == indirectDrawItems_.size();
+  if (usesIndirectStream) {
+    pass.desc.drawStream = indirectDrawStream_.bytes();
+  } else {
+    pass.desc.draws = mainPassDrawItems;
+  }
   pass.desc.debugLabel = kOpaqueMainPassLabel;
   pass.desc.debugColor = kOpaquePassDebugColor;
-  pass.hasDraws = !finalPassDrawItems.empty();
-  pass.hasPreDispatch = !pickPassSubmitted && !preDispatches_.empty();
+  pass.hasDraws = !mainPassDrawItems.empty();
+  pass.hasPreDispatch = !pickPrepassSubmitted && !preDispatches_.empty();
   pass.hasIndirectDraws = hasIndirectBaseDraws;
   pass.isMainPass = true;
+  out.push_back(pass);
+
+  if (!overlayPassDrawItems.empty()) {
+    PreparedGraphPass overlayPass{};
+    overlayPass.desc.color = {.loadOp = LoadOp::Load,
+                              .storeOp = StoreOp::Store,
+                              .clearColor = {kClearColorWhite, kClearColorWhite,
+                                             kClearColorWhite,
+                                             kClearColorWhite}};
+    overlayPass.desc.depth = {.loadOp = LoadOp::Load,
+                              .storeOp = StoreOp::Store,
+                              .clearDepth = kClearDepthOne,
+                              .clearStencil = 0};
+    overlayPass.desc.dependencyBuffers = std::span<const BufferHandle>(
+        passDependencyBuffers_.data(), passDependencyBuffers_.size());
+    overlayPass.desc.draws = overlayPassDrawItems;
+    overlayPass.desc.debugLabel = kOpaqueOverlayPassLabel;
+    overlayPass.desc.debugColor = kOpaquePassDebugColor;
+    overlayPass.hasDraws = true;
+    overlayPass.hasIndirectDraws = hasIndirectBaseDraws;
+    overlayPass.isOverlayPass = true;
+    out.push_back(overlayPass);
+  }
 
   frame.sharedDepthTexture = depthTexture_;
   frame.channels.publish<TextureHandle>(kFrameChannelSceneDepthTexture,
                                         depthTexture_);
-  out.push_back(pass);
   return Result<bool, std::string>::makeResult(true);
 }
 
@@ -2250,6 +2445,23 @@ OpaqueLayer::buildRenderGraph(RenderFrameContext &frame,
 
   std::pmr::memory_resource *const memory =
       renderableTemplates_.get_allocator().resource();
+  // The pick target is a history texture: a pick frame writes `current` and
+  // the next frame reads the same texture back as `previous`, while a new
+  // pick can already write the other slot.
+  std::optional<RenderGraphHistoryTexture> pickHistory;
+  if (pendingPickRequest_.has_value() || inFlightPickReadback_.has_value()) {
+    auto pickHistoryResult =
+        graph.importHistoryTexture(kOpaquePickHistoryKey, pickHistoryDesc());
+    if (pickHistoryResult.hasError()) {
+      return Result<bool, std::string>::makeError(pickHistoryResult.error());
+    }
+    pickHistory = pickHistoryResult.value();
+  }
+  if (inFlightPickReadback_.has_value() &&
+      frame.frameIndex > inFlightPickReadback_->submissionFrame) {
+    readBackPick(frame, *pickHistory);
+  }
+
   std::pmr::vector<PreparedGraphPass> localPasses(memory);
   auto buildResult = buildOpaquePasses(frame, localPasses);
   if (buildResult.hasError()) {
@@ -2273,6 +2485,7 @@ OpaqueLayer::buildRenderGraph(RenderFrameContext &frame,
       static_cast<uint32_t>(std::max(framebufferWidth, 1));
   const uint32_t safeHeight =
       static_cast<uint32_t>(std::max(framebufferHeight, 1));
+  RenderGraphTextureId sceneDepthGraphTexture{};
 
   for (const PreparedGraphPass &pass : localPasses) {
     RenderGraphGraphicsPassDesc passDesc = pass.desc;
@@ -2295,6 +2508,35 @@ OpaqueLayer::buildRenderGraph(RenderFrameContext &frame,
       passDesc.depthTexture = depthImportResult.value();
     }
 
+    if (pass.isOverlayPass) {
+      if (!nuri::isValid(sceneDepthGraphTexture)) {
+        return Result<bool, std::string>::makeError(
+            "OpaqueLayer::buildRenderGraph: overlay pass has no scene depth");
+      }
+      passDesc.depthTexture = sceneDepthGraphTexture;
+    }
+
+    std::array<RenderGraphColorAttachment, 1> pickAttachments{};
+    if (pass.writesPickId) {
+      if (!pickHistory.has_value()) {
+        return Result<bool, std::string>::makeError(
+            "OpaqueLayer::buildRenderGraph: pick pass has no pick target");
+      }
+      if (pass.isPickPass) {
+        passDesc.colorTexture = pickHistory->current;
+      } else {
+        pickAttachments[0] = {
+            .color = {.loadOp = LoadOp::Clear,
+                      .storeOp = StoreOp::Store,
+                      .clearColor = {0.0f, 0.0f, 0.0f, 0.0f}},
+            .texture = pickHistory->current};
+        passDesc.additionalColorAttachments =
+            std::span<const RenderGraphColorAttachment>(pickAttachments);
+      }
+      frame.channels.publish<RenderGraphTextureId>(
+          kFrameChannelOpaquePickGraphTexture, pickHistory->current);
+    }
+
     auto addResult = graph.addGraphicsPass(passDesc);
     if (addResult.hasError()) {
       return Result<bool, std::string>::makeError(addResult.error());
@@ -2314,13 +2556,11 @@ OpaqueLayer::buildRenderGraph(RenderFrameContext &frame,
     if (hasPreDispatch || hasIndirectDraws) {
       opaqueIndirectPassIds.push_back(passId);
     }
-    if (pass.isMainPass) {
+    if (pass.isMainPass || pass.isOverlayPass) {
       opaqueShadingPassIds.push_back(passId);
     }
 
     if (pass.isPickPass) {
-      frame.channels.publish<RenderGraphTextureId>(
-          kFrameChannelOpaquePickGraphTexture, passDesc.colorTexture);
       const Format pickDepthFormat =
           nuri::isValid(pass.depthTextureHandle)
               ? gpu_.getTextureFormat(pass.depthTextureHandle)
@@ -2380,8 +2620,13 @@ OpaqueLayer::buildRenderGraph(RenderFrameContext &frame,
         return Result<bool, std::string>::makeError(
             bindSceneDepthResult.error());
       }
+      sceneDepthGraphTexture = sceneDepthResult.value();
       frame.channels.publish<RenderGraphTextureId>(
-          kFrameChannelSceneDepthGraphTexture, sceneDepthResult.value());
+          kFrameChannelSceneDepthGraphTexture, sceneDepthGraphTexture);
+      if (pass.writesPickId) {
+        frame.channels.publish<RenderGraphTextureId>(
+            kFrameChannelOpaquePickDepthGraphTexture, sceneDepthGraphTexture);
+      }
     }
   }
 
@@ -2516,13 +2761,14 @@ OpaqueLayer::buildRenderGraph(RenderFrameContext &frame,
 
   if (frame.scene != nullptr && frame.resources != nullptr) {
     const EnvironmentHandles &environment = frame.scene->environment();
-    const std::array<std::pair<TextureRef, std::string_view>, 5> envTextures = {
+    const std::array<std::pair<TextureRef, std::string_view>, 6> envTextures = {
         {
             {environment.cubemap, "opaque_env_cubemap"},
             {environment.irradiance, "opaque_env_irradiance"},
             {environment.prefilteredGgx, "opaque_env_prefiltered_ggx"},
             {environment.prefilteredCharlie, "opaque_env_prefiltered_charlie"},
             {environment.brdfLut, "opaque_env_brdf_lut"},
+            {environment.irradianceVolume.texture, "opaque_irradiance_volume"},
         }};
 
     for (const auto &[ref, name] : envTextures) {
@@ -2610,8 +2856,7 @@ Result<bool, std::string> OpaqueLayer::ensureSingleInstanceBatchCache(
     return Result<bool, std::string>::makeResult(true);
   }
 
-  ScratchArena scratch;
-  ScopedScratch scopedScratch(scratch);
+  ScopedThreadScratch scopedScratch;
   PmrHashMap<BatchKey, size_t, BatchKeyHash> singleBatchLookup(
       scopedScratch.resource());
   singleBatchLookup.reserve(meshDrawTemplates_.size());
@@ -2688,6 +2933,8 @@ OpaqueLayer::buildIndirectDraws(uint32_t frameSlot, size_t remapCount,
   if (!canUseIndirectPath) {
     invalidateIndirectPackCache();
     indirectDrawItems_.clear();
+    indirectDrawStream_.reset();
+    indirectStreamPatches_.clear();
     indirectCommandUploadBytes_.clear();
     return Result<bool, std::string>::makeResult(true);
   }
@@ -2778,8 +3025,7 @@ bool OpaqueLayer::canReuseIndirectPack(uint64_t drawSignature) const {
 Result<bool, std::string>
 OpaqueLayer::rebuildIndirectPack(uint32_t frameSlot, size_t remapCount,
                                  uint64_t drawSignature) {
-  ScratchArena scratch;
-  ScopedScratch scopedScratch(scratch);
+  ScopedThreadScratch scopedScratch;
 
   struct IndirectGroup {
     DrawItem baseDraw{};
@@ -2875,12 +3121,15 @@ OpaqueLayer::rebuildIndirectPack(uint32_t frameSlot, size_t remapCount,
   }
 
   indirectDrawItems_.clear();
+  indirectDrawStream_.reset();
+  indirectStreamPatches_.clear();
   indirectCommandUploadBytes_.clear();
   indirectSourceDrawIndices_.clear();
 
   if (!indirectGroups.empty()) {
     indirectCommandUploadBytes_.reserve(packedRequiredBytes);
     indirectDrawItems_.reserve(totalIndirectDrawItems);
+    indirectStreamPatches_.reserve(totalIndirectDrawItems);
     indirectSourceDrawIndices_.reserve(totalIndirectDrawItems);
 
     const BufferHandle indirectBufferHandle =
@@ -2931,6 +3180,8 @@ OpaqueLayer::rebuildIndirectPack(uint32_t frameSlot, size_t remapCount,
                 &drawPushConstants_[group.sourceDrawIndex]),
             sizeof(PushConstants));
         indirectDrawItems_.push_back(indirectDraw);
+        indirectStreamPatches_.push_back(
+            indirectDrawStream_.appendPatchableDrawItem(indirectDraw));
         indirectSourceDrawIndices_.push_back(group.sourceDrawIndex);
 
         commandCursor += drawCount;
@@ -2956,7 +3207,8 @@ OpaqueLayer::rebuildIndirectPack(uint32_t frameSlot, size_t remapCount,
 Result<bool, std::string>
 OpaqueLayer::refreshCachedIndirectPack(uint32_t frameSlot,
                                        uint64_t drawSignature) {
-  if (indirectSourceDrawIndices_.size() != indirectDrawItems_.size()) {
+  if (indirectSourceDrawIndices_.size() != indirectDrawItems_.size() ||
+      indirectStreamPatches_.size() != indirectDrawItems_.size()) {
     return Result<bool, std::string>::makeError(
         "OpaqueLayer::buildIndirectDraws: cached indirect source mapping is "
         "invalid");
@@ -2974,6 +3226,15 @@ OpaqueLayer::refreshCachedIndirectPack(uint32_t frameSlot,
     indirectDrawItems_[i].pushConstants = std::span<const std::byte>(
         reinterpret_cast<const std::byte *>(&drawPushConstants_[sourceIndex]),
         sizeof(PushConstants));
+
+    const DrawStreamPatchOffsets &patch = indirectStreamPatches_[i];
+    if (patch.pushConstants != DrawStreamPatchOffsets::kNone) {
+      indirectDrawStream_.patch(patch.pushConstants,
+                                indirectDrawItems_[i].pushConstants);
+    }
+    indirectDrawStream_.patch(
+        patch.draw + offsetof(DrawStreamDrawIndexedIndirect, buffer),
+        std::as_bytes(std::span(&indirectBufferHandle, 1u)));
   }
 
   if (indirectUploadSignatures_[frameSlot] != drawSignature) {
@@ -3006,6 +3267,7 @@ Result<bool, std::string> OpaqueLayer::ensureInitialized() {
     meshTessShader_.reset();
     meshDebugOverlayShader_.reset();
     meshPickShader_.reset();
+    meshIdShader_.reset();
     computeShader_.reset();
     meshVertexShader_ = {};
     meshTessVertexShader_ = {};
@@ -3015,34 +3277,13 @@ Result<bool, std::string> OpaqueLayer::ensureInitialized() {
     meshDebugOverlayGeometryShader_ = {};
     meshDebugOverlayFragmentShader_ = {};
     meshPickFragmentShader_ = {};
+    meshIdFragmentShader_ = {};
     computeShaderHandle_ = {};
     resetMeshPipelineState();
     tessellationUnsupported_ = false;
     return depthResult;
   }
 
-  auto pickTextureResult = recreatePickTexture();
-  if (pickTextureResult.hasError()) {
-    meshShader_.reset();
-    meshTessShader_.reset();
-    meshDebugOverlayShader_.reset();
-    meshPickShader_.reset();
-    computeShader_.reset();
-    meshVertexShader_ = {};
-    meshTessVertexShader_ = {};
-    meshTessControlShader_ = {};
-    meshTessEvalShader_ = {};
-    meshFragmentShader_ = {};
-    meshDebugOverlayGeometryShader_ = {};
-    meshDebugOverlayFragmentShader_ = {};
-    meshPickFragmentShader_ = {};
-    computeShaderHandle_ = {};
-    resetMeshPipelineState();
-    tessellationUnsupported_ = false;
-    destroyDepthTexture();
-    return pickTextureResult;
-  }
-
   auto pipelineResult = createPipelines();
   if (pipelineResult.hasError()) {
     resetOverlayPipelineState();
@@ -3053,6 +3294,7 @@ Result<bool, std::string> OpaqueLayer::ensureInitialized() {
     meshTessShader_.reset();
     meshDebugOverlayShader_.reset();
     meshPickShader_.reset();
+    meshIdShader_.reset();
     computeShader_.reset();
     meshVertexShader_ = {};
     meshTessVertexShader_ = {};
@@ -3062,11 +3304,11 @@ Result<bool, std::string> OpaqueLayer::ensureInitialized() {
     meshDebugOverlayGeometryShader_ = {};
     meshDebugOverlayFragmentShader_ = {};
     meshPickFragmentShader_ = {};
+    meshIdFragmentShader_ = {};
     computeShaderHandle_ = {};
     computePipelineHandle_ = {};
     tessellationUnsupported_ = false;
     destroyDepthTexture();
-    destroyPickTexture();
     return pipelineResult;
   }
 
@@ -3106,16 +3348,57 @@ Result<bool, std::string> OpaqueLayer::recreateDepthTexture() {
   return Result<bool, std::string>::makeResult(true);
 }
 
-Result<bool, std::string> OpaqueLayer::recreatePickTexture() {
-  if (nuri::isValid(pickIdTexture_)) {
-    gpu_.destroyTexture(pickIdTexture_);
-    pickIdTexture_ = TextureHandle{};
+void OpaqueLayer::readBackPick(RenderFrameContext &frame,
+                               const RenderGraphHistoryTexture &pickHistory) {
+  // previous only holds the pick frame's IDs when that frame immediately
+  // preceded this one.
+  if (!pickHistory.previousValid) {
+    NURI_LOG_WARNING("OpaqueLayer::readBackPick: pick target from frame %llu "
+                     "is no longer available",
+                     static_cast<unsigned long long>(
+                         inFlightPickReadback_->submissionFrame));
+    inFlightPickReadback_.reset();
+    return;
   }
 
-  const TextureDesc pickDesc{
+  NURI_PROFILER_ZONE("OpaqueLayer.pick_readback", NURI_PROFILER_COLOR_CMD_COPY);
+  std::array<std::byte, sizeof(uint32_t)> pickBytes{};
+  const TextureReadbackRegion readbackRegion{
+      .x = inFlightPickReadback_->request.x,
+      .y = inFlightPickReadback_->request.y,
+      .width = 1,
+      .height = 1,
+      .mipLevel = 0,
+      .layer = 0,
+  };
+  auto readResult =
+      gpu_.readTexture(pickHistory.previousTexture, readbackRegion, pickBytes);
+  if (readResult.hasError()) {
+    NURI_LOG_WARNING("OpaqueLayer::readBackPick: pick readback failed: %s",
+                     readResult.error().c_str());
+  } else {
+    uint32_t encodedId = 0;
+    std::memcpy(&encodedId, pickBytes.data(), sizeof(encodedId));
+    OpaquePickResult result{};
+    result.requestId = inFlightPickReadback_->request.requestId;
+    result.hit = encodedId > 0;
+    result.renderableIndex = result.hit ? (encodedId - 1u) : 0u;
+    frame.opaquePickResult = result;
+  }
+  inFlightPickReadback_.reset();
+  NURI_PROFILER_ZONE_END();
+}
+
+TextureDesc OpaqueLayer::pickHistoryDesc() const {
+  int32_t framebufferWidth = 0;
+  int32_t framebufferHeight = 0;
+  gpu_.getFramebufferSize(framebufferWidth, framebufferHeight);
+  return TextureDesc{
       .type = TextureType::Texture2D,
       .format = Format::R32_UINT,
-      .dimensions = {1, 1, 1},
+      .dimensions = {static_cast<uint32_t>(std::max(framebufferWidth, 1)),
+                     static_cast<uint32_t>(std::max(framebufferHeight, 1)),
+                     1},
       .usage = TextureUsage::Attachment,
       .storage = Storage::Device,
       .numLayers = 1,
@@ -3125,13 +3408,6 @@ Result<bool, std::string> OpaqueLayer::recreatePickTexture() {
       .dataNumMipLevels = 1,
       .generateMipmaps = false,
   };
-  auto pickResult =
-      gpu_.createFramebufferTexture(pickDesc, "opaque_pick_id_texture");
-  if (pickResult.hasError()) {
-    return Result<bool, std::string>::makeError(pickResult.error());
-  }
-  pickIdTexture_ = pickResult.value();
-  return Result<bool, std::string>::makeResult(true);
 }
 
 Result<bool, std::string>
@@ -3291,6 +3567,7 @@ OpaqueLayer::ensureRingBufferCount(uint32_t requiredCount) {
   indirectCommandRing_.resize(requiredCount);
   indirectUploadSignatures_.assign(requiredCount, kInvalidDrawSignature);
   remapUploadSignatures_.assign(requiredCount, kInvalidDrawSignature);
+  invalidateAnimationHistory();
   return Result<bool, std::string>::makeResult(true);
 }
 
@@ -3331,6 +3608,7 @@ OpaqueLayer::ensureInstanceMatricesRingCapacity(size_t requiredBytes) {
     }
     slot.buffer = std::move(createResult.value());
     slot.capacityBytes = requested;
+    invalidateAnimationHistory();
   }
   return Result<bool, std::string>::makeResult(true);
 }
@@ -3428,7 +3706,9 @@ OpaqueLayer::rebuildSceneCache(const RenderScene &scene,
                                const ResourceManager &resources,
                                uint32_t materialCount) {
   renderableTemplates_.clear();
+  dynamicInstanceIndices_.clear();
   meshDrawTemplates_.clear();
+  hasClusterLodTemplates_ = false;
 
   const std::span<const Renderable> renderables = scene.renderables();
   if (renderables.size() >
@@ -3480,10 +3760,17 @@ OpaqueLayer::rebuildSceneCache(const RenderScene &scene,
           "address");
     }
 
-    renderableTemplates_.push_back(
-        RenderableTemplate{.renderable = &renderable, .model = model});
+    renderableTemplates_.push_back(RenderableTemplate{
+        .renderable = &renderable,
+        .model = model,
+        .occluder = !model->occluderIndices().empty(),
+    });
+    if (renderable.mobility == RenderableMobility::Dynamic) {
+      dynamicInstanceIndices_.push_back(index);
+    }
 
     const std::span<const Submesh> submeshes = model->submeshes();
+    const std::span<const MeshCluster> modelClusters = model->clusters();
     for (size_t submeshIndex = 0; submeshIndex < submeshes.size();
          ++submeshIndex) {
       const MaterialRef resolvedModelMaterial =
@@ -3494,6 +3781,10 @@ OpaqueLayer::rebuildSceneCache(const RenderScene &scene,
       const MaterialRecord *materialRecord = resources.tryGet(resolvedMaterial);
       const bool doubleSided =
           materialRecord != nullptr && materialRecord->desc.doubleSided;
+      if (materialRecord != nullptr &&
+          materialRecord->desc.alphaMode != MaterialAlphaMode::Opaque) {
+        renderableTemplates_.back().occluder = false;
+      }
       if (materialRecord != nullptr &&
           materialRecord->desc.alphaMode == MaterialAlphaMode::Blend) {
         ++skippedBlendSubmeshCount;
@@ -3505,6 +3796,11 @@ OpaqueLayer::rebuildSceneCache(const RenderScene &scene,
         finalMaterialIndex = 0u;
         ++invalidMaterialFallbackCount;
       }
+      // Ranges were validated when the model was created.
+      const Submesh &submesh = submeshes[submeshIndex];
+      const std::span<const MeshCluster> clusters =
+          modelClusters.subspan(submesh.clusterOffset, submesh.clusterCount);
+      hasClusterLodTemplates_ = hasClusterLodTemplates_ || !clusters.empty();
       meshDrawTemplates_.push_back(MeshDrawTemplate{
           .renderable = &renderable,
           .submesh = &submeshes[submeshIndex],
@@ -3516,6 +3812,7 @@ OpaqueLayer::rebuildSceneCache(const RenderScene &scene,
           .vertexBufferAddress = vertexBufferAddress,
           .materialIndex = finalMaterialIndex,
           .doubleSided = doubleSided,
+          .clusters = clusters,
       });
     }
   }
@@ -3568,8 +3865,7 @@ Result<bool, std::string> OpaqueLayer::rebuildMaterialTextureAccessCache(
     return Result<bool, std::string>::makeResult(true);
   }
 
-  ScratchArena scratch;
-  ScopedScratch scopedScratch(scratch);
+  ScopedThreadScratch scopedScratch;
   PmrHashSet<uint64_t> textureKeys(scopedScratch.resource());
   textureKeys.reserve(renderables.size());
   materialTextureAccessHandles_.reserve(renderables.size());
@@ -3612,9 +3908,11 @@ Result<bool, std::string> OpaqueLayer::createShaders() {
   meshShader_ = Shader::create("main", gpu_);
   meshTessShader_ = Shader::create("main_tess", gpu_);
   meshDebugOverlayShader_ = Shader::create("mesh_debug_overlay", gpu_);
-  meshPickShader_ = Shader::create("main_id", gpu_);
+  meshPickShader_ = Shader::create("main_pick", gpu_);
+  meshIdShader_ = Shader::create("main_id", gpu_);
   computeShader_ = Shader::create("duck_instances", gpu_);
-  if (!meshShader_ || !meshTessShader_ || !meshPickShader_ || !computeShader_) {
+  if (!meshShader_ || !meshTessShader_ || !meshPickShader_ || !meshIdShader_ ||
+      !computeShader_) {
     return Result<bool, std::string>::makeError(
         "OpaqueLayer::createShaders: failed to create shader objects");
   }
@@ -3627,41 +3925,39 @@ Result<bool, std::string> OpaqueLayer::createShaders() {
   meshDebugOverlayGeometryShader_ = {};
   meshDebugOverlayFragmentShader_ = {};
   meshPickFragmentShader_ = {};
+  meshIdFragmentShader_ = {};
   computeShaderHandle_ = {};
   tessellationUnsupported_ = false;
   gsOverlayPipelineUnsupported_ = false;
   gsTessOverlayPipelineUnsupported_ = false;
 
-  struct ShaderSpec {
-    Shader *shader = nullptr;
-    const std::filesystem::path *path = nullptr;
-    ShaderStage stage = ShaderStage::Vertex;
-    ShaderHandle *outHandle = nullptr;
-  };
-  const std::array<ShaderSpec, 3> shaderSpecs = {
-      ShaderSpec{meshShader_.get(), &config_.meshVertex, ShaderStage::Vertex,
-                 &meshVertexShader_},
-      ShaderSpec{meshShader_.get(), &config_.meshFragment,
-                 ShaderStage::Fragment, &meshFragmentShader_},
-      ShaderSpec{computeShader_.get(), &config_.computeInstances,
-                 ShaderStage::Compute, &computeShaderHandle_},
-  };
-
-  for (const ShaderSpec &spec : shaderSpecs) {
-    if (!spec.shader || !spec.outHandle || !spec.path) {
-      return Result<bool, std::string>::makeError(
-          "OpaqueLayer::createShaders: invalid shader spec");
+  {
+    const std::string vertexPath = config_.meshVertex.string();
+    const std::string fragmentPath = config_.meshFragment.string();
+    const std::array<ShaderFile, 2> meshFiles = {
+        ShaderFile{vertexPath, ShaderStage::Vertex},
+        ShaderFile{fragmentPath, ShaderStage::Fragment},
+    };
+    auto meshResult = meshShader_->compileFromFiles(meshFiles);
+    if (meshResult.hasError()) {
+      return Result<bool, std::string>::makeError(meshResult.error());
     }
-    const std::string shaderPath = spec.path->string();
-    auto compileResult = spec.shader->compileFromFile(shaderPath, spec.stage);
-    if (compileResult.hasError()) {
-      return Result<bool, std::string>::makeError(compileResult.error());
+    meshVertexShader_ = meshResult.value()[0];
+    meshFragmentShader_ = meshResult.value()[1];
+
+    auto computeResult = computeShader_->compileFromFile(
+        config_.computeInstances.string(), ShaderStage::Compute);
+    if (computeResult.hasError()) {
+      return Result<bool, std::string>::makeError(computeResult.error());
     }
-    *spec.outHandle = compileResult.value();
+    computeShaderHandle_ = computeResult.value();
   }
 
   {
-    const std::string shaderPath = config_.pickFragment.string();
+    // The MRT pick variant includes main.frag, so it lives beside it.
+    const std::string shaderPath =
+        (config_.meshFragment.parent_path() / kOpaquePickFragmentShaderFile)
+            .string();
     auto compileResult =
         meshPickShader_->compileFromFile(shaderPath, ShaderStage::Fragment);
     if (compileResult.hasError()) {
@@ -3670,38 +3966,35 @@ Result<bool, std::string> OpaqueLayer::createShaders() {
     meshPickFragmentShader_ = compileResult.value();
   }
 
-  const std::array<ShaderSpec, 3> tessShaderSpecs = {
-      ShaderSpec{meshTessShader_.get(), &config_.tessVertex,
-                 ShaderStage::Vertex, &meshTessVertexShader_},
-      ShaderSpec{meshTessShader_.get(), &config_.tessControl,
-                 ShaderStage::TessControl, &meshTessControlShader_},
-      ShaderSpec{meshTessShader_.get(), &config_.tessEval,
-                 ShaderStage::TessEval, &meshTessEvalShader_},
-  };
-  for (const ShaderSpec &spec : tessShaderSpecs) {
-    if (!spec.shader || !spec.outHandle || !spec.path) {
-      tessellationUnsupported_ = true;
-      meshTessVertexShader_ = {};
-      meshTessControlShader_ = {};
-      meshTessEvalShader_ = {};
-      NURI_LOG_WARNING(
-          "OpaqueLayer::createShaders: invalid tessellation shader spec");
-      break;
+  {
+    auto compileResult = meshIdShader_->compileFromFile(
+        config_.pickFragment.string(), ShaderStage::Fragment);
+    if (compileResult.hasError()) {
+      return Result<bool, std::string>::makeError(compileResult.error());
     }
+    meshIdFragmentShader_ = compileResult.value();
+  }
 
-    const std::string shaderPath = spec.path->string();
-    auto compileResult = spec.shader->compileFromFile(shaderPath, spec.stage);
-    if (compileResult.hasError()) {
+  {
+    const std::string vertexPath = config_.tessVertex.string();
+    const std::string controlPath = config_.tessControl.string();
+    const std::string evalPath = config_.tessEval.string();
+    const std::array<ShaderFile, 3> tessFiles = {
+        ShaderFile{vertexPath, ShaderStage::Vertex},
+        ShaderFile{controlPath, ShaderStage::TessControl},
+        ShaderFile{evalPath, ShaderStage::TessEval},
+    };
+    auto tessResult = meshTessShader_->compileFromFiles(tessFiles);
+    if (tessResult.hasError()) {
       tessellationUnsupported_ = true;
-      meshTessVertexShader_ = {};
-      meshTessControlShader_ = {};
-      meshTessEvalShader_ = {};
-      NURI_LOG_WARNING("OpaqueLayer::createShaders: Tessellation shader path "
-                       "'%s' failed, fallback to non-tessellation path: %s",
-                       shaderPath.c_str(), compileResult.error().c_str());
-      break;
+      NURI_LOG_WARNING("OpaqueLayer::createShaders: Tessellation shaders "
+                       "failed, fallback to non-tessellation path: %s",
+                       tessResult.error().c_str());
+    } else {
+      meshTessVertexShader_ = tessResult.value()[0];
+      meshTessControlShader_ = tessResult.value()[1];
+      meshTessEvalShader_ = tessResult.value()[2];
     }
-    *spec.outHandle = compileResult.value();
   }
 
   if (!meshDebugOverlayShader_) {
@@ -3712,35 +4005,22 @@ Result<bool, std::string> OpaqueLayer::createShaders() {
     return Result<bool, std::string>::makeResult(true);
   }
 
-  const std::array<ShaderSpec, 2> overlayShaderSpecs = {
-      ShaderSpec{meshDebugOverlayShader_.get(), &config_.overlayGeometry,
-                 ShaderStage::Geometry, &meshDebugOverlayGeometryShader_},
-      ShaderSpec{meshDebugOverlayShader_.get(), &config_.overlayFragment,
-                 ShaderStage::Fragment, &meshDebugOverlayFragmentShader_},
+  const std::string geometryPath = config_.overlayGeometry.string();
+  const std::string fragmentPath = config_.overlayFragment.string();
+  const std::array<ShaderFile, 2> overlayFiles = {
+      ShaderFile{geometryPath, ShaderStage::Geometry},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
   };
-  for (const ShaderSpec &spec : overlayShaderSpecs) {
-    if (!spec.shader || !spec.outHandle || !spec.path) {
-      gsOverlayPipelineUnsupported_ = true;
-      gsTessOverlayPipelineUnsupported_ = true;
-      meshDebugOverlayGeometryShader_ = {};
-      meshDebugOverlayFragmentShader_ = {};
-      NURI_LOG_WARNING(
-          "OpaqueLayer::createShaders: invalid debug overlay shader spec");
-      break;
-    }
-    const std::string shaderPath = spec.path->string();
-    auto compileResult = spec.shader->compileFromFile(shaderPath, spec.stage);
-    if (compileResult.hasError()) {
-      gsOverlayPipelineUnsupported_ = true;
-      gsTessOverlayPipelineUnsupported_ = true;
-      meshDebugOverlayGeometryShader_ = {};
-      meshDebugOverlayFragmentShader_ = {};
-      NURI_LOG_WARNING("OpaqueLayer::createShaders: Debug overlay shader path "
-                       "'%s' failed, fallback to line pipelines: %s",
-                       shaderPath.c_str(), compileResult.error().c_str());
-      break;
-    }
-    *spec.outHandle = compileResult.value();
+  auto overlayResult = meshDebugOverlayShader_->compileFromFiles(overlayFiles);
+  if (overlayResult.hasError()) {
+    gsOverlayPipelineUnsupported_ = true;
+    gsTessOverlayPipelineUnsupported_ = true;
+    NURI_LOG_WARNING("OpaqueLayer::createShaders: Debug overlay shaders "
+                     "failed, fallback to line pipelines: %s",
+                     overlayResult.error().c_str());
+  } else {
+    meshDebugOverlayGeometryShader_ = overlayResult.value()[0];
+    meshDebugOverlayFragmentShader_ = overlayResult.value()[1];
   }
 
   return Result<bool, std::string>::makeResult(true);
@@ -3829,9 +4109,9 @@ Result<bool, std::string> OpaqueLayer::createPipelines() {
   }
 
   {
-    const RenderPipelineDesc pickDesc =
-        meshPipelineDesc(Format::R32_UINT, depthFormat, meshVertexShader_, {},
-                         {}, {}, meshPickFragmentShader_, PolygonMode::Fill);
+    const RenderPipelineDesc pickDesc = withPickIdAttachment(meshPipelineDesc(
+        gpu_.getSwapchainFormat(), depthFormat, meshVertexShader_, {}, {}, {},
+        meshPickFragmentShader_, PolygonMode::Fill));
     auto pickPipelineResult =
         gpu_.createRenderPipeline(pickDesc, "opaque_mesh_pick");
     if (pickPipelineResult.hasError()) {
@@ -3854,9 +4134,10 @@ Result<bool, std::string> OpaqueLayer::createPipelines() {
 
   {
     const RenderPipelineDesc doubleSidedPickDesc =
-        meshPipelineDesc(Format::R32_UINT, depthFormat, meshVertexShader_, {},
-                         {}, {}, meshPickFragmentShader_, PolygonMode::Fill,
-                         Topology::Triangle, 0, false, CullMode::None);
+        withPickIdAttachment(meshPipelineDesc(
+            gpu_.getSwapchainFormat(), depthFormat, meshVertexShader_, {}, {},
+            {}, meshPickFragmentShader_, PolygonMode::Fill, Topology::Triangle,
+            0, false, CullMode::None));
     auto doubleSidedPickResult = gpu_.createRenderPipeline(
         doubleSidedPickDesc, "opaque_mesh_pick_double_sided");
     if (doubleSidedPickResult.hasError()) {
@@ -3884,10 +4165,11 @@ Result<bool, std::string> OpaqueLayer::createPipelines() {
 
   if (canCreateTessPipeline) {
     const RenderPipelineDesc pickTessDesc =
-        meshPipelineDesc(Format::R32_UINT, depthFormat, meshTessVertexShader_,
-                         meshTessControlShader_, meshTessEvalShader_, {},
-                         meshPickFragmentShader_, PolygonMode::Fill,
-                         Topology::Patch, kTessellationPatchControlPoints);
+        withPickIdAttachment(meshPipelineDesc(
+            gpu_.getSwapchainFormat(), depthFormat, meshTessVertexShader_,
+            meshTessControlShader_, meshTessEvalShader_, {},
+            meshPickFragmentShader_, PolygonMode::Fill, Topology::Patch,
+            kTessellationPatchControlPoints));
     auto pickTessResult =
         gpu_.createRenderPipeline(pickTessDesc, "opaque_mesh_tess_pick");
     if (pickTessResult.hasError()) {
@@ -3900,11 +4182,12 @@ Result<bool, std::string> OpaqueLayer::createPipelines() {
       meshPickTessPipelineHandle_ = pickTessResult.value();
     }
     if (!tessellationUnsupported_) {
-      const RenderPipelineDesc doubleSidedPickTessDesc = meshPipelineDesc(
-          Format::R32_UINT, depthFormat, meshTessVertexShader_,
-          meshTessControlShader_, meshTessEvalShader_, {},
-          meshPickFragmentShader_, PolygonMode::Fill, Topology::Patch,
-          kTessellationPatchControlPoints, false, CullMode::None);
+      const RenderPipelineDesc doubleSidedPickTessDesc =
+          withPickIdAttachment(meshPipelineDesc(
+              gpu_.getSwapchainFormat(), depthFormat, meshTessVertexShader_,
+              meshTessControlShader_, meshTessEvalShader_, {},
+              meshPickFragmentShader_, PolygonMode::Fill, Topology::Patch,
+              kTessellationPatchControlPoints, false, CullMode::None));
       auto doubleSidedPickTessResult = gpu_.createRenderPipeline(
           doubleSidedPickTessDesc, "opaque_mesh_tess_pick_double_sided");
       if (doubleSidedPickTessResult.hasError()) {
@@ -3920,6 +4203,68 @@ Result<bool, std::string> OpaqueLayer::createPipelines() {
     }
   }
 
+  {
+    const RenderPipelineDesc idDesc =
+        meshPipelineDesc(Format::R32_UINT, depthFormat, meshVertexShader_, {},
+                         {}, {}, meshIdFragmentShader_, PolygonMode::Fill);
+    auto idPipelineResult = gpu_.createRenderPipeline(idDesc, "opaque_mesh_id");
+    if (idPipelineResult.hasError()) {
+      destroyMeshPipelineState();
+      return Result<bool, std::string>::makeError(idPipelineResult.error());
+    }
+    meshIdPipelineHandle_ = idPipelineResult.value();
+  }
+
+  {
+    const RenderPipelineDesc doubleSidedIdDesc =
+        meshPipelineDesc(Format::R32_UINT, depthFormat, meshVertexShader_, {},
+                         {}, {}, meshIdFragmentShader_, PolygonMode::Fill,
+                         Topology::Triangle, 0, false, CullMode::None);
+    auto doubleSidedIdResult = gpu_.createRenderPipeline(
+        doubleSidedIdDesc, "opaque_mesh_id_double_sided");
+    if (doubleSidedIdResult.hasError()) {
+      NURI_LOG_WARNING("OpaqueLayer::createPipelines: double-sided ID "
+                       "pipeline failed, falling back to single-sided: %s",
+                       doubleSidedIdResult.error().c_str());
+    } else {
+      meshIdDoubleSidedPipelineHandle_ = doubleSidedIdResult.value();
+    }
+  }
+
+  if (canCreateTessPipeline) {
+    const RenderPipelineDesc idTessDesc = meshPipelineDesc(
+        Format::R32_UINT, depthFormat, meshTessVertexShader_,
+        meshTessControlShader_, meshTessEvalShader_, {}, meshIdFragmentShader_,
+        PolygonMode::Fill, Topology::Patch, kTessellationPatchControlPoints);
+    auto idTessResult =
+        gpu_.createRenderPipeline(idTessDesc, "opaque_mesh_tess_id");
+    if (idTessResult.hasError()) {
+      NURI_LOG_WARNING(
+          "OpaqueLayer::createPipelines: tessellation ID pipeline failed, "
+          "falling back to non-tessellation ID pipeline: %s",
+          idTessResult.error().c_str());
+    } else {
+      meshIdTessPipelineHandle_ = idTessResult.value();
+    }
+    if (!tessellationUnsupported_) {
+      const RenderPipelineDesc doubleSidedIdTessDesc = meshPipelineDesc(
+          Format::R32_UINT, depthFormat, meshTessVertexShader_,
+          meshTessControlShader_, meshTessEvalShader_, {},
+          meshIdFragmentShader_, PolygonMode::Fill, Topology::Patch,
+          kTessellationPatchControlPoints, false, CullMode::None);
+      auto doubleSidedIdTessResult = gpu_.createRenderPipeline(
+          doubleSidedIdTessDesc, "opaque_mesh_tess_id_double_sided");
+      if (doubleSidedIdTessResult.hasError()) {
+        NURI_LOG_WARNING("OpaqueLayer::createPipelines: double-sided "
+                         "tessellation ID pipeline failed, falling back to "
+                         "non-tessellation ID pipeline: %s",
+                         doubleSidedIdTessResult.error().c_str());
+      } else {
+        meshIdDoubleSidedTessPipelineHandle_ = doubleSidedIdTessResult.value();
+      }
+    }
+  }
+
   const ComputePipelineDesc computeDesc{
       .computeShader = computeShaderHandle_,
   };
@@ -3952,21 +4297,30 @@ RenderPipelineHandle OpaqueLayer::selectMeshPipeline(bool doubleSided,
 }
 
 RenderPipelineHandle
-OpaqueLayer::selectPickPipeline(RenderPipelineHandle sourcePipeline) const {
+OpaqueLayer::selectPickPipeline(RenderPipelineHandle sourcePipeline,
+                                bool idOnly) const {
   const bool tessellated = isTessPipeline(sourcePipeline);
   const bool doubleSided = isDoubleSidedPipeline(sourcePipeline);
+  const RenderPipelineHandle doubleSidedTess =
+      idOnly ? meshIdDoubleSidedTessPipelineHandle_
+             : meshPickDoubleSidedTessPipelineHandle_;
+  const RenderPipelineHandle tess =
+      idOnly ? meshIdTessPipelineHandle_ : meshPickTessPipelineHandle_;
+  const RenderPipelineHandle doubleSidedFill =
+      idOnly ? meshIdDoubleSidedPipelineHandle_
+             : meshPickDoubleSidedPipelineHandle_;
   if (tessellated) {
-    if (doubleSided && nuri::isValid(meshPickDoubleSidedTessPipelineHandle_)) {
-      return meshPickDoubleSidedTessPipelineHandle_;
+    if (doubleSided && nuri::isValid(doubleSidedTess)) {
+      return doubleSidedTess;
     }
-    if (nuri::isValid(meshPickTessPipelineHandle_)) {
-      return meshPickTessPipelineHandle_;
+    if (nuri::isValid(tess)) {
+      return tess;
     }
   }
-  if (doubleSided && nuri::isValid(meshPickDoubleSidedPipelineHandle_)) {
-    return meshPickDoubleSidedPipelineHandle_;
+  if (doubleSided && nuri::isValid(doubleSidedFill)) {
+    return doubleSidedFill;
   }
-  return meshPickPipelineHandle_;
+  return idOnly ? meshIdPipelineHandle_ : meshPickPipelineHandle_;
 }
 
 bool OpaqueLayer::isDoubleSidedPipeline(RenderPipelineHandle handle) const {
@@ -3979,7 +4333,8 @@ bool OpaqueLayer::isTessPipeline(RenderPipelineHandle handle) const {
          isSamePipelineHandle(handle, meshDoubleSidedTessPipelineHandle_);
 }
 
-Result<bool, std::string> OpaqueLayer::ensureWireframePipeline() {
+Result<bool, std::string>
+OpaqueLayer::ensureWireframePipeline(PipelineManager *pipelines) {
   if (wireframePipelineInitialized_ &&
       nuri::isValid(meshWireframePipelineHandle_)) {
     return Result<bool, std::string>::makeResult(true);
@@ -4000,7 +4355,8 @@ Result<bool, std::string> OpaqueLayer::ensureWireframePipeline() {
       meshFragmentShader_, PolygonMode::Line, Topology::Triangle, 0, true);
 
   auto pipelineResult =
-      gpu_.createRenderPipeline(wireframeDesc, "opaque_mesh_wireframe");
+      acquireOverlayPipeline(pipelines, wireframeDesc, kWireframePipelineName,
+                             meshWireframePipelineHandle_);
   if (pipelineResult.hasError()) {
     wireframePipelineUnsupported_ = true;
     if (!loggedWireframeFallbackUnsupported_) {
@@ -4011,7 +4367,9 @@ Result<bool, std::string> OpaqueLayer::ensureWireframePipeline() {
     return Result<bool, std::string>::makeResult(false);
   }
 
-  meshWireframePipelineHandle_ = pipelineResult.value();
+  if (!pipelineResult.value()) {
+    return Result<bool, std::string>::makeResult(false);
+  }
   wireframePipelineInitialized_ = true;
 
   baseMeshWireframeDraw_ = baseMeshFillDraw_;
@@ -4021,7 +4379,8 @@ Result<bool, std::string> OpaqueLayer::ensureWireframePipeline() {
   return Result<bool, std::string>::makeResult(true);
 }
 
-Result<bool, std::string> OpaqueLayer::ensureTessWireframePipeline() {
+Result<bool, std::string>
+OpaqueLayer::ensureTessWireframePipeline(PipelineManager *pipelines) {
   if (tessWireframePipelineInitialized_ &&
       nuri::isValid(meshTessWireframePipelineHandle_)) {
     return Result<bool, std::string>::makeResult(true);
@@ -4042,8 +4401,9 @@ Result<bool, std::string> OpaqueLayer::ensureTessWireframePipeline() {
       PolygonMode::Line, Topology::Patch, kTessellationPatchControlPoints,
       true);
 
-  auto pipelineResult =
-      gpu_.createRenderPipeline(wireframeDesc, "opaque_mesh_tess_wireframe");
+  auto pipelineResult = acquireOverlayPipeline(
+      pipelines, wireframeDesc, kTessWireframePipelineName,
+      meshTessWireframePipelineHandle_);
   if (pipelineResult.hasError()) {
     tessWireframePipelineUnsupported_ = true;
     if (!loggedTessWireframeFallbackUnsupported_) {
@@ -4054,13 +4414,16 @@ Result<bool, std::string> OpaqueLayer::ensureTessWireframePipeline() {
     return Result<bool, std::string>::makeResult(false);
   }
 
-  meshTessWireframePipelineHandle_ = pipelineResult.value();
+  if (!pipelineResult.value()) {
+    return Result<bool, std::string>::makeResult(false);
+  }
   tessWireframePipelineInitialized_ = true;
 
   return Result<bool, std::string>::makeResult(true);
 }
 
-Result<bool, std::string> OpaqueLayer::ensureGsOverlayPipeline() {
+Result<bool, std::string>
+OpaqueLayer::ensureGsOverlayPipeline(PipelineManager *pipelines) {
   if (gsOverlayPipelineInitialized_ &&
       nuri::isValid(meshGsOverlayPipelineHandle_)) {
     return Result<bool, std::string>::makeResult(true);
@@ -4088,7 +4451,8 @@ Result<bool, std::string> OpaqueLayer::ensureGsOverlayPipeline() {
       PolygonMode::Fill, Topology::Triangle, 0, true);
 
   auto pipelineResult =
-      gpu_.createRenderPipeline(overlayDesc, "opaque_mesh_overlay_gs");
+      acquireOverlayPipeline(pipelines, overlayDesc, kGsOverlayPipelineName,
+                             meshGsOverlayPipelineHandle_);
   if (pipelineResult.hasError()) {
     gsOverlayPipelineUnsupported_ = true;
     if (!loggedGsOverlayUnsupported_) {
@@ -4099,12 +4463,15 @@ Result<bool, std::string> OpaqueLayer::ensureGsOverlayPipeline() {
     return Result<bool, std::string>::makeResult(false);
   }
 
-  meshGsOverlayPipelineHandle_ = pipelineResult.value();
+  if (!pipelineResult.value()) {
+    return Result<bool, std::string>::makeResult(false);
+  }
   gsOverlayPipelineInitialized_ = true;
   return Result<bool, std::string>::makeResult(true);
 }
 
-Result<bool, std::string> OpaqueLayer::ensureGsTessOverlayPipeline() {
+Result<bool, std::string>
+OpaqueLayer::ensureGsTessOverlayPipeline(PipelineManager *pipelines) {
   if (gsTessOverlayPipelineInitialized_ &&
       nuri::isValid(meshGsTessOverlayPipelineHandle_)) {
     return Result<bool, std::string>::makeResult(true);
@@ -4137,8 +4504,9 @@ Result<bool, std::string> OpaqueLayer::ensureGsTessOverlayPipeline() {
                        meshDebugOverlayFragmentShader_, PolygonMode::Fill,
                        Topology::Patch, kTessellationPatchControlPoints, true);
 
-  auto pipelineResult =
-      gpu_.createRenderPipeline(overlayDesc, "opaque_mesh_tess_overlay_gs");
+  auto pipelineResult = acquireOverlayPipeline(
+      pipelines, overlayDesc, kGsTessOverlayPipelineName,
+      meshGsTessOverlayPipelineHandle_);
   if (pipelineResult.hasError()) {
     gsTessOverlayPipelineUnsupported_ = true;
     if (!loggedGsTessOverlayUnsupported_) {
@@ -4149,23 +4517,59 @@ Result<bool, std::string> OpaqueLayer::ensureGsTessOverlayPipeline() {
     return Result<bool, std::string>::makeResult(false);
   }
 
-  meshGsTessOverlayPipelineHandle_ = pipelineResult.value();
+  if (!pipelineResult.value()) {
+    return Result<bool, std::string>::makeResult(false);
+  }
   gsTessOverlayPipelineInitialized_ = true;
   return Result<bool, std::string>::makeResult(true);
 }
 
-void OpaqueLayer::resetOverlayPipelineState() {
-  if (nuri::isValid(meshGsOverlayPipelineHandle_)) {
-    gpu_.destroyRenderPipeline(meshGsOverlayPipelineHandle_);
-  }
-  if (nuri::isValid(meshGsTessOverlayPipelineHandle_)) {
-    gpu_.destroyRenderPipeline(meshGsTessOverlayPipelineHandle_);
+Result<bool, std::string> OpaqueLayer::acquireOverlayPipeline(
+    PipelineManager *pipelines, const RenderPipelineDesc &desc,
+    std::string_view debugName, RenderPipelineHandle &outHandle) {
+  if (pipelines == nullptr) {
+    auto pipelineResult = gpu_.createRenderPipeline(desc, debugName);
+    if (pipelineResult.hasError()) {
+      return Result<bool, std::string>::makeError(pipelineResult.error());
+    }
+    outHandle = pipelineResult.value();
+    return Result<bool, std::string>::makeResult(true);
   }
-  if (nuri::isValid(meshWireframePipelineHandle_)) {
-    gpu_.destroyRenderPipeline(meshWireframePipelineHandle_);
+
+  // Debug views are toggled at runtime, so they compile in the background
+  // and the overlay is dropped (or falls back to lines) until they are ready.
+  const PipelineRequest request{.desc = desc,
+                                .debugName = debugName,
+                                .policy = PipelineFallbackPolicy::Skip};
+  auto lookupResult =
+      pipelines->acquire(PipelineManager::makeKey(this, debugName), request);
+  if (lookupResult.hasError()) {
+    return Result<bool, std::string>::makeError(lookupResult.error());
   }
-  if (nuri::isValid(meshTessWireframePipelineHandle_)) {
-    gpu_.destroyRenderPipeline(meshTessWireframePipelineHandle_);
+  overlayPipelineManager_ = pipelines;
+  outHandle = lookupResult.value().handle;
+  return Result<bool, std::string>::makeResult(nuri::isValid(outHandle));
+}
+
+void OpaqueLayer::resetOverlayPipelineState() {
+  if (overlayPipelineManager_ != nullptr) {
+    for (const std::string_view name : kOverlayPipelineNames) {
+      overlayPipelineManager_->release(PipelineManager::makeKey(this, name));
+    }
+    overlayPipelineManager_ = nullptr;
+  } else {
+    if (nuri::isValid(meshGsOverlayPipelineHandle_)) {
+      gpu_.destroyRenderPipeline(meshGsOverlayPipelineHandle_);
+    }
+    if (nuri::isValid(meshGsTessOverlayPipelineHandle_)) {
+      gpu_.destroyRenderPipeline(meshGsTessOverlayPipelineHandle_);
+    }
+    if (nuri::isValid(meshWireframePipelineHandle_)) {
+      gpu_.destroyRenderPipeline(meshWireframePipelineHandle_);
+    }
+    if (nuri::isValid(meshTessWireframePipelineHandle_)) {
+      gpu_.destroyRenderPipeline(meshTessWireframePipelineHandle_);
+    }
   }
   meshGsOverlayPipelineHandle_ = {};
   meshGsTessOverlayPipelineHandle_ = {};
@@ -4186,6 +4590,67 @@ void OpaqueLayer::resetOverlayPipelineState() {
   baseMeshWireframeDraw_ = {};
 }
 
+void OpaqueLayer::updateOcclusionVisibility(const RenderFrameContext &frame,
+                                            const RenderSettings &settings) {
+  occludedInstanceCount_ = 0;
+  const size_t instanceCount = renderableTemplates_.size();
+  const bool enabled = settings.opaque.enableOcclusionCulling &&
+                       !settings.opaque.enableInstanceAnimation &&
+                       instanceCount > 1u &&
+                       instanceWorldBounds_.size() == instanceCount &&
+                       instanceLodCentersInvRadiusSq_.size() == instanceCount;
+  if (!enabled) {
+    instanceOccluded_.clear();
+    return;
+  }
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CMD_DRAW);
+
+  const glm::vec3 cameraPosition = glm::vec3(frame.camera.cameraPos);
+  const auto normalizedDistanceSq = [&](uint32_t instanceIndex) {
+    const glm::vec4 lodCache = instanceLodCentersInvRadiusSq_[instanceIndex];
+    const glm::vec3 delta = cameraPosition - glm::vec3(lodCache);
+    return glm::dot(delta, delta) * lodCache.w;
+  };
+  occluderCandidates_.clear();
+  for (uint32_t i = 0; i < static_cast<uint32_t>(instanceCount); ++i) {
+    if (renderableTemplates_[i].occluder &&
+        normalizedDistanceSq(i) < kOccluderMaxNormalizedDistanceSq) {
+      occluderCandidates_.push_back(i);
+    }
+  }
+  if (occluderCandidates_.size() > kMaxOccludersPerFrame) {
+    std::nth_element(occluderCandidates_.begin(),
+                     occluderCandidates_.begin() + kMaxOccludersPerFrame,
+                     occluderCandidates_.end(),
+                     [&](uint32_t a, uint32_t b) {
+                       return normalizedDistanceSq(a) <
+                              normalizedDistanceSq(b);
+                     });
+    occluderCandidates_.resize(kMaxOccludersPerFrame);
+  }
+
+  if (!occlusionCuller_) {
+    occlusionCuller_ = std::make_unique<SoftwareOcclusionCuller>(
+        SoftwareOcclusionConfig{},
+        instanceOccluded_.get_allocator().resource());
+  }
+  SoftwareOcclusionCuller &culler = *occlusionCuller_;
+  culler.beginFrame(frame.camera.proj * frame.camera.view);
+  for (const uint32_t instanceIndex : occluderCandidates_) {
+    const RenderableTemplate &templ = renderableTemplates_[instanceIndex];
+    culler.addOccluder(templ.model->occluderPositions(),
+                       templ.model->occluderIndices(),
+                       templ.renderable->modelMatrix);
+  }
+  culler.rasterize();
+
+  instanceOccluded_.assign(instanceCount, 0u);
+  if (culler.stats().rasterizedTriangles > 0u) {
+    culler.testOcclusion(instanceWorldBounds_, instanceOccluded_);
+    occludedInstanceCount_ = culler.stats().occludedBounds;
+  }
+}
+
 void OpaqueLayer::invalidateAutoLodCache() {
   autoLodCache_.valid = false;
   autoLodCache_.remapCount = 0;
@@ -4195,6 +4660,144 @@ void OpaqueLayer::invalidateAutoLodCache() {
   autoLodCache_.bucketCounts.fill(0);
 }
 
+Result<bool, std::string>
+OpaqueLayer::rebuildInstanceTransforms(bool animateInstances) {
+  const size_t instanceCount = renderableTemplates_.size();
+  instanceCentersPhase_.resize(instanceCount);
+  instanceBaseMatrices_.resize(instanceCount);
+  instanceLodCentersInvRadiusSq_.resize(instanceCount);
+  instanceWorldBounds_.resize(instanceCount);
+  for (size_t i = 0; i < instanceCount; ++i) {
+    const RenderableTemplate &templ = renderableTemplates_[i];
+    if (!templ.renderable || !templ.model) {
+      return Result<bool, std::string>::makeError(
+          "OpaqueLayer::rebuildInstanceTransforms: invalid opaque renderable");
+    }
+    writeInstanceTransformState(i, *templ.renderable, *templ.model,
+                                animateInstances);
+  }
+
+  // Base matrices carry no translation, so they decide whether every
+  // animated or translated instance transform fits the compact encoding.
+  instanceTransformEncoding_ =
+      selectInstanceTransformEncoding(instanceBaseMatrices_);
+  instanceBaseTransformsPacked_.resize(
+      instanceCount * instanceTransformStride(instanceTransformEncoding_));
+  packInstanceTransforms(instanceBaseMatrices_, instanceTransformEncoding_,
+                         instanceBaseTransformsPacked_);
+
+  instanceStaticBuffersDirty_ = true;
+  return Result<bool, std::string>::makeResult(true);
+}
+
+bool OpaqueLayer::refreshDynamicInstanceTransforms(bool animateInstances) {
+  const size_t instanceCount = renderableTemplates_.size();
+  if (instanceBaseMatrices_.size() != instanceCount ||
+      instanceBaseTransformsPacked_.size() !=
+          instanceCount * instanceTransformStride(instanceTransformEncoding_)) {
+    return false;
+  }
+  // A dynamic instance that gains shear no longer fits CompactTrs; the full
+  // rebuild picks a wider encoding for everyone.
+  if (instanceTransformEncoding_ == InstanceTransformEncoding::CompactTrs) {
+    for (const uint32_t instanceIndex : dynamicInstanceIndices_) {
+      glm::mat4 baseMatrix =
+          renderableTemplates_[instanceIndex].renderable->modelMatrix;
+      baseMatrix[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+      if (!packInstanceTrs(baseMatrix).has_value()) {
+        return false;
+      }
+    }
+  }
+
+  const size_t stride = instanceTransformStride(instanceTransformEncoding_);
+  for (const uint32_t instanceIndex : dynamicInstanceIndices_) {
+    const RenderableTemplate &templ = renderableTemplates_[instanceIndex];
+    if (!templ.renderable || !templ.model) {
+      return false;
+    }
+    writeInstanceTransformState(instanceIndex, *templ.renderable,
+                                *templ.model, animateInstances);
+    packInstanceTransforms(
+        std::span<const glm::mat4>(&instanceBaseMatrices_[instanceIndex], 1u),
+        instanceTransformEncoding_,
+        std::span<std::byte>(instanceBaseTransformsPacked_)
+            .subspan(instanceIndex * stride, stride));
+  }
+  instanceDynamicBuffersDirty_ = !dynamicInstanceIndices_.empty();
+  return true;
+}
+
+void OpaqueLayer::writeInstanceTransformState(size_t instanceIndex,
+                                              const Renderable &renderable,
+                                              const Model &model,
+                                              bool animateInstances) {
+  const glm::vec3 center = glm::vec3(renderable.modelMatrix[3]);
+  instanceCentersPhase_[instanceIndex] = glm::vec4(
+      center, animateInstances
+                  ? deterministicPhase(static_cast<uint32_t>(instanceIndex))
+                  : 0.0f);
+  glm::mat4 baseMatrix = renderable.modelMatrix;
+  baseMatrix[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+  instanceBaseMatrices_[instanceIndex] = baseMatrix;
+
+  const BoundingBox &bounds = model.bounds();
+  const glm::vec3 localCenter = bounds.getCenter();
+  const float localRadius = kBoundsRadiusHalf * glm::length(bounds.getSize());
+  const glm::vec3 worldCenter =
+      glm::vec3(renderable.modelMatrix * glm::vec4(localCenter, 1.0f));
+  const float worldRadius = std::max(
+      localRadius * maxAxisScale(renderable.modelMatrix), kMinLodRadius);
+  const float invRadiusSq = 1.0f / (worldRadius * worldRadius);
+  instanceLodCentersInvRadiusSq_[instanceIndex] =
+      glm::vec4(worldCenter, invRadiusSq);
+  instanceWorldBounds_[instanceIndex] =
+      bounds.getTransformed(renderable.modelMatrix);
+}
+
+// Uploads contiguous runs of dynamic slots; the static slots stay resident.
+Result<bool, std::string> OpaqueLayer::uploadDynamicInstanceTransforms() {
+  const size_t stride = instanceTransformStride(instanceTransformEncoding_);
+  const std::span<const std::byte> centersBytes =
+      std::as_bytes(std::span<const glm::vec4>(instanceCentersPhase_));
+  const std::span<const std::byte> transformBytes(
+      instanceBaseTransformsPacked_);
+  size_t runBegin = 0;
+  while (runBegin < dynamicInstanceIndices_.size()) {
+    size_t runEnd = runBegin + 1;
+    while (runEnd < dynamicInstanceIndices_.size() &&
+           dynamicInstanceIndices_[runEnd] ==
+               dynamicInstanceIndices_[runEnd - 1] + 1u) {
+      ++runEnd;
+    }
+    const size_t first = dynamicInstanceIndices_[runBegin];
+    const size_t count = runEnd - runBegin;
+
+    auto centersResult = gpu_.updateBuffer(
+        instanceCentersPhaseBuffer_->handle(),
+        centersBytes.subspan(first * sizeof(glm::vec4),
+                             count * sizeof(glm::vec4)),
+        first * sizeof(glm::vec4));
+    if (centersResult.hasError()) {
+      return centersResult;
+    }
+    auto transformResult = gpu_.updateBuffer(
+        instanceBaseMatricesBuffer_->handle(),
+        transformBytes.subspan(first * stride, count * stride),
+        first * stride);
+    if (transformResult.hasError()) {
+      return transformResult;
+    }
+    runBegin = runEnd;
+  }
+  instanceDynamicBuffersDirty_ = false;
+  return Result<bool, std::string>::makeResult(true);
+}
+
+void OpaqueLayer::invalidateAnimationHistory() {
+  animationHistoryFrameIndex_ = std::numeric_limits<uint64_t>::max();
+}
+
 void OpaqueLayer::invalidateSingleInstanceBatchCache() {
   ++singleInstanceTemplateRevision_;
   if (singleInstanceTemplateRevision_ == 0) {
@@ -4225,6 +4828,10 @@ void OpaqueLayer::invalidateIndirectPackCache() {
 }
 
 void OpaqueLayer::destroyMeshPipelineState() {
+  destroyPipelineHandle(gpu_, meshIdDoubleSidedTessPipelineHandle_);
+  destroyPipelineHandle(gpu_, meshIdTessPipelineHandle_);
+  destroyPipelineHandle(gpu_, meshIdDoubleSidedPipelineHandle_);
+  destroyPipelineHandle(gpu_, meshIdPipelineHandle_);
   destroyPipelineHandle(gpu_, meshPickDoubleSidedTessPipelineHandle_);
   destroyPipelineHandle(gpu_, meshPickTessPipelineHandle_);
   destroyPipelineHandle(gpu_, meshPickDoubleSidedPipelineHandle_);
@@ -4244,6 +4851,10 @@ void OpaqueLayer::resetMeshPipelineState() {
   meshPickDoubleSidedPipelineHandle_ = {};
   meshPickTessPipelineHandle_ = {};
   meshPickDoubleSidedTessPipelineHandle_ = {};
+  meshIdPipelineHandle_ = {};
+  meshIdDoubleSidedPipelineHandle_ = {};
+  meshIdTessPipelineHandle_ = {};
+  meshIdDoubleSidedTessPipelineHandle_ = {};
   baseMeshFillDraw_ = {};
 }
 
@@ -4274,13 +4885,6 @@ void OpaqueLayer::destroyDepthTexture() {
   }
 }
 
-void OpaqueLayer::destroyPickTexture() {
-  if (nuri::isValid(pickIdTexture_)) {
-    gpu_.destroyTexture(pickIdTexture_);
-    pickIdTexture_ = TextureHandle{};
-  }
-}
-
 void OpaqueLayer::destroyBuffers() {
   if (frameDataBuffer_ && frameDataBuffer_->valid()) {
     gpu_.destroyBuffer(frameDataBuffer_->handle());
@@ -3,9 +3,12 @@
 #include "nuri/core/layer.h"
 #include "nuri/core/runtime_config.h"
 #include "nuri/defines.h"
+#include "nuri/gfx/draw_stream.h"
 #include "nuri/gfx/gpu_device.h"
+#include "nuri/gfx/instance_transform.h"
 #include "nuri/gfx/pipeline.h"
 #include "nuri/gfx/shader.h"
+#include "nuri/gfx/software_occlusion.h"
 #include "nuri/resources/cpu/mesh_data.h"
 #include "nuri/resources/gpu/buffer.h"
 #include "nuri/resources/gpu/material.h"
@@ -26,6 +29,7 @@
 namespace nuri {
 
 using OpaqueLayerConfig = RuntimeOpaqueShaderConfig;
+class PipelineManager;
 class ResourceManager;
 
 class NURI_API OpaqueLayer final : public Layer {
@@ -60,6 +64,7 @@ private:
     HasIblSheen = 1u << 2u,
     HasBrdfLut = 1u << 3u,
     OutputLinearToSrgb = 1u << 4u,
+    HasIrradianceVolume = 1u << 5u,
   };
 
   struct FrameData {
@@ -74,8 +79,13 @@ private:
     uint32_t brdfLutTexId = 0;
     uint32_t flags = 0;
     uint32_t cubemapSamplerId = 0;
+    // Baked irradiance volume: world-space min, 1 / extent, and
+    // (texture, probe count x, y, z).
+    glm::vec4 irradianceVolumeMin{0.0f};
+    glm::vec4 irradianceVolumeInvExtent{0.0f};
+    glm::uvec4 irradianceVolumeInfo{0u};
   };
-  static_assert(sizeof(FrameData) == 176,
+  static_assert(sizeof(FrameData) == 224,
                 "OpaqueLayer::FrameData must match shader FrameDataBuffer "
                 "layout");
 
@@ -95,6 +105,12 @@ private:
     float tessMinFactor = 1.0f;
     float tessMaxFactor = 6.0f;
     uint32_t debugVisualizationMode = 0;
+    uint32_t instanceTransformEncoding = 0;
+    uint32_t animationFrameIndex = 0;
+    // Zero unless the compute pass may skip far instances this frame.
+    uint64_t previousInstanceMatricesAddress = 0;
+    float animationFullRateDistance = 0.0f;
+    uint32_t animationMaxUpdatePeriod = 1;
   };
   static_assert(sizeof(PushConstants) <= 128,
                 "OpaqueLayer::PushConstants exceeds Vulkan minimum guarantee");
@@ -102,6 +118,8 @@ private:
   struct RenderableTemplate {
     const Renderable *renderable = nullptr;
     const Model *model = nullptr;
+    // Has an occluder mesh and no alpha-tested or blended submeshes.
+    bool occluder = false;
   };
 
   struct MeshDrawTemplate {
@@ -115,6 +133,14 @@ private:
     uint64_t vertexBufferAddress = 0;
     uint32_t materialIndex = kInvalidMaterialIndex;
     bool doubleSided = false;
+    // Cluster LOD hierarchy of the submesh; empty when it has none.
+    std::span<const MeshCluster> clusters{};
+  };
+
+  // Instance drawn by a batch built from selected clusters.
+  struct ClusterBatchRef {
+    uint32_t batchIndex = 0;
+    uint32_t instanceIndex = 0;
   };
 
   struct TessCandidate {
@@ -154,11 +180,15 @@ private:
     RenderGraphGraphicsPassDesc desc{};
     TextureHandle colorTextureHandle{};
     TextureHandle depthTextureHandle{};
+    // Binds the pick history texture as color attachment 1 so pick IDs come
+    // out of the same draws.
+    bool writesPickId = false;
     bool hasDraws = false;
     bool hasPreDispatch = false;
     bool hasIndirectDraws = false;
     bool isMainPass = false;
     bool isPickPass = false;
+    bool isOverlayPass = false;
   };
 
   struct IndirectPackCache {
@@ -169,7 +199,9 @@ private:
 
   Result<bool, std::string> ensureInitialized();
   Result<bool, std::string> recreateDepthTexture();
-  Result<bool, std::string> recreatePickTexture();
+  [[nodiscard]] TextureDesc pickHistoryDesc() const;
+  void readBackPick(RenderFrameContext &frame,
+                    const RenderGraphHistoryTexture &pickHistory);
   Result<bool, std::string> ensureFrameDataBufferCapacity(size_t requiredBytes);
   Result<bool, std::string>
   ensureCentersPhaseBufferCapacity(size_t requiredBytes);
@@ -219,16 +251,33 @@ private:
                     std::pmr::vector<PreparedGraphPass> &out);
   [[nodiscard]] RenderPipelineHandle selectMeshPipeline(bool doubleSided,
                                                         bool tessellated) const;
+  // idOnly selects the single-target R32_UINT variants used by the ID
+  // prepass instead of the MRT pick pipelines.
   [[nodiscard]] RenderPipelineHandle
-  selectPickPipeline(RenderPipelineHandle sourcePipeline) const;
+  selectPickPipeline(RenderPipelineHandle sourcePipeline, bool idOnly) const;
   [[nodiscard]] bool isDoubleSidedPipeline(RenderPipelineHandle handle) const;
   [[nodiscard]] bool isTessPipeline(RenderPipelineHandle handle) const;
-  Result<bool, std::string> ensureWireframePipeline();
-  Result<bool, std::string> ensureTessWireframePipeline();
-  Result<bool, std::string> ensureGsOverlayPipeline();
-  Result<bool, std::string> ensureGsTessOverlayPipeline();
+  // Debug overlay pipelines; false means unavailable or still compiling.
+  Result<bool, std::string> acquireOverlayPipeline(
+      PipelineManager *pipelines, const RenderPipelineDesc &desc,
+      std::string_view debugName, RenderPipelineHandle &outHandle);
+  Result<bool, std::string> ensureWireframePipeline(PipelineManager *pipelines);
+  Result<bool, std::string>
+  ensureTessWireframePipeline(PipelineManager *pipelines);
+  Result<bool, std::string> ensureGsOverlayPipeline(PipelineManager *pipelines);
+  Result<bool, std::string>
+  ensureGsTessOverlayPipeline(PipelineManager *pipelines);
   void resetOverlayPipelineState();
   void invalidateAutoLodCache();
+  void invalidateAnimationHistory();
+  Result<bool, std::string> rebuildInstanceTransforms(bool animateInstances);
+  [[nodiscard]] bool refreshDynamicInstanceTransforms(bool animateInstances);
+  void writeInstanceTransformState(size_t instanceIndex,
+                                   const Renderable &renderable,
+                                   const Model &model, bool animateInstances);
+  Result<bool, std::string> uploadDynamicInstanceTransforms();
+  void updateOcclusionVisibility(const RenderFrameContext &frame,
+                                 const RenderSettings &settings);
   void updateFastAutoLodCache(
       const Submesh *submesh, const glm::vec3 &cameraPosition,
       const std::array<float, 3> &sortedLodThresholds,
@@ -240,7 +289,6 @@ private:
   void destroyMeshPipelineState();
   void resetMeshPipelineState();
   void destroyDepthTexture();
-  void destroyPickTexture();
   void destroyBuffers();
 
   GPUDevice &gpu_;
@@ -249,6 +297,7 @@ private:
   std::unique_ptr<Shader> meshTessShader_;
   std::unique_ptr<Shader> meshDebugOverlayShader_;
   std::unique_ptr<Shader> meshPickShader_;
+  std::unique_ptr<Shader> meshIdShader_;
   std::unique_ptr<Shader> computeShader_;
   std::unique_ptr<Pipeline> meshPipeline_;
   std::unique_ptr<Pipeline> computePipeline_;
@@ -260,7 +309,6 @@ private:
   std::pmr::vector<DynamicBufferSlot> instanceRemapRing_;
   std::pmr::vector<DynamicBufferSlot> indirectCommandRing_;
   TextureHandle depthTexture_{};
-  TextureHandle pickIdTexture_{};
 
   ShaderHandle meshVertexShader_{};
   ShaderHandle meshTessVertexShader_{};
@@ -270,6 +318,7 @@ private:
   ShaderHandle meshDebugOverlayGeometryShader_{};
   ShaderHandle meshDebugOverlayFragmentShader_{};
   ShaderHandle meshPickFragmentShader_{};
+  ShaderHandle meshIdFragmentShader_{};
   ShaderHandle computeShaderHandle_{};
   RenderPipelineHandle meshFillPipelineHandle_{};
   RenderPipelineHandle meshDoubleSidedFillPipelineHandle_{};
@@ -279,10 +328,17 @@ private:
   RenderPipelineHandle meshGsTessOverlayPipelineHandle_{};
   RenderPipelineHandle meshWireframePipelineHandle_{};
   RenderPipelineHandle meshTessWireframePipelineHandle_{};
+  // Owns the overlay pipelines above when they were acquired through it.
+  PipelineManager *overlayPipelineManager_ = nullptr;
   RenderPipelineHandle meshPickPipelineHandle_{};
   RenderPipelineHandle meshPickDoubleSidedPipelineHandle_{};
   RenderPipelineHandle meshPickTessPipelineHandle_{};
   RenderPipelineHandle meshPickDoubleSidedTessPipelineHandle_{};
+  // Single-target ID pipelines for the wireframe-only pick prepass.
+  RenderPipelineHandle meshIdPipelineHandle_{};
+  RenderPipelineHandle meshIdDoubleSidedPipelineHandle_{};
+  RenderPipelineHandle meshIdTessPipelineHandle_{};
+  RenderPipelineHandle meshIdDoubleSidedTessPipelineHandle_{};
   ComputePipelineHandle computePipelineHandle_{};
 
   size_t frameDataBufferCapacityBytes_ = 0;
@@ -308,12 +364,23 @@ private:
 
   const RenderScene *cachedScene_ = nullptr;
   uint64_t cachedTopologyVersion_ = std::numeric_limits<uint64_t>::max();
-  uint64_t cachedTransformVersion_ = std::numeric_limits<uint64_t>::max();
+  uint64_t cachedStaticTransformVersion_ =
+      std::numeric_limits<uint64_t>::max();
+  uint64_t cachedDynamicTransformVersion_ =
+      std::numeric_limits<uint64_t>::max();
   uint64_t cachedMaterialVersion_ = std::numeric_limits<uint64_t>::max();
   uint64_t cachedGeometryMutationVersion_ =
       std::numeric_limits<uint64_t>::max();
   bool instanceStaticBuffersDirty_ = true;
+  bool instanceDynamicBuffersDirty_ = false;
+  // Last frame whose compute pass wrote every animated transform into its
+  // instance matrices slot. Throttled instances copy from that slot.
+  uint64_t animationHistoryFrameIndex_ = std::numeric_limits<uint64_t>::max();
+  uint32_t animationHistoryFrameSlot_ = 0;
   bool uniformSingleSubmeshPath_ = false;
+  bool hasClusterLodTemplates_ = false;
+  InstanceTransformEncoding instanceTransformEncoding_ =
+      InstanceTransformEncoding::Affine3x4;
 
   struct AutoLodCache {
     bool valid = false;
@@ -333,15 +400,24 @@ private:
   IndirectPackCache indirectPackCache_{};
 
   std::pmr::vector<RenderableTemplate> renderableTemplates_;
+  // Ascending instance indices of dynamic renderables.
+  std::pmr::vector<uint32_t> dynamicInstanceIndices_;
   std::pmr::vector<MeshDrawTemplate> meshDrawTemplates_;
   std::pmr::vector<size_t> indirectSourceDrawIndices_;
   std::pmr::vector<uint64_t> indirectUploadSignatures_;
   std::pmr::vector<uint64_t> remapUploadSignatures_;
   std::pmr::vector<uint32_t> templateBatchIndices_;
+  std::pmr::vector<ClusterBatchRef> clusterBatchRefs_;
   std::pmr::vector<size_t> batchWriteOffsets_;
   std::pmr::vector<glm::vec4> instanceCentersPhase_;
   std::pmr::vector<glm::mat4> instanceBaseMatrices_;
+  std::pmr::vector<std::byte> instanceBaseTransformsPacked_;
   std::pmr::vector<glm::vec4> instanceLodCentersInvRadiusSq_;
+  std::pmr::vector<BoundingBox> instanceWorldBounds_;
+  std::pmr::vector<uint8_t> instanceOccluded_;
+  std::pmr::vector<uint32_t> occluderCandidates_;
+  std::unique_ptr<SoftwareOcclusionCuller> occlusionCuller_;
+  size_t occludedInstanceCount_ = 0;
   std::pmr::vector<MaterialGpuData> materialGpuDataCache_;
   std::pmr::vector<TextureHandle> materialTextureAccessHandles_;
   std::pmr::vector<uint32_t> instanceAutoLodLevels_;
@@ -351,6 +427,10 @@ private:
   std::pmr::vector<PushConstants> drawPushConstants_;
   std::pmr::vector<DrawItem> drawItems_;
   std::pmr::vector<DrawItem> indirectDrawItems_;
+  // Stream form of indirectDrawItems_, built with the pack and patched in
+  // place when only the ring slot or push constants change.
+  DrawStreamWriter indirectDrawStream_;
+  std::pmr::vector<DrawStreamPatchOffsets> indirectStreamPatches_;
   std::pmr::vector<std::byte> indirectCommandUploadBytes_;
   std::pmr::vector<DrawItem> overlayDrawItems_;
   std::pmr::vector<DrawItem> pickDrawItems_;
@@ -18,6 +18,7 @@
 namespace nuri {
 
 class LayerStack;
+class PipelineManager;
 class RenderScene;
 class ResourceManager;
 
@@ -43,7 +44,18 @@ struct RenderSettings {
     bool enableMeshLod = true;
     int32_t forcedMeshLod = -1;
     glm::vec3 meshLodDistanceThresholds{8.0f, 16.0f, 32.0f};
+    // Submeshes imported with a cluster hierarchy pick detail per cluster
+    // while auto LOD is active: the coarsest clusters whose simplification
+    // error projects below clusterLodErrorPixels are drawn.
+    bool enableClusterLod = true;
+    float clusterLodErrorPixels = 1.0f;
     bool enableInstanceAnimation = true;
+    // Animated instances beyond this distance update at half rate per
+    // doubling of distance, down to once every
+    // instanceAnimationMaxUpdatePeriod frames (a power of two; 1 disables
+    // throttling). Skipped frames reuse the previous frame's transform.
+    float instanceAnimationFullRateDistance = 24.0f;
+    uint32_t instanceAnimationMaxUpdatePeriod = 8;
     bool enableTessellation = false;
     float tessNearDistance = 1.0f;
     float tessFarDistance = 8.0f;
@@ -51,6 +63,13 @@ struct RenderSettings {
     float tessMaxFactor = 6.0f;
     // 0 means "no cap".
     uint32_t tessMaxInstances = 256;
+    // CPU software occlusion culling against the coarsest LODs of nearby
+    // opaque models. Inactive while instance animation is enabled, since the
+    // animated transforms only exist on the GPU.
+    bool enableOcclusionCulling = true;
+    // Scales image-based lighting by the scene's baked irradiance volume when
+    // one is set.
+    bool enableBakedIrradiance = true;
   };
 
   struct DebugSettings {
@@ -79,6 +98,8 @@ struct CameraFrameState {
 struct OpaqueFrameMetrics {
   uint32_t totalInstances = 0;
   uint32_t visibleInstances = 0;
+  uint32_t occludedInstances = 0;
+  uint32_t occluders = 0;
   uint32_t instancedDraws = 0;
   uint32_t indirectDrawCalls = 0;
   uint32_t indirectCommands = 0;
@@ -202,6 +223,7 @@ struct RenderFrameContext {
   const LayerStack *layerStack = nullptr;
   TextureHandle sharedDepthTexture{};
   const ResourceManager *resources = nullptr;
+  PipelineManager *pipelines = nullptr;
   double timeSeconds = 0.0;
   uint64_t frameIndex = 0;
 };
@@ -221,33 +221,22 @@ SkyboxLayer::ensureFrameBufferCapacity(size_t requiredBytes) {
 
 Result<bool, std::string> SkyboxLayer::createShaders() {
   skyboxShader_ = Shader::create("skybox", gpu_);
-  struct ShaderSpec {
-    Shader *shader = nullptr;
-    const std::filesystem::path *path = nullptr;
-    ShaderStage stage = ShaderStage::Vertex;
-    ShaderHandle *outHandle = nullptr;
-  };
-  const std::array<ShaderSpec, 2> shaderSpecs = {
-      ShaderSpec{skyboxShader_.get(), &config_.vertex, ShaderStage::Vertex,
-                 &skyboxVertexShader_},
-      ShaderSpec{skyboxShader_.get(), &config_.fragment, ShaderStage::Fragment,
-                 &skyboxFragmentShader_},
+  const std::string vertexPath = config_.vertex.string();
+  const std::string fragmentPath = config_.fragment.string();
+  if (!skyboxShader_ || vertexPath.empty() || fragmentPath.empty()) {
+    return Result<bool, std::string>::makeError(
+        "SkyboxLayer::createShaders: empty shader path");
+  }
+  const std::array<ShaderFile, 2> files = {
+      ShaderFile{vertexPath, ShaderStage::Vertex},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
   };
-
-  for (const ShaderSpec &spec : shaderSpecs) {
-    if (!spec.shader || !spec.outHandle || !spec.path ||
-        spec.path->string().empty()) {
-      return Result<bool, std::string>::makeError(
-          "SkyboxLayer::createShaders: empty shader path");
-    }
-    const std::string shaderPath = spec.path->string();
-    auto compileResult =
-        spec.shader->compileFromFile(shaderPath, spec.stage);
-    if (compileResult.hasError()) {
-      return Result<bool, std::string>::makeError(compileResult.error());
-    }
-    *spec.outHandle = compileResult.value();
+  auto compiled = skyboxShader_->compileFromFiles(files);
+  if (compiled.hasError()) {
+    return Result<bool, std::string>::makeError(compiled.error());
   }
+  skyboxVertexShader_ = compiled.value()[0];
+  skyboxFragmentShader_ = compiled.value()[1];
 
   return Result<bool, std::string>::makeResult(true);
 }
@@ -148,7 +148,8 @@ TransparentLayer::TransparentLayer(GPUDevice &gpu,
     : gpu_(gpu), config_(std::move(config)),
       memory_(resolveMemoryResource(memory)), instanceMatricesRing_(memory_),
       instanceRemapRing_(memory_), meshDrawTemplates_(memory_),
-      instanceMatrices_(memory_), instanceRemap_(memory_),
+      instanceMatrices_(memory_), instanceTransformsPacked_(memory_),
+      instanceRemap_(memory_),
       instanceDataRingUploadVersions_(memory_), materialGpuDataCache_(memory_),
       materialTextureAccessHandles_(memory_),
       environmentTextureAccessHandles_(memory_),
@@ -295,6 +296,13 @@ TransparentLayer::buildRenderGraph(RenderFrameContext &frame,
       instanceMatrices_.push_back(renderables[i].modelMatrix);
       instanceRemap_.push_back(i);
     }
+    instanceTransformEncoding_ =
+        selectInstanceTransformEncoding(instanceMatrices_);
+    instanceTransformsPacked_.resize(
+        instanceMatrices_.size() *
+        instanceTransformStride(instanceTransformEncoding_));
+    packInstanceTransforms(instanceMatrices_, instanceTransformEncoding_,
+                           instanceTransformsPacked_);
     cachedTransformVersion_ = frame.scene->transformVersion();
     std::fill(instanceDataRingUploadVersions_.begin(),
               instanceDataRingUploadVersions_.end(),
@@ -311,8 +319,8 @@ TransparentLayer::buildRenderGraph(RenderFrameContext &frame,
   if (materialBufferResult.hasError()) {
     return materialBufferResult;
   }
-  auto matricesBufferResult = ensureInstanceMatricesRingCapacity(std::max(
-      instanceMatrices_.size() * sizeof(glm::mat4), sizeof(glm::mat4)));
+  auto matricesBufferResult = ensureInstanceMatricesRingCapacity(
+      std::max(instanceTransformsPacked_.size(), sizeof(glm::mat4)));
   if (matricesBufferResult.hasError()) {
     return matricesBufferResult;
   }
@@ -425,10 +433,9 @@ TransparentLayer::buildRenderGraph(RenderFrameContext &frame,
 
   const bool needsInstanceDataUpload =
       instanceDataRingUploadVersions_[frameSlot] != cachedTransformVersion_;
-  if (needsInstanceDataUpload && !instanceMatrices_.empty()) {
+  if (needsInstanceDataUpload && !instanceTransformsPacked_.empty()) {
     const std::span<const std::byte> matrixBytes{
-        reinterpret_cast<const std::byte *>(instanceMatrices_.data()),
-        instanceMatrices_.size() * sizeof(glm::mat4)};
+        instanceTransformsPacked_.data(), instanceTransformsPacked_.size()};
     auto updateResult = gpu_.updateBuffer(
         instanceMatricesRing_[frameSlot].buffer->handle(), matrixBytes, 0);
     if (updateResult.hasError()) {
@@ -514,6 +521,8 @@ TransparentLayer::buildRenderGraph(RenderFrameContext &frame,
         .tessMinFactor = 1.0f,
         .tessMaxFactor = 1.0f,
         .debugVisualizationMode = 0u,
+        .instanceTransformEncoding =
+            static_cast<uint32_t>(instanceTransformEncoding_),
     });
     const PushConstants &pc = drawPushConstants_.back();
 
@@ -635,15 +644,15 @@ Result<bool, std::string> TransparentLayer::createShaders() {
         "TransparentLayer::createShaders: failed to create shader wrappers");
   }
 
-  auto vertexResult = meshShader_->compileFromFile(config_.meshVertex.string(),
-                                                   ShaderStage::Vertex);
-  if (vertexResult.hasError()) {
-    return Result<bool, std::string>::makeError(vertexResult.error());
-  }
-  auto fragmentResult = meshShader_->compileFromFile(
-      config_.meshFragment.string(), ShaderStage::Fragment);
-  if (fragmentResult.hasError()) {
-    return Result<bool, std::string>::makeError(fragmentResult.error());
+  const std::string vertexPath = config_.meshVertex.string();
+  const std::string fragmentPath = config_.meshFragment.string();
+  const std::array<ShaderFile, 2> meshFiles = {
+      ShaderFile{vertexPath, ShaderStage::Vertex},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
+  };
+  auto meshResult = meshShader_->compileFromFiles(meshFiles);
+  if (meshResult.hasError()) {
+    return Result<bool, std::string>::makeError(meshResult.error());
   }
   auto pickResult = meshPickShader_->compileFromFile(
       alphaPickFragmentPath_.string(), ShaderStage::Fragment);
@@ -651,8 +660,8 @@ Result<bool, std::string> TransparentLayer::createShaders() {
     return Result<bool, std::string>::makeError(pickResult.error());
   }
 
-  meshVertexShader_ = vertexResult.value();
-  meshFragmentShader_ = fragmentResult.value();
+  meshVertexShader_ = meshResult.value()[0];
+  meshFragmentShader_ = meshResult.value()[1];
   meshPickFragmentShader_ = pickResult.value();
   return Result<bool, std::string>::makeResult(true);
 }
@@ -1176,6 +1185,7 @@ void TransparentLayer::resetCachedState() {
 
   meshDrawTemplates_.clear();
   instanceMatrices_.clear();
+  instanceTransformsPacked_.clear();
   instanceRemap_.clear();
   instanceDataRingUploadVersions_.clear();
   materialGpuDataCache_.clear();
@@ -4,6 +4,7 @@
 #include "nuri/core/runtime_config.h"
 #include "nuri/defines.h"
 #include "nuri/gfx/gpu_device.h"
+#include "nuri/gfx/instance_transform.h"
 #include "nuri/resources/cpu/mesh_data.h"
 #include "nuri/resources/gpu/buffer.h"
 #include "nuri/resources/gpu/material.h"
@@ -108,6 +109,7 @@ private:
     float tessMinFactor = 1.0f;
     float tessMaxFactor = 6.0f;
     uint32_t debugVisualizationMode = 0;
+    uint32_t instanceTransformEncoding = 0;
   };
   static_assert(sizeof(PushConstants) <= 128,
                 "TransparentLayer::PushConstants exceeds Vulkan guarantee");
@@ -206,6 +208,9 @@ private:
 
   std::pmr::vector<MeshDrawTemplate> meshDrawTemplates_;
   std::pmr::vector<glm::mat4> instanceMatrices_;
+  std::pmr::vector<std::byte> instanceTransformsPacked_;
+  InstanceTransformEncoding instanceTransformEncoding_ =
+      InstanceTransformEncoding::Affine3x4;
   std::pmr::vector<uint32_t> instanceRemap_;
   std::pmr::vector<uint64_t> instanceDataRingUploadVersions_;
   std::pmr::vector<MaterialGpuData> materialGpuDataCache_;
@@ -0,0 +1,283 @@
+#include "nuri/pch.h"
+
+#include "nuri/gfx/pipeline_manager.h"
+
+#include "nuri/core/log.h"
+#include "nuri/core/profiling.h"
+
+namespace nuri {
+namespace {
+
+using CompileClock = std::chrono::steady_clock;
+
+[[nodiscard]] bool isSameHandle(RenderPipelineHandle a,
+                                RenderPipelineHandle b) {
+  return a.index == b.index && a.generation == b.generation;
+}
+
+} // namespace
+
+PipelineManager::PipelineManager(GPUDevice &gpu,
+                                 std::pmr::memory_resource *memory)
+    : gpu_(gpu),
+      memory_(memory != nullptr ? memory : std::pmr::get_default_resource()),
+      entries_(memory_), queue_(memory_), completed_(memory_) {}
+
+PipelineManager::~PipelineManager() {
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  workCv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+
+  // Unpublished jobs hold device state and must die on this thread.
+  queue_.clear();
+  completed_.clear();
+  for (const auto &[key, entry] : entries_) {
+    (void)key;
+    if (nuri::isValid(entry.handle)) {
+      gpu_.destroyRenderPipeline(entry.handle);
+    }
+  }
+}
+
+Result<PipelineLookup, std::string>
+PipelineManager::acquire(uint64_t key, const PipelineRequest &request) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    auto created = gpu_.createRenderPipeline(request.desc, request.debugName);
+    if (created.hasError()) {
+      return Result<PipelineLookup, std::string>::makeError(
+          "PipelineManager::acquire: failed to create '" +
+          std::string(request.debugName) + "': " + created.error());
+    }
+
+    Entry entry(memory_);
+    entry.handle = created.value();
+    entry.status = PipelineStatus::Ready;
+    if (request.policy != PipelineFallbackPolicy::Block &&
+        gpu_.supportsBackgroundPipelineCompilation()) {
+      auto prepared = gpu_.prepareRenderPipelineCompile(entry.handle);
+      if (prepared.hasError()) {
+        // Still usable; the driver compiles it at first bind instead.
+        NURI_LOG_WARNING("PipelineManager::acquire: compiling '%.*s' at first "
+                         "use: %s",
+                         static_cast<int>(request.debugName.size()),
+                         request.debugName.data(), prepared.error().c_str());
+      } else {
+        entry.status = PipelineStatus::Pending;
+        std::scoped_lock lock(mutex_);
+        queue_.push_back(CompileJob{.key = key,
+                                    .handle = entry.handle,
+                                    .job = std::move(prepared.value()),
+                                    .error = {},
+                                    .failed = false});
+        startWorkerLocked();
+        workCv_.notify_one();
+      }
+    }
+    it = entries_.emplace(key, std::move(entry)).first;
+  }
+
+  if (it->second.status == PipelineStatus::Pending &&
+      request.policy == PipelineFallbackPolicy::Block) {
+    const RenderPipelineHandle handle = it->second.handle;
+    while (true) {
+      publishCompleted();
+      it = entries_.find(key);
+      if (it == entries_.end() ||
+          it->second.status != PipelineStatus::Pending) {
+        break;
+      }
+      std::unique_lock lock(mutex_);
+      idleCv_.wait(lock, [&] {
+        return std::ranges::any_of(completed_, [&](const CompileJob &job) {
+          return isSameHandle(job.handle, handle);
+        });
+      });
+    }
+    if (it == entries_.end()) {
+      return Result<PipelineLookup, std::string>::makeError(
+          "PipelineManager::acquire: '" + std::string(request.debugName) +
+          "' was released while compiling");
+    }
+  }
+
+  const Entry &entry = it->second;
+  switch (entry.status) {
+  case PipelineStatus::Ready:
+    return Result<PipelineLookup, std::string>::makeResult(PipelineLookup{
+        .handle = entry.handle, .status = PipelineStatus::Ready});
+  case PipelineStatus::Failed:
+    return Result<PipelineLookup, std::string>::makeError(
+        "PipelineManager::acquire: failed to compile '" +
+        std::string(request.debugName) + "': " + std::string(entry.error));
+  case PipelineStatus::Pending:
+    break;
+  }
+
+  if (request.policy == PipelineFallbackPolicy::UseFallback &&
+      nuri::isValid(request.fallback)) {
+    ++fallbackLookups_;
+    return Result<PipelineLookup, std::string>::makeResult(
+        PipelineLookup{.handle = request.fallback,
+                       .status = PipelineStatus::Pending,
+                       .usingFallback = true});
+  }
+  ++skippedLookups_;
+  return Result<PipelineLookup, std::string>::makeResult(
+      PipelineLookup{.status = PipelineStatus::Pending});
+}
+
+void PipelineManager::release(uint64_t key) {
+  const auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return;
+  }
+  const RenderPipelineHandle handle = it->second.handle;
+  entries_.erase(it);
+
+  // A queued job is dropped here; one already compiling only touches its own
+  // state and is discarded when it is published.
+  std::pmr::deque<CompileJob> dropped(memory_);
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto job = queue_.begin(); job != queue_.end();) {
+      if (isSameHandle(job->handle, handle)) {
+        dropped.push_back(std::move(*job));
+        job = queue_.erase(job);
+      } else {
+        ++job;
+      }
+    }
+  }
+  dropped.clear();
+  if (nuri::isValid(handle)) {
+    gpu_.destroyRenderPipeline(handle);
+  }
+}
+
+void PipelineManager::beginFrame(uint64_t frameIndex) {
+  (void)frameIndex;
+  fallbackLookups_ = 0;
+  skippedLookups_ = 0;
+  publishCompleted();
+}
+
+void PipelineManager::waitIdle() {
+  {
+    std::unique_lock lock(mutex_);
+    idleCv_.wait(lock, [&] { return queue_.empty() && !compiling_; });
+  }
+  publishCompleted();
+}
+
+PipelineManagerStats PipelineManager::stats() const {
+  PipelineManagerStats out{};
+  out.fallbackLookups = fallbackLookups_;
+  out.skippedLookups = skippedLookups_;
+  for (const auto &[key, entry] : entries_) {
+    (void)key;
+    if (entry.status == PipelineStatus::Pending) {
+      ++out.pendingPipelines;
+    } else if (entry.status == PipelineStatus::Ready) {
+      ++out.readyPipelines;
+    }
+  }
+  std::scoped_lock lock(mutex_);
+  out.backgroundCompiles = backgroundCompiles_;
+  out.backgroundCompileSeconds = backgroundCompileSeconds_;
+  return out;
+}
+
+void PipelineManager::publishCompleted() {
+  std::pmr::deque<CompileJob> completed(memory_);
+  {
+    std::scoped_lock lock(mutex_);
+    if (completed_.empty()) {
+      return;
+    }
+    completed.swap(completed_);
+  }
+
+  for (CompileJob &job : completed) {
+    const auto it = entries_.find(job.key);
+    if (it == entries_.end() || !isSameHandle(it->second.handle, job.handle)) {
+      continue;
+    }
+    Entry &entry = it->second;
+    if (!job.failed) {
+      auto finished = gpu_.finishRenderPipelineCompile(*job.job);
+      if (finished.hasError()) {
+        job.failed = true;
+        job.error = finished.error();
+      }
+    }
+    if (job.failed) {
+      entry.status = PipelineStatus::Failed;
+      entry.error.assign(job.error);
+      NURI_LOG_WARNING("PipelineManager: background compile failed: %s",
+                       job.error.c_str());
+    } else {
+      entry.status = PipelineStatus::Ready;
+    }
+  }
+}
+
+uint64_t PipelineManager::makeKey(const void *owner, std::string_view name,
+                                  uint64_t variant) noexcept {
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  const auto mix = [&hash](uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u);
+  };
+  mix(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(owner)));
+  mix(variant);
+  return hash;
+}
+
+void PipelineManager::startWorkerLocked() {
+  if (worker_.joinable()) {
+    return;
+  }
+  worker_ = std::thread([this] { workerLoop(); });
+}
+
+void PipelineManager::workerLoop() {
+  NURI_PROFILER_THREAD("PipelineCompiler");
+  std::unique_lock lock(mutex_);
+  while (true) {
+    workCv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+    if (stopping_) {
+      return;
+    }
+    CompileJob job = std::move(queue_.front());
+    queue_.pop_front();
+    compiling_ = true;
+    lock.unlock();
+
+    const CompileClock::time_point begin = CompileClock::now();
+    auto result = job.job->compile();
+    const double seconds =
+        std::chrono::duration<double>(CompileClock::now() - begin).count();
+    if (result.hasError()) {
+      job.failed = true;
+      job.error = result.error();
+    }
+
+    lock.lock();
+    compiling_ = false;
+    ++backgroundCompiles_;
+    backgroundCompileSeconds_ += seconds;
+    completed_.push_back(std::move(job));
+    idleCv_.notify_all();
+  }
+}
+
+} // namespace nuri
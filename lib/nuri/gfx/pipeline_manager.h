@@ -0,0 +1,144 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/gfx/gpu_device.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace nuri {
+
+enum class PipelineFallbackPolicy : uint8_t {
+  // Draw with PipelineRequest::fallback until the pipeline is compiled.
+  UseFallback,
+  // Report the pipeline as unavailable so the caller drops the draw.
+  Skip,
+  // Create and compile on the calling thread.
+  Block,
+};
+
+enum class PipelineStatus : uint8_t {
+  Pending,
+  Ready,
+  Failed,
+};
+
+struct NURI_API PipelineRequest {
+  RenderPipelineDesc desc{};
+  std::string_view debugName{};
+  PipelineFallbackPolicy policy = PipelineFallbackPolicy::UseFallback;
+  // Must match desc's attachment formats, vertex input and push constant
+  // layout. Without one, UseFallback behaves like Skip.
+  RenderPipelineHandle fallback{};
+};
+
+struct NURI_API PipelineLookup {
+  // The requested pipeline once Ready, otherwise the fallback or an invalid
+  // handle when the draw should be skipped.
+  RenderPipelineHandle handle{};
+  PipelineStatus status = PipelineStatus::Pending;
+  bool usingFallback = false;
+};
+
+struct NURI_API PipelineManagerStats {
+  uint32_t pendingPipelines = 0;
+  uint32_t readyPipelines = 0;
+  // Reset by beginFrame().
+  uint32_t fallbackLookups = 0;
+  uint32_t skippedLookups = 0;
+  uint64_t backgroundCompiles = 0;
+  double backgroundCompileSeconds = 0.0;
+};
+
+// Owns render pipelines that are created on demand. Handles are created on
+// the render thread, which is cheap on backends that build the driver
+// pipeline lazily; the expensive compile then runs on a worker thread against
+// a job that owns its inputs, and is published back on the render thread.
+// Devices without supportsBackgroundPipelineCompilation() get synchronous
+// creation. Every method except the worker runs on the render thread, and no
+// lock is held across GPUDevice calls.
+class NURI_API PipelineManager {
+public:
+  explicit PipelineManager(
+      GPUDevice &gpu,
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+  ~PipelineManager();
+
+  PipelineManager(const PipelineManager &) = delete;
+  PipelineManager &operator=(const PipelineManager &) = delete;
+  PipelineManager(PipelineManager &&) = delete;
+  PipelineManager &operator=(PipelineManager &&) = delete;
+
+  // Keys identify a pipeline permutation; the desc is only read the first
+  // time a key is seen. Callers must release() a key before reusing it for a
+  // different desc. Returns an error if creation or compilation failed.
+  [[nodiscard]] Result<PipelineLookup, std::string>
+  acquire(uint64_t key, const PipelineRequest &request);
+  void release(uint64_t key);
+
+  // Publishes compiles the worker finished since the last call.
+  void beginFrame(uint64_t frameIndex);
+  // Blocks until every queued compile has finished and publishes them.
+  void waitIdle();
+
+  [[nodiscard]] PipelineManagerStats stats() const;
+
+  // Keys are shared by every user of the manager; `owner` keeps identically
+  // named pipelines of different layer instances apart.
+  [[nodiscard]] static uint64_t makeKey(const void *owner,
+                                        std::string_view name,
+                                        uint64_t variant = 0) noexcept;
+
+private:
+  struct Entry {
+    RenderPipelineHandle handle{};
+    PipelineStatus status = PipelineStatus::Pending;
+    std::pmr::string error;
+
+    explicit Entry(std::pmr::memory_resource *memory) : error(memory) {}
+  };
+
+  struct CompileJob {
+    uint64_t key = 0;
+    RenderPipelineHandle handle{};
+    std::unique_ptr<PipelineCompileJob> job;
+    std::string error;
+    bool failed = false;
+  };
+
+  void workerLoop();
+  void startWorkerLocked();
+  void publishCompleted();
+
+  GPUDevice &gpu_;
+  std::pmr::memory_resource *memory_ = nullptr;
+
+  // Render thread only.
+  std::pmr::unordered_map<uint64_t, Entry> entries_;
+  uint32_t fallbackLookups_ = 0;
+  uint32_t skippedLookups_ = 0;
+
+  // Shared with the worker.
+  mutable std::mutex mutex_;
+  std::condition_variable workCv_;
+  std::condition_variable idleCv_;
+  std::pmr::deque<CompileJob> queue_;
+  // Compiled jobs waiting for the render thread to publish them.
+  std::pmr::deque<CompileJob> completed_;
+  uint64_t backgroundCompiles_ = 0;
+  double backgroundCompileSeconds_ = 0.0;
+  bool compiling_ = false;
+  bool stopping_ = false;
+  std::thread worker_;
+};
+
+} // namespace nuri
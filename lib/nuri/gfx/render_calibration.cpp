@@ -0,0 +1,307 @@
+#include "nuri/pch.h"
+
+#include "nuri/gfx/render_calibration.h"
+
+#include "nuri/core/log.h"
+
+#include <iomanip>
+
+namespace nuri {
+namespace {
+
+constexpr std::string_view kProfileFileName = "render_calibration.json";
+constexpr int64_t kProfileVersion = 1;
+// Lets a vsync-capped interval (e.g. 16.7 ms against a 16.67 ms target)
+// count as meeting the target.
+constexpr double kTargetTolerance = 1.05;
+constexpr double kMillisecondsPerSecond = 1000.0;
+
+struct TierSettings {
+  float lodDistanceScale;
+  float clusterLodErrorPixels;
+  float animationFullRateDistanceScale;
+  uint32_t animationMaxUpdatePeriod;
+  uint32_t tessMaxInstances;
+};
+
+// Medium matches the RenderSettings defaults.
+constexpr std::array<TierSettings, 3> kTierSettings = {{
+    {0.5f, 4.0f, 0.5f, 16u, 64u},
+    {1.0f, 1.0f, 1.0f, 8u, 256u},
+    {1.5f, 0.5f, 2.0f, 4u, 1024u},
+}};
+
+[[nodiscard]] double takeMedian(std::pmr::vector<double> &samples) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const auto middle =
+      samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2u);
+  std::nth_element(samples.begin(), middle, samples.end());
+  return *middle;
+}
+
+template <typename T>
+[[nodiscard]] Result<T, std::string> makeError(std::string message) {
+  return Result<T, std::string>::makeError(std::move(message));
+}
+
+[[nodiscard]] Result<double, std::string>
+readNumberField(yyjson_val *root, const char *key, bool required) {
+  yyjson_val *value = yyjson_obj_get(root, key);
+  if (value == nullptr) {
+    if (required) {
+      return makeError<double>(
+          std::string("loadRenderCalibrationProfile: missing field '") + key +
+          "'");
+    }
+    return Result<double, std::string>::makeResult(0.0);
+  }
+  if (!yyjson_is_num(value)) {
+    return makeError<double>(
+        std::string("loadRenderCalibrationProfile: field '") + key +
+        "' must be a number");
+  }
+  const double number = yyjson_get_num(value);
+  if (!std::isfinite(number) || number < 0.0) {
+    return makeError<double>(
+        std::string("loadRenderCalibrationProfile: field '") + key +
+        "' must be a non-negative number");
+  }
+  return Result<double, std::string>::makeResult(number);
+}
+
+} // namespace
+
+std::string_view renderQualityTierName(RenderQualityTier tier) noexcept {
+  switch (tier) {
+  case RenderQualityTier::Low:
+    return "low";
+  case RenderQualityTier::Medium:
+    return "medium";
+  case RenderQualityTier::High:
+    return "high";
+  }
+  return "medium";
+}
+
+std::optional<RenderQualityTier>
+parseRenderQualityTier(std::string_view name) noexcept {
+  for (const RenderQualityTier tier :
+       {RenderQualityTier::Low, RenderQualityTier::Medium,
+        RenderQualityTier::High}) {
+    if (name == renderQualityTierName(tier)) {
+      return tier;
+    }
+  }
+  return std::nullopt;
+}
+
+void applyRenderQualityTier(RenderQualityTier tier, RenderSettings &settings) {
+  const TierSettings &tierSettings =
+      kTierSettings[static_cast<size_t>(tier)];
+  RenderSettings::OpaqueSettings &opaque = settings.opaque;
+  opaque.meshLodDistanceThresholds =
+      opaque.meshLodDistanceThresholds * tierSettings.lodDistanceScale;
+  opaque.clusterLodErrorPixels = tierSettings.clusterLodErrorPixels;
+  opaque.instanceAnimationFullRateDistance *=
+      tierSettings.animationFullRateDistanceScale;
+  opaque.instanceAnimationMaxUpdatePeriod =
+      tierSettings.animationMaxUpdatePeriod;
+  opaque.tessMaxInstances = tierSettings.tessMaxInstances;
+}
+
+RenderCalibration::RenderCalibration(std::pmr::memory_resource *memory)
+    : cpuSamplesMs_(memory), intervalSamplesMs_(memory) {}
+
+void RenderCalibration::begin(const RenderCalibrationConfig &config) {
+  config_ = config;
+  config_.sampleFrames = std::max(config_.sampleFrames, 1u);
+  cpuSamplesMs_.clear();
+  intervalSamplesMs_.clear();
+  cpuSamplesMs_.reserve(config_.sampleFrames);
+  intervalSamplesMs_.reserve(config_.sampleFrames);
+  result_.reset();
+  tier_ = RenderQualityTier::High;
+  tierFrame_ = 0;
+  running_ = true;
+}
+
+void RenderCalibration::cancel() noexcept {
+  running_ = false;
+  cpuSamplesMs_.clear();
+  intervalSamplesMs_.clear();
+}
+
+uint32_t RenderCalibration::framesRemainingInTier() const noexcept {
+  if (!running_) {
+    return 0u;
+  }
+  const uint32_t tierFrames = config_.warmupFrames + config_.sampleFrames;
+  return tierFrames > tierFrame_ ? tierFrames - tierFrame_ : 0u;
+}
+
+bool RenderCalibration::recordFrame(double cpuSeconds,
+                                    double frameIntervalSeconds) {
+  if (!running_) {
+    return false;
+  }
+  if (!std::isfinite(cpuSeconds) || !std::isfinite(frameIntervalSeconds) ||
+      cpuSeconds < 0.0 || frameIntervalSeconds <= 0.0) {
+    return false;
+  }
+  ++tierFrame_;
+  if (tierFrame_ <= config_.warmupFrames) {
+    return false;
+  }
+  cpuSamplesMs_.push_back(cpuSeconds * kMillisecondsPerSecond);
+  intervalSamplesMs_.push_back(frameIntervalSeconds * kMillisecondsPerSecond);
+  if (intervalSamplesMs_.size() < config_.sampleFrames) {
+    return false;
+  }
+
+  const double cpuMs = takeMedian(cpuSamplesMs_);
+  const double intervalMs = takeMedian(intervalSamplesMs_);
+  if (intervalMs <= config_.targetFrameMs * kTargetTolerance ||
+      tier_ == RenderQualityTier::Low) {
+    finish(cpuMs, intervalMs);
+    return true;
+  }
+
+  NURI_LOG_DEBUG("RenderCalibration::recordFrame: tier '%.*s' misses the "
+                 "target (%.2f ms > %.2f ms)",
+                 static_cast<int>(renderQualityTierName(tier_).size()),
+                 renderQualityTierName(tier_).data(), intervalMs,
+                 config_.targetFrameMs);
+  tier_ = static_cast<RenderQualityTier>(static_cast<uint8_t>(tier_) - 1u);
+  tierFrame_ = 0;
+  cpuSamplesMs_.clear();
+  intervalSamplesMs_.clear();
+  return true;
+}
+
+void RenderCalibration::finish(double cpuMs, double intervalMs) {
+  result_ = RenderCalibrationProfile{
+      .tier = tier_,
+      .targetFrameMs = config_.targetFrameMs,
+      .cpuFrameMs = cpuMs,
+      .frameIntervalMs = intervalMs,
+  };
+  running_ = false;
+  cpuSamplesMs_.clear();
+  intervalSamplesMs_.clear();
+}
+
+std::filesystem::path
+renderCalibrationProfilePath(const std::filesystem::path &configSourcePath) {
+  return configSourcePath.parent_path() / kProfileFileName;
+}
+
+Result<RenderCalibrationProfile, std::string>
+loadRenderCalibrationProfile(const std::filesystem::path &path) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input.is_open()) {
+    return makeError<RenderCalibrationProfile>(
+        "loadRenderCalibrationProfile: failed to open '" + path.string() +
+        "'");
+  }
+  std::ostringstream stream;
+  stream << input.rdbuf();
+  std::string jsonText = stream.str();
+
+  yyjson_read_err parseError{};
+  yyjson_doc *rawDoc = yyjson_read_opts(jsonText.data(), jsonText.size(), 0,
+                                        nullptr, &parseError);
+  if (!rawDoc) {
+    const std::string message =
+        parseError.msg != nullptr ? parseError.msg : "unknown parse error";
+    return makeError<RenderCalibrationProfile>(
+        "loadRenderCalibrationProfile: failed to parse '" + path.string() +
+        "': " + message);
+  }
+  std::unique_ptr<yyjson_doc, decltype(&yyjson_doc_free)> doc(rawDoc,
+                                                              &yyjson_doc_free);
+  yyjson_val *root = yyjson_doc_get_root(doc.get());
+  if (!yyjson_is_obj(root)) {
+    return makeError<RenderCalibrationProfile>(
+        "loadRenderCalibrationProfile: root must be a JSON object");
+  }
+
+  yyjson_val *version = yyjson_obj_get(root, "version");
+  if (!yyjson_is_int(version) || yyjson_get_sint(version) != kProfileVersion) {
+    return makeError<RenderCalibrationProfile>(
+        "loadRenderCalibrationProfile: unsupported profile version");
+  }
+
+  yyjson_val *tierValue = yyjson_obj_get(root, "tier");
+  const char *tierName =
+      yyjson_is_str(tierValue) ? yyjson_get_str(tierValue) : nullptr;
+  const std::optional<RenderQualityTier> tier =
+      tierName != nullptr ? parseRenderQualityTier(tierName) : std::nullopt;
+  if (!tier) {
+    return makeError<RenderCalibrationProfile>(
+        "loadRenderCalibrationProfile: field 'tier' must be one of 'low', "
+        "'medium' or 'high'");
+  }
+
+  auto targetResult = readNumberField(root, "target_frame_ms", true);
+  if (targetResult.hasError()) {
+    return makeError<RenderCalibrationProfile>(targetResult.error());
+  }
+  auto cpuResult = readNumberField(root, "cpu_frame_ms", false);
+  if (cpuResult.hasError()) {
+    return makeError<RenderCalibrationProfile>(cpuResult.error());
+  }
+  auto intervalResult = readNumberField(root, "frame_interval_ms", false);
+  if (intervalResult.hasError()) {
+    return makeError<RenderCalibrationProfile>(intervalResult.error());
+  }
+  if (targetResult.value() <= 0.0) {
+    return makeError<RenderCalibrationProfile>(
+        "loadRenderCalibrationProfile: field 'target_frame_ms' must be "
+        "positive");
+  }
+
+  return Result<RenderCalibrationProfile, std::string>::makeResult(
+      RenderCalibrationProfile{
+          .tier = *tier,
+          .targetFrameMs = targetResult.value(),
+          .cpuFrameMs = cpuResult.value(),
+          .frameIntervalMs = intervalResult.value(),
+      });
+}
+
+Result<bool, std::string>
+saveRenderCalibrationProfile(const std::filesystem::path &path,
+                             const RenderCalibrationProfile &profile) {
+  if (path.has_parent_path()) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+      return makeError<bool>(
+          "saveRenderCalibrationProfile: failed to create directory '" +
+          path.parent_path().string() + "': " + ec.message());
+    }
+  }
+
+  std::ofstream output(path, std::ios::out | std::ios::trunc);
+  if (!output.is_open()) {
+    return makeError<bool>("saveRenderCalibrationProfile: failed to open '" +
+                           path.string() + "'");
+  }
+  output << std::fixed << std::setprecision(3) << "{\n"
+         << "  \"version\": " << kProfileVersion << ",\n"
+         << "  \"tier\": \"" << renderQualityTierName(profile.tier)
+         << "\",\n"
+         << "  \"target_frame_ms\": " << profile.targetFrameMs << ",\n"
+         << "  \"cpu_frame_ms\": " << profile.cpuFrameMs << ",\n"
+         << "  \"frame_interval_ms\": " << profile.frameIntervalMs << "\n"
+         << "}\n";
+  if (!output.good()) {
+    return makeError<bool>("saveRenderCalibrationProfile: failed to write '" +
+                           path.string() + "'");
+  }
+  return Result<bool, std::string>::makeResult(true);
+}
+
+} // namespace nuri
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/gfx/layers/render_frame_context.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nuri {
+
+enum class RenderQualityTier : uint8_t {
+  Low = 0,
+  Medium = 1,
+  High = 2,
+};
+
+[[nodiscard]] NURI_API std::string_view
+renderQualityTierName(RenderQualityTier tier) noexcept;
+[[nodiscard]] NURI_API std::optional<RenderQualityTier>
+parseRenderQualityTier(std::string_view name) noexcept;
+
+// Scales the detail settings of a scene's baseline. Scenes keep their own LOD
+// distances (they depend on scene scale), so tiers multiply them rather than
+// replace them; feature toggles chosen by the scene are left alone.
+NURI_API void applyRenderQualityTier(RenderQualityTier tier,
+                                     RenderSettings &settings);
+
+struct RenderCalibrationProfile {
+  RenderQualityTier tier = RenderQualityTier::Medium;
+  double targetFrameMs = 1000.0 / 60.0;
+  // Medians measured at the chosen tier.
+  double cpuFrameMs = 0.0;
+  double frameIntervalMs = 0.0;
+};
+
+struct RenderCalibrationConfig {
+  double targetFrameMs = 1000.0 / 60.0;
+  // Frames rendered after each tier switch before sampling starts, so
+  // pipeline creation and buffer growth do not count against the tier.
+  uint32_t warmupFrames = 30;
+  uint32_t sampleFrames = 90;
+};
+
+// Steps from the highest tier down, rendering warmupFrames + sampleFrames at
+// each, and keeps the first tier whose median frame interval meets the
+// target. The interval includes waiting on the GPU, so it stands in for GPU
+// time; vsync-capped intervals at the target count as meeting it.
+class NURI_API RenderCalibration {
+public:
+  explicit RenderCalibration(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+  void begin(const RenderCalibrationConfig &config);
+  void cancel() noexcept;
+
+  [[nodiscard]] bool isRunning() const noexcept { return running_; }
+  // Tier to render with while running.
+  [[nodiscard]] RenderQualityTier currentTier() const noexcept {
+    return tier_;
+  }
+  // Frames left before the current tier is judged, for progress display.
+  [[nodiscard]] uint32_t framesRemainingInTier() const noexcept;
+
+  // Feeds one rendered frame. Returns true when the tier changed or the run
+  // finished, so the caller re-applies settings.
+  bool recordFrame(double cpuSeconds, double frameIntervalSeconds);
+
+  [[nodiscard]] const std::optional<RenderCalibrationProfile> &
+  result() const noexcept {
+    return result_;
+  }
+
+private:
+  void finish(double cpuMs, double intervalMs);
+
+  RenderCalibrationConfig config_{};
+  std::pmr::vector<double> cpuSamplesMs_;
+  std::pmr::vector<double> intervalSamplesMs_;
+  std::optional<RenderCalibrationProfile> result_{};
+  RenderQualityTier tier_ = RenderQualityTier::High;
+  uint32_t tierFrame_ = 0;
+  bool running_ = false;
+};
+
+// The profile lives next to the app config, e.g. render_calibration.json
+// beside app.config.json.
+[[nodiscard]] NURI_API std::filesystem::path
+renderCalibrationProfilePath(const std::filesystem::path &configSourcePath);
+
+[[nodiscard]] NURI_API Result<RenderCalibrationProfile, std::string>
+loadRenderCalibrationProfile(const std::filesystem::path &path);
+[[nodiscard]] NURI_API Result<bool, std::string>
+saveRenderCalibrationProfile(const std::filesystem::path &path,
+                             const RenderCalibrationProfile &profile);
+
+} // namespace nuri
@@ -4,6 +4,7 @@
 
 #include "nuri/core/containers/hash_set.h"
 #include "nuri/core/profiling.h"
+#include "nuri/gfx/draw_stream.h"
 
 #include <queue>
 
@@ -28,6 +29,12 @@ resolveResourceDebugName(std::string_view name, std::string_view fallback) {
   return name.empty() ? fallback : name;
 }
 
+[[nodiscard]] constexpr RenderGraphStage
+removeStages(RenderGraphStage stages, RenderGraphStage removed) {
+  return static_cast<RenderGraphStage>(static_cast<uint16_t>(stages) &
+                                       ~static_cast<uint16_t>(removed));
+}
+
 [[nodiscard]] std::string makePassResourceDebugName(std::string_view passLabel,
                                                     std::string_view suffix) {
   const std::string_view base =
@@ -40,6 +47,10 @@ resolveResourceDebugName(std::string_view name, std::string_view fallback) {
   return out;
 }
 
+static_assert(static_cast<uint16_t>(RenderGraphStage::DepthAttachment) ==
+                  static_cast<uint16_t>(GraphicsBarrierStage::DepthAttachment),
+              "RenderGraphStage must mirror GraphicsBarrierStage");
+
 [[nodiscard]] bool isValidTransientTextureDesc(const TextureDesc &desc) {
   return desc.type != TextureType::Count && desc.format != Format::Count &&
          desc.storage != Storage::Count && desc.usage != TextureUsage::Count &&
@@ -186,9 +197,11 @@ std::string_view toString(RenderGraphExecutionFailureStage stage) noexcept {
 
 RenderGraphBuilder::RenderGraphBuilder(std::pmr::memory_resource *memory)
     : memory_(memory != nullptr ? memory : std::pmr::get_default_resource()),
+      frameMemory_(memory_),
       textures_(memory_), buffers_(memory_), ownedPassPayloads_(memory_),
       passes_(memory_), passDebugNames_(memory_),
       passColorTextureBindings_(memory_), passDepthTextureBindings_(memory_),
+      passAdditionalColorTextureBindings_(memory_),
       passDependencyBufferBindingOffsets_(memory_),
       passDependencyBufferBindingCounts_(memory_),
       passDependencyBufferBindingResourceIndices_(memory_),
@@ -202,6 +215,9 @@ RenderGraphBuilder::RenderGraphBuilder(std::pmr::memory_resource *memory)
       drawIndexBindingResourceIndices_(memory_),
       drawIndirectBindingResourceIndices_(memory_),
       drawIndirectCountBindingResourceIndices_(memory_),
+      passCopyBindingOffsets_(memory_), passCopyBindingCounts_(memory_),
+      copySourceBindingResourceIndices_(memory_),
+      copyDestinationBindingResourceIndices_(memory_),
       importedTextureIndicesByHandle_(memory_),
       importedBufferIndicesByHandle_(memory_),
       explicitTextureAccessIndicesByPassResource_(memory_),
@@ -210,11 +226,14 @@ RenderGraphBuilder::RenderGraphBuilder(std::pmr::memory_resource *memory)
       inferredBufferAccessIndicesByPassResource_(memory_),
       dependencyEdgeKeys_(memory_), dependencies_(memory_),
       passResourceAccesses_(memory_), frameOutputTextureSet_(memory_),
-      frameOutputTextureIndices_(memory_),
+      frameOutputTextureIndices_(memory_), historyOutputTextureSet_(memory_),
+      historyOutputTextureIndices_(memory_),
       sideEffectMarkIndicesByPass_(memory_), sideEffectPassMarks_(memory_) {}
 
-void RenderGraphBuilder::beginFrame(uint64_t frameIndex) {
+void RenderGraphBuilder::beginFrame(uint64_t frameIndex,
+                                    std::pmr::memory_resource *frameMemory) {
   frameIndex_ = frameIndex;
+  frameMemory_ = frameMemory != nullptr ? frameMemory : memory_;
   textures_.clear();
   buffers_.clear();
   ownedPassPayloads_.clear();
@@ -222,6 +241,7 @@ void RenderGraphBuilder::beginFrame(uint64_t frameIndex) {
   passDebugNames_.clear();
   passColorTextureBindings_.clear();
   passDepthTextureBindings_.clear();
+  passAdditionalColorTextureBindings_.clear();
   passDependencyBufferBindingOffsets_.clear();
   passDependencyBufferBindingCounts_.clear();
   passDependencyBufferBindingResourceIndices_.clear();
@@ -236,6 +256,10 @@ void RenderGraphBuilder::beginFrame(uint64_t frameIndex) {
   drawIndexBindingResourceIndices_.clear();
   drawIndirectBindingResourceIndices_.clear();
   drawIndirectCountBindingResourceIndices_.clear();
+  passCopyBindingOffsets_.clear();
+  passCopyBindingCounts_.clear();
+  copySourceBindingResourceIndices_.clear();
+  copyDestinationBindingResourceIndices_.clear();
   importedTextureIndicesByHandle_.clear();
   importedBufferIndicesByHandle_.clear();
   explicitTextureAccessIndicesByPassResource_.clear();
@@ -247,8 +271,13 @@ void RenderGraphBuilder::beginFrame(uint64_t frameIndex) {
   passResourceAccesses_.clear();
   frameOutputTextureSet_.clear();
   frameOutputTextureIndices_.clear();
+  historyOutputTextureSet_.clear();
+  historyOutputTextureIndices_.clear();
   sideEffectMarkIndicesByPass_.clear();
   sideEffectPassMarks_.clear();
+  if (history_ != nullptr) {
+    history_->beginFrame(frameIndex);
+  }
 }
 
 Result<RenderGraphTextureId, std::string>
@@ -347,6 +376,47 @@ RenderGraphBuilder::createTransientTexture(const TextureDesc &desc,
       RenderGraphTextureId{.value = textureIndex});
 }
 
+Result<RenderGraphHistoryTexture, std::string>
+RenderGraphBuilder::importHistoryTexture(std::string_view key,
+                                         const TextureDesc &desc) {
+  if (history_ == nullptr) {
+    return Result<RenderGraphHistoryTexture, std::string>::makeError(
+        "RenderGraphBuilder::importHistoryTexture: no history resources are "
+        "attached");
+  }
+
+  auto acquireResult = history_->acquireTexture(key, desc);
+  if (acquireResult.hasError()) {
+    return Result<RenderGraphHistoryTexture, std::string>::makeError(
+        acquireResult.error());
+  }
+  const RenderGraphHistoryTextureHandles &handles = acquireResult.value();
+
+  auto currentResult = importTexture(handles.current, key);
+  if (currentResult.hasError()) {
+    return Result<RenderGraphHistoryTexture, std::string>::makeError(
+        currentResult.error());
+  }
+  auto previousResult = importTexture(handles.previous, key);
+  if (previousResult.hasError()) {
+    return Result<RenderGraphHistoryTexture, std::string>::makeError(
+        previousResult.error());
+  }
+
+  const uint32_t currentIndex = currentResult.value().value;
+  if (historyOutputTextureSet_.insert(currentIndex).second) {
+    historyOutputTextureIndices_.push_back(currentIndex);
+  }
+
+  return Result<RenderGraphHistoryTexture, std::string>::makeResult(
+      RenderGraphHistoryTexture{
+          .current = currentResult.value(),
+          .previous = previousResult.value(),
+          .previousTexture = handles.previous,
+          .previousValid = handles.previousValid,
+      });
+}
+
 Result<RenderGraphBufferId, std::string>
 RenderGraphBuilder::createTransientBuffer(const BufferDesc &desc,
                                           std::string_view debugName) {
@@ -377,7 +447,7 @@ RenderGraphBuilder::createTransientBuffer(const BufferDesc &desc,
 
 Result<bool, std::string> RenderGraphBuilder::addTextureAccessInternal(
     RenderGraphPassId pass, RenderGraphTextureId texture,
-    RenderGraphAccessMode mode, bool inferred) {
+    RenderGraphAccessMode mode, bool inferred, RenderGraphStage stages) {
   if (!isValid(pass) || !isValid(texture)) {
     return Result<bool, std::string>::makeError(
         "RenderGraphBuilder::addTextureAccessInternal: id is invalid");
@@ -401,6 +471,10 @@ Result<bool, std::string> RenderGraphBuilder::addTextureAccessInternal(
       existing != indexByKey.end()) {
     PassResourceAccess &merged = passResourceAccesses_[existing->second];
     merged.mode = merged.mode | mode;
+    // Merge resolved stages so an unstaged explicit access keeps its
+    // fallback next to a binding's precise stage.
+    merged.stages = resolveAccessStages(pass.value, merged.stages) |
+                    resolveAccessStages(pass.value, stages);
     return Result<bool, std::string>::makeResult(true);
   }
 
@@ -417,6 +491,7 @@ Result<bool, std::string> RenderGraphBuilder::addTextureAccessInternal(
       .resourceKind = AccessResourceKind::Texture,
       .resourceIndex = texture.value,
       .mode = mode,
+      .stages = stages,
       .inferred = inferred,
   });
   indexByKey.emplace(key, accessIndex);
@@ -432,7 +507,7 @@ RenderGraphBuilder::addTextureAccess(RenderGraphPassId pass,
 
 Result<bool, std::string> RenderGraphBuilder::addBufferAccessInternal(
     RenderGraphPassId pass, RenderGraphBufferId buffer,
-    RenderGraphAccessMode mode, bool inferred) {
+    RenderGraphAccessMode mode, bool inferred, RenderGraphStage stages) {
   if (!isValid(pass) || !isValid(buffer)) {
     return Result<bool, std::string>::makeError(
         "RenderGraphBuilder::addBufferAccessInternal: id is invalid");
@@ -455,6 +530,10 @@ Result<bool, std::string> RenderGraphBuilder::addBufferAccessInternal(
       existing != indexByKey.end()) {
     PassResourceAccess &merged = passResourceAccesses_[existing->second];
     merged.mode = merged.mode | mode;
+    // Merge resolved stages so an unstaged explicit access keeps its
+    // fallback next to a binding's precise stage.
+    merged.stages = resolveAccessStages(pass.value, merged.stages) |
+                    resolveAccessStages(pass.value, stages);
     return Result<bool, std::string>::makeResult(true);
   }
 
@@ -471,6 +550,7 @@ Result<bool, std::string> RenderGraphBuilder::addBufferAccessInternal(
       .resourceKind = AccessResourceKind::Buffer,
       .resourceIndex = buffer.value,
       .mode = mode,
+      .stages = stages,
       .inferred = inferred,
   });
   indexByKey.emplace(key, accessIndex);
@@ -515,12 +595,47 @@ RenderGraphBuilder::OwnedPassPayload RenderGraphBuilder::clonePassPayload(
                                  desc.debugLabel.size());
   ownedPayload.dependencyBuffers.assign(desc.dependencyBuffers.begin(),
                                         desc.dependencyBuffers.end());
+  cloneDispatchPayload(desc.preDispatches, ownedPayload);
+
+  ownedPayload.drawDebugLabels.reserve(desc.draws.size());
+  ownedPayload.drawPushConstants.reserve(desc.draws.size());
+  ownedPayload.draws.reserve(desc.draws.size());
+  for (const DrawItem &sourceDraw : desc.draws) {
+    ownedPayload.drawDebugLabels.push_back(std::pmr::string(memory_));
+    auto &label = ownedPayload.drawDebugLabels.back();
+    label.assign(sourceDraw.debugLabel.data(), sourceDraw.debugLabel.size());
 
-  ownedPayload.preDispatchDebugLabels.reserve(desc.preDispatches.size());
-  ownedPayload.preDispatchPushConstants.reserve(desc.preDispatches.size());
-  ownedPayload.preDispatchDependencyBuffers.reserve(desc.preDispatches.size());
-  ownedPayload.preDispatches.reserve(desc.preDispatches.size());
-  for (const ComputeDispatchItem &sourceDispatch : desc.preDispatches) {
+    ownedPayload.drawPushConstants.push_back(
+        std::pmr::vector<std::byte>(memory_));
+    auto &pushConstants = ownedPayload.drawPushConstants.back();
+    pushConstants.assign(sourceDraw.pushConstants.begin(),
+                         sourceDraw.pushConstants.end());
+  }
+  ownedPayload.drawStream.assign(desc.drawStream.begin(),
+                                desc.drawStream.end());
+  ownedPayload.draws.resize(desc.draws.size());
+  for (size_t i = 0; i < desc.draws.size(); ++i) {
+    const DrawItem &sourceDraw = desc.draws[i];
+    DrawItem &draw = ownedPayload.draws[i];
+    draw = sourceDraw;
+    draw.pushConstants =
+        std::span<const std::byte>(ownedPayload.drawPushConstants[i].data(),
+                                   ownedPayload.drawPushConstants[i].size());
+    draw.debugLabel = std::string_view(ownedPayload.drawDebugLabels[i].data(),
+                                       ownedPayload.drawDebugLabels[i].size());
+  }
+
+  return ownedPayload;
+}
+
+void RenderGraphBuilder::cloneDispatchPayload(
+    std::span<const ComputeDispatchItem> dispatches,
+    OwnedPassPayload &ownedPayload) const {
+  ownedPayload.preDispatchDebugLabels.reserve(dispatches.size());
+  ownedPayload.preDispatchPushConstants.reserve(dispatches.size());
+  ownedPayload.preDispatchDependencyBuffers.reserve(dispatches.size());
+  ownedPayload.preDispatches.reserve(dispatches.size());
+  for (const ComputeDispatchItem &sourceDispatch : dispatches) {
     ownedPayload.preDispatchDebugLabels.push_back(std::pmr::string(memory_));
     auto &label = ownedPayload.preDispatchDebugLabels.back();
     label.assign(sourceDispatch.debugLabel.data(),
@@ -538,9 +653,9 @@ RenderGraphBuilder::OwnedPassPayload RenderGraphBuilder::clonePassPayload(
     dependencyBuffers.assign(sourceDispatch.dependencyBuffers.begin(),
                              sourceDispatch.dependencyBuffers.end());
   }
-  ownedPayload.preDispatches.resize(desc.preDispatches.size());
-  for (size_t i = 0; i < desc.preDispatches.size(); ++i) {
-    const ComputeDispatchItem &sourceDispatch = desc.preDispatches[i];
+  ownedPayload.preDispatches.resize(dispatches.size());
+  for (size_t i = 0; i < dispatches.size(); ++i) {
+    const ComputeDispatchItem &sourceDispatch = dispatches[i];
     ComputeDispatchItem &dispatch = ownedPayload.preDispatches[i];
     dispatch = sourceDispatch;
     dispatch.pushConstants = std::span<const std::byte>(
@@ -553,38 +668,25 @@ RenderGraphBuilder::OwnedPassPayload RenderGraphBuilder::clonePassPayload(
         std::string_view(ownedPayload.preDispatchDebugLabels[i].data(),
                          ownedPayload.preDispatchDebugLabels[i].size());
   }
-
-  ownedPayload.drawDebugLabels.reserve(desc.draws.size());
-  ownedPayload.drawPushConstants.reserve(desc.draws.size());
-  ownedPayload.draws.reserve(desc.draws.size());
-  for (const DrawItem &sourceDraw : desc.draws) {
-    ownedPayload.drawDebugLabels.push_back(std::pmr::string(memory_));
-    auto &label = ownedPayload.drawDebugLabels.back();
-    label.assign(sourceDraw.debugLabel.data(), sourceDraw.debugLabel.size());
-
-    ownedPayload.drawPushConstants.push_back(
-        std::pmr::vector<std::byte>(memory_));
-    auto &pushConstants = ownedPayload.drawPushConstants.back();
-    pushConstants.assign(sourceDraw.pushConstants.begin(),
-                         sourceDraw.pushConstants.end());
-  }
-  ownedPayload.draws.resize(desc.draws.size());
-  for (size_t i = 0; i < desc.draws.size(); ++i) {
-    const DrawItem &sourceDraw = desc.draws[i];
-    DrawItem &draw = ownedPayload.draws[i];
-    draw = sourceDraw;
-    draw.pushConstants =
-        std::span<const std::byte>(ownedPayload.drawPushConstants[i].data(),
-                                   ownedPayload.drawPushConstants[i].size());
-    draw.debugLabel = std::string_view(ownedPayload.drawDebugLabels[i].data(),
-                                       ownedPayload.drawDebugLabels[i].size());
-  }
-
-  return ownedPayload;
 }
 
 Result<bool, std::string> RenderGraphBuilder::applyImplicitPassRoots(
     RenderGraphPassId pass, const RenderGraphGraphicsPassDesc &desc) {
+  if (desc.markImplicitOutputSideEffect) {
+    for (const RenderGraphColorAttachment &attachment :
+         desc.additionalColorAttachments) {
+      if (!nuri::isValid(attachment.texture) ||
+          !textures_[attachment.texture.value].imported) {
+        continue;
+      }
+      auto markResult = markPassSideEffect(pass);
+      if (markResult.hasError()) {
+        return markResult;
+      }
+      break;
+    }
+  }
+
   if (nuri::isValid(desc.colorTexture)) {
     if (desc.markColorAsFrameOutput) {
       return markTextureAsFrameOutput(desc.colorTexture);
@@ -611,6 +713,19 @@ Result<bool, std::string> RenderGraphBuilder::bindImplicitPassResources(
     }
   }
 
+  for (size_t i = 0; i < desc.additionalColorAttachments.size(); ++i) {
+    const RenderGraphTextureId texture =
+        desc.additionalColorAttachments[i].texture;
+    if (!nuri::isValid(texture)) {
+      continue;
+    }
+    auto bindResult = bindPassAdditionalColorTexture(
+        pass, static_cast<uint32_t>(i), texture);
+    if (bindResult.hasError()) {
+      return bindResult;
+    }
+  }
+
   if (nuri::isValid(desc.depthTexture)) {
     auto bindResult = bindPassDepthTexture(pass, desc.depthTexture);
     if (bindResult.hasError()) {
@@ -639,34 +754,10 @@ Result<bool, std::string> RenderGraphBuilder::bindImplicitPassResources(
     }
   }
 
-  const std::string preDispatchDependencyDebugName = makePassResourceDebugName(
-      desc.debugLabel, "pre_dispatch_dependency_buffer");
-  for (size_t dispatchIndex = 0; dispatchIndex < desc.preDispatches.size();
-       ++dispatchIndex) {
-    const ComputeDispatchItem &dispatch = desc.preDispatches[dispatchIndex];
-    for (size_t dependencyIndex = 0;
-         dependencyIndex < dispatch.dependencyBuffers.size();
-         ++dependencyIndex) {
-      const BufferHandle dependency =
-          dispatch.dependencyBuffers[dependencyIndex];
-      if (!nuri::isValid(dependency)) {
-        continue;
-      }
-
-      auto importResult =
-          importBuffer(dependency, preDispatchDependencyDebugName);
-      if (importResult.hasError()) {
-        return Result<bool, std::string>::makeError(importResult.error());
-      }
-
-      auto bindResult = bindPreDispatchDependencyBuffer(
-          pass, static_cast<uint32_t>(dispatchIndex),
-          static_cast<uint32_t>(dependencyIndex), importResult.value(),
-          RenderGraphAccessMode::Read | RenderGraphAccessMode::Write);
-      if (bindResult.hasError()) {
-        return bindResult;
-      }
-    }
+  auto dispatchBindResult =
+      bindDispatchDependencyBuffers(pass, desc.preDispatches, desc.debugLabel);
+  if (dispatchBindResult.hasError()) {
+    return dispatchBindResult;
   }
 
   const std::string drawDebugName =
@@ -706,13 +797,123 @@ Result<bool, std::string> RenderGraphBuilder::bindImplicitPassResources(
     }
   }
 
+  // Stream records carry concrete handles, so their buffers only need an
+  // imported read access for hazard tracking; no per-draw binding slots.
+  DrawStreamReader streamReader(desc.drawStream);
+  DrawStreamCommand command{};
+  while (true) {
+    auto nextResult = streamReader.next(command);
+    if (nextResult.hasError()) {
+      return Result<bool, std::string>::makeError(nextResult.error());
+    }
+    if (!nextResult.value()) {
+      break;
+    }
+
+    std::array<BufferHandle, 2> buffers{};
+    RenderGraphStage stages = RenderGraphStage::DrawIndirect;
+    switch (command.op) {
+    case DrawStreamOp::BindVertexBuffer:
+      buffers[0] = command.as<DrawStreamBindVertexBuffer>().buffer;
+      stages = RenderGraphStage::VertexInput;
+      break;
+    case DrawStreamOp::BindIndexBuffer:
+      buffers[0] = command.as<DrawStreamBindIndexBuffer>().buffer;
+      stages = RenderGraphStage::IndexInput;
+      break;
+    case DrawStreamOp::DrawIndexedIndirect:
+      buffers[0] = command.as<DrawStreamDrawIndexedIndirect>().buffer;
+      break;
+    case DrawStreamOp::DrawIndexedIndirectCount: {
+      const auto indirect = command.as<DrawStreamDrawIndexedIndirectCount>();
+      buffers[0] = indirect.buffer;
+      buffers[1] = indirect.countBuffer;
+      break;
+    }
+    default:
+      continue;
+    }
+
+    for (const BufferHandle buffer : buffers) {
+      if (!nuri::isValid(buffer)) {
+        continue;
+      }
+      auto importResult = importBuffer(buffer, drawDebugName);
+      if (importResult.hasError()) {
+        return Result<bool, std::string>::makeError(importResult.error());
+      }
+      auto readResult =
+          addBufferAccessInternal(pass, importResult.value(),
+                                  RenderGraphAccessMode::Read, false, stages);
+      if (readResult.hasError()) {
+        return readResult;
+      }
+    }
+  }
+
+  return Result<bool, std::string>::makeResult(true);
+}
+
+Result<bool, std::string> RenderGraphBuilder::bindDispatchDependencyBuffers(
+    RenderGraphPassId pass, std::span<const ComputeDispatchItem> dispatches,
+    std::string_view debugLabel) {
+  const std::string preDispatchDependencyDebugName = makePassResourceDebugName(
+      debugLabel, "pre_dispatch_dependency_buffer");
+  for (size_t dispatchIndex = 0; dispatchIndex < dispatches.size();
+       ++dispatchIndex) {
+    const ComputeDispatchItem &dispatch = dispatches[dispatchIndex];
+    for (size_t dependencyIndex = 0;
+         dependencyIndex < dispatch.dependencyBuffers.size();
+         ++dependencyIndex) {
+      const BufferHandle dependency =
+          dispatch.dependencyBuffers[dependencyIndex];
+      if (!nuri::isValid(dependency)) {
+        continue;
+      }
+
+      auto importResult =
+          importBuffer(dependency, preDispatchDependencyDebugName);
+      if (importResult.hasError()) {
+        return Result<bool, std::string>::makeError(importResult.error());
+      }
+
+      auto bindResult = bindPreDispatchDependencyBuffer(
+          pass, static_cast<uint32_t>(dispatchIndex),
+          static_cast<uint32_t>(dependencyIndex), importResult.value(),
+          RenderGraphAccessMode::Read | RenderGraphAccessMode::Write);
+      if (bindResult.hasError()) {
+        return bindResult;
+      }
+    }
+  }
+
   return Result<bool, std::string>::makeResult(true);
 }
 
 Result<RenderGraphPassId, std::string>
 RenderGraphBuilder::addGraphicsPass(const RenderGraphGraphicsPassDesc &desc) {
+  if (desc.additionalColorAttachments.size() >
+      kMaxAdditionalColorAttachments) {
+    return Result<RenderGraphPassId, std::string>::makeError(
+        "RenderGraphBuilder::addGraphicsPass: additional color attachment "
+        "count exceeds kMaxAdditionalColorAttachments");
+  }
+
+  if (!desc.drawStream.empty()) {
+    auto streamResult = validateDrawStream(desc.drawStream);
+    if (streamResult.hasError()) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          "RenderGraphBuilder::addGraphicsPass: " + streamResult.error());
+    }
+  }
+
   RenderPass pass{};
   pass.color = desc.color;
+  for (size_t i = 0; i < desc.additionalColorAttachments.size(); ++i) {
+    pass.additionalColors[i] = desc.additionalColorAttachments[i].color;
+  }
+  pass.additionalColorCount =
+      static_cast<uint32_t>(desc.additionalColorAttachments.size());
   pass.depth = desc.depth;
   pass.useViewport = desc.useViewport;
   pass.viewport = desc.viewport;
@@ -739,6 +940,128 @@ RenderGraphBuilder::addGraphicsPass(const RenderGraphGraphicsPassDesc &desc) {
   return Result<RenderGraphPassId, std::string>::makeResult(passId);
 }
 
+Result<RenderGraphPassId, std::string>
+RenderGraphBuilder::addComputePass(const RenderGraphComputePassDesc &desc) {
+  if (desc.dispatches.empty()) {
+    return Result<RenderGraphPassId, std::string>::makeError(
+        "RenderGraphBuilder::addComputePass: pass has no dispatches");
+  }
+
+  RenderPass pass{};
+  pass.kind = RenderPassKind::Compute;
+  pass.debugColor = desc.debugColor;
+
+  OwnedPassPayload ownedPayload(memory_);
+  ownedPayload.debugLabel.assign(desc.debugLabel.data(),
+                                 desc.debugLabel.size());
+  cloneDispatchPayload(desc.dispatches, ownedPayload);
+
+  auto addResult =
+      addPassRecord(pass, std::move(ownedPayload), desc.debugLabel);
+  if (addResult.hasError()) {
+    return Result<RenderGraphPassId, std::string>::makeError(addResult.error());
+  }
+  const RenderGraphPassId passId = addResult.value();
+
+  auto bindResult =
+      bindDispatchDependencyBuffers(passId, desc.dispatches, desc.debugLabel);
+  if (bindResult.hasError()) {
+    return Result<RenderGraphPassId, std::string>::makeError(
+        bindResult.error());
+  }
+
+  if (desc.markSideEffect) {
+    auto markResult = markPassSideEffect(passId);
+    if (markResult.hasError()) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          markResult.error());
+    }
+  }
+
+  return Result<RenderGraphPassId, std::string>::makeResult(passId);
+}
+
+Result<RenderGraphPassId, std::string>
+RenderGraphBuilder::addTransferPass(const RenderGraphTransferPassDesc &desc) {
+  if (desc.copies.empty()) {
+    return Result<RenderGraphPassId, std::string>::makeError(
+        "RenderGraphBuilder::addTransferPass: pass has no copies");
+  }
+  for (const RenderGraphBufferCopy &copy : desc.copies) {
+    if (!isValid(copy.source) || !isValid(copy.destination)) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          "RenderGraphBuilder::addTransferPass: copy buffer id is invalid");
+    }
+    if (!isValidBufferIndex(copy.source.value) ||
+        !isValidBufferIndex(copy.destination.value)) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          "RenderGraphBuilder::addTransferPass: copy buffer id is out of "
+          "range");
+    }
+    if (copy.size == 0u) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          "RenderGraphBuilder::addTransferPass: copy size must be non-zero");
+    }
+    if (copy.source.value == copy.destination.value) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          "RenderGraphBuilder::addTransferPass: copy source and destination "
+          "must differ");
+    }
+  }
+
+  RenderPass pass{};
+  pass.kind = RenderPassKind::Transfer;
+  pass.debugColor = desc.debugColor;
+
+  OwnedPassPayload ownedPayload(memory_);
+  ownedPayload.debugLabel.assign(desc.debugLabel.data(),
+                                 desc.debugLabel.size());
+  ownedPayload.copies.reserve(desc.copies.size());
+  for (const RenderGraphBufferCopy &copy : desc.copies) {
+    ownedPayload.copies.push_back(BufferCopyRegion{
+        .srcOffset = copy.sourceOffset,
+        .dstOffset = copy.destinationOffset,
+        .size = copy.size,
+    });
+  }
+
+  auto addResult =
+      addPassRecord(pass, std::move(ownedPayload), desc.debugLabel);
+  if (addResult.hasError()) {
+    return Result<RenderGraphPassId, std::string>::makeError(addResult.error());
+  }
+  const RenderGraphPassId passId = addResult.value();
+
+  const uint32_t copyOffset = passCopyBindingOffsets_[passId.value];
+  for (size_t i = 0; i < desc.copies.size(); ++i) {
+    const RenderGraphBufferCopy &copy = desc.copies[i];
+    copySourceBindingResourceIndices_[copyOffset + i] = copy.source.value;
+    copyDestinationBindingResourceIndices_[copyOffset + i] =
+        copy.destination.value;
+
+    auto readResult = addBufferRead(passId, copy.source);
+    if (readResult.hasError()) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          readResult.error());
+    }
+    auto writeResult = addBufferWrite(passId, copy.destination);
+    if (writeResult.hasError()) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          writeResult.error());
+    }
+  }
+
+  if (desc.markSideEffect) {
+    auto markResult = markPassSideEffect(passId);
+    if (markResult.hasError()) {
+      return Result<RenderGraphPassId, std::string>::makeError(
+          markResult.error());
+    }
+  }
+
+  return Result<RenderGraphPassId, std::string>::makeResult(passId);
+}
+
 Result<RenderGraphPassId, std::string>
 RenderGraphBuilder::addPassRecord(RenderPass pass,
                                   OwnedPassPayload ownedPayload,
@@ -755,6 +1078,8 @@ RenderGraphBuilder::addPassRecord(RenderPass pass,
       static_cast<uint32_t>(preDispatchDependencyBindingOffsets_.size());
   const uint32_t drawBindingOffset =
       static_cast<uint32_t>(drawVertexBindingResourceIndices_.size());
+  const uint32_t copyBindingOffset =
+      static_cast<uint32_t>(copySourceBindingResourceIndices_.size());
   const RenderGraphPassId passId{.value = passIndex};
 
   const size_t dependencyCount = ownedPayload.dependencyBuffers.size();
@@ -794,6 +1119,12 @@ RenderGraphBuilder::addPassRecord(RenderPass pass,
         "RenderGraphBuilder::addPassRecord: draw count exceeds uint32_t");
   }
 
+  const size_t copyCount = ownedPayload.copies.size();
+  if (copyCount > UINT32_MAX) {
+    return Result<RenderGraphPassId, std::string>::makeError(
+        "RenderGraphBuilder::addPassRecord: copy count exceeds uint32_t");
+  }
+
   ownedPassPayloads_.push_back(std::move(ownedPayload));
   OwnedPassPayload &storedPayload = ownedPassPayloads_.back();
   pass.preDispatches = std::span<const ComputeDispatchItem>(
@@ -803,6 +1134,10 @@ RenderGraphBuilder::addPassRecord(RenderPass pass,
                                     storedPayload.dependencyBuffers.size());
   pass.draws = std::span<const DrawItem>(storedPayload.draws.data(),
                                          storedPayload.draws.size());
+  pass.drawStream = std::span<const std::byte>(
+      storedPayload.drawStream.data(), storedPayload.drawStream.size());
+  pass.copies = std::span<const BufferCopyRegion>(storedPayload.copies.data(),
+                                                  storedPayload.copies.size());
   pass.debugLabel = std::string_view(storedPayload.debugLabel.data(),
                                      storedPayload.debugLabel.size());
 
@@ -814,6 +1149,9 @@ RenderGraphBuilder::addPassRecord(RenderPass pass,
   passDebugNames_.push_back(std::move(resolvedName));
   passColorTextureBindings_.push_back(UINT32_MAX);
   passDepthTextureBindings_.push_back(UINT32_MAX);
+  passAdditionalColorTextureBindings_.insert(
+      passAdditionalColorTextureBindings_.end(), kMaxAdditionalColorAttachments,
+      UINT32_MAX);
   passDependencyBufferBindingOffsets_.push_back(dependencyBindingOffset);
   passDependencyBufferBindingCounts_.push_back(
       static_cast<uint32_t>(dependencyCount));
@@ -843,6 +1181,13 @@ RenderGraphBuilder::addPassRecord(RenderPass pass,
     drawIndirectBindingResourceIndices_.push_back(UINT32_MAX);
     drawIndirectCountBindingResourceIndices_.push_back(UINT32_MAX);
   }
+
+  passCopyBindingOffsets_.push_back(copyBindingOffset);
+  passCopyBindingCounts_.push_back(static_cast<uint32_t>(copyCount));
+  for (size_t i = 0; i < copyCount; ++i) {
+    copySourceBindingResourceIndices_.push_back(UINT32_MAX);
+    copyDestinationBindingResourceIndices_.push_back(UINT32_MAX);
+  }
   return Result<RenderGraphPassId, std::string>::makeResult(passId);
 }
 
@@ -871,7 +1216,46 @@ RenderGraphBuilder::bindPassColorTexture(RenderGraphPassId pass,
   if (mode == RenderGraphAccessMode::None) {
     return Result<bool, std::string>::makeResult(true);
   }
-  return addTextureAccess(pass, texture, mode);
+  return addTextureAccessInternal(pass, texture, mode, false,
+                                  RenderGraphStage::ColorAttachment);
+}
+
+Result<bool, std::string> RenderGraphBuilder::bindPassAdditionalColorTexture(
+    RenderGraphPassId pass, uint32_t additionalColorIndex,
+    RenderGraphTextureId texture) {
+  if (!isValid(pass) || !isValid(texture)) {
+    return Result<bool, std::string>::makeError(
+        "RenderGraphBuilder::bindPassAdditionalColorTexture: id is invalid");
+  }
+  if (!isValidPassIndex(pass.value) || !isValidTextureIndex(texture.value)) {
+    return Result<bool, std::string>::makeError(
+        "RenderGraphBuilder::bindPassAdditionalColorTexture: id is out of "
+        "range");
+  }
+  const RenderPass &targetPass = passes_[pass.value];
+  if (additionalColorIndex >= targetPass.additionalColorCount) {
+    return Result<bool, std::string>::makeError(
+        "RenderGraphBuilder::bindPassAdditionalColorTexture: attachment index "
+        "is out of range");
+  }
+  const size_t bindingIndex =
+      static_cast<size_t>(pass.value) * kMaxAdditionalColorAttachments +
+      additionalColorIndex;
+  if (bindingIndex >= passAdditionalColorTextureBindings_.size()) {
+    return Result<bool, std::string>::makeError(
+        "RenderGraphBuilder::bindPassAdditionalColorTexture: pass binding "
+        "table is out of sync");
+  }
+
+  passAdditionalColorTextureBindings_[bindingIndex] = texture.value;
+
+  const RenderGraphAccessMode mode = attachmentAccessMode(
+      targetPass.additionalColors[additionalColorIndex].loadOp);
+  if (mode == RenderGraphAccessMode::None) {
+    return Result<bool, std::string>::makeResult(true);
+  }
+  return addTextureAccessInternal(pass, texture, mode, false,
+                                  RenderGraphStage::ColorAttachment);
 }
 
 Result<bool, std::string>
@@ -899,7 +1283,8 @@ RenderGraphBuilder::bindPassDepthTexture(RenderGraphPassId pass,
   if (mode == RenderGraphAccessMode::None) {
     return Result<bool, std::string>::makeResult(true);
   }
-  return addTextureAccess(pass, texture, mode);
+  return addTextureAccessInternal(pass, texture, mode, false,
+                                  RenderGraphStage::DepthAttachment);
 }
 
 Result<bool, std::string> RenderGraphBuilder::bindPassDependencyBuffer(
@@ -948,7 +1333,9 @@ Result<bool, std::string> RenderGraphBuilder::bindPassDependencyBuffer(
 
   passDependencyBufferBindingResourceIndices_[offset + dependencyIndex] =
       buffer.value;
-  return addBufferAccess(pass, buffer, mode);
+  return addBufferAccessInternal(pass, buffer, mode, false,
+                                 RenderGraphStage::VertexShader |
+                                     RenderGraphStage::FragmentShader);
 }
 
 Result<bool, std::string> RenderGraphBuilder::bindPreDispatchDependencyBuffer(
@@ -1019,7 +1406,8 @@ Result<bool, std::string> RenderGraphBuilder::bindPreDispatchDependencyBuffer(
 
   preDispatchDependencyBindingResourceIndices_[dependencyOffset +
                                                dependencyIndex] = buffer.value;
-  return addBufferAccess(pass, buffer, mode);
+  return addBufferAccessInternal(pass, buffer, mode, false,
+                                 RenderGraphStage::ComputeShader);
 }
 
 Result<bool, std::string> RenderGraphBuilder::bindDrawBuffer(
@@ -1064,22 +1452,27 @@ Result<bool, std::string> RenderGraphBuilder::bindDrawBuffer(
   }
 
   uint32_t *targetTableEntry = nullptr;
+  RenderGraphStage stages = RenderGraphStage::None;
   switch (target) {
   case RenderGraphCompileResult::DrawBufferBindingTarget::Vertex:
     targetTableEntry =
         &drawVertexBindingResourceIndices_[drawOffset + drawIndex];
+    stages = RenderGraphStage::VertexInput;
     break;
   case RenderGraphCompileResult::DrawBufferBindingTarget::Index:
     targetTableEntry =
         &drawIndexBindingResourceIndices_[drawOffset + drawIndex];
+    stages = RenderGraphStage::IndexInput;
     break;
   case RenderGraphCompileResult::DrawBufferBindingTarget::Indirect:
     targetTableEntry =
         &drawIndirectBindingResourceIndices_[drawOffset + drawIndex];
+    stages = RenderGraphStage::DrawIndirect;
     break;
   case RenderGraphCompileResult::DrawBufferBindingTarget::IndirectCount:
     targetTableEntry =
         &drawIndirectCountBindingResourceIndices_[drawOffset + drawIndex];
+    stages = RenderGraphStage::DrawIndirect;
     break;
   default:
     return Result<bool, std::string>::makeError(
@@ -1087,7 +1480,7 @@ Result<bool, std::string> RenderGraphBuilder::bindDrawBuffer(
   }
 
   *targetTableEntry = buffer.value;
-  return addBufferAccess(pass, buffer, mode);
+  return addBufferAccessInternal(pass, buffer, mode, false, stages);
 }
 
 Result<bool, std::string>
@@ -1228,7 +1621,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC0ValidateInputs(
           makeValidationRanges(static_cast<uint32_t>(textures_.size()),
                                workerCount);
       if (stdRanges.size() > 1u) {
-        std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+        std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
         ranges.assign(stdRanges.begin(), stdRanges.end());
         runtime.runRanges(std::span<const RenderGraphContiguousRange>(
                               ranges.data(), ranges.size()),
@@ -1308,7 +1701,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC0ValidateInputs(
           makeValidationRanges(static_cast<uint32_t>(buffers_.size()),
                                workerCount);
       if (stdRanges.size() > 1u) {
-        std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+        std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
         ranges.assign(stdRanges.begin(), stdRanges.end());
         runtime.runRanges(std::span<const RenderGraphContiguousRange>(
                               ranges.data(), ranges.size()),
@@ -1399,7 +1792,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC0ValidateInputs(
           makeValidationRanges(
               static_cast<uint32_t>(passResourceAccesses_.size()), workerCount);
       if (stdRanges.size() > 1u) {
-        std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+        std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
         ranges.assign(stdRanges.begin(), stdRanges.end());
         runtime.runRanges(std::span<const RenderGraphContiguousRange>(
                               ranges.data(), ranges.size()),
@@ -1435,16 +1828,26 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC0ValidateInputs(
   }
   if (passColorTextureBindings_.size() != passes_.size() ||
       passDepthTextureBindings_.size() != passes_.size() ||
+      passAdditionalColorTextureBindings_.size() !=
+          passes_.size() * kMaxAdditionalColorAttachments ||
       passDependencyBufferBindingOffsets_.size() != passes_.size() ||
       passDependencyBufferBindingCounts_.size() != passes_.size() ||
       passPreDispatchBindingOffsets_.size() != passes_.size() ||
       passPreDispatchBindingCounts_.size() != passes_.size() ||
       passDrawBindingOffsets_.size() != passes_.size() ||
-      passDrawBindingCounts_.size() != passes_.size()) {
+      passDrawBindingCounts_.size() != passes_.size() ||
+      passCopyBindingOffsets_.size() != passes_.size() ||
+      passCopyBindingCounts_.size() != passes_.size()) {
     return Result<bool, std::string>::makeError(
         "RenderGraphBuilder::compile: pass texture binding tables are out of "
         "sync");
   }
+  if (copySourceBindingResourceIndices_.size() !=
+      copyDestinationBindingResourceIndices_.size()) {
+    return Result<bool, std::string>::makeError(
+        "RenderGraphBuilder::compile: copy buffer binding tables are out of "
+        "sync");
+  }
   if (drawVertexBindingResourceIndices_.size() !=
           drawIndexBindingResourceIndices_.size() ||
       drawVertexBindingResourceIndices_.size() !=
@@ -1501,12 +1904,18 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
 
       RenderGraphAccessMode explicitMode = RenderGraphAccessMode::None;
       RenderGraphAccessMode inferredMode = RenderGraphAccessMode::None;
+      RenderGraphStage explicitStages = RenderGraphStage::None;
+      RenderGraphStage inferredStages = RenderGraphStage::None;
       for (size_t i = groupBegin; i < groupEnd; ++i) {
+        const RenderGraphStage stages =
+            resolveAccessStages(work.compiledAccesses[i]);
         if (work.compiledAccesses[i].inferred) {
           inferredMode = inferredMode | work.compiledAccesses[i].mode;
+          inferredStages = inferredStages | stages;
           continue;
         }
         explicitMode = explicitMode | work.compiledAccesses[i].mode;
+        explicitStages = explicitStages | stages;
       }
 
       const bool hasExplicit =
@@ -1521,6 +1930,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
             .resourceKind = work.compiledAccesses[groupBegin].resourceKind,
             .resourceIndex = work.compiledAccesses[groupBegin].resourceIndex,
             .mode = selectedMode,
+            .stages = hasExplicit ? explicitStages : inferredStages,
             .inferred = !hasExplicit,
         };
       }
@@ -1531,10 +1941,10 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
 
   NURI_PROFILER_ZONE("RenderGraph.compile.build_topology",
                      NURI_PROFILER_COLOR_BARRIER);
-  PmrHashSet<uint64_t> dependencyEdgeKeys(memory_);
+  PmrHashSet<uint64_t> dependencyEdgeKeys(frameMemory_);
   dependencyEdgeKeys.reserve(dependencies_.size() +
                              work.compiledAccesses.size() * 2u);
-  std::pmr::vector<DependencyEdge> allDependencies(memory_);
+  std::pmr::vector<DependencyEdge> allDependencies(frameMemory_);
   for (const DependencyEdge edge : dependencies_) {
     const uint64_t key =
         (static_cast<uint64_t>(edge.before) << 32u) | edge.after;
@@ -1658,7 +2068,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
 
     std::vector<std::vector<uint64_t>> workerEdgeKeys(stdRanges.size());
     if (canParallelizeHazards && stdRanges.size() > 1u) {
-      std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+      std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
       ranges.assign(stdRanges.begin(), stdRanges.end());
       runtime.runRanges(
           std::span<const RenderGraphContiguousRange>(ranges.data(),
@@ -1693,10 +2103,11 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
   addResourceHazards(AccessResourceKind::Buffer);
 
   work.activePassMask.resize(work.passCount, 1u);
-  if (!frameOutputTextureIndices_.empty() || !sideEffectPassMarks_.empty()) {
+  if (!frameOutputTextureIndices_.empty() ||
+      !historyOutputTextureIndices_.empty() || !sideEffectPassMarks_.empty()) {
     std::fill(work.activePassMask.begin(), work.activePassMask.end(), 0u);
 
-    std::pmr::vector<uint32_t> reverseCount(memory_);
+    std::pmr::vector<uint32_t> reverseCount(frameMemory_);
     reverseCount.resize(work.passCount, 0u);
     for (const DependencyEdge edge : allDependencies) {
       if (edge.before >= work.passCount || edge.after >= work.passCount) {
@@ -1707,21 +2118,21 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
       ++reverseCount[edge.after];
     }
 
-    std::pmr::vector<uint32_t> reverseOffsets(memory_);
+    std::pmr::vector<uint32_t> reverseOffsets(frameMemory_);
     reverseOffsets.resize(static_cast<size_t>(work.passCount) + 1u, 0u);
     for (uint32_t i = 0; i < work.passCount; ++i) {
       reverseOffsets[i + 1u] = reverseOffsets[i] + reverseCount[i];
     }
 
-    std::pmr::vector<uint32_t> reverseEdges(memory_);
+    std::pmr::vector<uint32_t> reverseEdges(frameMemory_);
     reverseEdges.resize(allDependencies.size(), 0u);
-    std::pmr::vector<uint32_t> reverseCursor(memory_);
+    std::pmr::vector<uint32_t> reverseCursor(frameMemory_);
     reverseCursor = reverseOffsets;
     for (const DependencyEdge edge : allDependencies) {
       reverseEdges[reverseCursor[edge.after]++] = edge.before;
     }
 
-    std::pmr::vector<uint32_t> stack(memory_);
+    std::pmr::vector<uint32_t> stack(frameMemory_);
     stack.reserve(work.passCount);
     const auto pushRoot = [&work, &stack, &compiled](uint32_t passIndex) {
       if (work.activePassMask[passIndex] != 0u) {
@@ -1750,15 +2161,9 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
       pushRoot(passIndex);
     }
 
-    std::pmr::vector<RenderGraphAccessMode> textureAccessByPass(memory_);
+    std::pmr::vector<RenderGraphAccessMode> textureAccessByPass(frameMemory_);
     textureAccessByPass.resize(work.passCount, RenderGraphAccessMode::None);
-    for (const uint32_t textureIndex : frameOutputTextureIndices_) {
-      if (!isValidTextureIndex(textureIndex)) {
-        return Result<bool, std::string>::makeError(
-            "RenderGraphBuilder::compile: frame-output texture index is out "
-            "of range");
-      }
-
+    const auto pushTextureWriterRoots = [&](uint32_t textureIndex) {
       std::fill(textureAccessByPass.begin(), textureAccessByPass.end(),
                 RenderGraphAccessMode::None);
       for (const PassResourceAccess &access : work.compiledAccesses) {
@@ -1775,6 +2180,24 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
           pushRoot(passIndex);
         }
       }
+    };
+    for (const uint32_t textureIndex : frameOutputTextureIndices_) {
+      if (!isValidTextureIndex(textureIndex)) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: frame-output texture index is out "
+            "of range");
+      }
+      pushTextureWriterRoots(textureIndex);
+    }
+    // Next frame reads history, so its writers are roots even when nothing
+    // in this frame consumes them.
+    for (const uint32_t textureIndex : historyOutputTextureIndices_) {
+      if (!isValidTextureIndex(textureIndex)) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: history texture index is out of "
+            "range");
+      }
+      pushTextureWriterRoots(textureIndex);
     }
 
     while (!stack.empty()) {
@@ -1809,9 +2232,9 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
     work.scheduledDependencies.push_back(edge);
   }
 
-  std::pmr::vector<uint32_t> indegree(memory_);
+  std::pmr::vector<uint32_t> indegree(frameMemory_);
   indegree.resize(work.passCount, 0u);
-  std::pmr::vector<uint32_t> outgoingCount(memory_);
+  std::pmr::vector<uint32_t> outgoingCount(frameMemory_);
   outgoingCount.resize(work.passCount, 0u);
 
   for (const DependencyEdge edge : work.scheduledDependencies) {
@@ -1832,22 +2255,22 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC1C2BuildTopology(
     ++outgoingCount[edge.before];
   }
 
-  std::pmr::vector<uint32_t> outgoingOffsets(memory_);
+  std::pmr::vector<uint32_t> outgoingOffsets(frameMemory_);
   outgoingOffsets.resize(static_cast<size_t>(work.passCount) + 1u, 0u);
   for (uint32_t i = 0; i < work.passCount; ++i) {
     outgoingOffsets[i + 1u] = outgoingOffsets[i] + outgoingCount[i];
   }
 
-  std::pmr::vector<uint32_t> outgoingEdges(memory_);
+  std::pmr::vector<uint32_t> outgoingEdges(frameMemory_);
   outgoingEdges.resize(work.scheduledDependencies.size(), 0u);
-  std::pmr::vector<uint32_t> outgoingCursor(memory_);
+  std::pmr::vector<uint32_t> outgoingCursor(frameMemory_);
   outgoingCursor = outgoingOffsets;
   for (const DependencyEdge edge : work.scheduledDependencies) {
     const uint32_t cursor = outgoingCursor[edge.before]++;
     outgoingEdges[cursor] = edge.after;
   }
 
-  std::pmr::vector<uint32_t> readyStorage(memory_);
+  std::pmr::vector<uint32_t> readyStorage(frameMemory_);
   readyStorage.reserve(work.passCount);
   std::priority_queue<uint32_t, std::pmr::vector<uint32_t>,
                       std::greater<uint32_t>>
@@ -1911,7 +2334,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
   compiled.passDebugNames.reserve(passDebugNames_.size());
   for (const std::pmr::string &name : passDebugNames_) {
-    std::pmr::string copiedName(memory_);
+    std::pmr::string copiedName(frameMemory_);
     copiedName.assign(name.data(), name.size());
     compiled.passDebugNames.push_back(std::move(copiedName));
   }
@@ -1931,6 +2354,8 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     uint32_t passIndex = UINT32_MAX;
     uint32_t colorTextureIndex = UINT32_MAX;
     uint32_t depthTextureIndex = UINT32_MAX;
+    uint32_t additionalColorBindingOffset = 0u;
+    uint32_t additionalColorCount = 0u;
     uint32_t dependencyCount = 0u;
     uint32_t dependencyBindingOffset = 0u;
     uint32_t resolvedDependencyOffset = 0u;
@@ -1942,6 +2367,9 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     uint32_t drawCount = 0u;
     uint32_t drawBindingOffset = 0u;
     uint32_t drawOutputOffset = 0u;
+    uint32_t copyCount = 0u;
+    uint32_t copyBindingOffset = 0u;
+    uint32_t copyOutputOffset = 0u;
     uint32_t unresolvedTextureOffset = 0u;
     uint32_t unresolvedTextureCount = 0u;
     uint32_t unresolvedDependencyOffset = 0u;
@@ -1950,10 +2378,12 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     uint32_t unresolvedPreDispatchDependencyCount = 0u;
     uint32_t unresolvedDrawOffset = 0u;
     uint32_t unresolvedDrawCount = 0u;
+    uint32_t unresolvedCopyOffset = 0u;
+    uint32_t unresolvedCopyCount = 0u;
   };
   const uint32_t workerCount = std::max(1u, runtime.workerCount());
   std::vector<IndexedResolveError> resolveErrors(workerCount);
-  std::pmr::vector<PassResolvePlan> passPlans(memory_);
+  std::pmr::vector<PassResolvePlan> passPlans(frameMemory_);
   passPlans.resize(work.order.size());
   const auto validatePassRange = [&](uint32_t workerIndex,
                                      RenderGraphContiguousRange range) {
@@ -1965,6 +2395,9 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
       plan.passIndex = passIndex;
       plan.colorTextureIndex = passColorTextureBindings_[passIndex];
       plan.depthTextureIndex = passDepthTextureBindings_[passIndex];
+      plan.additionalColorBindingOffset =
+          passIndex * static_cast<uint32_t>(kMaxAdditionalColorAttachments);
+      plan.additionalColorCount = sourcePass.additionalColorCount;
       const uint32_t dependencyCount =
           passDependencyBufferBindingCounts_[passIndex];
       if (dependencyCount > kMaxDependencyBuffers) {
@@ -2124,6 +2557,42 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
         };
         return;
       }
+      if (plan.additionalColorCount > kMaxAdditionalColorAttachments) {
+        resolveErrors[workerIndex] = IndexedResolveError{
+            .hasError = true,
+            .orderedPassIndex = orderedPassIndex,
+            .message = "RenderGraphBuilder::compile: additional color "
+                       "attachment count exceeds "
+                       "kMaxAdditionalColorAttachments",
+        };
+        return;
+      }
+      for (uint32_t i = 0; i < plan.additionalColorCount; ++i) {
+        const uint32_t resourceIndex =
+            passAdditionalColorTextureBindings_
+                [plan.additionalColorBindingOffset + i];
+        if (resourceIndex == UINT32_MAX) {
+          resolveErrors[workerIndex] = IndexedResolveError{
+              .hasError = true,
+              .orderedPassIndex = orderedPassIndex,
+              .message = "RenderGraphBuilder::compile: pass requires explicit "
+                         "additional color texture binding",
+          };
+          return;
+        }
+        if (!isValidTextureIndex(resourceIndex)) {
+          resolveErrors[workerIndex] = IndexedResolveError{
+              .hasError = true,
+              .orderedPassIndex = orderedPassIndex,
+              .message = "RenderGraphBuilder::compile: additional color "
+                         "texture binding references out-of-range texture",
+          };
+          return;
+        }
+        if (!textures_[resourceIndex].imported) {
+          ++plan.unresolvedTextureCount;
+        }
+      }
       if (plan.colorTextureIndex != UINT32_MAX &&
           !textures_[plan.colorTextureIndex].imported) {
         ++plan.unresolvedTextureCount;
@@ -2278,6 +2747,49 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
       }
       plan.drawCount = drawCount;
       plan.drawBindingOffset = drawOffset;
+
+      const uint32_t copyCount = passCopyBindingCounts_[passIndex];
+      const uint32_t copyOffset = passCopyBindingOffsets_[passIndex];
+      if (sourcePass.copies.size() != copyCount) {
+        resolveErrors[workerIndex] = IndexedResolveError{
+            .hasError = true,
+            .orderedPassIndex = orderedPassIndex,
+            .message = "RenderGraphBuilder::compile: copy binding count does "
+                       "not match pass copy count",
+        };
+        return;
+      }
+      if (copyOffset > copySourceBindingResourceIndices_.size() ||
+          copyCount > copySourceBindingResourceIndices_.size() - copyOffset) {
+        resolveErrors[workerIndex] = IndexedResolveError{
+            .hasError = true,
+            .orderedPassIndex = orderedPassIndex,
+            .message = "RenderGraphBuilder::compile: copy binding range is "
+                       "invalid",
+        };
+        return;
+      }
+      for (uint32_t copyIndex = 0; copyIndex < copyCount; ++copyIndex) {
+        const uint32_t globalCopyIndex = copyOffset + copyIndex;
+        for (const uint32_t resourceIndex :
+             {copySourceBindingResourceIndices_[globalCopyIndex],
+              copyDestinationBindingResourceIndices_[globalCopyIndex]}) {
+          if (!isValidBufferIndex(resourceIndex)) {
+            resolveErrors[workerIndex] = IndexedResolveError{
+                .hasError = true,
+                .orderedPassIndex = orderedPassIndex,
+                .message = "RenderGraphBuilder::compile: copy buffer binding "
+                           "references out-of-range resource",
+            };
+            return;
+          }
+          if (!buffers_[resourceIndex].imported) {
+            ++plan.unresolvedCopyCount;
+          }
+        }
+      }
+      plan.copyCount = copyCount;
+      plan.copyBindingOffset = copyOffset;
       passPlans[orderedPassIndex] = plan;
     }
   };
@@ -2287,7 +2799,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     const std::vector<RenderGraphContiguousRange> stdRanges = makePayloadRanges(
         static_cast<uint32_t>(work.order.size()), workerCount);
     if (stdRanges.size() > 1u) {
-      std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+      std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
       ranges.assign(stdRanges.begin(), stdRanges.end());
       runtime.runRanges(std::span<const RenderGraphContiguousRange>(
                             ranges.data(), ranges.size()),
@@ -2322,10 +2834,12 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
   size_t totalPreDispatchItems = 0u;
   size_t totalPreDispatchDependencySlots = 0u;
   size_t totalDrawItems = 0u;
+  size_t totalCopyRegions = 0u;
   size_t totalUnresolvedTextureBindings = 0u;
   size_t totalUnresolvedDependencyBufferBindings = 0u;
   size_t totalUnresolvedPreDispatchDependencyBufferBindings = 0u;
   size_t totalUnresolvedDrawBufferBindings = 0u;
+  size_t totalUnresolvedCopyBufferBindings = 0u;
   for (uint32_t orderedPassIndex = 0u; orderedPassIndex < passPlans.size();
        ++orderedPassIndex) {
     PassResolvePlan &plan = passPlans[orderedPassIndex];
@@ -2339,6 +2853,8 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     totalPreDispatchDependencySlots += plan.preDispatchDependencyCount;
     plan.drawOutputOffset = static_cast<uint32_t>(totalDrawItems);
     totalDrawItems += plan.drawCount;
+    plan.copyOutputOffset = static_cast<uint32_t>(totalCopyRegions);
+    totalCopyRegions += plan.copyCount;
     plan.unresolvedTextureOffset =
         static_cast<uint32_t>(totalUnresolvedTextureBindings);
     totalUnresolvedTextureBindings += plan.unresolvedTextureCount;
@@ -2352,6 +2868,9 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     plan.unresolvedDrawOffset =
         static_cast<uint32_t>(totalUnresolvedDrawBufferBindings);
     totalUnresolvedDrawBufferBindings += plan.unresolvedDrawCount;
+    plan.unresolvedCopyOffset =
+        static_cast<uint32_t>(totalUnresolvedCopyBufferBindings);
+    totalUnresolvedCopyBufferBindings += plan.unresolvedCopyCount;
   }
 
   compiled.resolvedDependencyBuffers.resize(totalDependencyBufferSlots);
@@ -2363,6 +2882,8 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
   compiled.preDispatchDependencyRanges.resize(totalPreDispatchItems);
   compiled.ownedDrawItems.resize(totalDrawItems);
   compiled.drawRangesByPass.resize(work.order.size());
+  compiled.ownedCopyRegions.resize(totalCopyRegions);
+  compiled.copyRangesByPass.resize(work.order.size());
   compiled.orderedPasses.resize(work.order.size());
   compiled.orderedPassIndices.resize(work.order.size());
   compiled.recordedGraphicsPasses.resize(work.order.size());
@@ -2374,6 +2895,8 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
       totalUnresolvedPreDispatchDependencyBufferBindings);
   compiled.unresolvedDrawBufferBindings.resize(
       totalUnresolvedDrawBufferBindings);
+  compiled.unresolvedCopyBufferBindings.resize(
+      totalUnresolvedCopyBufferBindings);
 
   const auto fillPassRange = [&](uint32_t, RenderGraphContiguousRange range) {
     for (uint32_t orderedPassIndex = range.offset;
@@ -2397,6 +2920,23 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
                   RenderGraphCompileResult::PassTextureBindingTarget::Color};
         }
       }
+      for (uint32_t i = 0; i < plan.additionalColorCount; ++i) {
+        const uint32_t resourceIndex =
+            passAdditionalColorTextureBindings_
+                [plan.additionalColorBindingOffset + i];
+        const TextureResource &resource = textures_[resourceIndex];
+        if (resource.imported) {
+          resolvedPass.additionalColorTextures[i] = resource.importedHandle;
+        } else {
+          resolvedPass.additionalColorTextures[i] = {};
+          compiled.unresolvedTextureBindings[unresolvedTextureWriteOffset++] = {
+              .orderedPassIndex = orderedPassIndex,
+              .textureResourceIndex = resourceIndex,
+              .target = RenderGraphCompileResult::PassTextureBindingTarget::
+                  AdditionalColor,
+              .additionalColorIndex = i};
+        }
+      }
       if (plan.depthTextureIndex != UINT32_MAX) {
         const TextureResource &resource = textures_[plan.depthTextureIndex];
         if (resource.imported) {
@@ -2573,6 +3113,51 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
       } else {
         resolvedPass.draws = {};
       }
+
+      compiled.copyRangesByPass[orderedPassIndex] = {
+          .offset = plan.copyOutputOffset, .count = plan.copyCount};
+      uint32_t unresolvedCopyWriteOffset = plan.unresolvedCopyOffset;
+      for (uint32_t copyIndex = 0; copyIndex < plan.copyCount; ++copyIndex) {
+        BufferCopyRegion resolvedCopy = sourcePass.copies[copyIndex];
+        const uint32_t globalCopyIndex = plan.copyBindingOffset + copyIndex;
+
+        const auto resolveCopyBinding =
+            [&](uint32_t resourceIndex,
+                RenderGraphCompileResult::CopyBufferBindingTarget target,
+                BufferHandle &slotHandle) {
+              const BufferResource &resource = buffers_[resourceIndex];
+              if (resource.imported) {
+                slotHandle = resource.importedHandle;
+                return;
+              }
+              slotHandle = {};
+              compiled
+                  .unresolvedCopyBufferBindings[unresolvedCopyWriteOffset++] = {
+                  .orderedPassIndex = orderedPassIndex,
+                  .copyIndex = copyIndex,
+                  .target = target,
+                  .bufferResourceIndex = resourceIndex};
+            };
+
+        resolveCopyBinding(
+            copySourceBindingResourceIndices_[globalCopyIndex],
+            RenderGraphCompileResult::CopyBufferBindingTarget::Source,
+            resolvedCopy.srcBuffer);
+        resolveCopyBinding(
+            copyDestinationBindingResourceIndices_[globalCopyIndex],
+            RenderGraphCompileResult::CopyBufferBindingTarget::Destination,
+            resolvedCopy.dstBuffer);
+
+        compiled.ownedCopyRegions[plan.copyOutputOffset + copyIndex] =
+            resolvedCopy;
+      }
+      if (plan.copyCount > 0u) {
+        resolvedPass.copies = std::span<const BufferCopyRegion>(
+            compiled.ownedCopyRegions.data() + plan.copyOutputOffset,
+            plan.copyCount);
+      } else {
+        resolvedPass.copies = {};
+      }
       if (passIndex < compiled.passDebugNames.size()) {
         const std::pmr::string &compiledName =
             compiled.passDebugNames[passIndex];
@@ -2595,7 +3180,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
     const std::vector<RenderGraphContiguousRange> stdRanges = makePayloadRanges(
         static_cast<uint32_t>(work.order.size()), workerCount);
     if (stdRanges.size() > 1u) {
-      std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+      std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
       ranges.assign(stdRanges.begin(), stdRanges.end());
       runtime.runRanges(std::span<const RenderGraphContiguousRange>(
                             ranges.data(), ranges.size()),
@@ -2611,6 +3196,37 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC3ResolvePassPayloads(
   return Result<bool, std::string>::makeResult(true);
 }
 
+RenderGraphStage RenderGraphBuilder::resolveAccessStages(
+    const PassResourceAccess &access) const {
+  return resolveAccessStages(access.passIndex, access.stages);
+}
+
+RenderGraphStage
+RenderGraphBuilder::resolveAccessStages(uint32_t passIndex,
+                                        RenderGraphStage stages) const {
+  if (stages != RenderGraphStage::None) {
+    return stages;
+  }
+  // Explicit reads/writes carry no binding role; assume any stage the pass
+  // kind can run.
+  const RenderPass &pass = passes_[passIndex];
+  switch (pass.kind) {
+  case RenderPassKind::Compute:
+    return RenderGraphStage::ComputeShader;
+  case RenderPassKind::Transfer:
+    return RenderGraphStage::Transfer;
+  case RenderPassKind::Graphics:
+  default: {
+    RenderGraphStage fallback =
+        RenderGraphStage::VertexShader | RenderGraphStage::FragmentShader;
+    if (!pass.preDispatches.empty()) {
+      fallback = fallback | RenderGraphStage::ComputeShader;
+    }
+    return fallback;
+  }
+  }
+}
+
 Result<bool, std::string> RenderGraphBuilder::compileStageC4PlanBarriers(
     RenderGraphCompileResult &compiled,
     const RenderGraphBuilder::CompileWorkState &work) const {
@@ -2618,13 +3234,13 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC4PlanBarriers(
   compiled.passBarrierRecords.clear();
   compiled.finalBarrierPlan = {};
 
-  std::pmr::vector<uint32_t> executionRankByPass(memory_);
+  std::pmr::vector<uint32_t> executionRankByPass(frameMemory_);
   executionRankByPass.resize(work.passCount, UINT32_MAX);
   for (uint32_t rank = 0; rank < work.order.size(); ++rank) {
     executionRankByPass[work.order[rank]] = rank;
   }
 
-  std::pmr::vector<PassResourceAccess> orderedAccesses(memory_);
+  std::pmr::vector<PassResourceAccess> orderedAccesses(frameMemory_);
   orderedAccesses.reserve(work.compiledAccesses.size());
   for (const PassResourceAccess &access : work.compiledAccesses) {
     if (access.passIndex >= work.passCount ||
@@ -2661,31 +3277,79 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC4PlanBarriers(
          passDepthTextureBindings_[access.passIndex] == access.resourceIndex)) {
       return RenderGraphResourceState::Attachment;
     }
+    if (access.resourceKind == AccessResourceKind::Texture) {
+      const size_t bindingOffset =
+          static_cast<size_t>(access.passIndex) *
+          kMaxAdditionalColorAttachments;
+      const uint32_t additionalColorCount =
+          passes_[access.passIndex].additionalColorCount;
+      for (uint32_t i = 0; i < additionalColorCount; ++i) {
+        if (passAdditionalColorTextureBindings_[bindingOffset + i] ==
+            access.resourceIndex) {
+          return RenderGraphResourceState::Attachment;
+        }
+      }
+    }
     return hasWrite ? RenderGraphResourceState::Write
                     : RenderGraphResourceState::Read;
   };
 
-  std::pmr::vector<RenderGraphBarrierRecord> stagedBarrierRecords(memory_);
-  std::pmr::vector<uint32_t> stagedBarrierPassIndices(memory_);
-  std::pmr::vector<RenderGraphBarrierRecord> stagedFinalBarrierRecords(memory_);
-  std::pmr::vector<uint32_t> barrierCounts(memory_);
+  std::pmr::vector<RenderGraphBarrierRecord> stagedBarrierRecords(frameMemory_);
+  std::pmr::vector<uint32_t> stagedBarrierPassIndices(frameMemory_);
+  std::pmr::vector<RenderGraphBarrierRecord> stagedFinalBarrierRecords(
+      frameMemory_);
+  std::pmr::vector<uint32_t> barrierCounts(frameMemory_);
   barrierCounts.resize(work.order.size(), 0u);
-  std::pmr::vector<RenderGraphAccessMode> lastTextureAccessByResource(memory_);
+  std::pmr::vector<RenderGraphAccessMode> lastTextureAccessByResource(
+      frameMemory_);
   lastTextureAccessByResource.resize(textures_.size(),
                                      RenderGraphAccessMode::None);
   std::pmr::vector<RenderGraphResourceState> lastTextureStateByResource(
-      memory_);
+      frameMemory_);
   lastTextureStateByResource.resize(textures_.size(),
                                     RenderGraphResourceState::Unknown);
-  std::pmr::vector<uint8_t> hasLastTextureAccess(memory_);
+  std::pmr::vector<RenderGraphStage> lastTextureStagesByResource(frameMemory_);
+  lastTextureStagesByResource.resize(textures_.size(), RenderGraphStage::None);
+  std::pmr::vector<uint8_t> hasLastTextureAccess(frameMemory_);
   hasLastTextureAccess.resize(textures_.size(), 0u);
 
   AccessResourceKind previousKind = AccessResourceKind::Texture;
   uint32_t previousResourceIndex = UINT32_MAX;
   RenderGraphAccessMode previousAccess = RenderGraphAccessMode::None;
   RenderGraphResourceState previousState = RenderGraphResourceState::Unknown;
+  // Union of the stages of every access since the last barrier that changed
+  // state or followed a write, i.e. all readers a later write must wait on.
+  RenderGraphStage phaseStages = RenderGraphStage::None;
+  // Source side of the barrier that opened the current phase; readers that
+  // join later in new stages get a barrier from the same source.
+  RenderGraphAccessMode phaseSourceAccess = RenderGraphAccessMode::None;
+  RenderGraphResourceState phaseSourceState = RenderGraphResourceState::Unknown;
+  RenderGraphStage phaseSourceStages = RenderGraphStage::None;
   bool havePreviousResource = false;
 
+  const auto stageBarrier = [&](const PassResourceAccess &access,
+                                RenderGraphAccessMode beforeAccess,
+                                RenderGraphResourceState beforeState,
+                                RenderGraphStage beforeStages,
+                                RenderGraphResourceState afterState,
+                                RenderGraphStage afterStages) {
+    const uint32_t orderedPassIndex = executionRankByPass[access.passIndex];
+    stagedBarrierRecords.push_back(RenderGraphBarrierRecord{
+        .resourceKind = access.resourceKind == AccessResourceKind::Texture
+                            ? RenderGraphBarrierResourceKind::Texture
+                            : RenderGraphBarrierResourceKind::Buffer,
+        .resourceIndex = access.resourceIndex,
+        .beforeAccess = beforeAccess,
+        .afterAccess = access.mode,
+        .beforeState = beforeState,
+        .afterState = afterState,
+        .beforeStages = beforeStages,
+        .afterStages = afterStages,
+    });
+    stagedBarrierPassIndices.push_back(orderedPassIndex);
+    ++barrierCounts[orderedPassIndex];
+  };
+
   for (const PassResourceAccess &access : orderedAccesses) {
     const bool sameResource = havePreviousResource &&
                               previousKind == access.resourceKind &&
@@ -2695,35 +3359,41 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC4PlanBarriers(
       previousResourceIndex = access.resourceIndex;
       previousAccess = RenderGraphAccessMode::None;
       previousState = RenderGraphResourceState::Unknown;
+      phaseStages = RenderGraphStage::None;
       havePreviousResource = true;
     }
 
     const RenderGraphResourceState nextState = resolveResourceState(access);
+    const RenderGraphStage nextStages = resolveAccessStages(access);
     const bool needsBarrier =
         previousState == RenderGraphResourceState::Unknown ||
         previousState != nextState ||
         hasAccessFlag(previousAccess, RenderGraphAccessMode::Write) ||
         hasAccessFlag(access.mode, RenderGraphAccessMode::Write);
     if (needsBarrier) {
-      const uint32_t orderedPassIndex = executionRankByPass[access.passIndex];
-      stagedBarrierRecords.push_back(RenderGraphBarrierRecord{
-          .resourceKind = access.resourceKind == AccessResourceKind::Texture
-                              ? RenderGraphBarrierResourceKind::Texture
-                              : RenderGraphBarrierResourceKind::Buffer,
-          .resourceIndex = access.resourceIndex,
-          .beforeAccess = previousAccess,
-          .afterAccess = access.mode,
-          .beforeState = previousState,
-          .afterState = nextState,
-      });
-      stagedBarrierPassIndices.push_back(orderedPassIndex);
-      ++barrierCounts[orderedPassIndex];
+      stageBarrier(access, previousAccess, previousState, phaseStages,
+                   nextState, nextStages);
+      phaseSourceAccess = previousAccess;
+      phaseSourceState = previousState;
+      phaseSourceStages = phaseStages;
+      phaseStages = nextStages;
+    } else {
+      // Read after read in the same state: stages no barrier has reached
+      // yet still need to wait on whatever opened the phase.
+      const RenderGraphStage unsyncedStages =
+          removeStages(nextStages, phaseStages);
+      if (unsyncedStages != RenderGraphStage::None) {
+        stageBarrier(access, phaseSourceAccess, phaseSourceState,
+                     phaseSourceStages, nextState, unsyncedStages);
+        phaseStages = phaseStages | unsyncedStages;
+      }
     }
 
     if (access.resourceKind == AccessResourceKind::Texture &&
         access.resourceIndex < textures_.size()) {
       lastTextureAccessByResource[access.resourceIndex] = access.mode;
       lastTextureStateByResource[access.resourceIndex] = nextState;
+      lastTextureStagesByResource[access.resourceIndex] = phaseStages;
       hasLastTextureAccess[access.resourceIndex] = 1u;
     }
 
@@ -2732,7 +3402,7 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC4PlanBarriers(
   }
 
   if (!frameOutputTextureIndices_.empty()) {
-    std::pmr::vector<uint32_t> sortedFrameOutputTextures(memory_);
+    std::pmr::vector<uint32_t> sortedFrameOutputTextures(frameMemory_);
     sortedFrameOutputTextures.assign(frameOutputTextureIndices_.begin(),
                                      frameOutputTextureIndices_.end());
     std::sort(sortedFrameOutputTextures.begin(),
@@ -2754,13 +3424,14 @@ Result<bool, std::string> RenderGraphBuilder::compileStageC4PlanBarriers(
           .afterAccess = RenderGraphAccessMode::None,
           .beforeState = lastState,
           .afterState = RenderGraphResourceState::Present,
+          .beforeStages = lastTextureStagesByResource[textureIndex],
       });
     }
   }
 
   compiled.passBarrierRecords.resize(stagedBarrierRecords.size() +
                                      stagedFinalBarrierRecords.size());
-  std::pmr::vector<uint32_t> nextBarrierOffset(memory_);
+  std::pmr::vector<uint32_t> nextBarrierOffset(frameMemory_);
   nextBarrierOffset.resize(compiled.passBarrierPlans.size(), 0u);
   uint32_t runningBarrierOffset = 0u;
   for (uint32_t orderedPassIndex = 0u;
@@ -2794,18 +3465,18 @@ RenderGraphBuilder::compileStageC5PlanTransientLifetimes(
     RenderGraphRuntime &runtime, RenderGraphCompileResult &compiled,
     RenderGraphBuilder::CompileWorkState &work) const {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
-  std::pmr::vector<uint32_t> executionRankByPass(memory_);
+  std::pmr::vector<uint32_t> executionRankByPass(frameMemory_);
   executionRankByPass.resize(work.passCount, UINT32_MAX);
   for (uint32_t rank = 0; rank < work.order.size(); ++rank) {
     executionRankByPass[work.order[rank]] = rank;
   }
 
-  std::pmr::vector<uint32_t> transientTextureFirstRank(memory_);
-  std::pmr::vector<uint32_t> transientTextureLastRank(memory_);
+  std::pmr::vector<uint32_t> transientTextureFirstRank(frameMemory_);
+  std::pmr::vector<uint32_t> transientTextureLastRank(frameMemory_);
   transientTextureFirstRank.resize(textures_.size(), UINT32_MAX);
   transientTextureLastRank.resize(textures_.size(), 0u);
-  std::pmr::vector<uint32_t> transientBufferFirstRank(memory_);
-  std::pmr::vector<uint32_t> transientBufferLastRank(memory_);
+  std::pmr::vector<uint32_t> transientBufferFirstRank(frameMemory_);
+  std::pmr::vector<uint32_t> transientBufferLastRank(frameMemory_);
   transientBufferFirstRank.resize(buffers_.size(), UINT32_MAX);
   transientBufferLastRank.resize(buffers_.size(), 0u);
   const auto updateLifetimeRanks = [](std::span<uint32_t> firstRanks,
@@ -2888,10 +3559,11 @@ RenderGraphBuilder::compileStageC5PlanTransientLifetimes(
       std::vector<WorkerLifetimeRanks> workerRanks{};
       workerRanks.reserve(stdRanges.size());
       for (size_t i = 0; i < stdRanges.size(); ++i) {
-        workerRanks.emplace_back(memory_, textures_.size(), buffers_.size());
+        workerRanks.emplace_back(frameMemory_, textures_.size(),
+                                 buffers_.size());
       }
 
-      std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+      std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
       ranges.assign(stdRanges.begin(), stdRanges.end());
       runtime.runRanges(
           std::span<const RenderGraphContiguousRange>(ranges.data(),
@@ -2998,7 +3670,7 @@ RenderGraphBuilder::compileStageC6PlanTransientAliasing(
   {
     NURI_PROFILER_ZONE("RenderGraph.compile.plan_texture_aliasing",
                        NURI_PROFILER_COLOR_CREATE);
-    std::pmr::vector<uint32_t> orderIndices(memory_);
+    std::pmr::vector<uint32_t> orderIndices(frameMemory_);
     orderIndices.resize(compiled.transientTextureLifetimes.size(), 0u);
     std::iota(orderIndices.begin(), orderIndices.end(), 0u);
     std::sort(orderIndices.begin(), orderIndices.end(),
@@ -3014,8 +3686,8 @@ RenderGraphBuilder::compileStageC6PlanTransientAliasing(
                 return a.resourceIndex < b.resourceIndex;
               });
 
-    std::pmr::vector<uint32_t> slotLastUse(memory_);
-    std::pmr::vector<uint32_t> slotRepresentativeResource(memory_);
+    std::pmr::vector<uint32_t> slotLastUse(frameMemory_);
+    std::pmr::vector<uint32_t> slotRepresentativeResource(frameMemory_);
     slotLastUse.reserve(compiled.transientTextureLifetimes.size());
     slotRepresentativeResource.reserve(
         compiled.transientTextureLifetimes.size());
@@ -3079,7 +3751,7 @@ RenderGraphBuilder::compileStageC6PlanTransientAliasing(
   {
     NURI_PROFILER_ZONE("RenderGraph.compile.plan_buffer_aliasing",
                        NURI_PROFILER_COLOR_CREATE);
-    std::pmr::vector<uint32_t> orderIndices(memory_);
+    std::pmr::vector<uint32_t> orderIndices(frameMemory_);
     orderIndices.resize(compiled.transientBufferLifetimes.size(), 0u);
     std::iota(orderIndices.begin(), orderIndices.end(), 0u);
     std::sort(orderIndices.begin(), orderIndices.end(),
@@ -3095,8 +3767,8 @@ RenderGraphBuilder::compileStageC6PlanTransientAliasing(
                 return a.resourceIndex < b.resourceIndex;
               });
 
-    std::pmr::vector<uint32_t> slotLastUse(memory_);
-    std::pmr::vector<uint32_t> slotRepresentativeResource(memory_);
+    std::pmr::vector<uint32_t> slotLastUse(frameMemory_);
+    std::pmr::vector<uint32_t> slotRepresentativeResource(frameMemory_);
     slotLastUse.reserve(compiled.transientBufferLifetimes.size());
     slotRepresentativeResource.reserve(
         compiled.transientBufferLifetimes.size());
@@ -3285,7 +3957,7 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
       }
     }
 
-    std::pmr::vector<uint8_t> seenTexturePhysicalSlots(memory_);
+    std::pmr::vector<uint8_t> seenTexturePhysicalSlots(frameMemory_);
     seenTexturePhysicalSlots.resize(compiled.transientTexturePhysicalCount, 0u);
     for (const auto &allocation :
          compiled.transientTexturePhysicalAllocations) {
@@ -3331,7 +4003,7 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
       }
     }
 
-    std::pmr::vector<uint8_t> seenBufferPhysicalSlots(memory_);
+    std::pmr::vector<uint8_t> seenBufferPhysicalSlots(frameMemory_);
     seenBufferPhysicalSlots.resize(compiled.transientBufferPhysicalCount, 0u);
     for (const auto &allocation : compiled.transientBufferPhysicalAllocations) {
       if (allocation.allocationIndex >= compiled.transientBufferPhysicalCount) {
@@ -3408,7 +4080,7 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
           "count");
     }
 
-    std::pmr::vector<uint8_t> seenOrderedPassIndices(memory_);
+    std::pmr::vector<uint8_t> seenOrderedPassIndices(frameMemory_);
     seenOrderedPassIndices.resize(compiled.declaredPassCount, 0u);
     for (const uint32_t passIndex : compiled.orderedPassIndices) {
       if (passIndex >= compiled.declaredPassCount) {
@@ -3422,9 +4094,9 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
       seenOrderedPassIndices[passIndex] = 1u;
     }
 
-    PmrHashSet<uint64_t> seenEdges(memory_);
+    PmrHashSet<uint64_t> seenEdges(frameMemory_);
     seenEdges.reserve(compiled.edges.size());
-    std::pmr::vector<uint32_t> orderPositionByPass(memory_);
+    std::pmr::vector<uint32_t> orderPositionByPass(frameMemory_);
     orderPositionByPass.resize(compiled.declaredPassCount, UINT32_MAX);
     for (uint32_t i = 0u; i < compiled.orderedPassIndices.size(); ++i) {
       orderPositionByPass[compiled.orderedPassIndices[i]] = i;
@@ -3527,6 +4199,10 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
       return Result<bool, std::string>::makeError(
           "RenderGraphBuilder::compile: draw range metadata count mismatch");
     }
+    if (compiled.copyRangesByPass.size() != compiled.orderedPasses.size()) {
+      return Result<bool, std::string>::makeError(
+          "RenderGraphBuilder::compile: copy range metadata count mismatch");
+    }
     if (compiled.preDispatchDependencyRanges.size() !=
         compiled.ownedPreDispatches.size()) {
       return Result<bool, std::string>::makeError(
@@ -3566,6 +4242,14 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
         return Result<bool, std::string>::makeError(
             "RenderGraphBuilder::compile: draw range is out of bounds");
       }
+
+      const auto &copyRange = compiled.copyRangesByPass[passExecIndex];
+      if (copyRange.offset > compiled.ownedCopyRegions.size() ||
+          copyRange.count >
+              compiled.ownedCopyRegions.size() - copyRange.offset) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: copy range is out of bounds");
+      }
     }
 
     for (const auto &binding : compiled.unresolvedTextureBindings) {
@@ -3583,11 +4267,22 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
       if (binding.target !=
               RenderGraphCompileResult::PassTextureBindingTarget::Color &&
           binding.target !=
-              RenderGraphCompileResult::PassTextureBindingTarget::Depth) {
+              RenderGraphCompileResult::PassTextureBindingTarget::Depth &&
+          binding.target != RenderGraphCompileResult::PassTextureBindingTarget::
+                                AdditionalColor) {
         return Result<bool, std::string>::makeError(
             "RenderGraphBuilder::compile: unresolved texture binding target is "
             "invalid");
       }
+      if (binding.target == RenderGraphCompileResult::
+                                PassTextureBindingTarget::AdditionalColor &&
+          binding.additionalColorIndex >=
+              compiled.orderedPasses[binding.orderedPassIndex]
+                  .additionalColorCount) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: unresolved additional color binding "
+            "index is out of range");
+      }
       const uint32_t allocationIndex =
           compiled.transientTextureAllocationByResource
               [binding.textureResourceIndex];
@@ -3721,6 +4416,44 @@ RenderGraphBuilder::compileStageC7ValidateCompiledMetadata(
             "target is invalid");
       }
     }
+
+    for (const auto &binding : compiled.unresolvedCopyBufferBindings) {
+      if (binding.orderedPassIndex >= compiled.copyRangesByPass.size()) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: unresolved copy buffer binding pass "
+            "index is out of range");
+      }
+      if (binding.bufferResourceIndex >=
+          compiled.transientBufferAllocationByResource.size()) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: unresolved copy buffer binding "
+            "resource index is out of range");
+      }
+      const uint32_t allocationIndex =
+          compiled
+              .transientBufferAllocationByResource[binding.bufferResourceIndex];
+      if (allocationIndex == UINT32_MAX ||
+          allocationIndex >= compiled.transientBufferPhysicalCount) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: unresolved copy buffer binding has "
+            "no transient allocation");
+      }
+      const auto &copyRange =
+          compiled.copyRangesByPass[binding.orderedPassIndex];
+      if (binding.copyIndex >= copyRange.count) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: unresolved copy buffer binding copy "
+            "index is out of range");
+      }
+      if (binding.target !=
+              RenderGraphCompileResult::CopyBufferBindingTarget::Source &&
+          binding.target !=
+              RenderGraphCompileResult::CopyBufferBindingTarget::Destination) {
+        return Result<bool, std::string>::makeError(
+            "RenderGraphBuilder::compile: unresolved copy buffer binding "
+            "target is invalid");
+      }
+    }
     NURI_PROFILER_ZONE_END();
   }
 
@@ -3731,9 +4464,9 @@ Result<RenderGraphCompileResult, std::string>
 RenderGraphBuilder::compile(RenderGraphRuntime &runtime) const {
   NURI_PROFILER_FUNCTION();
 
-  RenderGraphCompileResult compiled(memory_);
+  RenderGraphCompileResult compiled(frameMemory_);
   compiled.frameIndex = frameIndex_;
-  CompileWorkState work(memory_);
+  CompileWorkState work(frameMemory_);
   auto validateResult = compileStageC0ValidateInputs(runtime, compiled, work);
   if (validateResult.hasError()) {
     return Result<RenderGraphCompileResult, std::string>::makeError(
@@ -3794,8 +4527,8 @@ RenderGraphBuilder::compile(RenderGraphRuntime &runtime) const {
 
 RenderGraphExecutor::RenderGraphExecutor(std::pmr::memory_resource *memory)
     : memory_(memory != nullptr ? memory : std::pmr::get_default_resource()),
-      pendingFrames_(memory_), reusableTextures_(memory_),
-      reusableBuffers_(memory_) {}
+      frameMemory_(memory_), pendingFrames_(memory_),
+      reusableTextures_(memory_), reusableBuffers_(memory_) {}
 
 void RenderGraphExecutor::collectRetiredResources(GPUDevice &gpu) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_DESTROY);
@@ -3854,7 +4587,7 @@ void RenderGraphExecutor::collectRetiredResources(GPUDevice &gpu) {
 Result<RenderGraphExecutionMetadata, std::string>
 RenderGraphExecutor::execute(RenderGraphRuntime &runtime, GPUDevice &gpu,
                              const RenderGraphCompileResult &compiled) {
-  RenderGraphExecutionMetadata metadata(memory_);
+  RenderGraphExecutionMetadata metadata(frameMemory_);
   auto result = executeInternal(&runtime, gpu, compiled, &metadata);
   if (result.hasError()) {
     return Result<RenderGraphExecutionMetadata, std::string>::makeError(
@@ -3920,7 +4653,7 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
           "RenderGraphExecutor::execute: pass debug-name metadata count "
           "mismatch");
     }
-    std::pmr::vector<uint8_t> seenOrderedPassIndices(memory_);
+    std::pmr::vector<uint8_t> seenOrderedPassIndices(frameMemory_);
     seenOrderedPassIndices.resize(compiled.declaredPassCount, 0u);
     for (const uint32_t passIndex : compiled.orderedPassIndices) {
       if (passIndex >= compiled.declaredPassCount) {
@@ -3935,12 +4668,12 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
       }
       seenOrderedPassIndices[passIndex] = 1u;
     }
-    std::pmr::vector<uint32_t> orderPositionByPass(memory_);
+    std::pmr::vector<uint32_t> orderPositionByPass(frameMemory_);
     orderPositionByPass.resize(compiled.declaredPassCount, UINT32_MAX);
     for (uint32_t i = 0u; i < compiled.orderedPassIndices.size(); ++i) {
       orderPositionByPass[compiled.orderedPassIndices[i]] = i;
     }
-    PmrHashSet<uint64_t> seenEdges(memory_);
+    PmrHashSet<uint64_t> seenEdges(frameMemory_);
     seenEdges.reserve(compiled.edges.size());
     for (const auto &edge : compiled.edges) {
       if (edge.before >= compiled.declaredPassCount ||
@@ -3995,16 +4728,16 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
     NURI_PROFILER_ZONE_END();
   }
 
-  std::pmr::vector<TextureHandle> transientTextureHandles(memory_);
+  std::pmr::vector<TextureHandle> transientTextureHandles(frameMemory_);
   transientTextureHandles.resize(compiled.transientTexturePhysicalCount,
                                  TextureHandle{});
-  std::pmr::vector<TextureDesc> transientTextureDescs(memory_);
+  std::pmr::vector<TextureDesc> transientTextureDescs(frameMemory_);
   transientTextureDescs.resize(compiled.transientTexturePhysicalCount,
                                TextureDesc{});
-  std::pmr::vector<BufferHandle> transientBufferHandles(memory_);
+  std::pmr::vector<BufferHandle> transientBufferHandles(frameMemory_);
   transientBufferHandles.resize(compiled.transientBufferPhysicalCount,
                                 BufferHandle{});
-  std::pmr::vector<BufferDesc> transientBufferDescs(memory_);
+  std::pmr::vector<BufferDesc> transientBufferDescs(frameMemory_);
   transientBufferDescs.resize(compiled.transientBufferPhysicalCount,
                               BufferDesc{});
 
@@ -4157,12 +4890,13 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
     NURI_PROFILER_ZONE_END();
   }
 
-  std::pmr::vector<RenderPass> executablePasses(memory_);
-  std::pmr::vector<BufferHandle> executableDependencyBuffers(memory_);
-  std::pmr::vector<ComputeDispatchItem> executablePreDispatches(memory_);
-  std::pmr::vector<DrawItem> executableDrawItems(memory_);
+  std::pmr::vector<RenderPass> executablePasses(frameMemory_);
+  std::pmr::vector<BufferHandle> executableDependencyBuffers(frameMemory_);
+  std::pmr::vector<ComputeDispatchItem> executablePreDispatches(frameMemory_);
+  std::pmr::vector<DrawItem> executableDrawItems(frameMemory_);
   std::pmr::vector<BufferHandle> executablePreDispatchDependencyBuffers(
-      memory_);
+      frameMemory_);
+  std::pmr::vector<BufferCopyRegion> executableCopyRegions(frameMemory_);
 
   {
     NURI_PROFILER_ZONE("RenderGraph.execute.build_executable_payload",
@@ -4173,6 +4907,7 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
     executableDrawItems = compiled.ownedDrawItems;
     executablePreDispatchDependencyBuffers =
         compiled.resolvedPreDispatchDependencyBuffers;
+    executableCopyRegions = compiled.ownedCopyRegions;
 
     if (compiled.dependencyBufferRangesByPass.size() !=
         executablePasses.size()) {
@@ -4197,6 +4932,13 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
           "RenderGraphExecutor::execute: pass draw range metadata count "
           "mismatch");
     }
+    if (compiled.copyRangesByPass.size() != executablePasses.size()) {
+      destroyMaterializedResources();
+      return fail(
+          RenderGraphExecutionFailureStage::BuildExecutablePayload,
+          "RenderGraphExecutor::execute: pass copy range metadata count "
+          "mismatch");
+    }
     if (compiled.preDispatchDependencyRanges.size() !=
         executablePreDispatches.size()) {
       destroyMaterializedResources();
@@ -4226,15 +4968,14 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
             "of bounds");
       }
 
-      if (range.count == 0u) {
+      if (range.count > 0u) {
+        executablePasses[orderedPassIndex].dependencyBuffers =
+            std::span<const BufferHandle>(
+                executableDependencyBuffers.data() + range.offset, range.count);
+      } else {
         executablePasses[orderedPassIndex].dependencyBuffers = {};
-        continue;
       }
 
-      executablePasses[orderedPassIndex].dependencyBuffers =
-          std::span<const BufferHandle>(
-              executableDependencyBuffers.data() + range.offset, range.count);
-
       const auto &preDispatchRange =
           compiled.preDispatchRangesByPass[orderedPassIndex];
       if (preDispatchRange.offset > executablePreDispatches.size() ||
@@ -4298,6 +5039,23 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
       } else {
         executablePasses[orderedPassIndex].draws = {};
       }
+
+      const auto &copyRange = compiled.copyRangesByPass[orderedPassIndex];
+      if (copyRange.offset > executableCopyRegions.size() ||
+          copyRange.count > executableCopyRegions.size() - copyRange.offset) {
+        destroyMaterializedResources();
+        return fail(
+            RenderGraphExecutionFailureStage::BuildExecutablePayload,
+            "RenderGraphExecutor::execute: pass copy range is out of bounds");
+      }
+      if (copyRange.count > 0u) {
+        executablePasses[orderedPassIndex].copies =
+            std::span<const BufferCopyRegion>(
+                executableCopyRegions.data() + copyRange.offset,
+                copyRange.count);
+      } else {
+        executablePasses[orderedPassIndex].copies = {};
+      }
     }
     NURI_PROFILER_ZONE_END();
   }
@@ -4342,6 +5100,12 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
       } else if (binding.target ==
                  RenderGraphCompileResult::PassTextureBindingTarget::Depth) {
         pass.depthTexture = transientTextureHandles[allocationIndex];
+      } else if (binding.target ==
+                     RenderGraphCompileResult::PassTextureBindingTarget::
+                         AdditionalColor &&
+                 binding.additionalColorIndex < pass.additionalColorCount) {
+        pass.additionalColorTextures[binding.additionalColorIndex] =
+            transientTextureHandles[allocationIndex];
       } else {
         destroyMaterializedResources();
         return fail(
@@ -4528,10 +5292,69 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
             "target is invalid");
       }
     }
+
+    for (const auto &binding : compiled.unresolvedCopyBufferBindings) {
+      if (binding.orderedPassIndex >= executablePasses.size()) {
+        destroyMaterializedResources();
+        return fail(
+            RenderGraphExecutionFailureStage::PatchUnresolvedBindings,
+            "RenderGraphExecutor::execute: unresolved copy buffer binding pass "
+            "index is out of range");
+      }
+      if (binding.bufferResourceIndex >=
+          compiled.transientBufferAllocationByResource.size()) {
+        destroyMaterializedResources();
+        return fail(
+            RenderGraphExecutionFailureStage::PatchUnresolvedBindings,
+            "RenderGraphExecutor::execute: unresolved copy buffer binding "
+            "resource index is out of range");
+      }
+
+      const auto &copyRange =
+          compiled.copyRangesByPass[binding.orderedPassIndex];
+      if (binding.copyIndex >= copyRange.count) {
+        destroyMaterializedResources();
+        return fail(
+            RenderGraphExecutionFailureStage::PatchUnresolvedBindings,
+            "RenderGraphExecutor::execute: unresolved copy buffer binding copy "
+            "index is out of range");
+      }
+
+      const uint32_t allocationIndex =
+          compiled
+              .transientBufferAllocationByResource[binding.bufferResourceIndex];
+      if (allocationIndex == UINT32_MAX ||
+          allocationIndex >= transientBufferHandles.size() ||
+          !nuri::isValid(transientBufferHandles[allocationIndex])) {
+        destroyMaterializedResources();
+        return fail(
+            RenderGraphExecutionFailureStage::PatchUnresolvedBindings,
+            "RenderGraphExecutor::execute: unresolved copy buffer binding has "
+            "no materialized allocation");
+      }
+
+      BufferCopyRegion &copy =
+          executableCopyRegions[copyRange.offset + binding.copyIndex];
+      switch (binding.target) {
+      case RenderGraphCompileResult::CopyBufferBindingTarget::Source:
+        copy.srcBuffer = transientBufferHandles[allocationIndex];
+        break;
+      case RenderGraphCompileResult::CopyBufferBindingTarget::Destination:
+        copy.dstBuffer = transientBufferHandles[allocationIndex];
+        break;
+      default:
+        destroyMaterializedResources();
+        return fail(
+            RenderGraphExecutionFailureStage::PatchUnresolvedBindings,
+            "RenderGraphExecutor::execute: unresolved copy buffer binding "
+            "target is invalid");
+      }
+    }
     NURI_PROFILER_ZONE_END();
   }
 
-  std::pmr::vector<GraphicsBarrierRecord> executableBarrierRecords(memory_);
+  std::pmr::vector<GraphicsBarrierRecord> executableBarrierRecords(
+      frameMemory_);
   executableBarrierRecords.reserve(compiled.passBarrierRecords.size());
   {
     NURI_PROFILER_ZONE("RenderGraph.execute.resolve_barriers",
@@ -4574,6 +5397,11 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
           toGraphicsState(barrier.beforeState);
       const GraphicsBarrierState afterState =
           toGraphicsState(barrier.afterState);
+      // RenderGraphStage mirrors the GraphicsBarrierStage bit layout.
+      const auto beforeStages =
+          static_cast<GraphicsBarrierStage>(barrier.beforeStages);
+      const auto afterStages =
+          static_cast<GraphicsBarrierStage>(barrier.afterStages);
 
       if (barrier.resourceKind == RenderGraphBarrierResourceKind::Texture) {
         if (barrier.resourceIndex >= compiled.textureHandlesByResource.size()) {
@@ -4610,8 +5438,11 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
           texture = transientTextureHandles[allocationIndex];
         }
 
-        executableBarrierRecords.push_back(GraphicsBarrierRecord::ForTexture(
-            texture, beforeAccess, afterAccess, beforeState, afterState));
+        executableBarrierRecords.push_back(
+            GraphicsBarrierRecord::ForTexture(texture, beforeAccess,
+                                              afterAccess, beforeState,
+                                              afterState)
+                .withStages(beforeStages, afterStages));
       } else {
         if (barrier.resourceIndex >= compiled.bufferHandlesByResource.size()) {
           destroyMaterializedResources();
@@ -4647,8 +5478,10 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
           buffer = transientBufferHandles[allocationIndex];
         }
 
-        executableBarrierRecords.push_back(GraphicsBarrierRecord::ForBuffer(
-            buffer, beforeAccess, afterAccess, beforeState, afterState));
+        executableBarrierRecords.push_back(
+            GraphicsBarrierRecord::ForBuffer(buffer, beforeAccess, afterAccess,
+                                             beforeState, afterState)
+                .withStages(beforeStages, afterStages));
       }
     }
     NURI_PROFILER_ZONE_END();
@@ -4694,7 +5527,7 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
                     gpu.maxParallelGraphicsRecordingContexts())
               : 1u;
 
-      std::pmr::vector<RenderGraphContiguousRange> ranges(memory_);
+      std::pmr::vector<RenderGraphContiguousRange> ranges(frameMemory_);
       {
         NURI_PROFILER_ZONE("RenderGraph.execute.schedule_recording_ranges",
                            NURI_PROFILER_COLOR_CMD_COPY);
@@ -4721,7 +5554,7 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
         }
       }
 
-      std::pmr::vector<RecordingContextHandle> recordingContexts(memory_);
+      std::pmr::vector<RecordingContextHandle> recordingContexts(frameMemory_);
       recordingContexts.resize(ranges.size());
 
       std::atomic<bool> recordingFailed = false;
@@ -4847,7 +5680,7 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
       }
 
       std::pmr::vector<RecordedCommandBufferHandle> recordedCommandBuffers(
-          memory_);
+          frameMemory_);
       recordedCommandBuffers.reserve(ranges.size());
       {
         NURI_PROFILER_ZONE("RenderGraph.execute.finish_recording_contexts",
@@ -4895,7 +5728,7 @@ RenderGraphExecutor::executeInternal(RenderGraphRuntime *runtime,
         NURI_PROFILER_ZONE_END();
       }
 
-      std::pmr::vector<SubmitBatchMeta> batches(memory_);
+      std::pmr::vector<SubmitBatchMeta> batches(frameMemory_);
       {
         NURI_PROFILER_ZONE("RenderGraph.execute.build_submit_batches",
                            NURI_PROFILER_COLOR_SUBMIT);
@@ -7,6 +7,7 @@
 #include "nuri/gfx/gpu_descriptors.h"
 #include "nuri/gfx/gpu_device.h"
 #include "nuri/gfx/gpu_render_types.h"
+#include "nuri/gfx/render_graph/render_graph_history.h"
 #include "nuri/gfx/render_graph/render_graph_runtime.h"
 
 #include <cstddef>
@@ -60,9 +61,47 @@ operator|(RenderGraphAccessMode lhs, RenderGraphAccessMode rhs) {
   return (static_cast<uint8_t>(mode) & static_cast<uint8_t>(flag)) != 0u;
 }
 
+// Pipeline stages a pass touches a resource in, tagged by the binding that
+// declared the access. Bit layout matches GraphicsBarrierStage.
+enum class RenderGraphStage : uint16_t {
+  None = 0,
+  DrawIndirect = 1u << 0u,
+  IndexInput = 1u << 1u,
+  VertexInput = 1u << 2u,
+  VertexShader = 1u << 3u,
+  FragmentShader = 1u << 4u,
+  ComputeShader = 1u << 5u,
+  Transfer = 1u << 6u,
+  ColorAttachment = 1u << 7u,
+  DepthAttachment = 1u << 8u,
+};
+
+[[nodiscard]] constexpr RenderGraphStage operator|(RenderGraphStage lhs,
+                                                   RenderGraphStage rhs) {
+  return static_cast<RenderGraphStage>(static_cast<uint16_t>(lhs) |
+                                       static_cast<uint16_t>(rhs));
+}
+
+// Extra MRT output written alongside the primary color attachment.
+struct NURI_API RenderGraphColorAttachment {
+  AttachmentColor color{};
+  RenderGraphTextureId texture{};
+};
+
+// `current` is written this frame and becomes next frame's `previous`.
+// Writers of `current` are kept alive even if nothing reads it this frame.
+struct NURI_API RenderGraphHistoryTexture {
+  RenderGraphTextureId current{};
+  RenderGraphTextureId previous{};
+  // Backing texture of `previous`, for CPU readbacks of last frame's writes.
+  TextureHandle previousTexture{};
+  bool previousValid = false;
+};
+
 struct NURI_API RenderGraphGraphicsPassDesc {
   AttachmentColor color{};
   RenderGraphTextureId colorTexture{};
+  std::span<const RenderGraphColorAttachment> additionalColorAttachments{};
   AttachmentDepth depth{};
   RenderGraphTextureId depthTexture{};
   bool useViewport = false;
@@ -70,12 +109,39 @@ struct NURI_API RenderGraphGraphicsPassDesc {
   std::span<const ComputeDispatchItem> preDispatches{};
   std::span<const BufferHandle> dependencyBuffers{};
   std::span<const DrawItem> draws{};
+  // Encoded with DrawStreamWriter; recorded after `draws`. Stream buffers must
+  // be imported handles.
+  std::span<const std::byte> drawStream{};
   std::string_view debugLabel{};
   uint32_t debugColor = 0xffffffffu;
   bool markColorAsFrameOutput = false;
   bool markImplicitOutputSideEffect = true;
 };
 
+// Compute passes never open a rendering scope and are culled unless they feed
+// a live pass or are explicitly marked as a side effect.
+struct NURI_API RenderGraphComputePassDesc {
+  std::span<const ComputeDispatchItem> dispatches{};
+  std::string_view debugLabel{};
+  uint32_t debugColor = 0xffffffffu;
+  bool markSideEffect = false;
+};
+
+struct NURI_API RenderGraphBufferCopy {
+  RenderGraphBufferId source{};
+  RenderGraphBufferId destination{};
+  uint64_t sourceOffset = 0;
+  uint64_t destinationOffset = 0;
+  uint64_t size = 0;
+};
+
+struct NURI_API RenderGraphTransferPassDesc {
+  std::span<const RenderGraphBufferCopy> copies{};
+  std::string_view debugLabel{};
+  uint32_t debugColor = 0xffffffffu;
+  bool markSideEffect = false;
+};
+
 struct NURI_API RecordedGraphicsPassMeta {
   uint32_t orderedPassIndex = UINT32_MAX;
   uint32_t declaredPassIndex = UINT32_MAX;
@@ -107,6 +173,8 @@ struct NURI_API RenderGraphBarrierRecord {
   RenderGraphAccessMode afterAccess = RenderGraphAccessMode::None;
   RenderGraphResourceState beforeState = RenderGraphResourceState::Unknown;
   RenderGraphResourceState afterState = RenderGraphResourceState::Unknown;
+  RenderGraphStage beforeStages = RenderGraphStage::None;
+  RenderGraphStage afterStages = RenderGraphStage::None;
 };
 
 struct NURI_API PassBarrierPlan {
@@ -199,12 +267,14 @@ struct NURI_API RenderGraphCompileResult {
   enum class PassTextureBindingTarget : uint8_t {
     Color = 0,
     Depth = 1,
+    AdditionalColor = 2,
   };
 
   struct PassTextureBinding {
     uint32_t orderedPassIndex = UINT32_MAX;
     uint32_t textureResourceIndex = UINT32_MAX;
     PassTextureBindingTarget target = PassTextureBindingTarget::Color;
+    uint32_t additionalColorIndex = 0u;
   };
 
   struct PassDependencyBufferRange {
@@ -254,6 +324,23 @@ struct NURI_API RenderGraphCompileResult {
     uint32_t bufferResourceIndex = UINT32_MAX;
   };
 
+  struct PassCopyRange {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+  };
+
+  enum class CopyBufferBindingTarget : uint8_t {
+    Source = 0,
+    Destination = 1,
+  };
+
+  struct UnresolvedCopyBufferBinding {
+    uint32_t orderedPassIndex = UINT32_MAX;
+    uint32_t copyIndex = UINT32_MAX;
+    CopyBufferBindingTarget target = CopyBufferBindingTarget::Source;
+    uint32_t bufferResourceIndex = UINT32_MAX;
+  };
+
   uint64_t frameIndex = 0;
   uint32_t declaredPassCount = 0;
   uint32_t culledPassCount = 0;
@@ -300,6 +387,9 @@ struct NURI_API RenderGraphCompileResult {
   std::pmr::vector<UnresolvedPreDispatchDependencyBufferBinding>
       unresolvedPreDispatchDependencyBufferBindings;
   std::pmr::vector<UnresolvedDrawBufferBinding> unresolvedDrawBufferBindings;
+  std::pmr::vector<BufferCopyRegion> ownedCopyRegions;
+  std::pmr::vector<PassCopyRange> copyRangesByPass;
+  std::pmr::vector<UnresolvedCopyBufferBinding> unresolvedCopyBufferBindings;
 
   explicit RenderGraphCompileResult(
       std::pmr::memory_resource *memory = std::pmr::get_default_resource())
@@ -330,7 +420,10 @@ struct NURI_API RenderGraphCompileResult {
         resolvedPreDispatchDependencyBuffers(ensureMemory(memory)),
         preDispatchDependencyRanges(ensureMemory(memory)),
         unresolvedPreDispatchDependencyBufferBindings(ensureMemory(memory)),
-        unresolvedDrawBufferBindings(ensureMemory(memory)) {}
+        unresolvedDrawBufferBindings(ensureMemory(memory)),
+        ownedCopyRegions(ensureMemory(memory)),
+        copyRangesByPass(ensureMemory(memory)),
+        unresolvedCopyBufferBindings(ensureMemory(memory)) {}
 
 private:
   static std::pmr::memory_resource *ensureMemory(std::pmr::memory_resource *m) {
@@ -343,7 +436,10 @@ public:
   explicit RenderGraphBuilder(
       std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
-  void beginFrame(uint64_t frameIndex);
+  // Compile scratch and the compile result are allocated from frameMemory
+  // when given; it must outlive every use of that frame's compile result.
+  void beginFrame(uint64_t frameIndex,
+                  std::pmr::memory_resource *frameMemory = nullptr);
   [[nodiscard]] Result<RenderGraphTextureId, std::string>
   importTexture(TextureHandle texture, std::string_view debugName = {});
   [[nodiscard]] Result<RenderGraphBufferId, std::string>
@@ -351,6 +447,9 @@ public:
   [[nodiscard]] Result<RenderGraphTextureId, std::string>
   createTransientTexture(const TextureDesc &desc,
                          std::string_view debugName = {});
+  // Requires setHistoryResources(); the registry outlives every frame.
+  [[nodiscard]] Result<RenderGraphHistoryTexture, std::string>
+  importHistoryTexture(std::string_view key, const TextureDesc &desc);
   [[nodiscard]] Result<RenderGraphBufferId, std::string>
   createTransientBuffer(const BufferDesc &desc,
                         std::string_view debugName = {});
@@ -370,9 +469,17 @@ public:
   addBufferWrite(RenderGraphPassId pass, RenderGraphBufferId buffer);
   [[nodiscard]] Result<RenderGraphPassId, std::string>
   addGraphicsPass(const RenderGraphGraphicsPassDesc &desc);
+  [[nodiscard]] Result<RenderGraphPassId, std::string>
+  addComputePass(const RenderGraphComputePassDesc &desc);
+  [[nodiscard]] Result<RenderGraphPassId, std::string>
+  addTransferPass(const RenderGraphTransferPassDesc &desc);
   [[nodiscard]] Result<bool, std::string>
   bindPassColorTexture(RenderGraphPassId pass, RenderGraphTextureId texture);
   [[nodiscard]] Result<bool, std::string>
+  bindPassAdditionalColorTexture(RenderGraphPassId pass,
+                                 uint32_t additionalColorIndex,
+                                 RenderGraphTextureId texture);
+  [[nodiscard]] Result<bool, std::string>
   bindPassDepthTexture(RenderGraphPassId pass, RenderGraphTextureId texture);
   [[nodiscard]] Result<bool, std::string> bindPassDependencyBuffer(
       RenderGraphPassId pass, uint32_t dependencyIndex,
@@ -398,6 +505,9 @@ public:
   void setInferredSideEffectSuppression(bool enabled) noexcept {
     suppressInferredSideEffectsWhenExplicitOutputs_ = enabled;
   }
+  void setHistoryResources(RenderGraphHistoryResources *history) noexcept {
+    history_ = history;
+  }
   [[nodiscard]] Result<RenderGraphCompileResult, std::string>
   compile(RenderGraphRuntime &runtime) const;
   [[nodiscard]] size_t passCount() const noexcept { return passes_.size(); }
@@ -418,6 +528,7 @@ private:
     AccessResourceKind resourceKind = AccessResourceKind::Texture;
     uint32_t resourceIndex = UINT32_MAX;
     RenderGraphAccessMode mode = RenderGraphAccessMode::None;
+    RenderGraphStage stages = RenderGraphStage::None;
     bool inferred = false;
   };
 
@@ -459,13 +570,16 @@ private:
     std::pmr::vector<DrawItem> draws;
     std::pmr::vector<std::pmr::string> drawDebugLabels;
     std::pmr::vector<std::pmr::vector<std::byte>> drawPushConstants;
+    std::pmr::vector<std::byte> drawStream;
+    std::pmr::vector<BufferCopyRegion> copies;
 
     explicit OwnedPassPayload(
         std::pmr::memory_resource *memory = std::pmr::get_default_resource())
         : debugLabel(memory), preDispatches(memory),
           preDispatchDebugLabels(memory), preDispatchPushConstants(memory),
           preDispatchDependencyBuffers(memory), dependencyBuffers(memory),
-          draws(memory), drawDebugLabels(memory), drawPushConstants(memory) {}
+          draws(memory), drawDebugLabels(memory), drawPushConstants(memory),
+          drawStream(memory), copies(memory) {}
   };
 
   struct CompileWorkState {
@@ -495,14 +609,26 @@ private:
   }
   [[nodiscard]] Result<bool, std::string>
   addTextureAccessInternal(RenderGraphPassId pass, RenderGraphTextureId texture,
-                           RenderGraphAccessMode mode, bool inferred);
+                           RenderGraphAccessMode mode, bool inferred,
+                           RenderGraphStage stages = RenderGraphStage::None);
   [[nodiscard]] Result<bool, std::string>
   addBufferAccessInternal(RenderGraphPassId pass, RenderGraphBufferId buffer,
-                          RenderGraphAccessMode mode, bool inferred);
+                          RenderGraphAccessMode mode, bool inferred,
+                          RenderGraphStage stages = RenderGraphStage::None);
+  [[nodiscard]] RenderGraphStage
+  resolveAccessStages(const PassResourceAccess &access) const;
+  [[nodiscard]] RenderGraphStage
+  resolveAccessStages(uint32_t passIndex, RenderGraphStage stages) const;
   [[nodiscard]] Result<bool, std::string>
   markPassSideEffectInternal(RenderGraphPassId pass, bool inferred);
   [[nodiscard]] OwnedPassPayload
   clonePassPayload(const RenderGraphGraphicsPassDesc &desc) const;
+  void cloneDispatchPayload(std::span<const ComputeDispatchItem> dispatches,
+                            OwnedPassPayload &ownedPayload) const;
+  [[nodiscard]] Result<bool, std::string>
+  bindDispatchDependencyBuffers(RenderGraphPassId pass,
+                                std::span<const ComputeDispatchItem> dispatches,
+                                std::string_view debugLabel);
   [[nodiscard]] Result<bool, std::string>
   bindImplicitPassResources(RenderGraphPassId pass,
                             const RenderGraphGraphicsPassDesc &desc);
@@ -538,6 +664,7 @@ private:
       const RenderGraphCompileResult &compiled) const;
 
   std::pmr::memory_resource *memory_ = nullptr;
+  std::pmr::memory_resource *frameMemory_ = nullptr;
   uint64_t frameIndex_ = 0;
   std::pmr::vector<TextureResource> textures_;
   std::pmr::vector<BufferResource> buffers_;
@@ -546,6 +673,8 @@ private:
   std::pmr::vector<std::pmr::string> passDebugNames_;
   std::pmr::vector<uint32_t> passColorTextureBindings_;
   std::pmr::vector<uint32_t> passDepthTextureBindings_;
+  // Fixed stride of kMaxAdditionalColorAttachments entries per pass.
+  std::pmr::vector<uint32_t> passAdditionalColorTextureBindings_;
   std::pmr::vector<uint32_t> passDependencyBufferBindingOffsets_;
   std::pmr::vector<uint32_t> passDependencyBufferBindingCounts_;
   std::pmr::vector<uint32_t> passDependencyBufferBindingResourceIndices_;
@@ -560,6 +689,10 @@ private:
   std::pmr::vector<uint32_t> drawIndexBindingResourceIndices_;
   std::pmr::vector<uint32_t> drawIndirectBindingResourceIndices_;
   std::pmr::vector<uint32_t> drawIndirectCountBindingResourceIndices_;
+  std::pmr::vector<uint32_t> passCopyBindingOffsets_;
+  std::pmr::vector<uint32_t> passCopyBindingCounts_;
+  std::pmr::vector<uint32_t> copySourceBindingResourceIndices_;
+  std::pmr::vector<uint32_t> copyDestinationBindingResourceIndices_;
   PmrHashMap<uint64_t, uint32_t> importedTextureIndicesByHandle_;
   PmrHashMap<uint64_t, uint32_t> importedBufferIndicesByHandle_;
   PmrHashMap<uint64_t, uint32_t> explicitTextureAccessIndicesByPassResource_;
@@ -571,8 +704,11 @@ private:
   std::pmr::vector<PassResourceAccess> passResourceAccesses_;
   PmrHashSet<uint32_t> frameOutputTextureSet_;
   std::pmr::vector<uint32_t> frameOutputTextureIndices_;
+  PmrHashSet<uint32_t> historyOutputTextureSet_;
+  std::pmr::vector<uint32_t> historyOutputTextureIndices_;
   PmrHashMap<uint32_t, uint32_t> sideEffectMarkIndicesByPass_;
   std::pmr::vector<SideEffectPassMark> sideEffectPassMarks_;
+  RenderGraphHistoryResources *history_ = nullptr;
   bool suppressInferredSideEffectsWhenExplicitOutputs_ = false;
 };
 
@@ -583,6 +719,11 @@ public:
   [[nodiscard]] Result<RenderGraphExecutionMetadata, std::string>
   execute(RenderGraphRuntime &runtime, GPUDevice &gpu,
           const RenderGraphCompileResult &compiled);
+  // Per-execution scratch and the returned metadata come from this resource.
+  // Retired transients stay on the executor's memory.
+  void setFrameMemory(std::pmr::memory_resource *frameMemory) noexcept {
+    frameMemory_ = frameMemory != nullptr ? frameMemory : memory_;
+  }
 
 private:
   [[nodiscard]] Result<bool, std::string>
@@ -616,6 +757,7 @@ private:
   void collectRetiredResources(GPUDevice &gpu);
 
   std::pmr::memory_resource *memory_ = nullptr;
+  std::pmr::memory_resource *frameMemory_ = nullptr;
   std::pmr::vector<PendingFrameResources> pendingFrames_;
   std::pmr::vector<ReusableTextureResource> reusableTextures_;
   std::pmr::vector<ReusableBufferResource> reusableBuffers_;
@@ -0,0 +1,198 @@
+#include "nuri/pch.h"
+
+#include "nuri/gfx/render_graph/render_graph_history.h"
+
+#include "nuri/core/profiling.h"
+#include "nuri/gfx/gpu_device.h"
+
+namespace nuri {
+
+namespace {
+
+// Matches the deepest swapchain the backends create; a retired slot may still
+// be sampled by frames that are in flight until then.
+constexpr uint64_t kHistoryRetireFrameLatency = 3u;
+// Entries nobody acquired for this many frames are released.
+constexpr uint64_t kHistoryEvictAfterFrames = 120u;
+
+[[nodiscard]] bool isValidHistoryTextureDesc(const TextureDesc &desc) {
+  return desc.type != TextureType::Count && desc.format != Format::Count &&
+         desc.storage != Storage::Count && desc.usage != TextureUsage::Count &&
+         desc.dimensions.width > 0 && desc.dimensions.height > 0 &&
+         desc.dimensions.depth > 0 && desc.numLayers > 0 &&
+         desc.numSamples > 0 && desc.numMipLevels > 0 && desc.data.empty();
+}
+
+[[nodiscard]] bool isSameHistoryTextureDesc(const TextureDesc &a,
+                                            const TextureDesc &b) {
+  return a.type == b.type && a.format == b.format &&
+         a.dimensions.width == b.dimensions.width &&
+         a.dimensions.height == b.dimensions.height &&
+         a.dimensions.depth == b.dimensions.depth && a.usage == b.usage &&
+         a.storage == b.storage && a.numLayers == b.numLayers &&
+         a.numSamples == b.numSamples && a.numMipLevels == b.numMipLevels &&
+         a.generateMipmaps == b.generateMipmaps;
+}
+
+} // namespace
+
+RenderGraphHistoryResources::RenderGraphHistoryResources(
+    GPUDevice &gpu, std::pmr::memory_resource *memory)
+    : gpu_(gpu),
+      memory_(memory != nullptr ? memory : std::pmr::get_default_resource()),
+      textures_(memory_), retiredTextures_(memory_) {}
+
+RenderGraphHistoryResources::~RenderGraphHistoryResources() {
+  for (HistoryTexture &entry : textures_) {
+    retireSlots(entry);
+  }
+  textures_.clear();
+  destroyRetired(true);
+}
+
+void RenderGraphHistoryResources::beginFrame(uint64_t frameIndex) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_DESTROY);
+  frameIndex_ = frameIndex;
+
+  size_t writeIndex = 0u;
+  for (size_t readIndex = 0u; readIndex < textures_.size(); ++readIndex) {
+    HistoryTexture &entry = textures_[readIndex];
+    const bool stale =
+        entry.acquiredOnce && frameIndex > entry.lastAcquiredFrame &&
+        frameIndex - entry.lastAcquiredFrame > kHistoryEvictAfterFrames;
+    if (stale) {
+      retireSlots(entry);
+      continue;
+    }
+    if (writeIndex != readIndex) {
+      textures_[writeIndex] = std::move(entry);
+    }
+    ++writeIndex;
+  }
+  textures_.erase(textures_.begin() + static_cast<ptrdiff_t>(writeIndex),
+                  textures_.end());
+
+  destroyRetired(false);
+}
+
+Result<RenderGraphHistoryTextureHandles, std::string>
+RenderGraphHistoryResources::acquireTexture(std::string_view key,
+                                            const TextureDesc &desc) {
+  if (key.empty()) {
+    return Result<RenderGraphHistoryTextureHandles, std::string>::makeError(
+        "RenderGraphHistoryResources::acquireTexture: key is empty");
+  }
+  if (!isValidHistoryTextureDesc(desc)) {
+    return Result<RenderGraphHistoryTextureHandles, std::string>::makeError(
+        "RenderGraphHistoryResources::acquireTexture: descriptor is invalid");
+  }
+
+  HistoryTexture *entry = nullptr;
+  for (HistoryTexture &candidate : textures_) {
+    if (candidate.key == key) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (entry == nullptr) {
+    HistoryTexture created(memory_);
+    created.key.assign(key.data(), key.size());
+    textures_.push_back(std::move(created));
+    entry = &textures_.back();
+  }
+
+  if (!nuri::isValid(entry->slots[0]) ||
+      !isSameHistoryTextureDesc(entry->desc, desc)) {
+    retireSlots(*entry);
+    auto allocateResult = allocateSlots(*entry, desc);
+    if (allocateResult.hasError()) {
+      return Result<RenderGraphHistoryTextureHandles, std::string>::makeError(
+          allocateResult.error());
+    }
+  } else if (!entry->acquiredOnce || entry->lastAcquiredFrame != frameIndex_) {
+    const bool consecutive = entry->acquiredOnce &&
+                             frameIndex_ == entry->lastAcquiredFrame + 1u;
+    entry->currentSlot ^= 1u;
+    entry->previousValid = consecutive;
+  }
+  if (entry->invalidatePending) {
+    entry->previousValid = false;
+    entry->invalidatePending = false;
+  }
+  entry->acquiredOnce = true;
+  entry->lastAcquiredFrame = frameIndex_;
+
+  return Result<RenderGraphHistoryTextureHandles, std::string>::makeResult(
+      RenderGraphHistoryTextureHandles{
+          .current = entry->slots[entry->currentSlot],
+          .previous = entry->slots[entry->currentSlot ^ 1u],
+          .previousValid = entry->previousValid,
+      });
+}
+
+void RenderGraphHistoryResources::invalidate(std::string_view key) {
+  for (HistoryTexture &entry : textures_) {
+    if (entry.key == key) {
+      entry.invalidatePending = true;
+      return;
+    }
+  }
+}
+
+void RenderGraphHistoryResources::invalidateAll() {
+  for (HistoryTexture &entry : textures_) {
+    entry.invalidatePending = true;
+  }
+}
+
+Result<bool, std::string>
+RenderGraphHistoryResources::allocateSlots(HistoryTexture &entry,
+                                           const TextureDesc &desc) {
+  std::string debugName = "rg_history_";
+  debugName.append(entry.key.data(), entry.key.size());
+  for (TextureHandle &slot : entry.slots) {
+    auto createResult = gpu_.createTexture(desc, debugName);
+    if (createResult.hasError()) {
+      retireSlots(entry);
+      return Result<bool, std::string>::makeError(
+          "RenderGraphHistoryResources::acquireTexture: " +
+          createResult.error());
+    }
+    slot = createResult.value();
+  }
+  entry.desc = desc;
+  entry.currentSlot = 0u;
+  entry.previousValid = false;
+  entry.acquiredOnce = false;
+  return Result<bool, std::string>::makeResult(true);
+}
+
+void RenderGraphHistoryResources::retireSlots(HistoryTexture &entry) {
+  for (TextureHandle &slot : entry.slots) {
+    if (nuri::isValid(slot)) {
+      retiredTextures_.push_back(
+          RetiredTexture{.handle = slot, .retireFrame = frameIndex_});
+    }
+    slot = {};
+  }
+  entry.previousValid = false;
+}
+
+void RenderGraphHistoryResources::destroyRetired(bool force) {
+  size_t writeIndex = 0u;
+  for (size_t readIndex = 0u; readIndex < retiredTextures_.size();
+       ++readIndex) {
+    const RetiredTexture retired = retiredTextures_[readIndex];
+    const bool expired =
+        force ||
+        frameIndex_ >= retired.retireFrame + kHistoryRetireFrameLatency;
+    if (expired) {
+      gpu_.destroyTexture(retired.handle);
+      continue;
+    }
+    retiredTextures_[writeIndex++] = retired;
+  }
+  retiredTextures_.resize(writeIndex);
+}
+
+} // namespace nuri
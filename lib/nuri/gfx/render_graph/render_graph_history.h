@@ -0,0 +1,91 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/gfx/gpu_descriptors.h"
+#include "nuri/gfx/gpu_types.h"
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nuri {
+
+class GPUDevice;
+
+struct NURI_API RenderGraphHistoryTextureHandles {
+  TextureHandle current{};
+  TextureHandle previous{};
+  // False on the first frame after (re)allocation, after a skipped frame and
+  // on the first acquire after invalidate(); temporal consumers should reset
+  // instead of sampling.
+  bool previousValid = false;
+};
+
+// Persistent double-buffered textures keyed by name. Each frame the slot that
+// was written last frame becomes `previous`; a changed descriptor (e.g. on
+// resize) reallocates both slots. Retired textures are destroyed once the
+// frames that may still reference them have retired.
+class NURI_API RenderGraphHistoryResources {
+public:
+  explicit RenderGraphHistoryResources(
+      GPUDevice &gpu,
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+  ~RenderGraphHistoryResources();
+
+  RenderGraphHistoryResources(const RenderGraphHistoryResources &) = delete;
+  RenderGraphHistoryResources &
+  operator=(const RenderGraphHistoryResources &) = delete;
+  RenderGraphHistoryResources(RenderGraphHistoryResources &&) = delete;
+  RenderGraphHistoryResources &
+  operator=(RenderGraphHistoryResources &&) = delete;
+
+  void beginFrame(uint64_t frameIndex);
+  [[nodiscard]] Result<RenderGraphHistoryTextureHandles, std::string>
+  acquireTexture(std::string_view key, const TextureDesc &desc);
+  void invalidate(std::string_view key);
+  void invalidateAll();
+
+  [[nodiscard]] size_t textureCount() const noexcept {
+    return textures_.size();
+  }
+  [[nodiscard]] size_t retiredTextureCount() const noexcept {
+    return retiredTextures_.size();
+  }
+
+private:
+  struct HistoryTexture {
+    std::pmr::string key;
+    TextureDesc desc{};
+    std::array<TextureHandle, 2> slots{};
+    uint32_t currentSlot = 0u;
+    uint64_t lastAcquiredFrame = 0u;
+    bool acquiredOnce = false;
+    bool previousValid = false;
+    bool invalidatePending = false;
+
+    explicit HistoryTexture(std::pmr::memory_resource *memory)
+        : key(memory) {}
+  };
+
+  struct RetiredTexture {
+    TextureHandle handle{};
+    uint64_t retireFrame = 0u;
+  };
+
+  [[nodiscard]] Result<bool, std::string>
+  allocateSlots(HistoryTexture &entry, const TextureDesc &desc);
+  void retireSlots(HistoryTexture &entry);
+  void destroyRetired(bool force);
+
+  GPUDevice &gpu_;
+  std::pmr::memory_resource *memory_ = nullptr;
+  std::pmr::vector<HistoryTexture> textures_;
+  std::pmr::vector<RetiredTexture> retiredTextures_;
+  uint64_t frameIndex_ = 0u;
+};
+
+} // namespace nuri
@@ -160,7 +160,6 @@ void fingerprintString(uint64_t &hash, std::string_view value) {
 [[nodiscard]] uint64_t computeCompileFingerprint(
     const RenderGraphCompileResult &compiled) {
   uint64_t hash = fingerprintSeed();
-  fingerprintPod(hash, compiled.frameIndex);
   fingerprintPod(hash, compiled.declaredPassCount);
   fingerprintPod(hash, compiled.culledPassCount);
   fingerprintPod(hash, compiled.rootPassCount);
@@ -201,6 +200,85 @@ void fingerprintString(uint64_t &hash, std::string_view value) {
     fingerprintPod(hash, allocation.resourceIndex);
     fingerprintPod(hash, allocation.allocationIndex);
   }
+  for (const uint32_t allocationIndex :
+       compiled.transientTextureAllocationByResource) {
+    fingerprintPod(hash, allocationIndex);
+  }
+  for (const uint32_t allocationIndex :
+       compiled.transientBufferAllocationByResource) {
+    fingerprintPod(hash, allocationIndex);
+  }
+  for (const auto &physical : compiled.transientTexturePhysicalAllocations) {
+    fingerprintPod(hash, physical.allocationIndex);
+    fingerprintPod(hash, physical.representativeResourceIndex);
+    fingerprintPod(hash, physical.desc.format);
+    fingerprintPod(hash, physical.desc.dimensions);
+    fingerprintPod(hash, physical.desc.usage);
+  }
+  for (const auto &physical : compiled.transientBufferPhysicalAllocations) {
+    fingerprintPod(hash, physical.allocationIndex);
+    fingerprintPod(hash, physical.representativeResourceIndex);
+    fingerprintPod(hash, physical.desc.usage);
+    fingerprintPod(hash, physical.desc.size);
+  }
+  for (const auto &binding : compiled.unresolvedTextureBindings) {
+    fingerprintPod(hash, binding.orderedPassIndex);
+    fingerprintPod(hash, binding.textureResourceIndex);
+    fingerprintPod(hash, static_cast<uint8_t>(binding.target));
+    fingerprintPod(hash, binding.additionalColorIndex);
+  }
+  // Resolved slots hold per-frame ring handles, so only which slots are bound
+  // is part of the graph shape; the handles are refreshed separately.
+  for (const BufferHandle buffer : compiled.resolvedDependencyBuffers) {
+    fingerprintPod(hash, nuri::isValid(buffer));
+  }
+  for (const auto &range : compiled.dependencyBufferRangesByPass) {
+    fingerprintPod(hash, range.offset);
+    fingerprintPod(hash, range.count);
+  }
+  for (const auto &binding : compiled.unresolvedDependencyBufferBindings) {
+    fingerprintPod(hash, binding.orderedPassIndex);
+    fingerprintPod(hash, binding.dependencyBufferIndex);
+    fingerprintPod(hash, binding.bufferResourceIndex);
+  }
+  for (const auto &range : compiled.preDispatchRangesByPass) {
+    fingerprintPod(hash, range.offset);
+    fingerprintPod(hash, range.count);
+  }
+  for (const auto &range : compiled.preDispatchDependencyRanges) {
+    fingerprintPod(hash, range.offset);
+    fingerprintPod(hash, range.count);
+  }
+  for (const BufferHandle buffer :
+       compiled.resolvedPreDispatchDependencyBuffers) {
+    fingerprintPod(hash, nuri::isValid(buffer));
+  }
+  for (const auto &binding :
+       compiled.unresolvedPreDispatchDependencyBufferBindings) {
+    fingerprintPod(hash, binding.orderedPassIndex);
+    fingerprintPod(hash, binding.preDispatchIndex);
+    fingerprintPod(hash, binding.dependencyBufferIndex);
+    fingerprintPod(hash, binding.bufferResourceIndex);
+  }
+  for (const auto &range : compiled.drawRangesByPass) {
+    fingerprintPod(hash, range.offset);
+    fingerprintPod(hash, range.count);
+  }
+  for (const auto &binding : compiled.unresolvedDrawBufferBindings) {
+    fingerprintPod(hash, binding.orderedPassIndex);
+    fingerprintPod(hash, binding.drawIndex);
+    fingerprintPod(hash, static_cast<uint8_t>(binding.target));
+    fingerprintPod(hash, binding.bufferResourceIndex);
+  }
+  const uint32_t ownedPreDispatchCount =
+      static_cast<uint32_t>(compiled.ownedPreDispatches.size());
+  const uint32_t ownedDrawItemCount =
+      static_cast<uint32_t>(compiled.ownedDrawItems.size());
+  fingerprintPod(hash, compiled.transientTexturePhysicalCount);
+  fingerprintPod(hash, compiled.transientBufferPhysicalCount);
+  fingerprintPod(hash, compiled.resourceStats);
+  fingerprintPod(hash, ownedPreDispatchCount);
+  fingerprintPod(hash, ownedDrawItemCount);
   return hash;
 }
 
@@ -221,6 +299,8 @@ void fingerprintString(uint64_t &hash, std::string_view value) {
     fingerprintPod(hash, static_cast<uint8_t>(record.afterAccess));
     fingerprintPod(hash, static_cast<uint8_t>(record.beforeState));
     fingerprintPod(hash, static_cast<uint8_t>(record.afterState));
+    fingerprintPod(hash, static_cast<uint16_t>(record.beforeStages));
+    fingerprintPod(hash, static_cast<uint16_t>(record.afterStages));
   }
   return hash;
 }
@@ -247,9 +327,35 @@ void fingerprintString(uint64_t &hash, std::string_view value) {
   return hash;
 }
 
+struct TelemetryFingerprints {
+  uint64_t compile = 0;
+  uint64_t barrier = 0;
+  uint64_t execution = 0;
+
+  [[nodiscard]] bool
+  matches(const RenderGraphTelemetrySnapshot::Summary &summary) const {
+    return compile == summary.compileFingerprint &&
+           barrier == summary.barrierFingerprint &&
+           execution == summary.executionFingerprint;
+  }
+};
+
+[[nodiscard]] TelemetryFingerprints
+computeFingerprints(const RenderGraphCompileResult &compiled,
+                    const RenderGraphExecutionMetadata *execution) {
+  TelemetryFingerprints fingerprints{};
+  fingerprints.compile = computeCompileFingerprint(compiled);
+  fingerprints.barrier = computeBarrierFingerprint(compiled);
+  if (execution != nullptr) {
+    fingerprints.execution = computeExecutionFingerprint(*execution);
+  }
+  return fingerprints;
+}
+
 [[nodiscard]] RenderGraphTelemetrySnapshot::Summary
 buildSummary(const RenderGraphCompileResult &compiled,
-             const RenderGraphExecutionMetadata *execution) {
+             const RenderGraphExecutionMetadata *execution,
+             const TelemetryFingerprints &fingerprints) {
   RenderGraphTelemetrySnapshot::Summary summary = buildSummary(compiled);
   if (execution != nullptr) {
     summary.recordedCommandBufferCount =
@@ -258,10 +364,10 @@ buildSummary(const RenderGraphCompileResult &compiled,
         static_cast<uint32_t>(execution->submitBatches.size());
     summary.passRangeCount = static_cast<uint32_t>(execution->passRanges.size());
     summary.usedParallelRecording = execution->usedParallelRecording;
-    summary.executionFingerprint = computeExecutionFingerprint(*execution);
   }
-  summary.compileFingerprint = computeCompileFingerprint(compiled);
-  summary.barrierFingerprint = computeBarrierFingerprint(compiled);
+  summary.compileFingerprint = fingerprints.compile;
+  summary.barrierFingerprint = fingerprints.barrier;
+  summary.executionFingerprint = fingerprints.execution;
   return summary;
 }
 
@@ -314,6 +420,21 @@ void copyCompileSnapshotData(RenderGraphTelemetrySnapshot &snapshot,
              compiled.unresolvedDrawBufferBindings);
 }
 
+void fillSnapshot(RenderGraphTelemetrySnapshot &snapshot,
+                  const RenderGraphCompileResult &compiled,
+                  const RenderGraphExecutionMetadata *execution,
+                  const TelemetryFingerprints &fingerprints) {
+  snapshot.reset();
+  snapshot.summary = buildSummary(compiled, execution, fingerprints);
+  copyCompileSnapshotData(snapshot, compiled);
+  if (execution != nullptr) {
+    copyVector(snapshot.recordedCommandBuffers,
+               execution->recordedCommandBuffers);
+    copyVector(snapshot.submitBatches, execution->submitBatches);
+    copyVector(snapshot.passRanges, execution->passRanges);
+  }
+}
+
 template <typename Value>
 void writeKeyValue(std::ostream &stream, std::string_view key, Value value) {
   stream << key << ": " << value << "\n";
@@ -354,6 +475,8 @@ void writeIndexedSection(std::ostream &stream, std::string_view title,
     return "color";
   case RenderGraphCompileResult::PassTextureBindingTarget::Depth:
     return "depth";
+  case RenderGraphCompileResult::PassTextureBindingTarget::AdditionalColor:
+    return "additional_color";
   }
 
   return "unknown";
@@ -418,20 +541,15 @@ RenderGraphTelemetrySnapshot::RenderGraphTelemetrySnapshot(
 
 void RenderGraphTelemetrySnapshot::captureFrom(
     const RenderGraphCompileResult &compiled) {
-  reset();
-  summary = buildSummary(compiled, nullptr);
-  copyCompileSnapshotData(*this, compiled);
+  fillSnapshot(*this, compiled, nullptr,
+               computeFingerprints(compiled, nullptr));
 }
 
 void RenderGraphTelemetrySnapshot::captureFrom(
     const RenderGraphCompileResult &compiled,
     const RenderGraphExecutionMetadata &execution) {
-  reset();
-  summary = buildSummary(compiled, &execution);
-  copyCompileSnapshotData(*this, compiled);
-  copyVector(recordedCommandBuffers, execution.recordedCommandBuffers);
-  copyVector(submitBatches, execution.submitBatches);
-  copyVector(passRanges, execution.passRanges);
+  fillSnapshot(*this, compiled, &execution,
+               computeFingerprints(compiled, &execution));
 }
 
 void RenderGraphTelemetrySnapshot::reset() {
@@ -467,20 +585,54 @@ void RenderGraphTelemetrySnapshot::reset() {
 
 RenderGraphTelemetryService::RenderGraphTelemetryService(
     std::pmr::memory_resource *memory)
-    : snapshot_(ensureMemory(memory)),
+    : snapshots_{RenderGraphTelemetrySnapshot(ensureMemory(memory)),
+                 RenderGraphTelemetrySnapshot(ensureMemory(memory))},
       configuredDumpDirectory_(resolveRenderGraphDumpDirectory()) {}
 
 void RenderGraphTelemetryService::capture(
     const RenderGraphCompileResult &compiled) {
-  snapshot_.captureFrom(compiled);
-  hasSnapshot_ = true;
+  captureInternal(compiled, nullptr);
 }
 
 void RenderGraphTelemetryService::capture(
     const RenderGraphCompileResult &compiled,
     const RenderGraphExecutionMetadata &execution) {
-  snapshot_.captureFrom(compiled, execution);
+  captureInternal(compiled, &execution);
+}
+
+void RenderGraphTelemetryService::captureInternal(
+    const RenderGraphCompileResult &compiled,
+    const RenderGraphExecutionMetadata *execution) {
+  const bool forced = captureRequested_ || !hasSnapshot_;
+  if (!forced) {
+    ++framesSinceSample_;
+    if (sampleInterval_ == 0u || framesSinceSample_ < sampleInterval_) {
+      ++captureStats_.sampledOutFrames;
+      return;
+    }
+  }
+  framesSinceSample_ = 0u;
+
+  const TelemetryFingerprints fingerprints =
+      computeFingerprints(compiled, execution);
+  RenderGraphTelemetrySnapshot &front = snapshots_[frontIndex_];
+  if (!forced && fingerprints.matches(front.summary)) {
+    front.summary.frameIndex = compiled.frameIndex;
+    // Same slot layout, so this only overwrites handles in place.
+    copyVector(front.resolvedDependencyBuffers,
+               compiled.resolvedDependencyBuffers);
+    ++captureStats_.unchangedFrames;
+    return;
+  }
+
+  // The back snapshot keeps its capacity, so steady-state captures reuse the
+  // same storage and publishing is an index flip.
+  const uint32_t backIndex = frontIndex_ ^ 1u;
+  fillSnapshot(snapshots_[backIndex], compiled, execution, fingerprints);
+  frontIndex_ = backIndex;
+  captureRequested_ = false;
   hasSnapshot_ = true;
+  ++captureStats_.capturedSnapshots;
 }
 
 std::filesystem::path RenderGraphTelemetryService::suggestDumpPath() const {
@@ -489,7 +641,8 @@ std::filesystem::path RenderGraphTelemetryService::suggestDumpPath() const {
                                        : configuredDumpDirectory_;
   std::ostringstream fileName;
   fileName << "render_graph_frame_"
-           << (hasSnapshot_ ? snapshot_.summary.frameIndex : 0ull) << ".txt";
+           << (hasSnapshot_ ? snapshots_[frontIndex_].summary.frameIndex : 0ull)
+           << ".txt";
   return dumpDirectory / fileName.str();
 }
 
@@ -500,7 +653,7 @@ Result<bool, std::string> RenderGraphTelemetryService::writeLatestTextDump(
         "RenderGraphTelemetryService::writeLatestTextDump: no snapshot "
         "captured");
   }
-  return writeRenderGraphTelemetryTextDump(snapshot_, outputPath);
+  return writeRenderGraphTelemetryTextDump(snapshots_[frontIndex_], outputPath);
 }
 
 Result<bool, std::string>
@@ -4,6 +4,7 @@
 #include "nuri/defines.h"
 #include "nuri/gfx/render_graph/render_graph.h"
 
+#include <array>
 #include <filesystem>
 #include <memory_resource>
 #include <string>
@@ -109,6 +110,15 @@ struct NURI_API RenderGraphTelemetrySnapshot {
   void reset();
 };
 
+struct RenderGraphTelemetryCaptureStats {
+  uint64_t capturedSnapshots = 0;
+  uint64_t unchangedFrames = 0;
+  uint64_t sampledOutFrames = 0;
+};
+
+// Captures are change-driven: a frame whose graph fingerprints match the
+// front snapshot only bumps its frame index. Changed graphs are written into
+// the back snapshot, which then becomes the front one.
 class NURI_API RenderGraphTelemetryService {
 public:
   explicit RenderGraphTelemetryService(
@@ -117,18 +127,38 @@ public:
   void capture(const RenderGraphCompileResult &compiled);
   void capture(const RenderGraphCompileResult &compiled,
                const RenderGraphExecutionMetadata &execution);
+  // Frames between capture attempts. 0 disables sampling, so only frames
+  // after requestCapture() are captured.
+  void setSampleInterval(uint32_t frames) noexcept { sampleInterval_ = frames; }
+  [[nodiscard]] uint32_t sampleInterval() const noexcept {
+    return sampleInterval_;
+  }
+  // Forces a full copy on the next capture, even if nothing changed.
+  void requestCapture() noexcept { captureRequested_ = true; }
+  [[nodiscard]] const RenderGraphTelemetryCaptureStats &
+  captureStats() const noexcept {
+    return captureStats_;
+  }
   [[nodiscard]] bool hasSnapshot() const noexcept { return hasSnapshot_; }
   [[nodiscard]] const RenderGraphTelemetrySnapshot *
   latestSnapshot() const noexcept {
-    return hasSnapshot_ ? &snapshot_ : nullptr;
+    return hasSnapshot_ ? &snapshots_[frontIndex_] : nullptr;
   }
   [[nodiscard]] std::filesystem::path suggestDumpPath() const;
   [[nodiscard]] Result<bool, std::string>
   writeLatestTextDump(std::string_view outputPath) const;
 
 private:
-  RenderGraphTelemetrySnapshot snapshot_;
+  void captureInternal(const RenderGraphCompileResult &compiled,
+                       const RenderGraphExecutionMetadata *execution);
+
+  std::array<RenderGraphTelemetrySnapshot, 2> snapshots_;
   std::filesystem::path configuredDumpDirectory_;
+  RenderGraphTelemetryCaptureStats captureStats_{};
+  uint32_t frontIndex_ = 0;
+  uint32_t sampleInterval_ = 1;
+  uint32_t framesSinceSample_ = 0;
+  bool captureRequested_ = false;
   bool hasSnapshot_ = false;
 };
 
@@ -4,6 +4,7 @@
 
 #include "nuri/core/layer_stack.h"
 #include "nuri/core/log.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/profiling.h"
 #include "nuri/gfx/gpu_device.h"
 #include "nuri/gfx/render_graph/render_graph_telemetry.h"
@@ -24,15 +25,35 @@ namespace {
   return value == "1" || value == "true" || value == "TRUE";
 }
 
+const PerfCounterId kGraphPassesCounter =
+    PerfCounters::registerCounter("render_graph.passes");
+const PerfCounterId kGraphCulledPassesCounter =
+    PerfCounters::registerCounter("render_graph.culled_passes");
+const PerfCounterId kGraphBarriersCounter =
+    PerfCounters::registerCounter("render_graph.barriers");
+const PerfCounterId kGraphCommandBuffersCounter =
+    PerfCounters::registerCounter("render_graph.command_buffers");
+
+void publishRenderGraphCounters(const RenderGraphCompileResult &compiled,
+                                const RenderGraphExecutionMetadata &executed) {
+  PerfCounters::add(kGraphPassesCounter, compiled.orderedPasses.size());
+  PerfCounters::add(kGraphCulledPassesCounter, compiled.culledPassCount);
+  PerfCounters::add(kGraphBarriersCounter, compiled.passBarrierRecords.size());
+  PerfCounters::add(kGraphCommandBuffersCounter,
+                    executed.recordedCommandBuffers.size());
+}
+
 } // namespace
 
 Renderer::Renderer(GPUDevice &gpu, std::pmr::memory_resource &memory)
-    : gpu_(gpu), resources_(gpu, &memory), renderGraphRuntime_(&memory),
-      renderGraphBuilder_(&memory), renderGraphExecutor_(&memory),
-      renderGraphTelemetry_(&memory),
+    : gpu_(gpu), frameArenas_(&memory), resources_(gpu, &memory),
+      pipelines_(gpu, &memory), renderGraphRuntime_(&memory),
+      renderGraphHistory_(gpu, &memory), renderGraphBuilder_(&memory),
+      renderGraphExecutor_(&memory), renderGraphTelemetry_(&memory),
       suppressInferredSideEffects_(resolveSuppressInferredSideEffectsFlag()) {
   renderGraphBuilder_.setInferredSideEffectSuppression(
       suppressInferredSideEffects_);
+  renderGraphBuilder_.setHistoryResources(&renderGraphHistory_);
   if (suppressInferredSideEffects_) {
     NURI_LOG_INFO(
         "Renderer: inferred render-graph side-effect suppression is "
@@ -83,7 +104,9 @@ Result<bool, std::string> Renderer::render(LayerStack &layers,
 Result<bool, std::string> Renderer::beginFrameSequence(uint64_t frameIndex) {
   {
     NURI_PROFILER_ZONE("Renderer.begin_frame", NURI_PROFILER_COLOR_CMD_COPY);
+    frameArenas_.beginFrame(frameIndex);
     resources_.beginFrame(frameIndex);
+    pipelines_.beginFrame(frameIndex);
     NURI_PROFILER_ZONE_END();
   }
 
@@ -100,7 +123,8 @@ Result<bool, std::string> Renderer::beginFrameSequence(uint64_t frameIndex) {
 void Renderer::renderGraphBeginFrame(uint64_t frameIndex) {
   NURI_PROFILER_ZONE("Renderer.render_graph_begin_frame",
                      NURI_PROFILER_COLOR_CMD_COPY);
-  renderGraphBuilder_.beginFrame(frameIndex);
+  renderGraphBuilder_.beginFrame(frameIndex, frameArenas_.resource());
+  renderGraphExecutor_.setFrameMemory(frameArenas_.resource());
   NURI_PROFILER_ZONE_END();
 }
 
@@ -150,6 +174,7 @@ Result<bool, std::string> Renderer::compileAndExecuteRenderGraph() {
     renderGraphTelemetry_.capture(compileResult.value(), executeResult.value());
     NURI_PROFILER_ZONE_END();
   }
+  publishRenderGraphCounters(compileResult.value(), executeResult.value());
   return Result<bool, std::string>::makeResult(true);
 }
 
@@ -5,7 +5,9 @@
 #include "nuri/gfx/layers/render_frame_context.h"
 
 #include "nuri/core/layer_stack.h"
+#include "nuri/core/pmr_scratch.h"
 #include "nuri/gfx/gpu_device.h"
+#include "nuri/gfx/pipeline_manager.h"
 #include "nuri/gfx/render_graph/render_graph.h"
 #include "nuri/gfx/render_graph/render_graph_telemetry.h"
 #include "nuri/resources/gpu/resource_manager.h"
@@ -41,6 +43,10 @@ public:
   [[nodiscard]] const ResourceManager &resources() const noexcept {
     return resources_;
   }
+  [[nodiscard]] PipelineManager &pipelines() noexcept { return pipelines_; }
+  [[nodiscard]] RenderGraphHistoryResources &renderGraphHistory() noexcept {
+    return renderGraphHistory_;
+  }
   [[nodiscard]] RenderGraphTelemetryService &renderGraphTelemetry() noexcept {
     return renderGraphTelemetry_;
   }
@@ -56,9 +62,15 @@ private:
   [[nodiscard]] Result<bool, std::string> endFrameSequence(uint64_t frameIndex);
   [[nodiscard]] Result<bool, std::string> compileAndExecuteRenderGraph();
 
+  // Compile results and execution metadata live until the slot is reused.
+  static constexpr uint32_t kFrameArenaCount = 2u;
+
   GPUDevice &gpu_;
+  FrameArenaRing<kFrameArenaCount> frameArenas_;
   ResourceManager resources_;
+  PipelineManager pipelines_;
   RenderGraphRuntime renderGraphRuntime_;
+  RenderGraphHistoryResources renderGraphHistory_;
   RenderGraphBuilder renderGraphBuilder_;
   RenderGraphExecutor renderGraphExecutor_;
   RenderGraphTelemetryService renderGraphTelemetry_;
@@ -3,9 +3,11 @@
 
 #include "nuri/core/log.h"
 #include "nuri/core/profiling.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
 
 #include <algorithm>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 namespace nuri {
@@ -26,53 +28,31 @@ normalizePath(const std::filesystem::path &filePath) {
   return normalized.lexically_normal();
 }
 
+// Sources read ahead of expansion, keyed by normalized path.
+using ShaderSources = std::unordered_map<std::string, std::string>;
+
 [[nodiscard]] std::string
-readFileToString(const std::filesystem::path &filePath, std::string &errorMsg) {
+readFileToString(const std::filesystem::path &filePath, std::string &errorMsg,
+                 const ShaderSources *sources = nullptr) {
   NURI_PROFILER_FUNCTION();
   errorMsg.clear();
-
-  std::ifstream file(filePath, std::ios::binary);
-  if (!file.is_open()) {
-    errorMsg = "Failed to open file: " + filePath.string();
-    return {};
-  }
-
-  std::error_code ec;
-  const auto fileSize = std::filesystem::file_size(filePath, ec);
-
-  std::string content;
-
-  if (!ec && fileSize > 0) {
-    content.resize(fileSize);
-    file.read(content.data(), static_cast<std::streamsize>(fileSize));
-
-    const auto bytesRead = file.gcount();
-
-    if (file.bad()) {
-      errorMsg = "Failed to read file: " + filePath.string();
-      return {};
-    }
-
-    if (bytesRead != static_cast<std::streamsize>(fileSize)) {
-      content.resize(static_cast<size_t>(bytesRead));
-    }
-  } else {
-    try {
-      content.assign(std::istreambuf_iterator<char>(file),
-                     std::istreambuf_iterator<char>());
-
-      if (file.bad()) {
-        errorMsg = "Failed to read file: " + filePath.string();
-        return {};
-      }
-    } catch (const std::exception &e) {
-      errorMsg =
-          "Failed to read file: " + filePath.string() + " (" + e.what() + ")";
-      return {};
+  if (sources != nullptr) {
+    const auto it = sources->find(filePath.string());
+    if (it != sources->end()) {
+      return it->second;
     }
   }
 
-  return content;
+  // Goes through the asset file system so shaders resolve from a mounted
+  // archive first and from disk otherwise.
+  auto bytes = readAssetFile(filePath);
+  if (bytes.hasError()) {
+    errorMsg = "Failed to read file: " + filePath.string() + " (" +
+               bytes.error() + ")";
+    return {};
+  }
+  return std::string(reinterpret_cast<const char *>(bytes.value().data()),
+                     bytes.value().size());
 }
 
 [[nodiscard]] std::string_view trimLeft(std::string_view value) {
@@ -124,10 +104,63 @@ struct IncludeDirective {
   return directive;
 }
 
+// Reads the given files and everything they include with one
+// readAssetFiles batch per include level, so stages that share headers read
+// them once and archive-backed files are grouped per archive. Files that fail
+// to read are left out; expansion then reads them alone and reports the
+// error with its include context.
+[[nodiscard]] ShaderSources
+prefetchShaderSources(std::span<const std::filesystem::path> files) {
+  NURI_PROFILER_FUNCTION();
+  ShaderSources sources;
+  std::vector<std::filesystem::path> pending;
+  for (const std::filesystem::path &file : files) {
+    std::filesystem::path normalized = normalizePath(file);
+    if (std::find(pending.begin(), pending.end(), normalized) ==
+        pending.end()) {
+      pending.push_back(std::move(normalized));
+    }
+  }
+
+  for (size_t depth = 0; !pending.empty() && depth < kMaxIncludeDepth;
+       ++depth) {
+    auto batch = readAssetFiles(pending);
+    if (batch.hasError()) {
+      break;
+    }
+    std::vector<std::filesystem::path> next;
+    for (size_t i = 0; i < pending.size(); ++i) {
+      const std::vector<std::byte> &bytes = batch.value()[i];
+      std::string source(reinterpret_cast<const char *>(bytes.data()),
+                         bytes.size());
+      std::istringstream sourceStream(source);
+      std::string line;
+      while (std::getline(sourceStream, line)) {
+        const IncludeDirective directive = parseIncludeDirective(line);
+        if (directive.kind != IncludeDirective::Kind::Include) {
+          continue;
+        }
+        std::filesystem::path includePath =
+            normalizePath(pending[i].parent_path() / directive.includePath);
+        if (!sources.contains(includePath.string()) &&
+            std::find(pending.begin(), pending.end(), includePath) ==
+                pending.end() &&
+            std::find(next.begin(), next.end(), includePath) == next.end()) {
+          next.push_back(std::move(includePath));
+        }
+      }
+      sources.emplace(pending[i].string(), std::move(source));
+    }
+    pending = std::move(next);
+  }
+  return sources;
+}
+
 [[nodiscard]] bool
 expandShaderIncludesRecursive(const std::filesystem::path &filePath,
                               std::vector<std::filesystem::path> &includeStack,
-                              std::string &outCode, std::string &errorMsg) {
+                              std::string &outCode, std::string &errorMsg,
+                              const ShaderSources *sources = nullptr) {
   const std::filesystem::path normalizedPath = normalizePath(filePath);
 
   const auto cycleIt =
@@ -153,7 +186,7 @@ expandShaderIncludesRecursive(const std::filesystem::path &filePath,
     return false;
   }
 
-  std::string source = readFileToString(normalizedPath, errorMsg);
+  std::string source = readFileToString(normalizedPath, errorMsg, sources);
   if (!errorMsg.empty()) {
     return false;
   }
@@ -190,7 +223,7 @@ expandShaderIncludesRecursive(const std::filesystem::path &filePath,
 
     std::string includeCode;
     if (!expandShaderIncludesRecursive(includePath, includeStack, includeCode,
-                                       errorMsg)) {
+                                       errorMsg, sources)) {
       errorMsg = std::string("While expanding include '") +
                  directive.includePath + "' in '" + normalizedPath.string() +
                  "' at line " + std::to_string(lineNumber) + ": " + errorMsg;
@@ -207,6 +240,41 @@ expandShaderIncludesRecursive(const std::filesystem::path &filePath,
   includeStack.pop_back();
   return true;
 }
+
+[[nodiscard]] Result<ShaderHandle, std::string>
+compileExpandedFile(Shader &shader, std::string_view path, ShaderStage stage,
+                    const ShaderSources *sources) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  std::vector<std::filesystem::path> includeStack;
+  std::string expandedCode;
+  std::string expandError;
+  if (!expandShaderIncludesRecursive(std::filesystem::path(path), includeStack,
+                                     expandedCode, expandError, sources)) {
+    const std::string pathStr{path};
+    NURI_LOG_WARNING(
+        "Shader::compileFromFile: Failed to load/expand shader file '%s': %s",
+        pathStr.c_str(), expandError.c_str());
+    return Result<ShaderHandle, std::string>::makeError(
+        "Failed to load/expand shader file '" + pathStr + "': " + expandError);
+  }
+
+  auto compileResult = shader.compile(expandedCode, stage);
+  if (compileResult.hasError()) {
+    const std::string pathStr{path};
+    NURI_LOG_WARNING(
+        "Shader::compileFromFile: Failed to compile shader file '%s': %s",
+        pathStr.c_str(), compileResult.error().c_str());
+    return Result<ShaderHandle, std::string>::makeError(
+        "Failed to compile shader file '" + pathStr +
+        "': " + compileResult.error());
+  }
+
+  NURI_LOG_DEBUG(
+      "Shader::compileFromFile: Compiled shader file '%.*s' for stage %s",
+      static_cast<int>(path.size()), path.data(), ShaderStageToString(stage));
+
+  return compileResult;
+}
 } // namespace
 
 Shader::Shader(std::string_view moduleName, GPUDevice &gpu)
@@ -264,36 +332,35 @@ Result<ShaderHandle, std::string> Shader::compile(const std::string &code,
 
 Result<ShaderHandle, std::string> Shader::compileFromFile(std::string_view path,
                                                           ShaderStage stage) {
+  return compileExpandedFile(*this, path, stage, nullptr);
+}
+
+Result<std::vector<ShaderHandle>, std::string>
+Shader::compileFromFiles(std::span<const ShaderFile> files) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
-  std::vector<std::filesystem::path> includeStack;
-  std::string expandedCode;
-  std::string expandError;
-  if (!expandShaderIncludesRecursive(std::filesystem::path(path), includeStack,
-                                     expandedCode, expandError)) {
-    const std::string pathStr{path};
-    NURI_LOG_WARNING(
-        "Shader::compileFromFile: Failed to load/expand shader file '%s': %s",
-        pathStr.c_str(), expandError.c_str());
-    return Result<ShaderHandle, std::string>::makeError(
-        "Failed to load/expand shader file '" + pathStr + "': " + expandError);
+  std::vector<std::filesystem::path> paths;
+  paths.reserve(files.size());
+  for (const ShaderFile &file : files) {
+    paths.emplace_back(file.path);
   }
-
-  auto compileResult = compile(expandedCode, stage);
-  if (compileResult.hasError()) {
-    const std::string pathStr{path};
-    NURI_LOG_WARNING(
-        "Shader::compileFromFile: Failed to compile shader file '%s': %s",
-        pathStr.c_str(), compileResult.error().c_str());
-    return Result<ShaderHandle, std::string>::makeError(
-        "Failed to compile shader file '" + pathStr +
-        "': " + compileResult.error());
+  const ShaderSources sources = prefetchShaderSources(paths);
+
+  std::vector<ShaderHandle> handles;
+  handles.reserve(files.size());
+  for (const ShaderFile &file : files) {
+    auto result = compileExpandedFile(*this, file.path, file.stage, &sources);
+    if (result.hasError()) {
+      for (size_t i = 0; i < handles.size(); ++i) {
+        gpu_.destroyShaderModule(handles[i]);
+        shaderHandles_[static_cast<size_t>(files[i].stage)] = {};
+      }
+      return Result<std::vector<ShaderHandle>, std::string>::makeError(
+          result.error());
+    }
+    handles.push_back(result.value());
   }
-
-  NURI_LOG_DEBUG(
-      "Shader::compileFromFile: Compiled shader file '%.*s' for stage %s",
-      static_cast<int>(path.size()), path.data(), ShaderStageToString(stage));
-
-  return compileResult;
+  return Result<std::vector<ShaderHandle>, std::string>::makeResult(
+      std::move(handles));
 }
 
 ShaderHandle Shader::getHandle(ShaderStage stage) const {
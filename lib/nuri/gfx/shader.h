@@ -7,12 +7,19 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 namespace nuri {
 
 class GPUDevice;
 
+struct ShaderFile {
+  std::string_view path;
+  ShaderStage stage = ShaderStage::Vertex;
+};
+
 class NURI_API Shader {
 public:
   Shader(std::string_view moduleName, GPUDevice &gpu);
@@ -35,6 +42,11 @@ public:
 
   Result<ShaderHandle, std::string> compileFromFile(std::string_view path,
                                                     ShaderStage stage);
+  // Compiles several stages, reading the files and their includes in
+  // batches through readAssetFiles. Handles come back in request order; on
+  // failure the stages compiled by this call are destroyed.
+  Result<std::vector<ShaderHandle>, std::string>
+  compileFromFiles(std::span<const ShaderFile> files);
 
   [[nodiscard]] ShaderHandle getHandle(ShaderStage stage) const;
 
@@ -0,0 +1,470 @@
+#include "nuri/pch.h"
+
+#include "nuri/gfx/software_occlusion.h"
+
+#include "nuri/core/profiling.h"
+
+namespace nuri {
+namespace {
+
+// Vertices closer than this (in clip-space w) are treated as crossing the
+// near plane; occluders drop the triangle and occludees count as visible.
+constexpr float kMinClipW = 1.0e-4f;
+constexpr uint32_t kMaxThreadCount = 4;
+constexpr size_t kBoundsPerJob = 64;
+constexpr float kFarDepth = std::numeric_limits<float>::infinity();
+
+using TileMask = std::array<uint32_t, SoftwareOcclusionCuller::kTileHeight>;
+
+[[nodiscard]] uint32_t roundUpTo(uint32_t value, uint32_t multiple) {
+  return std::max(multiple, (value + multiple - 1u) / multiple * multiple);
+}
+
+// Worker threads to spawn; the calling thread always takes part.
+[[nodiscard]] uint32_t resolveWorkerCount(uint32_t requestedThreads) {
+  const uint32_t threadCount =
+      requestedThreads != 0u
+          ? requestedThreads
+          : static_cast<uint32_t>(std::thread::hardware_concurrency());
+  return std::clamp(threadCount, 1u, kMaxThreadCount) - 1u;
+}
+
+// Bits [first, last] of a 32 pixel tile row, both relative to the tile.
+[[nodiscard]] uint32_t spanMask(uint32_t first, uint32_t last) {
+  const uint32_t count = last - first + 1u;
+  const uint32_t bits = count >= 32u ? ~0u : ((1u << count) - 1u);
+  return bits << first;
+}
+
+[[nodiscard]] bool isMaskFull(const TileMask &mask) {
+  for (const uint32_t row : mask) {
+    if (row != ~0u) {
+      return false;
+    }
+  }
+  return true;
+}
+
+[[nodiscard]] bool isMaskEmpty(const TileMask &mask) {
+  for (const uint32_t row : mask) {
+    if (row != 0u) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+SoftwareOcclusionCuller::SoftwareOcclusionCuller(
+    const SoftwareOcclusionConfig &config, std::pmr::memory_resource *memory)
+    : width_(roundUpTo(config.width, kTileWidth)),
+      height_(roundUpTo(config.height, kTileHeight)),
+      tilesX_(width_ / kTileWidth), tilesY_(height_ / kTileHeight),
+      tiles_(memory), occluders_(memory), triangles_(memory) {
+  tiles_.resize(static_cast<size_t>(tilesX_) * tilesY_);
+  const uint32_t workerCount = resolveWorkerCount(config.threadCount);
+  workers_.reserve(workerCount);
+  for (uint32_t i = 0; i < workerCount; ++i) {
+    workers_.emplace_back(
+        [this](std::stop_token stopToken) { workerLoop(stopToken); });
+  }
+}
+
+SoftwareOcclusionCuller::~SoftwareOcclusionCuller() {
+  for (std::jthread &worker : workers_) {
+    worker.request_stop();
+  }
+  {
+    std::scoped_lock lock(jobMutex_);
+    jobCv_.notify_all();
+  }
+  workers_.clear();
+}
+
+void SoftwareOcclusionCuller::beginFrame(const glm::mat4 &viewProj) {
+  viewProj_ = viewProj;
+  for (Tile &tile : tiles_) {
+    tile.mask.fill(0u);
+    tile.zMax0 = kFarDepth;
+    tile.zMax1 = 0.0f;
+  }
+  occluders_.clear();
+  triangles_.clear();
+  stats_ = {};
+}
+
+void SoftwareOcclusionCuller::addOccluder(std::span<const glm::vec3> positions,
+                                          std::span<const uint32_t> indices,
+                                          const glm::mat4 &modelMatrix) {
+  const size_t triangleCount = indices.size() / 3u;
+  if (positions.empty() || triangleCount == 0) {
+    return;
+  }
+  size_t firstTriangle = 0;
+  if (!occluders_.empty()) {
+    const Occluder &last = occluders_.back();
+    firstTriangle = last.firstTriangle + last.indices.size() / 3u;
+  }
+  occluders_.push_back(Occluder{.positions = positions,
+                                .indices = indices,
+                                .modelMatrix = modelMatrix,
+                                .firstTriangle = firstTriangle});
+}
+
+void SoftwareOcclusionCuller::rasterize() {
+  NURI_PROFILER_FUNCTION();
+  size_t triangleCount = 0;
+  if (!occluders_.empty()) {
+    const Occluder &last = occluders_.back();
+    triangleCount = last.firstTriangle + last.indices.size() / 3u;
+  }
+  triangles_.assign(triangleCount, ScreenTriangle{});
+  stats_.occluders = static_cast<uint32_t>(occluders_.size());
+  stats_.occluderTriangles = static_cast<uint32_t>(triangleCount);
+  if (triangleCount == 0) {
+    return;
+  }
+
+  rasterizedTriangles_.store(0u, std::memory_order_relaxed);
+  parallelFor(occluders_.size(), [this](size_t index) {
+    setupTriangles(index);
+  });
+  parallelFor(tilesY_, [this](size_t tileRow) {
+    rasterizeTileRow(static_cast<uint32_t>(tileRow));
+  });
+  stats_.rasterizedTriangles =
+      rasterizedTriangles_.load(std::memory_order_relaxed);
+}
+
+void SoftwareOcclusionCuller::setupTriangles(size_t occluderIndex) {
+  const Occluder &occluder = occluders_[occluderIndex];
+  const glm::mat4 modelViewProj = viewProj_ * occluder.modelMatrix;
+  const float width = static_cast<float>(width_);
+  const float height = static_cast<float>(height_);
+  const size_t triangleCount = occluder.indices.size() / 3u;
+  uint32_t setupCount = 0;
+
+  for (size_t t = 0; t < triangleCount; ++t) {
+    ScreenTriangle &out = triangles_[occluder.firstTriangle + t];
+    std::array<glm::vec2, 3> screen{};
+    float maxDepth = 0.0f;
+    bool clipped = false;
+    for (uint32_t corner = 0; corner < 3u; ++corner) {
+      const uint32_t index = occluder.indices[t * 3u + corner];
+      if (index >= occluder.positions.size()) {
+        clipped = true;
+        break;
+      }
+      const glm::vec4 clip =
+          modelViewProj * glm::vec4(occluder.positions[index], 1.0f);
+      if (clip.w <= kMinClipW) {
+        clipped = true;
+        break;
+      }
+      const float invW = 1.0f / clip.w;
+      screen[corner] = glm::vec2((clip.x * invW * 0.5f + 0.5f) * width,
+                                 (clip.y * invW * 0.5f + 0.5f) * height);
+      maxDepth = std::max(maxDepth, clip.w);
+    }
+    if (clipped) {
+      continue;
+    }
+
+    const glm::vec2 ab = screen[1] - screen[0];
+    const glm::vec2 ac = screen[2] - screen[0];
+    const float area = ab.x * ac.y - ab.y * ac.x;
+    if (std::abs(area) < 1.0e-6f) {
+      continue;
+    }
+    if (area < 0.0f) {
+      std::swap(screen[1], screen[2]);
+    }
+
+    out.minX = std::min({screen[0].x, screen[1].x, screen[2].x});
+    out.maxX = std::max({screen[0].x, screen[1].x, screen[2].x});
+    out.minY = std::min({screen[0].y, screen[1].y, screen[2].y});
+    out.maxY = std::max({screen[0].y, screen[1].y, screen[2].y});
+    if (out.maxX < 0.0f || out.minX > width || out.maxY < 0.0f ||
+        out.minY > height) {
+      continue;
+    }
+    out.vertices = screen;
+    out.maxDepth = maxDepth;
+    out.valid = true;
+    ++setupCount;
+  }
+  rasterizedTriangles_.fetch_add(setupCount, std::memory_order_relaxed);
+}
+
+void SoftwareOcclusionCuller::rasterizeTileRow(uint32_t tileRow) {
+  const float bandTop = static_cast<float>(tileRow * kTileHeight);
+  const float bandBottom = bandTop + static_cast<float>(kTileHeight);
+  const float maxX = static_cast<float>(width_);
+  const int32_t lastPixel = static_cast<int32_t>(width_) - 1;
+  Tile *const rowTiles = tiles_.data() + static_cast<size_t>(tileRow) * tilesX_;
+
+  std::array<int32_t, kTileHeight> spanStart{};
+  std::array<int32_t, kTileHeight> spanEnd{};
+  for (const ScreenTriangle &triangle : triangles_) {
+    if (!triangle.valid || triangle.maxY < bandTop ||
+        triangle.minY > bandBottom) {
+      continue;
+    }
+
+    int32_t bandMinX = lastPixel + 1;
+    int32_t bandMaxX = -1;
+    for (uint32_t row = 0; row < kTileHeight; ++row) {
+      spanStart[row] = 0;
+      spanEnd[row] = -1;
+      const float y = bandTop + static_cast<float>(row) + 0.5f;
+      if (y < triangle.minY || y > triangle.maxY) {
+        continue;
+      }
+
+      // Pixel centres inside all three edges (interior on the left).
+      float left = -1.0f;
+      float right = maxX + 1.0f;
+      bool empty = false;
+      for (uint32_t edge = 0; edge < 3u; ++edge) {
+        const glm::vec2 &a = triangle.vertices[edge];
+        const glm::vec2 &b = triangle.vertices[(edge + 1u) % 3u];
+        const float dy = b.y - a.y;
+        const float c = (b.x - a.x) * (y - a.y);
+        if (dy > 0.0f) {
+          right = std::min(right, a.x + c / dy);
+        } else if (dy < 0.0f) {
+          left = std::max(left, a.x + c / dy);
+        } else if (c < 0.0f) {
+          empty = true;
+        }
+      }
+      if (empty || left > right) {
+        continue;
+      }
+      const int32_t first =
+          std::max(0, static_cast<int32_t>(std::ceil(left - 0.5f)));
+      const int32_t last = std::min(
+          lastPixel, static_cast<int32_t>(std::floor(right - 0.5f)));
+      if (first > last) {
+        continue;
+      }
+      spanStart[row] = first;
+      spanEnd[row] = last;
+      bandMinX = std::min(bandMinX, first);
+      bandMaxX = std::max(bandMaxX, last);
+    }
+    if (bandMinX > bandMaxX) {
+      continue;
+    }
+
+    const uint32_t firstTile = static_cast<uint32_t>(bandMinX) / kTileWidth;
+    const uint32_t lastTile = static_cast<uint32_t>(bandMaxX) / kTileWidth;
+    for (uint32_t tileX = firstTile; tileX <= lastTile; ++tileX) {
+      const int32_t tileLeft = static_cast<int32_t>(tileX * kTileWidth);
+      const int32_t tileRight = tileLeft + static_cast<int32_t>(kTileWidth) - 1;
+      TileMask mask{};
+      bool covered = false;
+      for (uint32_t row = 0; row < kTileHeight; ++row) {
+        const int32_t first = std::max(spanStart[row], tileLeft);
+        const int32_t last = std::min(spanEnd[row], tileRight);
+        if (first > last) {
+          continue;
+        }
+        mask[row] = spanMask(static_cast<uint32_t>(first - tileLeft),
+                             static_cast<uint32_t>(last - tileLeft));
+        covered = true;
+      }
+      if (covered) {
+        mergeTile(rowTiles[tileX], mask, triangle.maxDepth);
+      }
+    }
+  }
+}
+
+void SoftwareOcclusionCuller::mergeTile(Tile &tile, const TileMask &mask,
+                                        float depth) const {
+  if (depth >= tile.zMax0) {
+    return;
+  }
+  // A triangle far in front of the working layer starts a new one instead of
+  // dragging the nearer surface back to the working layer's depth.
+  if (!isMaskEmpty(tile.mask) &&
+      tile.zMax1 - depth > tile.zMax0 - tile.zMax1) {
+    tile.mask.fill(0u);
+  }
+  tile.zMax1 = isMaskEmpty(tile.mask) ? depth : std::max(tile.zMax1, depth);
+  for (uint32_t row = 0; row < kTileHeight; ++row) {
+    tile.mask[row] |= mask[row];
+  }
+  if (isMaskFull(tile.mask)) {
+    tile.zMax0 = std::min(tile.zMax0, tile.zMax1);
+    tile.mask.fill(0u);
+    tile.zMax1 = 0.0f;
+  }
+}
+
+bool SoftwareOcclusionCuller::isOccluded(const BoundingBox &worldBounds) const {
+  const glm::vec3 &lo = worldBounds.min_;
+  const glm::vec3 &hi = worldBounds.max_;
+  if (lo.x > hi.x || lo.y > hi.y || lo.z > hi.z) {
+    return false;
+  }
+
+  float minX = std::numeric_limits<float>::max();
+  float minY = std::numeric_limits<float>::max();
+  float maxX = std::numeric_limits<float>::lowest();
+  float maxY = std::numeric_limits<float>::lowest();
+  float minDepth = std::numeric_limits<float>::max();
+  for (uint32_t corner = 0; corner < 8u; ++corner) {
+    const glm::vec4 point((corner & 1u) != 0u ? hi.x : lo.x,
+                          (corner & 2u) != 0u ? hi.y : lo.y,
+                          (corner & 4u) != 0u ? hi.z : lo.z, 1.0f);
+    const glm::vec4 clip = viewProj_ * point;
+    if (clip.w <= kMinClipW) {
+      return false;
+    }
+    const float invW = 1.0f / clip.w;
+    const float x = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+    const float y =
+        (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height_);
+    minX = std::min(minX, x);
+    maxX = std::max(maxX, x);
+    minY = std::min(minY, y);
+    maxY = std::max(maxY, y);
+    minDepth = std::min(minDepth, clip.w);
+  }
+  if (maxX <= 0.0f || maxY <= 0.0f || minX >= static_cast<float>(width_) ||
+      minY >= static_cast<float>(height_)) {
+    return false;
+  }
+
+  // Every pixel the rectangle touches must be hidden.
+  const int32_t firstX = std::max(0, static_cast<int32_t>(std::floor(minX)));
+  const int32_t firstY = std::max(0, static_cast<int32_t>(std::floor(minY)));
+  const int32_t lastX =
+      std::max(firstX, std::min(static_cast<int32_t>(width_) - 1,
+                                static_cast<int32_t>(std::ceil(maxX)) - 1));
+  const int32_t lastY =
+      std::max(firstY, std::min(static_cast<int32_t>(height_) - 1,
+                                static_cast<int32_t>(std::ceil(maxY)) - 1));
+
+  for (uint32_t tileY = static_cast<uint32_t>(firstY) / kTileHeight;
+       tileY <= static_cast<uint32_t>(lastY) / kTileHeight; ++tileY) {
+    const int32_t tileTop = static_cast<int32_t>(tileY * kTileHeight);
+    const uint32_t rowBegin =
+        static_cast<uint32_t>(std::max(firstY, tileTop) - tileTop);
+    const uint32_t rowEnd = static_cast<uint32_t>(
+        std::min(lastY, tileTop + static_cast<int32_t>(kTileHeight) - 1) -
+        tileTop);
+    for (uint32_t tileX = static_cast<uint32_t>(firstX) / kTileWidth;
+         tileX <= static_cast<uint32_t>(lastX) / kTileWidth; ++tileX) {
+      const Tile &tile = tiles_[static_cast<size_t>(tileY) * tilesX_ + tileX];
+      if (minDepth > tile.zMax0) {
+        continue;
+      }
+      if (minDepth <= tile.zMax1) {
+        return false;
+      }
+      const int32_t tileLeft = static_cast<int32_t>(tileX * kTileWidth);
+      const uint32_t rectMask = spanMask(
+          static_cast<uint32_t>(std::max(firstX, tileLeft) - tileLeft),
+          static_cast<uint32_t>(
+              std::min(lastX, tileLeft + static_cast<int32_t>(kTileWidth) - 1) -
+              tileLeft));
+      for (uint32_t row = rowBegin; row <= rowEnd; ++row) {
+        if ((rectMask & ~tile.mask[row]) != 0u) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void SoftwareOcclusionCuller::testOcclusion(
+    std::span<const BoundingBox> worldBounds, std::span<uint8_t> outOccluded) {
+  NURI_PROFILER_FUNCTION();
+  const size_t count = std::min(worldBounds.size(), outOccluded.size());
+  occludedBounds_.store(0u, std::memory_order_relaxed);
+  const size_t jobCount = (count + kBoundsPerJob - 1u) / kBoundsPerJob;
+  parallelFor(jobCount, [&](size_t job) {
+    const size_t begin = job * kBoundsPerJob;
+    const size_t end = std::min(count, begin + kBoundsPerJob);
+    uint32_t occluded = 0;
+    for (size_t i = begin; i < end; ++i) {
+      outOccluded[i] = isOccluded(worldBounds[i]) ? 1u : 0u;
+      occluded += outOccluded[i];
+    }
+    occludedBounds_.fetch_add(occluded, std::memory_order_relaxed);
+  });
+  stats_.testedBounds += static_cast<uint32_t>(count);
+  stats_.occludedBounds += occludedBounds_.load(std::memory_order_relaxed);
+}
+
+void SoftwareOcclusionCuller::parallelFor(
+    size_t count, const std::function<void(size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+  if (workers_.empty() || count == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  {
+    std::scoped_lock lock(jobMutex_);
+    job_ = &fn;
+    jobCount_ = count;
+    nextJobIndex_.store(0u, std::memory_order_relaxed);
+    activeWorkers_ = static_cast<uint32_t>(workers_.size());
+    ++jobGeneration_;
+  }
+  jobCv_.notify_all();
+
+  for (size_t i = nextJobIndex_.fetch_add(1u); i < count;
+       i = nextJobIndex_.fetch_add(1u)) {
+    fn(i);
+  }
+
+  std::unique_lock lock(jobMutex_);
+  jobDoneCv_.wait(lock, [this] { return activeWorkers_ == 0u; });
+  job_ = nullptr;
+}
+
+void SoftwareOcclusionCuller::workerLoop(std::stop_token stopToken) {
+  NURI_PROFILER_THREAD("OcclusionWorker");
+  uint64_t observedGeneration = 0;
+  while (true) {
+    const std::function<void(size_t)> *job = nullptr;
+    size_t count = 0;
+    {
+      std::unique_lock lock(jobMutex_);
+      jobCv_.wait(lock, [&] {
+        return stopToken.stop_requested() ||
+               jobGeneration_ != observedGeneration;
+      });
+      if (stopToken.stop_requested()) {
+        return;
+      }
+      observedGeneration = jobGeneration_;
+      job = job_;
+      count = jobCount_;
+    }
+
+    for (size_t i = nextJobIndex_.fetch_add(1u); i < count;
+         i = nextJobIndex_.fetch_add(1u)) {
+      (*job)(i);
+    }
+
+    {
+      std::scoped_lock lock(jobMutex_);
+      --activeWorkers_;
+    }
+    jobDoneCv_.notify_one();
+  }
+}
+
+} // namespace nuri
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "nuri/defines.h"
+#include "nuri/math/types.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace nuri {
+
+struct NURI_API SoftwareOcclusionConfig {
+  // Rounded up to whole 32x8 pixel tiles.
+  uint32_t width = 320;
+  uint32_t height = 192;
+  // Threads sharing the work, including the caller. 0 picks a count from the
+  // hardware.
+  uint32_t threadCount = 0;
+};
+
+struct NURI_API SoftwareOcclusionStats {
+  uint32_t occluders = 0;
+  uint32_t occluderTriangles = 0;
+  uint32_t rasterizedTriangles = 0;
+  uint32_t testedBounds = 0;
+  uint32_t occludedBounds = 0;
+};
+
+// Masked software occlusion culling. Occluder triangles are rasterized into a
+// low resolution buffer of 32x8 pixel tiles that keep one coverage bit per
+// pixel and two conservative depth layers, so a whole tile row is covered with
+// a handful of integer operations. Depth is clip-space w, which keeps the test
+// independent of the projection's depth range. Occlusion is conservative:
+// bounds touching the near plane or not fully hidden are reported visible.
+class NURI_API SoftwareOcclusionCuller {
+public:
+  explicit SoftwareOcclusionCuller(
+      const SoftwareOcclusionConfig &config = {},
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+  ~SoftwareOcclusionCuller();
+
+  SoftwareOcclusionCuller(const SoftwareOcclusionCuller &) = delete;
+  SoftwareOcclusionCuller &operator=(const SoftwareOcclusionCuller &) = delete;
+  SoftwareOcclusionCuller(SoftwareOcclusionCuller &&) = delete;
+  SoftwareOcclusionCuller &operator=(SoftwareOcclusionCuller &&) = delete;
+
+  // Clears the buffer and the occluder list.
+  void beginFrame(const glm::mat4 &viewProj);
+  // The spans must stay alive until rasterize() returns.
+  void addOccluder(std::span<const glm::vec3> positions,
+                   std::span<const uint32_t> indices,
+                   const glm::mat4 &modelMatrix);
+  void rasterize();
+
+  [[nodiscard]] bool isOccluded(const BoundingBox &worldBounds) const;
+  // outOccluded[i] is set to 1 when worldBounds[i] is hidden, 0 otherwise.
+  void testOcclusion(std::span<const BoundingBox> worldBounds,
+                     std::span<uint8_t> outOccluded);
+
+  [[nodiscard]] const SoftwareOcclusionStats &stats() const noexcept {
+    return stats_;
+  }
+  [[nodiscard]] uint32_t width() const noexcept { return width_; }
+  [[nodiscard]] uint32_t height() const noexcept { return height_; }
+
+  static constexpr uint32_t kTileWidth = 32;
+  static constexpr uint32_t kTileHeight = 8;
+
+private:
+  struct Tile {
+    std::array<uint32_t, kTileHeight> mask{};
+    float zMax0 = 0.0f;
+    float zMax1 = 0.0f;
+  };
+
+  struct Occluder {
+    std::span<const glm::vec3> positions;
+    std::span<const uint32_t> indices;
+    glm::mat4 modelMatrix{1.0f};
+    size_t firstTriangle = 0;
+  };
+
+  struct ScreenTriangle {
+    std::array<glm::vec2, 3> vertices{};
+    float maxDepth = 0.0f;
+    float minY = 0.0f;
+    float maxY = 0.0f;
+    float minX = 0.0f;
+    float maxX = 0.0f;
+    bool valid = false;
+  };
+
+  void setupTriangles(size_t occluderIndex);
+  void rasterizeTileRow(uint32_t tileRow);
+  void mergeTile(Tile &tile, const std::array<uint32_t, kTileHeight> &mask,
+                 float depth) const;
+  void parallelFor(size_t count, const std::function<void(size_t)> &fn);
+  void workerLoop(std::stop_token stopToken);
+
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint32_t tilesX_ = 0;
+  uint32_t tilesY_ = 0;
+  glm::mat4 viewProj_{1.0f};
+  std::pmr::vector<Tile> tiles_;
+  std::pmr::vector<Occluder> occluders_;
+  std::pmr::vector<ScreenTriangle> triangles_;
+  SoftwareOcclusionStats stats_{};
+  std::atomic<uint32_t> rasterizedTriangles_{0};
+  std::atomic<uint32_t> occludedBounds_{0};
+
+  std::mutex jobMutex_;
+  std::condition_variable jobCv_;
+  std::condition_variable jobDoneCv_;
+  const std::function<void(size_t)> *job_ = nullptr;
+  size_t jobCount_ = 0;
+  std::atomic<size_t> nextJobIndex_{0};
+  uint64_t jobGeneration_ = 0;
+  uint32_t activeWorkers_ = 0;
+  std::vector<std::jthread> workers_;
+};
+
+} // namespace nuri
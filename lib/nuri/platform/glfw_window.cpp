@@ -341,6 +341,14 @@ std::unique_ptr<Window> Window::create(std::string_view title, int32_t width,
 
 void GlfwWindow::pollEvents() { glfwPollEvents(); }
 
+void GlfwWindow::waitEvents(double timeoutSeconds) {
+  if (timeoutSeconds > 0.0) {
+    glfwWaitEventsTimeout(timeoutSeconds);
+  } else {
+    glfwPollEvents();
+  }
+}
+
 bool GlfwWindow::shouldClose() const {
   return impl_->window && glfwWindowShouldClose(impl_->window);
 }
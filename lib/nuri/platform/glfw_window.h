@@ -17,6 +17,7 @@ public:
   GlfwWindow &operator=(GlfwWindow &&) = delete;
 
   void pollEvents() override;
+  void waitEvents(double timeoutSeconds) override;
   bool shouldClose() const override;
   void getWindowSize(int32_t &outWidth, int32_t &outHeight) const override;
   void getFramebufferSize(int32_t &outWidth, int32_t &outHeight) const override;
@@ -3,10 +3,14 @@
 #include "nuri/platform/lvk_gpu_device.h"
 
 #include "nuri/core/log.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/profiling.h"
 #include "nuri/core/window.h"
+#include "nuri/gfx/draw_stream.h"
 #include "nuri/resources/gpu/geometry_pool.h"
 
+#include <unordered_map>
+
 #include <lvk/LVK.h>
 #if __has_include(<lvk/vulkan/VulkanClasses.h>)
 #include <lvk/vulkan/VulkanClasses.h>
@@ -318,33 +322,7 @@ template <typename HandleType>
   return a.index == b.index && a.generation == b.generation;
 }
 
-[[nodiscard]] Result<uint32_t, std::string>
-allocateMonotonicHandleIndex(uint32_t &nextIndex, std::string_view context) {
-  if (nextIndex == std::numeric_limits<uint32_t>::max()) {
-    std::string message;
-    message.reserve(context.size() + 24u);
-    message.append(context);
-    message.append(": handle index overflow");
-    return Result<uint32_t, std::string>::makeError(std::move(message));
-  }
-
-  return Result<uint32_t, std::string>::makeResult(nextIndex++);
-}
-
-[[nodiscard]] uint32_t nextHandleGeneration(std::vector<uint32_t> &generations,
-                                            uint32_t index) {
-  if (index >= generations.size()) {
-    generations.resize(static_cast<size_t>(index) + 1u, 0u);
-  }
-
-  uint32_t &generation = generations[index];
-  ++generation;
-  if (generation == 0u) {
-    ++generation;
-  }
-  return generation;
-}
-
+#if !NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
 [[nodiscard]] Result<bool, std::string>
 makeLvkBarrierApiError(std::string_view context) {
   std::string message;
@@ -357,6 +335,7 @@ makeLvkBarrierApiError(std::string_view context) {
                  "shader-read texture transitions");
   return Result<bool, std::string>::makeError(std::move(message));
 }
+#endif
 
 [[nodiscard]] SubmissionHandle
 toNuriSubmissionHandle(lvk::SubmitHandle handle) {
@@ -401,6 +380,35 @@ toNuriSubmissionHandle(lvk::SubmitHandle handle) {
 
 constexpr bool kEnablePerDrawDebugLabels = false;
 
+const PerfCounterId kUploadBytesCounter =
+    PerfCounters::registerCounter("gpu.upload_bytes");
+const PerfCounterId kDrawCallsCounter =
+    PerfCounters::registerCounter("gpu.draw_calls");
+const PerfCounterId kIndirectDrawCallsCounter =
+    PerfCounters::registerCounter("gpu.indirect_draw_calls");
+const PerfCounterId kDirectTrianglesCounter =
+    PerfCounters::registerCounter("gpu.direct_triangles");
+
+// Per-pass draw totals, published once per recorded pass instead of once
+// per draw. Triangles assume triangle lists and only cover direct draws;
+// indirect counts live on the GPU.
+struct DrawCommandTally {
+  uint64_t drawCalls = 0;
+  uint64_t indirectDrawCalls = 0;
+  uint64_t directTriangles = 0;
+
+  void addDirect(uint32_t elementCount, uint32_t instanceCount) noexcept {
+    ++drawCalls;
+    directTriangles += static_cast<uint64_t>(elementCount / 3u) * instanceCount;
+  }
+
+  void publish() const noexcept {
+    PerfCounters::add(kDrawCallsCounter, drawCalls);
+    PerfCounters::add(kIndirectDrawCallsCounter, indirectDrawCalls);
+    PerfCounters::add(kDirectTrianglesCounter, directTriangles);
+  }
+};
+
 [[nodiscard]] Result<bool, std::string>
 makeDependencyError(std::string_view context, std::string_view detail) {
   std::string message;
@@ -444,10 +452,480 @@ graphicsBarrierStages(GraphicsBarrierState state, bool isDepthTexture) {
            VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
-           VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+           VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT |
+           VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  }
+}
+
+#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
+[[nodiscard]] VkPipelineStageFlags2
+toVkPipelineStages(GraphicsBarrierStage stages) {
+  constexpr std::array<std::pair<GraphicsBarrierStage, VkPipelineStageFlags2>,
+                       9>
+      kStageBits = {{
+          {GraphicsBarrierStage::DrawIndirect,
+           VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT},
+          {GraphicsBarrierStage::IndexInput,
+           VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT},
+          {GraphicsBarrierStage::VertexInput,
+           VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT},
+          {GraphicsBarrierStage::VertexShader,
+           VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT},
+          {GraphicsBarrierStage::FragmentShader,
+           VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT},
+          {GraphicsBarrierStage::ComputeShader,
+           VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT},
+          {GraphicsBarrierStage::Transfer, VK_PIPELINE_STAGE_2_TRANSFER_BIT},
+          {GraphicsBarrierStage::ColorAttachment,
+           VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT},
+          {GraphicsBarrierStage::DepthAttachment,
+           VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+               VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT},
+      }};
+  VkPipelineStageFlags2 flags = VK_PIPELINE_STAGE_2_NONE;
+  for (const auto &[stage, bits] : kStageBits) {
+    if (hasGraphicsBarrierStageFlag(stages, stage)) {
+      flags |= bits;
+    }
+  }
+  return flags;
+}
+
+// Narrowest access mask that is valid for `stages` and covers `mode`.
+[[nodiscard]] VkAccessFlags2 barrierAccessMask(VkPipelineStageFlags2 stages,
+                                               GraphicsBarrierAccessMode mode) {
+  constexpr VkPipelineStageFlags2 kShaderStages =
+      VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  constexpr VkPipelineStageFlags2 kDepthStages =
+      VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+      VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+  VkAccessFlags2 access = VK_ACCESS_2_NONE;
+  if (hasGraphicsBarrierAccessFlag(mode, GraphicsBarrierAccessMode::Read)) {
+    if ((stages & VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT) != 0u) {
+      access |= VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+    }
+    if ((stages & (VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+                   VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT)) != 0u) {
+      access |= VK_ACCESS_2_INDEX_READ_BIT;
+    }
+    if ((stages & (VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT |
+                   VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT)) != 0u) {
+      access |= VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+    }
+    if ((stages & kShaderStages) != 0u) {
+      access |= VK_ACCESS_2_SHADER_SAMPLED_READ_BIT |
+                VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    }
+    if ((stages & VK_PIPELINE_STAGE_2_TRANSFER_BIT) != 0u) {
+      access |= VK_ACCESS_2_TRANSFER_READ_BIT;
+    }
+    if ((stages & VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT) != 0u) {
+      access |= VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
+    }
+    if ((stages & kDepthStages) != 0u) {
+      access |= VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    }
+  }
+  if (hasGraphicsBarrierAccessFlag(mode, GraphicsBarrierAccessMode::Write)) {
+    if ((stages & kShaderStages) != 0u) {
+      access |= VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    }
+    if ((stages & VK_PIPELINE_STAGE_2_TRANSFER_BIT) != 0u) {
+      access |= VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    }
+    if ((stages & VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT) != 0u) {
+      access |= VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    }
+    if ((stages & kDepthStages) != 0u) {
+      access |= VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    }
+  }
+  return access;
+}
+
+[[nodiscard]] VkImageLayout barrierImageLayout(GraphicsBarrierState state,
+                                               VkImageLayout current) {
+  switch (state) {
+  case GraphicsBarrierState::Read:
+    return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  case GraphicsBarrierState::Write:
+    return VK_IMAGE_LAYOUT_GENERAL;
+  case GraphicsBarrierState::Attachment:
+    return VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL;
+  case GraphicsBarrierState::Present:
+    return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+  case GraphicsBarrierState::Unknown:
+  default:
+    return current;
+  }
+}
+
+[[nodiscard]] VkPrimitiveTopology toVkTopology(lvk::Topology topology) {
+  switch (topology) {
+  case lvk::Topology_Point:
+    return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+  case lvk::Topology_Line:
+    return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+  case lvk::Topology_LineStrip:
+    return VK_PRIMITIVE_TOPOLOGY_LINE_STRIP;
+  case lvk::Topology_TriangleStrip:
+    return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+  case lvk::Topology_Patch:
+    return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+  case lvk::Topology_Triangle:
+  default:
+    return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+  }
+}
+
+[[nodiscard]] VkCullModeFlags toVkCullMode(lvk::CullMode mode) {
+  switch (mode) {
+  case lvk::CullMode_Front:
+    return VK_CULL_MODE_FRONT_BIT;
+  case lvk::CullMode_Back:
+    return VK_CULL_MODE_BACK_BIT;
+  case lvk::CullMode_None:
+  default:
+    return VK_CULL_MODE_NONE;
   }
 }
 
+[[nodiscard]] VkBlendOp toVkBlendOp(lvk::BlendOp op) {
+  switch (op) {
+  case lvk::BlendOp_Subtract:
+    return VK_BLEND_OP_SUBTRACT;
+  case lvk::BlendOp_ReverseSubtract:
+    return VK_BLEND_OP_REVERSE_SUBTRACT;
+  case lvk::BlendOp_Min:
+    return VK_BLEND_OP_MIN;
+  case lvk::BlendOp_Max:
+    return VK_BLEND_OP_MAX;
+  case lvk::BlendOp_Add:
+  default:
+    return VK_BLEND_OP_ADD;
+  }
+}
+
+[[nodiscard]] VkBlendFactor toVkBlendFactor(lvk::BlendFactor factor) {
+  switch (factor) {
+  case lvk::BlendFactor_Zero:
+    return VK_BLEND_FACTOR_ZERO;
+  case lvk::BlendFactor_SrcColor:
+    return VK_BLEND_FACTOR_SRC_COLOR;
+  case lvk::BlendFactor_OneMinusSrcColor:
+    return VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+  case lvk::BlendFactor_SrcAlpha:
+    return VK_BLEND_FACTOR_SRC_ALPHA;
+  case lvk::BlendFactor_OneMinusSrcAlpha:
+    return VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+  case lvk::BlendFactor_DstColor:
+    return VK_BLEND_FACTOR_DST_COLOR;
+  case lvk::BlendFactor_OneMinusDstColor:
+    return VK_BLEND_FACTOR_ONE_MINUS_DST_COLOR;
+  case lvk::BlendFactor_DstAlpha:
+    return VK_BLEND_FACTOR_DST_ALPHA;
+  case lvk::BlendFactor_OneMinusDstAlpha:
+    return VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
+  case lvk::BlendFactor_SrcAlphaSaturated:
+    return VK_BLEND_FACTOR_SRC_ALPHA_SATURATE;
+  case lvk::BlendFactor_BlendColor:
+    return VK_BLEND_FACTOR_CONSTANT_COLOR;
+  case lvk::BlendFactor_OneMinusBlendColor:
+    return VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_COLOR;
+  case lvk::BlendFactor_BlendAlpha:
+    return VK_BLEND_FACTOR_CONSTANT_ALPHA;
+  case lvk::BlendFactor_OneMinusBlendAlpha:
+    return VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_ALPHA;
+  case lvk::BlendFactor_Src1Color:
+    return VK_BLEND_FACTOR_SRC1_COLOR;
+  case lvk::BlendFactor_OneMinusSrc1Color:
+    return VK_BLEND_FACTOR_ONE_MINUS_SRC1_COLOR;
+  case lvk::BlendFactor_Src1Alpha:
+    return VK_BLEND_FACTOR_SRC1_ALPHA;
+  case lvk::BlendFactor_OneMinusSrc1Alpha:
+    return VK_BLEND_FACTOR_ONE_MINUS_SRC1_ALPHA;
+  case lvk::BlendFactor_One:
+  default:
+    return VK_BLEND_FACTOR_ONE;
+  }
+}
+
+// Background build of one render pipeline. Everything the driver reads is
+// copied out of the LVK pools on the render thread, and the pipeline is
+// built into a private VkPipelineCache, so compile() never touches LVK state.
+// The render thread merges that cache into LVK's, which turns LVK's own lazy
+// build at first bind into a cache hit. Shader modules stay alive through
+// `onDestroy`, which the device runs when the job is destroyed.
+class LvkPipelineCompileJob final : public PipelineCompileJob {
+public:
+  LvkPipelineCompileJob(VkDevice device, std::function<void()> onDestroy)
+      : device_(device), onDestroy_(std::move(onDestroy)) {}
+
+  ~LvkPipelineCompileJob() override {
+    if (layout_ != VK_NULL_HANDLE) {
+      vkDestroyPipelineLayout(device_, layout_, nullptr);
+    }
+    if (cache_ != VK_NULL_HANDLE) {
+      vkDestroyPipelineCache(device_, cache_, nullptr);
+    }
+    if (onDestroy_) {
+      onDestroy_();
+    }
+  }
+
+  LvkPipelineCompileJob(const LvkPipelineCompileJob &) = delete;
+  LvkPipelineCompileJob &operator=(const LvkPipelineCompileJob &) = delete;
+
+  [[nodiscard]] bool capture(lvk::VulkanContext &context,
+                             const lvk::RenderPipelineState &state) {
+    const lvk::RenderPipelineDesc &desc = state.desc_;
+    const VkPipelineCacheCreateInfo cacheInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    if (vkCreatePipelineCache(device_, &cacheInfo, nullptr, &cache_) !=
+        VK_SUCCESS) {
+      return false;
+    }
+
+    uint32_t pushConstantsSize = 0u;
+    const auto addStage = [&](lvk::ShaderModuleHandle handle,
+                              VkShaderStageFlagBits stage) {
+      const lvk::ShaderModuleState *module =
+          context.shaderModulesPool_.get(handle);
+      if (module == nullptr || module->sm == VK_NULL_HANDLE) {
+        return;
+      }
+      pushConstantsSize =
+          std::max(pushConstantsSize, module->pushConstantsSize);
+      stages_[numStages_++] = VkPipelineShaderStageCreateInfo{
+          .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+          .stage = stage,
+          .module = module->sm,
+          .pName = "main",
+          .pSpecializationInfo = &specInfo_,
+      };
+    };
+    addStage(desc.smVert, VK_SHADER_STAGE_VERTEX_BIT);
+    addStage(desc.smTesc, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT);
+    addStage(desc.smTese, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT);
+    addStage(desc.smGeom, VK_SHADER_STAGE_GEOMETRY_BIT);
+    addStage(desc.smFrag, VK_SHADER_STAGE_FRAGMENT_BIT);
+    if (numStages_ == 0u) {
+      return false;
+    }
+
+    // Same layout LVK builds in getVkPipeline(): the bindless set in all four
+    // slots plus one push constant range over every stage.
+    const VkDescriptorSetLayout setLayouts[] = {
+        context.vkDSL_, context.vkDSL_, context.vkDSL_, context.vkDSL_};
+    const VkPushConstantRange pushConstants{
+        .stageFlags = state.shaderStageFlags_,
+        .offset = 0u,
+        .size = pushConstantsSize,
+    };
+    const VkPipelineLayoutCreateInfo layoutInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = static_cast<uint32_t>(std::size(setLayouts)),
+        .pSetLayouts = setLayouts,
+        .pushConstantRangeCount = pushConstantsSize > 0u ? 1u : 0u,
+        .pPushConstantRanges = &pushConstants,
+    };
+    if (vkCreatePipelineLayout(device_, &layoutInfo, nullptr, &layout_) !=
+        VK_SUCCESS) {
+      return false;
+    }
+
+    numBindings_ = state.numBindings_;
+    numAttributes_ = state.numAttributes_;
+    std::copy_n(state.vkBindings_, numBindings_, bindings_.begin());
+    std::copy_n(state.vkAttributes_, numAttributes_, attributes_.begin());
+
+    const uint32_t numSpecConstants =
+        desc.specInfo.getNumSpecializationConstants();
+    for (uint32_t i = 0; i < numSpecConstants; ++i) {
+      specEntries_[i] = VkSpecializationMapEntry{
+          .constantID = desc.specInfo.entries[i].constantId,
+          .offset = desc.specInfo.entries[i].offset,
+          .size = desc.specInfo.entries[i].size,
+      };
+    }
+    const auto *specData =
+        static_cast<const std::byte *>(desc.specInfo.data);
+    if (specData != nullptr) {
+      specData_.assign(specData, specData + desc.specInfo.dataSize);
+    }
+    specInfo_ = VkSpecializationInfo{
+        .mapEntryCount = numSpecConstants,
+        .pMapEntries = specEntries_.data(),
+        .dataSize = specData_.size(),
+        .pData = specData_.empty() ? nullptr : specData_.data(),
+    };
+
+    numColors_ = desc.getNumColorAttachments();
+    for (uint32_t i = 0; i < numColors_; ++i) {
+      const lvk::ColorAttachment &color = desc.color[i];
+      colorFormats_[i] = lvk::formatToVkFormat(color.format);
+      blendStates_[i] = VkPipelineColorBlendAttachmentState{
+          .blendEnable = color.blendEnabled ? VK_TRUE : VK_FALSE,
+          .srcColorBlendFactor = toVkBlendFactor(color.srcRGBBlendFactor),
+          .dstColorBlendFactor = toVkBlendFactor(color.dstRGBBlendFactor),
+          .colorBlendOp = toVkBlendOp(color.rgbBlendOp),
+          .srcAlphaBlendFactor = toVkBlendFactor(color.srcAlphaBlendFactor),
+          .dstAlphaBlendFactor = toVkBlendFactor(color.dstAlphaBlendFactor),
+          .alphaBlendOp = toVkBlendOp(color.alphaBlendOp),
+          .colorWriteMask =
+              VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+              VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+      };
+    }
+    depthFormat_ = lvk::formatToVkFormat(desc.depthFormat);
+    topology_ = toVkTopology(desc.topology);
+    polygonMode_ = desc.polygonMode == lvk::PolygonMode_Line
+                       ? VK_POLYGON_MODE_LINE
+                       : VK_POLYGON_MODE_FILL;
+    cullMode_ = toVkCullMode(desc.cullMode);
+    frontFace_ = desc.frontFaceWinding == lvk::WindingMode_CW
+                     ? VK_FRONT_FACE_CLOCKWISE
+                     : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    samples_ = desc.samplesCount > 1u
+                   ? static_cast<VkSampleCountFlagBits>(desc.samplesCount)
+                   : VK_SAMPLE_COUNT_1_BIT;
+    patchControlPoints_ = desc.patchControlPoints;
+    return true;
+  }
+
+  Result<bool, std::string> compile() override {
+    NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+    const VkPipelineVertexInputStateCreateInfo vertexInput{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = numBindings_,
+        .pVertexBindingDescriptions = bindings_.data(),
+        .vertexAttributeDescriptionCount = numAttributes_,
+        .pVertexAttributeDescriptions = attributes_.data(),
+    };
+    const VkPipelineInputAssemblyStateCreateInfo inputAssembly{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+        .topology = topology_,
+    };
+    const VkPipelineTessellationStateCreateInfo tessellation{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO,
+        .patchControlPoints = patchControlPoints_,
+    };
+    const VkPipelineViewportStateCreateInfo viewport{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+        .viewportCount = 1u,
+        .scissorCount = 1u,
+    };
+    const VkPipelineRasterizationStateCreateInfo rasterization{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+        .polygonMode = polygonMode_,
+        .cullMode = cullMode_,
+        .frontFace = frontFace_,
+        .lineWidth = 1.0f,
+    };
+    const VkPipelineMultisampleStateCreateInfo multisample{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+        .rasterizationSamples = samples_,
+    };
+    const VkPipelineDepthStencilStateCreateInfo depthStencil{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+    };
+    const VkPipelineColorBlendStateCreateInfo colorBlend{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+        .attachmentCount = numColors_,
+        .pAttachments = blendStates_.data(),
+    };
+    // Mirrors the dynamic state LVK enables so the cache key matches.
+    const VkDynamicState dynamicStates[] = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR,
+        VK_DYNAMIC_STATE_DEPTH_BIAS,
+        VK_DYNAMIC_STATE_BLEND_CONSTANTS,
+        VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE,
+        VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE,
+        VK_DYNAMIC_STATE_DEPTH_COMPARE_OP,
+        VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE,
+    };
+    const VkPipelineDynamicStateCreateInfo dynamic{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .dynamicStateCount = static_cast<uint32_t>(std::size(dynamicStates)),
+        .pDynamicStates = dynamicStates,
+    };
+    const VkPipelineRenderingCreateInfo rendering{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+        .colorAttachmentCount = numColors_,
+        .pColorAttachmentFormats = colorFormats_.data(),
+        .depthAttachmentFormat = depthFormat_,
+    };
+    const VkGraphicsPipelineCreateInfo pipelineInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &rendering,
+        .stageCount = numStages_,
+        .pStages = stages_.data(),
+        .pVertexInputState = &vertexInput,
+        .pInputAssemblyState = &inputAssembly,
+        .pTessellationState =
+            patchControlPoints_ > 0u ? &tessellation : nullptr,
+        .pViewportState = &viewport,
+        .pRasterizationState = &rasterization,
+        .pMultisampleState = &multisample,
+        .pDepthStencilState = &depthStencil,
+        .pColorBlendState = &colorBlend,
+        .pDynamicState = &dynamic,
+        .layout = layout_,
+    };
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    const VkResult result = vkCreateGraphicsPipelines(
+        device_, cache_, 1u, &pipelineInfo, nullptr, &pipeline);
+    if (result != VK_SUCCESS) {
+      return Result<bool, std::string>::makeError(
+          "LvkPipelineCompileJob::compile: vkCreateGraphicsPipelines failed (" +
+          std::to_string(static_cast<int>(result)) + ")");
+    }
+    // Only the cache entry is kept; LVK builds its own pipeline from it.
+    vkDestroyPipeline(device_, pipeline, nullptr);
+    return Result<bool, std::string>::makeResult(true);
+  }
+
+  [[nodiscard]] VkPipelineCache cache() const { return cache_; }
+
+private:
+  VkDevice device_ = VK_NULL_HANDLE;
+  std::function<void()> onDestroy_;
+  VkPipelineCache cache_ = VK_NULL_HANDLE;
+  VkPipelineLayout layout_ = VK_NULL_HANDLE;
+  std::array<VkPipelineShaderStageCreateInfo, 5> stages_{};
+  uint32_t numStages_ = 0u;
+  std::array<VkVertexInputBindingDescription,
+             lvk::VertexInput::LVK_VERTEX_BUFFER_MAX>
+      bindings_{};
+  std::array<VkVertexInputAttributeDescription,
+             lvk::VertexInput::LVK_VERTEX_ATTRIBUTES_MAX>
+      attributes_{};
+  uint32_t numBindings_ = 0u;
+  uint32_t numAttributes_ = 0u;
+  std::array<VkSpecializationMapEntry,
+             lvk::SpecializationConstantDesc::LVK_SPECIALIZATION_CONSTANTS_MAX>
+      specEntries_{};
+  std::vector<std::byte> specData_;
+  VkSpecializationInfo specInfo_{};
+  std::array<VkFormat, LVK_MAX_COLOR_ATTACHMENTS> colorFormats_{};
+  std::array<VkPipelineColorBlendAttachmentState, LVK_MAX_COLOR_ATTACHMENTS>
+      blendStates_{};
+  uint32_t numColors_ = 0u;
+  VkFormat depthFormat_ = VK_FORMAT_UNDEFINED;
+  VkPrimitiveTopology topology_ = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+  VkPolygonMode polygonMode_ = VK_POLYGON_MODE_FILL;
+  VkCullModeFlags cullMode_ = VK_CULL_MODE_NONE;
+  VkFrontFace frontFace_ = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+  VkSampleCountFlagBits samples_ = VK_SAMPLE_COUNT_1_BIT;
+  uint32_t patchControlPoints_ = 0u;
+};
+
+#endif
+
 } // namespace
 
 template <typename LvkHandle> struct ResourceSlot {
@@ -568,15 +1046,21 @@ struct FramebufferTexture {
   std::string debugName;
 };
 
-struct ActiveGraphicsRecordingContext {
-  RecordingContextHandle handle{};
+constexpr uint32_t kMaxGraphicsRecordingContexts = 8u;
+
+// Recording context handles index straight into this fixed table. A slot is
+// live while `liveGeneration` matches its handle, so per-pass lookups from
+// recording workers take no lock. Slots are claimed under
+// contextImmediateMutex and released by clearing the generation.
+struct GraphicsRecordingSlot {
+  std::atomic<uint32_t> liveGeneration{0u};
+  uint32_t lastGeneration = 0u;
   lvk::ICommandBuffer *commandBuffer = nullptr;
-  uint32_t workerIndex = 0u;
 };
 
 struct RecordedGraphicsCommandBuffer {
-  RecordedCommandBufferHandle handle{};
   lvk::ICommandBuffer *commandBuffer = nullptr;
+  uint32_t generation = 0u;
 };
 
 struct LvkGPUDevice::Impl {
@@ -593,16 +1077,65 @@ struct LvkGPUDevice::Impl {
   ResourceTable<ComputePipelineHandle, lvk::ComputePipelineHandle>
       computePipelines;
   std::vector<FramebufferTexture> framebufferTextures;
+  // Shader modules referenced by in-flight pipeline compile jobs. A module
+  // destroyed while referenced is released when its last job goes away.
+  std::unordered_map<uint32_t, uint32_t> compileShaderRefs;
+  std::unordered_map<uint32_t, std::array<ShaderHandle, 5>>
+      renderPipelineShaders;
+  std::vector<ShaderHandle> deferredShaderDestroys;
   mutable std::mutex contextImmediateMutex;
-  std::mutex graphicsContextMutex;
-  std::vector<ActiveGraphicsRecordingContext> activeGraphicsContexts;
+  std::array<GraphicsRecordingSlot, kMaxGraphicsRecordingContexts>
+      graphicsRecordingSlots;
+  std::mutex recordedCommandBufferMutex;
   std::vector<RecordedGraphicsCommandBuffer> recordedGraphicsCommandBuffers;
+  std::vector<uint32_t> freeRecordedGraphicsCommandBuffers;
   lvk::TextureHandle currentFrameSwapchainTexture{};
-  std::vector<uint32_t> recordingContextGenerations;
-  std::vector<uint32_t> recordedCommandBufferGenerations;
-  uint32_t nextRecordingContextIndex = 1u;
-  uint32_t nextRecordedCommandBufferIndex = 1u;
   std::unique_ptr<GeometryPool> geometryPool;
+
+  [[nodiscard]] GraphicsRecordingSlot *
+  findGraphicsRecordingSlot(RecordingContextHandle handle) {
+    if (!nuri::isValid(handle) ||
+        handle.index >= graphicsRecordingSlots.size()) {
+      return nullptr;
+    }
+    GraphicsRecordingSlot &slot = graphicsRecordingSlots[handle.index];
+    return slot.liveGeneration.load(std::memory_order_acquire) ==
+                   handle.generation
+               ? &slot
+               : nullptr;
+  }
+
+  // Clears the slot so a later acquire can reuse it and returns the command
+  // buffer the context was recording into.
+  [[nodiscard]] lvk::ICommandBuffer *
+  releaseGraphicsRecordingSlot(RecordingContextHandle handle) {
+    GraphicsRecordingSlot *slot = findGraphicsRecordingSlot(handle);
+    if (slot == nullptr) {
+      return nullptr;
+    }
+    lvk::ICommandBuffer *commandBuffer = slot->commandBuffer;
+    uint32_t expected = handle.generation;
+    if (!slot->liveGeneration.compare_exchange_strong(
+            expected, 0u, std::memory_order_acq_rel)) {
+      return nullptr;
+    }
+    return commandBuffer;
+  }
+
+  // Caller holds recordedCommandBufferMutex.
+  [[nodiscard]] RecordedGraphicsCommandBuffer *
+  findRecordedCommandBuffer(RecordedCommandBufferHandle handle) {
+    if (!nuri::isValid(handle) ||
+        handle.index >= recordedGraphicsCommandBuffers.size()) {
+      return nullptr;
+    }
+    RecordedGraphicsCommandBuffer &entry =
+        recordedGraphicsCommandBuffers[handle.index];
+    return entry.commandBuffer != nullptr &&
+                   entry.generation == handle.generation
+               ? &entry
+               : nullptr;
+  }
 };
 
 LvkGPUDevice::LvkGPUDevice() : impl_(std::make_unique<Impl>()) {}
@@ -884,6 +1417,7 @@ LvkGPUDevice::createBuffer(const BufferDesc &desc, std::string_view debugName) {
       .debugName = debugNameCStr,
   };
 
+  PerfCounters::add(kUploadBytesCounter, desc.data.size());
   lvk::Result res;
   lvk::Holder<lvk::BufferHandle> handle =
       impl_->context->createBuffer(bufferDesc, debugNameCStr, &res);
@@ -950,6 +1484,7 @@ LvkGPUDevice::createTexture(const TextureDesc &desc,
       .debugName = debugNameCStr,
   };
 
+  PerfCounters::add(kUploadBytesCounter, desc.data.size());
   lvk::Result res;
   lvk::Holder<lvk::TextureHandle> handle =
       impl_->context->createTexture(textureDesc, debugNameCStr, &res);
@@ -1248,6 +1783,13 @@ LvkGPUDevice::createRenderPipeline(const RenderPipelineDesc &desc,
       .patchControlPoints = desc.patchControlPoints,
       .debugName = reserved.debugNameCStr,
   };
+  for (size_t i = 0; i < desc.additionalColorFormats.size(); ++i) {
+    if (desc.additionalColorFormats[i] == Format::Count) {
+      continue;
+    }
+    pipelineDesc.color[i + 1u] = {
+        .format = toLvkFormat(desc.additionalColorFormats[i])};
+  }
 
   lvk::Result res;
   lvk::Holder<lvk::RenderPipelineHandle> handle =
@@ -1294,9 +1836,93 @@ LvkGPUDevice::createRenderPipeline(const RenderPipelineDesc &desc,
     return Result<RenderPipelineHandle, std::string>::makeError(
         "Failed to store render pipeline resource");
   }
+  impl_->renderPipelineShaders[reserved.handle.index] = {
+      desc.vertexShader, desc.tessControlShader, desc.tessEvalShader,
+      desc.geometryShader, desc.fragmentShader};
   return Result<RenderPipelineHandle, std::string>::makeResult(reserved.handle);
 }
 
+bool LvkGPUDevice::supportsBackgroundPipelineCompilation() const {
+  return NURI_LVK_HAS_VULKAN_COMMAND_BUFFER != 0;
+}
+
+Result<std::unique_ptr<PipelineCompileJob>, std::string>
+LvkGPUDevice::prepareRenderPipelineCompile(RenderPipelineHandle pipeline) {
+  using JobResult = Result<std::unique_ptr<PipelineCompileJob>, std::string>;
+#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
+  const lvk::RenderPipelineHandle lvkHandle =
+      impl_->renderPipelines.getLvkHandle(pipeline);
+  auto *vkContext = static_cast<lvk::VulkanContext *>(impl_->context.get());
+  const lvk::RenderPipelineState *state =
+      vkContext->renderPipelinesPool_.get(lvkHandle);
+  if (state == nullptr) {
+    return JobResult::makeError(
+        "LvkGPUDevice::prepareRenderPipelineCompile: invalid pipeline handle");
+  }
+
+  const std::array<ShaderHandle, 5> shaders =
+      impl_->renderPipelineShaders[pipeline.index];
+  for (const ShaderHandle shader : shaders) {
+    if (nuri::isValid(shader)) {
+      ++impl_->compileShaderRefs[shader.index];
+    }
+  }
+  auto job = std::make_unique<LvkPipelineCompileJob>(
+      vkContext->getVkDevice(), [this, shaders] {
+        for (const ShaderHandle shader : shaders) {
+          if (nuri::isValid(shader) &&
+              --impl_->compileShaderRefs[shader.index] == 0u) {
+            impl_->compileShaderRefs.erase(shader.index);
+          }
+        }
+        releaseDeferredShaderModules();
+      });
+  if (!job->capture(*vkContext, *state)) {
+    return JobResult::makeError("LvkGPUDevice::prepareRenderPipelineCompile: "
+                                "failed to capture pipeline state");
+  }
+  return JobResult::makeResult(std::move(job));
+#else
+  (void)pipeline;
+  return JobResult::makeError(
+      "LvkGPUDevice::prepareRenderPipelineCompile: not supported");
+#endif
+}
+
+Result<bool, std::string>
+LvkGPUDevice::finishRenderPipelineCompile(PipelineCompileJob &job) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
+  auto *vkContext = static_cast<lvk::VulkanContext *>(impl_->context.get());
+  const VkPipelineCache source =
+      static_cast<LvkPipelineCompileJob &>(job).cache();
+  if (vkContext->pipelineCache_ == VK_NULL_HANDLE) {
+    return Result<bool, std::string>::makeResult(true);
+  }
+  const VkResult result = vkMergePipelineCaches(
+      vkContext->getVkDevice(), vkContext->pipelineCache_, 1u, &source);
+  if (result != VK_SUCCESS) {
+    return Result<bool, std::string>::makeError(
+        "LvkGPUDevice::finishRenderPipelineCompile: vkMergePipelineCaches "
+        "failed (" +
+        std::to_string(static_cast<int>(result)) + ")");
+  }
+#else
+  (void)job;
+#endif
+  return Result<bool, std::string>::makeResult(true);
+}
+
+void LvkGPUDevice::releaseDeferredShaderModules() {
+  std::erase_if(impl_->deferredShaderDestroys, [this](ShaderHandle shader) {
+    if (impl_->compileShaderRefs.contains(shader.index)) {
+      return false;
+    }
+    impl_->shaders.deallocate(shader);
+    return true;
+  });
+}
+
 Result<ComputePipelineHandle, std::string>
 LvkGPUDevice::createComputePipeline(const ComputePipelineDesc &desc,
                                     std::string_view debugName) {
@@ -1397,6 +2023,9 @@ void LvkGPUDevice::destroyRenderPipeline(RenderPipelineHandle pipeline) {
   if (!impl_) {
     return;
   }
+  if (impl_->renderPipelines.isValid(pipeline)) {
+    impl_->renderPipelineShaders.erase(pipeline.index);
+  }
   impl_->renderPipelines.deallocate(pipeline);
 }
 
@@ -1432,6 +2061,10 @@ void LvkGPUDevice::destroyShaderModule(ShaderHandle shader) {
   if (!impl_) {
     return;
   }
+  if (impl_->compileShaderRefs.contains(shader.index)) {
+    impl_->deferredShaderDestroys.push_back(shader);
+    return;
+  }
   impl_->shaders.deallocate(shader);
 }
 
@@ -1506,123 +2139,522 @@ Result<GeometryAllocationHandle, std::string> LvkGPUDevice::allocateGeometry(
                                        indexCount, debugName);
 }
 
+bool LvkGPUDevice::supportsEncodedGeometry() const {
+  return impl_->geometryPool &&
+         impl_->geometryPool->supportsEncodedVertices();
+}
+
+Result<GeometryAllocationHandle, std::string>
+LvkGPUDevice::allocateEncodedGeometry(const EncodedVertexStream &vertices,
+                                      std::span<const std::byte> indexBytes,
+                                      uint32_t indexCount,
+                                      std::string_view debugName) {
+  if (!impl_->geometryPool) {
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "Geometry pool is not initialized");
+  }
+  return impl_->geometryPool->allocateEncoded(vertices, indexBytes,
+                                              indexCount, debugName);
+}
+
 void LvkGPUDevice::releaseGeometry(GeometryAllocationHandle h) {
   if (impl_->geometryPool) {
     impl_->geometryPool->release(h);
   }
 }
 
-Result<bool, std::string>
-LvkGPUDevice::recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
-                                 std::span<const RenderPass> passes) {
-  static_assert(kMaxDependencyBuffers <=
-                lvk::Dependencies::LVK_MAX_SUBMIT_DEPENDENCIES);
-  if (passes.empty()) {
-    return Result<bool, std::string>::makeResult(true);
-  }
+namespace {
 
-  lvk::TextureHandle swapchainTexture{};
-  {
-    // beginFrame() and resizeSwapchain() reset currentFrameSwapchainTexture
-    // while holding contextImmediateMutex, so copy it under the same lock.
-    std::lock_guard immediateLock(impl_->contextImmediateMutex);
-    swapchainTexture = impl_->currentFrameSwapchainTexture;
-  }
-  const auto fillDependencies =
-      [this](std::span<const BufferHandle> dependencyBuffers,
-             lvk::Dependencies &deps,
-             std::string_view context) -> Result<bool, std::string> {
-    if (dependencyBuffers.size() > kMaxDependencyBuffers) {
-      return makeDependencyCountExceededError(context);
+// Records the draw items and the draw stream of a graphics pass into an open
+// rendering scope.
+[[nodiscard]] Result<bool, std::string> recordDrawCommands(
+    lvk::ICommandBuffer &sink, const RenderPass &pass,
+    const ResourceTable<BufferHandle, lvk::BufferHandle> &buffers,
+    const ResourceTable<RenderPipelineHandle, lvk::RenderPipelineHandle>
+        &pipelines,
+    const lvk::ScissorRect &viewportScissor,
+    bool supportsIndexedIndirectCount) {
+  const auto fail = [&sink](std::string_view message,
+                            bool drawLabelPushed) -> Result<bool, std::string> {
+    if (drawLabelPushed) {
+      sink.cmdPopDebugGroupLabel();
+    }
+    return Result<bool, std::string>::makeError(std::string(message));
+  };
+
+  bool scissorMatchesViewport = true;
+  bool pipelineBound = false;
+  RenderPipelineHandle boundPipeline{};
+  bool vertexBindingBound = false;
+  BufferHandle boundVertexBuffer{};
+  uint64_t boundVertexBufferOffset = 0;
+  bool indexBindingBound = false;
+  BufferHandle boundIndexBuffer{};
+  uint64_t boundIndexBufferOffset = 0;
+  IndexFormat boundIndexFormat = IndexFormat::U32;
+  bool depthStateBound = false;
+  DepthState boundDepthState{};
+  bool depthBiasEnableKnown = false;
+  bool depthBiasEnabled = false;
+  bool depthBiasParamsKnown = false;
+  float boundDepthBiasConstant = 0.0f;
+  float boundDepthBiasSlope = 0.0f;
+  float boundDepthBiasClamp = 0.0f;
+  DrawCommandTally tally{};
+
+  for (const DrawItem &draw : pass.draws) {
+    const bool drawLabelPushed =
+        kEnablePerDrawDebugLabels &&
+        pushDebugLabel(sink, draw.debugLabel, draw.debugColor);
+
+    if (!pipelineBound || !areSameHandle(draw.pipeline, boundPipeline)) {
+      if (!pipelines.isValid(draw.pipeline)) {
+        return fail("Invalid render pipeline handle", drawLabelPushed);
+      }
+      sink.cmdBindRenderPipeline(pipelines.getLvkHandle(draw.pipeline));
+      boundPipeline = draw.pipeline;
+      pipelineBound = true;
     }
 
-    size_t dstIndex = 0;
-    for (const BufferHandle bufferHandle : dependencyBuffers) {
-      if (!nuri::isValid(bufferHandle)) {
-        continue;
+    if (nuri::isValid(draw.vertexBuffer)) {
+      if (!buffers.isValid(draw.vertexBuffer)) {
+        return fail("Vertex buffer is invalid", drawLabelPushed);
       }
-      if (!impl_->buffers.isValid(bufferHandle)) {
-        return makeDependencyError(context, "dependency buffer is invalid");
+      const bool vertexBindingChanged =
+          !vertexBindingBound ||
+          !areSameHandle(draw.vertexBuffer, boundVertexBuffer) ||
+          boundVertexBufferOffset != draw.vertexBufferOffset;
+      if (vertexBindingChanged) {
+        sink.cmdBindVertexBuffer(0, buffers.getLvkHandle(draw.vertexBuffer),
+                                 draw.vertexBufferOffset);
+        boundVertexBuffer = draw.vertexBuffer;
+        boundVertexBufferOffset = draw.vertexBufferOffset;
+        vertexBindingBound = true;
       }
-      deps.buffers[dstIndex++] = impl_->buffers.getLvkHandle(bufferHandle);
     }
-    return Result<bool, std::string>::makeResult(true);
-  };
-  const bool supportsIndexedIndirectCount =
-      impl_->context->supportsDrawIndexedIndirectCount();
 
-  for (const RenderPass &pass : passes) {
-    const bool passLabelPushed =
-        pushDebugLabel(commandBuffer, pass.debugLabel, pass.debugColor);
-    const auto returnPassError =
-        [&](std::string_view message) -> Result<bool, std::string> {
-      if (passLabelPushed) {
-        commandBuffer.cmdPopDebugGroupLabel();
+    const bool isDirectDraw = draw.command == DrawCommandType::Direct;
+    const bool isIndexedIndirectDraw =
+        draw.command == DrawCommandType::IndexedIndirect ||
+        draw.command == DrawCommandType::IndexedIndirectCount;
+    const bool requiresIndexBuffer =
+        isIndexedIndirectDraw || (isDirectDraw && draw.indexCount > 0);
+    if (requiresIndexBuffer) {
+      const bool indexBindingChanged =
+          !indexBindingBound ||
+          !areSameHandle(draw.indexBuffer, boundIndexBuffer) ||
+          boundIndexBufferOffset != draw.indexBufferOffset ||
+          boundIndexFormat != draw.indexFormat;
+      if (indexBindingChanged) {
+        if (!buffers.isValid(draw.indexBuffer)) {
+          return fail("Index buffer is invalid", drawLabelPushed);
+        }
+        sink.cmdBindIndexBuffer(buffers.getLvkHandle(draw.indexBuffer),
+                                toLvkIndexFormat(draw.indexFormat),
+                                draw.indexBufferOffset);
+        boundIndexBuffer = draw.indexBuffer;
+        boundIndexBufferOffset = draw.indexBufferOffset;
+        boundIndexFormat = draw.indexFormat;
+        indexBindingBound = true;
       }
-      return Result<bool, std::string>::makeError(std::string(message));
-    };
-    const auto returnPassErrorResult =
-        [&](Result<bool, std::string> result) -> Result<bool, std::string> {
-      if (passLabelPushed) {
-        commandBuffer.cmdPopDebugGroupLabel();
+    }
+
+    if (draw.useDepthState) {
+      const bool depthStateChanged =
+          !depthStateBound ||
+          boundDepthState.compareOp != draw.depthState.compareOp ||
+          boundDepthState.isDepthWriteEnabled !=
+              draw.depthState.isDepthWriteEnabled;
+      if (depthStateChanged) {
+        lvk::DepthState depthState{
+            .compareOp = toLvkCompareOp(draw.depthState.compareOp),
+            .isDepthWriteEnabled = draw.depthState.isDepthWriteEnabled,
+        };
+        sink.cmdBindDepthState(depthState);
+        boundDepthState = draw.depthState;
+        depthStateBound = true;
       }
-      return result;
-    };
+    }
 
-    lvk::RenderPass renderPass{};
-    renderPass.color[0] = {
-        .loadOp = toLvkLoadOp(pass.color.loadOp),
-        .storeOp = toLvkStoreOp(pass.color.storeOp),
-        .clearColor = {pass.color.clearColor.r, pass.color.clearColor.g,
-                       pass.color.clearColor.b, pass.color.clearColor.a},
-    };
+    const bool depthBiasEnableChanged =
+        !depthBiasEnableKnown || depthBiasEnabled != draw.depthBiasEnable;
+    if (depthBiasEnableChanged) {
+      sink.cmdSetDepthBiasEnable(draw.depthBiasEnable);
+      depthBiasEnableKnown = true;
+      depthBiasEnabled = draw.depthBiasEnable;
+    }
+    if (draw.depthBiasEnable) {
+      const bool depthBiasParamsChanged =
+          !depthBiasParamsKnown || depthBiasEnableChanged ||
+          boundDepthBiasConstant != draw.depthBiasConstant ||
+          boundDepthBiasSlope != draw.depthBiasSlope ||
+          boundDepthBiasClamp != draw.depthBiasClamp;
+      if (depthBiasParamsChanged) {
+        sink.cmdSetDepthBias(draw.depthBiasConstant, draw.depthBiasSlope,
+                             draw.depthBiasClamp);
+        boundDepthBiasConstant = draw.depthBiasConstant;
+        boundDepthBiasSlope = draw.depthBiasSlope;
+        boundDepthBiasClamp = draw.depthBiasClamp;
+        depthBiasParamsKnown = true;
+      }
+    }
 
-    lvk::TextureHandle colorTexture{};
-    if (nuri::isValid(pass.colorTexture)) {
-      if (!impl_->textures.isValid(pass.colorTexture)) {
-        return returnPassError(
-            "LvkGPUDevice::recordGraphicsPass: invalid pass color texture "
-            "handle");
+    if (draw.useScissor) {
+      sink.cmdBindScissorRect({draw.scissor.x, draw.scissor.y,
+                               draw.scissor.width, draw.scissor.height});
+      scissorMatchesViewport = false;
+    } else if (!scissorMatchesViewport) {
+      sink.cmdBindScissorRect(viewportScissor);
+      scissorMatchesViewport = true;
+    }
+
+    if (!draw.pushConstants.empty()) {
+      sink.cmdPushConstants(
+          static_cast<const void *>(draw.pushConstants.data()),
+          draw.pushConstants.size(), 0);
+    }
+
+    if (draw.command == DrawCommandType::IndexedIndirect) {
+      if (!buffers.isValid(draw.indirectBuffer)) {
+        return fail("Indirect buffer is invalid", drawLabelPushed);
       }
-      colorTexture = impl_->textures.getLvkHandle(pass.colorTexture);
-      if (!colorTexture.valid()) {
-        return returnPassError(
-            "LvkGPUDevice::recordGraphicsPass: invalid LVK pass color texture "
-            "handle");
+      if (draw.indirectDrawCount > 0) {
+        sink.cmdDrawIndexedIndirect(buffers.getLvkHandle(draw.indirectBuffer),
+                                    draw.indirectBufferOffset,
+                                    draw.indirectDrawCount,
+                                    draw.indirectStride);
+        ++tally.indirectDrawCalls;
       }
-    } else {
-      colorTexture = swapchainTexture;
-      if (!colorTexture.valid()) {
-        return returnPassError(
-            "LvkGPUDevice::recordGraphicsPass: invalid swapchain texture");
+    } else if (draw.command == DrawCommandType::IndexedIndirectCount) {
+      if (!buffers.isValid(draw.indirectBuffer) ||
+          !buffers.isValid(draw.indirectCountBuffer)) {
+        return fail("Indirect or count buffer is invalid", drawLabelPushed);
       }
+      if (draw.indirectDrawCount > 0) {
+        ++tally.indirectDrawCalls;
+        if (supportsIndexedIndirectCount) {
+          sink.cmdDrawIndexedIndirectCount(
+              buffers.getLvkHandle(draw.indirectBuffer),
+              draw.indirectBufferOffset,
+              buffers.getLvkHandle(draw.indirectCountBuffer),
+              draw.indirectCountBufferOffset, draw.indirectDrawCount,
+              draw.indirectStride);
+        } else {
+          sink.cmdDrawIndexedIndirect(buffers.getLvkHandle(draw.indirectBuffer),
+                                      draw.indirectBufferOffset,
+                                      draw.indirectDrawCount,
+                                      draw.indirectStride);
+        }
+      }
+    } else if (draw.indexCount > 0) {
+      sink.cmdDrawIndexed(draw.indexCount, draw.instanceCount, draw.firstIndex,
+                          draw.vertexOffset, draw.firstInstance);
+      tally.addDirect(draw.indexCount, draw.instanceCount);
+    } else {
+      sink.cmdDraw(draw.vertexCount, draw.instanceCount, draw.firstVertex,
+                   draw.firstInstance);
+      tally.addDirect(draw.vertexCount, draw.instanceCount);
     }
 
-    lvk::Framebuffer framebuffer{};
-    framebuffer.color[0] = {.texture = colorTexture};
+    if (drawLabelPushed) {
+      sink.cmdPopDebugGroupLabel();
+    }
+  }
 
-    if (nuri::isValid(pass.depthTexture)) {
-      if (!impl_->textures.isValid(pass.depthTexture)) {
-        return returnPassError(
-            "LvkGPUDevice::recordGraphicsPass: invalid pass depth texture "
-            "handle");
+  DrawStreamReader streamReader(pass.drawStream);
+  DrawStreamCommand streamCommand{};
+  while (true) {
+    auto nextResult = streamReader.next(streamCommand);
+    if (nextResult.hasError()) {
+      return fail(nextResult.error(), false);
+    }
+    if (!nextResult.value()) {
+      break;
+    }
+    if (isDrawStreamDrawOp(streamCommand.op)) {
+      if (!pipelineBound) {
+        return fail("Draw stream draws without a bound pipeline", false);
       }
-      const lvk::TextureHandle depthTexture =
-          impl_->textures.getLvkHandle(pass.depthTexture);
-      if (!depthTexture.valid()) {
-        return returnPassError(
-            "LvkGPUDevice::recordGraphicsPass: invalid LVK pass depth texture "
-            "handle");
+      if (streamCommand.op != DrawStreamOp::Draw && !indexBindingBound) {
+        return fail("Draw stream indexed draw without an index buffer",
+                    false);
       }
-      renderPass.depth = {
-          .loadOp = toLvkLoadOp(pass.depth.loadOp),
-          .storeOp = toLvkStoreOp(pass.depth.storeOp),
-          .clearDepth = pass.depth.clearDepth,
-          .clearStencil = pass.depth.clearStencil,
+    }
+
+    switch (streamCommand.op) {
+    case DrawStreamOp::BindPipeline: {
+      const auto pipeline = streamCommand.as<RenderPipelineHandle>();
+      if (pipelineBound && areSameHandle(pipeline, boundPipeline)) {
+        break;
+      }
+      if (!pipelines.isValid(pipeline)) {
+        return fail("Invalid render pipeline handle", false);
+      }
+      sink.cmdBindRenderPipeline(pipelines.getLvkHandle(pipeline));
+      boundPipeline = pipeline;
+      pipelineBound = true;
+      break;
+    }
+    case DrawStreamOp::BindVertexBuffer: {
+      const auto binding = streamCommand.as<DrawStreamBindVertexBuffer>();
+      if (vertexBindingBound &&
+          areSameHandle(binding.buffer, boundVertexBuffer) &&
+          boundVertexBufferOffset == binding.offset) {
+        break;
+      }
+      if (!buffers.isValid(binding.buffer)) {
+        return fail("Vertex buffer is invalid", false);
+      }
+      sink.cmdBindVertexBuffer(0, buffers.getLvkHandle(binding.buffer),
+                               binding.offset);
+      boundVertexBuffer = binding.buffer;
+      boundVertexBufferOffset = binding.offset;
+      vertexBindingBound = true;
+      break;
+    }
+    case DrawStreamOp::BindIndexBuffer: {
+      const auto binding = streamCommand.as<DrawStreamBindIndexBuffer>();
+      if (indexBindingBound &&
+          areSameHandle(binding.buffer, boundIndexBuffer) &&
+          boundIndexBufferOffset == binding.offset &&
+          boundIndexFormat == binding.format) {
+        break;
+      }
+      if (!buffers.isValid(binding.buffer)) {
+        return fail("Index buffer is invalid", false);
+      }
+      sink.cmdBindIndexBuffer(buffers.getLvkHandle(binding.buffer),
+                              toLvkIndexFormat(binding.format),
+                              binding.offset);
+      boundIndexBuffer = binding.buffer;
+      boundIndexBufferOffset = binding.offset;
+      boundIndexFormat = binding.format;
+      indexBindingBound = true;
+      break;
+    }
+    case DrawStreamOp::SetDepthState: {
+      const auto state = streamCommand.as<DepthState>();
+      if (depthStateBound && boundDepthState.compareOp == state.compareOp &&
+          boundDepthState.isDepthWriteEnabled == state.isDepthWriteEnabled) {
+        break;
+      }
+      lvk::DepthState depthState{
+          .compareOp = toLvkCompareOp(state.compareOp),
+          .isDepthWriteEnabled = state.isDepthWriteEnabled,
       };
-      framebuffer.depthStencil = {.texture = depthTexture};
-    } else {
-      renderPass.depth.loadOp = lvk::LoadOp_Invalid;
+      sink.cmdBindDepthState(depthState);
+      boundDepthState = state;
+      depthStateBound = true;
+      break;
+    }
+    case DrawStreamOp::SetDepthBias: {
+      const auto bias = streamCommand.as<DrawStreamSetDepthBias>();
+      const bool enable = bias.enable != 0u;
+      const bool enableChanged =
+          !depthBiasEnableKnown || depthBiasEnabled != enable;
+      if (enableChanged) {
+        sink.cmdSetDepthBiasEnable(enable);
+        depthBiasEnableKnown = true;
+        depthBiasEnabled = enable;
+      }
+      if (enable && (!depthBiasParamsKnown || enableChanged ||
+                     boundDepthBiasConstant != bias.constant ||
+                     boundDepthBiasSlope != bias.slope ||
+                     boundDepthBiasClamp != bias.clamp)) {
+        sink.cmdSetDepthBias(bias.constant, bias.slope, bias.clamp);
+        boundDepthBiasConstant = bias.constant;
+        boundDepthBiasSlope = bias.slope;
+        boundDepthBiasClamp = bias.clamp;
+        depthBiasParamsKnown = true;
+      }
+      break;
+    }
+    case DrawStreamOp::SetScissor: {
+      const auto scissor = streamCommand.as<DrawStreamSetScissor>();
+      if (scissor.enable != 0u) {
+        sink.cmdBindScissorRect({scissor.rect.x, scissor.rect.y,
+                                 scissor.rect.width, scissor.rect.height});
+        scissorMatchesViewport = false;
+      } else if (!scissorMatchesViewport) {
+        sink.cmdBindScissorRect(viewportScissor);
+        scissorMatchesViewport = true;
+      }
+      break;
+    }
+    case DrawStreamOp::PushConstants:
+      sink.cmdPushConstants(
+          static_cast<const void *>(streamCommand.payload.data()),
+          streamCommand.payload.size(), 0);
+      break;
+    case DrawStreamOp::Draw: {
+      const auto draw = streamCommand.as<DrawStreamDraw>();
+      sink.cmdDraw(draw.vertexCount, draw.instanceCount, draw.firstVertex,
+                   draw.firstInstance);
+      tally.addDirect(draw.vertexCount, draw.instanceCount);
+      break;
+    }
+    case DrawStreamOp::DrawIndexed: {
+      const auto draw = streamCommand.as<DrawStreamDrawIndexed>();
+      sink.cmdDrawIndexed(draw.indexCount, draw.instanceCount, draw.firstIndex,
+                          draw.vertexOffset, draw.firstInstance);
+      tally.addDirect(draw.indexCount, draw.instanceCount);
+      break;
+    }
+    case DrawStreamOp::DrawIndexedIndirect: {
+      const auto draw = streamCommand.as<DrawStreamDrawIndexedIndirect>();
+      if (!buffers.isValid(draw.buffer)) {
+        return fail("Indirect buffer is invalid", false);
+      }
+      if (draw.drawCount > 0) {
+        sink.cmdDrawIndexedIndirect(buffers.getLvkHandle(draw.buffer),
+                                    draw.offset, draw.drawCount, draw.stride);
+        ++tally.indirectDrawCalls;
+      }
+      break;
+    }
+    case DrawStreamOp::DrawIndexedIndirectCount: {
+      const auto draw = streamCommand.as<DrawStreamDrawIndexedIndirectCount>();
+      if (!buffers.isValid(draw.buffer) || !buffers.isValid(draw.countBuffer)) {
+        return fail("Indirect or count buffer is invalid", false);
+      }
+      if (draw.maxDrawCount == 0) {
+        break;
+      }
+      ++tally.indirectDrawCalls;
+      if (supportsIndexedIndirectCount) {
+        sink.cmdDrawIndexedIndirectCount(
+            buffers.getLvkHandle(draw.buffer), draw.offset,
+            buffers.getLvkHandle(draw.countBuffer), draw.countOffset,
+            draw.maxDrawCount, draw.stride);
+      } else {
+        sink.cmdDrawIndexedIndirect(buffers.getLvkHandle(draw.buffer),
+                                    draw.offset, draw.maxDrawCount,
+                                    draw.stride);
+      }
+      break;
+    }
+    case DrawStreamOp::Count:
+    default:
+      return fail("Unknown draw stream record", false);
+    }
+  }
+
+  tally.publish();
+  return Result<bool, std::string>::makeResult(true);
+}
+
+} // namespace
+
+Result<bool, std::string>
+LvkGPUDevice::recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
+                                 std::span<const RenderPass> passes) {
+  static_assert(kMaxDependencyBuffers <=
+                lvk::Dependencies::LVK_MAX_SUBMIT_DEPENDENCIES);
+  if (passes.empty()) {
+    return Result<bool, std::string>::makeResult(true);
+  }
+
+  lvk::TextureHandle swapchainTexture{};
+  {
+    // beginFrame() and resizeSwapchain() reset currentFrameSwapchainTexture
+    // while holding contextImmediateMutex, so copy it under the same lock.
+    std::lock_guard immediateLock(impl_->contextImmediateMutex);
+    swapchainTexture = impl_->currentFrameSwapchainTexture;
+  }
+  const auto fillDependencies =
+      [this](std::span<const BufferHandle> dependencyBuffers,
+             lvk::Dependencies &deps,
+             std::string_view context) -> Result<bool, std::string> {
+    if (dependencyBuffers.size() > kMaxDependencyBuffers) {
+      return makeDependencyCountExceededError(context);
+    }
+
+    size_t dstIndex = 0;
+    for (const BufferHandle bufferHandle : dependencyBuffers) {
+      if (!nuri::isValid(bufferHandle)) {
+        continue;
+      }
+      if (!impl_->buffers.isValid(bufferHandle)) {
+        return makeDependencyError(context, "dependency buffer is invalid");
+      }
+      deps.buffers[dstIndex++] = impl_->buffers.getLvkHandle(bufferHandle);
+    }
+    return Result<bool, std::string>::makeResult(true);
+  };
+  const auto recordBufferCopies =
+      [this, &commandBuffer](std::span<const BufferCopyRegion> copies)
+      -> Result<bool, std::string> {
+    for (const BufferCopyRegion &region : copies) {
+      if (region.size == 0) {
+        continue;
+      }
+      if (!impl_->buffers.isValid(region.srcBuffer) ||
+          !impl_->buffers.isValid(region.dstBuffer)) {
+        return Result<bool, std::string>::makeError(
+            "LvkGPUDevice::recordGraphicsPass: invalid copy source or "
+            "destination buffer");
+      }
+      const lvk::BufferHandle src =
+          impl_->buffers.getLvkHandle(region.srcBuffer);
+      const lvk::BufferHandle dst =
+          impl_->buffers.getLvkHandle(region.dstBuffer);
+      const size_t srcSize =
+          static_cast<size_t>(lvk::getBufferSize(impl_->context.get(), src));
+      const size_t dstSize =
+          static_cast<size_t>(lvk::getBufferSize(impl_->context.get(), dst));
+      if (region.srcOffset > srcSize ||
+          region.size > srcSize - region.srcOffset ||
+          region.dstOffset > dstSize ||
+          region.size > dstSize - region.dstOffset) {
+        return Result<bool, std::string>::makeError(
+            "LvkGPUDevice::recordGraphicsPass: copy range is out of bounds");
+      }
+    }
+
+    NURI_PROFILER_ZONE("LvkGPUDevice.buffer_copy_recording",
+                       NURI_PROFILER_COLOR_CMD_COPY);
+    for (const BufferCopyRegion &region : copies) {
+      if (region.size == 0) {
+        continue;
+      }
+      commandBuffer.cmdCopyBuffer(impl_->buffers.getLvkHandle(region.srcBuffer),
+                                  impl_->buffers.getLvkHandle(region.dstBuffer),
+                                  region.srcOffset, region.dstOffset,
+                                  region.size);
+    }
+    NURI_PROFILER_ZONE_END();
+    return Result<bool, std::string>::makeResult(true);
+  };
+  const bool supportsIndexedIndirectCount =
+      impl_->context->supportsDrawIndexedIndirectCount();
+
+  for (const RenderPass &pass : passes) {
+    const bool passLabelPushed =
+        pushDebugLabel(commandBuffer, pass.debugLabel, pass.debugColor);
+    const auto returnPassError =
+        [&](std::string_view message) -> Result<bool, std::string> {
+      if (passLabelPushed) {
+        commandBuffer.cmdPopDebugGroupLabel();
+      }
+      return Result<bool, std::string>::makeError(std::string(message));
+    };
+    const auto returnPassErrorResult =
+        [&](Result<bool, std::string> result) -> Result<bool, std::string> {
+      if (passLabelPushed) {
+        commandBuffer.cmdPopDebugGroupLabel();
+      }
+      return result;
+    };
+
+    if (pass.kind == RenderPassKind::Transfer) {
+      auto copyResult = recordBufferCopies(pass.copies);
+      if (copyResult.hasError()) {
+        return returnPassErrorResult(copyResult);
+      }
+      if (passLabelPushed) {
+        commandBuffer.cmdPopDebugGroupLabel();
+      }
+      continue;
     }
 
     {
@@ -1674,6 +2706,100 @@ LvkGPUDevice::recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
       NURI_PROFILER_ZONE_END();
     }
 
+    // Compute passes only carry dispatches; skipping the rendering scope lets
+    // compute-only chains avoid attachment setup and layout transitions.
+    if (pass.kind == RenderPassKind::Compute) {
+      if (passLabelPushed) {
+        commandBuffer.cmdPopDebugGroupLabel();
+      }
+      continue;
+    }
+
+    lvk::RenderPass renderPass{};
+    renderPass.color[0] = {
+        .loadOp = toLvkLoadOp(pass.color.loadOp),
+        .storeOp = toLvkStoreOp(pass.color.storeOp),
+        .clearColor = {pass.color.clearColor.r, pass.color.clearColor.g,
+                       pass.color.clearColor.b, pass.color.clearColor.a},
+    };
+
+    lvk::TextureHandle colorTexture{};
+    if (nuri::isValid(pass.colorTexture)) {
+      if (!impl_->textures.isValid(pass.colorTexture)) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid pass color texture "
+            "handle");
+      }
+      colorTexture = impl_->textures.getLvkHandle(pass.colorTexture);
+      if (!colorTexture.valid()) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid LVK pass color texture "
+            "handle");
+      }
+    } else {
+      colorTexture = swapchainTexture;
+      if (!colorTexture.valid()) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid swapchain texture");
+      }
+    }
+
+    lvk::Framebuffer framebuffer{};
+    framebuffer.color[0] = {.texture = colorTexture};
+
+    if (pass.additionalColorCount > kMaxAdditionalColorAttachments) {
+      return returnPassError(
+          "LvkGPUDevice::recordGraphicsPass: additional color attachment "
+          "count exceeds kMaxAdditionalColorAttachments");
+    }
+    for (uint32_t i = 0; i < pass.additionalColorCount; ++i) {
+      const TextureHandle attachmentHandle = pass.additionalColorTextures[i];
+      if (!impl_->textures.isValid(attachmentHandle)) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid pass additional color "
+            "texture handle");
+      }
+      const lvk::TextureHandle attachmentTexture =
+          impl_->textures.getLvkHandle(attachmentHandle);
+      if (!attachmentTexture.valid()) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid LVK pass additional "
+            "color texture handle");
+      }
+      const AttachmentColor &attachment = pass.additionalColors[i];
+      renderPass.color[i + 1u] = {
+          .loadOp = toLvkLoadOp(attachment.loadOp),
+          .storeOp = toLvkStoreOp(attachment.storeOp),
+          .clearColor = {attachment.clearColor.r, attachment.clearColor.g,
+                         attachment.clearColor.b, attachment.clearColor.a},
+      };
+      framebuffer.color[i + 1u] = {.texture = attachmentTexture};
+    }
+
+    if (nuri::isValid(pass.depthTexture)) {
+      if (!impl_->textures.isValid(pass.depthTexture)) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid pass depth texture "
+            "handle");
+      }
+      const lvk::TextureHandle depthTexture =
+          impl_->textures.getLvkHandle(pass.depthTexture);
+      if (!depthTexture.valid()) {
+        return returnPassError(
+            "LvkGPUDevice::recordGraphicsPass: invalid LVK pass depth texture "
+            "handle");
+      }
+      renderPass.depth = {
+          .loadOp = toLvkLoadOp(pass.depth.loadOp),
+          .storeOp = toLvkStoreOp(pass.depth.storeOp),
+          .clearDepth = pass.depth.clearDepth,
+          .clearStencil = pass.depth.clearStencil,
+      };
+      framebuffer.depthStencil = {.texture = depthTexture};
+    } else {
+      renderPass.depth.loadOp = lvk::LoadOp_Invalid;
+    }
+
     lvk::Dependencies renderDependencies{};
     auto renderDepsResult =
         fillDependencies(pass.dependencyBuffers, renderDependencies,
@@ -1685,12 +2811,8 @@ LvkGPUDevice::recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
     commandBuffer.cmdBeginRendering(renderPass, framebuffer,
                                     renderDependencies);
     const auto returnDrawError =
-        [&](std::string_view message,
-            bool drawLabelPushed) -> Result<bool, std::string> {
+        [&](std::string_view message) -> Result<bool, std::string> {
       commandBuffer.cmdEndRendering();
-      if (drawLabelPushed) {
-        commandBuffer.cmdPopDebugGroupLabel();
-      }
       if (passLabelPushed) {
         commandBuffer.cmdPopDebugGroupLabel();
       }
@@ -1728,184 +2850,11 @@ LvkGPUDevice::recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
     };
     commandBuffer.cmdBindScissorRect(viewportScissor);
 
-    bool scissorMatchesViewport = true;
-    bool pipelineBound = false;
-    RenderPipelineHandle boundPipeline{};
-    bool vertexBindingBound = false;
-    BufferHandle boundVertexBuffer{};
-    uint64_t boundVertexBufferOffset = 0;
-    bool indexBindingBound = false;
-    BufferHandle boundIndexBuffer{};
-    uint64_t boundIndexBufferOffset = 0;
-    IndexFormat boundIndexFormat = IndexFormat::U32;
-    bool depthStateBound = false;
-    DepthState boundDepthState{};
-    bool depthBiasEnableKnown = false;
-    bool depthBiasEnabled = false;
-    bool depthBiasParamsKnown = false;
-    float boundDepthBiasConstant = 0.0f;
-    float boundDepthBiasSlope = 0.0f;
-    float boundDepthBiasClamp = 0.0f;
-
-    for (const DrawItem &draw : pass.draws) {
-      const bool drawLabelPushed =
-          kEnablePerDrawDebugLabels &&
-          pushDebugLabel(commandBuffer, draw.debugLabel, draw.debugColor);
-
-      if (!pipelineBound || !areSameHandle(draw.pipeline, boundPipeline)) {
-        if (!impl_->renderPipelines.isValid(draw.pipeline)) {
-          return returnDrawError("Invalid render pipeline handle",
-                                 drawLabelPushed);
-        }
-        commandBuffer.cmdBindRenderPipeline(
-            impl_->renderPipelines.getLvkHandle(draw.pipeline));
-        boundPipeline = draw.pipeline;
-        pipelineBound = true;
-      }
-
-      if (nuri::isValid(draw.vertexBuffer)) {
-        if (!impl_->buffers.isValid(draw.vertexBuffer)) {
-          return returnDrawError("Vertex buffer is invalid", drawLabelPushed);
-        }
-        const bool vertexBindingChanged =
-            !vertexBindingBound ||
-            !areSameHandle(draw.vertexBuffer, boundVertexBuffer) ||
-            boundVertexBufferOffset != draw.vertexBufferOffset;
-        if (vertexBindingChanged) {
-          commandBuffer.cmdBindVertexBuffer(
-              0, impl_->buffers.getLvkHandle(draw.vertexBuffer),
-              draw.vertexBufferOffset);
-          boundVertexBuffer = draw.vertexBuffer;
-          boundVertexBufferOffset = draw.vertexBufferOffset;
-          vertexBindingBound = true;
-        }
-      }
-
-      const bool isDirectDraw = draw.command == DrawCommandType::Direct;
-      const bool isIndexedIndirectDraw =
-          draw.command == DrawCommandType::IndexedIndirect ||
-          draw.command == DrawCommandType::IndexedIndirectCount;
-      const bool requiresIndexBuffer =
-          isIndexedIndirectDraw || (isDirectDraw && draw.indexCount > 0);
-      if (requiresIndexBuffer) {
-        const bool indexBindingChanged =
-            !indexBindingBound ||
-            !areSameHandle(draw.indexBuffer, boundIndexBuffer) ||
-            boundIndexBufferOffset != draw.indexBufferOffset ||
-            boundIndexFormat != draw.indexFormat;
-        if (indexBindingChanged) {
-          if (!impl_->buffers.isValid(draw.indexBuffer)) {
-            return returnDrawError("Index buffer is invalid", drawLabelPushed);
-          }
-          commandBuffer.cmdBindIndexBuffer(
-              impl_->buffers.getLvkHandle(draw.indexBuffer),
-              toLvkIndexFormat(draw.indexFormat), draw.indexBufferOffset);
-          boundIndexBuffer = draw.indexBuffer;
-          boundIndexBufferOffset = draw.indexBufferOffset;
-          boundIndexFormat = draw.indexFormat;
-          indexBindingBound = true;
-        }
-      }
-
-      if (draw.useDepthState) {
-        const bool depthStateChanged =
-            !depthStateBound ||
-            boundDepthState.compareOp != draw.depthState.compareOp ||
-            boundDepthState.isDepthWriteEnabled !=
-                draw.depthState.isDepthWriteEnabled;
-        if (depthStateChanged) {
-          lvk::DepthState depthState{
-              .compareOp = toLvkCompareOp(draw.depthState.compareOp),
-              .isDepthWriteEnabled = draw.depthState.isDepthWriteEnabled,
-          };
-          commandBuffer.cmdBindDepthState(depthState);
-          boundDepthState = draw.depthState;
-          depthStateBound = true;
-        }
-      }
-
-      const bool depthBiasEnableChanged =
-          !depthBiasEnableKnown || depthBiasEnabled != draw.depthBiasEnable;
-      if (depthBiasEnableChanged) {
-        commandBuffer.cmdSetDepthBiasEnable(draw.depthBiasEnable);
-        depthBiasEnableKnown = true;
-        depthBiasEnabled = draw.depthBiasEnable;
-      }
-      if (draw.depthBiasEnable) {
-        const bool depthBiasParamsChanged =
-            !depthBiasParamsKnown || depthBiasEnableChanged ||
-            boundDepthBiasConstant != draw.depthBiasConstant ||
-            boundDepthBiasSlope != draw.depthBiasSlope ||
-            boundDepthBiasClamp != draw.depthBiasClamp;
-        if (depthBiasParamsChanged) {
-          commandBuffer.cmdSetDepthBias(
-              draw.depthBiasConstant, draw.depthBiasSlope, draw.depthBiasClamp);
-          boundDepthBiasConstant = draw.depthBiasConstant;
-          boundDepthBiasSlope = draw.depthBiasSlope;
-          boundDepthBiasClamp = draw.depthBiasClamp;
-          depthBiasParamsKnown = true;
-        }
-      }
-
-      if (draw.useScissor) {
-        commandBuffer.cmdBindScissorRect({draw.scissor.x, draw.scissor.y,
-                                          draw.scissor.width,
-                                          draw.scissor.height});
-        scissorMatchesViewport = false;
-      } else if (!scissorMatchesViewport) {
-        commandBuffer.cmdBindScissorRect(viewportScissor);
-        scissorMatchesViewport = true;
-      }
-
-      if (!draw.pushConstants.empty()) {
-        commandBuffer.cmdPushConstants(
-            static_cast<const void *>(draw.pushConstants.data()),
-            draw.pushConstants.size(), 0);
-      }
-
-      if (draw.command == DrawCommandType::IndexedIndirect) {
-        if (!impl_->buffers.isValid(draw.indirectBuffer)) {
-          return returnDrawError("Indirect buffer is invalid", drawLabelPushed);
-        }
-        if (draw.indirectDrawCount > 0) {
-          commandBuffer.cmdDrawIndexedIndirect(
-              impl_->buffers.getLvkHandle(draw.indirectBuffer),
-              draw.indirectBufferOffset, draw.indirectDrawCount,
-              draw.indirectStride);
-        }
-      } else if (draw.command == DrawCommandType::IndexedIndirectCount) {
-        if (!impl_->buffers.isValid(draw.indirectBuffer) ||
-            !impl_->buffers.isValid(draw.indirectCountBuffer)) {
-          return returnDrawError("Indirect or count buffer is invalid",
-                                 drawLabelPushed);
-        }
-        if (draw.indirectDrawCount > 0) {
-          if (supportsIndexedIndirectCount) {
-            commandBuffer.cmdDrawIndexedIndirectCount(
-                impl_->buffers.getLvkHandle(draw.indirectBuffer),
-                draw.indirectBufferOffset,
-                impl_->buffers.getLvkHandle(draw.indirectCountBuffer),
-                draw.indirectCountBufferOffset, draw.indirectDrawCount,
-                draw.indirectStride);
-          } else {
-            commandBuffer.cmdDrawIndexedIndirect(
-                impl_->buffers.getLvkHandle(draw.indirectBuffer),
-                draw.indirectBufferOffset, draw.indirectDrawCount,
-                draw.indirectStride);
-          }
-        }
-      } else if (draw.indexCount > 0) {
-        commandBuffer.cmdDrawIndexed(draw.indexCount, draw.instanceCount,
-                                     draw.firstIndex, draw.vertexOffset,
-                                     draw.firstInstance);
-      } else {
-        commandBuffer.cmdDraw(draw.vertexCount, draw.instanceCount,
-                              draw.firstVertex, draw.firstInstance);
-      }
-
-      if (drawLabelPushed) {
-        commandBuffer.cmdPopDebugGroupLabel();
-      }
+    auto drawResult = recordDrawCommands(
+        commandBuffer, pass, impl_->buffers, impl_->renderPipelines,
+        viewportScissor, supportsIndexedIndirectCount);
+    if (drawResult.hasError()) {
+      return returnDrawError(drawResult.error());
     }
 
     commandBuffer.cmdEndRendering();
@@ -1921,7 +2870,7 @@ LvkGPUDevice::recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
 bool LvkGPUDevice::supportsParallelGraphicsRecording() const { return true; }
 
 uint32_t LvkGPUDevice::maxParallelGraphicsRecordingContexts() const {
-  return 8u;
+  return kMaxGraphicsRecordingContexts;
 }
 
 Result<RecordingContextHandle, std::string>
@@ -1930,28 +2879,35 @@ LvkGPUDevice::acquireGraphicsRecordingContext(uint32_t workerIndex) {
     return Result<RecordingContextHandle, std::string>::makeError(
         "LvkGPUDevice::acquireGraphicsRecordingContext: context is null");
   }
-  std::scoped_lock lock(impl_->contextImmediateMutex,
-                        impl_->graphicsContextMutex);
-  lvk::ICommandBuffer &commandBuffer = impl_->context->acquireCommandBuffer();
-  auto indexResult = allocateMonotonicHandleIndex(
-      impl_->nextRecordingContextIndex,
-      "LvkGPUDevice::acquireGraphicsRecordingContext");
-  if (indexResult.hasError()) {
+  // LVK hands out command buffers from one pool, so acquisition stays
+  // serialized; it happens once per worker per frame.
+  std::lock_guard lock(impl_->contextImmediateMutex);
+  uint32_t slotIndex = kMaxGraphicsRecordingContexts;
+  for (uint32_t probe = 0u; probe < kMaxGraphicsRecordingContexts; ++probe) {
+    const uint32_t candidate =
+        (workerIndex + probe) % kMaxGraphicsRecordingContexts;
+    if (impl_->graphicsRecordingSlots[candidate].liveGeneration.load(
+            std::memory_order_acquire) == 0u) {
+      slotIndex = candidate;
+      break;
+    }
+  }
+  if (slotIndex == kMaxGraphicsRecordingContexts) {
     return Result<RecordingContextHandle, std::string>::makeError(
-        indexResult.error());
-  }
-
-  const uint32_t index = indexResult.value();
-  const RecordingContextHandle handle{
-      .index = index,
-      .generation =
-          nextHandleGeneration(impl_->recordingContextGenerations, index)};
-  impl_->activeGraphicsContexts.push_back(ActiveGraphicsRecordingContext{
-      .handle = handle,
-      .commandBuffer = &commandBuffer,
-      .workerIndex = workerIndex,
-  });
-  return Result<RecordingContextHandle, std::string>::makeResult(handle);
+        "LvkGPUDevice::acquireGraphicsRecordingContext: all recording "
+        "contexts are in use");
+  }
+
+  GraphicsRecordingSlot &slot = impl_->graphicsRecordingSlots[slotIndex];
+  slot.commandBuffer = &impl_->context->acquireCommandBuffer();
+  ++slot.lastGeneration;
+  if (slot.lastGeneration == 0u) {
+    ++slot.lastGeneration;
+  }
+  slot.liveGeneration.store(slot.lastGeneration, std::memory_order_release);
+  return Result<RecordingContextHandle, std::string>::makeResult(
+      RecordingContextHandle{.index = slotIndex,
+                             .generation = slot.lastGeneration});
 }
 
 Result<bool, std::string> LvkGPUDevice::recordGraphicsBarriers(
@@ -1961,41 +2917,40 @@ Result<bool, std::string> LvkGPUDevice::recordGraphicsBarriers(
     return Result<bool, std::string>::makeResult(true);
   }
 
-  lvk::ICommandBuffer *rawCommandBuffer = nullptr;
-  {
-    std::lock_guard lock(impl_->graphicsContextMutex);
-    for (const auto &entry : impl_->activeGraphicsContexts) {
-      if (!areSameHandle(entry.handle, ctx)) {
-        continue;
-      }
-      rawCommandBuffer = entry.commandBuffer;
-      break;
-    }
-  }
-  if (rawCommandBuffer == nullptr) {
+  const GraphicsRecordingSlot *slot = impl_->findGraphicsRecordingSlot(ctx);
+  if (slot == nullptr) {
     return Result<bool, std::string>::makeError(
         "LvkGPUDevice::recordGraphicsBarriers: unknown recording context");
   }
+  lvk::ICommandBuffer *rawCommandBuffer = slot->commandBuffer;
 
-  const bool needsInternalBarrierApi =
-      std::find_if(barriers.begin(), barriers.end(),
-                   [](const GraphicsBarrierRecord &barrier) {
-                     return barrier.resourceKind ==
-                                GraphicsBarrierResourceKind::Buffer ||
-                            (barrier.resourceKind ==
-                                 GraphicsBarrierResourceKind::Texture &&
-                             barrier.afterState != GraphicsBarrierState::Read &&
-                             barrier.afterState !=
-                                 GraphicsBarrierState::Unknown);
-                   }) != barriers.end();
-  lvk::ICommandBuffer *commandBuffer = nullptr;
 #if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
-  commandBuffer = needsInternalBarrierApi ? rawCommandBuffer : nullptr;
-#else
-  if (needsInternalBarrierApi) {
-    return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-  }
-#endif
+  // All transitions of one pass go out as a single vkCmdPipelineBarrier2 with
+  // the stages the graph recorded for each side. Records without stages fall
+  // back to the conservative per-state masks.
+  auto *vkContext = static_cast<lvk::VulkanContext *>(impl_->context.get());
+  const auto resolveStages = [](GraphicsBarrierStage stages,
+                                GraphicsBarrierState state, bool isDepth) {
+    const VkPipelineStageFlags2 flags = toVkPipelineStages(stages);
+    return flags != VK_PIPELINE_STAGE_2_NONE
+               ? flags
+               : graphicsBarrierStages(state, isDepth);
+  };
+  const auto sourceMode = [](GraphicsBarrierAccessMode mode) {
+    // Nothing tracked before the first access this frame: assume a write.
+    return mode == GraphicsBarrierAccessMode::None
+               ? GraphicsBarrierAccessMode::Write
+               : mode & GraphicsBarrierAccessMode::Write;
+  };
+
+  std::array<std::byte, 4096> scratchStorage;
+  std::pmr::monotonic_buffer_resource scratch(scratchStorage.data(),
+                                              scratchStorage.size());
+  std::pmr::vector<VkImageMemoryBarrier2> imageBarriers(&scratch);
+  std::pmr::vector<VkBufferMemoryBarrier2> bufferBarriers(&scratch);
+  std::pmr::vector<lvk::VulkanImage *> transitionedImages(&scratch);
+  imageBarriers.reserve(barriers.size());
+  transitionedImages.reserve(barriers.size());
 
   for (const GraphicsBarrierRecord &barrier : barriers) {
     if (barrier.resourceKind == GraphicsBarrierResourceKind::Texture) {
@@ -2006,51 +2961,52 @@ Result<bool, std::string> LvkGPUDevice::recordGraphicsBarriers(
             "LvkGPUDevice::recordGraphicsBarriers: texture barrier handle "
             "is invalid");
       }
-
-      const lvk::TextureHandle texture =
-          impl_->textures.getLvkHandle(textureHandle);
-      switch (barrier.afterState) {
-      case GraphicsBarrierState::Read:
-        rawCommandBuffer->transitionToShaderReadOnly(texture);
-        break;
-      case GraphicsBarrierState::Attachment:
-#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
-        if (commandBuffer == nullptr) {
-          return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-        }
-        static_cast<lvk::CommandBuffer *>(commandBuffer)
-            ->transitionTextureLayout(texture,
-                                      VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL);
-#else
-        return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-#endif
-        break;
-      case GraphicsBarrierState::Write:
-#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
-        if (commandBuffer == nullptr) {
-          return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-        }
-        static_cast<lvk::CommandBuffer *>(commandBuffer)
-            ->transitionTextureLayout(texture, VK_IMAGE_LAYOUT_GENERAL);
-#else
-        return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-#endif
-        break;
-      case GraphicsBarrierState::Present:
-#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
-        if (commandBuffer == nullptr) {
-          return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-        }
-        static_cast<lvk::CommandBuffer *>(commandBuffer)
-            ->transitionTextureLayout(texture, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
-#else
-        return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-#endif
-        break;
-      case GraphicsBarrierState::Unknown:
-      default:
-        break;
+      if (barrier.afterState == GraphicsBarrierState::Unknown) {
+        continue;
       }
+      lvk::VulkanImage *image = vkContext->texturesPool_.get(
+          impl_->textures.getLvkHandle(textureHandle));
+      if (image == nullptr) {
+        return Result<bool, std::string>::makeError(
+            "LvkGPUDevice::recordGraphicsBarriers: invalid LVK texture");
+      }
+
+      const VkImageAspectFlags aspect = image->getImageAspectFlags();
+      const bool isDepth = (aspect & VK_IMAGE_ASPECT_DEPTH_BIT) != 0u;
+      const VkPipelineStageFlags2 srcStages =
+          resolveStages(barrier.beforeStages, barrier.beforeState, isDepth);
+      const VkPipelineStageFlags2 dstStages =
+          resolveStages(barrier.afterStages, barrier.afterState, isDepth);
+      const VkImageLayout oldLayout = image->vkImageLayout_;
+      // Multisampled images are never sampled; keep them out of the
+      // shader-read layout like lvk::CommandBuffer does.
+      const VkImageLayout newLayout =
+          barrier.afterState == GraphicsBarrierState::Read &&
+                  image->vkSamples_ != VK_SAMPLE_COUNT_1_BIT
+              ? oldLayout
+              : barrierImageLayout(barrier.afterState, oldLayout);
+      imageBarriers.push_back(VkImageMemoryBarrier2{
+          .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+          .srcStageMask = srcStages,
+          .srcAccessMask =
+              barrierAccessMask(srcStages, sourceMode(barrier.beforeAccess)),
+          .dstStageMask = dstStages,
+          .dstAccessMask = barrierAccessMask(dstStages, barrier.afterAccess),
+          .oldLayout = oldLayout,
+          .newLayout = newLayout,
+          .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .image = image->vkImage_,
+          .subresourceRange =
+              VkImageSubresourceRange{
+                  .aspectMask = aspect,
+                  .baseMipLevel = 0u,
+                  .levelCount = VK_REMAINING_MIP_LEVELS,
+                  .baseArrayLayer = 0u,
+                  .layerCount = VK_REMAINING_ARRAY_LAYERS,
+              },
+      });
+      transitionedImages.push_back(image);
       continue;
     }
 
@@ -2060,22 +3016,68 @@ Result<bool, std::string> LvkGPUDevice::recordGraphicsBarriers(
           "LvkGPUDevice::recordGraphicsBarriers: buffer barrier handle is "
           "invalid");
     }
-    if (commandBuffer == nullptr) {
-      return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-    }
+    const lvk::VulkanBuffer *buffer = vkContext->buffersPool_.get(
+        impl_->buffers.getLvkHandle(bufferHandle));
+    if (buffer == nullptr) {
+      return Result<bool, std::string>::makeError(
+          "LvkGPUDevice::recordGraphicsBarriers: invalid LVK buffer");
+    }
+
+    const VkPipelineStageFlags2 srcStages =
+        resolveStages(barrier.beforeStages, barrier.beforeState, false);
+    const VkPipelineStageFlags2 dstStages =
+        resolveStages(barrier.afterStages, barrier.afterState, false);
+    bufferBarriers.push_back(VkBufferMemoryBarrier2{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+        .srcStageMask = srcStages,
+        .srcAccessMask =
+            barrierAccessMask(srcStages, sourceMode(barrier.beforeAccess)),
+        .dstStageMask = dstStages,
+        .dstAccessMask = barrierAccessMask(dstStages, barrier.afterAccess),
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = buffer->vkBuffer_,
+        .offset = 0u,
+        .size = VK_WHOLE_SIZE,
+    });
+  }
 
-    const VkPipelineStageFlags2 srcStage =
-        graphicsBarrierStages(barrier.beforeState, false);
-    const VkPipelineStageFlags2 dstStage =
-        graphicsBarrierStages(barrier.afterState, false);
-#if NURI_LVK_HAS_VULKAN_COMMAND_BUFFER
-    static_cast<lvk::CommandBuffer *>(commandBuffer)
-        ->bufferBarrier(impl_->buffers.getLvkHandle(bufferHandle), srcStage,
-                        dstStage);
+  if (imageBarriers.empty() && bufferBarriers.empty()) {
+    return Result<bool, std::string>::makeResult(true);
+  }
+  const VkDependencyInfo dependency{
+      .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+      .bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()),
+      .pBufferMemoryBarriers = bufferBarriers.data(),
+      .imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()),
+      .pImageMemoryBarriers = imageBarriers.data(),
+  };
+  vkCmdPipelineBarrier2(
+      static_cast<lvk::CommandBuffer *>(rawCommandBuffer)->getVkCommandBuffer(),
+      &dependency);
+  for (size_t i = 0; i < transitionedImages.size(); ++i) {
+    transitionedImages[i]->vkImageLayout_ = imageBarriers[i].newLayout;
+  }
 #else
-    return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
-#endif
+  for (const GraphicsBarrierRecord &barrier : barriers) {
+    if (barrier.resourceKind == GraphicsBarrierResourceKind::Buffer ||
+        (barrier.afterState != GraphicsBarrierState::Read &&
+         barrier.afterState != GraphicsBarrierState::Unknown)) {
+      return makeLvkBarrierApiError("LvkGPUDevice::recordGraphicsBarriers");
+    }
+    const TextureHandle textureHandle = barrier.textureHandle();
+    if (!nuri::isValid(textureHandle) ||
+        !impl_->textures.isValid(textureHandle)) {
+      return Result<bool, std::string>::makeError(
+          "LvkGPUDevice::recordGraphicsBarriers: texture barrier handle "
+          "is invalid");
+    }
+    if (barrier.afterState == GraphicsBarrierState::Read) {
+      rawCommandBuffer->transitionToShaderReadOnly(
+          impl_->textures.getLvkHandle(textureHandle));
+    }
   }
+#endif
 
   return Result<bool, std::string>::makeResult(true);
 }
@@ -2083,18 +3085,9 @@ Result<bool, std::string> LvkGPUDevice::recordGraphicsBarriers(
 Result<bool, std::string>
 LvkGPUDevice::recordGraphicsPass(RecordingContextHandle ctx,
                                  const RenderPass &pass) {
-  lvk::ICommandBuffer *commandBuffer = nullptr;
-  {
-    std::lock_guard lock(impl_->graphicsContextMutex);
-    for (const auto &entry : impl_->activeGraphicsContexts) {
-      if (areSameHandle(entry.handle, ctx)) {
-        commandBuffer = entry.commandBuffer;
-        break;
-      }
-    }
-  }
-  if (commandBuffer != nullptr) {
-    return recordRenderPasses(*commandBuffer,
+  const GraphicsRecordingSlot *slot = impl_->findGraphicsRecordingSlot(ctx);
+  if (slot != nullptr) {
+    return recordRenderPasses(*slot->commandBuffer,
                               std::span<const RenderPass>(&pass, 1u));
   }
   return Result<bool, std::string>::makeError(
@@ -2103,80 +3096,63 @@ LvkGPUDevice::recordGraphicsPass(RecordingContextHandle ctx,
 
 Result<RecordedCommandBufferHandle, std::string>
 LvkGPUDevice::finishGraphicsRecordingContext(RecordingContextHandle ctx) {
-  std::lock_guard lock(impl_->graphicsContextMutex);
-  for (size_t i = 0u; i < impl_->activeGraphicsContexts.size(); ++i) {
-    if (!areSameHandle(impl_->activeGraphicsContexts[i].handle, ctx)) {
-      continue;
-    }
-
-    auto indexResult = allocateMonotonicHandleIndex(
-        impl_->nextRecordedCommandBufferIndex,
-        "LvkGPUDevice::finishGraphicsRecordingContext");
-    if (indexResult.hasError()) {
-      return Result<RecordedCommandBufferHandle, std::string>::makeError(
-          indexResult.error());
-    }
-
-    const uint32_t index = indexResult.value();
-    const RecordedCommandBufferHandle handle{
-        .index = index,
-        .generation = nextHandleGeneration(
-            impl_->recordedCommandBufferGenerations, index)};
-    impl_->recordedGraphicsCommandBuffers.push_back(
-        RecordedGraphicsCommandBuffer{
-            .handle = handle,
-            .commandBuffer = impl_->activeGraphicsContexts[i].commandBuffer,
-        });
-    impl_->activeGraphicsContexts.erase(impl_->activeGraphicsContexts.begin() +
-                                        i);
-    return Result<RecordedCommandBufferHandle, std::string>::makeResult(handle);
+  lvk::ICommandBuffer *commandBuffer = impl_->releaseGraphicsRecordingSlot(ctx);
+  if (commandBuffer == nullptr) {
+    return Result<RecordedCommandBufferHandle, std::string>::makeError(
+        "LvkGPUDevice::finishGraphicsRecordingContext: unknown recording "
+        "context");
+  }
+
+  std::lock_guard lock(impl_->recordedCommandBufferMutex);
+  uint32_t index = 0u;
+  if (!impl_->freeRecordedGraphicsCommandBuffers.empty()) {
+    index = impl_->freeRecordedGraphicsCommandBuffers.back();
+    impl_->freeRecordedGraphicsCommandBuffers.pop_back();
+  } else {
+    index = static_cast<uint32_t>(impl_->recordedGraphicsCommandBuffers.size());
+    impl_->recordedGraphicsCommandBuffers.emplace_back();
   }
-
-  return Result<RecordedCommandBufferHandle, std::string>::makeError(
-      "LvkGPUDevice::finishGraphicsRecordingContext: unknown recording "
-      "context");
+  RecordedGraphicsCommandBuffer &entry =
+      impl_->recordedGraphicsCommandBuffers[index];
+  entry.commandBuffer = commandBuffer;
+  ++entry.generation;
+  if (entry.generation == 0u) {
+    ++entry.generation;
+  }
+  return Result<RecordedCommandBufferHandle, std::string>::makeResult(
+      RecordedCommandBufferHandle{.index = index,
+                                  .generation = entry.generation});
 }
 
 Result<bool, std::string>
 LvkGPUDevice::discardGraphicsRecordingContext(RecordingContextHandle ctx) {
-  std::scoped_lock lock(impl_->contextImmediateMutex,
-                        impl_->graphicsContextMutex);
-  for (size_t i = 0u; i < impl_->activeGraphicsContexts.size(); ++i) {
-    if (!areSameHandle(impl_->activeGraphicsContexts[i].handle, ctx)) {
-      continue;
-    }
-
-    impl_->context->discard(*impl_->activeGraphicsContexts[i].commandBuffer);
-    impl_->activeGraphicsContexts.erase(impl_->activeGraphicsContexts.begin() +
-                                        i);
-    return Result<bool, std::string>::makeResult(true);
+  lvk::ICommandBuffer *commandBuffer = impl_->releaseGraphicsRecordingSlot(ctx);
+  if (commandBuffer == nullptr) {
+    return Result<bool, std::string>::makeError(
+        "LvkGPUDevice::discardGraphicsRecordingContext: unknown recording "
+        "context");
   }
-
-  return Result<bool, std::string>::makeError(
-      "LvkGPUDevice::discardGraphicsRecordingContext: unknown recording "
-      "context");
+  std::lock_guard lock(impl_->contextImmediateMutex);
+  impl_->context->discard(*commandBuffer);
+  return Result<bool, std::string>::makeResult(true);
 }
 
 Result<bool, std::string> LvkGPUDevice::discardRecordedGraphicsCommandBuffer(
     RecordedCommandBufferHandle commandBuffer) {
   std::scoped_lock lock(impl_->contextImmediateMutex,
-                        impl_->graphicsContextMutex);
-  for (size_t i = 0u; i < impl_->recordedGraphicsCommandBuffers.size(); ++i) {
-    if (!areSameHandle(impl_->recordedGraphicsCommandBuffers[i].handle,
-                       commandBuffer)) {
-      continue;
-    }
-
-    impl_->context->discard(
-        *impl_->recordedGraphicsCommandBuffers[i].commandBuffer);
-    impl_->recordedGraphicsCommandBuffers.erase(
-        impl_->recordedGraphicsCommandBuffers.begin() + i);
-    return Result<bool, std::string>::makeResult(true);
+                        impl_->recordedCommandBufferMutex);
+  RecordedGraphicsCommandBuffer *entry =
+      impl_->findRecordedCommandBuffer(commandBuffer);
+  if (entry == nullptr) {
+    return Result<bool, std::string>::makeError(
+        "LvkGPUDevice::discardRecordedGraphicsCommandBuffer: unknown command "
+        "buffer");
   }
 
-  return Result<bool, std::string>::makeError(
-      "LvkGPUDevice::discardRecordedGraphicsCommandBuffer: unknown command "
-      "buffer");
+  impl_->context->discard(*entry->commandBuffer);
+  entry->commandBuffer = nullptr;
+  impl_->freeRecordedGraphicsCommandBuffers.push_back(commandBuffer.index);
+  return Result<bool, std::string>::makeResult(true);
 }
 
 Result<SubmissionHandle, std::string> LvkGPUDevice::submitRecordedGraphicsFrame(
@@ -2188,7 +3164,7 @@ Result<SubmissionHandle, std::string> LvkGPUDevice::submitRecordedGraphicsFrame(
   }
 
   std::scoped_lock lock(impl_->contextImmediateMutex,
-                        impl_->graphicsContextMutex);
+                        impl_->recordedCommandBufferMutex);
   std::vector<uint8_t> presentFlags(commandBuffers.size(), 0u);
   for (const SubmitBatchMeta &batch : batches) {
     if (batch.commandBufferOffset > commandBuffers.size() ||
@@ -2215,16 +3191,7 @@ Result<SubmissionHandle, std::string> LvkGPUDevice::submitRecordedGraphicsFrame(
   }
 
   for (const RecordedCommandBufferHandle requestedHandle : commandBuffers) {
-    size_t foundIndex = impl_->recordedGraphicsCommandBuffers.size();
-    for (size_t j = 0u; j < impl_->recordedGraphicsCommandBuffers.size(); ++j) {
-      if (areSameHandle(impl_->recordedGraphicsCommandBuffers[j].handle,
-                        requestedHandle)) {
-        foundIndex = j;
-        break;
-      }
-    }
-
-    if (foundIndex == impl_->recordedGraphicsCommandBuffers.size()) {
+    if (impl_->findRecordedCommandBuffer(requestedHandle) == nullptr) {
       return Result<SubmissionHandle, std::string>::makeError(
           "LvkGPUDevice::submitRecordedGraphicsFrame: unknown recorded "
           "command buffer");
@@ -2233,28 +3200,20 @@ Result<SubmissionHandle, std::string> LvkGPUDevice::submitRecordedGraphicsFrame(
 
   lvk::SubmitHandle lastSubmitHandle{};
   for (uint32_t i = 0u; i < commandBuffers.size(); ++i) {
-    lvk::ICommandBuffer *commandBuffer = nullptr;
-    size_t foundIndex = impl_->recordedGraphicsCommandBuffers.size();
-    for (size_t j = 0u; j < impl_->recordedGraphicsCommandBuffers.size(); ++j) {
-      if (areSameHandle(impl_->recordedGraphicsCommandBuffers[j].handle,
-                        commandBuffers[i])) {
-        commandBuffer = impl_->recordedGraphicsCommandBuffers[j].commandBuffer;
-        foundIndex = j;
-        break;
-      }
-    }
-
-    if (commandBuffer == nullptr) {
+    RecordedGraphicsCommandBuffer *entry =
+        impl_->findRecordedCommandBuffer(commandBuffers[i]);
+    if (entry == nullptr) {
       return Result<SubmissionHandle, std::string>::makeError(
           "LvkGPUDevice::submitRecordedGraphicsFrame: unknown recorded "
           "command buffer");
     }
 
     lastSubmitHandle = impl_->context->submit(
-        *commandBuffer,
+        *entry->commandBuffer,
         presentFlags[i] != 0u ? swapchainTexture : lvk::TextureHandle{});
-    impl_->recordedGraphicsCommandBuffers.erase(
-        impl_->recordedGraphicsCommandBuffers.begin() + foundIndex);
+    entry->commandBuffer = nullptr;
+    impl_->freeRecordedGraphicsCommandBuffers.push_back(
+        commandBuffers[i].index);
   }
 
   if (wantsPresent) {
@@ -2378,6 +3337,7 @@ LvkGPUDevice::updateBuffer(BufferHandle buffer, std::span<const std::byte> data,
         "updateBuffer: offset + data.size() exceeds buffer size");
   }
 
+  PerfCounters::add(kUploadBytesCounter, data.size());
   if (uint8_t *mapped = impl_->context->getMappedPtr(lvkBuf)) {
     std::memcpy(mapped + offset, data.data(), data.size());
     impl_->context->flushMappedMemory(lvkBuf, offset, data.size());
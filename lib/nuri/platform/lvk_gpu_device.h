@@ -47,6 +47,11 @@ public:
   Result<ComputePipelineHandle, std::string>
   createComputePipeline(const ComputePipelineDesc &desc,
                         std::string_view debugName = {}) override;
+  bool supportsBackgroundPipelineCompilation() const override;
+  Result<std::unique_ptr<PipelineCompileJob>, std::string>
+  prepareRenderPipelineCompile(RenderPipelineHandle pipeline) override;
+  Result<bool, std::string>
+  finishRenderPipelineCompile(PipelineCompileJob &job) override;
 
   // Resource destruction
   void destroyRenderPipeline(RenderPipelineHandle pipeline) override;
@@ -99,6 +104,12 @@ public:
   allocateGeometry(std::span<const std::byte> vertexBytes, uint32_t vertexCount,
                    std::span<const std::byte> indexBytes, uint32_t indexCount,
                    std::string_view debugName = {}) override;
+  bool supportsEncodedGeometry() const override;
+  Result<GeometryAllocationHandle, std::string>
+  allocateEncodedGeometry(const EncodedVertexStream &vertices,
+                          std::span<const std::byte> indexBytes,
+                          uint32_t indexCount,
+                          std::string_view debugName = {}) override;
   void releaseGeometry(GeometryAllocationHandle h) override;
   Result<bool, std::string>
   copyBufferRegions(std::span<const BufferCopyRegion> regions) override;
@@ -124,6 +135,7 @@ private:
   [[nodiscard]] Result<bool, std::string>
   recordRenderPasses(lvk::ICommandBuffer &commandBuffer,
                      std::span<const RenderPass> passes);
+  void releaseDeferredShaderModules();
   struct Impl;
   std::unique_ptr<Impl> impl_;
 };
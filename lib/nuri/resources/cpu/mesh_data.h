@@ -19,6 +19,20 @@ struct SubmeshLod {
   float error = 0.0f;
 };
 
+// Node of a submesh's cluster LOD hierarchy. bounds (xyz center, w radius)
+// and error describe the group the cluster was simplified from, parentBounds
+// and parentError the coarser group built over it. Clusters produced by one
+// group share those values, so a cluster is drawn exactly when its own error
+// is acceptable and its parent's is not, and any such cut is crack-free.
+struct MeshCluster {
+  uint32_t indexOffset = 0;
+  uint32_t indexCount = 0;
+  float error = 0.0f;
+  float parentError = std::numeric_limits<float>::max();
+  glm::vec4 bounds{0.0f};
+  glm::vec4 parentBounds{0.0f};
+};
+
 struct Submesh {
   static constexpr uint32_t kMaxLodCount = 4;
 
@@ -28,17 +42,21 @@ struct Submesh {
   BoundingBox bounds{glm::vec3(0.0f), glm::vec3(0.0f)};
   uint32_t lodCount = 1;
   std::array<SubmeshLod, kMaxLodCount> lods{};
+  // Range in MeshData::clusters; empty without a cluster hierarchy.
+  uint32_t clusterOffset = 0;
+  uint32_t clusterCount = 0;
 };
 
 struct MeshData {
   std::pmr::vector<Vertex> vertices;
   std::pmr::vector<uint32_t> indices;
   std::pmr::vector<Submesh> submeshes;
+  std::pmr::vector<MeshCluster> clusters;
   std::pmr::string name;
 
   explicit MeshData(
       std::pmr::memory_resource *mem = std::pmr::get_default_resource())
-      : vertices(mem), indices(mem), submeshes(mem), name(mem) {}
+      : vertices(mem), indices(mem), submeshes(mem), clusters(mem), name(mem) {}
 };
 
 } // namespace nuri
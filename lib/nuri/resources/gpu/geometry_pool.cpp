@@ -2,8 +2,10 @@
 
 #include "nuri/resources/gpu/geometry_pool.h"
 
+#include "nuri/core/log.h"
 #include "nuri/gfx/gpu_descriptors.h"
 #include "nuri/gfx/gpu_device.h"
+#include "nuri/resources/gpu/geometry_vertex_decoder.h"
 
 namespace nuri {
 namespace {
@@ -15,6 +17,66 @@ struct PoolSourceRef {
   size_t size = 0;
 };
 
+constexpr uint64_t kContentHashSeed = 0x9e3779b97f4a7c15ull;
+constexpr uint64_t kContentHashMultiplier = 0xff51afd7ed558ccdull;
+// Seed and multiplier of the independent check hash.
+constexpr uint64_t kContentCheckSeed = 0x2545f4914f6cdd1dull;
+constexpr uint64_t kContentCheckMultiplier = 0xc4ceb9fe1a85ec53ull;
+// Keeps encoded streams from sharing entries with raw bytes that happen to
+// match them.
+constexpr uint64_t kEncodedContentTag = 0x656e636f64656476ull;
+
+uint64_t mixContentWord(uint64_t hash, uint64_t word,
+                        uint64_t seed = kContentHashSeed,
+                        uint64_t multiplier = kContentHashMultiplier) {
+  hash ^= word + seed + (hash << 6u) + (hash >> 2u);
+  hash *= multiplier;
+  return hash ^ (hash >> 29u);
+}
+
+// Word-at-a-time so hashing large meshes stays cheap next to the upload.
+// Both hashes are advanced in the same pass over the bytes.
+void hashStream(uint64_t &hash, uint64_t &check,
+                std::span<const std::byte> bytes) {
+  const auto mix = [&](uint64_t word) {
+    hash = mixContentWord(hash, word);
+    check = mixContentWord(check, word, kContentCheckSeed,
+                           kContentCheckMultiplier);
+  };
+  mix(bytes.size());
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= bytes.size();
+       offset += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes.data() + offset, sizeof(word));
+    mix(word);
+  }
+  if (offset < bytes.size()) {
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes.data() + offset, bytes.size() - offset);
+    mix(tail);
+  }
+}
+
+// Visits the byte ranges that identify an allocation's content. Encoded
+// streams also contribute their layout, since it changes the decoded result.
+template <typename Fn>
+void forEachContentRange(std::span<const std::byte> vertexBytes,
+                         const EncodedVertexStream *encoded,
+                         std::span<const std::byte> indexBytes, Fn &&fn) {
+  if (encoded == nullptr) {
+    fn(vertexBytes);
+  } else {
+    const std::array<uint32_t, 5> layout = {
+        encoded->vertexCount, encoded->vertexStrideBytes,
+        encoded->blockVertexCount, encoded->blockCount, encoded->tailOffset};
+    fn(std::as_bytes(std::span(layout)));
+    fn(std::as_bytes(encoded->channelOffsets));
+    fn(encoded->encodedBytes);
+  }
+  fn(indexBytes);
+}
+
 } // namespace
 
 GeometryPool::GeometryPool(GPUDevice &gpu, GeometryPoolConfig config,
@@ -22,7 +84,7 @@ GeometryPool::GeometryPool(GPUDevice &gpu, GeometryPoolConfig config,
     : gpu_(gpu), config_(config), memory_(ensureMemory(memory)),
       vertexChunks_(memory_), indexChunks_(memory_), allocations_(memory_),
       freeAllocationIndices_(memory_), retiredVertexChunks_(memory_),
-      retiredIndexChunks_(memory_) {}
+      retiredIndexChunks_(memory_), contentToAllocation_(memory_) {}
 
 GeometryPool::~GeometryPool() {
   for (const Chunk &chunk : vertexChunks_) {
@@ -224,6 +286,7 @@ void GeometryPool::reclaimRetiredAllocations() {
 
     freeInPool(vertexChunks_, entry.vertex);
     freeInPool(indexChunks_, entry.index);
+    unregisterContent(entry, index);
 
     entry.state = AllocationEntry::State::Dead;
     entry.vertex = {};
@@ -503,6 +566,149 @@ Result<bool, std::string> GeometryPool::compactIfNeeded() {
   return Result<bool, std::string>::makeResult(true);
 }
 
+GeometryPool::ContentKey
+GeometryPool::hashContent(const VertexSource &vertices,
+                          std::span<const std::byte> indexBytes) {
+  ContentKey key{.hash = kContentHashSeed, .check = kContentCheckSeed};
+  forEachContentRange(vertices.bytes, vertices.encoded, indexBytes,
+                      [&key](std::span<const std::byte> range) {
+                        hashStream(key.hash, key.check, range);
+                        key.sizeBytes += range.size();
+                      });
+  if (vertices.encoded != nullptr) {
+    key.hash = mixContentWord(key.hash, kEncodedContentTag);
+  }
+  return key;
+}
+
+std::optional<GeometryAllocationHandle>
+GeometryPool::acquireExisting(const ContentKey &contentKey,
+                              const VertexSource &vertices,
+                              size_t vertexByteSize, uint32_t vertexCount,
+                              std::span<const std::byte> indexBytes,
+                              uint32_t indexCount) {
+  const auto it = contentToAllocation_.find(contentKey.hash);
+  if (it == contentToAllocation_.end() || it->second >= allocations_.size()) {
+    return std::nullopt;
+  }
+  AllocationEntry &entry = allocations_[it->second];
+  if (entry.state == AllocationEntry::State::Dead ||
+      entry.contentCheck != contentKey.check ||
+      entry.contentBytes != contentKey.sizeBytes ||
+      entry.encodedContent != (vertices.encoded != nullptr) ||
+      entry.vertex.size != vertexByteSize ||
+      entry.index.size != indexBytes.size() ||
+      entry.vertexCount != vertexCount || entry.indexCount != indexCount ||
+      !confirmResidentContent(entry, vertices, indexBytes)) {
+    return std::nullopt;
+  }
+
+  if (entry.state == AllocationEntry::State::PendingFree) {
+    // Still resident, so a reload within the reclaim window skips the upload.
+    // Handles released earlier stay dead.
+    entry.generation += 1;
+    if (entry.generation == 0) {
+      entry.generation = 1;
+    }
+    entry.state = AllocationEntry::State::Live;
+    entry.retireFrame = 0;
+    entry.refCount = 1;
+    bumpMutationVersion();
+  } else {
+    ++entry.refCount;
+    ++sharedReferences_;
+  }
+  dedupedBytes_ += vertexByteSize + indexBytes.size();
+  return GeometryAllocationHandle{
+      .index = it->second,
+      .generation = entry.generation,
+  };
+}
+
+void GeometryPool::unregisterContent(AllocationEntry &entry,
+                                     uint32_t allocationIndex) {
+  if (!entry.registered) {
+    return;
+  }
+  const auto it = contentToAllocation_.find(entry.contentHash);
+  if (it != contentToAllocation_.end() && it->second == allocationIndex) {
+    contentToAllocation_.erase(it);
+  }
+  entry.registered = false;
+  entry.contentHash = 0;
+  entry.contentCheck = 0;
+  entry.contentBytes = 0;
+}
+
+// Reads the candidate's resident bytes back and compares them with the new
+// source, so nothing beyond the key is kept per entry. This only runs on a
+// full key match. Encoded entries hold decoded vertices with no CPU copy to
+// compare against, so only their indices are read back and their vertex
+// stream rests on the key.
+bool GeometryPool::confirmResidentContent(
+    const AllocationEntry &entry, const VertexSource &vertices,
+    std::span<const std::byte> indexBytes) {
+  const size_t vertexBytes =
+      vertices.encoded == nullptr ? entry.vertex.size : 0u;
+  const size_t totalBytes = vertexBytes + entry.index.size;
+  auto staging = gpu_.createBuffer(
+      BufferDesc{.usage = BufferUsage::Storage,
+                 .storage = Storage::HostVisible,
+                 .size = totalBytes},
+      "geometry_pool_dedup_readback");
+  if (staging.hasError()) {
+    NURI_LOG_DEBUG("GeometryPool::allocate: dedup readback unavailable: %s",
+                   staging.error().c_str());
+    return false;
+  }
+
+  const std::array<BufferCopyRegion, 2> regions = {
+      BufferCopyRegion{
+          .srcBuffer = indexChunks_[entry.index.chunkIndex].buffer,
+          .dstBuffer = staging.value(),
+          .srcOffset = entry.index.offset,
+          .dstOffset = vertexBytes,
+          .size = entry.index.size},
+      BufferCopyRegion{
+          .srcBuffer = vertexChunks_[entry.vertex.chunkIndex].buffer,
+          .dstBuffer = staging.value(),
+          .srcOffset = entry.vertex.offset,
+          .dstOffset = 0u,
+          .size = vertexBytes},
+  };
+  // Zero-sized copies are invalid, so the vertex region is dropped when only
+  // indices are compared.
+  const size_t regionCount = vertexBytes == 0u ? 1u : 2u;
+  std::pmr::vector<std::byte> resident(totalBytes, memory_);
+  const bool readBack =
+      !gpu_.copyBufferRegions(std::span(regions).first(regionCount))
+           .hasError() &&
+      !gpu_.readBuffer(staging.value(), 0u, resident).hasError();
+  gpu_.destroyBuffer(staging.value());
+  if (!readBack) {
+    return false;
+  }
+  const bool verticesMatch =
+      vertexBytes == 0u ||
+      std::memcmp(resident.data(), vertices.bytes.data(), vertexBytes) == 0;
+  return verticesMatch &&
+         std::memcmp(resident.data() + vertexBytes, indexBytes.data(),
+                     indexBytes.size()) == 0;
+}
+
+GeometryPoolStats GeometryPool::stats() const noexcept {
+  GeometryPoolStats result{
+      .sharedReferences = sharedReferences_,
+      .dedupedBytes = dedupedBytes_,
+  };
+  for (const AllocationEntry &entry : allocations_) {
+    if (entry.state == AllocationEntry::State::Live) {
+      ++result.liveAllocations;
+    }
+  }
+  return result;
+}
+
 bool GeometryPool::isHandleLive(GeometryAllocationHandle handle) const {
   if (!nuri::isValid(handle) || handle.index >= allocations_.size()) {
     return false;
@@ -541,8 +747,76 @@ GeometryPool::allocate(std::span<const std::byte> vertexBytes,
         "GeometryPool::allocate: index data is empty");
   }
 
+  const VertexSource source{.bytes = vertexBytes};
+  const ContentKey contentKey = config_.enableContentDeduplication
+                                    ? hashContent(source, indexBytes)
+                                    : ContentKey{};
+  return allocateEntry(source, vertexBytes.size(), vertexCount, indexBytes,
+                       indexCount, contentKey, debugName);
+}
+
+Result<GeometryAllocationHandle, std::string>
+GeometryPool::allocateEncoded(const EncodedVertexStream &vertices,
+                              std::span<const std::byte> indexBytes,
+                              uint32_t indexCount, std::string_view debugName) {
+  if (!config_.enableGpuVertexDecode) {
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "GeometryPool::allocateEncoded: GPU vertex decode is disabled");
+  }
+  if (vertices.encodedBytes.empty() || vertices.vertexCount == 0) {
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "GeometryPool::allocateEncoded: vertex data is empty");
+  }
+  if (indexBytes.empty()) {
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "GeometryPool::allocateEncoded: index data is empty");
+  }
+
+  const size_t vertexByteSize =
+      static_cast<size_t>(vertices.vertexCount) * vertices.vertexStrideBytes;
+  const VertexSource source{.encoded = &vertices};
+  const ContentKey contentKey = config_.enableContentDeduplication
+                                    ? hashContent(source, indexBytes)
+                                    : ContentKey{};
+  return allocateEntry(source, vertexByteSize, vertices.vertexCount,
+                       indexBytes, indexCount, contentKey, debugName);
+}
+
+Result<bool, std::string>
+GeometryPool::writeVertices(const VertexSource &vertices,
+                            const SubAllocation &allocation) {
+  const BufferHandle buffer = vertexChunks_[allocation.chunkIndex].buffer;
+  if (vertices.encoded == nullptr) {
+    return gpu_.updateBuffer(buffer, vertices.bytes, allocation.offset);
+  }
+  if (!vertexDecoder_) {
+    vertexDecoder_ = std::make_unique<GeometryVertexDecoder>(gpu_);
+  }
+  return vertexDecoder_->decode(*vertices.encoded, buffer, allocation.offset);
+}
+
+Result<GeometryAllocationHandle, std::string>
+GeometryPool::allocateEntry(const VertexSource &vertices,
+                            size_t vertexByteSize, uint32_t vertexCount,
+                            std::span<const std::byte> indexBytes,
+                            uint32_t indexCount,
+                            const ContentKey &contentKey,
+                            std::string_view debugName) {
+  if (config_.enableContentDeduplication) {
+    if (const auto existing =
+            acquireExisting(contentKey, vertices, vertexByteSize,
+                            vertexCount, indexBytes, indexCount)) {
+      NURI_LOG_DEBUG("GeometryPool::allocate: '%.*s' shares geometry with "
+                     "'%s'",
+                     static_cast<int>(debugName.size()), debugName.data(),
+                     allocations_[existing->index].debugName.c_str());
+      return Result<GeometryAllocationHandle, std::string>::makeResult(
+          *existing);
+    }
+  }
+
   auto vertexAllocResult = allocateFromPool(
-      vertexChunks_, vertexBytes.size(), kVertexAlignment,
+      vertexChunks_, vertexByteSize, kVertexAlignment,
       config_.vertexChunkSizeBytes, BufferUsage::Storage, "geometry_pool_vb");
   if (vertexAllocResult.hasError()) {
     return Result<GeometryAllocationHandle, std::string>::makeError(
@@ -560,9 +834,7 @@ GeometryPool::allocate(std::span<const std::byte> vertexBytes,
   }
   const SubAllocation indexAllocation = indexAllocResult.value();
 
-  auto uploadVertices =
-      gpu_.updateBuffer(vertexChunks_[vertexAllocation.chunkIndex].buffer,
-                        vertexBytes, vertexAllocation.offset);
+  auto uploadVertices = writeVertices(vertices, vertexAllocation);
   if (uploadVertices.hasError()) {
     freeInPool(vertexChunks_, vertexAllocation);
     freeInPool(indexChunks_, indexAllocation);
@@ -599,8 +871,20 @@ GeometryPool::allocate(std::span<const std::byte> vertexBytes,
   entry.index = indexAllocation;
   entry.vertexCount = vertexCount;
   entry.indexCount = indexCount;
+  entry.refCount = 1;
   entry.retireFrame = 0;
   entry.debugName.assign(debugName.data(), debugName.size());
+  // A hash collision keeps the older entry registered; the new one is simply
+  // never shared.
+  if (config_.enableContentDeduplication &&
+      contentToAllocation_.try_emplace(contentKey.hash, allocationIndex)
+          .second) {
+    entry.contentHash = contentKey.hash;
+    entry.contentCheck = contentKey.check;
+    entry.contentBytes = contentKey.sizeBytes;
+    entry.encodedContent = vertices.encoded != nullptr;
+    entry.registered = true;
+  }
   bumpMutationVersion();
 
   return Result<GeometryAllocationHandle, std::string>::makeResult(
@@ -616,6 +900,12 @@ void GeometryPool::release(GeometryAllocationHandle handle) {
   }
 
   AllocationEntry &entry = allocations_[handle.index];
+  if (entry.refCount > 1u) {
+    --entry.refCount;
+    --sharedReferences_;
+    return;
+  }
+  entry.refCount = 0;
   entry.state = AllocationEntry::State::PendingFree;
   entry.retireFrame = currentFrameIndex_;
   bumpMutationVersion();
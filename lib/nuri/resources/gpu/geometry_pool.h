@@ -7,15 +7,27 @@
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <memory_resource>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace nuri {
+class GeometryVertexDecoder;
+
+struct GeometryPoolStats {
+  uint32_t liveAllocations = 0;
+  // Handles handed out beyond the first for deduplicated content.
+  uint32_t sharedReferences = 0;
+  // Vertex and index bytes that were not uploaded thanks to deduplication.
+  uint64_t dedupedBytes = 0;
+};
 
-class GeometryPool final {
+class NURI_API GeometryPool final {
 public:
   explicit GeometryPool(
       GPUDevice &gpu, GeometryPoolConfig config = {},
@@ -32,12 +44,22 @@ public:
   allocate(std::span<const std::byte> vertexBytes, uint32_t vertexCount,
            std::span<const std::byte> indexBytes, uint32_t indexCount,
            std::string_view debugName);
+  [[nodiscard]] bool supportsEncodedVertices() const noexcept {
+    return config_.enableGpuVertexDecode;
+  }
+  // Vertices are decoded on the GPU into the pool; indices are uploaded as is.
+  [[nodiscard]] Result<GeometryAllocationHandle, std::string>
+  allocateEncoded(const EncodedVertexStream &vertices,
+                  std::span<const std::byte> indexBytes, uint32_t indexCount,
+                  std::string_view debugName);
+  // Drops one reference; the allocation retires once none are left.
   void release(GeometryAllocationHandle handle);
   [[nodiscard]] bool resolve(GeometryAllocationHandle handle,
                              GeometryAllocationView &out) const;
   [[nodiscard]] uint64_t mutationVersion() const noexcept {
     return mutationVersion_;
   }
+  [[nodiscard]] GeometryPoolStats stats() const noexcept;
 
 private:
   static constexpr uint32_t kInvalidChunkIndex = UINT32_MAX;
@@ -79,6 +101,12 @@ private:
     SubAllocation index{};
     uint32_t vertexCount = 0;
     uint32_t indexCount = 0;
+    uint32_t refCount = 0;
+    uint64_t contentHash = 0;
+    uint64_t contentCheck = 0;
+    uint64_t contentBytes = 0;
+    bool encodedContent = false;
+    bool registered = false;
     uint64_t retireFrame = 0;
     std::pmr::string debugName;
 
@@ -114,6 +142,30 @@ private:
 
   [[nodiscard]] static size_t alignUp(size_t value, size_t alignment);
 
+  // Either raw vertex bytes or a stream decoded by the vertex decoder.
+  struct VertexSource {
+    std::span<const std::byte> bytes{};
+    const EncodedVertexStream *encoded = nullptr;
+  };
+
+  // Two independent 64-bit hashes plus the hashed byte count. `hash` keys
+  // the lookup table; the rest must also match before a candidate is read
+  // back for the final comparison.
+  struct ContentKey {
+    uint64_t hash = 0;
+    uint64_t check = 0;
+    uint64_t sizeBytes = 0;
+  };
+
+  [[nodiscard]] Result<GeometryAllocationHandle, std::string>
+  allocateEntry(const VertexSource &vertices, size_t vertexByteSize,
+                uint32_t vertexCount, std::span<const std::byte> indexBytes,
+                uint32_t indexCount, const ContentKey &contentKey,
+                std::string_view debugName);
+  [[nodiscard]] Result<bool, std::string>
+  writeVertices(const VertexSource &vertices,
+                const SubAllocation &allocation);
+
   [[nodiscard]] Result<bool, std::string>
   createChunk(std::pmr::vector<Chunk> &chunks, size_t minimumSize,
               BufferUsage usage, std::string_view debugPrefix);
@@ -138,6 +190,19 @@ private:
                       PoolCompactionPlan &plan);
   [[nodiscard]] Result<bool, std::string> compactIfNeeded();
 
+  [[nodiscard]] static ContentKey
+  hashContent(const VertexSource &vertices,
+              std::span<const std::byte> indexBytes);
+  [[nodiscard]] std::optional<GeometryAllocationHandle>
+  acquireExisting(const ContentKey &contentKey, const VertexSource &vertices,
+                  size_t vertexByteSize, uint32_t vertexCount,
+                  std::span<const std::byte> indexBytes, uint32_t indexCount);
+  [[nodiscard]] bool
+  confirmResidentContent(const AllocationEntry &entry,
+                         const VertexSource &vertices,
+                         std::span<const std::byte> indexBytes);
+  void unregisterContent(AllocationEntry &entry, uint32_t allocationIndex);
+
   [[nodiscard]] bool isHandleLive(GeometryAllocationHandle handle) const;
   void bumpMutationVersion() noexcept;
 
@@ -153,6 +218,10 @@ private:
   std::pmr::vector<uint32_t> freeAllocationIndices_;
   std::pmr::deque<RetiredChunk> retiredVertexChunks_;
   std::pmr::deque<RetiredChunk> retiredIndexChunks_;
+  std::pmr::unordered_map<uint64_t, uint32_t> contentToAllocation_;
+  std::unique_ptr<GeometryVertexDecoder> vertexDecoder_;
+  uint32_t sharedReferences_ = 0;
+  uint64_t dedupedBytes_ = 0;
   uint64_t mutationVersion_ = 1;
 };
 
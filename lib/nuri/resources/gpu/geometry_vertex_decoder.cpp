@@ -0,0 +1,429 @@
+#include "nuri/pch.h"
+
+#include "nuri/resources/gpu/geometry_vertex_decoder.h"
+
+#include "nuri/core/profiling.h"
+#include "nuri/gfx/gpu_descriptors.h"
+#include "nuri/gfx/gpu_render_types.h"
+
+namespace nuri {
+namespace {
+
+constexpr std::string_view kVertexDecodeCS = R"(
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+layout(local_size_x = 64) in;
+
+layout(std430, buffer_reference) readonly buffer ReadWords {
+  uint words[];
+};
+
+layout(std430, buffer_reference) buffer Words {
+  uint words[];
+};
+
+layout(push_constant) uniform PushConstants {
+  ReadWords encoded;
+  ReadWords channelOffsets;
+  Words vertices;
+  Words carries;
+  uint pass;
+  uint vertexCount;
+  uint wordsPerVertex;
+  uint blockVertexCount;
+  uint blockCount;
+  uint tailOffset;
+} pc;
+
+uint readByte(uint offset) {
+  return (pc.encoded.words[offset >> 2u] >> ((offset & 3u) * 8u)) & 0xffu;
+}
+
+// Adds four packed bytes lane by lane with 8-bit wraparound.
+uint addBytes(uint a, uint b) {
+  return ((a & 0x7f7f7f7fu) + (b & 0x7f7f7f7fu)) ^ ((a ^ b) & 0x80808080u);
+}
+
+uint unzigzag(uint value) {
+  return ((value >> 1u) ^ (0u - (value & 1u))) & 0xffu;
+}
+
+void decodeGroup(uint header, uint group, inout uint cursor,
+                 out uint deltas[16]) {
+  uint bitsLog2 = (readByte(header + group / 4u) >> ((group % 4u) * 2u)) & 3u;
+  if (bitsLog2 == 0u) {
+    for (uint i = 0u; i < 16u; ++i) {
+      deltas[i] = 0u;
+    }
+    return;
+  }
+  if (bitsLog2 == 3u) {
+    for (uint i = 0u; i < 16u; ++i) {
+      deltas[i] = readByte(cursor + i);
+    }
+    cursor += 16u;
+    return;
+  }
+
+  uint bits = 1u << bitsLog2;
+  uint perByte = 8u / bits;
+  uint sentinel = (1u << bits) - 1u;
+  uint extra = cursor + 2u * bits;
+  for (uint i = 0u; i < 16u; ++i) {
+    uint shift = 8u - bits * (i % perByte + 1u);
+    uint value = (readByte(cursor + i / perByte) >> shift) & sentinel;
+    if (value == sentinel) {
+      value = readByte(extra);
+      extra += 1u;
+    }
+    deltas[i] = value;
+  }
+  cursor = extra;
+}
+
+// One invocation per block and vertex word; the four byte channels of the
+// word are decoded together so every store is a full word.
+void decodeBlock(uint id) {
+  if (id >= pc.blockCount * pc.wordsPerVertex) {
+    return;
+  }
+  uint block = id / pc.wordsPerVertex;
+  uint word = id % pc.wordsPerVertex;
+  uint firstVertex = block * pc.blockVertexCount;
+  uint count = min(pc.blockVertexCount, pc.vertexCount - firstVertex);
+  uint groupCount = (count + 15u) / 16u;
+  uint headerSize = (groupCount + 3u) / 4u;
+  uint channelBase = block * pc.wordsPerVertex * 4u + word * 4u;
+
+  uint headers[4];
+  uint cursors[4];
+  for (uint c = 0u; c < 4u; ++c) {
+    headers[c] = pc.channelOffsets.words[channelBase + c];
+    cursors[c] = headers[c] + headerSize;
+  }
+
+  uint sum = 0u;
+  for (uint group = 0u; group < groupCount; ++group) {
+    uint lanes[16];
+    for (uint i = 0u; i < 16u; ++i) {
+      lanes[i] = 0u;
+    }
+    for (uint c = 0u; c < 4u; ++c) {
+      uint deltas[16];
+      decodeGroup(headers[c], group, cursors[c], deltas);
+      for (uint i = 0u; i < 16u; ++i) {
+        lanes[i] |= unzigzag(deltas[i]) << (c * 8u);
+      }
+    }
+    uint groupVertices = min(16u, count - group * 16u);
+    for (uint i = 0u; i < groupVertices; ++i) {
+      sum = addBytes(sum, lanes[i]);
+      uint vertex = firstVertex + group * 16u + i;
+      pc.vertices.words[vertex * pc.wordsPerVertex + word] = sum;
+    }
+  }
+  pc.carries.words[id] = sum;
+}
+
+void scanCarries(uint word) {
+  if (word >= pc.wordsPerVertex) {
+    return;
+  }
+  uint base = pc.tailOffset + word * 4u;
+  uint carry = readByte(base) | (readByte(base + 1u) << 8u) |
+               (readByte(base + 2u) << 16u) | (readByte(base + 3u) << 24u);
+  for (uint block = 0u; block < pc.blockCount; ++block) {
+    uint index = block * pc.wordsPerVertex + word;
+    uint total = pc.carries.words[index];
+    pc.carries.words[index] = carry;
+    carry = addBytes(carry, total);
+  }
+}
+
+void applyCarries(uint id) {
+  if (id >= pc.vertexCount * pc.wordsPerVertex) {
+    return;
+  }
+  uint block = (id / pc.wordsPerVertex) / pc.blockVertexCount;
+  uint word = id % pc.wordsPerVertex;
+  pc.vertices.words[id] =
+      addBytes(pc.vertices.words[id],
+               pc.carries.words[block * pc.wordsPerVertex + word]);
+}
+
+void main() {
+  uint id = gl_GlobalInvocationID.y * gl_NumWorkGroups.x *
+                gl_WorkGroupSize.x + gl_GlobalInvocationID.x;
+  if (pc.pass == 0u) {
+    decodeBlock(id);
+  } else if (pc.pass == 1u) {
+    scanCarries(id);
+  } else {
+    applyCarries(id);
+  }
+}
+)";
+
+constexpr uint32_t kDecodeLocalSize = 64u;
+constexpr uint32_t kMaxDispatchGroupsX = 65535u;
+constexpr size_t kMinBufferBytes = 64u * 1024u;
+constexpr size_t kUploadOffsetAlignment = 8u;
+
+enum class DecodePass : uint32_t {
+  DecodeBlocks = 0,
+  ScanCarries = 1,
+  ApplyCarries = 2,
+};
+
+struct VertexDecodePushConstants {
+  uint64_t encodedAddress = 0;
+  uint64_t channelOffsetsAddress = 0;
+  uint64_t verticesAddress = 0;
+  uint64_t carriesAddress = 0;
+  uint32_t pass = 0;
+  uint32_t vertexCount = 0;
+  uint32_t wordsPerVertex = 0;
+  uint32_t blockVertexCount = 0;
+  uint32_t blockCount = 0;
+  uint32_t tailOffset = 0;
+};
+static_assert(sizeof(VertexDecodePushConstants) <= 128,
+              "VertexDecodePushConstants exceeds Vulkan minimum guarantee");
+
+DispatchSize dispatchSizeFor(uint64_t invocations) {
+  const uint64_t groups =
+      (invocations + kDecodeLocalSize - 1u) / kDecodeLocalSize;
+  const uint64_t x = std::min<uint64_t>(groups, kMaxDispatchGroupsX);
+  return DispatchSize{
+      .x = static_cast<uint32_t>(std::max<uint64_t>(x, 1u)),
+      .y = static_cast<uint32_t>(std::max<uint64_t>((groups + x - 1u) / x, 1u)),
+      .z = 1u,
+  };
+}
+
+Result<bool, std::string> validateStream(const EncodedVertexStream &stream) {
+  const auto makeError = [](std::string_view message) {
+    return Result<bool, std::string>::makeError(
+        "GeometryVertexDecoder::decode: " + std::string(message));
+  };
+  if (stream.vertexCount == 0 || stream.encodedBytes.empty()) {
+    return makeError("vertex stream is empty");
+  }
+  if (stream.vertexStrideBytes == 0 ||
+      (stream.vertexStrideBytes % sizeof(uint32_t)) != 0u) {
+    return makeError("vertex stride must be a multiple of 4");
+  }
+  if (stream.blockVertexCount == 0 ||
+      stream.blockCount != (stream.vertexCount + stream.blockVertexCount - 1u) /
+                               stream.blockVertexCount) {
+    return makeError("block layout does not match the vertex count");
+  }
+  if (stream.channelOffsets.size() !=
+      static_cast<size_t>(stream.blockCount) * stream.vertexStrideBytes) {
+    return makeError("channel offset table size is invalid");
+  }
+  if (static_cast<size_t>(stream.tailOffset) + stream.vertexStrideBytes >
+      stream.encodedBytes.size()) {
+    return makeError("tail offset is out of range");
+  }
+  const uint64_t words = static_cast<uint64_t>(stream.vertexCount) *
+                         (stream.vertexStrideBytes / sizeof(uint32_t));
+  if (words > std::numeric_limits<uint32_t>::max()) {
+    return makeError("vertex stream is too large");
+  }
+  return Result<bool, std::string>::makeResult(true);
+}
+
+} // namespace
+
+GeometryVertexDecoder::GeometryVertexDecoder(GPUDevice &gpu) : gpu_(gpu) {}
+
+GeometryVertexDecoder::~GeometryVertexDecoder() {
+  if (nuri::isValid(pipeline_)) {
+    gpu_.destroyComputePipeline(pipeline_);
+  }
+  if (nuri::isValid(shader_)) {
+    gpu_.destroyShaderModule(shader_);
+  }
+  if (nuri::isValid(uploadBuffer_)) {
+    gpu_.destroyBuffer(uploadBuffer_);
+  }
+  if (nuri::isValid(carryBuffer_)) {
+    gpu_.destroyBuffer(carryBuffer_);
+  }
+}
+
+Result<bool, std::string> GeometryVertexDecoder::ensurePipeline() {
+  if (nuri::isValid(pipeline_)) {
+    return Result<bool, std::string>::makeResult(true);
+  }
+  if (!nuri::isValid(shader_)) {
+    auto shaderResult = gpu_.createShaderModule(ShaderDesc{
+        .moduleName = "geometry_vertex_decode",
+        .source = kVertexDecodeCS,
+        .stage = ShaderStage::Compute,
+    });
+    if (shaderResult.hasError()) {
+      return Result<bool, std::string>::makeError(
+          "GeometryVertexDecoder: shader creation failed: " +
+          shaderResult.error());
+    }
+    shader_ = shaderResult.value();
+  }
+  auto pipelineResult = gpu_.createComputePipeline(
+      ComputePipelineDesc{.computeShader = shader_}, "geometry_vertex_decode");
+  if (pipelineResult.hasError()) {
+    return Result<bool, std::string>::makeError(
+        "GeometryVertexDecoder: compute pipeline creation failed: " +
+        pipelineResult.error());
+  }
+  pipeline_ = pipelineResult.value();
+  return Result<bool, std::string>::makeResult(true);
+}
+
+Result<bool, std::string>
+GeometryVertexDecoder::ensureBuffer(BufferHandle &buffer, size_t &capacity,
+                                    size_t requiredBytes, Storage storage,
+                                    std::string_view debugName) {
+  if (nuri::isValid(buffer) && capacity >= requiredBytes) {
+    return Result<bool, std::string>::makeResult(true);
+  }
+  if (nuri::isValid(buffer)) {
+    gpu_.destroyBuffer(buffer);
+    buffer = BufferHandle{};
+    capacity = 0;
+  }
+
+  const size_t newSize =
+      std::max({requiredBytes, capacity * 2, kMinBufferBytes});
+  auto bufferResult = gpu_.createBuffer(
+      BufferDesc{
+          .usage = BufferUsage::Storage,
+          .storage = storage,
+          .size = newSize,
+      },
+      debugName);
+  if (bufferResult.hasError()) {
+    return Result<bool, std::string>::makeError(bufferResult.error());
+  }
+  buffer = bufferResult.value();
+  capacity = newSize;
+  return Result<bool, std::string>::makeResult(true);
+}
+
+Result<bool, std::string>
+GeometryVertexDecoder::writeUpload(size_t offset,
+                                   std::span<const std::byte> bytes) {
+  if (std::byte *mapped = gpu_.getMappedBufferPtr(uploadBuffer_)) {
+    std::memcpy(mapped + offset, bytes.data(), bytes.size());
+    gpu_.flushMappedBuffer(uploadBuffer_, offset, bytes.size());
+    return Result<bool, std::string>::makeResult(true);
+  }
+  return gpu_.updateBuffer(uploadBuffer_, bytes, offset);
+}
+
+Result<bool, std::string>
+GeometryVertexDecoder::decode(const EncodedVertexStream &stream,
+                              BufferHandle dstBuffer, size_t dstOffset) {
+  NURI_PROFILER_FUNCTION();
+  auto validResult = validateStream(stream);
+  if (validResult.hasError()) {
+    return validResult;
+  }
+  auto pipelineResult = ensurePipeline();
+  if (pipelineResult.hasError()) {
+    return pipelineResult;
+  }
+
+  // Byte reads fetch whole words, so the stream is padded to a word and the
+  // offset table placed at an address-aligned offset behind it.
+  const size_t offsetsOffset =
+      (stream.encodedBytes.size() + kUploadOffsetAlignment - 1u) &
+      ~(kUploadOffsetAlignment - 1u);
+  const std::span<const std::byte> offsetBytes =
+      std::as_bytes(stream.channelOffsets);
+  auto uploadResult = ensureBuffer(
+      uploadBuffer_, uploadCapacity_, offsetsOffset + offsetBytes.size(),
+      Storage::HostVisible, "geometry_vertex_decode_upload");
+  if (uploadResult.hasError()) {
+    return uploadResult;
+  }
+  const uint32_t wordsPerVertex =
+      stream.vertexStrideBytes / static_cast<uint32_t>(sizeof(uint32_t));
+  const size_t carryBytes = static_cast<size_t>(stream.blockCount) *
+                            wordsPerVertex * sizeof(uint32_t);
+  auto carryResult =
+      ensureBuffer(carryBuffer_, carryCapacity_, carryBytes, Storage::Device,
+                   "geometry_vertex_decode_carries");
+  if (carryResult.hasError()) {
+    return carryResult;
+  }
+
+  auto writeStream = writeUpload(0u, stream.encodedBytes);
+  if (writeStream.hasError()) {
+    return writeStream;
+  }
+  const std::array<std::byte, kUploadOffsetAlignment> padding{};
+  const size_t paddingBytes = offsetsOffset - stream.encodedBytes.size();
+  if (paddingBytes > 0u) {
+    auto writePadding = writeUpload(
+        stream.encodedBytes.size(),
+        std::span<const std::byte>(padding.data(), paddingBytes));
+    if (writePadding.hasError()) {
+      return writePadding;
+    }
+  }
+  auto writeOffsets = writeUpload(offsetsOffset, offsetBytes);
+  if (writeOffsets.hasError()) {
+    return writeOffsets;
+  }
+
+  VertexDecodePushConstants pushConstants{
+      .encodedAddress = gpu_.getBufferDeviceAddress(uploadBuffer_),
+      .channelOffsetsAddress =
+          gpu_.getBufferDeviceAddress(uploadBuffer_, offsetsOffset),
+      .verticesAddress = gpu_.getBufferDeviceAddress(dstBuffer, dstOffset),
+      .carriesAddress = gpu_.getBufferDeviceAddress(carryBuffer_),
+      .vertexCount = stream.vertexCount,
+      .wordsPerVertex = wordsPerVertex,
+      .blockVertexCount = stream.blockVertexCount,
+      .blockCount = stream.blockCount,
+      .tailOffset = stream.tailOffset,
+  };
+  if (pushConstants.encodedAddress == 0 ||
+      pushConstants.channelOffsetsAddress == 0 ||
+      pushConstants.verticesAddress == 0 ||
+      pushConstants.carriesAddress == 0) {
+    return Result<bool, std::string>::makeError(
+        "GeometryVertexDecoder::decode: buffer address is invalid");
+  }
+
+  std::array<VertexDecodePushConstants, 3> passConstants{};
+  passConstants.fill(pushConstants);
+  passConstants[0].pass = static_cast<uint32_t>(DecodePass::DecodeBlocks);
+  passConstants[1].pass = static_cast<uint32_t>(DecodePass::ScanCarries);
+  passConstants[2].pass = static_cast<uint32_t>(DecodePass::ApplyCarries);
+  const std::array<uint64_t, 3> passInvocations = {
+      static_cast<uint64_t>(stream.blockCount) * wordsPerVertex,
+      wordsPerVertex,
+      static_cast<uint64_t>(stream.vertexCount) * wordsPerVertex,
+  };
+  const std::array<BufferHandle, 3> dependencies = {uploadBuffer_,
+                                                    carryBuffer_, dstBuffer};
+
+  std::array<ComputeDispatchItem, 3> dispatches{};
+  for (size_t i = 0; i < dispatches.size(); ++i) {
+    dispatches[i] = ComputeDispatchItem{
+        .pipeline = pipeline_,
+        .dispatch = dispatchSizeFor(passInvocations[i]),
+        .pushConstants = std::as_bytes(std::span(&passConstants[i], 1u)),
+        .dependencyBuffers = dependencies,
+        .debugLabel = "Geometry Vertex Decode",
+        .debugColor = 0xff60a0ffu,
+    };
+  }
+  return gpu_.submitComputeDispatches(dispatches);
+}
+
+} // namespace nuri
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/gfx/gpu_device.h"
+#include "nuri/gfx/gpu_types.h"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace nuri {
+
+// Decodes meshopt v0 vertex streams on the GPU: one pass decodes every block
+// relative to zero, a second turns the block totals into carries seeded with
+// the stream's first vertex, and a third adds them back. decode() waits for
+// the dispatches, so the upload and scratch buffers are reused across calls.
+class NURI_API GeometryVertexDecoder final {
+public:
+  explicit GeometryVertexDecoder(GPUDevice &gpu);
+  ~GeometryVertexDecoder();
+
+  GeometryVertexDecoder(const GeometryVertexDecoder &) = delete;
+  GeometryVertexDecoder &operator=(const GeometryVertexDecoder &) = delete;
+  GeometryVertexDecoder(GeometryVertexDecoder &&) = delete;
+  GeometryVertexDecoder &operator=(GeometryVertexDecoder &&) = delete;
+
+  // Writes vertexCount * vertexStrideBytes bytes at dstOffset, which must be
+  // 8-byte aligned.
+  [[nodiscard]] Result<bool, std::string>
+  decode(const EncodedVertexStream &stream, BufferHandle dstBuffer,
+         size_t dstOffset);
+
+private:
+  [[nodiscard]] Result<bool, std::string> ensurePipeline();
+  [[nodiscard]] Result<bool, std::string>
+  ensureBuffer(BufferHandle &buffer, size_t &capacity, size_t requiredBytes,
+               Storage storage, std::string_view debugName);
+  [[nodiscard]] Result<bool, std::string>
+  writeUpload(size_t offset, std::span<const std::byte> bytes);
+
+  GPUDevice &gpu_;
+  ShaderHandle shader_{};
+  ComputePipelineHandle pipeline_{};
+  // Encoded stream followed by the channel offset table.
+  BufferHandle uploadBuffer_{};
+  size_t uploadCapacity_ = 0;
+  // Per block and vertex word: block total, then carry.
+  BufferHandle carryBuffer_{};
+  size_t carryCapacity_ = 0;
+};
+
+} // namespace nuri
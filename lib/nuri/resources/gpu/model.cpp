@@ -7,6 +7,7 @@
 #include "nuri/core/profiling.h"
 #include "nuri/gfx/gpu_device.h"
 #include "nuri/resources/mesh_importer.h"
+#include "nuri/resources/storage/mesh/mesh_binary_codec.h"
 #include "nuri/resources/storage/mesh/mesh_binary_format.h"
 #include "nuri/resources/storage/mesh/mesh_binary_serializer.h"
 #include "nuri/resources/storage/mesh/mesh_cache_utils.h"
@@ -29,6 +30,12 @@ struct PackedVertexWords {
 
 static_assert(sizeof(PackedVertexWords) == 36);
 
+// Occluders are rasterized on the CPU every frame, so only meshes whose
+// coarsest LODs stay small are kept.
+constexpr size_t kMaxOccluderTriangles = 2048;
+constexpr uint32_t kUnmappedOccluderVertex =
+    std::numeric_limits<uint32_t>::max();
+
 uint16_t packSnorm16(float value) {
   const float clamped = std::clamp(value, -1.0f, 1.0f);
   const int32_t quantized =
@@ -130,6 +137,7 @@ packVerticesToByteBuffer(std::span<const Vertex> vertices) {
 Result<bool, std::string>
 validateMeshTopology(std::span<const uint32_t> indices, uint32_t vertexCount,
                      std::span<const Submesh> submeshes,
+                     std::span<const MeshCluster> clusters,
                      std::string_view context) {
   const std::string contextString(context);
   if (vertexCount == 0) {
@@ -176,6 +184,24 @@ validateMeshTopology(std::span<const uint32_t> indices, uint32_t vertexCount,
             " index range exceeds index buffer");
       }
     }
+    const uint64_t clusterEnd =
+        static_cast<uint64_t>(submesh.clusterOffset) + submesh.clusterCount;
+    if (clusterEnd > clusters.size()) {
+      return Result<bool, std::string>::makeError(
+          contextString + ": submesh " + std::to_string(submeshIndex) +
+          " cluster range exceeds cluster list");
+    }
+  }
+  for (size_t clusterIndex = 0; clusterIndex < clusters.size();
+       ++clusterIndex) {
+    const MeshCluster &cluster = clusters[clusterIndex];
+    const uint64_t end =
+        static_cast<uint64_t>(cluster.indexOffset) + cluster.indexCount;
+    if (end > indices.size()) {
+      return Result<bool, std::string>::makeError(
+          contextString + ": cluster " + std::to_string(clusterIndex) +
+          " index range exceeds index buffer");
+    }
   }
 
   NURI_LOG_DEBUG("%s: mesh validated (vertices=%u indices=%zu submeshes=%zu "
@@ -185,6 +211,14 @@ validateMeshTopology(std::span<const uint32_t> indices, uint32_t vertexCount,
   return Result<bool, std::string>::makeResult(true);
 }
 
+size_t occluderTriangleCount(std::span<const Submesh> submeshes) {
+  size_t triangleCount = 0;
+  for (const Submesh &submesh : submeshes) {
+    triangleCount += submesh.lods[submesh.lodCount - 1u].indexCount / 3u;
+  }
+  return triangleCount;
+}
+
 bool isMeshCacheReadEnabled() {
   std::optional<std::string> envValueStorage;
 #if defined(_WIN32)
@@ -219,6 +253,7 @@ void maybeQueueMeshCacheWrite(const MeshCacheKey &cacheKey,
                               uint32_t vertexCount,
                               std::span<const uint32_t> indices,
                               std::span<const Submesh> submeshes,
+                              std::span<const MeshCluster> clusters,
                               const BoundingBox &bounds) {
   if (packedVertexBytes.empty() || indices.empty()) {
     return;
@@ -238,6 +273,7 @@ void maybeQueueMeshCacheWrite(const MeshCacheKey &cacheKey,
   input.vertexStrideBytes = kMeshBinaryPackedVertexStrideBytes;
   input.indices = indices;
   input.submeshes = submeshes;
+  input.clusters = clusters;
 
   auto serializeResult = meshBinarySerialize(input);
   if (serializeResult.hasError()) {
@@ -255,7 +291,8 @@ void maybeQueueMeshCacheWrite(const MeshCacheKey &cacheKey,
 
 std::optional<MeshBinaryDecodedMesh>
 tryLoadMeshCache(std::string_view sourcePath, const MeshCacheKey &cacheKey,
-                 const MeshImportOptions &options) {
+                 const MeshImportOptions &options,
+                 bool keepEncodedVertices = false) {
   std::error_code ec;
   const bool cacheExists =
       std::filesystem::exists(cacheKey.cachePath, ec) && !ec &&
@@ -281,6 +318,7 @@ tryLoadMeshCache(std::string_view sourcePath, const MeshCacheKey &cacheKey,
   context.sourceExists = sourceFingerprint.exists;
   context.sourceSizeBytes = sourceFingerprint.sizeBytes;
   context.sourceMtimeNs = sourceFingerprint.mtimeNs;
+  context.keepEncodedVertices = keepEncodedVertices;
 
   auto decodeResult = meshBinaryDeserialize(cacheReadResult.value(), context);
   if (decodeResult.hasError()) {
@@ -304,6 +342,8 @@ tryLoadMeshCache(std::string_view sourcePath, const MeshCacheKey &cacheKey,
       decodedMesh.vertexCount,
       std::span<const Submesh>(decodedMesh.submeshes.data(),
                                decodedMesh.submeshes.size()),
+      std::span<const MeshCluster>(decodedMesh.clusters.data(),
+                                   decodedMesh.clusters.size()),
       "Model::createFromFile cache validation");
   if (topologyValidation.hasError()) {
     NURI_LOG_WARNING("Model::createFromFile: Rejected mesh cache '%s': %s",
@@ -317,6 +357,68 @@ tryLoadMeshCache(std::string_view sourcePath, const MeshCacheKey &cacheKey,
   return decodedMesh;
 }
 
+// Meshes small enough to become occluders need CPU positions and a failed GPU
+// decode falls back to the CPU, so only the remaining encoded streams are
+// decoded on the GPU.
+Result<GeometryAllocationHandle, std::string>
+allocateCachedGeometry(GPUDevice &gpu, MeshBinaryDecodedMesh &mesh,
+                       std::string_view debugName) {
+  if (mesh.vertexStrideBytes != sizeof(PackedVertexWords)) {
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "cache vertex stride mismatch (expected=" +
+        std::to_string(sizeof(PackedVertexWords)) +
+        " actual=" + std::to_string(mesh.vertexStrideBytes) + ")");
+  }
+  const std::span<const std::byte> indexBytes{
+      reinterpret_cast<const std::byte *>(mesh.indices.data()),
+      mesh.indices.size() * sizeof(uint32_t)};
+  const uint32_t indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+  if (!mesh.encodedVertexBytes.empty()) {
+    const size_t triangleCount = occluderTriangleCount(mesh.submeshes);
+    if (triangleCount == 0 || triangleCount > kMaxOccluderTriangles) {
+      const MeshBinaryVertexDecodePlan &plan = mesh.vertexDecodePlan;
+      const EncodedVertexStream stream{
+          .encodedBytes = mesh.encodedVertexBytes,
+          .channelOffsets = plan.channelOffsets,
+          .vertexCount = mesh.vertexCount,
+          .vertexStrideBytes = mesh.vertexStrideBytes,
+          .blockVertexCount = plan.blockVertexCount,
+          .blockCount = plan.blockCount,
+          .tailOffset = plan.tailOffset,
+      };
+      auto encodedResult = gpu.allocateEncodedGeometry(stream, indexBytes,
+                                                       indexCount, debugName);
+      if (!encodedResult.hasError()) {
+        return encodedResult;
+      }
+      NURI_LOG_WARNING("Model::createFromFile: GPU vertex decode failed for "
+                       "'%.*s', decoding on the CPU: %s",
+                       static_cast<int>(debugName.size()), debugName.data(),
+                       encodedResult.error().c_str());
+    }
+    auto decodeResult = meshBinaryDecodeVertexBuffer(
+        mesh.encodedVertexBytes, mesh.vertexCount, mesh.vertexStrideBytes);
+    if (decodeResult.hasError()) {
+      return Result<GeometryAllocationHandle, std::string>::makeError(
+          decodeResult.error());
+    }
+    mesh.packedVertexBytes = std::move(decodeResult.value());
+    mesh.encodedVertexBytes.clear();
+  }
+
+  const size_t expectedPackedByteCount =
+      static_cast<size_t>(mesh.vertexCount) * sizeof(PackedVertexWords);
+  if (mesh.packedVertexBytes.size() != expectedPackedByteCount) {
+    return Result<GeometryAllocationHandle, std::string>::makeError(
+        "cache vertex byte count mismatch (expected=" +
+        std::to_string(expectedPackedByteCount) +
+        " actual=" + std::to_string(mesh.packedVertexBytes.size()) + ")");
+  }
+  return gpu.allocateGeometry(mesh.packedVertexBytes, mesh.vertexCount,
+                              indexBytes, indexCount, debugName);
+}
+
 } // namespace
 
 bool ModelAsyncLoad::valid() const noexcept {
@@ -465,6 +567,41 @@ void Model::setMaterialIndexForAllSources(uint32_t materialIndex) noexcept {
   }
 }
 
+void Model::buildOccluder(std::span<const std::byte> packedVertexBytes,
+                          std::span<const uint32_t> indices) {
+  occluderPositions_.clear();
+  occluderIndices_.clear();
+  const size_t triangleCount = occluderTriangleCount(submeshes_);
+  if (triangleCount == 0 || triangleCount > kMaxOccluderTriangles) {
+    return;
+  }
+
+  ScratchArena scratch;
+  ScopedScratch scopedScratch(scratch);
+  std::pmr::vector<uint32_t> remap(vertexCount_, kUnmappedOccluderVertex,
+                                   scopedScratch.resource());
+  occluderIndices_.reserve(triangleCount * 3u);
+  for (const Submesh &submesh : submeshes_) {
+    // Topology was validated on creation, so the ranges are in bounds.
+    const SubmeshLod &range = submesh.lods[submesh.lodCount - 1u];
+    const uint32_t indexCount = range.indexCount / 3u * 3u;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+      const uint32_t vertex = indices[range.indexOffset + i];
+      uint32_t &mapped = remap[vertex];
+      if (mapped == kUnmappedOccluderVertex) {
+        glm::vec3 position{};
+        std::memcpy(&position,
+                    packedVertexBytes.data() +
+                        static_cast<size_t>(vertex) * sizeof(PackedVertexWords),
+                    sizeof(position));
+        mapped = static_cast<uint32_t>(occluderPositions_.size());
+        occluderPositions_.push_back(position);
+      }
+      occluderIndices_.push_back(mapped);
+    }
+  }
+}
+
 Result<std::unique_ptr<Model>, std::string>
 Model::create(GPUDevice &gpu, const MeshData &data,
               std::string_view debugName) {
@@ -493,6 +630,7 @@ Model::createFromPackedVertices(GPUDevice &gpu, const MeshData &data,
       std::span<const uint32_t>(data.indices.data(), data.indices.size()),
       static_cast<uint32_t>(data.vertices.size()),
       std::span<const Submesh>(data.submeshes.data(), data.submeshes.size()),
+      std::span<const MeshCluster>(data.clusters.data(), data.clusters.size()),
       "Model::createFromPackedVertices");
   if (topologyValidation.hasError()) {
     return Result<std::unique_ptr<Model>, std::string>::makeError(
@@ -516,6 +654,9 @@ Model::createFromPackedVertices(GPUDevice &gpu, const MeshData &data,
 
   std::pmr::vector<Submesh> ownedSubmeshes(storageMemory);
   ownedSubmeshes.assign(data.submeshes.begin(), data.submeshes.end());
+  std::pmr::vector<MeshCluster> ownedClusters(data.clusters.begin(),
+                                              data.clusters.end(),
+                                              storageMemory);
   auto sourceMaterialCountResult = computeSourceMaterialCount(
       std::span<const Submesh>(ownedSubmeshes.data(), ownedSubmeshes.size()));
   if (sourceMaterialCountResult.hasError()) {
@@ -525,12 +666,15 @@ Model::createFromPackedVertices(GPUDevice &gpu, const MeshData &data,
   std::pmr::vector<uint32_t> sourceMaterialToRuntime(
       sourceMaterialCountResult.value(), Model::kInvalidMaterialIndex,
       storageMemory);
+  std::unique_ptr<Model> model(
+      new Model(gpu, geometryResult.value(), std::move(ownedSubmeshes),
+                std::move(ownedClusters),
+                static_cast<uint32_t>(data.vertices.size()),
+                static_cast<uint32_t>(data.indices.size()), bounds,
+                std::move(sourceMaterialToRuntime)));
+  model->buildOccluder(packedVertexBytes, data.indices);
   return Result<std::unique_ptr<Model>, std::string>::makeResult(
-      std::unique_ptr<Model>(
-          new Model(gpu, geometryResult.value(), std::move(ownedSubmeshes),
-                    static_cast<uint32_t>(data.vertices.size()),
-                    static_cast<uint32_t>(data.indices.size()), bounds,
-                    std::move(sourceMaterialToRuntime))));
+      std::move(model));
 }
 
 Result<std::unique_ptr<Model>, std::string> Model::createFromFile(
@@ -550,54 +694,45 @@ Result<std::unique_ptr<Model>, std::string> Model::createFromFile(
         cacheKeyResult.error().c_str());
   } else if (isMeshCacheReadEnabled()) {
     const MeshCacheKey &cacheKey = cacheKeyResult.value();
-    if (auto cachedMesh = tryLoadMeshCache(path, cacheKey, options);
+    if (auto cachedMesh = tryLoadMeshCache(path, cacheKey, options,
+                                           gpu.supportsEncodedGeometry());
         cachedMesh.has_value()) {
-      const size_t expectedPackedByteCount =
-          static_cast<size_t>(cachedMesh->vertexCount) *
-          sizeof(PackedVertexWords);
-      if (cachedMesh->packedVertexBytes.size() != expectedPackedByteCount) {
-        NURI_LOG_WARNING(
-            "Model::createFromFile: Cache vertex byte count mismatch for '%s' "
-            "(expected=%zu actual=%zu), rebuilding from source",
-            cacheKey.cachePath.string().c_str(), expectedPackedByteCount,
-            cachedMesh->packedVertexBytes.size());
-      } else {
-        const std::span<const std::byte> vertexBytes{
-            cachedMesh->packedVertexBytes.data(),
-            cachedMesh->packedVertexBytes.size()};
-        const std::span<const std::byte> indexBytes{
-            reinterpret_cast<const std::byte *>(cachedMesh->indices.data()),
-            cachedMesh->indices.size() * sizeof(uint32_t)};
-        auto geometryResult = gpu.allocateGeometry(
-            vertexBytes, cachedMesh->vertexCount, indexBytes,
-            static_cast<uint32_t>(cachedMesh->indices.size()), debugName);
-        if (!geometryResult.hasError()) {
-          std::pmr::vector<Submesh> ownedSubmeshes(storageMemory);
-          ownedSubmeshes.assign(cachedMesh->submeshes.begin(),
-                                cachedMesh->submeshes.end());
-          auto sourceMaterialCountResult =
-              computeSourceMaterialCount(std::span<const Submesh>(
-                  ownedSubmeshes.data(), ownedSubmeshes.size()));
-          if (sourceMaterialCountResult.hasError()) {
-            return Result<std::unique_ptr<Model>, std::string>::makeError(
-                sourceMaterialCountResult.error());
-          }
-          std::pmr::vector<uint32_t> sourceMaterialToRuntime(
-              sourceMaterialCountResult.value(), Model::kInvalidMaterialIndex,
-              storageMemory);
-          return Result<std::unique_ptr<Model>, std::string>::makeResult(
-              std::unique_ptr<Model>(new Model(
-                  gpu, geometryResult.value(), std::move(ownedSubmeshes),
-                  cachedMesh->vertexCount,
-                  static_cast<uint32_t>(cachedMesh->indices.size()),
-                  cachedMesh->bounds, std::move(sourceMaterialToRuntime))));
+      auto geometryResult =
+          allocateCachedGeometry(gpu, *cachedMesh, debugName);
+      if (!geometryResult.hasError()) {
+        std::pmr::vector<Submesh> ownedSubmeshes(storageMemory);
+        ownedSubmeshes.assign(cachedMesh->submeshes.begin(),
+                              cachedMesh->submeshes.end());
+        std::pmr::vector<MeshCluster> ownedClusters(
+            cachedMesh->clusters.begin(), cachedMesh->clusters.end(),
+            storageMemory);
+        auto sourceMaterialCountResult =
+            computeSourceMaterialCount(std::span<const Submesh>(
+                ownedSubmeshes.data(), ownedSubmeshes.size()));
+        if (sourceMaterialCountResult.hasError()) {
+          return Result<std::unique_ptr<Model>, std::string>::makeError(
+              sourceMaterialCountResult.error());
         }
-        NURI_LOG_WARNING(
-            "Model::createFromFile: Failed to create model from cache '%s': "
-            "%s",
-            cacheKey.cachePath.string().c_str(),
-            geometryResult.error().c_str());
+        std::pmr::vector<uint32_t> sourceMaterialToRuntime(
+            sourceMaterialCountResult.value(), Model::kInvalidMaterialIndex,
+            storageMemory);
+        std::unique_ptr<Model> model(new Model(
+            gpu, geometryResult.value(), std::move(ownedSubmeshes),
+            std::move(ownedClusters), cachedMesh->vertexCount,
+            static_cast<uint32_t>(cachedMesh->indices.size()),
+            cachedMesh->bounds, std::move(sourceMaterialToRuntime)));
+        // GPU-decoded meshes have no CPU positions and are never occluders.
+        if (!cachedMesh->packedVertexBytes.empty()) {
+          model->buildOccluder(cachedMesh->packedVertexBytes,
+                               cachedMesh->indices);
+        }
+        return Result<std::unique_ptr<Model>, std::string>::makeResult(
+            std::move(model));
       }
+      NURI_LOG_WARNING(
+          "Model::createFromFile: Failed to create model from cache '%s': "
+          "%s, rebuilding from source",
+          cacheKey.cachePath.string().c_str(), geometryResult.error().c_str());
     }
   } else {
     NURI_LOG_DEBUG("Model::createFromFile: Mesh cache read disabled for '%.*s'",
@@ -644,6 +779,8 @@ Result<std::unique_ptr<Model>, std::string> Model::createFromFile(
                                   meshData.indices.size()),
         std::span<const Submesh>(meshData.submeshes.data(),
                                  meshData.submeshes.size()),
+        std::span<const MeshCluster>(meshData.clusters.data(),
+                                     meshData.clusters.size()),
         modelResult.value()->bounds());
   }
 
@@ -739,6 +876,9 @@ Result<bool, std::string> Model::warmFileCache(std::string_view path,
                            static_cast<uint32_t>(meshData.vertices.size()),
                            std::span<const Submesh>(meshData.submeshes.data(),
                                                     meshData.submeshes.size()),
+                           std::span<const MeshCluster>(
+                               meshData.clusters.data(),
+                               meshData.clusters.size()),
                            "Model::warmFileCache");
   if (topologyValidation.hasError()) {
     return Result<bool, std::string>::makeError(topologyValidation.error());
@@ -767,6 +907,8 @@ Result<bool, std::string> Model::warmFileCache(std::string_view path,
                                             meshData.indices.size());
   input.submeshes = std::span<const Submesh>(meshData.submeshes.data(),
                                              meshData.submeshes.size());
+  input.clusters = std::span<const MeshCluster>(meshData.clusters.data(),
+                                                meshData.clusters.size());
 
   auto serializeResult = meshBinarySerialize(input);
   if (serializeResult.hasError()) {
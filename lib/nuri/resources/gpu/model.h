@@ -100,15 +100,35 @@ public:
   createFromFileAsync(std::string_view path,
                       const MeshImportOptions &options = {});
 
+  // CPU-only path that ensures an up-to-date mesh cache file exists, so a
+  // later createFromFile() only reads the cache. Safe to call from any thread.
+  // Returns true when a valid cache was already present, false when rebuilt.
+  [[nodiscard]] static Result<bool, std::string> warmFileCache(
+      std::string_view path, const MeshImportOptions &options = {},
+      // Used for transient import allocations during warmup only.
+      std::pmr::memory_resource *mem = std::pmr::get_default_resource());
+
   [[nodiscard]] GeometryAllocationHandle geometryHandle() const noexcept {
     return geometry_;
   }
   [[nodiscard]] std::span<const Submesh> submeshes() const noexcept {
     return submeshes_;
   }
+  // Cluster LOD hierarchies, indexed by Submesh::clusterOffset/clusterCount.
+  [[nodiscard]] std::span<const MeshCluster> clusters() const noexcept {
+    return clusters_;
+  }
   [[nodiscard]] uint32_t vertexCount() const noexcept { return vertexCount_; }
   [[nodiscard]] uint32_t indexCount() const noexcept { return indexCount_; }
   [[nodiscard]] const BoundingBox &bounds() const noexcept { return bounds_; }
+  // Coarsest LOD of every submesh as a compact triangle list for CPU
+  // occlusion. Empty when that is still too dense to rasterize cheaply.
+  [[nodiscard]] std::span<const glm::vec3> occluderPositions() const noexcept {
+    return occluderPositions_;
+  }
+  [[nodiscard]] std::span<const uint32_t> occluderIndices() const noexcept {
+    return occluderIndices_;
+  }
   [[nodiscard]] uint32_t sourceMaterialCount() const noexcept {
     return static_cast<uint32_t>(sourceMaterialToRuntime_.size());
   }
@@ -126,28 +146,29 @@ private:
                            std::span<const std::byte> packedVertexBytes,
                            std::string_view debugName);
 
-  // CPU-only path that ensures an up-to-date mesh cache file exists.
-  // Returns true when a valid cache was already present, false when rebuilt.
-  [[nodiscard]] static Result<bool, std::string> warmFileCache(
-      std::string_view path, const MeshImportOptions &options = {},
-      // Used for transient import allocations during warmup only.
-      std::pmr::memory_resource *mem = std::pmr::get_default_resource());
+  void buildOccluder(std::span<const std::byte> packedVertexBytes,
+                     std::span<const uint32_t> indices);
 
   Model(GPUDevice &gpu, GeometryAllocationHandle geometry,
-        std::pmr::vector<Submesh> submeshes, uint32_t vertexCount,
+        std::pmr::vector<Submesh> submeshes,
+        std::pmr::vector<MeshCluster> clusters, uint32_t vertexCount,
         uint32_t indexCount, BoundingBox bounds,
         std::pmr::vector<uint32_t> sourceMaterialToRuntime)
       : gpu_(&gpu), geometry_(geometry), submeshes_(std::move(submeshes)),
-        vertexCount_(vertexCount), indexCount_(indexCount), bounds_(bounds),
+        clusters_(std::move(clusters)), vertexCount_(vertexCount),
+        indexCount_(indexCount), bounds_(bounds),
         sourceMaterialToRuntime_(std::move(sourceMaterialToRuntime)) {}
 
   GPUDevice *gpu_ = nullptr;
   GeometryAllocationHandle geometry_{};
   std::pmr::vector<Submesh> submeshes_;
+  std::pmr::vector<MeshCluster> clusters_;
   uint32_t vertexCount_ = 0;
   uint32_t indexCount_ = 0;
   BoundingBox bounds_{};
   std::pmr::vector<uint32_t> sourceMaterialToRuntime_;
+  std::pmr::vector<glm::vec3> occluderPositions_;
+  std::pmr::vector<uint32_t> occluderIndices_;
 };
 
 using Mesh = Model;
@@ -3,6 +3,7 @@
 #include "nuri/resources/gpu/resource_manager.h"
 
 #include "nuri/core/log.h"
+#include "nuri/core/perf_counters.h"
 #include "nuri/core/profiling.h"
 #include "nuri/resources/mesh_importer.h"
 
@@ -10,6 +11,9 @@ namespace nuri {
 
 namespace {
 
+const PerfCounterId kStaleLookupsCounter =
+    PerfCounters::registerCounter("resources.stale_lookups");
+
 template <typename SlotT, typename RefT>
 [[nodiscard]] bool isSlotLiveForRef(const std::pmr::vector<SlotT> &slots,
                                     RefT ref) {
@@ -278,6 +282,42 @@ void ResourceManager::destroyModelSlot(uint32_t index) {
 
 Result<TextureRef, std::string>
 ResourceManager::acquireTexture(const TextureRequest &request) {
+  return acquireTextureImpl(request, nullptr);
+}
+
+Result<TextureRef, std::string>
+ResourceManager::acquireTexture(const TextureRequest &request,
+                                TexturePayload payload) {
+  return acquireTextureImpl(request, &payload);
+}
+
+Result<TexturePayload, std::string>
+ResourceManager::decodeTexture(const TextureRequest &request) {
+  if (request.path.empty()) {
+    return Result<TexturePayload, std::string>::makeError(
+        "ResourceManager::decodeTexture: path is empty");
+  }
+
+  const std::string canonicalPath = canonicalizeResourcePath(request.path);
+  switch (request.kind) {
+  case TextureRequestKind::Texture2D:
+    return Texture::decodeTexture(canonicalPath, request.loadOptions,
+                                  request.debugName);
+  case TextureRequestKind::Ktx2Texture2D:
+    return Texture::decodeTextureKtx2(canonicalPath, request.debugName);
+  case TextureRequestKind::Ktx2Cubemap:
+    return Texture::decodeCubemapKtx2(canonicalPath, request.debugName);
+  case TextureRequestKind::EquirectHdrCubemap:
+    return Texture::decodeCubemapFromEquirectangularHDR(canonicalPath,
+                                                        request.debugName);
+  }
+  return Result<TexturePayload, std::string>::makeError(
+      "ResourceManager::decodeTexture: unknown texture request kind");
+}
+
+Result<TextureRef, std::string>
+ResourceManager::acquireTextureImpl(const TextureRequest &request,
+                                    TexturePayload *payload) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
   if (request.path.empty()) {
     return Result<TextureRef, std::string>::makeError(
@@ -302,28 +342,16 @@ ResourceManager::acquireTexture(const TextureRequest &request) {
   }
   ++telemetry_.textureAcquireMisses;
 
-  Result<std::unique_ptr<Texture>, std::string> textureResult =
-      Result<std::unique_ptr<Texture>, std::string>::makeError(
-          "ResourceManager::acquireTexture: uninitialized result");
-
-  switch (request.kind) {
-  case TextureRequestKind::Texture2D:
-    textureResult = Texture::loadTexture(
-        gpu_, canonicalPath, request.loadOptions, request.debugName);
-    break;
-  case TextureRequestKind::Ktx2Texture2D:
-    textureResult =
-        Texture::loadTextureKtx2(gpu_, canonicalPath, request.debugName);
-    break;
-  case TextureRequestKind::Ktx2Cubemap:
-    textureResult =
-        Texture::loadCubemapKtx2(gpu_, canonicalPath, request.debugName);
-    break;
-  case TextureRequestKind::EquirectHdrCubemap:
-    textureResult = Texture::loadCubemapFromEquirectangularHDR(
-        gpu_, canonicalPath, request.debugName);
-    break;
+  TexturePayload decoded{};
+  if (payload == nullptr) {
+    auto decodeResult = decodeTexture(request);
+    if (decodeResult.hasError()) {
+      return Result<TextureRef, std::string>::makeError(decodeResult.error());
+    }
+    decoded = std::move(decodeResult.value());
+    payload = &decoded;
   }
+  auto textureResult = Texture::createFromPayload(gpu_, std::move(*payload));
 
   if (textureResult.hasError()) {
     return Result<TextureRef, std::string>::makeError(textureResult.error());
@@ -1023,6 +1051,7 @@ const TextureRecord *ResourceManager::tryGet(TextureRef ref) const {
   const TextureSlot *slot = tryGetSlot(ref);
   if (slot == nullptr) {
     ++telemetry_.staleTextureLookups;
+    PerfCounters::add(kStaleLookupsCounter);
   }
   return slot != nullptr ? &slot->record : nullptr;
 }
@@ -1035,6 +1064,7 @@ const ModelRecord *ResourceManager::tryGet(ModelRef ref) const {
   const ModelSlot *slot = tryGetSlot(ref);
   if (slot == nullptr) {
     ++telemetry_.staleModelLookups;
+    PerfCounters::add(kStaleLookupsCounter);
   }
   return slot != nullptr ? &slot->record : nullptr;
 }
@@ -1047,6 +1077,7 @@ const MaterialRecord *ResourceManager::tryGet(MaterialRef ref) const {
   const MaterialSlot *slot = tryGetSlot(ref);
   if (slot == nullptr) {
     ++telemetry_.staleMaterialLookups;
+    PerfCounters::add(kStaleLookupsCounter);
   }
   return slot != nullptr ? &slot->record : nullptr;
 }
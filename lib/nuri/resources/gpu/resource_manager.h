@@ -165,6 +165,14 @@ public:
 
   [[nodiscard]] Result<TextureRef, std::string>
   acquireTexture(const TextureRequest &request);
+  // `payload` must come from decodeTexture(request); it is dropped on a cache
+  // hit.
+  [[nodiscard]] Result<TextureRef, std::string>
+  acquireTexture(const TextureRequest &request, TexturePayload payload);
+  // CPU-only part of a texture acquire. Does not touch the manager, so it can
+  // run on worker threads while the GPU thread does other work.
+  [[nodiscard]] static Result<TexturePayload, std::string>
+  decodeTexture(const TextureRequest &request);
   [[nodiscard]] Result<ModelRef, std::string>
   acquireModel(const ModelRequest &request);
   [[nodiscard]] Result<MaterialRef, std::string>
@@ -248,6 +256,8 @@ private:
   };
 
   [[nodiscard]] uint64_t retireLagFrames() const;
+  [[nodiscard]] Result<TextureRef, std::string>
+  acquireTextureImpl(const TextureRequest &request, TexturePayload *payload);
   [[nodiscard]] TextureRef makeTextureRefForSlot(uint32_t index) const;
   [[nodiscard]] MaterialRef makeMaterialRefForSlot(uint32_t index) const;
   [[nodiscard]] ModelRef makeModelRefForSlot(uint32_t index) const;
@@ -5,6 +5,7 @@
 #include "nuri/core/log.h"
 #include "nuri/core/profiling.h"
 #include "nuri/resources/cpu/bitmap.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
 
 #include <ktx.h>
 #include <stb_image.h>
@@ -22,12 +23,6 @@ namespace {
   return mipCount;
 }
 
-struct KtxLoadPayload {
-  TextureDesc desc{};
-  std::vector<std::byte> bytes{};
-  std::string debugName{};
-};
-
 struct KtxTextureDeleter {
   void operator()(ktxTexture *texture) const noexcept {
     if (texture != nullptr) {
@@ -118,20 +113,27 @@ convertFloatBitmapToHalfBytes(std::span<const uint8_t> srcBytes) {
   return dstBytes;
 }
 
-[[nodiscard]] Result<KtxLoadPayload, std::string>
+[[nodiscard]] Result<TexturePayload, std::string>
 loadKtxPayload(std::string_view filePath, std::string_view debugName,
                TextureType expectedType) {
   const std::string filePathStr(filePath);
   if (filePathStr.empty()) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: file path is empty");
   }
 
+  auto fileBytes = readAssetFile(filePathStr);
+  if (fileBytes.hasError()) {
+    return Result<TexturePayload, std::string>::makeError(
+        "Texture::loadKtxPayload: " + fileBytes.error());
+  }
   ktxTexture *texture = nullptr;
-  const KTX_error_code createError = ktxTexture_CreateFromNamedFile(
-      filePathStr.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture);
+  const KTX_error_code createError = ktxTexture_CreateFromMemory(
+      reinterpret_cast<const ktx_uint8_t *>(fileBytes.value().data()),
+      fileBytes.value().size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+      &texture);
   if (createError != KTX_SUCCESS || texture == nullptr) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: failed to read KTX file '" + filePathStr +
         "' (error " + std::to_string(static_cast<int>(createError)) + ")");
   }
@@ -139,12 +141,12 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
 
   const bool isCube = texture->numFaces == 6u;
   if (expectedType == TextureType::TextureCube && !isCube) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: expected a cubemap KTX file: '" +
         filePathStr + "'");
   }
   if (expectedType == TextureType::Texture2D && isCube) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: expected a 2D KTX file but got cubemap: '" +
         filePathStr + "'");
   }
@@ -158,12 +160,12 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
       static_cast<size_t>(ktxTexture_GetDataSize(texture));
   const uint8_t *srcData = ktxTexture_GetData(texture);
   if (srcData == nullptr || srcDataSize == 0u) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: KTX2 file has no image payload: '" +
         filePathStr + "'");
   }
 
-  KtxLoadPayload payload{};
+  TexturePayload payload{};
   payload.desc.type = expectedType;
   payload.desc.dimensions = {width, height, depth};
   payload.desc.usage = TextureUsage::Sampled;
@@ -177,7 +179,7 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
 
   auto formatResult = resolveKtxTextureFormat(texture, filePathStr);
   if (formatResult.hasError()) {
-    return Result<KtxLoadPayload, std::string>::makeError(formatResult.error());
+    return Result<TexturePayload, std::string>::makeError(formatResult.error());
   }
   payload.desc.format = formatResult.value();
 
@@ -197,7 +199,7 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
 
   const uint32_t bytesPerPixel = bytesPerPixelForFormat(payload.desc.format);
   if (bytesPerPixel == 0u) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: unsupported pixel size for resolved format "
         "in '" +
         filePathStr + "'");
@@ -231,7 +233,7 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
         const KTX_error_code offsetError =
             ktxTexture_GetImageOffset(texture, level, layer, face, &srcOffset);
         if (offsetError != KTX_SUCCESS) {
-          return Result<KtxLoadPayload, std::string>::makeError(
+          return Result<TexturePayload, std::string>::makeError(
               "Texture::loadKtxPayload: failed to get KTX image offset in '" +
               filePathStr + "' (error " +
               std::to_string(static_cast<int>(offsetError)) + ")");
@@ -239,7 +241,7 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
 
         if (static_cast<size_t>(srcOffset) > srcDataSize ||
             imageBytes > (srcDataSize - static_cast<size_t>(srcOffset))) {
-          return Result<KtxLoadPayload, std::string>::makeError(
+          return Result<TexturePayload, std::string>::makeError(
               "Texture::loadKtxPayload: KTX image offset is out of bounds in "
               "'" +
               filePathStr + "'");
@@ -247,7 +249,7 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
 
         if (dstOffset > payload.bytes.size() ||
             imageBytes > (payload.bytes.size() - dstOffset)) {
-          return Result<KtxLoadPayload, std::string>::makeError(
+          return Result<TexturePayload, std::string>::makeError(
               "Texture::loadKtxPayload: packed KTX output buffer overflow in "
               "'" +
               filePathStr + "'");
@@ -261,21 +263,12 @@ loadKtxPayload(std::string_view filePath, std::string_view debugName,
   }
 
   if (dstOffset != payload.bytes.size()) {
-    return Result<KtxLoadPayload, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Texture::loadKtxPayload: packed KTX output size mismatch in '" +
         filePathStr + "'");
   }
 
-  payload.desc.data =
-      std::span<const std::byte>(payload.bytes.data(), payload.bytes.size());
-  return Result<KtxLoadPayload, std::string>::makeResult(std::move(payload));
-}
-
-[[nodiscard]] Result<std::unique_ptr<Texture>, std::string>
-createTextureFromPayload(GPUDevice &gpu, KtxLoadPayload payload) {
-  payload.desc.data =
-      std::span<const std::byte>(payload.bytes.data(), payload.bytes.size());
-  return Texture::create(gpu, payload.desc, payload.debugName);
+  return Result<TexturePayload, std::string>::makeResult(std::move(payload));
 }
 
 } // namespace
@@ -306,29 +299,96 @@ Texture::loadTexture(GPUDevice &gpu, std::string_view filePath,
                      const TextureLoadOptions &options,
                      std::string_view debugName) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  auto payloadResult = decodeTexture(filePath, options, debugName);
+  if (payloadResult.hasError()) {
+    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+        payloadResult.error());
+  }
+  return createFromPayload(gpu, std::move(payloadResult.value()));
+}
+
+Result<std::unique_ptr<Texture>, std::string>
+Texture::loadCubemapFromEquirectangularHDR(GPUDevice &gpu,
+                                           std::string_view filePath,
+                                           std::string_view debugName) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  auto payloadResult = decodeCubemapFromEquirectangularHDR(filePath, debugName);
+  if (payloadResult.hasError()) {
+    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+        payloadResult.error());
+  }
+  return createFromPayload(gpu, std::move(payloadResult.value()));
+}
+
+Result<std::unique_ptr<Texture>, std::string>
+Texture::loadTextureKtx2(GPUDevice &gpu, std::string_view filePath,
+                         std::string_view debugName) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  auto payloadResult = decodeTextureKtx2(filePath, debugName);
+  if (payloadResult.hasError()) {
+    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+        payloadResult.error());
+  }
+  return createFromPayload(gpu, std::move(payloadResult.value()));
+}
+
+Result<std::unique_ptr<Texture>, std::string>
+Texture::loadCubemapKtx2(GPUDevice &gpu, std::string_view filePath,
+                         std::string_view debugName) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  auto payloadResult = decodeCubemapKtx2(filePath, debugName);
+  if (payloadResult.hasError()) {
+    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+        payloadResult.error());
+  }
+  return createFromPayload(gpu, std::move(payloadResult.value()));
+}
+
+Result<TexturePayload, std::string>
+Texture::decodeTexture(std::string_view filePath,
+                       const TextureLoadOptions &options,
+                       std::string_view debugName) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
   const std::string filePathStr(filePath);
   int32_t width = 0;
   int32_t height = 0;
   int32_t channels = 0;
-  void *pixels = stbi_load(filePathStr.c_str(), &width, &height, &channels, 4);
+  auto fileBytes = readAssetFile(filePathStr);
+  if (fileBytes.hasError() ||
+      fileBytes.value().size() >
+          static_cast<size_t>(std::numeric_limits<int>::max())) {
+    const std::string reason = fileBytes.hasError()
+                                   ? fileBytes.error()
+                                   : std::string("file too large");
+    NURI_LOG_WARNING("Texture::decodeTexture: Failed to load texture '%s': %s",
+                     filePathStr.c_str(), reason.c_str());
+    return Result<TexturePayload, std::string>::makeError(
+        "Failed to load texture from file: " + filePathStr + " " + reason);
+  }
+  void *pixels = stbi_load_from_memory(
+      reinterpret_cast<const stbi_uc *>(fileBytes.value().data()),
+      static_cast<int>(fileBytes.value().size()), &width, &height, &channels,
+      4);
   if (!pixels) {
-    NURI_LOG_WARNING("Texture::loadTexture: Failed to load texture '%s': %s",
+    NURI_LOG_WARNING("Texture::decodeTexture: Failed to load texture '%s': %s",
                      filePathStr.c_str(), stbi_failure_reason());
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Failed to load texture from file: " + filePathStr + " " +
         stbi_failure_reason());
   }
 
   const size_t dataSize =
       static_cast<size_t>(width) * static_cast<size_t>(height) * 4u;
-  const std::span<const std::byte> initialData{
-      static_cast<const std::byte *>(pixels), dataSize};
+  const auto *pixelBytes = static_cast<const std::byte *>(pixels);
 
   const uint32_t widthU32 = static_cast<uint32_t>(width);
   const uint32_t heightU32 = static_cast<uint32_t>(height);
   const uint32_t mipLevels =
       options.generateMipmaps ? computeMipLevelCount(widthU32, heightU32) : 1u;
-  TextureDesc desc{
+  TexturePayload payload{};
+  payload.bytes.assign(pixelBytes, pixelBytes + dataSize);
+  stbi_image_free(pixels);
+  payload.desc = TextureDesc{
       .type = TextureType::Texture2D,
       .format = options.srgb ? Format::RGBA8_SRGB : Format::RGBA8_UNORM,
       .dimensions = {widthU32, heightU32, 1},
@@ -337,46 +397,49 @@ Texture::loadTexture(GPUDevice &gpu, std::string_view filePath,
       .numLayers = 1,
       .numSamples = 1,
       .numMipLevels = mipLevels,
-      .data = initialData,
       .dataNumMipLevels = 1,
       .generateMipmaps = options.generateMipmaps,
   };
-  auto result = gpu.createTexture(desc, debugName);
-  if (result.hasError()) {
-    NURI_LOG_WARNING("Texture::loadTexture: Failed to create texture '%s': %s",
-                     filePathStr.c_str(), result.error().c_str());
-    stbi_image_free(pixels);
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
-        result.error());
-  }
-
-  stbi_image_free(pixels);
+  payload.debugName = std::string(debugName);
 
-  NURI_LOG_DEBUG("Texture::loadTexture: Created texture from file '%s'",
+  NURI_LOG_DEBUG("Texture::decodeTexture: Decoded texture from file '%s'",
                  filePathStr.c_str());
-
-  return Result<std::unique_ptr<Texture>, std::string>::makeResult(
-      std::unique_ptr<Texture>(
-          new Texture(result.value(), desc, std::string(debugName))));
+  return Result<TexturePayload, std::string>::makeResult(std::move(payload));
 }
 
-Result<std::unique_ptr<Texture>, std::string>
-Texture::loadCubemapFromEquirectangularHDR(GPUDevice &gpu,
-                                           std::string_view filePath,
-                                           std::string_view debugName) {
+Result<TexturePayload, std::string>
+Texture::decodeCubemapFromEquirectangularHDR(std::string_view filePath,
+                                             std::string_view debugName) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
   const std::string filePathStr(filePath);
   int32_t width = 0;
   int32_t height = 0;
   int32_t channels = 0;
-  float *pixels =
-      stbi_loadf(filePathStr.c_str(), &width, &height, &channels, 4);
+  auto fileBytes = readAssetFile(filePathStr);
+  if (fileBytes.hasError() ||
+      fileBytes.value().size() >
+          static_cast<size_t>(std::numeric_limits<int>::max())) {
+    const std::string reason = fileBytes.hasError()
+                                   ? fileBytes.error()
+                                   : std::string("file too large");
+    NURI_LOG_WARNING(
+        "Texture::decodeCubemapFromEquirectangularHDR: Failed to load '%s': "
+        "%s",
+        filePathStr.c_str(), reason.c_str());
+    return Result<TexturePayload, std::string>::makeError(
+        "Failed to load HDR texture from file: " + filePathStr + " " + reason);
+  }
+  float *pixels = stbi_loadf_from_memory(
+      reinterpret_cast<const stbi_uc *>(fileBytes.value().data()),
+      static_cast<int>(fileBytes.value().size()), &width, &height, &channels,
+      4);
   if (!pixels) {
     const char *reason = stbi_failure_reason();
     NURI_LOG_WARNING(
-        "Texture::loadCubemapFromEquirectangularHDR: Failed to load '%s': %s",
+        "Texture::decodeCubemapFromEquirectangularHDR: Failed to load '%s': "
+        "%s",
         filePathStr.c_str(), reason ? reason : "unknown error");
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Failed to load HDR texture from file: " + filePathStr + " " +
         (reason ? std::string(reason) : std::string("unknown error")));
   }
@@ -389,27 +452,24 @@ Texture::loadCubemapFromEquirectangularHDR(GPUDevice &gpu,
   const Bitmap cubemapFaces =
       equirectangular.convertEquirectangularMapToCubeMapFaces();
   if (cubemapFaces.empty()) {
-    NURI_LOG_WARNING("Texture::loadCubemapFromEquirectangularHDR: Failed to "
+    NURI_LOG_WARNING("Texture::decodeCubemapFromEquirectangularHDR: Failed to "
                      "convert equirectangular HDR to cubemap faces '%s'",
                      filePathStr.c_str());
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Failed to convert HDR texture to cubemap faces: " + filePathStr);
   }
 
-  std::vector<std::byte> halfBytes =
-      convertFloatBitmapToHalfBytes(cubemapFaces.data());
-  if (halfBytes.empty()) {
-    NURI_LOG_WARNING("Texture::loadCubemapFromEquirectangularHDR: Failed to "
+  TexturePayload payload{};
+  payload.bytes = convertFloatBitmapToHalfBytes(cubemapFaces.data());
+  if (payload.bytes.empty()) {
+    NURI_LOG_WARNING("Texture::decodeCubemapFromEquirectangularHDR: Failed to "
                      "convert cubemap data to RGBA16F '%s'",
                      filePathStr.c_str());
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
+    return Result<TexturePayload, std::string>::makeError(
         "Failed to convert cubemap face data to RGBA16F: " + filePathStr);
   }
 
-  const std::span<const std::byte> initialData(halfBytes.data(),
-                                               halfBytes.size());
-
-  TextureDesc desc{
+  payload.desc = TextureDesc{
       .type = TextureType::TextureCube,
       .format = Format::RGBA16_FLOAT,
       .dimensions = {static_cast<uint32_t>(cubemapFaces.width()),
@@ -419,54 +479,42 @@ Texture::loadCubemapFromEquirectangularHDR(GPUDevice &gpu,
       .numLayers = 1,
       .numSamples = 1,
       .numMipLevels = 1,
-      .data = initialData,
       .dataNumMipLevels = 1,
       .generateMipmaps = false,
   };
-  const std::string resolvedDebugName =
-      debugName.empty() ? filePathStr : std::string(debugName);
-  auto result = gpu.createTexture(desc, resolvedDebugName);
-  if (result.hasError()) {
-    NURI_LOG_WARNING("Texture::loadCubemapFromEquirectangularHDR: Failed to "
-                     "create cubemap texture '%s': %s",
-                     filePathStr.c_str(), result.error().c_str());
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
-        result.error());
-  }
+  payload.debugName = debugName.empty() ? filePathStr : std::string(debugName);
 
-  NURI_LOG_DEBUG("Texture::loadCubemapFromEquirectangularHDR: Created cubemap "
-                 "from file '%s'",
+  NURI_LOG_DEBUG("Texture::decodeCubemapFromEquirectangularHDR: Decoded "
+                 "cubemap from file '%s'",
                  filePathStr.c_str());
+  return Result<TexturePayload, std::string>::makeResult(std::move(payload));
+}
 
-  return Result<std::unique_ptr<Texture>, std::string>::makeResult(
-      std::unique_ptr<Texture>(
-          new Texture(result.value(), desc, resolvedDebugName)));
+Result<TexturePayload, std::string>
+Texture::decodeTextureKtx2(std::string_view filePath,
+                           std::string_view debugName) {
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  return loadKtxPayload(filePath, debugName, TextureType::Texture2D);
 }
 
-Result<std::unique_ptr<Texture>, std::string>
-Texture::loadTextureKtx2(GPUDevice &gpu, std::string_view filePath,
-                         std::string_view debugName) {
+Result<TexturePayload, std::string>
+Texture::decodeCubemapKtx2(std::string_view filePath,
+                           std::string_view debugName) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
-  auto payloadResult =
-      loadKtxPayload(filePath, debugName, TextureType::Texture2D);
-  if (payloadResult.hasError()) {
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
-        payloadResult.error());
-  }
-  return createTextureFromPayload(gpu, std::move(payloadResult.value()));
+  return loadKtxPayload(filePath, debugName, TextureType::TextureCube);
 }
 
 Result<std::unique_ptr<Texture>, std::string>
-Texture::loadCubemapKtx2(GPUDevice &gpu, std::string_view filePath,
-                         std::string_view debugName) {
-  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
-  auto payloadResult =
-      loadKtxPayload(filePath, debugName, TextureType::TextureCube);
-  if (payloadResult.hasError()) {
-    return Result<std::unique_ptr<Texture>, std::string>::makeError(
-        payloadResult.error());
+Texture::createFromPayload(GPUDevice &gpu, TexturePayload payload) {
+  payload.desc.data =
+      std::span<const std::byte>(payload.bytes.data(), payload.bytes.size());
+  auto result = create(gpu, payload.desc, payload.debugName);
+  if (result.hasError()) {
+    NURI_LOG_WARNING("Texture::createFromPayload: Failed to create texture "
+                     "'%s': %s",
+                     payload.debugName.c_str(), result.error().c_str());
   }
-  return createTextureFromPayload(gpu, std::move(payloadResult.value()));
+  return result;
 }
 
 } // namespace nuri
@@ -4,6 +4,7 @@
 #include "nuri/gfx/gpu_device.h"
 
 #include <string_view>
+#include <vector>
 
 namespace nuri {
 
@@ -12,6 +13,15 @@ struct TextureLoadOptions {
   bool generateMipmaps = false;
 };
 
+// Decoded texture contents, produced without touching the GPU so file reads
+// and conversions can run on worker threads. `desc.data` is rebound to
+// `bytes` on upload, so payloads can be moved freely.
+struct NURI_API TexturePayload {
+  TextureDesc desc{};
+  std::vector<std::byte> bytes{};
+  std::string debugName{};
+};
+
 class NURI_API Texture final {
 public:
   ~Texture() = default;
@@ -46,6 +56,23 @@ public:
   loadCubemapKtx2(GPUDevice &gpu, std::string_view filePath,
                   std::string_view debugName = {});
 
+  // CPU-only halves of the loaders above; safe to call from any thread.
+  [[nodiscard]] static Result<TexturePayload, std::string>
+  decodeTexture(std::string_view filePath, const TextureLoadOptions &options,
+                std::string_view debugName = {});
+  [[nodiscard]] static Result<TexturePayload, std::string>
+  decodeCubemapFromEquirectangularHDR(std::string_view filePath,
+                                      std::string_view debugName = {});
+  [[nodiscard]] static Result<TexturePayload, std::string>
+  decodeTextureKtx2(std::string_view filePath,
+                    std::string_view debugName = {});
+  [[nodiscard]] static Result<TexturePayload, std::string>
+  decodeCubemapKtx2(std::string_view filePath,
+                    std::string_view debugName = {});
+
+  [[nodiscard]] static Result<std::unique_ptr<Texture>, std::string>
+  createFromPayload(GPUDevice &gpu, TexturePayload payload);
+
   [[nodiscard]] TextureHandle handle() const { return handle_; }
   [[nodiscard]] TextureType type() const { return type_; }
   [[nodiscard]] Format format() const { return format_; }
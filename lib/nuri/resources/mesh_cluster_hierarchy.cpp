@@ -0,0 +1,375 @@
+#include "nuri/pch.h"
+
+#include "nuri/resources/mesh_cluster_hierarchy.h"
+
+#include "nuri/core/pmr_scratch.h"
+#include "nuri/core/profiling.h"
+
+namespace nuri {
+namespace {
+
+constexpr size_t kTriangleIndexCount = 3;
+constexpr uint32_t kMaxMeshletVertices = 255;
+constexpr uint32_t kMaxMeshletTriangles = 512;
+// Groups that keep more than this share of their triangles are not worth
+// another level and stay roots.
+constexpr float kMinSimplifyReduction = 0.85f;
+constexpr uint32_t kMaxHierarchyDepth = 32;
+// Group borders stay locked so neighbouring groups can switch independently.
+// The input is a small subset of the mesh, and errors are kept absolute so
+// they accumulate across levels.
+constexpr unsigned int kGroupSimplifyOptions = meshopt_SimplifyLockBorder |
+                                               meshopt_SimplifySparse |
+                                               meshopt_SimplifyErrorAbsolute;
+
+struct BuildContext {
+  std::span<const Vertex> vertices;
+  const MeshClusterHierarchyOptions &options;
+  MeshClusterHierarchy &hierarchy;
+};
+
+glm::vec4 computeSphere(std::span<const Vertex> vertices,
+                        std::span<const uint32_t> indices) {
+  glm::vec3 minPos(std::numeric_limits<float>::max());
+  glm::vec3 maxPos(std::numeric_limits<float>::lowest());
+  for (const uint32_t index : indices) {
+    minPos = glm::min(minPos, vertices[index].position);
+    maxPos = glm::max(maxPos, vertices[index].position);
+  }
+  const glm::vec3 center = (minPos + maxPos) * 0.5f;
+  float radiusSq = 0.0f;
+  for (const uint32_t index : indices) {
+    const glm::vec3 offset = vertices[index].position - center;
+    radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+  }
+  return glm::vec4(center, std::sqrt(radiusSq));
+}
+
+glm::vec4 mergeSpheres(const glm::vec4 &a, const glm::vec4 &b) {
+  const glm::vec3 delta = glm::vec3(b) - glm::vec3(a);
+  const float distance = glm::length(delta);
+  if (distance + b.w <= a.w) {
+    return a;
+  }
+  if (distance + a.w <= b.w) {
+    return b;
+  }
+  const float radius = (distance + a.w + b.w) * 0.5f;
+  const glm::vec3 center = glm::vec3(a) + delta * ((radius - a.w) / distance);
+  return glm::vec4(center, radius);
+}
+
+// Splits indices into clusters and appends their ids to outClusterIds. The
+// finest clusters get their own sphere; coarser ones share their group's.
+void appendClusters(BuildContext &context, std::span<const uint32_t> indices,
+                    const glm::vec4 *groupBounds, float groupError,
+                    std::pmr::vector<uint32_t> &outClusterIds) {
+  const MeshClusterHierarchyOptions &options = context.options;
+  MeshClusterHierarchy &hierarchy = context.hierarchy;
+  ScopedThreadScratch scratch;
+  const size_t maxMeshlets =
+      meshopt_buildMeshletsBound(indices.size(), options.maxClusterVertices,
+                                 options.maxClusterTriangles);
+  std::pmr::vector<meshopt_Meshlet> meshlets(maxMeshlets, scratch.resource());
+  std::pmr::vector<unsigned int> meshletVertices(
+      maxMeshlets * options.maxClusterVertices, scratch.resource());
+  std::pmr::vector<unsigned char> meshletTriangles(
+      maxMeshlets * options.maxClusterTriangles * kTriangleIndexCount,
+      scratch.resource());
+  const size_t meshletCount = meshopt_buildMeshlets(
+      meshlets.data(), meshletVertices.data(), meshletTriangles.data(),
+      indices.data(), indices.size(), &context.vertices.front().position.x,
+      context.vertices.size(), sizeof(Vertex), options.maxClusterVertices,
+      options.maxClusterTriangles, 0.0f);
+
+  for (size_t i = 0; i < meshletCount; ++i) {
+    const meshopt_Meshlet &meshlet = meshlets[i];
+    MeshCluster cluster{};
+    cluster.indexOffset = static_cast<uint32_t>(hierarchy.indices.size());
+    cluster.indexCount = meshlet.triangle_count * kTriangleIndexCount;
+    for (uint32_t k = 0; k < cluster.indexCount; ++k) {
+      const unsigned char local = meshletTriangles[meshlet.triangle_offset + k];
+      hierarchy.indices.push_back(
+          meshletVertices[meshlet.vertex_offset + local]);
+    }
+    cluster.bounds =
+        groupBounds != nullptr
+            ? *groupBounds
+            : computeSphere(context.vertices,
+                            std::span<const uint32_t>(hierarchy.indices)
+                                .subspan(cluster.indexOffset,
+                                         cluster.indexCount));
+    cluster.error = groupError;
+    outClusterIds.push_back(static_cast<uint32_t>(hierarchy.clusters.size()));
+    hierarchy.clusters.push_back(cluster);
+  }
+}
+
+// Greedily grows each group from the first unassigned cluster by the
+// neighbour sharing the most vertex positions with the group so far.
+void groupClusters(const BuildContext &context,
+                   std::span<const uint32_t> positionIds,
+                   std::span<const uint32_t> level,
+                   std::pmr::vector<uint32_t> &outGroupOffsets,
+                   std::pmr::vector<uint32_t> &outGroupMembers) {
+  const MeshClusterHierarchy &hierarchy = context.hierarchy;
+  ScopedThreadScratch scratch;
+  std::pmr::memory_resource *memory = scratch.resource();
+
+  std::pmr::vector<uint32_t> clusterPositionOffsets(memory);
+  std::pmr::vector<uint32_t> clusterPositions(memory);
+  clusterPositionOffsets.reserve(level.size() + 1u);
+  clusterPositionOffsets.push_back(0u);
+  for (const uint32_t clusterId : level) {
+    const MeshCluster &cluster = hierarchy.clusters[clusterId];
+    const size_t first = clusterPositions.size();
+    for (uint32_t k = 0; k < cluster.indexCount; ++k) {
+      clusterPositions.push_back(
+          positionIds[hierarchy.indices[cluster.indexOffset + k]]);
+    }
+    std::sort(clusterPositions.begin() + first, clusterPositions.end());
+    clusterPositions.erase(
+        std::unique(clusterPositions.begin() + first, clusterPositions.end()),
+        clusterPositions.end());
+    clusterPositionOffsets.push_back(
+        static_cast<uint32_t>(clusterPositions.size()));
+  }
+
+  std::pmr::vector<uint32_t> positionClusterOffsets(positionIds.size() + 1u,
+                                                    0u, memory);
+  for (const uint32_t position : clusterPositions) {
+    ++positionClusterOffsets[position + 1u];
+  }
+  for (size_t i = 1; i < positionClusterOffsets.size(); ++i) {
+    positionClusterOffsets[i] += positionClusterOffsets[i - 1u];
+  }
+  std::pmr::vector<uint32_t> positionClusters(clusterPositions.size(), 0u,
+                                              memory);
+  std::pmr::vector<uint32_t> positionFill(
+      positionClusterOffsets.begin(), positionClusterOffsets.end() - 1,
+      memory);
+  for (uint32_t local = 0; local < level.size(); ++local) {
+    for (uint32_t k = clusterPositionOffsets[local];
+         k < clusterPositionOffsets[local + 1u]; ++k) {
+      positionClusters[positionFill[clusterPositions[k]]++] = local;
+    }
+  }
+
+  std::pmr::vector<uint8_t> assigned(level.size(), 0u, memory);
+  std::pmr::vector<uint32_t> scores(level.size(), 0u, memory);
+  std::pmr::vector<uint32_t> touched(memory);
+  outGroupOffsets.clear();
+  outGroupMembers.clear();
+  outGroupOffsets.push_back(0u);
+  for (uint32_t seed = 0; seed < level.size(); ++seed) {
+    if (assigned[seed] != 0u) {
+      continue;
+    }
+    const size_t groupStart = outGroupMembers.size();
+    assigned[seed] = 1u;
+    outGroupMembers.push_back(seed);
+    while (outGroupMembers.size() - groupStart <
+           context.options.groupClusterCount) {
+      const uint32_t newest = outGroupMembers.back();
+      for (uint32_t k = clusterPositionOffsets[newest];
+           k < clusterPositionOffsets[newest + 1u]; ++k) {
+        const uint32_t position = clusterPositions[k];
+        for (uint32_t n = positionClusterOffsets[position];
+             n < positionClusterOffsets[position + 1u]; ++n) {
+          const uint32_t neighbour = positionClusters[n];
+          if (assigned[neighbour] != 0u) {
+            continue;
+          }
+          if (scores[neighbour]++ == 0u) {
+            touched.push_back(neighbour);
+          }
+        }
+      }
+      uint32_t best = 0;
+      uint32_t bestScore = 0;
+      for (const uint32_t candidate : touched) {
+        if (assigned[candidate] == 0u && scores[candidate] > bestScore) {
+          best = candidate;
+          bestScore = scores[candidate];
+        }
+      }
+      if (bestScore == 0u) {
+        break;
+      }
+      assigned[best] = 1u;
+      outGroupMembers.push_back(best);
+    }
+    for (const uint32_t candidate : touched) {
+      scores[candidate] = 0u;
+    }
+    touched.clear();
+    outGroupOffsets.push_back(static_cast<uint32_t>(outGroupMembers.size()));
+  }
+}
+
+} // namespace
+
+Result<MeshClusterHierarchy, std::string>
+buildMeshClusterHierarchy(std::span<const Vertex> vertices,
+                          std::span<const uint32_t> indices,
+                          const MeshClusterHierarchyOptions &options,
+                          std::pmr::memory_resource *mem) {
+  using ResultType = Result<MeshClusterHierarchy, std::string>;
+  NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
+  if (vertices.empty() || indices.size() < kTriangleIndexCount ||
+      indices.size() % kTriangleIndexCount != 0) {
+    return ResultType::makeError(
+        "buildMeshClusterHierarchy: input is not a triangle list");
+  }
+  if (options.maxClusterVertices < kTriangleIndexCount ||
+      options.maxClusterVertices > kMaxMeshletVertices ||
+      options.maxClusterTriangles == 0 ||
+      options.maxClusterTriangles > kMaxMeshletTriangles ||
+      options.maxClusterTriangles % 4u != 0 || options.groupClusterCount < 2) {
+    return ResultType::makeError(
+        "buildMeshClusterHierarchy: invalid cluster options");
+  }
+  for (const uint32_t index : indices) {
+    if (index >= vertices.size()) {
+      return ResultType::makeError(
+          "buildMeshClusterHierarchy: index out of range");
+    }
+  }
+  if (!mem) {
+    mem = std::pmr::get_default_resource();
+  }
+
+  MeshClusterHierarchy hierarchy(mem);
+  BuildContext context{
+      .vertices = vertices,
+      .options = options,
+      .hierarchy = hierarchy,
+  };
+
+  // Seams duplicate vertices, so adjacency is tracked by position.
+  std::pmr::vector<uint32_t> positionIds(vertices.size(), mem);
+  {
+    std::pmr::vector<glm::vec3> positions(mem);
+    positions.reserve(vertices.size());
+    for (const Vertex &vertex : vertices) {
+      positions.push_back(vertex.position);
+    }
+    meshopt_generateVertexRemap(positionIds.data(), nullptr, positions.size(),
+                                positions.data(), positions.size(),
+                                sizeof(glm::vec3));
+  }
+
+  std::pmr::vector<uint32_t> level(mem);
+  std::pmr::vector<uint32_t> nextLevel(mem);
+  appendClusters(context, indices, nullptr, 0.0f, level);
+
+  std::pmr::vector<uint32_t> groupOffsets(mem);
+  std::pmr::vector<uint32_t> groupMembers(mem);
+  std::pmr::vector<uint32_t> groupIndices(mem);
+  std::pmr::vector<uint32_t> simplifiedIndices(mem);
+  for (uint32_t depth = 0; depth < kMaxHierarchyDepth && level.size() > 1;
+       ++depth) {
+    groupClusters(context, positionIds, level, groupOffsets, groupMembers);
+    nextLevel.clear();
+    for (size_t group = 0; group + 1u < groupOffsets.size(); ++group) {
+      const std::span<const uint32_t> members =
+          std::span<const uint32_t>(groupMembers)
+              .subspan(groupOffsets[group],
+                       groupOffsets[group + 1u] - groupOffsets[group]);
+      if (members.size() < 2) {
+        continue;
+      }
+
+      groupIndices.clear();
+      glm::vec4 groupBounds = hierarchy.clusters[level[members[0]]].bounds;
+      float childError = 0.0f;
+      for (const uint32_t member : members) {
+        const MeshCluster &child = hierarchy.clusters[level[member]];
+        groupIndices.insert(
+            groupIndices.end(),
+            hierarchy.indices.begin() + child.indexOffset,
+            hierarchy.indices.begin() + child.indexOffset + child.indexCount);
+        groupBounds = mergeSpheres(groupBounds, child.bounds);
+        childError = std::max(childError, child.error);
+      }
+
+      simplifiedIndices.resize(groupIndices.size());
+      const size_t targetIndexCount =
+          groupIndices.size() / (2u * kTriangleIndexCount) *
+          kTriangleIndexCount;
+      float simplifyError = 0.0f;
+      const size_t simplifiedCount = meshopt_simplify(
+          simplifiedIndices.data(), groupIndices.data(), groupIndices.size(),
+          &vertices.front().position.x, vertices.size(), sizeof(Vertex),
+          targetIndexCount, std::numeric_limits<float>::max(),
+          kGroupSimplifyOptions, &simplifyError);
+      if (simplifiedCount < kTriangleIndexCount ||
+          static_cast<float>(simplifiedCount) >
+              static_cast<float>(groupIndices.size()) *
+                  kMinSimplifyReduction) {
+        continue;
+      }
+      simplifiedIndices.resize(simplifiedCount);
+
+      const float groupError = childError + simplifyError;
+      for (const uint32_t member : members) {
+        MeshCluster &child = hierarchy.clusters[level[member]];
+        child.parentBounds = groupBounds;
+        child.parentError = groupError;
+      }
+      appendClusters(context, simplifiedIndices, &groupBounds, groupError,
+                     nextLevel);
+    }
+    level.swap(nextLevel);
+  }
+
+  if (hierarchy.indices.size() > std::numeric_limits<uint32_t>::max()) {
+    return ResultType::makeError(
+        "buildMeshClusterHierarchy: index count exceeds uint32");
+  }
+  return ResultType::makeResult(std::move(hierarchy));
+}
+
+void selectMeshClusters(std::span<const MeshCluster> clusters,
+                        const glm::mat4 &modelMatrix,
+                        const glm::vec3 &viewerPosition, float errorScale,
+                        std::pmr::vector<SubmeshLod> &outRanges) {
+  const float scale = std::sqrt(std::max(
+      {glm::dot(glm::vec3(modelMatrix[0]), glm::vec3(modelMatrix[0])),
+       glm::dot(glm::vec3(modelMatrix[1]), glm::vec3(modelMatrix[1])),
+       glm::dot(glm::vec3(modelMatrix[2]), glm::vec3(modelMatrix[2]))}));
+  const auto errorAcceptable = [&](const glm::vec4 &bounds, float error) {
+    const glm::vec3 center =
+        glm::vec3(modelMatrix * glm::vec4(glm::vec3(bounds), 1.0f));
+    const float distance =
+        std::max(glm::length(center - viewerPosition) - bounds.w * scale, 0.0f);
+    return error * scale * errorScale <= distance;
+  };
+
+  const size_t firstRange = outRanges.size();
+  for (const MeshCluster &cluster : clusters) {
+    if (cluster.indexCount == 0 ||
+        !errorAcceptable(cluster.bounds, cluster.error)) {
+      continue;
+    }
+    if (cluster.parentError < std::numeric_limits<float>::max() &&
+        errorAcceptable(cluster.parentBounds, cluster.parentError)) {
+      continue;
+    }
+    if (outRanges.size() > firstRange) {
+      SubmeshLod &previous = outRanges.back();
+      if (previous.indexOffset + previous.indexCount == cluster.indexOffset) {
+        previous.indexCount += cluster.indexCount;
+        previous.error = std::max(previous.error, cluster.error);
+        continue;
+      }
+    }
+    outRanges.push_back(SubmeshLod{
+        .indexOffset = cluster.indexOffset,
+        .indexCount = cluster.indexCount,
+        .error = cluster.error,
+    });
+  }
+}
+
+} // namespace nuri
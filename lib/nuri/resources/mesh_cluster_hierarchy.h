@@ -0,0 +1,53 @@
+#pragma once
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/resources/cpu/mesh_data.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+
+namespace nuri {
+
+struct MeshClusterHierarchyOptions {
+  uint32_t maxClusterVertices = 64;
+  uint32_t maxClusterTriangles = 124;
+  // Neighbouring clusters merged into one group per simplification step.
+  uint32_t groupClusterCount = 4;
+};
+
+struct MeshClusterHierarchy {
+  // Cluster index ranges point into indices, finest level first.
+  std::pmr::vector<uint32_t> indices;
+  std::pmr::vector<MeshCluster> clusters;
+
+  explicit MeshClusterHierarchy(
+      std::pmr::memory_resource *mem = std::pmr::get_default_resource())
+      : indices(mem), clusters(mem) {}
+};
+
+// Splits a triangle list into clusters, then repeatedly merges neighbouring
+// clusters into groups, halves each group with its border locked and splits
+// the result into coarser clusters. Errors accumulate up the hierarchy and
+// each group's sphere encloses its children, so the projected error never
+// decreases from a cluster to its parent. Groups that stop simplifying become
+// roots.
+[[nodiscard]] NURI_API Result<MeshClusterHierarchy, std::string>
+buildMeshClusterHierarchy(
+    std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+    const MeshClusterHierarchyOptions &options = {},
+    std::pmr::memory_resource *mem = std::pmr::get_default_resource());
+
+// Appends the index ranges of the clusters whose own error projects within
+// the threshold while their parent's does not, merging adjacent ranges.
+// errorScale maps world-space error at unit distance to threshold units:
+// viewport height * proj[1][1] / (2 * pixel threshold).
+NURI_API void selectMeshClusters(std::span<const MeshCluster> clusters,
+                                 const glm::mat4 &modelMatrix,
+                                 const glm::vec3 &viewerPosition,
+                                 float errorScale,
+                                 std::pmr::vector<SubmeshLod> &outRanges);
+
+} // namespace nuri
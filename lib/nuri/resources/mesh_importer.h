@@ -29,6 +29,11 @@ struct MeshImportOptions {
   uint32_t lodCount = kMaxLodCount;
   std::array<float, kMaxLodCount - 1> lodTriangleRatios{0.60f, 0.35f, 0.20f};
   float lodTargetError = 1e-2f;
+  // Submeshes with at least this many triangles also get a cluster LOD
+  // hierarchy, so the runtime can pick detail per cluster instead of per
+  // submesh.
+  bool generateClusterLod = true;
+  uint32_t clusterLodMinTriangles = 65536;
 };
 
 using ImportedMaterialAlphaMode = MaterialAlphaMode;
@@ -5,6 +5,7 @@
 #include "nuri/core/log.h"
 #include "nuri/core/pmr_scratch.h"
 #include "nuri/core/profiling.h"
+#include "nuri/resources/mesh_cluster_hierarchy.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/material.h>
@@ -965,7 +966,7 @@ void appendSubmeshToMeshData(
     const BoundingBox &bounds, uint32_t lodCount,
     std::span<const std::pmr::vector<uint32_t>> lodIndexBuffers,
     const std::array<float, Submesh::kMaxLodCount> &lodErrors,
-    uint32_t meshIndex) {
+    const MeshClusterHierarchy &clusterHierarchy, uint32_t meshIndex) {
   const uint32_t vertexBase = static_cast<uint32_t>(data.vertices.size());
   data.vertices.insert(data.vertices.end(), vertices.begin(), vertices.end());
 
@@ -999,6 +1000,18 @@ void appendSubmeshToMeshData(
     return;
   }
 
+  const uint32_t clusterIndexBase = static_cast<uint32_t>(data.indices.size());
+  for (uint32_t localIndex : clusterHierarchy.indices) {
+    data.indices.push_back(vertexBase + localIndex);
+  }
+  submesh.clusterOffset = static_cast<uint32_t>(data.clusters.size());
+  submesh.clusterCount =
+      static_cast<uint32_t>(clusterHierarchy.clusters.size());
+  for (MeshCluster cluster : clusterHierarchy.clusters) {
+    cluster.indexOffset += clusterIndexBase;
+    data.clusters.push_back(cluster);
+  }
+
   data.submeshes.push_back(submesh);
 }
 
@@ -1162,9 +1175,28 @@ MeshImporter::loadFromFile(std::string_view path,
                                     lodIndexBuffers);
     }
 
+    MeshClusterHierarchy clusterHierarchy(scopedScratch.resource());
+    if (options.generateClusterLod &&
+        lodIndexBuffers[0].size() / kTriangleIndexCount >=
+            std::max(options.clusterLodMinTriangles, 1u)) {
+      NURI_PROFILER_ZONE("MeshImporter.cluster_lod_generation",
+                         NURI_PROFILER_COLOR_CREATE);
+      auto clusterResult = buildMeshClusterHierarchy(
+          meshVertices, lodIndexBuffers[0], {}, scopedScratch.resource());
+      NURI_PROFILER_ZONE_END();
+      if (clusterResult.hasError()) {
+        NURI_LOG_WARNING("MeshImporter::loadFromFile: Mesh %u cluster LOD "
+                         "generation failed: %s",
+                         i, clusterResult.error().c_str());
+      } else {
+        clusterHierarchy = std::move(clusterResult.value());
+      }
+    }
+
     const BoundingBox submeshBounds = computeSubmeshBounds(meshVertices);
     appendSubmeshToMeshData(data, *mesh, meshVertices, submeshBounds,
-                            generatedLodCount, lodIndexBuffers, lodErrors, i);
+                            generatedLodCount, lodIndexBuffers, lodErrors,
+                            clusterHierarchy, i);
   }
   NURI_LOG_DEBUG(
       "MeshImporter::loadFromFile: Mesh optimization processing complete");
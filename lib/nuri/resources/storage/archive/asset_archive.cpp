@@ -0,0 +1,652 @@
+#include "nuri/pch.h"
+
+#include "nuri/resources/storage/archive/asset_archive.h"
+
+#include "nuri/core/profiling.h"
+#include "nuri/resources/storage/mesh/mesh_cache_utils.h"
+
+namespace nuri {
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis64 = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime64 = 1099511628211ull;
+
+// LZ block codec. A block is a run of sequences:
+//   token      literal length (high nibble), match length - 4 (low nibble);
+//              15 in either nibble continues in 255-terminated extra bytes
+//   literals
+//   offset     uint16 little endian, distance back into the output
+//   extra match length bytes
+// The last sequence has literals only and ends at the end of the block.
+constexpr size_t kLzMinMatch = 4u;
+constexpr size_t kLzMaxOffset = 65535u;
+constexpr uint32_t kLzHashBits = 14u;
+constexpr uint32_t kLzNibbleMax = 15u;
+constexpr uint32_t kLzEmptySlot = UINT32_MAX;
+
+// Entries whose gap is at most this are merged into one read; reading the
+// gap costs less than another seek on HDDs and network mounts.
+constexpr uint64_t kMaxCoalesceGapBytes = 256ull * 1024ull;
+constexpr uint64_t kMaxCoalescedReadBytes = 64ull * 1024ull * 1024ull;
+
+template <typename T>
+[[nodiscard]] Result<T, std::string> makeError(std::string message) {
+  return Result<T, std::string>::makeError(std::move(message));
+}
+
+[[nodiscard]] uint32_t readU32(const std::byte *bytes) {
+  uint32_t value = 0;
+  std::memcpy(&value, bytes, sizeof(value));
+  return value;
+}
+
+[[nodiscard]] uint32_t lzHash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32u - kLzHashBits);
+}
+
+void lzWriteLength(std::vector<std::byte> &out, size_t length) {
+  while (length >= 255u) {
+    out.push_back(std::byte{255});
+    length -= 255u;
+  }
+  out.push_back(static_cast<std::byte>(length));
+}
+
+void lzWriteSequence(std::vector<std::byte> &out,
+                     std::span<const std::byte> literals, size_t offset,
+                     size_t matchLength) {
+  const size_t literalNibble =
+      std::min<size_t>(literals.size(), kLzNibbleMax);
+  const size_t matchNibble =
+      matchLength == 0u
+          ? 0u
+          : std::min<size_t>(matchLength - kLzMinMatch, kLzNibbleMax);
+  out.push_back(static_cast<std::byte>((literalNibble << 4u) | matchNibble));
+  if (literalNibble == kLzNibbleMax) {
+    lzWriteLength(out, literals.size() - kLzNibbleMax);
+  }
+  out.insert(out.end(), literals.begin(), literals.end());
+  if (matchLength == 0u) {
+    return;
+  }
+  out.push_back(static_cast<std::byte>(offset & 0xffu));
+  out.push_back(static_cast<std::byte>((offset >> 8u) & 0xffu));
+  if (matchNibble == kLzNibbleMax) {
+    lzWriteLength(out, matchLength - kLzMinMatch - kLzNibbleMax);
+  }
+}
+
+[[nodiscard]] bool lzReadLength(std::span<const std::byte> in, size_t &pos,
+                                size_t &length) {
+  while (true) {
+    if (pos >= in.size()) {
+      return false;
+    }
+    const size_t value = std::to_integer<size_t>(in[pos++]);
+    length += value;
+    if (value != 255u) {
+      return true;
+    }
+  }
+}
+
+[[nodiscard]] uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+[[nodiscard]] bool entryLess(const AssetArchiveEntry &lhs,
+                             std::string_view lhsPath,
+                             const AssetArchiveEntry &rhs,
+                             std::string_view rhsPath) {
+  if (lhs.pathHash != rhs.pathHash) {
+    return lhs.pathHash < rhs.pathHash;
+  }
+  return lhsPath < rhsPath;
+}
+
+[[nodiscard]] Result<bool, std::string>
+writeBytes(std::ofstream &output, const void *data, size_t size,
+           const std::filesystem::path &path) {
+  output.write(static_cast<const char *>(data),
+               static_cast<std::streamsize>(size));
+  if (!output) {
+    return makeError<bool>("buildAssetArchive: failed to write '" +
+                           path.string() + "'");
+  }
+  return Result<bool, std::string>::makeResult(true);
+}
+
+} // namespace
+
+uint64_t hashAssetArchivePath(std::string_view path) {
+  uint64_t hash = kFnvOffsetBasis64;
+  for (const char c : path) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= kFnvPrime64;
+  }
+  return hash;
+}
+
+std::vector<std::byte> assetArchiveCompress(std::span<const std::byte> bytes) {
+  std::vector<std::byte> out;
+  out.reserve(bytes.size() / 2u + 16u);
+  std::vector<uint32_t> table(size_t{1} << kLzHashBits, kLzEmptySlot);
+
+  size_t anchor = 0;
+  size_t pos = 0;
+  while (pos + kLzMinMatch <= bytes.size()) {
+    const uint32_t sequence = readU32(bytes.data() + pos);
+    const uint32_t slot = lzHash(sequence);
+    const uint32_t candidate = table[slot];
+    table[slot] = static_cast<uint32_t>(pos);
+    if (candidate == kLzEmptySlot || pos - candidate > kLzMaxOffset ||
+        readU32(bytes.data() + candidate) != sequence) {
+      ++pos;
+      continue;
+    }
+
+    size_t matchLength = kLzMinMatch;
+    while (pos + matchLength < bytes.size() &&
+           bytes[candidate + matchLength] == bytes[pos + matchLength]) {
+      ++matchLength;
+    }
+    lzWriteSequence(out, bytes.subspan(anchor, pos - anchor), pos - candidate,
+                    matchLength);
+    pos += matchLength;
+    anchor = pos;
+  }
+  lzWriteSequence(out, bytes.subspan(anchor), 0u, 0u);
+  return out;
+}
+
+Result<std::vector<std::byte>, std::string>
+assetArchiveDecompress(std::span<const std::byte> compressed,
+                       uint64_t sizeBytes) {
+  if (sizeBytes > static_cast<uint64_t>(std::numeric_limits<size_t>::max())) {
+    return makeError<std::vector<std::byte>>(
+        "assetArchiveDecompress: output too large");
+  }
+  std::vector<std::byte> out;
+  out.reserve(static_cast<size_t>(sizeBytes));
+
+  size_t pos = 0;
+  while (pos < compressed.size()) {
+    const uint32_t token = std::to_integer<uint32_t>(compressed[pos++]);
+    size_t literalLength = token >> 4u;
+    if (literalLength == kLzNibbleMax &&
+        !lzReadLength(compressed, pos, literalLength)) {
+      return makeError<std::vector<std::byte>>(
+          "assetArchiveDecompress: truncated literal length");
+    }
+    if (literalLength > compressed.size() - pos ||
+        literalLength > sizeBytes - out.size()) {
+      return makeError<std::vector<std::byte>>(
+          "assetArchiveDecompress: literals run past the block");
+    }
+    const auto literals = compressed.subspan(pos, literalLength);
+    out.insert(out.end(), literals.begin(), literals.end());
+    pos += literalLength;
+    if (pos == compressed.size()) {
+      break;
+    }
+
+    if (compressed.size() - pos < 2u) {
+      return makeError<std::vector<std::byte>>(
+          "assetArchiveDecompress: truncated match offset");
+    }
+    const size_t offset = std::to_integer<size_t>(compressed[pos]) |
+                          (std::to_integer<size_t>(compressed[pos + 1u]) << 8u);
+    pos += 2u;
+    size_t matchLength = token & kLzNibbleMax;
+    if (matchLength == kLzNibbleMax &&
+        !lzReadLength(compressed, pos, matchLength)) {
+      return makeError<std::vector<std::byte>>(
+          "assetArchiveDecompress: truncated match length");
+    }
+    matchLength += kLzMinMatch;
+    if (offset == 0u || offset > out.size() ||
+        matchLength > sizeBytes - out.size()) {
+      return makeError<std::vector<std::byte>>(
+          "assetArchiveDecompress: match out of range");
+    }
+    // Matches may overlap their own output, so copy byte by byte.
+    size_t from = out.size() - offset;
+    for (size_t i = 0; i < matchLength; ++i) {
+      out.push_back(out[from++]);
+    }
+  }
+
+  if (out.size() != sizeBytes) {
+    return makeError<std::vector<std::byte>>(
+        "assetArchiveDecompress: decoded " + std::to_string(out.size()) +
+        " bytes, expected " + std::to_string(sizeBytes));
+  }
+  return Result<std::vector<std::byte>, std::string>::makeResult(
+      std::move(out));
+}
+
+Result<AssetArchiveBuildStats, std::string>
+buildAssetArchive(const std::filesystem::path &sourceDirectory,
+                  const std::filesystem::path &outputPath,
+                  const AssetArchiveBuildOptions &options) {
+  NURI_PROFILER_FUNCTION();
+  if (options.dataAlignment == 0u ||
+      !std::has_single_bit(options.dataAlignment)) {
+    return makeError<AssetArchiveBuildStats>(
+        "buildAssetArchive: data alignment must be a power of two");
+  }
+  std::error_code ec;
+  if (!std::filesystem::is_directory(sourceDirectory, ec) || ec) {
+    return makeError<AssetArchiveBuildStats>(
+        "buildAssetArchive: '" + sourceDirectory.string() +
+        "' is not a directory");
+  }
+
+  const std::filesystem::path outputAbsolute =
+      std::filesystem::absolute(outputPath, ec).lexically_normal();
+  std::vector<std::filesystem::path> files;
+  for (std::filesystem::recursive_directory_iterator it(sourceDirectory, ec),
+       end;
+       !ec && it != end; it.increment(ec)) {
+    if (!it->is_regular_file(ec) || ec) {
+      continue;
+    }
+    const std::filesystem::path filePath = it->path();
+    if (std::filesystem::absolute(filePath, ec).lexically_normal() ==
+        outputAbsolute) {
+      continue;
+    }
+    files.push_back(filePath);
+  }
+  if (ec) {
+    return makeError<AssetArchiveBuildStats>(
+        "buildAssetArchive: failed to walk '" + sourceDirectory.string() +
+        "': " + ec.message());
+  }
+  // Sorted so archives are reproducible and directories stay contiguous,
+  // which keeps related entries close for batched reads.
+  std::sort(files.begin(), files.end());
+  if (files.size() > static_cast<size_t>(UINT32_MAX)) {
+    return makeError<AssetArchiveBuildStats>(
+        "buildAssetArchive: too many files");
+  }
+
+  const std::filesystem::path parent = outputPath.parent_path();
+  if (!parent.empty()) {
+    std::filesystem::create_directories(parent, ec);
+    if (ec) {
+      return makeError<AssetArchiveBuildStats>(
+          "buildAssetArchive: failed to create directory '" + parent.string() +
+          "': " + ec.message());
+    }
+  }
+  std::filesystem::path tempPath = outputPath;
+  tempPath += ".tmp";
+  std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+  if (!output.is_open()) {
+    return makeError<AssetArchiveBuildStats>(
+        "buildAssetArchive: failed to open '" + tempPath.string() + "'");
+  }
+
+  AssetArchiveHeader header{};
+  header.magic = kAssetArchiveMagic;
+  header.majorVersion = kAssetArchiveFormatMajorVersion;
+  header.minorVersion = kAssetArchiveFormatMinorVersion;
+  header.headerSize = sizeof(AssetArchiveHeader);
+  header.entrySize = sizeof(AssetArchiveEntry);
+  header.flags = kAssetArchiveHeaderFlagLittleEndian;
+  header.entryCount = static_cast<uint32_t>(files.size());
+  header.dataAlignment = options.dataAlignment;
+
+  const auto fail = [&](std::string message) {
+    output.close();
+    std::error_code removeError;
+    std::filesystem::remove(tempPath, removeError);
+    return makeError<AssetArchiveBuildStats>(std::move(message));
+  };
+
+  auto headerWrite = writeBytes(output, &header, sizeof(header), tempPath);
+  if (headerWrite.hasError()) {
+    return fail(headerWrite.error());
+  }
+
+  AssetArchiveBuildStats stats{};
+  std::vector<AssetArchiveEntry> entries;
+  std::vector<std::string> entryPaths;
+  entries.reserve(files.size());
+  entryPaths.reserve(files.size());
+  const std::vector<std::byte> padding(options.dataAlignment, std::byte{0});
+  uint64_t offset = sizeof(AssetArchiveHeader);
+  for (const std::filesystem::path &filePath : files) {
+    auto bytesResult = readBinaryFile(filePath);
+    if (bytesResult.hasError()) {
+      return fail("buildAssetArchive: " + bytesResult.error());
+    }
+    const std::vector<std::byte> &bytes = bytesResult.value();
+
+    std::string entryPath =
+        filePath.lexically_relative(sourceDirectory).generic_string();
+    AssetArchiveEntry entry{};
+    entry.pathHash = hashAssetArchivePath(entryPath);
+    entry.sizeBytes = bytes.size();
+
+    std::vector<std::byte> compressed;
+    if (options.compress && !bytes.empty()) {
+      compressed = assetArchiveCompress(bytes);
+      const double limit = static_cast<double>(bytes.size()) *
+                           (1.0 - options.minCompressionSavings);
+      if (static_cast<double>(compressed.size()) > limit) {
+        compressed.clear();
+        compressed.shrink_to_fit();
+      }
+    }
+    const bool storeCompressed = !compressed.empty();
+    const std::span<const std::byte> stored =
+        storeCompressed ? std::span<const std::byte>(compressed)
+                        : std::span<const std::byte>(bytes);
+    entry.compression = static_cast<uint32_t>(
+        storeCompressed ? AssetArchiveCompression::Lz
+                        : AssetArchiveCompression::None);
+    entry.storedSizeBytes = stored.size();
+
+    const uint64_t alignedOffset = alignUp(offset, options.dataAlignment);
+    auto padWrite = writeBytes(output, padding.data(),
+                               static_cast<size_t>(alignedOffset - offset),
+                               tempPath);
+    if (padWrite.hasError()) {
+      return fail(padWrite.error());
+    }
+    auto dataWrite = writeBytes(output, stored.data(), stored.size(), tempPath);
+    if (dataWrite.hasError()) {
+      return fail(dataWrite.error());
+    }
+    entry.dataOffset = alignedOffset;
+    offset = alignedOffset + stored.size();
+
+    stats.sourceBytes += bytes.size();
+    stats.compressedEntryCount += storeCompressed ? 1u : 0u;
+    entries.push_back(entry);
+    entryPaths.push_back(std::move(entryPath));
+  }
+
+  std::vector<uint32_t> order(entries.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return entryLess(entries[lhs], entryPaths[lhs], entries[rhs],
+                     entryPaths[rhs]);
+  });
+  std::string strings;
+  std::vector<AssetArchiveEntry> index;
+  index.reserve(entries.size());
+  for (const uint32_t entryIndex : order) {
+    AssetArchiveEntry entry = entries[entryIndex];
+    const std::string &entryPath = entryPaths[entryIndex];
+    if (strings.size() + entryPath.size() > UINT32_MAX) {
+      return fail("buildAssetArchive: path table too large");
+    }
+    entry.pathOffset = static_cast<uint32_t>(strings.size());
+    entry.pathLength = static_cast<uint32_t>(entryPath.size());
+    strings += entryPath;
+    index.push_back(entry);
+  }
+
+  header.indexOffset = offset;
+  header.stringsOffset = offset + index.size() * sizeof(AssetArchiveEntry);
+  header.stringsSizeBytes = strings.size();
+  header.fileSize = header.stringsOffset + header.stringsSizeBytes;
+  auto indexWrite =
+      writeBytes(output, index.data(), index.size() * sizeof(AssetArchiveEntry),
+                 tempPath);
+  if (indexWrite.hasError()) {
+    return fail(indexWrite.error());
+  }
+  auto stringsWrite =
+      writeBytes(output, strings.data(), strings.size(), tempPath);
+  if (stringsWrite.hasError()) {
+    return fail(stringsWrite.error());
+  }
+  output.seekp(0, std::ios::beg);
+  auto finalHeaderWrite =
+      writeBytes(output, &header, sizeof(header), tempPath);
+  if (finalHeaderWrite.hasError()) {
+    return fail(finalHeaderWrite.error());
+  }
+  output.close();
+  if (!output) {
+    return fail("buildAssetArchive: failed to finish '" + tempPath.string() +
+                "'");
+  }
+
+  std::filesystem::rename(tempPath, outputPath, ec);
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+    return makeError<AssetArchiveBuildStats>(
+        "buildAssetArchive: failed to move archive into place at '" +
+        outputPath.string() + "'");
+  }
+
+  stats.entryCount = header.entryCount;
+  stats.archiveBytes = header.fileSize;
+  return Result<AssetArchiveBuildStats, std::string>::makeResult(stats);
+}
+
+Result<std::unique_ptr<AssetArchive>, std::string>
+AssetArchive::open(const std::filesystem::path &path) {
+  NURI_PROFILER_FUNCTION();
+  std::unique_ptr<AssetArchive> archive(new AssetArchive());
+  archive->path_ = path;
+  archive->file_.open(path, std::ios::binary);
+  if (!archive->file_.is_open()) {
+    return makeError<std::unique_ptr<AssetArchive>>(
+        "AssetArchive::open: failed to open '" + path.string() + "'");
+  }
+
+  AssetArchiveHeader header{};
+  archive->file_.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (archive->file_.gcount() != static_cast<std::streamsize>(sizeof(header))) {
+    return makeError<std::unique_ptr<AssetArchive>>(
+        "AssetArchive::open: '" + path.string() + "' is too small");
+  }
+  if (header.magic != kAssetArchiveMagic ||
+      header.majorVersion != kAssetArchiveFormatMajorVersion ||
+      header.headerSize != sizeof(AssetArchiveHeader) ||
+      header.entrySize != sizeof(AssetArchiveEntry) ||
+      (header.flags & kAssetArchiveHeaderFlagLittleEndian) == 0u) {
+    return makeError<std::unique_ptr<AssetArchive>>(
+        "AssetArchive::open: '" + path.string() +
+        "' is not a supported asset archive");
+  }
+
+  std::error_code ec;
+  const uint64_t actualSize = std::filesystem::file_size(path, ec);
+  const uint64_t indexBytes =
+      static_cast<uint64_t>(header.entryCount) * sizeof(AssetArchiveEntry);
+  if (ec || actualSize != header.fileSize ||
+      header.indexOffset < sizeof(AssetArchiveHeader) ||
+      header.stringsOffset != header.indexOffset + indexBytes ||
+      header.stringsOffset + header.stringsSizeBytes != header.fileSize) {
+    return makeError<std::unique_ptr<AssetArchive>>(
+        "AssetArchive::open: '" + path.string() +
+        "' has an inconsistent layout");
+  }
+
+  // Index and path strings are adjacent: one read for both.
+  std::vector<std::byte> tail(
+      static_cast<size_t>(indexBytes + header.stringsSizeBytes));
+  archive->file_.seekg(static_cast<std::streamoff>(header.indexOffset));
+  archive->file_.read(reinterpret_cast<char *>(tail.data()),
+                      static_cast<std::streamsize>(tail.size()));
+  if (!archive->file_ ||
+      archive->file_.gcount() != static_cast<std::streamsize>(tail.size())) {
+    return makeError<std::unique_ptr<AssetArchive>>(
+        "AssetArchive::open: failed to read the index of '" + path.string() +
+        "'");
+  }
+  archive->entries_.resize(header.entryCount);
+  if (indexBytes > 0u) {
+    std::memcpy(archive->entries_.data(), tail.data(),
+                static_cast<size_t>(indexBytes));
+  }
+  archive->strings_.assign(
+      reinterpret_cast<const char *>(tail.data()) + indexBytes,
+      static_cast<size_t>(header.stringsSizeBytes));
+  archive->dataEnd_ = header.indexOffset;
+
+  for (const AssetArchiveEntry &entry : archive->entries_) {
+    const bool compressed = entry.compression ==
+                            static_cast<uint32_t>(AssetArchiveCompression::Lz);
+    const bool raw = entry.compression ==
+                     static_cast<uint32_t>(AssetArchiveCompression::None);
+    if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength >
+            archive->strings_.size() ||
+        entry.dataOffset > archive->dataEnd_ ||
+        entry.storedSizeBytes > archive->dataEnd_ - entry.dataOffset ||
+        (!compressed && !raw) ||
+        (raw && entry.storedSizeBytes != entry.sizeBytes)) {
+      return makeError<std::unique_ptr<AssetArchive>>(
+          "AssetArchive::open: '" + path.string() +
+          "' has a corrupt index entry");
+    }
+  }
+  return Result<std::unique_ptr<AssetArchive>, std::string>::makeResult(
+      std::move(archive));
+}
+
+AssetArchive::~AssetArchive() = default;
+
+std::string_view AssetArchive::entryPath(size_t index) const {
+  if (index >= entries_.size()) {
+    return {};
+  }
+  const AssetArchiveEntry &entry = entries_[index];
+  return std::string_view(strings_).substr(entry.pathOffset, entry.pathLength);
+}
+
+const AssetArchiveEntry *AssetArchive::find(std::string_view entryPath) const {
+  const uint64_t hash = hashAssetArchivePath(entryPath);
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), hash,
+      [](const AssetArchiveEntry &entry, uint64_t value) {
+        return entry.pathHash < value;
+      });
+  for (; it != entries_.end() && it->pathHash == hash; ++it) {
+    if (std::string_view(strings_).substr(it->pathOffset, it->pathLength) ==
+        entryPath) {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+bool AssetArchive::contains(std::string_view entryPath) const {
+  return find(entryPath) != nullptr;
+}
+
+std::optional<uint64_t>
+AssetArchive::entrySize(std::string_view entryPath) const {
+  const AssetArchiveEntry *entry = find(entryPath);
+  return entry != nullptr ? std::optional<uint64_t>(entry->sizeBytes)
+                          : std::nullopt;
+}
+
+Result<std::vector<std::byte>, std::string>
+AssetArchive::decodeEntry(const AssetArchiveEntry &entry,
+                          std::span<const std::byte> stored) const {
+  if (entry.compression ==
+      static_cast<uint32_t>(AssetArchiveCompression::None)) {
+    return Result<std::vector<std::byte>, std::string>::makeResult(
+        std::vector<std::byte>(stored.begin(), stored.end()));
+  }
+  auto decoded = assetArchiveDecompress(stored, entry.sizeBytes);
+  if (decoded.hasError()) {
+    return makeError<std::vector<std::byte>>(
+        "AssetArchive::read: '" +
+        std::string(strings_, entry.pathOffset, entry.pathLength) + "' in '" +
+        path_.string() + "': " + decoded.error());
+  }
+  return decoded;
+}
+
+Result<std::vector<std::byte>, std::string>
+AssetArchive::read(std::string_view entryPath) const {
+  const std::array<std::string_view, 1> paths = {entryPath};
+  auto batch = readBatch(paths);
+  if (batch.hasError()) {
+    return makeError<std::vector<std::byte>>(batch.error());
+  }
+  return Result<std::vector<std::byte>, std::string>::makeResult(
+      std::move(batch.value().front()));
+}
+
+Result<std::vector<std::vector<std::byte>>, std::string>
+AssetArchive::readBatch(std::span<const std::string_view> entryPaths) const {
+  NURI_PROFILER_FUNCTION();
+  using BatchResult = Result<std::vector<std::vector<std::byte>>, std::string>;
+  std::vector<const AssetArchiveEntry *> requested(entryPaths.size());
+  for (size_t i = 0; i < entryPaths.size(); ++i) {
+    requested[i] = find(entryPaths[i]);
+    if (requested[i] == nullptr) {
+      return BatchResult::makeError("AssetArchive::readBatch: '" +
+                                    std::string(entryPaths[i]) +
+                                    "' is not in '" + path_.string() + "'");
+    }
+  }
+
+  std::vector<size_t> order(requested.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return requested[lhs]->dataOffset < requested[rhs]->dataOffset;
+  });
+
+  std::vector<std::vector<std::byte>> results(requested.size());
+  std::vector<std::byte> staging;
+  size_t runBegin = 0;
+  while (runBegin < order.size()) {
+    const AssetArchiveEntry &first = *requested[order[runBegin]];
+    const uint64_t readBegin = first.dataOffset;
+    uint64_t readEnd = first.dataOffset + first.storedSizeBytes;
+    size_t runEnd = runBegin + 1u;
+    while (runEnd < order.size()) {
+      const AssetArchiveEntry &next = *requested[order[runEnd]];
+      const uint64_t nextEnd =
+          std::max(readEnd, next.dataOffset + next.storedSizeBytes);
+      if (next.dataOffset > readEnd + kMaxCoalesceGapBytes ||
+          nextEnd - readBegin > kMaxCoalescedReadBytes) {
+        break;
+      }
+      readEnd = nextEnd;
+      ++runEnd;
+    }
+
+    staging.resize(static_cast<size_t>(readEnd - readBegin));
+    {
+      std::scoped_lock lock(fileMutex_);
+      file_.clear();
+      file_.seekg(static_cast<std::streamoff>(readBegin));
+      file_.read(reinterpret_cast<char *>(staging.data()),
+                 static_cast<std::streamsize>(staging.size()));
+      if (!file_ ||
+          file_.gcount() != static_cast<std::streamsize>(staging.size())) {
+        return BatchResult::makeError("AssetArchive::readBatch: failed to read "
+                                      "from '" +
+                                      path_.string() + "'");
+      }
+    }
+
+    for (size_t i = runBegin; i < runEnd; ++i) {
+      const AssetArchiveEntry &entry = *requested[order[i]];
+      const std::span<const std::byte> stored(
+          staging.data() + (entry.dataOffset - readBegin),
+          static_cast<size_t>(entry.storedSizeBytes));
+      auto decoded = decodeEntry(entry, stored);
+      if (decoded.hasError()) {
+        return BatchResult::makeError(decoded.error());
+      }
+      results[order[i]] = std::move(decoded.value());
+    }
+    runBegin = runEnd;
+  }
+  return BatchResult::makeResult(std::move(results));
+}
+
+} // namespace nuri
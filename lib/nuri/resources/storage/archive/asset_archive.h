@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+#include "nuri/resources/storage/archive/asset_archive_format.h"
+
+namespace nuri {
+
+struct AssetArchiveBuildOptions {
+  // Power of two; page-sized by default so entries can later be read with
+  // unbuffered I/O.
+  uint32_t dataAlignment = 4096u;
+  bool compress = true;
+  // An entry is stored compressed only when that saves at least this
+  // fraction of its size; already-compressed formats (PNG, KTX2) stay raw.
+  float minCompressionSavings = 0.125f;
+};
+
+struct AssetArchiveBuildStats {
+  uint32_t entryCount = 0;
+  uint32_t compressedEntryCount = 0;
+  uint64_t sourceBytes = 0;
+  uint64_t archiveBytes = 0;
+};
+
+// Packs every regular file under sourceDirectory. Entry paths are relative
+// to sourceDirectory with '/' separators.
+[[nodiscard]] NURI_API Result<AssetArchiveBuildStats, std::string>
+buildAssetArchive(const std::filesystem::path &sourceDirectory,
+                  const std::filesystem::path &outputPath,
+                  const AssetArchiveBuildOptions &options = {});
+
+[[nodiscard]] NURI_API uint64_t hashAssetArchivePath(std::string_view path);
+
+[[nodiscard]] NURI_API std::vector<std::byte>
+assetArchiveCompress(std::span<const std::byte> bytes);
+[[nodiscard]] NURI_API Result<std::vector<std::byte>, std::string>
+assetArchiveDecompress(std::span<const std::byte> compressed,
+                       uint64_t sizeBytes);
+
+// Read-only view of an archive built by buildAssetArchive. The file stays
+// open for the archive's lifetime and all reads go through that one handle;
+// reads are serialized, so callers on several threads take turns.
+class NURI_API AssetArchive {
+public:
+  [[nodiscard]] static Result<std::unique_ptr<AssetArchive>, std::string>
+  open(const std::filesystem::path &path);
+
+  AssetArchive(const AssetArchive &) = delete;
+  AssetArchive &operator=(const AssetArchive &) = delete;
+  AssetArchive(AssetArchive &&) = delete;
+  AssetArchive &operator=(AssetArchive &&) = delete;
+  ~AssetArchive();
+
+  [[nodiscard]] const std::filesystem::path &path() const noexcept {
+    return path_;
+  }
+  [[nodiscard]] size_t entryCount() const noexcept { return entries_.size(); }
+  [[nodiscard]] std::string_view entryPath(size_t index) const;
+  [[nodiscard]] bool contains(std::string_view entryPath) const;
+  [[nodiscard]] std::optional<uint64_t>
+  entrySize(std::string_view entryPath) const;
+
+  [[nodiscard]] Result<std::vector<std::byte>, std::string>
+  read(std::string_view entryPath) const;
+  // Reads all entries in file order, merging neighbouring entries into one
+  // large read. Results are returned in request order; a missing entry fails
+  // the whole batch.
+  [[nodiscard]] Result<std::vector<std::vector<std::byte>>, std::string>
+  readBatch(std::span<const std::string_view> entryPaths) const;
+
+private:
+  AssetArchive() = default;
+
+  [[nodiscard]] const AssetArchiveEntry *find(std::string_view entryPath) const;
+  [[nodiscard]] Result<std::vector<std::byte>, std::string>
+  decodeEntry(const AssetArchiveEntry &entry,
+              std::span<const std::byte> stored) const;
+
+  std::filesystem::path path_;
+  std::vector<AssetArchiveEntry> entries_;
+  std::string strings_;
+  uint64_t dataEnd_ = 0;
+  mutable std::mutex fileMutex_;
+  mutable std::ifstream file_;
+};
+
+} // namespace nuri
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace nuri {
+
+constexpr uint16_t kAssetArchiveFormatMajorVersion = 1;
+constexpr uint16_t kAssetArchiveFormatMinorVersion = 0;
+
+constexpr std::array<char, 8> kAssetArchiveMagic = {'N', 'U', 'R', 'I',
+                                                    'P', 'A', 'K', '\0'};
+
+constexpr uint32_t kAssetArchiveHeaderFlagLittleEndian = 1u << 0u;
+
+enum class AssetArchiveCompression : uint32_t {
+  None = 0,
+  // Byte-oriented LZ77 block codec, see asset_archive.cpp.
+  Lz = 1,
+};
+
+// Layout: header, entry payloads (each starting on a dataAlignment
+// boundary), entry index sorted by (pathHash, path), path strings. The index
+// and strings are contiguous so opening an archive is one read.
+#pragma pack(push, 1)
+struct AssetArchiveHeader {
+  std::array<char, 8> magic{};
+  uint16_t majorVersion = 0;
+  uint16_t minorVersion = 0;
+  uint16_t headerSize = 0;
+  uint16_t entrySize = 0;
+  uint32_t flags = 0;
+  uint32_t entryCount = 0;
+  uint32_t dataAlignment = 0;
+  uint64_t fileSize = 0;
+  uint64_t indexOffset = 0;
+  uint64_t stringsOffset = 0;
+  uint64_t stringsSizeBytes = 0;
+  uint32_t reserved[4] = {0, 0, 0, 0};
+};
+
+struct AssetArchiveEntry {
+  // FNV-1a of the '/'-separated path relative to the packed directory.
+  uint64_t pathHash = 0;
+  uint32_t pathOffset = 0;
+  uint32_t pathLength = 0;
+  uint64_t dataOffset = 0;
+  uint64_t storedSizeBytes = 0;
+  uint64_t sizeBytes = 0;
+  uint32_t compression = 0;
+  uint32_t reserved = 0;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(AssetArchiveHeader) == 76);
+static_assert(sizeof(AssetArchiveEntry) == 48);
+static_assert(std::is_standard_layout_v<AssetArchiveHeader>);
+static_assert(std::is_standard_layout_v<AssetArchiveEntry>);
+static_assert(std::is_trivially_copyable_v<AssetArchiveHeader>);
+static_assert(std::is_trivially_copyable_v<AssetArchiveEntry>);
+
+} // namespace nuri
@@ -0,0 +1,163 @@
+#include "nuri/pch.h"
+
+#include "nuri/resources/storage/archive/asset_file_system.h"
+
+#include "nuri/core/log.h"
+#include "nuri/core/profiling.h"
+#include "nuri/resources/storage/archive/asset_archive.h"
+#include "nuri/resources/storage/mesh/mesh_cache_utils.h"
+
+#include <shared_mutex>
+
+namespace nuri {
+namespace {
+
+struct AssetArchiveMount {
+  std::filesystem::path root;
+  std::shared_ptr<const AssetArchive> archive;
+};
+
+struct AssetArchiveMounts {
+  std::shared_mutex mutex;
+  std::vector<AssetArchiveMount> mounts;
+};
+
+AssetArchiveMounts &assetArchiveMounts() {
+  static AssetArchiveMounts mounts;
+  return mounts;
+}
+
+[[nodiscard]] std::filesystem::path
+normalizeAssetPath(const std::filesystem::path &path) {
+  std::error_code ec;
+  std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+  return (ec ? path : absolute).lexically_normal();
+}
+
+struct ArchiveLookup {
+  std::shared_ptr<const AssetArchive> archive;
+  std::string entryPath;
+};
+
+// Returns the newest mount whose archive holds the path, or an empty lookup
+// when the path should be read from disk.
+[[nodiscard]] ArchiveLookup findInArchives(const std::filesystem::path &path) {
+  AssetArchiveMounts &state = assetArchiveMounts();
+  std::shared_lock lock(state.mutex);
+  if (state.mounts.empty()) {
+    return {};
+  }
+  const std::filesystem::path normalized = normalizeAssetPath(path);
+  for (auto it = state.mounts.rbegin(); it != state.mounts.rend(); ++it) {
+    const std::filesystem::path relative =
+        normalized.lexically_relative(it->root);
+    if (relative.empty() || *relative.begin() == "..") {
+      continue;
+    }
+    std::string entryPath = relative.generic_string();
+    if (it->archive->contains(entryPath)) {
+      return {it->archive, std::move(entryPath)};
+    }
+  }
+  return {};
+}
+
+} // namespace
+
+Result<bool, std::string>
+mountAssetArchive(const std::filesystem::path &archivePath,
+                  const std::filesystem::path &mountRoot) {
+  auto archiveResult = AssetArchive::open(archivePath);
+  if (archiveResult.hasError()) {
+    return Result<bool, std::string>::makeError(archiveResult.error());
+  }
+  std::shared_ptr<const AssetArchive> archive =
+      std::move(archiveResult.value());
+  NURI_LOG_INFO("mountAssetArchive: mounted '%s' (%zu entries) at '%s'",
+                archivePath.string().c_str(), archive->entryCount(),
+                mountRoot.string().c_str());
+
+  AssetArchiveMounts &state = assetArchiveMounts();
+  std::unique_lock lock(state.mutex);
+  state.mounts.push_back(
+      AssetArchiveMount{normalizeAssetPath(mountRoot), std::move(archive)});
+  return Result<bool, std::string>::makeResult(true);
+}
+
+void unmountAssetArchives() {
+  AssetArchiveMounts &state = assetArchiveMounts();
+  std::unique_lock lock(state.mutex);
+  state.mounts.clear();
+}
+
+size_t mountedAssetArchiveCount() {
+  AssetArchiveMounts &state = assetArchiveMounts();
+  std::shared_lock lock(state.mutex);
+  return state.mounts.size();
+}
+
+bool assetFileExists(const std::filesystem::path &path) {
+  if (findInArchives(path).archive) {
+    return true;
+  }
+  std::error_code ec;
+  return std::filesystem::is_regular_file(path, ec) && !ec;
+}
+
+Result<std::vector<std::byte>, std::string>
+readAssetFile(const std::filesystem::path &path) {
+  ArchiveLookup lookup = findInArchives(path);
+  if (lookup.archive) {
+    return lookup.archive->read(lookup.entryPath);
+  }
+  return readBinaryFile(path);
+}
+
+Result<std::vector<std::vector<std::byte>>, std::string>
+readAssetFiles(std::span<const std::filesystem::path> paths) {
+  NURI_PROFILER_FUNCTION();
+  using BatchResult = Result<std::vector<std::vector<std::byte>>, std::string>;
+  std::vector<std::vector<std::byte>> results(paths.size());
+
+  struct ArchiveBatch {
+    std::shared_ptr<const AssetArchive> archive;
+    std::vector<std::string> entryPaths;
+    std::vector<size_t> resultIndices;
+  };
+  std::vector<ArchiveBatch> batches;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    ArchiveLookup lookup = findInArchives(paths[i]);
+    if (!lookup.archive) {
+      auto bytes = readBinaryFile(paths[i]);
+      if (bytes.hasError()) {
+        return BatchResult::makeError("readAssetFiles: " + bytes.error());
+      }
+      results[i] = std::move(bytes.value());
+      continue;
+    }
+    auto batch = std::find_if(batches.begin(), batches.end(),
+                              [&](const ArchiveBatch &candidate) {
+                                return candidate.archive == lookup.archive;
+                              });
+    if (batch == batches.end()) {
+      batch = batches.insert(batches.end(), ArchiveBatch{lookup.archive});
+    }
+    batch->entryPaths.push_back(std::move(lookup.entryPath));
+    batch->resultIndices.push_back(i);
+  }
+
+  for (ArchiveBatch &batch : batches) {
+    const std::vector<std::string_view> entryPaths(batch.entryPaths.begin(),
+                                                   batch.entryPaths.end());
+    auto batchResult = batch.archive->readBatch(entryPaths);
+    if (batchResult.hasError()) {
+      return BatchResult::makeError("readAssetFiles: " + batchResult.error());
+    }
+    for (size_t i = 0; i < batch.resultIndices.size(); ++i) {
+      results[batch.resultIndices[i]] = std::move(batchResult.value()[i]);
+    }
+  }
+  return BatchResult::makeResult(std::move(results));
+}
+
+} // namespace nuri
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "nuri/core/result.h"
+#include "nuri/defines.h"
+
+namespace nuri {
+
+// Process-wide asset lookup. Files under a mounted archive's root are served
+// from the archive; anything the archive does not contain (or any path
+// outside every mount) is read from disk as before. Later mounts take
+// precedence over earlier ones.
+//
+// Every function here may be called from any thread. Reads look the mount
+// table up under a shared lock and keep the archive alive while reading, so
+// a concurrent unmount only decides whether a read is served packed or loose.
+[[nodiscard]] NURI_API Result<bool, std::string>
+mountAssetArchive(const std::filesystem::path &archivePath,
+                  const std::filesystem::path &mountRoot);
+NURI_API void unmountAssetArchives();
+[[nodiscard]] NURI_API size_t mountedAssetArchiveCount();
+
+[[nodiscard]] NURI_API bool assetFileExists(const std::filesystem::path &path);
+[[nodiscard]] NURI_API Result<std::vector<std::byte>, std::string>
+readAssetFile(const std::filesystem::path &path);
+// Archive-backed paths are grouped per archive and read with
+// AssetArchive::readBatch; results are returned in request order.
+[[nodiscard]] NURI_API Result<std::vector<std::vector<std::byte>>, std::string>
+readAssetFiles(std::span<const std::filesystem::path> paths);
+
+} // namespace nuri
@@ -5,6 +5,13 @@
 namespace nuri {
 namespace {
 
+constexpr uint8_t kVertexCodecV0Header = 0xa0u;
+constexpr size_t kVertexBlockSizeBytes = 8192u;
+constexpr size_t kVertexBlockMaxVertices = 256u;
+constexpr size_t kVertexByteGroupSize = 16u;
+constexpr size_t kVertexTailMinSize = 32u;
+constexpr size_t kVertexMaxStrideBytes = 256u;
+
 template <typename T>
 [[nodiscard]] Result<std::vector<std::byte>, std::string>
 makeCodecError(T &&message) {
@@ -45,6 +52,7 @@ meshBinaryEncodeVertexBuffer(std::span<const std::byte> vertexBytes,
   const size_t encodedBound =
       meshopt_encodeVertexBufferBound(vertexCount, vertexStrideBytes);
   std::vector<std::byte> encoded(encodedBound);
+  meshopt_encodeVertexVersion(0);
   const size_t encodedSize = meshopt_encodeVertexBuffer(
       reinterpret_cast<unsigned char *>(encoded.data()), encoded.size(),
       vertexBytes.data(), vertexCount, vertexStrideBytes);
@@ -91,6 +99,96 @@ meshBinaryDecodeVertexBuffer(std::span<const std::byte> encodedBytes,
       std::move(decoded));
 }
 
+Result<MeshBinaryVertexDecodePlan, std::string>
+meshBinaryPlanVertexDecode(std::span<const std::byte> encodedBytes,
+                           uint32_t vertexCount, uint32_t vertexStrideBytes) {
+  using PlanResult = Result<MeshBinaryVertexDecodePlan, std::string>;
+  if (vertexStrideBytes == 0 || vertexStrideBytes > kVertexMaxStrideBytes ||
+      (vertexStrideBytes % sizeof(uint32_t)) != 0u) {
+    return PlanResult::makeError(
+        "meshBinaryPlanVertexDecode: unsupported vertex stride");
+  }
+  const size_t tailSize =
+      std::max(kVertexTailMinSize, static_cast<size_t>(vertexStrideBytes));
+  if (encodedBytes.size() < 1u + tailSize ||
+      encodedBytes.size() > std::numeric_limits<uint32_t>::max()) {
+    return PlanResult::makeError(
+        "meshBinaryPlanVertexDecode: encoded vertex stream size is invalid");
+  }
+  const auto byteAt = [&encodedBytes](size_t offset) {
+    return std::to_integer<uint32_t>(encodedBytes[offset]);
+  };
+  if (byteAt(0) != kVertexCodecV0Header) {
+    return PlanResult::makeError(
+        "meshBinaryPlanVertexDecode: stream is not encoded with codec v0");
+  }
+
+  MeshBinaryVertexDecodePlan plan{};
+  plan.blockVertexCount = static_cast<uint32_t>(
+      std::min((kVertexBlockSizeBytes / vertexStrideBytes) &
+                   ~(kVertexByteGroupSize - 1u),
+               kVertexBlockMaxVertices));
+  plan.blockCount =
+      (vertexCount + plan.blockVertexCount - 1u) / plan.blockVertexCount;
+  plan.channelOffsets.reserve(static_cast<size_t>(plan.blockCount) *
+                              vertexStrideBytes);
+  plan.tailOffset =
+      static_cast<uint32_t>(encodedBytes.size() - vertexStrideBytes);
+
+  const size_t dataEnd = encodedBytes.size() - tailSize;
+  size_t cursor = 1u;
+  for (uint32_t block = 0; block < plan.blockCount; ++block) {
+    const uint32_t firstVertex = block * plan.blockVertexCount;
+    const size_t blockVertices =
+        std::min(plan.blockVertexCount, vertexCount - firstVertex);
+    const size_t groupCount =
+        (blockVertices + kVertexByteGroupSize - 1u) / kVertexByteGroupSize;
+    const size_t headerSize = (groupCount + 3u) / 4u;
+    for (uint32_t channel = 0; channel < vertexStrideBytes; ++channel) {
+      if (dataEnd - cursor < headerSize) {
+        return PlanResult::makeError(
+            "meshBinaryPlanVertexDecode: truncated channel header");
+      }
+      plan.channelOffsets.push_back(static_cast<uint32_t>(cursor));
+      const size_t header = cursor;
+      cursor += headerSize;
+      for (size_t group = 0; group < groupCount; ++group) {
+        const uint32_t bitsLog2 =
+            (byteAt(header + group / 4u) >> ((group % 4u) * 2u)) & 3u;
+        size_t groupSize = 0;
+        if (bitsLog2 == 3u) {
+          groupSize = kVertexByteGroupSize;
+        } else if (bitsLog2 != 0u) {
+          const uint32_t bits = 1u << bitsLog2;
+          const uint32_t sentinel = (1u << bits) - 1u;
+          const size_t packedSize = kVertexByteGroupSize * bits / 8u;
+          if (dataEnd - cursor < packedSize) {
+            return PlanResult::makeError(
+                "meshBinaryPlanVertexDecode: truncated byte group");
+          }
+          groupSize = packedSize;
+          for (size_t i = 0; i < packedSize; ++i) {
+            const uint32_t packed = byteAt(cursor + i);
+            for (uint32_t shift = 0; shift < 8u; shift += bits) {
+              groupSize += ((packed >> shift) & sentinel) == sentinel ? 1u : 0u;
+            }
+          }
+        }
+        if (dataEnd - cursor < groupSize) {
+          return PlanResult::makeError(
+              "meshBinaryPlanVertexDecode: truncated byte group");
+        }
+        cursor += groupSize;
+      }
+    }
+  }
+  if (cursor != dataEnd) {
+    return PlanResult::makeError(
+        "meshBinaryPlanVertexDecode: unexpected data after the last block");
+  }
+  return PlanResult::makeResult(std::move(plan));
+}
+
 Result<std::vector<std::byte>, std::string>
 meshBinaryEncodeIndexBuffer(std::span<const uint32_t> indices,
                             uint32_t vertexCount) {
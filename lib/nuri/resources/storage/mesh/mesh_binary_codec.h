@@ -7,23 +7,44 @@
 #include <vector>
 
 #include "nuri/core/result.h"
+#include "nuri/defines.h"
 
 namespace nuri {
 
-[[nodiscard]] Result<std::vector<std::byte>, std::string>
+// Block layout of an encoded vertex stream, enough for blocks to be decoded
+// independently on the GPU. Only the meshopt v0 vertex codec is described.
+struct NURI_API MeshBinaryVertexDecodePlan {
+  uint32_t blockVertexCount = 0;
+  uint32_t blockCount = 0;
+  // Byte offset of each byte channel, indexed [block * stride + channel].
+  std::vector<uint32_t> channelOffsets;
+  // Byte offset of the raw first vertex stored at the end of the stream.
+  uint32_t tailOffset = 0;
+};
+
+// Vertex streams are always written with the v0 codec so they stay decodable
+// by meshBinaryPlanVertexDecode.
+[[nodiscard]] NURI_API Result<std::vector<std::byte>, std::string>
 meshBinaryEncodeVertexBuffer(std::span<const std::byte> vertexBytes,
                              uint32_t vertexStrideBytes);
 
-[[nodiscard]] Result<std::vector<std::byte>, std::string>
+[[nodiscard]] NURI_API Result<std::vector<std::byte>, std::string>
 meshBinaryDecodeVertexBuffer(std::span<const std::byte> encodedBytes,
                              uint32_t vertexCount,
                              uint32_t vertexStrideBytes);
 
-[[nodiscard]] Result<std::vector<std::byte>, std::string>
+// Walks every block of an encoded stream without decoding it. Fails for
+// streams that were not written with the v0 codec, strides that are not a
+// multiple of 4 and truncated or trailing data.
+[[nodiscard]] NURI_API Result<MeshBinaryVertexDecodePlan, std::string>
+meshBinaryPlanVertexDecode(std::span<const std::byte> encodedBytes,
+                           uint32_t vertexCount, uint32_t vertexStrideBytes);
+
+[[nodiscard]] NURI_API Result<std::vector<std::byte>, std::string>
 meshBinaryEncodeIndexBuffer(std::span<const uint32_t> indices,
                             uint32_t vertexCount);
 
-[[nodiscard]] Result<std::vector<std::byte>, std::string>
+[[nodiscard]] NURI_API Result<std::vector<std::byte>, std::string>
 meshBinaryDecodeIndexBuffer(std::span<const std::byte> encodedBytes,
                             uint32_t indexCount, uint32_t indexStrideBytes);
 
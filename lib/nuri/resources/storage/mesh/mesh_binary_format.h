@@ -7,7 +7,7 @@
 namespace nuri {
 
 constexpr uint16_t kMeshBinaryFormatMajorVersion = 1;
-constexpr uint16_t kMeshBinaryFormatMinorVersion = 0;
+constexpr uint16_t kMeshBinaryFormatMinorVersion = 1;
 
 constexpr std::array<char, 8> kMeshBinaryMagic = {'N', 'U', 'R', 'I',
                                                   'M', 'S', 'H', '\0'};
@@ -30,6 +30,8 @@ constexpr uint32_t kMeshBinarySectionSmes =
     makeMeshBinaryFourCC('S', 'M', 'E', 'S');
 constexpr uint32_t kMeshBinarySectionLods =
     makeMeshBinaryFourCC('L', 'O', 'D', 'S');
+constexpr uint32_t kMeshBinarySectionClus =
+    makeMeshBinaryFourCC('C', 'L', 'U', 'S');
 constexpr uint32_t kMeshBinarySectionVbuf =
     makeMeshBinaryFourCC('V', 'B', 'U', 'F');
 constexpr uint32_t kMeshBinarySectionIbuf =
@@ -93,7 +95,8 @@ struct MeshBinarySubmeshRecord {
   uint32_t layoutId = kMeshBinaryLayoutIdPacked32;
   float boundsMin[3] = {0.0f, 0.0f, 0.0f};
   float boundsMax[3] = {0.0f, 0.0f, 0.0f};
-  uint32_t reserved[2] = {0, 0};
+  uint32_t clusterFirst = 0;
+  uint32_t clusterCount = 0;
 };
 
 struct MeshBinaryLodRecord {
@@ -103,6 +106,15 @@ struct MeshBinaryLodRecord {
   uint32_t reserved = 0;
 };
 
+struct MeshBinaryClusterRecord {
+  uint32_t indexOffset = 0;
+  uint32_t indexCount = 0;
+  float error = 0.0f;
+  float parentError = 0.0f;
+  float bounds[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  float parentBounds[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+};
+
 struct MeshBinaryBufferSectionHeader {
   uint32_t elementCount = 0;
   uint32_t elementStrideBytes = 0;
@@ -115,18 +127,21 @@ static_assert(sizeof(MeshBinarySectionTocEntry) == 32);
 static_assert(sizeof(MeshBinaryVertexLayoutRecord) == 16);
 static_assert(sizeof(MeshBinarySubmeshRecord) == 48);
 static_assert(sizeof(MeshBinaryLodRecord) == 16);
+static_assert(sizeof(MeshBinaryClusterRecord) == 48);
 static_assert(sizeof(MeshBinaryBufferSectionHeader) == 16);
 static_assert(std::is_standard_layout_v<MeshBinaryHeader>);
 static_assert(std::is_standard_layout_v<MeshBinarySectionTocEntry>);
 static_assert(std::is_standard_layout_v<MeshBinaryVertexLayoutRecord>);
 static_assert(std::is_standard_layout_v<MeshBinarySubmeshRecord>);
 static_assert(std::is_standard_layout_v<MeshBinaryLodRecord>);
+static_assert(std::is_standard_layout_v<MeshBinaryClusterRecord>);
 static_assert(std::is_standard_layout_v<MeshBinaryBufferSectionHeader>);
 static_assert(std::is_trivially_copyable_v<MeshBinaryHeader>);
 static_assert(std::is_trivially_copyable_v<MeshBinarySectionTocEntry>);
 static_assert(std::is_trivially_copyable_v<MeshBinaryVertexLayoutRecord>);
 static_assert(std::is_trivially_copyable_v<MeshBinarySubmeshRecord>);
 static_assert(std::is_trivially_copyable_v<MeshBinaryLodRecord>);
+static_assert(std::is_trivially_copyable_v<MeshBinaryClusterRecord>);
 static_assert(std::is_trivially_copyable_v<MeshBinaryBufferSectionHeader>);
 
 } // namespace nuri
@@ -215,6 +215,8 @@ buildSubmeshAndLodSections(std::span<const Submesh> submeshes) {
     submeshRecord.boundsMax[0] = submesh.bounds.max_.x;
     submeshRecord.boundsMax[1] = submesh.bounds.max_.y;
     submeshRecord.boundsMax[2] = submesh.bounds.max_.z;
+    submeshRecord.clusterFirst = submesh.clusterOffset;
+    submeshRecord.clusterCount = submesh.clusterCount;
     appendPod(submeshSection.payload, submeshRecord);
 
     for (uint32_t lodIndex = 0; lodIndex < submesh.lodCount; ++lodIndex) {
@@ -240,6 +242,32 @@ buildSubmeshAndLodSections(std::span<const Submesh> submeshes) {
           std::make_pair(std::move(submeshSection), std::move(lodSection)));
 }
 
+[[nodiscard]] Result<SerializedSection, std::string>
+buildClusterSection(std::span<const MeshCluster> clusters) {
+  SerializedSection section{};
+  section.fourcc = kMeshBinarySectionClus;
+  section.flags = 0;
+  if (clusters.size() > std::numeric_limits<uint32_t>::max()) {
+    return makeSerializerError<SerializedSection>(
+        "meshBinarySerialize: cluster count exceeds uint32");
+  }
+  section.count = static_cast<uint32_t>(clusters.size());
+  section.stride = sizeof(MeshBinaryClusterRecord);
+  for (const MeshCluster &cluster : clusters) {
+    MeshBinaryClusterRecord record{};
+    record.indexOffset = cluster.indexOffset;
+    record.indexCount = cluster.indexCount;
+    record.error = cluster.error;
+    record.parentError = cluster.parentError;
+    for (int i = 0; i < 4; ++i) {
+      record.bounds[i] = cluster.bounds[i];
+      record.parentBounds[i] = cluster.parentBounds[i];
+    }
+    appendPod(section.payload, record);
+  }
+  return Result<SerializedSection, std::string>::makeResult(std::move(section));
+}
+
 [[nodiscard]] Result<SerializedSection, std::string>
 buildVertexBufferSection(std::span<const std::byte> packedVertexBytes,
                          uint32_t vertexCount, uint32_t vertexStrideBytes) {
@@ -395,6 +423,21 @@ meshBinarySerialize(const MeshBinarySerializeInput &input) {
             "meshBinarySerialize: submesh index range out of bounds");
       }
     }
+    uint64_t clusterEnd = 0;
+    if (!checkedAddToU64(submesh.clusterOffset, submesh.clusterCount,
+                         clusterEnd) ||
+        clusterEnd > input.clusters.size()) {
+      return makeSerializerError<std::vector<std::byte>>(
+          "meshBinarySerialize: submesh cluster range out of bounds");
+    }
+  }
+  for (const MeshCluster &cluster : input.clusters) {
+    uint64_t rangeEnd = 0;
+    if (!checkedAddToU64(cluster.indexOffset, cluster.indexCount, rangeEnd) ||
+        rangeEnd > input.indices.size()) {
+      return makeSerializerError<std::vector<std::byte>>(
+          "meshBinarySerialize: cluster index range out of bounds");
+    }
   }
 
   const size_t vertexCountFromBytes =
@@ -406,7 +449,7 @@ meshBinarySerialize(const MeshBinarySerializeInput &input) {
   }
 
   std::pmr::vector<SerializedSection> sections(scopedScratch.resource());
-  sections.reserve(5);
+  sections.reserve(6);
 
   auto vlayResult = buildVertexLayoutSection();
   if (vlayResult.hasError()) {
@@ -422,6 +465,12 @@ meshBinarySerialize(const MeshBinarySerializeInput &input) {
   sections.push_back(std::move(smesLodsSections.first));
   sections.push_back(std::move(smesLodsSections.second));
 
+  auto clusResult = buildClusterSection(input.clusters);
+  if (clusResult.hasError()) {
+    return makeSerializerError<std::vector<std::byte>>(clusResult.error());
+  }
+  sections.push_back(std::move(clusResult.value()));
+
   auto vbufResult = buildVertexBufferSection(
       input.packedVertexBytes, input.vertexCount, input.vertexStrideBytes);
   if (vbufResult.hasError()) {
@@ -625,6 +674,12 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
     return makeSerializerError<MeshBinaryDecodedMesh>(
         lodsSectionResult.error());
   }
+  auto clusSectionResult =
+      findRequiredSection(toc, kMeshBinarySectionClus, "CLUS");
+  if (clusSectionResult.hasError()) {
+    return makeSerializerError<MeshBinaryDecodedMesh>(
+        clusSectionResult.error());
+  }
   auto vbufSectionResult =
       findRequiredSection(toc, kMeshBinarySectionVbuf, "VBUF");
   if (vbufSectionResult.hasError()) {
@@ -641,6 +696,7 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
   const MeshBinarySectionTocEntry &vlayEntry = *vlaySectionResult.value();
   const MeshBinarySectionTocEntry &smesEntry = *smesSectionResult.value();
   const MeshBinarySectionTocEntry &lodsEntry = *lodsSectionResult.value();
+  const MeshBinarySectionTocEntry &clusEntry = *clusSectionResult.value();
   const MeshBinarySectionTocEntry &vbufEntry = *vbufSectionResult.value();
   const MeshBinarySectionTocEntry &ibufEntry = *ibufSectionResult.value();
 
@@ -659,6 +715,11 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
     return makeSerializerError<MeshBinaryDecodedMesh>(
         "meshBinaryDeserialize: invalid LODS stride");
   }
+  if (clusEntry.stride != sizeof(MeshBinaryClusterRecord) ||
+      !sectionSizeMatchesCountStride(clusEntry)) {
+    return makeSerializerError<MeshBinaryDecodedMesh>(
+        "meshBinaryDeserialize: invalid CLUS stride");
+  }
   if (vbufEntry.count != 1 ||
       vbufEntry.stride != sizeof(MeshBinaryBufferSectionHeader)) {
     return makeSerializerError<MeshBinaryDecodedMesh>(
@@ -723,11 +784,24 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
           sizeof(MeshBinaryBufferSectionHeader),
       ibufMeta.encodedSizeBytes);
 
-  auto decodedVerticesResult = meshBinaryDecodeVertexBuffer(
-      encodedVertices, vbufMeta.elementCount, vbufMeta.elementStrideBytes);
-  if (decodedVerticesResult.hasError()) {
-    return makeSerializerError<MeshBinaryDecodedMesh>(
-        decodedVerticesResult.error());
+  // Streams the GPU decoder cannot handle fall back to the CPU decode.
+  std::optional<MeshBinaryVertexDecodePlan> vertexDecodePlan;
+  if (context.keepEncodedVertices) {
+    auto planResult = meshBinaryPlanVertexDecode(
+        encodedVertices, vbufMeta.elementCount, vbufMeta.elementStrideBytes);
+    if (!planResult.hasError()) {
+      vertexDecodePlan = std::move(planResult.value());
+    }
+  }
+  std::vector<std::byte> decodedVertexBytes;
+  if (!vertexDecodePlan) {
+    auto decodedVerticesResult = meshBinaryDecodeVertexBuffer(
+        encodedVertices, vbufMeta.elementCount, vbufMeta.elementStrideBytes);
+    if (decodedVerticesResult.hasError()) {
+      return makeSerializerError<MeshBinaryDecodedMesh>(
+          decodedVerticesResult.error());
+    }
+    decodedVertexBytes = std::move(decodedVerticesResult.value());
   }
   auto decodedIndicesResult = meshBinaryDecodeIndexBuffer(
       encodedIndices, ibufMeta.elementCount, ibufMeta.elementStrideBytes);
@@ -748,9 +822,21 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
     return makeSerializerError<MeshBinaryDecodedMesh>(
         "meshBinaryDeserialize: failed to read LOD records");
   }
+  std::pmr::vector<MeshBinaryClusterRecord> clusterRecords(
+      scopedScratch.resource());
+  if (!readPodArray(fileBytes, clusEntry.offset, clusEntry.count,
+                    clusterRecords)) {
+    return makeSerializerError<MeshBinaryDecodedMesh>(
+        "meshBinaryDeserialize: failed to read cluster records");
+  }
 
   MeshBinaryDecodedMesh decoded{};
-  decoded.packedVertexBytes = std::move(decodedVerticesResult.value());
+  decoded.packedVertexBytes = std::move(decodedVertexBytes);
+  if (vertexDecodePlan) {
+    decoded.encodedVertexBytes.assign(encodedVertices.begin(),
+                                      encodedVertices.end());
+    decoded.vertexDecodePlan = std::move(*vertexDecodePlan);
+  }
   decoded.vertexCount = vbufMeta.elementCount;
   decoded.vertexStrideBytes = vbufMeta.elementStrideBytes;
   decoded.bounds =
@@ -792,6 +878,15 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
                     glm::vec3(record.boundsMax[0], record.boundsMax[1],
                               record.boundsMax[2]));
     submesh.lodCount = record.lodCount;
+    uint64_t clusterEnd = 0;
+    if (!checkedAddToU64(record.clusterFirst, record.clusterCount,
+                         clusterEnd) ||
+        clusterEnd > clusterRecords.size()) {
+      return makeSerializerError<MeshBinaryDecodedMesh>(
+          "meshBinaryDeserialize: submesh cluster range out of bounds");
+    }
+    submesh.clusterOffset = record.clusterFirst;
+    submesh.clusterCount = record.clusterCount;
 
     for (uint32_t lodIndex = 0; lodIndex < record.lodCount; ++lodIndex) {
       const MeshBinaryLodRecord &lodRecord =
@@ -817,6 +912,28 @@ meshBinaryDeserialize(std::span<const std::byte> fileBytes,
     decoded.submeshes.push_back(submesh);
   }
 
+  decoded.clusters.reserve(clusterRecords.size());
+  for (const MeshBinaryClusterRecord &record : clusterRecords) {
+    uint64_t indexRangeEnd = 0;
+    if (!checkedAddToU64(record.indexOffset, record.indexCount,
+                         indexRangeEnd) ||
+        indexRangeEnd > decoded.indices.size()) {
+      return makeSerializerError<MeshBinaryDecodedMesh>(
+          "meshBinaryDeserialize: cluster index range out of bounds");
+    }
+    decoded.clusters.push_back(MeshCluster{
+        .indexOffset = record.indexOffset,
+        .indexCount = record.indexCount,
+        .error = record.error,
+        .parentError = record.parentError,
+        .bounds = glm::vec4(record.bounds[0], record.bounds[1],
+                            record.bounds[2], record.bounds[3]),
+        .parentBounds =
+            glm::vec4(record.parentBounds[0], record.parentBounds[1],
+                      record.parentBounds[2], record.parentBounds[3]),
+    });
+  }
+
   return Result<MeshBinaryDecodedMesh, MeshBinaryDeserializeError>::makeResult(
       std::move(decoded));
 }
@@ -9,6 +9,7 @@
 #include "nuri/core/result.h"
 #include "nuri/math/types.h"
 #include "nuri/resources/cpu/mesh_data.h"
+#include "nuri/resources/storage/mesh/mesh_binary_codec.h"
 
 namespace nuri {
 
@@ -23,6 +24,7 @@ struct MeshBinarySerializeInput {
   uint32_t vertexStrideBytes = 0;
   std::span<const uint32_t> indices{};
   std::span<const Submesh> submeshes{};
+  std::span<const MeshCluster> clusters{};
 };
 
 struct MeshBinaryDeserializeContext {
@@ -32,14 +34,20 @@ struct MeshBinaryDeserializeContext {
   bool sourceExists = false;
   uint64_t sourceSizeBytes = 0;
   int64_t sourceMtimeNs = 0;
+  // Keep v0 vertex streams encoded for GPU decode instead of decoding them.
+  bool keepEncodedVertices = false;
 };
 
 struct MeshBinaryDecodedMesh {
+  // Empty when the vertex stream was kept encoded.
   std::vector<std::byte> packedVertexBytes;
+  std::vector<std::byte> encodedVertexBytes;
+  MeshBinaryVertexDecodePlan vertexDecodePlan;
   uint32_t vertexCount = 0;
   uint32_t vertexStrideBytes = 0;
   std::vector<uint32_t> indices;
   std::vector<Submesh> submeshes;
+  std::vector<MeshCluster> clusters;
   BoundingBox bounds{glm::vec3(0.0f), glm::vec3(0.0f)};
 };
 
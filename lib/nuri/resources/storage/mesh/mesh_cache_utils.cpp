@@ -9,7 +9,7 @@ namespace {
 
 constexpr uint64_t kFnvOffsetBasis = 1469598103934665603ull;
 constexpr uint64_t kFnvPrime = 1099511628211ull;
-constexpr uint32_t kMeshCacheContentVersion = 6u;
+constexpr uint32_t kMeshCacheContentVersion = 7u;
 
 void fnv1aAddByte(uint64_t &hash, uint8_t byte) {
   hash ^= byte;
@@ -75,6 +75,8 @@ uint64_t hashMeshImportOptions(const MeshImportOptions &options) {
     fnv1aAddPod(hash, bits);
   }
   fnv1aAddPod(hash, std::bit_cast<uint32_t>(options.lodTargetError));
+  addBool(options.generateClusterLod);
+  fnv1aAddPod(hash, options.clusterLodMinTriangles);
 
   return hash;
 }
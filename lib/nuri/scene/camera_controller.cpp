@@ -11,6 +11,8 @@ namespace {
 constexpr float kEpsilon = 1e-6f;
 constexpr float kMinDamping = 0.001f;
 constexpr float kMinMoveToDurationSeconds = 0.0001f;
+// Below 1 mm/s the damped drift is invisible.
+constexpr float kRestSpeedSq = 1e-6f;
 constexpr float kTwoPi = glm::two_pi<float>();
 constexpr std::array<Key, 8> kMovementKeys = {
     Key::W, Key::S, Key::A,         Key::D,
@@ -463,6 +465,10 @@ void CameraController::reset() {
   NURI_LOG_DEBUG("CameraController::reset: Controller state reset");
 }
 
+bool CameraController::isMoving() const noexcept {
+  return isMoveToActive() || glm::dot(velocity_, velocity_) > kRestSpeedSq;
+}
+
 CameraController makeFpsDirectController(const CameraControllerConfig &config) {
   CameraController controller(config);
   controller.setPreset(CameraPreset::FpsDirect);
@@ -70,6 +70,8 @@ public:
   [[nodiscard]] bool isMoveToActive() const noexcept {
     return moveTo_.active || moveTo_.queued;
   }
+  // True while a MoveTo runs or damped velocity is still carrying the camera.
+  [[nodiscard]] bool isMoving() const noexcept;
 
 private:
   struct MovementState {
@@ -15,6 +15,7 @@ void forEachEnvironmentTextureRef(const EnvironmentHandles &handles, Fn &&fn) {
   fn(handles.prefilteredGgx);
   fn(handles.prefilteredCharlie);
   fn(handles.brdfLut);
+  fn(handles.irradianceVolume.texture);
 }
 
 } // namespace
@@ -29,7 +30,8 @@ RenderScene::~RenderScene() {
 
 Result<uint32_t, std::string>
 RenderScene::addRenderable(ModelRef model, MaterialRef material,
-                           const glm::mat4 &modelMatrix) {
+                           const glm::mat4 &modelMatrix,
+                           RenderableMobility mobility) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
   if (!isValid(model)) {
     return Result<uint32_t, std::string>::makeError(
@@ -59,18 +61,19 @@ RenderScene::addRenderable(ModelRef model, MaterialRef material,
   renderable.model = model;
   renderable.material = material;
   renderable.modelMatrix = modelMatrix;
+  renderable.mobility = mobility;
 
   renderables_.emplace_back(renderable);
   retainRenderable(renderable);
-  ++topologyVersion_;
-  ++transformVersion_;
+  bumpTopologyVersion();
   return Result<uint32_t, std::string>::makeResult(
       static_cast<uint32_t>(renderables_.size() - 1));
 }
 
 Result<uint32_t, std::string>
 RenderScene::addRenderablesInstanced(ModelRef model, MaterialRef material,
-                                     std::span<const glm::mat4> modelMatrices) {
+                                     std::span<const glm::mat4> modelMatrices,
+                                     RenderableMobility mobility) {
   NURI_PROFILER_FUNCTION_COLOR(NURI_PROFILER_COLOR_CREATE);
   if (!isValid(model)) {
     return Result<uint32_t, std::string>::makeError(
@@ -116,11 +119,11 @@ RenderScene::addRenderablesInstanced(ModelRef model, MaterialRef material,
     renderable.model = model;
     renderable.material = material;
     renderable.modelMatrix = modelMatrix;
+    renderable.mobility = mobility;
     retainRenderable(renderable);
     renderables_.push_back(renderable);
   }
-  ++topologyVersion_;
-  ++transformVersion_;
+  bumpTopologyVersion();
   return Result<uint32_t, std::string>::makeResult(
       static_cast<uint32_t>(startIndex));
 }
@@ -133,6 +136,23 @@ bool RenderScene::setRenderableTransform(uint32_t index,
   }
   renderables_[index].modelMatrix = modelMatrix;
   ++transformVersion_;
+  if (renderables_[index].mobility == RenderableMobility::Dynamic) {
+    ++dynamicTransformVersion_;
+  } else {
+    ++staticTransformVersion_;
+  }
+  return true;
+}
+
+bool RenderScene::setRenderableMobility(uint32_t index,
+                                        RenderableMobility mobility) {
+  if (index >= renderables_.size()) {
+    return false;
+  }
+  if (renderables_[index].mobility != mobility) {
+    renderables_[index].mobility = mobility;
+    bumpTopologyVersion();
+  }
   return true;
 }
 
@@ -152,8 +172,7 @@ void RenderScene::clearRenderables() {
     releaseRenderable(renderable);
   }
   renderables_.clear();
-  ++topologyVersion_;
-  ++transformVersion_;
+  bumpTopologyVersion();
 }
 
 void RenderScene::bindResources(ResourceManager *resources) {
@@ -188,8 +207,7 @@ void RenderScene::bindResources(ResourceManager *resources) {
 
   if (writeIndex != renderables_.size()) {
     renderables_.resize(writeIndex);
-    ++topologyVersion_;
-    ++transformVersion_;
+    bumpTopologyVersion();
   }
 
   const auto sanitizeTextureRef = [this](TextureRef &ref) {
@@ -202,6 +220,7 @@ void RenderScene::bindResources(ResourceManager *resources) {
   sanitizeTextureRef(environment_.prefilteredGgx);
   sanitizeTextureRef(environment_.prefilteredCharlie);
   sanitizeTextureRef(environment_.brdfLut);
+  sanitizeTextureRef(environment_.irradianceVolume.texture);
   retainEnvironment(environment_);
 }
 
@@ -235,6 +254,12 @@ void RenderScene::setEnvironment(EnvironmentHandles handles) {
   updateTextureRef(environment_.prefilteredGgx, handles.prefilteredGgx);
   updateTextureRef(environment_.prefilteredCharlie, handles.prefilteredCharlie);
   updateTextureRef(environment_.brdfLut, handles.brdfLut);
+  updateTextureRef(environment_.irradianceVolume.texture,
+                   handles.irradianceVolume.texture);
+  environment_.irradianceVolume.boundsMin = handles.irradianceVolume.boundsMin;
+  environment_.irradianceVolume.boundsMax = handles.irradianceVolume.boundsMax;
+  environment_.irradianceVolume.probeCounts =
+      handles.irradianceVolume.probeCounts;
 }
 
 void RenderScene::retainRenderable(const Renderable &renderable) {
@@ -275,4 +300,11 @@ void RenderScene::releaseEnvironment(const EnvironmentHandles &handles) {
   });
 }
 
+void RenderScene::bumpTopologyVersion() noexcept {
+  ++topologyVersion_;
+  ++transformVersion_;
+  ++staticTransformVersion_;
+  ++dynamicTransformVersion_;
+}
+
 } // namespace nuri
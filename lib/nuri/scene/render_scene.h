@@ -15,10 +15,28 @@
 namespace nuri {
 class ResourceManager;
 
+// Static renderables are expected to keep their transform; moving one
+// rebuilds every cached instance transform. Dynamic renderables are refreshed
+// individually and leave the static instance data untouched.
+enum class RenderableMobility : uint8_t {
+  Static,
+  Dynamic,
+};
+
 struct NURI_API Renderable {
   ModelRef model = kInvalidModelRef;
   MaterialRef material = kInvalidMaterialRef;
   glm::mat4 modelMatrix{1.0f};
+  RenderableMobility mobility = RenderableMobility::Static;
+};
+
+// Baked probe grid for static diffuse lighting. The texture is the L1 SH atlas
+// written by the editor Bakery; bounds are in world space.
+struct NURI_API IrradianceVolumeDesc {
+  TextureRef texture = kInvalidTextureRef;
+  glm::vec3 boundsMin{0.0f};
+  glm::vec3 boundsMax{0.0f};
+  glm::uvec3 probeCounts{0u};
 };
 
 struct NURI_API EnvironmentHandles {
@@ -27,6 +45,7 @@ struct NURI_API EnvironmentHandles {
   TextureRef prefilteredGgx = kInvalidTextureRef;
   TextureRef prefilteredCharlie = kInvalidTextureRef;
   TextureRef brdfLut = kInvalidTextureRef;
+  IrradianceVolumeDesc irradianceVolume{};
 };
 
 class NURI_API RenderScene {
@@ -42,12 +61,16 @@ public:
 
   [[nodiscard]] Result<uint32_t, std::string>
   addRenderable(ModelRef model, MaterialRef material,
-                const glm::mat4 &modelMatrix = glm::mat4(1.0f));
-  [[nodiscard]] Result<uint32_t, std::string>
-  addRenderablesInstanced(ModelRef model, MaterialRef material,
-                          std::span<const glm::mat4> modelMatrices);
+                const glm::mat4 &modelMatrix = glm::mat4(1.0f),
+                RenderableMobility mobility = RenderableMobility::Static);
+  [[nodiscard]] Result<uint32_t, std::string> addRenderablesInstanced(
+      ModelRef model, MaterialRef material,
+      std::span<const glm::mat4> modelMatrices,
+      RenderableMobility mobility = RenderableMobility::Static);
   [[nodiscard]] bool setRenderableTransform(uint32_t index,
                                             const glm::mat4 &modelMatrix);
+  [[nodiscard]] bool setRenderableMobility(uint32_t index,
+                                           RenderableMobility mobility);
 
   [[nodiscard]] const Renderable *renderable(uint32_t index) const;
   [[nodiscard]] std::span<const Renderable> renderables() const {
@@ -60,6 +83,14 @@ public:
   [[nodiscard]] uint64_t transformVersion() const noexcept {
     return transformVersion_;
   }
+  // Split of transformVersion() by the mobility of the moved renderable.
+  // Topology changes bump both.
+  [[nodiscard]] uint64_t staticTransformVersion() const noexcept {
+    return staticTransformVersion_;
+  }
+  [[nodiscard]] uint64_t dynamicTransformVersion() const noexcept {
+    return dynamicTransformVersion_;
+  }
   void bindResources(ResourceManager *resources);
 
   void setEnvironment(EnvironmentHandles handles);
@@ -72,12 +103,15 @@ private:
   void releaseRenderable(const Renderable &renderable);
   void retainEnvironment(const EnvironmentHandles &handles);
   void releaseEnvironment(const EnvironmentHandles &handles);
+  void bumpTopologyVersion() noexcept;
 
   std::pmr::vector<Renderable> renderables_;
   ResourceManager *resources_ = nullptr;
   EnvironmentHandles environment_{};
   uint64_t topologyVersion_ = 0;
   uint64_t transformVersion_ = 0;
+  uint64_t staticTransformVersion_ = 0;
+  uint64_t dynamicTransformVersion_ = 0;
 };
 
 } // namespace nuri
@@ -5,6 +5,7 @@
 #include "nuri/core/containers/hash_map.h"
 #include "nuri/core/log.h"
 #include "nuri/gfx/gpu_device.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
 #include "nuri/resources/storage/font/nfont_binary_codec.h"
 
 namespace nuri {
@@ -22,46 +23,6 @@ template <typename T, typename... Args>
   return next == 0u ? 1u : next;
 }
 
-[[nodiscard]] Result<std::vector<std::byte>, std::string>
-readBinaryFile(const std::filesystem::path &path) {
-  std::ifstream input(path, std::ios::binary | std::ios::ate);
-  if (!input) {
-    return makeError<std::vector<std::byte>>(
-        "FontManager: failed to open file '", path.string(), "'");
-  }
-
-  const std::streampos endPos = input.tellg();
-  if (endPos < 0) {
-    return makeError<std::vector<std::byte>>(
-        "FontManager: failed to query file size for '", path.string(), "'");
-  }
-
-  const uint64_t size64 = static_cast<uint64_t>(endPos);
-  if (size64 > static_cast<uint64_t>(std::numeric_limits<size_t>::max())) {
-    return makeError<std::vector<std::byte>>("FontManager: file too large '",
-                                             path.string(), "'");
-  }
-
-  input.seekg(0, std::ios::beg);
-  if (!input) {
-    return makeError<std::vector<std::byte>>(
-        "FontManager: failed to seek file '", path.string(), "'");
-  }
-
-  std::vector<std::byte> data(static_cast<size_t>(size64));
-  if (!data.empty()) {
-    input.read(reinterpret_cast<char *>(data.data()),
-               static_cast<std::streamsize>(data.size()));
-    if (!input) {
-      return makeError<std::vector<std::byte>>(
-          "FontManager: failed to read file '", path.string(), "'");
-    }
-  }
-
-  return Result<std::vector<std::byte>, std::string>::makeResult(
-      std::move(data));
-}
-
 [[nodiscard]] uint32_t computeMipLevels2D(uint32_t width, uint32_t height) {
   uint32_t levels = 1;
   uint32_t w = std::max(width, 1u);
@@ -97,7 +58,7 @@ public:
     }
 
     const std::filesystem::path path{std::string(desc.path)};
-    auto fileBytesResult = readBinaryFile(path);
+    auto fileBytesResult = readAssetFile(path);
     if (fileBytesResult.hasError()) {
       return makeError<FontHandle>("FontManager::loadFont: ",
                                    fileBytesResult.error());
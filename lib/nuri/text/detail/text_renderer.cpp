@@ -577,19 +577,18 @@ Result<bool, std::string> TextRenderer::compileUiShaders() {
   }
 
   auto helper = Shader::create("text_2d_mtsdf", gpu_);
-  auto vs = helper->compileFromFile(shaderPaths_.uiVertex.string(),
-                                    ShaderStage::Vertex);
-  if (vs.hasError()) {
-    return Result<bool, std::string>::makeError(vs.error());
-  }
-  auto fs = helper->compileFromFile(shaderPaths_.uiFragment.string(),
-                                    ShaderStage::Fragment);
-  if (fs.hasError()) {
-    gpu_.destroyShaderModule(vs.value());
-    return Result<bool, std::string>::makeError(fs.error());
-  }
-  uiVs_ = vs.value();
-  uiFs_ = fs.value();
+  const std::string vertexPath = shaderPaths_.uiVertex.string();
+  const std::string fragmentPath = shaderPaths_.uiFragment.string();
+  const std::array<ShaderFile, 2> files = {
+      ShaderFile{vertexPath, ShaderStage::Vertex},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
+  };
+  auto compiled = helper->compileFromFiles(files);
+  if (compiled.hasError()) {
+    return Result<bool, std::string>::makeError(compiled.error());
+  }
+  uiVs_ = compiled.value()[0];
+  uiFs_ = compiled.value()[1];
   return Result<bool, std::string>::makeResult(true);
 }
 
@@ -611,19 +610,18 @@ Result<bool, std::string> TextRenderer::compileWorldShaders() {
   }
 
   auto helper = Shader::create("text_3d_mtsdf", gpu_);
-  auto vs = helper->compileFromFile(shaderPaths_.worldVertex.string(),
-                                    ShaderStage::Vertex);
-  if (vs.hasError()) {
-    return Result<bool, std::string>::makeError(vs.error());
-  }
-  auto fs = helper->compileFromFile(shaderPaths_.worldFragment.string(),
-                                    ShaderStage::Fragment);
-  if (fs.hasError()) {
-    gpu_.destroyShaderModule(vs.value());
-    return Result<bool, std::string>::makeError(fs.error());
-  }
-  worldVs_ = vs.value();
-  worldFs_ = fs.value();
+  const std::string vertexPath = shaderPaths_.worldVertex.string();
+  const std::string fragmentPath = shaderPaths_.worldFragment.string();
+  const std::array<ShaderFile, 2> files = {
+      ShaderFile{vertexPath, ShaderStage::Vertex},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
+  };
+  auto compiled = helper->compileFromFiles(files);
+  if (compiled.hasError()) {
+    return Result<bool, std::string>::makeError(compiled.error());
+  }
+  worldVs_ = compiled.value()[0];
+  worldFs_ = compiled.value()[1];
   return Result<bool, std::string>::makeResult(true);
 }
 
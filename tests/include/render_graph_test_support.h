@@ -222,6 +222,7 @@ public:
   BufferHandle lastDependencyBuffer{};
   BufferHandle lastPreDispatchDependencyBuffer{};
   BufferHandle lastDrawVertexBuffer{};
+  BufferCopyRegion lastCopyRegion{};
   uint32_t failCreateBufferAtCall = 0u;
   uint32_t failCreateTextureAtCall = 0u;
   bool failSubmitFrame = false;
@@ -0,0 +1,225 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/resources/storage/archive/asset_archive.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+using namespace nuri;
+
+std::filesystem::path makeTempDirectory(std::string_view stem) {
+  const auto tick =
+      std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() /
+      ("nuri_" + std::string(stem) + "_" + std::to_string(tick));
+  std::filesystem::create_directories(path);
+  return path;
+}
+
+std::vector<std::byte> toBytes(std::string_view text) {
+  std::vector<std::byte> bytes(text.size());
+  if (!text.empty()) {
+    std::memcpy(bytes.data(), text.data(), text.size());
+  }
+  return bytes;
+}
+
+void writeFile(const std::filesystem::path &path, std::string_view text) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+// Repetitive enough that the builder stores it compressed.
+std::string makeCompressibleText() {
+  std::string text;
+  for (int i = 0; i < 512; ++i) {
+    text += "#version 460\nlayout(location = " + std::to_string(i % 8) +
+            ") in vec3 position;\n";
+  }
+  return text;
+}
+
+class AssetArchiveTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    root_ = makeTempDirectory("asset_archive");
+    source_ = root_ / "assets";
+    writeFile(source_ / "shaders" / "mesh.vert", makeCompressibleText());
+    writeFile(source_ / "textures" / "noise.bin", "\x01\x7f\x33\xc4\x10");
+    writeFile(source_ / "fonts" / "ui.nfont", "font");
+    writeFile(source_ / "empty.txt", "");
+    archivePath_ = root_ / "assets.npak";
+  }
+
+  void TearDown() override {
+    unmountAssetArchives();
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  std::filesystem::path root_;
+  std::filesystem::path source_;
+  std::filesystem::path archivePath_;
+};
+
+TEST(AssetArchiveCodecTest, RoundTripsRepetitiveAndShortInputs) {
+  const std::string repetitive = makeCompressibleText();
+  // Long incompressible runs exercise the extended literal lengths.
+  std::string noise(4096, '\0');
+  uint32_t state = 0x12345678u;
+  for (char &c : noise) {
+    state = state * 1664525u + 1013904223u;
+    c = static_cast<char>(state >> 24u);
+  }
+  const std::string mixed = noise + repetitive;
+  for (const std::string_view text :
+       {std::string_view(repetitive), std::string_view(mixed),
+        std::string_view("abc"), std::string_view(""),
+        std::string_view("aaaaaaaaaaaaaaaaaaaaaaaaa")}) {
+    const std::vector<std::byte> input = toBytes(text);
+    const std::vector<std::byte> compressed = assetArchiveCompress(input);
+    auto decoded = assetArchiveDecompress(compressed, input.size());
+    ASSERT_FALSE(decoded.hasError()) << decoded.error();
+    EXPECT_EQ(decoded.value(), input);
+  }
+  EXPECT_LT(assetArchiveCompress(toBytes(repetitive)).size(),
+            repetitive.size() / 4u);
+}
+
+TEST(AssetArchiveCodecTest, RejectsCorruptBlocks) {
+  const std::vector<std::byte> input = toBytes(makeCompressibleText());
+  std::vector<std::byte> compressed = assetArchiveCompress(input);
+  EXPECT_TRUE(assetArchiveDecompress(compressed, input.size() + 1u).hasError());
+  compressed.resize(compressed.size() / 2u);
+  EXPECT_TRUE(assetArchiveDecompress(compressed, input.size()).hasError());
+}
+
+TEST_F(AssetArchiveTest, BuildsAndReadsEntries) {
+  auto buildResult = buildAssetArchive(source_, archivePath_);
+  ASSERT_FALSE(buildResult.hasError()) << buildResult.error();
+  EXPECT_EQ(buildResult.value().entryCount, 4u);
+  EXPECT_GE(buildResult.value().compressedEntryCount, 1u);
+
+  auto archiveResult = AssetArchive::open(archivePath_);
+  ASSERT_FALSE(archiveResult.hasError()) << archiveResult.error();
+  const AssetArchive &archive = *archiveResult.value();
+  EXPECT_EQ(archive.entryCount(), 4u);
+  EXPECT_TRUE(archive.contains("shaders/mesh.vert"));
+  EXPECT_FALSE(archive.contains("shaders/missing.vert"));
+  EXPECT_EQ(archive.entrySize("fonts/ui.nfont"), std::optional<uint64_t>(4u));
+
+  auto shader = archive.read("shaders/mesh.vert");
+  ASSERT_FALSE(shader.hasError()) << shader.error();
+  EXPECT_EQ(shader.value(), toBytes(makeCompressibleText()));
+
+  auto empty = archive.read("empty.txt");
+  ASSERT_FALSE(empty.hasError()) << empty.error();
+  EXPECT_TRUE(empty.value().empty());
+  EXPECT_TRUE(archive.read("missing.bin").hasError());
+}
+
+TEST_F(AssetArchiveTest, BatchReturnsRequestOrder) {
+  AssetArchiveBuildOptions options{};
+  options.dataAlignment = 64u;
+  ASSERT_FALSE(buildAssetArchive(source_, archivePath_, options).hasError());
+  auto archiveResult = AssetArchive::open(archivePath_);
+  ASSERT_FALSE(archiveResult.hasError()) << archiveResult.error();
+
+  const std::array<std::string_view, 3> paths = {
+      "textures/noise.bin", "fonts/ui.nfont", "shaders/mesh.vert"};
+  auto batch = archiveResult.value()->readBatch(paths);
+  ASSERT_FALSE(batch.hasError()) << batch.error();
+  ASSERT_EQ(batch.value().size(), 3u);
+  EXPECT_EQ(batch.value()[0], toBytes("\x01\x7f\x33\xc4\x10"));
+  EXPECT_EQ(batch.value()[1], toBytes("font"));
+  EXPECT_EQ(batch.value()[2], toBytes(makeCompressibleText()));
+
+  const std::array<std::string_view, 2> withMissing = {"fonts/ui.nfont",
+                                                       "fonts/missing.nfont"};
+  EXPECT_TRUE(archiveResult.value()->readBatch(withMissing).hasError());
+}
+
+TEST_F(AssetArchiveTest, RejectsTruncatedArchive) {
+  ASSERT_FALSE(buildAssetArchive(source_, archivePath_).hasError());
+  const uintmax_t size = std::filesystem::file_size(archivePath_);
+  std::filesystem::resize_file(archivePath_, size - 8u);
+  EXPECT_TRUE(AssetArchive::open(archivePath_).hasError());
+}
+
+TEST_F(AssetArchiveTest, MountedArchiveFallsBackToLooseFiles) {
+  ASSERT_FALSE(buildAssetArchive(source_, archivePath_).hasError());
+  // Loose copies change after packing so the source of each read is visible.
+  writeFile(source_ / "fonts" / "ui.nfont", "loose");
+  writeFile(source_ / "fonts" / "extra.nfont", "extra");
+
+  auto mountResult = mountAssetArchive(archivePath_, source_);
+  ASSERT_FALSE(mountResult.hasError()) << mountResult.error();
+  EXPECT_EQ(mountedAssetArchiveCount(), 1u);
+
+  auto packed = readAssetFile(source_ / "shaders" / ".." / "fonts" /
+                              "ui.nfont");
+  ASSERT_FALSE(packed.hasError()) << packed.error();
+  EXPECT_EQ(packed.value(), toBytes("font"));
+
+  auto loose = readAssetFile(source_ / "fonts" / "extra.nfont");
+  ASSERT_FALSE(loose.hasError()) << loose.error();
+  EXPECT_EQ(loose.value(), toBytes("extra"));
+  EXPECT_TRUE(assetFileExists(source_ / "textures" / "noise.bin"));
+  EXPECT_FALSE(assetFileExists(source_ / "textures" / "missing.bin"));
+
+  const std::array<std::filesystem::path, 3> paths = {
+      source_ / "fonts" / "extra.nfont", source_ / "fonts" / "ui.nfont",
+      source_ / "textures" / "noise.bin"};
+  auto batch = readAssetFiles(paths);
+  ASSERT_FALSE(batch.hasError()) << batch.error();
+  EXPECT_EQ(batch.value()[0], toBytes("extra"));
+  EXPECT_EQ(batch.value()[1], toBytes("font"));
+  EXPECT_EQ(batch.value()[2], toBytes("\x01\x7f\x33\xc4\x10"));
+
+  unmountAssetArchives();
+  auto unmounted = readAssetFile(source_ / "fonts" / "ui.nfont");
+  ASSERT_FALSE(unmounted.hasError()) << unmounted.error();
+  EXPECT_EQ(unmounted.value(), toBytes("loose"));
+}
+
+TEST_F(AssetArchiveTest, ConcurrentReadsSurviveUnmount) {
+  ASSERT_FALSE(buildAssetArchive(source_, archivePath_).hasError());
+  writeFile(source_ / "fonts" / "ui.nfont", "loose");
+  ASSERT_FALSE(mountAssetArchive(archivePath_, source_).hasError());
+
+  const std::vector<std::byte> packed = toBytes("font");
+  const std::vector<std::byte> loose = toBytes("loose");
+  const std::vector<std::byte> shader = toBytes(makeCompressibleText());
+  std::atomic<uint32_t> failures{0u};
+  std::vector<std::thread> readers;
+  for (int thread = 0; thread < 4; ++thread) {
+    readers.emplace_back([&] {
+      const std::array<std::filesystem::path, 2> paths = {
+          source_ / "fonts" / "ui.nfont", source_ / "shaders" / "mesh.vert"};
+      for (int i = 0; i < 200; ++i) {
+        auto batch = readAssetFiles(paths);
+        if (batch.hasError() ||
+            (batch.value()[0] != packed && batch.value()[0] != loose) ||
+            batch.value()[1] != shader) {
+          failures.fetch_add(1u);
+        }
+      }
+    });
+  }
+  unmountAssetArchives();
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(failures.load(), 0u);
+}
+
+} // namespace
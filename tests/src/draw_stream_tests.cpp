@@ -0,0 +1,280 @@
+#include "tests_pch.h"
+
+#include "render_graph_test_support.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/draw_stream.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+using namespace nuri::test_support;
+
+std::vector<DrawStreamCommand> decodeAll(std::span<const std::byte> bytes) {
+  std::vector<DrawStreamCommand> commands;
+  DrawStreamReader reader(bytes);
+  DrawStreamCommand command{};
+  while (true) {
+    auto nextResult = reader.next(command);
+    EXPECT_FALSE(nextResult.hasError()) << nextResult.error();
+    if (nextResult.hasError() || !nextResult.value()) {
+      break;
+    }
+    commands.push_back(command);
+  }
+  return commands;
+}
+
+DrawItem makeIndexedDraw(uint32_t firstIndex) {
+  DrawItem draw{};
+  draw.pipeline = RenderPipelineHandle{.index = 1u, .generation = 1u};
+  draw.vertexBuffer = BufferHandle{.index = 2u, .generation = 1u};
+  draw.indexBuffer = BufferHandle{.index = 3u, .generation = 1u};
+  draw.indexFormat = IndexFormat::U32;
+  draw.indexCount = 36u;
+  draw.firstIndex = firstIndex;
+  draw.useDepthState = true;
+  draw.depthState = {.compareOp = CompareOp::Less,
+                     .isDepthWriteEnabled = true};
+  return draw;
+}
+
+TEST(DrawStreamTest, WriterEmitsOnlyStateDeltas) {
+  const std::array<uint32_t, 2> pushA = {7u, 9u};
+  const std::array<uint32_t, 2> pushB = {8u, 9u};
+
+  DrawStreamWriter writer;
+  DrawItem first = makeIndexedDraw(0u);
+  first.pushConstants = std::as_bytes(std::span(pushA));
+  DrawItem second = makeIndexedDraw(36u);
+  second.pushConstants = std::as_bytes(std::span(pushA));
+  DrawItem third = makeIndexedDraw(72u);
+  third.pushConstants = std::as_bytes(std::span(pushB));
+  third.useScissor = true;
+  third.scissor = {.x = 1u, .y = 2u, .width = 3u, .height = 4u};
+  writer.appendDrawItem(first);
+  writer.appendDrawItem(second);
+  writer.appendDrawItem(third);
+  EXPECT_EQ(writer.drawCount(), 3u);
+
+  const std::vector<DrawStreamCommand> commands = decodeAll(writer.bytes());
+  const std::array<DrawStreamOp, 11> expectedOps = {
+      DrawStreamOp::BindPipeline,  DrawStreamOp::BindVertexBuffer,
+      DrawStreamOp::BindIndexBuffer, DrawStreamOp::SetDepthState,
+      DrawStreamOp::SetDepthBias,  DrawStreamOp::SetScissor,
+      DrawStreamOp::PushConstants, DrawStreamOp::DrawIndexed,
+      DrawStreamOp::DrawIndexed,   DrawStreamOp::SetScissor,
+      DrawStreamOp::PushConstants,
+  };
+  ASSERT_EQ(commands.size(), expectedOps.size() + 1u);
+  for (size_t i = 0; i < expectedOps.size(); ++i) {
+    EXPECT_EQ(commands[i].op, expectedOps[i]) << "record " << i;
+  }
+  EXPECT_EQ(commands.back().op, DrawStreamOp::DrawIndexed);
+
+  const auto lastDraw = commands.back().as<DrawStreamDrawIndexed>();
+  EXPECT_EQ(lastDraw.indexCount, 36u);
+  EXPECT_EQ(lastDraw.firstIndex, 72u);
+  const auto scissor = commands[9].as<DrawStreamSetScissor>();
+  EXPECT_EQ(scissor.enable, 1u);
+  EXPECT_EQ(scissor.rect.height, 4u);
+  ASSERT_EQ(commands[10].payload.size(), sizeof(pushB));
+  EXPECT_EQ(std::memcmp(commands[10].payload.data(), pushB.data(),
+                        sizeof(pushB)),
+            0);
+
+  // A streamed draw costs a fraction of the DrawItem it replaces.
+  EXPECT_LT(writer.bytes().size(), 3u * sizeof(DrawItem));
+
+  writer.reset();
+  EXPECT_TRUE(writer.empty());
+  writer.appendDrawItem(second);
+  EXPECT_EQ(decodeAll(writer.bytes()).front().op, DrawStreamOp::BindPipeline)
+      << "reset must forget cached state";
+}
+
+TEST(DrawStreamTest, IndirectCountRoundTrips) {
+  DrawStreamWriter writer;
+  DrawItem draw = makeIndexedDraw(0u);
+  draw.command = DrawCommandType::IndexedIndirectCount;
+  draw.indirectBuffer = BufferHandle{.index = 4u, .generation = 2u};
+  draw.indirectBufferOffset = 256u;
+  draw.indirectCountBuffer = BufferHandle{.index = 5u, .generation = 3u};
+  draw.indirectCountBufferOffset = 16u;
+  draw.indirectDrawCount = 1024u;
+  draw.indirectStride = 20u;
+  writer.appendDrawItem(draw);
+
+  auto validateResult = validateDrawStream(writer.bytes());
+  ASSERT_FALSE(validateResult.hasError()) << validateResult.error();
+  EXPECT_EQ(validateResult.value(), 1u);
+
+  const std::vector<DrawStreamCommand> commands = decodeAll(writer.bytes());
+  ASSERT_FALSE(commands.empty());
+  ASSERT_EQ(commands.back().op, DrawStreamOp::DrawIndexedIndirectCount);
+  const auto decoded =
+      commands.back().as<DrawStreamDrawIndexedIndirectCount>();
+  EXPECT_TRUE(sameBuffer(decoded.buffer, draw.indirectBuffer));
+  EXPECT_EQ(decoded.offset, 256u);
+  EXPECT_TRUE(sameBuffer(decoded.countBuffer, draw.indirectCountBuffer));
+  EXPECT_EQ(decoded.countOffset, 16u);
+  EXPECT_EQ(decoded.maxDrawCount, 1024u);
+  EXPECT_EQ(decoded.stride, 20u);
+}
+
+TEST(DrawStreamTest, ReaderRejectsMalformedStreams) {
+  DrawStreamWriter writer;
+  writer.bindPipeline(RenderPipelineHandle{.index = 1u, .generation = 1u});
+  writer.draw({.vertexCount = 3u});
+  const std::span<const std::byte> valid = writer.bytes();
+  ASSERT_FALSE(validateDrawStream(valid).hasError());
+
+  EXPECT_TRUE(validateDrawStream(valid.first(valid.size() - 4u)).hasError())
+      << "truncated payload";
+  EXPECT_TRUE(validateDrawStream(valid.first(2u)).hasError())
+      << "truncated header";
+
+  std::vector<std::byte> unknownOp(valid.begin(), valid.end());
+  unknownOp[0] = static_cast<std::byte>(DrawStreamOp::Count);
+  EXPECT_TRUE(validateDrawStream(unknownOp).hasError());
+
+  std::vector<std::byte> wrongSize(valid.begin(), valid.end());
+  wrongSize[0] = static_cast<std::byte>(DrawStreamOp::Draw);
+  EXPECT_TRUE(validateDrawStream(wrongSize).hasError());
+
+  RenderGraphBuilder builder;
+  builder.beginFrame(1u);
+  RenderGraphGraphicsPassDesc desc{};
+  desc.drawStream = unknownOp;
+  EXPECT_TRUE(builder.addGraphicsPass(desc).hasError());
+  EXPECT_EQ(builder.passCount(), 0u);
+}
+
+TEST(DrawStreamTest, ValidationRequiresBoundPipelineAndIndexBuffer) {
+  DrawStreamWriter unbound;
+  unbound.draw({.vertexCount = 3u});
+  EXPECT_TRUE(validateDrawStream(unbound.bytes()).hasError())
+      << "draw without a pipeline";
+
+  DrawStreamWriter noIndex;
+  noIndex.bindPipeline(RenderPipelineHandle{.index = 1u, .generation = 1u});
+  noIndex.drawIndexed({.indexCount = 3u});
+  EXPECT_TRUE(validateDrawStream(noIndex.bytes()).hasError())
+      << "indexed draw without an index buffer";
+
+  DrawStreamWriter noIndexIndirect;
+  noIndexIndirect.bindPipeline(
+      RenderPipelineHandle{.index = 1u, .generation = 1u});
+  noIndexIndirect.drawIndexedIndirect(
+      {.buffer = BufferHandle{.index = 4u, .generation = 1u},
+       .drawCount = 1u,
+       .stride = 20u});
+  EXPECT_TRUE(validateDrawStream(noIndexIndirect.bytes()).hasError())
+      << "indirect draw without an index buffer";
+
+  RenderGraphBuilder builder;
+  builder.beginFrame(1u);
+  RenderGraphGraphicsPassDesc desc{};
+  desc.drawStream = noIndex.bytes();
+  EXPECT_TRUE(builder.addGraphicsPass(desc).hasError());
+}
+
+TEST(DrawStreamTest, PatchableDrawItemsRewriteInPlace) {
+  const std::array<uint32_t, 2> push = {7u, 9u};
+  const std::array<uint32_t, 2> patchedPush = {11u, 13u};
+  DrawItem draw = makeIndexedDraw(0u);
+  draw.command = DrawCommandType::IndexedIndirect;
+  draw.indirectBuffer = BufferHandle{.index = 4u, .generation = 1u};
+  draw.indirectDrawCount = 2u;
+  draw.indirectStride = 20u;
+  draw.pushConstants = std::as_bytes(std::span(push));
+
+  DrawStreamWriter writer;
+  const DrawStreamPatchOffsets first = writer.appendPatchableDrawItem(draw);
+  const DrawStreamPatchOffsets second = writer.appendPatchableDrawItem(draw);
+  ASSERT_NE(first.pushConstants, DrawStreamPatchOffsets::kNone);
+  ASSERT_NE(second.pushConstants, DrawStreamPatchOffsets::kNone)
+      << "identical push constants still get their own record";
+  const size_t sizeBefore = writer.bytes().size();
+
+  const BufferHandle slotBuffer{.index = 6u, .generation = 2u};
+  writer.patch(second.pushConstants, std::as_bytes(std::span(patchedPush)));
+  writer.patch(second.draw + offsetof(DrawStreamDrawIndexedIndirect, buffer),
+               std::as_bytes(std::span(&slotBuffer, 1u)));
+  EXPECT_EQ(writer.bytes().size(), sizeBefore);
+
+  auto validateResult = validateDrawStream(writer.bytes());
+  ASSERT_FALSE(validateResult.hasError()) << validateResult.error();
+  EXPECT_EQ(validateResult.value(), 2u);
+
+  std::vector<DrawStreamCommand> pushes;
+  std::vector<DrawStreamDrawIndexedIndirect> draws;
+  for (const DrawStreamCommand &command : decodeAll(writer.bytes())) {
+    if (command.op == DrawStreamOp::PushConstants) {
+      pushes.push_back(command);
+    } else if (command.op == DrawStreamOp::DrawIndexedIndirect) {
+      draws.push_back(command.as<DrawStreamDrawIndexedIndirect>());
+    }
+  }
+  ASSERT_EQ(pushes.size(), 2u);
+  ASSERT_EQ(draws.size(), 2u);
+  EXPECT_EQ(std::memcmp(pushes[0].payload.data(), push.data(), sizeof(push)),
+            0);
+  EXPECT_EQ(std::memcmp(pushes[1].payload.data(), patchedPush.data(),
+                        sizeof(patchedPush)),
+            0);
+  EXPECT_TRUE(sameBuffer(draws[0].buffer, draw.indirectBuffer));
+  EXPECT_TRUE(sameBuffer(draws[1].buffer, slotBuffer));
+  EXPECT_EQ(draws[1].drawCount, 2u);
+}
+
+TEST(DrawStreamTest, GraphicsPassImportsStreamBuffersAndOwnsBytes) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(2u);
+
+  auto colorResult = builder.importTexture(
+      TextureHandle{.index = 9u, .generation = 1u}, "stream_color");
+  ASSERT_FALSE(colorResult.hasError());
+
+  std::vector<std::byte> bytes;
+  {
+    DrawStreamWriter writer;
+    writer.appendDrawItem(makeIndexedDraw(0u));
+    writer.appendDrawItem(makeIndexedDraw(36u));
+    bytes.assign(writer.bytes().begin(), writer.bytes().end());
+  }
+
+  RenderGraphGraphicsPassDesc desc{};
+  desc.colorTexture = colorResult.value();
+  desc.drawStream = bytes;
+  desc.debugLabel = "stream_pass";
+  desc.markColorAsFrameOutput = true;
+  auto passResult = builder.addGraphicsPass(desc);
+  ASSERT_FALSE(passResult.hasError()) << passResult.error();
+  const std::vector<std::byte> expected = bytes;
+  bytes.assign(bytes.size(), std::byte{0});
+
+  RenderGraphRuntime runtime;
+  auto compileResult = builder.compile(runtime);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+  EXPECT_EQ(compiled.resourceStats.importedBuffers, 2u)
+      << "vertex and index buffers referenced by the stream";
+  ASSERT_EQ(compiled.orderedPasses.size(), 1u);
+  const std::span<const std::byte> stored =
+      compiled.orderedPasses[0u].drawStream;
+  ASSERT_EQ(stored.size(), expected.size());
+  EXPECT_EQ(std::memcmp(stored.data(), expected.data(), expected.size()), 0);
+  auto validateResult = validateDrawStream(stored);
+  ASSERT_FALSE(validateResult.hasError());
+  EXPECT_EQ(validateResult.value(), 2u);
+}
+
+} // namespace
@@ -0,0 +1,217 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/resources/gpu/geometry_pool.h"
+#include "render_graph_test_support.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+using namespace nuri::test_support;
+
+// Keeps buffer contents so dedup hits can be confirmed by readback.
+class FakeGeometryGPUDevice final : public FakeGPUDeviceBase {
+public:
+  Result<BufferHandle, std::string>
+  createBuffer(const BufferDesc &desc, std::string_view debugName) override {
+    auto result = FakeGPUDeviceBase::createBuffer(desc, debugName);
+    if (!result.hasError()) {
+      buffers_[result.value().index].resize(desc.size);
+    }
+    return result;
+  }
+
+  void destroyBuffer(BufferHandle buffer) override {
+    buffers_.erase(buffer.index);
+    FakeGPUDeviceBase::destroyBuffer(buffer);
+  }
+
+  Result<bool, std::string> updateBuffer(BufferHandle buffer,
+                                         std::span<const std::byte> data,
+                                         size_t offset) override {
+    ++uploadCount;
+    std::vector<std::byte> &bytes = buffers_.at(buffer.index);
+    std::copy(data.begin(), data.end(), bytes.begin() + offset);
+    return Result<bool, std::string>::makeResult(true);
+  }
+
+  Result<bool, std::string>
+  copyBufferRegions(std::span<const BufferCopyRegion> regions) override {
+    for (const BufferCopyRegion &region : regions) {
+      const std::vector<std::byte> &src = buffers_.at(region.srcBuffer.index);
+      std::vector<std::byte> &dst = buffers_.at(region.dstBuffer.index);
+      std::copy_n(src.begin() + region.srcOffset, region.size,
+                  dst.begin() + region.dstOffset);
+    }
+    return Result<bool, std::string>::makeResult(true);
+  }
+
+  Result<bool, std::string> readBuffer(BufferHandle buffer, size_t offset,
+                                       std::span<std::byte> outBytes) override {
+    ++readbackCount;
+    const std::vector<std::byte> &bytes = buffers_.at(buffer.index);
+    std::copy_n(bytes.begin() + offset, outBytes.size(), outBytes.begin());
+    return Result<bool, std::string>::makeResult(true);
+  }
+
+  // Flips the leading bytes of every buffer, standing in for a colliding key
+  // whose contents differ. Test geometry is tiny and sits at the front.
+  void corruptResidentBytes() {
+    for (auto &[index, bytes] : buffers_) {
+      const size_t count = std::min<size_t>(bytes.size(), 4096u);
+      for (size_t i = 0; i < count; ++i) {
+        bytes[i] = ~bytes[i];
+      }
+    }
+  }
+
+  uint32_t uploadCount = 0u;
+  uint32_t readbackCount = 0u;
+
+private:
+  std::unordered_map<uint32_t, std::vector<std::byte>> buffers_;
+};
+
+struct TestGeometry {
+  std::array<float, 12> vertices{};
+  std::array<uint32_t, 3> indices{0u, 1u, 2u};
+
+  explicit TestGeometry(float seed) {
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      vertices[i] = seed + static_cast<float>(i);
+    }
+  }
+
+  Result<GeometryAllocationHandle, std::string>
+  allocate(GeometryPool &pool, std::string_view name) const {
+    return pool.allocate(std::as_bytes(std::span(vertices)), 3u,
+                         std::as_bytes(std::span(indices)), 3u, name);
+  }
+};
+
+bool isSameHandle(GeometryAllocationHandle a, GeometryAllocationHandle b) {
+  return a.index == b.index && a.generation == b.generation;
+}
+
+TEST(GeometryPoolTest, IdenticalContentSharesOneReferenceCountedAllocation) {
+  FakeGeometryGPUDevice gpu;
+  GeometryPool pool(gpu);
+  const TestGeometry geometry(1.0f);
+
+  auto first = geometry.allocate(pool, "first");
+  auto second = geometry.allocate(pool, "second");
+  ASSERT_FALSE(first.hasError());
+  ASSERT_FALSE(second.hasError());
+  EXPECT_TRUE(isSameHandle(first.value(), second.value()));
+  EXPECT_EQ(gpu.uploadCount, 2u);
+  EXPECT_EQ(pool.stats().liveAllocations, 1u);
+  EXPECT_EQ(pool.stats().sharedReferences, 1u);
+  EXPECT_EQ(pool.stats().dedupedBytes,
+            sizeof(geometry.vertices) + sizeof(geometry.indices));
+
+  auto other = TestGeometry(100.0f).allocate(pool, "other");
+  ASSERT_FALSE(other.hasError());
+  EXPECT_FALSE(isSameHandle(first.value(), other.value()));
+  EXPECT_EQ(gpu.uploadCount, 4u);
+
+  GeometryAllocationView view{};
+  pool.release(first.value());
+  EXPECT_TRUE(pool.resolve(second.value(), view));
+  EXPECT_EQ(pool.stats().sharedReferences, 0u);
+  pool.release(second.value());
+  EXPECT_FALSE(pool.resolve(second.value(), view));
+  EXPECT_EQ(pool.stats().liveAllocations, 1u);
+}
+
+TEST(GeometryPoolTest, MatchingSizesWithDifferentBytesAreNotShared) {
+  FakeGeometryGPUDevice gpu;
+  GeometryPool pool(gpu);
+  TestGeometry geometry(1.0f);
+
+  auto first = geometry.allocate(pool, "first");
+  ASSERT_FALSE(first.hasError());
+  geometry.indices = {2u, 1u, 0u};
+  auto reordered = geometry.allocate(pool, "reordered");
+  ASSERT_FALSE(reordered.hasError());
+  EXPECT_FALSE(isSameHandle(first.value(), reordered.value()));
+  EXPECT_EQ(pool.stats().liveAllocations, 2u);
+  EXPECT_EQ(pool.stats().dedupedBytes, 0u);
+  EXPECT_EQ(gpu.readbackCount, 0u) << "a key miss must not read back";
+
+  geometry.indices = {0u, 1u, 2u};
+  auto original = geometry.allocate(pool, "original");
+  ASSERT_FALSE(original.hasError());
+  EXPECT_TRUE(isSameHandle(first.value(), original.value()));
+  EXPECT_EQ(gpu.readbackCount, 1u);
+  EXPECT_EQ(gpu.uploadCount, 4u);
+}
+
+TEST(GeometryPoolTest, KeyMatchIsConfirmedAgainstResidentBytes) {
+  FakeGeometryGPUDevice gpu;
+  GeometryPool pool(gpu);
+  const TestGeometry geometry(1.0f);
+
+  auto first = geometry.allocate(pool, "first");
+  ASSERT_FALSE(first.hasError());
+  // The pool keeps no CPU copy, so the resident bytes are the only thing a
+  // key match can be checked against.
+  gpu.corruptResidentBytes();
+  auto second = geometry.allocate(pool, "second");
+  ASSERT_FALSE(second.hasError());
+  EXPECT_FALSE(isSameHandle(first.value(), second.value()));
+  EXPECT_EQ(gpu.readbackCount, 1u);
+  EXPECT_EQ(pool.stats().dedupedBytes, 0u);
+  EXPECT_EQ(gpu.destroyedBufferCount, 1u) << "readback staging is released";
+}
+
+TEST(GeometryPoolTest, RetiredContentIsRevivedUntilReclaimed) {
+  FakeGeometryGPUDevice gpu;
+  GeometryPool pool(gpu);
+  const TestGeometry geometry(1.0f);
+  ASSERT_FALSE(pool.beginFrame(1u).hasError());
+
+  auto original = geometry.allocate(pool, "original");
+  ASSERT_FALSE(original.hasError());
+  pool.release(original.value());
+
+  auto revived = geometry.allocate(pool, "revived");
+  ASSERT_FALSE(revived.hasError());
+  EXPECT_EQ(revived.value().index, original.value().index);
+  EXPECT_NE(revived.value().generation, original.value().generation);
+  EXPECT_EQ(gpu.uploadCount, 2u);
+
+  GeometryAllocationView view{};
+  EXPECT_FALSE(pool.resolve(original.value(), view));
+  EXPECT_TRUE(pool.resolve(revived.value(), view));
+
+  pool.release(revived.value());
+  ASSERT_FALSE(pool.beginFrame(10u).hasError());
+  auto reloaded = geometry.allocate(pool, "reloaded");
+  ASSERT_FALSE(reloaded.hasError());
+  EXPECT_EQ(gpu.uploadCount, 4u);
+}
+
+TEST(GeometryPoolTest, DeduplicationCanBeDisabled) {
+  FakeGeometryGPUDevice gpu;
+  GeometryPool pool(gpu,
+                    GeometryPoolConfig{.enableContentDeduplication = false});
+  const TestGeometry geometry(1.0f);
+
+  auto first = geometry.allocate(pool, "first");
+  auto second = geometry.allocate(pool, "second");
+  ASSERT_FALSE(first.hasError());
+  ASSERT_FALSE(second.hasError());
+  EXPECT_FALSE(isSameHandle(first.value(), second.value()));
+  EXPECT_EQ(gpu.uploadCount, 4u);
+  EXPECT_EQ(pool.stats().dedupedBytes, 0u);
+}
+
+} // namespace
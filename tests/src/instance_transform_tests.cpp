@@ -0,0 +1,124 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/instance_transform.h"
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+
+void expectMatrixNear(const glm::mat4 &actual, const glm::mat4 &expected,
+                      float tolerance) {
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 4; ++row) {
+      EXPECT_NEAR(actual[column][row], expected[column][row], tolerance)
+          << "column " << column << " row " << row;
+    }
+  }
+}
+
+glm::mat4 makeTrs(const glm::vec3 &translation, float angle,
+                  const glm::vec3 &axis, const glm::vec3 &scale) {
+  glm::mat4 transform = glm::translate(glm::mat4(1.0f), translation);
+  transform = glm::rotate(transform, angle, axis);
+  return glm::scale(transform, scale);
+}
+
+glm::mat4 decodeEntry(std::span<const std::byte> bytes,
+                      InstanceTransformEncoding encoding, size_t index) {
+  const std::byte *entry =
+      bytes.data() + index * instanceTransformStride(encoding);
+  if (encoding == InstanceTransformEncoding::CompactTrs) {
+    PackedInstanceTrs packed{};
+    std::memcpy(&packed, entry, sizeof(packed));
+    return unpackInstanceTrs(packed);
+  }
+  PackedInstanceAffine packed{};
+  std::memcpy(&packed, entry, sizeof(packed));
+  return glm::transpose(glm::mat4(packed.rows[0], packed.rows[1],
+                                  packed.rows[2],
+                                  glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+}
+
+TEST(InstanceTransformTest, CompactTrsRoundTripsRotationScaleAndMirror) {
+  const std::array<glm::mat4, 3> transforms = {
+      makeTrs(glm::vec3(12.5f, -3.0f, 400.0f), 0.7f,
+              glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(2.0f, 0.5f, 3.0f)),
+      makeTrs(glm::vec3(0.0f), 2.9f, glm::vec3(0.0f, 0.0f, 1.0f),
+              glm::vec3(1.0f)),
+      makeTrs(glm::vec3(-1.0f, 2.0f, 0.25f), 1.3f,
+              glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(-1.5f, 1.0f, 1.0f)),
+  };
+  EXPECT_EQ(selectInstanceTransformEncoding(transforms),
+            InstanceTransformEncoding::CompactTrs);
+
+  for (const glm::mat4 &transform : transforms) {
+    const std::optional<PackedInstanceTrs> packed = packInstanceTrs(transform);
+    ASSERT_TRUE(packed.has_value());
+    const float maxScale =
+        std::max({std::abs(packed->scale.x), std::abs(packed->scale.y),
+                  std::abs(packed->scale.z)});
+    expectMatrixNear(unpackInstanceTrs(*packed), transform,
+                     2.0e-4f * maxScale);
+  }
+
+  std::vector<std::byte> bytes(transforms.size() * sizeof(PackedInstanceTrs));
+  packInstanceTransforms(transforms, InstanceTransformEncoding::CompactTrs,
+                         bytes);
+  expectMatrixNear(
+      decodeEntry(bytes, InstanceTransformEncoding::CompactTrs, 1u),
+      transforms[1], 2.0e-4f);
+}
+
+TEST(InstanceTransformTest, ShearFallsBackToAffineRows) {
+  glm::mat4 sheared = makeTrs(glm::vec3(1.0f, 2.0f, 3.0f), 0.4f,
+                              glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f));
+  sheared[1][0] += 0.5f;
+  EXPECT_FALSE(packInstanceTrs(sheared).has_value());
+
+  glm::mat4 projective(1.0f);
+  projective[2][3] = -1.0f;
+  EXPECT_FALSE(packInstanceTrs(projective).has_value());
+  EXPECT_FALSE(packInstanceTrs(glm::mat4(0.0f)).has_value());
+
+  const std::array<glm::mat4, 2> transforms = {glm::mat4(1.0f), sheared};
+  const InstanceTransformEncoding encoding =
+      selectInstanceTransformEncoding(transforms);
+  ASSERT_EQ(encoding, InstanceTransformEncoding::Affine3x4);
+  EXPECT_EQ(instanceTransformStride(encoding), 48u);
+
+  std::vector<std::byte> bytes(transforms.size() *
+                               instanceTransformStride(encoding));
+  packInstanceTransforms(transforms, encoding, bytes);
+  expectMatrixNear(decodeEntry(bytes, encoding, 1u), sheared, 0.0f);
+}
+
+TEST(InstanceTransformTest, SetTranslationPatchesOnlyTranslation) {
+  const glm::mat4 base = makeTrs(glm::vec3(0.0f), 1.1f,
+                                 glm::vec3(1.0f, 0.0f, 0.0f),
+                                 glm::vec3(0.5f, 2.0f, 1.0f));
+  const glm::vec3 center(7.0f, -8.0f, 9.0f);
+  const glm::mat4 expected = glm::translate(glm::mat4(1.0f), center) * base;
+  const std::array<glm::mat4, 2> transforms = {glm::mat4(1.0f), base};
+
+  for (const InstanceTransformEncoding encoding :
+       {InstanceTransformEncoding::Affine3x4,
+        InstanceTransformEncoding::CompactTrs}) {
+    std::vector<std::byte> bytes(transforms.size() *
+                                 instanceTransformStride(encoding));
+    packInstanceTransforms(transforms, encoding, bytes);
+    setPackedInstanceTranslation(bytes, encoding, 1u, center);
+
+    expectMatrixNear(decodeEntry(bytes, encoding, 1u), expected, 5.0e-4f);
+    expectMatrixNear(decodeEntry(bytes, encoding, 0u), glm::mat4(1.0f),
+                     1.0e-4f);
+  }
+}
+
+} // namespace
@@ -0,0 +1,173 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/resources/storage/mesh/mesh_binary_codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+
+constexpr uint32_t kStride = 36u;
+constexpr uint32_t kGroupSize = 16u;
+
+// Mixes smooth ramps, constant channels, noise and sparse spikes so every
+// byte group encoding is exercised.
+std::vector<std::byte> makeVertices(uint32_t vertexCount) {
+  std::vector<std::byte> bytes(static_cast<size_t>(vertexCount) * kStride);
+  uint32_t state = 0x12345678u;
+  for (uint32_t v = 0; v < vertexCount; ++v) {
+    for (uint32_t k = 0; k < kStride; ++k) {
+      state = state * 1664525u + 1013904223u;
+      uint32_t value = 0;
+      switch (k % 4u) {
+      case 0:
+        value = v / 3u + k;
+        break;
+      case 1:
+        value = 7u * k;
+        break;
+      case 2:
+        value = state >> 24u;
+        break;
+      default:
+        value = (v % 97u == 0u) ? (state >> 24u) : (v / 50u);
+        break;
+      }
+      bytes[static_cast<size_t>(v) * kStride + k] =
+          static_cast<std::byte>(value & 0xffu);
+    }
+  }
+  return bytes;
+}
+
+uint32_t byteAt(std::span<const std::byte> bytes, size_t offset) {
+  return std::to_integer<uint32_t>(bytes[offset]);
+}
+
+void decodeGroup(std::span<const std::byte> encoded, size_t header,
+                 uint32_t group, size_t &cursor, uint32_t (&deltas)[16]) {
+  const uint32_t bitsLog2 =
+      (byteAt(encoded, header + group / 4u) >> ((group % 4u) * 2u)) & 3u;
+  if (bitsLog2 == 0u) {
+    std::fill(std::begin(deltas), std::end(deltas), 0u);
+    return;
+  }
+  if (bitsLog2 == 3u) {
+    for (uint32_t i = 0; i < kGroupSize; ++i) {
+      deltas[i] = byteAt(encoded, cursor + i);
+    }
+    cursor += kGroupSize;
+    return;
+  }
+  const uint32_t bits = 1u << bitsLog2;
+  const uint32_t perByte = 8u / bits;
+  const uint32_t sentinel = (1u << bits) - 1u;
+  size_t extra = cursor + 2u * bits;
+  for (uint32_t i = 0; i < kGroupSize; ++i) {
+    const uint32_t shift = 8u - bits * (i % perByte + 1u);
+    uint32_t value =
+        (byteAt(encoded, cursor + i / perByte) >> shift) & sentinel;
+    if (value == sentinel) {
+      value = byteAt(encoded, extra++);
+    }
+    deltas[i] = value;
+  }
+  cursor = extra;
+}
+
+// Mirrors the GPU decoder: every block is decoded relative to zero, then the
+// block totals are turned into carries seeded with the stream's tail vertex.
+std::vector<std::byte> decodeWithPlan(std::span<const std::byte> encoded,
+                                      const MeshBinaryVertexDecodePlan &plan,
+                                      uint32_t vertexCount) {
+  std::vector<uint8_t> decoded(static_cast<size_t>(vertexCount) * kStride);
+  std::vector<uint8_t> totals(static_cast<size_t>(plan.blockCount) * kStride);
+  for (uint32_t block = 0; block < plan.blockCount; ++block) {
+    const uint32_t first = block * plan.blockVertexCount;
+    const uint32_t count =
+        std::min(plan.blockVertexCount, vertexCount - first);
+    const uint32_t groupCount = (count + kGroupSize - 1u) / kGroupSize;
+    for (uint32_t k = 0; k < kStride; ++k) {
+      const size_t header = plan.channelOffsets[block * kStride + k];
+      size_t cursor = header + (groupCount + 3u) / 4u;
+      uint8_t sum = 0;
+      for (uint32_t group = 0; group < groupCount; ++group) {
+        uint32_t deltas[16];
+        decodeGroup(encoded, header, group, cursor, deltas);
+        for (uint32_t i = 0; i < kGroupSize && group * 16u + i < count; ++i) {
+          const uint32_t delta = (deltas[i] >> 1u) ^ (0u - (deltas[i] & 1u));
+          sum = static_cast<uint8_t>(sum + delta);
+          decoded[static_cast<size_t>(first + group * 16u + i) * kStride + k] =
+              sum;
+        }
+      }
+      totals[block * kStride + k] = sum;
+    }
+  }
+
+  for (uint32_t k = 0; k < kStride; ++k) {
+    auto carry = static_cast<uint8_t>(byteAt(encoded, plan.tailOffset + k));
+    for (uint32_t block = 0; block < plan.blockCount; ++block) {
+      const uint8_t total = totals[block * kStride + k];
+      totals[block * kStride + k] = carry;
+      carry = static_cast<uint8_t>(carry + total);
+    }
+  }
+
+  std::vector<std::byte> result(decoded.size());
+  for (uint32_t v = 0; v < vertexCount; ++v) {
+    const uint32_t block = v / plan.blockVertexCount;
+    for (uint32_t k = 0; k < kStride; ++k) {
+      const size_t index = static_cast<size_t>(v) * kStride + k;
+      result[index] = static_cast<std::byte>(
+          static_cast<uint8_t>(decoded[index] + totals[block * kStride + k]));
+    }
+  }
+  return result;
+}
+
+TEST(MeshBinaryCodecTest, PlannedBlockDecodeMatchesSourceVertices) {
+  constexpr uint32_t kVertexCount = 1000u;
+  const std::vector<std::byte> vertices = makeVertices(kVertexCount);
+  auto encoded = meshBinaryEncodeVertexBuffer(vertices, kStride);
+  ASSERT_FALSE(encoded.hasError()) << encoded.error();
+
+  auto plan =
+      meshBinaryPlanVertexDecode(encoded.value(), kVertexCount, kStride);
+  ASSERT_FALSE(plan.hasError()) << plan.error();
+  EXPECT_GT(plan.value().blockCount, 1u);
+  EXPECT_EQ(plan.value().channelOffsets.size(),
+            static_cast<size_t>(plan.value().blockCount) * kStride);
+
+  EXPECT_EQ(decodeWithPlan(encoded.value(), plan.value(), kVertexCount),
+            vertices);
+}
+
+TEST(MeshBinaryCodecTest, PlanRejectsUnsupportedStreams) {
+  constexpr uint32_t kVertexCount = 64u;
+  const std::vector<std::byte> vertices = makeVertices(kVertexCount);
+  auto encoded = meshBinaryEncodeVertexBuffer(vertices, kStride);
+  ASSERT_FALSE(encoded.hasError()) << encoded.error();
+
+  std::vector<std::byte> otherVersion = encoded.value();
+  otherVersion[0] = std::byte{0xa1};
+  EXPECT_TRUE(
+      meshBinaryPlanVertexDecode(otherVersion, kVertexCount, kStride)
+          .hasError());
+
+  std::vector<std::byte> truncated = encoded.value();
+  truncated.erase(truncated.begin() + 8);
+  EXPECT_TRUE(
+      meshBinaryPlanVertexDecode(truncated, kVertexCount, kStride).hasError());
+
+  EXPECT_TRUE(meshBinaryPlanVertexDecode(encoded.value(), kVertexCount, 6u)
+                  .hasError());
+}
+
+} // namespace
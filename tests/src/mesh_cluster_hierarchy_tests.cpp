@@ -0,0 +1,127 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/resources/mesh_cluster_hierarchy.h"
+
+#include <limits>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+
+constexpr uint32_t kGridSize = 48;
+
+// Bumpy height field, so every simplification step has a measurable error.
+void makeTerrain(std::vector<Vertex> &vertices,
+                 std::vector<uint32_t> &indices) {
+  uint32_t state = 0x2468aceu;
+  for (uint32_t y = 0; y <= kGridSize; ++y) {
+    for (uint32_t x = 0; x <= kGridSize; ++x) {
+      state = state * 1664525u + 1013904223u;
+      Vertex vertex{};
+      vertex.position =
+          glm::vec3(static_cast<float>(x), static_cast<float>(y),
+                    static_cast<float>(state >> 24u) / 255.0f);
+      vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+      vertices.push_back(vertex);
+    }
+  }
+  for (uint32_t y = 0; y < kGridSize; ++y) {
+    for (uint32_t x = 0; x < kGridSize; ++x) {
+      const uint32_t corner = y * (kGridSize + 1u) + x;
+      const uint32_t above = corner + kGridSize + 1u;
+      indices.insert(indices.end(), {corner, corner + 1u, above + 1u, corner,
+                                     above + 1u, above});
+    }
+  }
+}
+
+bool isRoot(const MeshCluster &cluster) {
+  return cluster.parentError == std::numeric_limits<float>::max();
+}
+
+uint32_t totalIndexCount(const std::pmr::vector<SubmeshLod> &ranges) {
+  uint32_t total = 0;
+  for (const SubmeshLod &range : ranges) {
+    total += range.indexCount;
+  }
+  return total;
+}
+
+TEST(MeshClusterHierarchyTest, ErrorsAndBoundsGrowTowardsTheRoots) {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  makeTerrain(vertices, indices);
+
+  auto result = buildMeshClusterHierarchy(vertices, indices);
+  ASSERT_FALSE(result.hasError()) << result.error();
+  const MeshClusterHierarchy &hierarchy = result.value();
+
+  size_t finestIndexCount = 0;
+  size_t rootCount = 0;
+  for (const MeshCluster &cluster : hierarchy.clusters) {
+    ASSERT_LE(static_cast<size_t>(cluster.indexOffset) + cluster.indexCount,
+              hierarchy.indices.size());
+    EXPECT_EQ(cluster.indexCount % 3u, 0u);
+    if (cluster.error == 0.0f) {
+      finestIndexCount += cluster.indexCount;
+    }
+    if (isRoot(cluster)) {
+      ++rootCount;
+      continue;
+    }
+    EXPECT_GE(cluster.parentError, cluster.error);
+    const float centerDistance = glm::length(glm::vec3(cluster.parentBounds) -
+                                             glm::vec3(cluster.bounds));
+    EXPECT_LE(centerDistance + cluster.bounds.w,
+              cluster.parentBounds.w + 1e-3f);
+  }
+  EXPECT_EQ(finestIndexCount, indices.size());
+  EXPECT_GT(rootCount, 0u);
+  EXPECT_LT(rootCount, hierarchy.clusters.size());
+}
+
+TEST(MeshClusterHierarchyTest, SelectionFollowsTheErrorThreshold) {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  makeTerrain(vertices, indices);
+
+  auto result = buildMeshClusterHierarchy(vertices, indices);
+  ASSERT_FALSE(result.hasError()) << result.error();
+  const MeshClusterHierarchy &hierarchy = result.value();
+  const glm::vec3 viewer(0.0f, 0.0f, 100.0f);
+
+  std::pmr::vector<SubmeshLod> fine;
+  selectMeshClusters(hierarchy.clusters, glm::mat4(1.0f), viewer, 1e9f, fine);
+  EXPECT_EQ(totalIndexCount(fine), indices.size());
+  // Finest clusters are laid out back to back and merge into one range.
+  EXPECT_EQ(fine.size(), 1u);
+
+  std::pmr::vector<SubmeshLod> coarse;
+  selectMeshClusters(hierarchy.clusters, glm::mat4(1.0f), viewer, 0.0f,
+                     coarse);
+  uint32_t rootIndexCount = 0;
+  for (const MeshCluster &cluster : hierarchy.clusters) {
+    if (isRoot(cluster)) {
+      rootIndexCount += cluster.indexCount;
+    }
+  }
+  EXPECT_EQ(totalIndexCount(coarse), rootIndexCount);
+  EXPECT_LT(totalIndexCount(coarse), indices.size());
+}
+
+TEST(MeshClusterHierarchyTest, RejectsInvalidInput) {
+  std::vector<Vertex> vertices(3);
+  const std::vector<uint32_t> outOfRange = {0u, 1u, 3u};
+  EXPECT_TRUE(buildMeshClusterHierarchy(vertices, outOfRange).hasError());
+
+  const std::vector<uint32_t> triangle = {0u, 1u, 2u};
+  EXPECT_TRUE(buildMeshClusterHierarchy(
+                  vertices, triangle,
+                  MeshClusterHierarchyOptions{.groupClusterCount = 1u})
+                  .hasError());
+}
+
+} // namespace
@@ -0,0 +1,91 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/core/perf_counters.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+
+const PerfCounterId kTestDraws =
+    PerfCounters::registerCounter("tests.draws", PerfCounterKind::Counter);
+const PerfCounterId kTestResident =
+    PerfCounters::registerCounter("tests.resident", PerfCounterKind::Gauge);
+
+class PerfCounterTest : public ::testing::Test {
+protected:
+  void SetUp() override { PerfCounters::resetHistory(); }
+};
+
+TEST_F(PerfCounterTest, RegistrationIsStableByName) {
+  ASSERT_TRUE(kTestDraws.isValid());
+  EXPECT_EQ(PerfCounters::registerCounter("tests.draws").index,
+            kTestDraws.index);
+  EXPECT_EQ(PerfCounters::name(kTestDraws), "tests.draws");
+  EXPECT_EQ(PerfCounters::kind(kTestResident), PerfCounterKind::Gauge);
+  EXPECT_EQ(PerfCounters::counterAt(kTestResident.index).index,
+            kTestResident.index);
+}
+
+TEST_F(PerfCounterTest, CountersResetPerFrameAndGaugesPersist) {
+  PerfCounters::add(kTestDraws, 3u);
+  PerfCounters::add(kTestDraws);
+  PerfCounters::set(kTestResident, 42u);
+  PerfCounters::endFrame(10u);
+  PerfCounters::endFrame(11u);
+
+  ASSERT_EQ(PerfCounters::historySize(), 2u);
+  EXPECT_EQ(PerfCounters::frameIndex(0u), 11u);
+  EXPECT_EQ(PerfCounters::frameIndex(1u), 10u);
+  EXPECT_EQ(PerfCounters::value(kTestDraws, 1u), 4u);
+  EXPECT_EQ(PerfCounters::value(kTestDraws, 0u), 0u);
+  EXPECT_EQ(PerfCounters::value(kTestResident, 0u), 42u);
+  EXPECT_EQ(PerfCounters::value(kTestResident, 1u), 42u);
+  EXPECT_DOUBLE_EQ(PerfCounters::average(kTestDraws), 2.0);
+  EXPECT_EQ(PerfCounters::value(kTestDraws, 2u), 0u);
+}
+
+TEST_F(PerfCounterTest, ConcurrentAddsAreNotLost) {
+  constexpr uint32_t kThreads = 4u;
+  constexpr uint32_t kAddsPerThread = 10000u;
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([] {
+      for (uint32_t i = 0; i < kAddsPerThread; ++i) {
+        PerfCounters::add(kTestDraws);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  PerfCounters::endFrame(0u);
+  EXPECT_EQ(PerfCounters::value(kTestDraws), kThreads * kAddsPerThread);
+}
+
+TEST_F(PerfCounterTest, HistoryKeepsTheNewestFrames) {
+  const uint32_t frameCount = PerfCounters::kHistoryFrames + 5u;
+  for (uint32_t frame = 0; frame < frameCount; ++frame) {
+    PerfCounters::add(kTestDraws, frame);
+    PerfCounters::endFrame(frame);
+  }
+  EXPECT_EQ(PerfCounters::historySize(), PerfCounters::kHistoryFrames);
+  EXPECT_EQ(PerfCounters::value(kTestDraws, 0u), frameCount - 1u);
+  EXPECT_EQ(
+      PerfCounters::frameIndex(PerfCounters::kHistoryFrames - 1u),
+      static_cast<uint64_t>(frameCount - PerfCounters::kHistoryFrames));
+}
+
+TEST_F(PerfCounterTest, InvalidIdsAreIgnored) {
+  PerfCounters::add(PerfCounterId{}, 5u);
+  PerfCounters::set(PerfCounterId{}, 5u);
+  PerfCounters::endFrame(0u);
+  EXPECT_EQ(PerfCounters::value(PerfCounterId{}), 0u);
+  EXPECT_TRUE(PerfCounters::name(PerfCounterId{}).empty());
+}
+
+} // namespace
@@ -0,0 +1,307 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/pipeline_manager.h"
+#include "render_graph_test_support.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using namespace nuri;
+using namespace nuri::test_support;
+
+class FakePipelineGPUDevice final : public FakeGPUDeviceBase {
+public:
+  Result<RenderPipelineHandle, std::string>
+  createRenderPipeline(const RenderPipelineDesc &,
+                       std::string_view) override {
+    ++createdPipelineCount;
+    if (onCreate) {
+      onCreate();
+    }
+    return Result<RenderPipelineHandle, std::string>::makeResult(
+        RenderPipelineHandle{.index = nextPipelineIndex_++, .generation = 1u});
+  }
+
+  void destroyRenderPipeline(RenderPipelineHandle pipeline) override {
+    if (nuri::isValid(pipeline)) {
+      ++destroyedPipelineCount;
+    }
+  }
+
+  bool supportsBackgroundPipelineCompilation() const override {
+    return backgroundCompilation;
+  }
+
+  Result<std::unique_ptr<PipelineCompileJob>, std::string>
+  prepareRenderPipelineCompile(RenderPipelineHandle) override {
+    if (failPrepare) {
+      return Result<std::unique_ptr<PipelineCompileJob>, std::string>::
+          makeError("no pipeline cache");
+    }
+    return Result<std::unique_ptr<PipelineCompileJob>, std::string>::
+        makeResult(std::make_unique<FakeCompileJob>(*this));
+  }
+
+  Result<bool, std::string>
+  finishRenderPipelineCompile(PipelineCompileJob &) override {
+    ++finishedCompileCount;
+    if (std::this_thread::get_id() != ownerThread_) {
+      ++finishedOffThreadCount;
+    }
+    if (failFinish) {
+      return Result<bool, std::string>::makeError("cache merge failed");
+    }
+    return Result<bool, std::string>::makeResult(true);
+  }
+
+  void openCompileGate() {
+    std::scoped_lock lock(compileMutex_);
+    compileGateOpen_ = true;
+    compileCv_.notify_all();
+  }
+
+  void waitForCompileStarts(uint32_t count) {
+    std::unique_lock lock(compileMutex_);
+    compileCv_.wait(lock, [&] { return compileStartedCount_ >= count; });
+  }
+
+  bool backgroundCompilation = true;
+  bool failPrepare = false;
+  bool failCompile = false;
+  bool failFinish = false;
+  std::function<void()> onCreate;
+  uint32_t createdPipelineCount = 0u;
+  uint32_t destroyedPipelineCount = 0u;
+  uint32_t finishedCompileCount = 0u;
+  uint32_t finishedOffThreadCount = 0u;
+
+private:
+  class FakeCompileJob final : public PipelineCompileJob {
+  public:
+    explicit FakeCompileJob(FakePipelineGPUDevice &device) : device_(device) {}
+
+    Result<bool, std::string> compile() override {
+      std::unique_lock lock(device_.compileMutex_);
+      ++device_.compileStartedCount_;
+      device_.compileCv_.notify_all();
+      device_.compileCv_.wait(lock, [&] { return device_.compileGateOpen_; });
+      if (device_.failCompile) {
+        return Result<bool, std::string>::makeError(
+            "driver rejected pipeline");
+      }
+      return Result<bool, std::string>::makeResult(true);
+    }
+
+  private:
+    FakePipelineGPUDevice &device_;
+  };
+
+  std::thread::id ownerThread_ = std::this_thread::get_id();
+  std::mutex compileMutex_;
+  std::condition_variable compileCv_;
+  bool compileGateOpen_ = false;
+  uint32_t compileStartedCount_ = 0u;
+  uint32_t nextPipelineIndex_ = 1u;
+};
+
+bool sameHandle(RenderPipelineHandle lhs, RenderPipelineHandle rhs) {
+  return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+PipelineLookup acquireOrFail(PipelineManager &manager, uint64_t key,
+                             const PipelineRequest &request) {
+  auto result = manager.acquire(key, request);
+  EXPECT_FALSE(result.hasError()) << result.error();
+  return result.hasError() ? PipelineLookup{} : result.value();
+}
+
+TEST(PipelineManagerTest, DevicesWithoutBackgroundCompileCreateInline) {
+  FakePipelineGPUDevice gpu;
+  gpu.backgroundCompilation = false;
+  {
+    PipelineManager manager(gpu);
+    const uint64_t key = PipelineManager::makeKey(&gpu, "grid", 1u);
+    EXPECT_NE(key, PipelineManager::makeKey(&gpu, "grid", 2u));
+    EXPECT_NE(key, PipelineManager::makeKey(&manager, "grid", 1u));
+
+    const PipelineRequest request{.debugName = "grid",
+                                  .policy = PipelineFallbackPolicy::Skip};
+    const PipelineLookup first = acquireOrFail(manager, key, request);
+    EXPECT_EQ(first.status, PipelineStatus::Ready);
+    EXPECT_TRUE(nuri::isValid(first.handle));
+    EXPECT_FALSE(first.usingFallback);
+
+    const PipelineLookup second = acquireOrFail(manager, key, request);
+    EXPECT_TRUE(sameHandle(first.handle, second.handle));
+    EXPECT_EQ(gpu.createdPipelineCount, 1u);
+
+    manager.release(key);
+    EXPECT_EQ(gpu.destroyedPipelineCount, 1u);
+    manager.release(key);
+    EXPECT_EQ(gpu.destroyedPipelineCount, 1u);
+
+    static_cast<void>(acquireOrFail(manager, key + 1u, request));
+  }
+  // The manager destroys whatever is still registered.
+  EXPECT_EQ(gpu.destroyedPipelineCount, 2u);
+}
+
+TEST(PipelineManagerTest, PendingPipelinesUseFallbackOrSkipUntilCompiled) {
+  FakePipelineGPUDevice gpu;
+  PipelineManager manager(gpu);
+  const RenderPipelineHandle fallback{.index = 100u, .generation = 1u};
+
+  const PipelineRequest fallbackRequest{
+      .debugName = "variant",
+      .policy = PipelineFallbackPolicy::UseFallback,
+      .fallback = fallback};
+  const PipelineLookup pendingWithFallback =
+      acquireOrFail(manager, 1u, fallbackRequest);
+  EXPECT_EQ(pendingWithFallback.status, PipelineStatus::Pending);
+  EXPECT_TRUE(pendingWithFallback.usingFallback);
+  EXPECT_TRUE(sameHandle(pendingWithFallback.handle, fallback));
+
+  const PipelineRequest skipRequest{.debugName = "overlay",
+                                    .policy = PipelineFallbackPolicy::Skip};
+  const PipelineLookup skipped = acquireOrFail(manager, 2u, skipRequest);
+  EXPECT_EQ(skipped.status, PipelineStatus::Pending);
+  EXPECT_FALSE(nuri::isValid(skipped.handle));
+
+  // UseFallback without a fallback pipeline degrades to skipping.
+  const PipelineLookup noFallback = acquireOrFail(
+      manager, 2u,
+      PipelineRequest{.policy = PipelineFallbackPolicy::UseFallback});
+  EXPECT_FALSE(nuri::isValid(noFallback.handle));
+
+  PipelineManagerStats stats = manager.stats();
+  EXPECT_EQ(stats.pendingPipelines, 2u);
+  EXPECT_EQ(stats.fallbackLookups, 1u);
+  EXPECT_EQ(stats.skippedLookups, 2u);
+
+  gpu.openCompileGate();
+  manager.waitIdle();
+  manager.beginFrame(1u);
+
+  const PipelineLookup ready = acquireOrFail(manager, 1u, fallbackRequest);
+  EXPECT_EQ(ready.status, PipelineStatus::Ready);
+  EXPECT_FALSE(ready.usingFallback);
+  EXPECT_FALSE(sameHandle(ready.handle, fallback));
+  EXPECT_TRUE(nuri::isValid(acquireOrFail(manager, 2u, skipRequest).handle));
+
+  EXPECT_EQ(gpu.finishedCompileCount, 2u);
+  EXPECT_EQ(gpu.finishedOffThreadCount, 0u)
+      << "results must be published on the render thread";
+
+  stats = manager.stats();
+  EXPECT_EQ(stats.readyPipelines, 2u);
+  EXPECT_EQ(stats.pendingPipelines, 0u);
+  EXPECT_EQ(stats.backgroundCompiles, 2u);
+  EXPECT_EQ(stats.fallbackLookups, 0u);
+  EXPECT_EQ(gpu.createdPipelineCount, 2u);
+}
+
+TEST(PipelineManagerTest, FallbackSwapsToCompiledPipelineOnlyWhenPublished) {
+  FakePipelineGPUDevice gpu;
+  PipelineManager manager(gpu);
+  const RenderPipelineHandle fallback{.index = 100u, .generation = 1u};
+  const PipelineRequest request{.debugName = "variant",
+                                .policy = PipelineFallbackPolicy::UseFallback,
+                                .fallback = fallback};
+
+  EXPECT_TRUE(sameHandle(acquireOrFail(manager, 1u, request).handle, fallback));
+  gpu.openCompileGate();
+  while (manager.stats().backgroundCompiles < 1u) {
+    std::this_thread::yield();
+  }
+  // The worker is done, but nothing swaps until the render thread publishes.
+  const PipelineLookup unpublished = acquireOrFail(manager, 1u, request);
+  EXPECT_EQ(unpublished.status, PipelineStatus::Pending);
+  EXPECT_TRUE(sameHandle(unpublished.handle, fallback));
+  EXPECT_EQ(gpu.finishedCompileCount, 0u);
+
+  manager.beginFrame(1u);
+  const PipelineLookup swapped = acquireOrFail(manager, 1u, request);
+  EXPECT_EQ(swapped.status, PipelineStatus::Ready);
+  EXPECT_FALSE(swapped.usingFallback);
+  EXPECT_FALSE(sameHandle(swapped.handle, fallback));
+  EXPECT_EQ(gpu.finishedCompileCount, 1u);
+
+  // A failed finish keeps the variant off the fallback for good.
+  gpu.failFinish = true;
+  static_cast<void>(acquireOrFail(manager, 2u, request));
+  manager.waitIdle();
+  auto failed = manager.acquire(2u, request);
+  ASSERT_TRUE(failed.hasError());
+  EXPECT_NE(failed.error().find("cache merge failed"), std::string::npos);
+  EXPECT_EQ(manager.stats().readyPipelines, 1u);
+}
+
+TEST(PipelineManagerTest, ReleaseDuringCompileDropsTheResultAndFailuresReport) {
+  FakePipelineGPUDevice gpu;
+  PipelineManager manager(gpu);
+  const PipelineRequest request{.debugName = "tess_wireframe",
+                                .policy = PipelineFallbackPolicy::Skip};
+
+  static_cast<void>(acquireOrFail(manager, 7u, request));
+  gpu.waitForCompileStarts(1u);
+  // The job owns what it compiles, so the pipeline can go right away.
+  manager.release(7u);
+  EXPECT_EQ(gpu.destroyedPipelineCount, 1u);
+
+  gpu.openCompileGate();
+  manager.waitIdle();
+  manager.beginFrame(1u);
+  EXPECT_EQ(gpu.destroyedPipelineCount, 1u);
+  EXPECT_EQ(gpu.finishedCompileCount, 0u);
+
+  // Block creates inline even when background compilation is available.
+  const PipelineLookup blocked = acquireOrFail(
+      manager, 8u,
+      PipelineRequest{.debugName = "pick",
+                      .policy = PipelineFallbackPolicy::Block});
+  EXPECT_EQ(blocked.status, PipelineStatus::Ready);
+
+  gpu.failCompile = true;
+  static_cast<void>(acquireOrFail(manager, 9u, request));
+  manager.waitIdle();
+  auto failed = manager.acquire(9u, request);
+  ASSERT_TRUE(failed.hasError());
+  EXPECT_NE(failed.error().find("driver rejected pipeline"), std::string::npos);
+}
+
+TEST(PipelineManagerTest, DeviceCallsRunOutsideTheManagerLock) {
+  FakePipelineGPUDevice gpu;
+  PipelineManager manager(gpu);
+  // Re-entering the manager from a device call would deadlock if acquire()
+  // held its mutex across createRenderPipeline.
+  gpu.onCreate = [&] { static_cast<void>(manager.stats()); };
+  gpu.openCompileGate();
+
+  const PipelineRequest request{.debugName = "overlay",
+                                .policy = PipelineFallbackPolicy::Block};
+  static_cast<void>(acquireOrFail(
+      manager, 1u,
+      PipelineRequest{.debugName = "overlay",
+                      .policy = PipelineFallbackPolicy::Skip}));
+  const PipelineLookup blocked = acquireOrFail(manager, 1u, request);
+  EXPECT_EQ(blocked.status, PipelineStatus::Ready);
+  EXPECT_EQ(gpu.finishedCompileCount, 1u);
+
+  // Without a job the pipeline is still usable and compiles at first bind.
+  gpu.failPrepare = true;
+  const PipelineLookup unprepared = acquireOrFail(
+      manager, 2u,
+      PipelineRequest{.debugName = "grid",
+                      .policy = PipelineFallbackPolicy::Skip});
+  EXPECT_EQ(unprepared.status, PipelineStatus::Ready);
+  EXPECT_TRUE(nuri::isValid(unprepared.handle));
+}
+
+} // namespace
@@ -0,0 +1,85 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/core/pmr_scratch.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+
+class CountingResource final : public std::pmr::memory_resource {
+public:
+  size_t allocationCount = 0u;
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocationCount;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+void fillScratch(ScratchArena &arena, size_t bytes) {
+  ScopedScratch scope(arena);
+  std::pmr::vector<std::byte> data(scope.resource());
+  data.resize(bytes);
+}
+
+TEST(PmrScratchTest, ArenaRetainsHighWaterMarkAcrossScopes) {
+  CountingResource upstream;
+  ScratchArena arena(&upstream);
+
+  fillScratch(arena, 48u * 1024u);
+  EXPECT_GE(arena.highWaterMark(), 48u * 1024u);
+  EXPECT_GE(arena.capacity(), 48u * 1024u);
+
+  const size_t allocationsAfterWarmup = upstream.allocationCount;
+  for (int frame = 0; frame < 8; ++frame) {
+    fillScratch(arena, 48u * 1024u);
+  }
+  EXPECT_EQ(upstream.allocationCount, allocationsAfterWarmup);
+}
+
+TEST(PmrScratchTest, ThreadScratchNestsOnSeparateArenas) {
+  ScopedThreadScratch outer;
+  std::pmr::vector<int> outerData(outer.resource());
+  outerData.assign(64u, 7);
+  {
+    ScopedThreadScratch inner;
+    EXPECT_NE(inner.resource(), outer.resource());
+    std::pmr::vector<int> innerData(inner.resource());
+    innerData.assign(64u, 3);
+  }
+  EXPECT_EQ(outerData.front(), 7);
+  EXPECT_EQ(outerData.back(), 7);
+}
+
+TEST(PmrScratchTest, FrameArenaRingRecyclesOnlyTheReusedSlot) {
+  FrameArenaRing<2> ring;
+  ring.beginFrame(0u);
+  std::pmr::memory_resource *frame0 = ring.resource();
+  auto *frame0Data =
+      static_cast<int *>(frame0->allocate(sizeof(int), alignof(int)));
+  *frame0Data = 42;
+
+  ring.beginFrame(1u);
+  EXPECT_NE(ring.resource(), frame0);
+  static_cast<void>(ring.resource()->allocate(1024u));
+  EXPECT_EQ(*frame0Data, 42);
+
+  ring.beginFrame(2u);
+  EXPECT_EQ(ring.resource(), frame0);
+}
+
+} // namespace
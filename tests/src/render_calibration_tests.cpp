@@ -0,0 +1,144 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/render_calibration.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+using namespace nuri;
+
+constexpr RenderCalibrationConfig kConfig{
+    .targetFrameMs = 10.0,
+    .warmupFrames = 2,
+    .sampleFrames = 5,
+};
+
+std::filesystem::path makeTempPath(std::string_view stem) {
+  const auto tick =
+      std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  return std::filesystem::temp_directory_path() /
+         ("nuri_" + std::string(stem) + "_" + std::to_string(tick) + ".json");
+}
+
+// Runs one full tier at a fixed frame interval and returns whether the
+// calibration reported a change on the last frame.
+bool runTier(RenderCalibration &calibration, double intervalSeconds) {
+  bool changed = false;
+  for (uint32_t i = 0; i < kConfig.warmupFrames + kConfig.sampleFrames; ++i) {
+    changed = calibration.recordFrame(0.002, intervalSeconds);
+  }
+  return changed;
+}
+
+TEST(RenderCalibrationTest, KeepsHighestTierThatMeetsTarget) {
+  RenderCalibration calibration;
+  calibration.begin(kConfig);
+  ASSERT_TRUE(calibration.isRunning());
+  EXPECT_EQ(calibration.currentTier(), RenderQualityTier::High);
+
+  EXPECT_TRUE(runTier(calibration, 0.020));
+  EXPECT_TRUE(calibration.isRunning());
+  EXPECT_EQ(calibration.currentTier(), RenderQualityTier::Medium);
+
+  EXPECT_TRUE(runTier(calibration, 0.008));
+  EXPECT_FALSE(calibration.isRunning());
+  ASSERT_TRUE(calibration.result().has_value());
+  EXPECT_EQ(calibration.result()->tier, RenderQualityTier::Medium);
+  EXPECT_DOUBLE_EQ(calibration.result()->frameIntervalMs, 8.0);
+  EXPECT_DOUBLE_EQ(calibration.result()->cpuFrameMs, 2.0);
+}
+
+TEST(RenderCalibrationTest, WarmupFramesAndOutliersDoNotDecide) {
+  RenderCalibration calibration;
+  calibration.begin(kConfig);
+  // Slow warmup frames are ignored and a single spike does not move the
+  // median.
+  EXPECT_FALSE(calibration.recordFrame(0.002, 0.500));
+  EXPECT_FALSE(calibration.recordFrame(0.002, 0.500));
+  EXPECT_FALSE(calibration.recordFrame(0.002, 0.100));
+  for (uint32_t i = 1; i < kConfig.sampleFrames - 1u; ++i) {
+    EXPECT_FALSE(calibration.recordFrame(0.002, 0.009));
+  }
+  EXPECT_EQ(calibration.framesRemainingInTier(), 1u);
+  EXPECT_TRUE(calibration.recordFrame(0.002, 0.009));
+  ASSERT_TRUE(calibration.result().has_value());
+  EXPECT_EQ(calibration.result()->tier, RenderQualityTier::High);
+}
+
+TEST(RenderCalibrationTest, FallsBackToLowWhenNothingMeetsTarget) {
+  RenderCalibration calibration;
+  calibration.begin(kConfig);
+  EXPECT_TRUE(runTier(calibration, 0.050));
+  EXPECT_TRUE(runTier(calibration, 0.050));
+  EXPECT_TRUE(runTier(calibration, 0.050));
+  EXPECT_FALSE(calibration.isRunning());
+  ASSERT_TRUE(calibration.result().has_value());
+  EXPECT_EQ(calibration.result()->tier, RenderQualityTier::Low);
+}
+
+TEST(RenderCalibrationTest, TiersScaleSceneLodDistances) {
+  RenderSettings low{};
+  low.opaque.meshLodDistanceThresholds = glm::vec3(8.0f, 24.0f, 48.0f);
+  RenderSettings high = low;
+  applyRenderQualityTier(RenderQualityTier::Low, low);
+  applyRenderQualityTier(RenderQualityTier::High, high);
+
+  EXPECT_LT(low.opaque.meshLodDistanceThresholds.x,
+            high.opaque.meshLodDistanceThresholds.x);
+  EXPECT_FLOAT_EQ(low.opaque.meshLodDistanceThresholds.z, 24.0f);
+  EXPECT_GT(low.opaque.clusterLodErrorPixels,
+            high.opaque.clusterLodErrorPixels);
+  EXPECT_LT(low.opaque.tessMaxInstances, high.opaque.tessMaxInstances);
+
+  RenderSettings medium{};
+  const RenderSettings defaults{};
+  applyRenderQualityTier(RenderQualityTier::Medium, medium);
+  EXPECT_FLOAT_EQ(medium.opaque.clusterLodErrorPixels,
+                  defaults.opaque.clusterLodErrorPixels);
+  EXPECT_EQ(medium.opaque.instanceAnimationMaxUpdatePeriod,
+            defaults.opaque.instanceAnimationMaxUpdatePeriod);
+}
+
+TEST(RenderCalibrationTest, ProfileRoundTripsThroughDisk) {
+  const std::filesystem::path path = makeTempPath("render_calibration");
+  const RenderCalibrationProfile profile{
+      .tier = RenderQualityTier::Low,
+      .targetFrameMs = 8.25,
+      .cpuFrameMs = 3.5,
+      .frameIntervalMs = 7.75,
+  };
+  auto saveResult = saveRenderCalibrationProfile(path, profile);
+  ASSERT_FALSE(saveResult.hasError()) << saveResult.error();
+
+  auto loadResult = loadRenderCalibrationProfile(path);
+  ASSERT_FALSE(loadResult.hasError()) << loadResult.error();
+  EXPECT_EQ(loadResult.value().tier, RenderQualityTier::Low);
+  EXPECT_DOUBLE_EQ(loadResult.value().targetFrameMs, 8.25);
+  EXPECT_DOUBLE_EQ(loadResult.value().cpuFrameMs, 3.5);
+  EXPECT_DOUBLE_EQ(loadResult.value().frameIntervalMs, 7.75);
+
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+TEST(RenderCalibrationTest, RejectsUnknownTier) {
+  const std::filesystem::path path = makeTempPath("render_calibration_bad");
+  {
+    std::ofstream output(path, std::ios::out | std::ios::trunc);
+    output << "{\"version\": 1, \"tier\": \"ultra\", "
+              "\"target_frame_ms\": 16.0}";
+  }
+  EXPECT_TRUE(loadRenderCalibrationProfile(path).hasError());
+  EXPECT_TRUE(
+      loadRenderCalibrationProfile(makeTempPath("missing")).hasError());
+
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+} // namespace
@@ -1819,4 +1819,404 @@ TEST(RenderGraphCompileBehaviorTest, ExplicitAccessOverridesLegacyInference) {
   }
 }
 
+TEST(RenderGraphCompileBehaviorTest,
+     ComputeAndTransferPassesScheduleAndCullDeadCompute) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(240u);
+
+  auto scratchResult = builder.createTransientBuffer(
+      makeTransientBufferDesc(64u), "ct_scratch");
+  auto deadResult =
+      builder.createTransientBuffer(makeTransientBufferDesc(64u), "ct_dead");
+  auto readbackResult = builder.importBuffer(
+      BufferHandle{.index = 7u, .generation = 1u}, "ct_readback");
+  ASSERT_FALSE(scratchResult.hasError());
+  ASSERT_FALSE(deadResult.hasError());
+  ASSERT_FALSE(readbackResult.hasError());
+
+  const std::array<ComputeDispatchItem, 1> dispatches = {ComputeDispatchItem{}};
+  RenderGraphComputePassDesc computeDesc{};
+  computeDesc.dispatches = dispatches;
+  computeDesc.debugLabel = "ct_compute";
+  auto computeResult = builder.addComputePass(computeDesc);
+  computeDesc.debugLabel = "ct_dead_compute";
+  auto deadComputeResult = builder.addComputePass(computeDesc);
+  ASSERT_FALSE(computeResult.hasError());
+  ASSERT_FALSE(deadComputeResult.hasError());
+  ASSERT_FALSE(
+      builder.addBufferWrite(computeResult.value(), scratchResult.value())
+          .hasError());
+  ASSERT_FALSE(
+      builder.addBufferWrite(deadComputeResult.value(), deadResult.value())
+          .hasError());
+
+  const std::array<RenderGraphBufferCopy, 1> copies = {RenderGraphBufferCopy{
+      .source = scratchResult.value(),
+      .destination = readbackResult.value(),
+      .size = 64u,
+  }};
+  RenderGraphTransferPassDesc transferDesc{};
+  transferDesc.copies = copies;
+  transferDesc.debugLabel = "ct_transfer";
+  transferDesc.markSideEffect = true;
+  auto transferResult = builder.addTransferPass(transferDesc);
+  ASSERT_FALSE(transferResult.hasError());
+
+  auto compileResult = compileBuilder(builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+
+  EXPECT_EQ(compiled.culledPassCount, 1u);
+  ASSERT_EQ(compiled.orderedPassIndices.size(), 2u);
+  EXPECT_EQ(compiled.orderedPassIndices[0u], computeResult.value().value);
+  EXPECT_EQ(compiled.orderedPassIndices[1u], transferResult.value().value);
+  EXPECT_EQ(compiled.orderedPasses[0u].kind, RenderPassKind::Compute);
+  EXPECT_EQ(compiled.orderedPasses[0u].preDispatches.size(), 1u);
+  EXPECT_EQ(compiled.orderedPasses[1u].kind, RenderPassKind::Transfer);
+  ASSERT_EQ(compiled.orderedPasses[1u].copies.size(), 1u);
+  EXPECT_TRUE(sameBuffer(compiled.orderedPasses[1u].copies[0u].dstBuffer,
+                         BufferHandle{.index = 7u, .generation = 1u}));
+  ASSERT_EQ(compiled.unresolvedCopyBufferBindings.size(), 1u);
+  EXPECT_EQ(compiled.unresolvedCopyBufferBindings[0u].target,
+            RenderGraphCompileResult::CopyBufferBindingTarget::Source);
+}
+
+TEST(RenderGraphCompileBehaviorTest, TransferPassRejectsInvalidCopies) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(241u);
+
+  auto bufferResult =
+      builder.createTransientBuffer(makeTransientBufferDesc(64u), "ct_buf");
+  ASSERT_FALSE(bufferResult.hasError());
+
+  RenderGraphTransferPassDesc emptyDesc{};
+  EXPECT_TRUE(builder.addTransferPass(emptyDesc).hasError());
+
+  const std::array<RenderGraphBufferCopy, 1> selfCopy = {RenderGraphBufferCopy{
+      .source = bufferResult.value(),
+      .destination = bufferResult.value(),
+      .size = 16u,
+  }};
+  RenderGraphTransferPassDesc selfDesc{};
+  selfDesc.copies = selfCopy;
+  EXPECT_TRUE(builder.addTransferPass(selfDesc).hasError());
+
+  RenderGraphComputePassDesc emptyComputeDesc{};
+  EXPECT_TRUE(builder.addComputePass(emptyComputeDesc).hasError());
+  EXPECT_EQ(builder.passCount(), 0u);
+}
+
+TEST(RenderGraphCompileBehaviorTest,
+     AdditionalColorAttachmentsResolveAsAttachmentsAndRootImports) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(242u);
+
+  const TextureHandle pickTexture{.index = 11u, .generation = 1u};
+  auto pickResult = builder.importTexture(pickTexture, "mrt_pick");
+  auto scratchResult = builder.createTransientTexture(
+      makeTransientTextureDesc(Format::RGBA8_UNORM, 64u, 64u), "mrt_scratch");
+  ASSERT_FALSE(pickResult.hasError());
+  ASSERT_FALSE(scratchResult.hasError());
+
+  const std::array<RenderGraphColorAttachment, 1> attachments = {
+      RenderGraphColorAttachment{
+          .color = {.loadOp = LoadOp::Clear, .storeOp = StoreOp::Store},
+          .texture = pickResult.value()}};
+  RenderGraphGraphicsPassDesc writerDesc{};
+  writerDesc.colorTexture = scratchResult.value();
+  writerDesc.additionalColorAttachments = attachments;
+  writerDesc.debugLabel = "mrt_writer";
+  auto writerResult = builder.addGraphicsPass(writerDesc);
+  ASSERT_FALSE(writerResult.hasError()) << writerResult.error();
+
+  RenderGraphGraphicsPassDesc readerDesc{};
+  readerDesc.debugLabel = "mrt_reader";
+  auto readerResult = builder.addGraphicsPass(readerDesc);
+  ASSERT_FALSE(readerResult.hasError());
+  ASSERT_FALSE(
+      builder.addTextureRead(readerResult.value(), pickResult.value())
+          .hasError());
+
+  auto compileResult = compileBuilder(builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+
+  EXPECT_EQ(compiled.culledPassCount, 0u)
+      << "imported MRT target should keep the writer pass alive";
+  ASSERT_EQ(compiled.orderedPasses.size(), 2u);
+  EXPECT_EQ(compiled.orderedPasses[0u].additionalColorCount, 1u);
+  EXPECT_TRUE(sameTexture(
+      compiled.orderedPasses[0u].additionalColorTextures[0u], pickTexture));
+  ASSERT_EQ(compiled.unresolvedTextureBindings.size(), 1u);
+  EXPECT_EQ(compiled.unresolvedTextureBindings[0u].target,
+            RenderGraphCompileResult::PassTextureBindingTarget::Color);
+
+  const PassBarrierPlan &readerPlan = compiled.passBarrierPlans[1u];
+  bool foundPickBarrier = false;
+  for (uint32_t i = 0; i < readerPlan.barrierCount; ++i) {
+    const RenderGraphBarrierRecord &record =
+        compiled.passBarrierRecords[readerPlan.barrierOffset + i];
+    if (record.resourceKind != RenderGraphBarrierResourceKind::Texture ||
+        record.resourceIndex != pickResult.value().value) {
+      continue;
+    }
+    foundPickBarrier = true;
+    EXPECT_EQ(record.beforeState, RenderGraphResourceState::Attachment);
+    EXPECT_EQ(record.afterState, RenderGraphResourceState::Read);
+  }
+  EXPECT_TRUE(foundPickBarrier);
+}
+
+TEST(RenderGraphCompileBehaviorTest, AdditionalColorAttachmentsRejectOverflow) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(243u);
+
+  auto textureResult = builder.importTexture(
+      TextureHandle{.index = 12u, .generation = 1u}, "mrt_overflow");
+  ASSERT_FALSE(textureResult.hasError());
+
+  std::array<RenderGraphColorAttachment, kMaxAdditionalColorAttachments + 1u>
+      attachments{};
+  for (RenderGraphColorAttachment &attachment : attachments) {
+    attachment.texture = textureResult.value();
+  }
+  RenderGraphGraphicsPassDesc overflowDesc{};
+  overflowDesc.additionalColorAttachments = attachments;
+  EXPECT_TRUE(builder.addGraphicsPass(overflowDesc).hasError());
+
+  RenderGraphGraphicsPassDesc plainDesc{};
+  auto plainResult = builder.addGraphicsPass(plainDesc);
+  ASSERT_FALSE(plainResult.hasError());
+  EXPECT_TRUE(builder
+                  .bindPassAdditionalColorTexture(plainResult.value(), 0u,
+                                                  textureResult.value())
+                  .hasError())
+      << "binding past the declared attachment count should fail";
+}
+
+TEST(RenderGraphCompileBehaviorTest, BarrierRecordsCarryBindingStages) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(245u);
+
+  const BufferHandle argsBuffer{.index = 31u, .generation = 1u};
+  auto argsResult = builder.importBuffer(argsBuffer, "stage_args");
+  auto colorResult = builder.createTransientTexture(
+      makeTransientTextureDesc(Format::RGBA8_UNORM, 64u, 64u), "stage_color");
+  auto outputResult = builder.importTexture(
+      TextureHandle{.index = 32u, .generation = 1u}, "stage_output");
+  ASSERT_FALSE(argsResult.hasError());
+  ASSERT_FALSE(colorResult.hasError());
+  ASSERT_FALSE(outputResult.hasError());
+
+  const std::array<ComputeDispatchItem, 1> dispatches = {ComputeDispatchItem{}};
+  RenderGraphComputePassDesc cullDesc{};
+  cullDesc.dispatches = dispatches;
+  cullDesc.debugLabel = "stage_cull";
+  auto cullResult = builder.addComputePass(cullDesc);
+  ASSERT_FALSE(cullResult.hasError());
+  ASSERT_FALSE(
+      builder.addBufferWrite(cullResult.value(), argsResult.value())
+          .hasError());
+
+  const std::array<DrawItem, 1> draws = {DrawItem{
+      .command = DrawCommandType::IndexedIndirect,
+      .indirectBuffer = argsBuffer,
+  }};
+  RenderGraphGraphicsPassDesc drawDesc{};
+  drawDesc.colorTexture = colorResult.value();
+  drawDesc.draws = draws;
+  drawDesc.debugLabel = "stage_draw";
+  auto drawResult = builder.addGraphicsPass(drawDesc);
+  ASSERT_FALSE(drawResult.hasError()) << drawResult.error();
+
+  RenderGraphGraphicsPassDesc resolveDesc{};
+  resolveDesc.colorTexture = outputResult.value();
+  resolveDesc.debugLabel = "stage_resolve";
+  resolveDesc.markColorAsFrameOutput = true;
+  auto resolveResult = builder.addGraphicsPass(resolveDesc);
+  ASSERT_FALSE(resolveResult.hasError());
+  ASSERT_FALSE(
+      builder.addTextureRead(resolveResult.value(), colorResult.value())
+          .hasError());
+
+  auto compileResult = compileBuilder(builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+  ASSERT_EQ(compiled.passBarrierPlans.size(), 3u);
+
+  const auto findRecord = [&compiled](uint32_t orderedPass,
+                                      RenderGraphBarrierResourceKind kind,
+                                      uint32_t resourceIndex)
+      -> const RenderGraphBarrierRecord * {
+    const PassBarrierPlan &plan = compiled.passBarrierPlans[orderedPass];
+    for (uint32_t i = 0; i < plan.barrierCount; ++i) {
+      const RenderGraphBarrierRecord &record =
+          compiled.passBarrierRecords[plan.barrierOffset + i];
+      if (record.resourceKind == kind &&
+          record.resourceIndex == resourceIndex) {
+        return &record;
+      }
+    }
+    return nullptr;
+  };
+
+  const RenderGraphBarrierRecord *argsRecord = findRecord(
+      1u, RenderGraphBarrierResourceKind::Buffer, argsResult.value().value);
+  ASSERT_NE(argsRecord, nullptr);
+  EXPECT_EQ(argsRecord->beforeStages, RenderGraphStage::ComputeShader);
+  EXPECT_EQ(argsRecord->afterStages, RenderGraphStage::DrawIndirect);
+
+  const RenderGraphBarrierRecord *colorRecord = findRecord(
+      2u, RenderGraphBarrierResourceKind::Texture, colorResult.value().value);
+  ASSERT_NE(colorRecord, nullptr);
+  EXPECT_EQ(colorRecord->beforeStages, RenderGraphStage::ColorAttachment);
+  EXPECT_EQ(colorRecord->afterStages, RenderGraphStage::VertexShader |
+                                          RenderGraphStage::FragmentShader);
+
+  const FinalBarrierPlan &finalPlan = compiled.finalBarrierPlan;
+  ASSERT_EQ(finalPlan.barrierCount, 1u);
+  const RenderGraphBarrierRecord &presentRecord =
+      compiled.passBarrierRecords[finalPlan.barrierOffset];
+  EXPECT_EQ(presentRecord.beforeStages, RenderGraphStage::ColorAttachment);
+  EXPECT_EQ(presentRecord.afterStages, RenderGraphStage::None);
+}
+
+const RenderGraphBarrierRecord *
+findBufferBarrier(const RenderGraphCompileResult &compiled,
+                  RenderGraphPassId pass, RenderGraphBufferId buffer) {
+  const auto rank = std::find(compiled.orderedPassIndices.begin(),
+                              compiled.orderedPassIndices.end(), pass.value);
+  if (rank == compiled.orderedPassIndices.end()) {
+    return nullptr;
+  }
+  const PassBarrierPlan &plan = compiled.passBarrierPlans[static_cast<size_t>(
+      rank - compiled.orderedPassIndices.begin())];
+  for (uint32_t i = 0; i < plan.barrierCount; ++i) {
+    const RenderGraphBarrierRecord &record =
+        compiled.passBarrierRecords[plan.barrierOffset + i];
+    if (record.resourceKind == RenderGraphBarrierResourceKind::Buffer &&
+        record.resourceIndex == buffer.value) {
+      return &record;
+    }
+  }
+  return nullptr;
+}
+
+// Compute writes `args`, one pass draws indirectly from it and a second pass
+// reads it with an explicit (unstaged) access.
+struct SharedReadGraph {
+  RenderGraphBuilder builder;
+  RenderGraphBufferId args{};
+  RenderGraphPassId writer{};
+  RenderGraphPassId indirectReader{};
+  RenderGraphPassId shaderReader{};
+  std::array<ComputeDispatchItem, 1> dispatches = {ComputeDispatchItem{}};
+  std::array<DrawItem, 1> draws = {DrawItem{
+      .command = DrawCommandType::IndexedIndirect,
+      .indirectBuffer = BufferHandle{.index = 41u, .generation = 1u},
+  }};
+
+  void build() {
+    builder.beginFrame(246u);
+    auto argsResult = builder.importBuffer(draws[0].indirectBuffer, "args");
+    ASSERT_FALSE(argsResult.hasError());
+    args = argsResult.value();
+
+    RenderGraphComputePassDesc writeDesc{};
+    writeDesc.dispatches = dispatches;
+    writeDesc.debugLabel = "args_write";
+    auto writeResult = builder.addComputePass(writeDesc);
+    ASSERT_FALSE(writeResult.hasError());
+    writer = writeResult.value();
+    ASSERT_FALSE(builder.addBufferWrite(writer, args).hasError());
+
+    const auto addColorPass = [this](std::string_view label, uint32_t index,
+                                     bool withDraws) -> RenderGraphPassId {
+      auto colorResult = builder.importTexture(
+          TextureHandle{.index = index, .generation = 1u}, label);
+      EXPECT_FALSE(colorResult.hasError());
+      RenderGraphGraphicsPassDesc desc{};
+      desc.colorTexture = colorResult.value();
+      if (withDraws) {
+        desc.draws = draws;
+      }
+      desc.debugLabel = label;
+      desc.markColorAsFrameOutput = true;
+      auto passResult = builder.addGraphicsPass(desc);
+      EXPECT_FALSE(passResult.hasError()) << passResult.error();
+      return passResult.value();
+    };
+    indirectReader = addColorPass("indirect_reader", 42u, true);
+    shaderReader = addColorPass("shader_reader", 43u, false);
+    ASSERT_FALSE(builder.addBufferRead(shaderReader, args).hasError());
+  }
+};
+
+TEST(RenderGraphCompileBehaviorTest, ReaderInNewStageWaitsOnTheWriter) {
+  SharedReadGraph graph;
+  ASSERT_NO_FATAL_FAILURE(graph.build());
+
+  auto compileResult = compileBuilder(graph.builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+
+  const RenderGraphBarrierRecord *indirect =
+      findBufferBarrier(compiled, graph.indirectReader, graph.args);
+  ASSERT_NE(indirect, nullptr);
+  EXPECT_EQ(indirect->afterStages, RenderGraphStage::DrawIndirect);
+
+  const RenderGraphBarrierRecord *shader =
+      findBufferBarrier(compiled, graph.shaderReader, graph.args);
+  ASSERT_NE(shader, nullptr)
+      << "shader stages were not covered by the indirect reader's barrier";
+  EXPECT_EQ(shader->beforeAccess, RenderGraphAccessMode::Write);
+  EXPECT_EQ(shader->beforeStages, RenderGraphStage::ComputeShader);
+  EXPECT_EQ(shader->afterStages, RenderGraphStage::VertexShader |
+                                     RenderGraphStage::FragmentShader);
+}
+
+TEST(RenderGraphCompileBehaviorTest, WriteAfterReadsWaitsOnEveryReader) {
+  SharedReadGraph graph;
+  ASSERT_NO_FATAL_FAILURE(graph.build());
+
+  RenderGraphComputePassDesc rewriteDesc{};
+  rewriteDesc.dispatches = graph.dispatches;
+  rewriteDesc.debugLabel = "args_rewrite";
+  rewriteDesc.markSideEffect = true;
+  auto rewriteResult = graph.builder.addComputePass(rewriteDesc);
+  ASSERT_FALSE(rewriteResult.hasError());
+  ASSERT_FALSE(graph.builder.addBufferWrite(rewriteResult.value(), graph.args)
+                   .hasError());
+
+  auto compileResult = compileBuilder(graph.builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphBarrierRecord *rewrite = findBufferBarrier(
+      compileResult.value(), rewriteResult.value(), graph.args);
+  ASSERT_NE(rewrite, nullptr);
+  EXPECT_EQ(rewrite->beforeStages, RenderGraphStage::DrawIndirect |
+                                       RenderGraphStage::VertexShader |
+                                       RenderGraphStage::FragmentShader);
+  EXPECT_EQ(rewrite->afterStages, RenderGraphStage::ComputeShader);
+}
+
+TEST(RenderGraphCompileBehaviorTest, UnstagedAccessKeepsFallbackNextToBinding) {
+  SharedReadGraph graph;
+  ASSERT_NO_FATAL_FAILURE(graph.build());
+  ASSERT_FALSE(graph.builder.addBufferRead(graph.indirectReader, graph.args)
+                   .hasError());
+
+  auto compileResult = compileBuilder(graph.builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+  const RenderGraphBarrierRecord *indirect =
+      findBufferBarrier(compiled, graph.indirectReader, graph.args);
+  ASSERT_NE(indirect, nullptr);
+  EXPECT_EQ(indirect->afterStages, RenderGraphStage::DrawIndirect |
+                                       RenderGraphStage::VertexShader |
+                                       RenderGraphStage::FragmentShader);
+  EXPECT_EQ(findBufferBarrier(compiled, graph.shaderReader, graph.args),
+            nullptr)
+      << "the shader reader's stages are already synchronized";
+}
+
 } // namespace
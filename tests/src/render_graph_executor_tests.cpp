@@ -2564,4 +2564,98 @@ TEST_F(RenderGraphExecutorTest,
   }
 }
 
+TEST_F(RenderGraphExecutorTest,
+       ExecutorRecordsComputeAndTransferPassesWithPatchedCopies) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(380u);
+
+  const BufferHandle readback{.index = 9u, .generation = 1u};
+  auto scratchResult = builder.createTransientBuffer(
+      makeTransientBufferDesc(64u), "exec_ct_scratch");
+  auto readbackResult = builder.importBuffer(readback, "exec_ct_readback");
+  ASSERT_FALSE(scratchResult.hasError());
+  ASSERT_FALSE(readbackResult.hasError());
+
+  const std::array<ComputeDispatchItem, 1> dispatches = {ComputeDispatchItem{}};
+  RenderGraphComputePassDesc computeDesc{};
+  computeDesc.dispatches = dispatches;
+  computeDesc.debugLabel = "exec_ct_compute";
+  auto computeResult = builder.addComputePass(computeDesc);
+  ASSERT_FALSE(computeResult.hasError());
+  ASSERT_FALSE(
+      builder.addBufferWrite(computeResult.value(), scratchResult.value())
+          .hasError());
+
+  const std::array<RenderGraphBufferCopy, 1> copies = {RenderGraphBufferCopy{
+      .source = scratchResult.value(),
+      .destination = readbackResult.value(),
+      .sourceOffset = 16u,
+      .size = 32u,
+  }};
+  RenderGraphTransferPassDesc transferDesc{};
+  transferDesc.copies = copies;
+  transferDesc.debugLabel = "exec_ct_transfer";
+  transferDesc.markSideEffect = true;
+  ASSERT_FALSE(builder.addTransferPass(transferDesc).hasError());
+
+  auto compileResult = compileBuilder(builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+
+  FakeGPUDevice gpu;
+  RenderGraphExecutor executor;
+  auto executeResult = executeCompiled(executor, gpu, compileResult.value());
+  ASSERT_FALSE(executeResult.hasError()) << executeResult.error();
+
+  ASSERT_EQ(gpu.recordedPasses.size(), 2u);
+  EXPECT_EQ(gpu.recordedPasses[0u].kind, RenderPassKind::Compute);
+  EXPECT_EQ(gpu.recordedPasses[0u].preDispatches.size(), 1u);
+  EXPECT_TRUE(gpu.recordedPasses[0u].draws.empty());
+  EXPECT_EQ(gpu.recordedPasses[1u].kind, RenderPassKind::Transfer);
+  EXPECT_EQ(gpu.recordedPasses[1u].copies.size(), 1u);
+  EXPECT_TRUE(nuri::isValid(gpu.lastCopyRegion.srcBuffer));
+  EXPECT_TRUE(sameBuffer(gpu.lastCopyRegion.dstBuffer, readback));
+  EXPECT_EQ(gpu.lastCopyRegion.srcOffset, 16u);
+  EXPECT_EQ(gpu.lastCopyRegion.size, 32u);
+  EXPECT_EQ(gpu.createdBufferCount, 1u);
+}
+
+TEST_F(RenderGraphExecutorTest,
+       ExecutorPatchesTransientAdditionalColorAttachments) {
+  RenderGraphBuilder builder;
+  builder.beginFrame(381u);
+
+  auto idResult = builder.createTransientTexture(
+      makeTransientTextureDesc(Format::R32_UINT, 64u, 64u), "exec_mrt_ids");
+  ASSERT_FALSE(idResult.hasError());
+
+  const std::array<RenderGraphColorAttachment, 1> attachments = {
+      RenderGraphColorAttachment{
+          .color = {.loadOp = LoadOp::Clear, .storeOp = StoreOp::Store},
+          .texture = idResult.value()}};
+  RenderGraphGraphicsPassDesc passDesc{};
+  passDesc.additionalColorAttachments = attachments;
+  passDesc.debugLabel = "exec_mrt_pass";
+  ASSERT_FALSE(builder.addGraphicsPass(passDesc).hasError());
+
+  auto compileResult = compileBuilder(builder);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+  ASSERT_EQ(compiled.unresolvedTextureBindings.size(), 1u);
+  EXPECT_EQ(
+      compiled.unresolvedTextureBindings[0u].target,
+      RenderGraphCompileResult::PassTextureBindingTarget::AdditionalColor);
+
+  FakeGPUDevice gpu;
+  RenderGraphExecutor executor;
+  auto executeResult = executeCompiled(executor, gpu, compiled);
+  ASSERT_FALSE(executeResult.hasError()) << executeResult.error();
+
+  ASSERT_EQ(gpu.recordedPasses.size(), 1u);
+  EXPECT_EQ(gpu.recordedPasses[0u].additionalColorCount, 1u);
+  EXPECT_TRUE(
+      nuri::isValid(gpu.recordedPasses[0u].additionalColorTextures[0u]))
+      << "transient MRT target should be materialized before recording";
+  EXPECT_EQ(gpu.createdTextureCount, 1u);
+}
+
 } // namespace
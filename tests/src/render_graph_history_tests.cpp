@@ -0,0 +1,190 @@
+#include "tests_pch.h"
+
+#include "render_graph_test_support.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/render_graph/render_graph_history.h"
+
+#include <cstdint>
+
+namespace {
+
+using namespace nuri;
+using namespace nuri::test_support;
+
+TextureDesc makeHistoryTextureDesc(uint32_t width, uint32_t height) {
+  TextureDesc desc =
+      makeTransientTextureDesc(Format::RGBA16_FLOAT, width, height);
+  desc.usage = TextureUsage::AttachmentSampled;
+  return desc;
+}
+
+TEST(RenderGraphHistoryTest, SlotsPingPongAcrossConsecutiveFrames) {
+  FakeExecutorGPUDevice gpu;
+  RenderGraphHistoryResources history(gpu);
+  const TextureDesc desc = makeHistoryTextureDesc(64u, 64u);
+
+  history.beginFrame(10u);
+  auto firstResult = history.acquireTexture("taa", desc);
+  ASSERT_FALSE(firstResult.hasError()) << firstResult.error();
+  const RenderGraphHistoryTextureHandles first = firstResult.value();
+  EXPECT_FALSE(first.previousValid) << "nothing was written before frame 10";
+  EXPECT_FALSE(sameTexture(first.current, first.previous));
+  EXPECT_EQ(history.textureCount(), 1u);
+
+  auto repeatResult = history.acquireTexture("taa", desc);
+  ASSERT_FALSE(repeatResult.hasError());
+  EXPECT_TRUE(sameTexture(repeatResult.value().current, first.current))
+      << "same-frame acquires must not swap";
+
+  history.beginFrame(11u);
+  auto secondResult = history.acquireTexture("taa", desc);
+  ASSERT_FALSE(secondResult.hasError());
+  EXPECT_TRUE(secondResult.value().previousValid);
+  EXPECT_TRUE(sameTexture(secondResult.value().previous, first.current));
+  EXPECT_TRUE(sameTexture(secondResult.value().current, first.previous));
+
+  history.beginFrame(13u);
+  auto skippedResult = history.acquireTexture("taa", desc);
+  ASSERT_FALSE(skippedResult.hasError());
+  EXPECT_FALSE(skippedResult.value().previousValid)
+      << "frame 12 never wrote history";
+
+  history.beginFrame(14u);
+  history.invalidate("taa");
+  auto invalidatedResult = history.acquireTexture("taa", desc);
+  ASSERT_FALSE(invalidatedResult.hasError());
+  EXPECT_FALSE(invalidatedResult.value().previousValid);
+  EXPECT_EQ(gpu.createdTextureCount, 2u);
+
+  EXPECT_TRUE(history.acquireTexture("", desc).hasError());
+}
+
+TEST(RenderGraphHistoryTest, DescriptorChangeReallocatesAndDefersDestroy) {
+  FakeExecutorGPUDevice gpu;
+  {
+    RenderGraphHistoryResources history(gpu);
+    history.beginFrame(20u);
+    ASSERT_FALSE(
+        history.acquireTexture("ssr", makeHistoryTextureDesc(64u, 64u))
+            .hasError());
+
+    history.beginFrame(21u);
+    auto resizedResult =
+        history.acquireTexture("ssr", makeHistoryTextureDesc(128u, 64u));
+    ASSERT_FALSE(resizedResult.hasError());
+    EXPECT_FALSE(resizedResult.value().previousValid);
+    EXPECT_EQ(gpu.createdTextureCount, 4u);
+    EXPECT_EQ(history.retiredTextureCount(), 2u);
+    EXPECT_EQ(gpu.destroyedTextureCount, 0u)
+        << "old slots may still be in flight";
+
+    history.beginFrame(22u);
+    EXPECT_EQ(gpu.destroyedTextureCount, 0u);
+    history.beginFrame(24u);
+    EXPECT_EQ(gpu.destroyedTextureCount, 2u);
+    EXPECT_EQ(history.retiredTextureCount(), 0u);
+  }
+  EXPECT_EQ(gpu.destroyedTextureCount, 4u);
+}
+
+TEST(RenderGraphHistoryTest, HistoryWriterSurvivesCullingAndReadsPrevious) {
+  FakeExecutorGPUDevice gpu;
+  RenderGraphHistoryResources history(gpu);
+  RenderGraphBuilder builder;
+  builder.beginFrame(30u);
+
+  EXPECT_TRUE(
+      builder.importHistoryTexture("taa", makeHistoryTextureDesc(64u, 64u))
+          .hasError())
+      << "history requires an attached registry";
+
+  builder.setHistoryResources(&history);
+  builder.beginFrame(31u);
+  auto historyResult =
+      builder.importHistoryTexture("taa", makeHistoryTextureDesc(64u, 64u));
+  ASSERT_FALSE(historyResult.hasError()) << historyResult.error();
+  const RenderGraphHistoryTexture taa = historyResult.value();
+  EXPECT_NE(taa.current.value, taa.previous.value);
+
+  auto backbufferResult = builder.importTexture(
+      TextureHandle{.index = 900u, .generation = 1u}, "hist_backbuffer");
+  auto deadResult = builder.createTransientTexture(
+      makeTransientTextureDesc(Format::RGBA8_UNORM, 64u, 64u), "hist_dead");
+  ASSERT_FALSE(backbufferResult.hasError());
+  ASSERT_FALSE(deadResult.hasError());
+
+  RenderGraphGraphicsPassDesc resolveDesc{};
+  resolveDesc.colorTexture = taa.current;
+  resolveDesc.debugLabel = "hist_resolve";
+  auto resolveResult = builder.addGraphicsPass(resolveDesc);
+  ASSERT_FALSE(resolveResult.hasError()) << resolveResult.error();
+  ASSERT_FALSE(
+      builder.addTextureRead(resolveResult.value(), taa.previous).hasError());
+
+  RenderGraphGraphicsPassDesc deadDesc{};
+  deadDesc.colorTexture = deadResult.value();
+  deadDesc.debugLabel = "hist_dead_pass";
+  ASSERT_FALSE(builder.addGraphicsPass(deadDesc).hasError());
+
+  RenderGraphGraphicsPassDesc presentDesc{};
+  presentDesc.colorTexture = backbufferResult.value();
+  presentDesc.debugLabel = "hist_present";
+  presentDesc.markColorAsFrameOutput = true;
+  ASSERT_FALSE(builder.addGraphicsPass(presentDesc).hasError());
+
+  RenderGraphRuntime runtime;
+  auto compileResult = builder.compile(runtime);
+  ASSERT_FALSE(compileResult.hasError()) << compileResult.error();
+  const RenderGraphCompileResult &compiled = compileResult.value();
+
+  EXPECT_EQ(compiled.culledPassCount, 1u)
+      << "only the pass without consumers should be culled";
+  ASSERT_EQ(compiled.orderedPassIndices.size(), 2u);
+  uint32_t resolveOrderedIndex = UINT32_MAX;
+  for (uint32_t i = 0; i < compiled.orderedPassIndices.size(); ++i) {
+    if (compiled.orderedPassIndices[i] == resolveResult.value().value) {
+      resolveOrderedIndex = i;
+    }
+  }
+  ASSERT_NE(resolveOrderedIndex, UINT32_MAX);
+
+  const PassBarrierPlan &plan = compiled.passBarrierPlans[resolveOrderedIndex];
+  bool foundPreviousBarrier = false;
+  for (uint32_t i = 0; i < plan.barrierCount; ++i) {
+    const RenderGraphBarrierRecord &record =
+        compiled.passBarrierRecords[plan.barrierOffset + i];
+    if (record.resourceKind != RenderGraphBarrierResourceKind::Texture ||
+        record.resourceIndex != taa.previous.value) {
+      continue;
+    }
+    foundPreviousBarrier = true;
+    EXPECT_EQ(record.afterState, RenderGraphResourceState::Read);
+  }
+  EXPECT_TRUE(foundPreviousBarrier);
+}
+
+TEST(RenderGraphHistoryTest, ImportExposesPreviousBackingTexture) {
+  FakeExecutorGPUDevice gpu;
+  RenderGraphHistoryResources history(gpu);
+  RenderGraphBuilder builder;
+  builder.setHistoryResources(&history);
+  const TextureDesc desc = makeHistoryTextureDesc(32u, 32u);
+
+  builder.beginFrame(40u);
+  auto firstResult = history.acquireTexture("pick", desc);
+  ASSERT_FALSE(firstResult.hasError()) << firstResult.error();
+  const TextureHandle writtenLastFrame = firstResult.value().current;
+
+  builder.beginFrame(41u);
+  auto importResult = builder.importHistoryTexture("pick", desc);
+  ASSERT_FALSE(importResult.hasError()) << importResult.error();
+  EXPECT_TRUE(importResult.value().previousValid);
+  EXPECT_EQ(importResult.value().previousTexture.index,
+            writtenLastFrame.index);
+  EXPECT_EQ(importResult.value().previousTexture.generation,
+            writtenLastFrame.generation);
+}
+
+} // namespace
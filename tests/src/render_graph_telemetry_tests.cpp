@@ -217,6 +217,110 @@ TEST(RenderGraphTelemetryTest, CaptureDeepCopiesStructuredData) {
   EXPECT_EQ(snapshot->unresolvedDrawBufferBindings[0].bufferResourceIndex, 4u);
 }
 
+TEST(RenderGraphTelemetryTest, UnchangedGraphOnlyUpdatesFrameIndex) {
+  RenderGraphTelemetryService telemetry;
+
+  std::array<std::byte, 32 * 1024> compileBytes{};
+  std::pmr::monotonic_buffer_resource compileMemory(compileBytes.data(),
+                                                    compileBytes.size());
+  RenderGraphCompileResult compiled(&compileMemory);
+  RenderGraphExecutionMetadata execution(&compileMemory);
+  populateTelemetryCompileResult(compiled, &compileMemory);
+  populateTelemetryExecutionMetadata(execution, &compileMemory);
+  telemetry.capture(compiled, execution);
+
+  const RenderGraphTelemetrySnapshot *first = telemetry.latestSnapshot();
+  ASSERT_NE(first, nullptr);
+  const uint64_t compileFingerprint = first->summary.compileFingerprint;
+
+  compiled.frameIndex = 43u;
+  telemetry.capture(compiled, execution);
+  EXPECT_EQ(telemetry.latestSnapshot(), first);
+  EXPECT_EQ(first->summary.frameIndex, 43u);
+  EXPECT_EQ(first->summary.compileFingerprint, compileFingerprint);
+  EXPECT_EQ(telemetry.captureStats().capturedSnapshots, 1u);
+  EXPECT_EQ(telemetry.captureStats().unchangedFrames, 1u);
+
+  compiled.frameIndex = 44u;
+  compiled.edges.push_back({.before = 1u, .after = 0u});
+  telemetry.capture(compiled, execution);
+  const RenderGraphTelemetrySnapshot *second = telemetry.latestSnapshot();
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(second, first);
+  EXPECT_EQ(second->summary.frameIndex, 44u);
+  EXPECT_EQ(second->edges.size(), 2u);
+  EXPECT_NE(second->summary.compileFingerprint, compileFingerprint);
+  EXPECT_EQ(telemetry.captureStats().capturedSnapshots, 2u);
+
+  telemetry.requestCapture();
+  telemetry.capture(compiled, execution);
+  EXPECT_EQ(telemetry.latestSnapshot(), first);
+  EXPECT_EQ(first->edges.size(), 2u);
+  EXPECT_EQ(telemetry.captureStats().capturedSnapshots, 3u);
+}
+
+TEST(RenderGraphTelemetryTest, RotatingRingHandlesDoNotForceCaptures) {
+  RenderGraphTelemetryService telemetry;
+
+  std::array<std::byte, 32 * 1024> compileBytes{};
+  std::pmr::monotonic_buffer_resource compileMemory(compileBytes.data(),
+                                                    compileBytes.size());
+  RenderGraphCompileResult compiled(&compileMemory);
+  populateTelemetryCompileResult(compiled, &compileMemory);
+  telemetry.capture(compiled);
+  const RenderGraphTelemetrySnapshot *first = telemetry.latestSnapshot();
+  ASSERT_NE(first, nullptr);
+
+  // Frame slots bind a different ring buffer to the same dependency slot.
+  compiled.frameIndex = 43u;
+  compiled.resolvedDependencyBuffers[0] =
+      BufferHandle{.index = 12u, .generation = 2u};
+  telemetry.capture(compiled);
+  EXPECT_EQ(telemetry.latestSnapshot(), first);
+  EXPECT_EQ(telemetry.captureStats().capturedSnapshots, 1u);
+  EXPECT_EQ(telemetry.captureStats().unchangedFrames, 1u);
+  ASSERT_EQ(first->resolvedDependencyBuffers.size(), 1u);
+  EXPECT_EQ(first->resolvedDependencyBuffers[0].index, 12u);
+
+  compiled.frameIndex = 44u;
+  compiled.resolvedDependencyBuffers[0] = BufferHandle{};
+  telemetry.capture(compiled);
+  EXPECT_NE(telemetry.latestSnapshot(), first);
+  EXPECT_EQ(telemetry.captureStats().capturedSnapshots, 2u);
+}
+
+TEST(RenderGraphTelemetryTest, SampleIntervalThrottlesCaptures) {
+  RenderGraphTelemetryService telemetry;
+  telemetry.setSampleInterval(0u);
+
+  std::array<std::byte, 32 * 1024> compileBytes{};
+  std::pmr::monotonic_buffer_resource compileMemory(compileBytes.data(),
+                                                    compileBytes.size());
+  RenderGraphCompileResult compiled(&compileMemory);
+  populateTelemetryCompileResult(compiled, &compileMemory);
+  telemetry.capture(compiled);
+  ASSERT_TRUE(telemetry.hasSnapshot());
+
+  compiled.frameIndex = 50u;
+  telemetry.capture(compiled);
+  EXPECT_EQ(telemetry.latestSnapshot()->summary.frameIndex, 42u);
+  EXPECT_EQ(telemetry.captureStats().sampledOutFrames, 1u);
+
+  telemetry.requestCapture();
+  telemetry.capture(compiled);
+  EXPECT_EQ(telemetry.latestSnapshot()->summary.frameIndex, 50u);
+
+  telemetry.setSampleInterval(2u);
+  compiled.frameIndex = 51u;
+  telemetry.capture(compiled);
+  EXPECT_EQ(telemetry.latestSnapshot()->summary.frameIndex, 50u);
+  compiled.frameIndex = 52u;
+  telemetry.capture(compiled);
+  EXPECT_EQ(telemetry.latestSnapshot()->summary.frameIndex, 52u);
+  EXPECT_EQ(telemetry.captureStats().sampledOutFrames, 2u);
+  EXPECT_EQ(telemetry.captureStats().unchangedFrames, 1u);
+}
+
 TEST(RenderGraphTelemetryTest, WriteDumpSerializesSnapshotAndValidatesInputs) {
   std::array<std::byte, 32 * 1024> serviceBytes{};
   std::pmr::monotonic_buffer_resource serviceMemory(serviceBytes.data(),
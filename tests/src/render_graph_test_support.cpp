@@ -534,11 +534,19 @@ FakeExecutorGPUDevice::submitRecordedGraphicsFrame(
   lastDependencyBuffer = {};
   lastPreDispatchDependencyBuffer = {};
   lastDrawVertexBuffer = {};
+  lastCopyRegion = {};
 
   if (recordedPasses.empty()) {
     return baseResult;
   }
 
+  for (const RenderPass &recorded : recordedPasses) {
+    if (!recorded.copies.empty()) {
+      lastCopyRegion = recorded.copies[0u];
+      break;
+    }
+  }
+
   const RenderPass &pass = recordedPasses[0u];
   lastColorTexture = pass.colorTexture;
   lastDepthTexture = pass.depthTexture;
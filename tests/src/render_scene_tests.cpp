@@ -0,0 +1,62 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/scene/render_scene.h"
+
+#include <array>
+#include <cstdint>
+
+namespace {
+
+using namespace nuri;
+
+constexpr ModelRef kModel{1u};
+constexpr MaterialRef kMaterial{1u};
+
+TEST(RenderSceneTest, TransformVersionsFollowRenderableMobility) {
+  RenderScene scene;
+  auto staticIndex = scene.addRenderable(kModel, kMaterial);
+  auto dynamicIndex = scene.addRenderable(
+      kModel, kMaterial, glm::mat4(1.0f), RenderableMobility::Dynamic);
+  ASSERT_FALSE(staticIndex.hasError());
+  ASSERT_FALSE(dynamicIndex.hasError());
+
+  const uint64_t staticVersion = scene.staticTransformVersion();
+  const uint64_t dynamicVersion = scene.dynamicTransformVersion();
+  const uint64_t topologyVersion = scene.topologyVersion();
+
+  ASSERT_TRUE(
+      scene.setRenderableTransform(dynamicIndex.value(), glm::mat4(2.0f)));
+  EXPECT_EQ(scene.staticTransformVersion(), staticVersion);
+  EXPECT_NE(scene.dynamicTransformVersion(), dynamicVersion);
+  EXPECT_EQ(scene.topologyVersion(), topologyVersion);
+
+  ASSERT_TRUE(
+      scene.setRenderableTransform(staticIndex.value(), glm::mat4(2.0f)));
+  EXPECT_NE(scene.staticTransformVersion(), staticVersion);
+  EXPECT_EQ(scene.topologyVersion(), topologyVersion);
+}
+
+TEST(RenderSceneTest, MobilityChangesBumpTopologyOnlyWhenChanged) {
+  RenderScene scene;
+  const std::array<glm::mat4, 2> matrices{glm::mat4(1.0f), glm::mat4(1.0f)};
+  auto first = scene.addRenderablesInstanced(kModel, kMaterial, matrices);
+  ASSERT_FALSE(first.hasError());
+  EXPECT_EQ(scene.renderable(first.value())->mobility,
+            RenderableMobility::Static);
+
+  const uint64_t topologyVersion = scene.topologyVersion();
+  ASSERT_TRUE(scene.setRenderableMobility(first.value(),
+                                          RenderableMobility::Static));
+  EXPECT_EQ(scene.topologyVersion(), topologyVersion);
+
+  ASSERT_TRUE(scene.setRenderableMobility(first.value(),
+                                          RenderableMobility::Dynamic));
+  EXPECT_NE(scene.topologyVersion(), topologyVersion);
+  EXPECT_EQ(scene.renderable(first.value())->mobility,
+            RenderableMobility::Dynamic);
+  EXPECT_FALSE(scene.setRenderableMobility(2u, RenderableMobility::Dynamic));
+}
+
+} // namespace
@@ -0,0 +1,124 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/shader.h"
+#include "nuri/resources/storage/archive/asset_archive.h"
+#include "nuri/resources/storage/archive/asset_file_system.h"
+#include "render_graph_test_support.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+using namespace nuri;
+using namespace nuri::test_support;
+
+class FakeShaderGPUDevice final : public FakeGPUDeviceBase {
+public:
+  Result<ShaderHandle, std::string>
+  createShaderModule(const ShaderDesc &desc) override {
+    sources.emplace_back(desc.source);
+    return Result<ShaderHandle, std::string>::makeResult(
+        ShaderHandle{.index = nextShaderIndex_++, .generation = 1u});
+  }
+
+  void destroyShaderModule(ShaderHandle shader) override {
+    if (nuri::isValid(shader)) {
+      ++destroyedShaderCount;
+    }
+  }
+
+  std::vector<std::string> sources;
+  uint32_t destroyedShaderCount = 0u;
+
+private:
+  uint32_t nextShaderIndex_ = 1u;
+};
+
+void writeFile(const std::filesystem::path &path, std::string_view text) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+class ShaderFilesTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const auto tick =
+        std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    root_ = std::filesystem::temp_directory_path() /
+            ("nuri_shader_files_" + std::to_string(tick));
+    shaders_ = root_ / "assets" / "shaders";
+    writeFile(shaders_ / "common.glsl", "// packed common\n");
+    writeFile(shaders_ / "mesh.vert",
+              "#include \"common.glsl\"\nvoid main() {}\n");
+    writeFile(shaders_ / "mesh.frag",
+              "#include \"common.glsl\"\nvoid main() {}\n");
+  }
+
+  void TearDown() override {
+    unmountAssetArchives();
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  std::filesystem::path root_;
+  std::filesystem::path shaders_;
+};
+
+TEST_F(ShaderFilesTest, BatchedStagesResolveIncludesFromMountedArchive) {
+  const std::filesystem::path archivePath = root_ / "assets.npak";
+  ASSERT_FALSE(buildAssetArchive(root_ / "assets", archivePath).hasError());
+  // Loose copy changes after packing so an archive hit is visible.
+  writeFile(shaders_ / "common.glsl", "// loose common\n");
+  auto mounted = mountAssetArchive(archivePath, root_ / "assets");
+  ASSERT_FALSE(mounted.hasError()) << mounted.error();
+
+  FakeShaderGPUDevice gpu;
+  Shader shader("mesh", gpu);
+  const std::string vertexPath = (shaders_ / "mesh.vert").string();
+  const std::string fragmentPath = (shaders_ / "mesh.frag").string();
+  const std::array<ShaderFile, 2> files = {
+      ShaderFile{vertexPath, ShaderStage::Vertex},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
+  };
+  auto compiled = shader.compileFromFiles(files);
+  ASSERT_FALSE(compiled.hasError()) << compiled.error();
+  ASSERT_EQ(compiled.value().size(), 2u);
+  EXPECT_EQ(compiled.value()[0].index,
+            shader.getHandle(ShaderStage::Vertex).index);
+  EXPECT_EQ(compiled.value()[1].index,
+            shader.getHandle(ShaderStage::Fragment).index);
+
+  ASSERT_EQ(gpu.sources.size(), 2u);
+  for (const std::string &source : gpu.sources) {
+    EXPECT_NE(source.find("// packed common"), std::string::npos) << source;
+    EXPECT_NE(source.find("void main()"), std::string::npos);
+  }
+}
+
+TEST_F(ShaderFilesTest, FailedStageDestroysStagesCompiledByTheBatch) {
+  FakeShaderGPUDevice gpu;
+  Shader shader("mesh", gpu);
+  writeFile(shaders_ / "broken.frag",
+            "#include \"missing.glsl\"\nvoid main() {}\n");
+  const std::string vertexPath = (shaders_ / "mesh.vert").string();
+  const std::string fragmentPath = (shaders_ / "broken.frag").string();
+  const std::array<ShaderFile, 2> files = {
+      ShaderFile{vertexPath, ShaderStage::Vertex},
+      ShaderFile{fragmentPath, ShaderStage::Fragment},
+  };
+
+  auto compiled = shader.compileFromFiles(files);
+  ASSERT_TRUE(compiled.hasError());
+  EXPECT_NE(compiled.error().find("missing.glsl"), std::string::npos)
+      << compiled.error();
+  EXPECT_EQ(gpu.sources.size(), 1u);
+  EXPECT_EQ(gpu.destroyedShaderCount, 1u);
+  EXPECT_FALSE(nuri::isValid(shader.getHandle(ShaderStage::Vertex)));
+}
+
+} // namespace
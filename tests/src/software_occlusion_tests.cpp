@@ -0,0 +1,115 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/gfx/software_occlusion.h"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+using namespace nuri;
+
+// Unit quad in the XY plane, facing +Z.
+constexpr std::array<uint32_t, 6> kQuadIndices = {0u, 1u, 2u, 0u, 2u, 3u};
+
+std::array<glm::vec3, 4> makeQuad(float halfExtent) {
+  return {glm::vec3(-halfExtent, -halfExtent, 0.0f),
+          glm::vec3(halfExtent, -halfExtent, 0.0f),
+          glm::vec3(halfExtent, halfExtent, 0.0f),
+          glm::vec3(-halfExtent, halfExtent, 0.0f)};
+}
+
+// Camera at the origin looking down -Z.
+glm::mat4 makeViewProj() {
+  return glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+}
+
+glm::mat4 atDepth(float distance) {
+  return glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -distance));
+}
+
+BoundingBox boxAt(float halfExtent, float nearDistance, float farDistance) {
+  return BoundingBox(glm::vec3(-halfExtent, -halfExtent, -farDistance),
+                     glm::vec3(halfExtent, halfExtent, -nearDistance));
+}
+
+TEST(SoftwareOcclusionTest, FullScreenOccluderHidesOnlyBoundsBehindIt) {
+  SoftwareOcclusionCuller culler(
+      SoftwareOcclusionConfig{.width = 128, .height = 64, .threadCount = 1});
+  const std::array<glm::vec3, 4> wall = makeQuad(10.0f);
+  culler.beginFrame(makeViewProj());
+  culler.addOccluder(wall, kQuadIndices, atDepth(5.0f));
+  culler.rasterize();
+
+  EXPECT_EQ(culler.stats().occluders, 1u);
+  EXPECT_EQ(culler.stats().occluderTriangles, 2u);
+  EXPECT_EQ(culler.stats().rasterizedTriangles, 2u);
+
+  EXPECT_TRUE(culler.isOccluded(boxAt(1.0f, 8.0f, 9.0f)));
+  EXPECT_FALSE(culler.isOccluded(boxAt(1.0f, 3.0f, 4.0f)));
+  // Straddles the wall.
+  EXPECT_FALSE(culler.isOccluded(boxAt(1.0f, 4.0f, 6.0f)));
+  // Crosses the near plane.
+  EXPECT_FALSE(culler.isOccluded(boxAt(1.0f, -1.0f, 20.0f)));
+}
+
+TEST(SoftwareOcclusionTest, PartialCoverageNeedsTheWholeRectangleHidden) {
+  SoftwareOcclusionCuller culler(
+      SoftwareOcclusionConfig{.width = 128, .height = 64, .threadCount = 1});
+  const std::array<glm::vec3, 4> wall = makeQuad(1.0f);
+  culler.beginFrame(makeViewProj());
+  culler.addOccluder(wall, kQuadIndices, atDepth(5.0f));
+  culler.rasterize();
+
+  EXPECT_TRUE(culler.isOccluded(boxAt(0.5f, 9.0f, 10.0f)));
+  // Pokes out past the edges of the wall.
+  EXPECT_FALSE(culler.isOccluded(boxAt(3.0f, 9.0f, 10.0f)));
+
+  // Occluders behind the camera are dropped rather than wrapped around.
+  culler.beginFrame(makeViewProj());
+  culler.addOccluder(wall, kQuadIndices, atDepth(-5.0f));
+  culler.rasterize();
+  EXPECT_EQ(culler.stats().rasterizedTriangles, 0u);
+  EXPECT_FALSE(culler.isOccluded(boxAt(0.5f, 9.0f, 10.0f)));
+}
+
+TEST(SoftwareOcclusionTest, WorkerThreadsMatchSingleThreadedResults) {
+  const std::array<glm::vec3, 4> wall = makeQuad(0.6f);
+  std::vector<BoundingBox> bounds;
+  for (int i = 0; i < 300; ++i) {
+    const float x = static_cast<float>(i % 20 - 10) * 0.3f;
+    const float y = static_cast<float>(i / 20 - 7) * 0.3f;
+    const float distance = 4.0f + static_cast<float>(i % 7);
+    bounds.emplace_back(glm::vec3(x - 0.1f, y - 0.1f, -distance - 0.2f),
+                        glm::vec3(x + 0.1f, y + 0.1f, -distance));
+  }
+
+  std::array<std::vector<uint8_t>, 2> results;
+  std::array<uint32_t, 2> occludedCounts{};
+  for (uint32_t run = 0; run < 2u; ++run) {
+    SoftwareOcclusionCuller culler(SoftwareOcclusionConfig{
+        .width = 256, .height = 128, .threadCount = run == 0u ? 1u : 4u});
+    culler.beginFrame(makeViewProj());
+    for (int i = 0; i < 9; ++i) {
+      const glm::mat4 model = glm::translate(
+          glm::mat4(1.0f), glm::vec3(static_cast<float>(i % 3 - 1) * 1.5f,
+                                     static_cast<float>(i / 3 - 1) * 1.5f,
+                                     -5.0f));
+      culler.addOccluder(wall, kQuadIndices, model);
+    }
+    culler.rasterize();
+    results[run].assign(bounds.size(), 2u);
+    culler.testOcclusion(bounds, results[run]);
+    EXPECT_EQ(culler.stats().testedBounds, bounds.size());
+    occludedCounts[run] = culler.stats().occludedBounds;
+  }
+
+  EXPECT_EQ(results[0], results[1]);
+  EXPECT_EQ(occludedCounts[0], occludedCounts[1]);
+  EXPECT_GT(occludedCounts[0], 0u);
+  EXPECT_LT(occludedCounts[0], bounds.size());
+}
+
+} // namespace
@@ -0,0 +1,157 @@
+#include "tests_pch.h"
+
+#include <gtest/gtest.h>
+
+#include "nuri/core/startup_task_graph.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+using namespace nuri;
+
+Result<bool, std::string> succeed() {
+  return Result<bool, std::string>::makeResult(true);
+}
+
+StartupTaskId addOrFail(StartupTaskGraph &graph, const StartupTaskDesc &desc) {
+  auto result = graph.addTask(desc);
+  EXPECT_FALSE(result.hasError()) << result.error();
+  return result.hasError() ? StartupTaskId{} : result.value();
+}
+
+TEST(StartupTaskGraphTest, DependenciesOrderTasksAndMainTasksStayOnCaller) {
+  StartupTaskGraph graph;
+  const std::thread::id callerThread = std::this_thread::get_id();
+  std::atomic<uint32_t> sequence{0u};
+  std::array<uint32_t, 4> finishedAt{};
+  std::array<std::thread::id, 4> ranOn{};
+  const auto record = [&](uint32_t slot) {
+    return [&, slot]() -> Result<bool, std::string> {
+      ranOn[slot] = std::this_thread::get_id();
+      finishedAt[slot] = sequence.fetch_add(1u);
+      return succeed();
+    };
+  };
+
+  const StartupTaskId decodeA = addOrFail(
+      graph, {.name = "decode_a", .affinity = StartupTaskAffinity::Worker,
+              .run = record(0u)});
+  const StartupTaskId decodeB = addOrFail(
+      graph, {.name = "decode_b", .affinity = StartupTaskAffinity::Worker,
+              .run = record(1u)});
+  const std::array<StartupTaskId, 2> uploadDeps = {decodeA, decodeB};
+  const StartupTaskId upload = addOrFail(
+      graph, {.name = "upload",
+              .affinity = StartupTaskAffinity::MainThread,
+              .dependencies = uploadDeps,
+              .run = record(2u)});
+  const std::array<StartupTaskId, 1> finalizeDeps = {upload};
+  (void)addOrFail(graph, {.name = "finalize",
+                          .affinity = StartupTaskAffinity::Worker,
+                          .dependencies = finalizeDeps,
+                          .run = record(3u)});
+
+  const StartupReport report = graph.run(2u);
+  EXPECT_TRUE(report.succeeded());
+  EXPECT_EQ(report.workerCount, 2u);
+  EXPECT_TRUE(graph.empty()) << "run() consumes the graph";
+  ASSERT_EQ(report.tasks.size(), 4u);
+  for (const StartupTaskTiming &timing : report.tasks) {
+    EXPECT_EQ(timing.status, StartupTaskStatus::Succeeded) << timing.name;
+  }
+
+  EXPECT_GT(finishedAt[2], finishedAt[0]);
+  EXPECT_GT(finishedAt[2], finishedAt[1]);
+  EXPECT_GT(finishedAt[3], finishedAt[2]);
+  EXPECT_EQ(ranOn[2], callerThread);
+  EXPECT_EQ(report.tasks[2].workerIndex, UINT32_MAX);
+  EXPECT_NE(ranOn[0], callerThread);
+  EXPECT_NE(ranOn[3], callerThread);
+  EXPECT_LT(report.tasks[3].workerIndex, 2u);
+}
+
+TEST(StartupTaskGraphTest, FailureSkipsTransitiveDependents) {
+  StartupTaskGraph graph;
+  std::atomic<uint32_t> runCount{0u};
+  const auto counted = [&runCount]() -> Result<bool, std::string> {
+    runCount.fetch_add(1u);
+    return succeed();
+  };
+
+  const StartupTaskId broken = addOrFail(
+      graph, {.name = "broken",
+              .run = []() -> Result<bool, std::string> {
+                return Result<bool, std::string>::makeError("missing file");
+              }});
+  const StartupTaskId independent =
+      addOrFail(graph, {.name = "independent", .run = counted});
+  const std::array<StartupTaskId, 1> childDeps = {broken};
+  const StartupTaskId child = addOrFail(
+      graph, {.name = "child",
+              .affinity = StartupTaskAffinity::MainThread,
+              .dependencies = childDeps,
+              .run = counted});
+  const std::array<StartupTaskId, 2> grandchildDeps = {child, independent};
+  (void)addOrFail(graph, {.name = "grandchild",
+                          .dependencies = grandchildDeps,
+                          .run = counted});
+  (void)addOrFail(graph, {.name = "throws",
+                          .run = []() -> Result<bool, std::string> {
+                            throw std::runtime_error("boom");
+                          }});
+
+  const StartupReport report = graph.run(3u);
+  EXPECT_FALSE(report.succeeded());
+  EXPECT_EQ(report.failedTaskCount, 2u);
+  EXPECT_EQ(report.skippedTaskCount, 2u);
+  EXPECT_EQ(runCount.load(), 1u) << "only the independent task may run";
+  ASSERT_EQ(report.tasks.size(), 5u);
+  EXPECT_EQ(report.tasks[0].status, StartupTaskStatus::Failed);
+  EXPECT_EQ(report.tasks[0].error, "missing file");
+  EXPECT_EQ(report.tasks[1].status, StartupTaskStatus::Succeeded);
+  EXPECT_EQ(report.tasks[2].status, StartupTaskStatus::Skipped);
+  EXPECT_EQ(report.tasks[3].status, StartupTaskStatus::Skipped);
+  EXPECT_EQ(report.tasks[4].status, StartupTaskStatus::Failed);
+  EXPECT_NE(report.tasks[4].error.find("boom"), std::string::npos);
+}
+
+TEST(StartupTaskGraphTest, RejectsInvalidTasksAndRunsInlineWithoutWorkers) {
+  StartupTaskGraph graph;
+  EXPECT_TRUE(graph.addTask({.name = "no_callback"}).hasError());
+
+  const std::array<StartupTaskId, 1> forwardDeps = {
+      StartupTaskId{.value = 0u}};
+  EXPECT_TRUE(graph
+                  .addTask({.name = "forward",
+                            .dependencies = forwardDeps,
+                            .run = succeed})
+                  .hasError())
+      << "dependencies must already exist";
+  EXPECT_TRUE(graph.empty());
+
+  const std::thread::id callerThread = std::this_thread::get_id();
+  std::thread::id ranOn{};
+  const StartupTaskId first = addOrFail(
+      graph, {.name = "first", .run = [&]() -> Result<bool, std::string> {
+                ranOn = std::this_thread::get_id();
+                return succeed();
+              }});
+  const std::array<StartupTaskId, 2> duplicateDeps = {first, first};
+  (void)addOrFail(graph, {.name = "second",
+                          .dependencies = duplicateDeps,
+                          .run = succeed});
+
+  const StartupReport report = graph.run(0u);
+  EXPECT_TRUE(report.succeeded());
+  EXPECT_EQ(report.workerCount, 0u);
+  EXPECT_EQ(ranOn, callerThread);
+  EXPECT_EQ(report.tasks[1].status, StartupTaskStatus::Succeeded)
+      << "duplicate edges must not stall the dependent";
+  EXPECT_GT(StartupTaskGraph::defaultWorkerCount(), 0u);
+}
+
+} // namespace